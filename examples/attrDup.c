@@ -0,0 +1,133 @@
+/*
+ *      EGADS: Electronic Geometry Aircraft Design System
+ *
+ *             Check that duplicated attributes are independent
+ *
+ *      Copyright 2011-2022, Massachusetts Institute of Technology
+ *      Licensed under The GNU Lesser General Public License, version 2.1
+ *      See http://www.opensource.org/licenses/lgpl-2.1.php
+ *
+ */
+
+#include <string.h>
+#include "egads.h"
+
+
+/* the value of an ATTRINT (or -1) */
+static int
+intAttr(ego obj, const char *name)
+{
+  int          stat, atype, alen;
+  const int    *ints;
+  const double *reals;
+  const char   *str;
+
+  stat = EG_attributeRet(obj, name, &atype, &alen, &ints, &reals, &str);
+  if ((stat != EGADS_SUCCESS) || (atype != ATTRINT) || (alen != 1)) return -1;
+  return ints[0];
+}
+
+
+/* the number of attributes (or -1) */
+static int
+numAttr(ego obj)
+{
+  int num;
+
+  if (EG_attributeNum(obj, &num) != EGADS_SUCCESS) return -1;
+  return num;
+}
+
+
+/* dup src to dst, change each in turn & look at the other */
+static int
+dupModify(const char *title, ego src, ego dst)
+{
+  int          i, nerr, nsrc, nseq, atype, alen;
+  double       reals[3] = {1.0, 2.0, 3.0};
+  const int    *pints;
+  const double *preals;
+  const char   *str;
+
+  nerr = 0;
+  i    = 1;
+  EG_attributeAdd(src, "tag",   ATTRINT,    1, &i,   NULL,  NULL);
+  EG_attributeAdd(src, "xyz",   ATTRREAL,   3, NULL, reals, NULL);
+  EG_attributeAdd(src, "label", ATTRSTRING, 0, NULL, NULL,  "src");
+  EG_attributeAddSeq(src, "part", ATTRINT,  1, &i,   NULL,  NULL);
+  i = 2;
+  EG_attributeAddSeq(src, "part", ATTRINT,  1, &i,   NULL,  NULL);
+  nsrc = numAttr(src);
+
+  if (EG_attributeDup(src, dst) != EGADS_SUCCESS) nerr++;
+  /* a second dup merges nothing new when attributes are full */
+  if (EG_attributeDup(src, dst) != EGADS_SUCCESS) nerr++;
+  if (numAttr(dst) != nsrc) nerr++;
+
+  /* change the copy */
+  i = 3;
+  EG_attributeAdd(dst, "tag", ATTRINT, 1, &i, NULL, NULL);
+  EG_attributeAddSeq(dst, "part", ATTRINT, 1, &i, NULL, NULL);
+  reals[0] = -1.0;
+  EG_attributeAdd(dst, "xyz", ATTRREAL, 3, NULL, reals, NULL);
+  EG_attributeDel(dst, "label");
+  if (intAttr(src, "tag") != 1) nerr++;
+  if (numAttr(src) != nsrc)     nerr++;
+  if ((EG_attributeNumSeq(src, "part", &nseq) != EGADS_SUCCESS) ||
+      (nseq != 2)) nerr++;
+  if ((EG_attributeRet(src, "xyz", &atype, &alen, &pints, &preals,
+                       &str) != EGADS_SUCCESS) || (preals[0] != 1.0)) nerr++;
+  if ((EG_attributeRet(src, "label", &atype, &alen, &pints, &preals,
+                       &str) != EGADS_SUCCESS) || (strcmp(str, "src") != 0))
+    nerr++;
+
+  /* change the source */
+  i = 4;
+  EG_attributeAdd(src, "tag", ATTRINT, 1, &i, NULL, NULL);
+  EG_attributeAdd(src, "new", ATTRINT, 1, &i, NULL, NULL);
+  if (intAttr(dst, "tag") != 3) nerr++;
+  if (intAttr(dst, "new") != -1) nerr++;
+
+  /* a fresh dup followed by removing everything from the source */
+  EG_attributeDel(dst, NULL);
+  if (EG_attributeDup(src, dst) != EGADS_SUCCESS) nerr++;
+  EG_attributeDel(src, NULL);
+  if (numAttr(src) != 0)        nerr++;
+  if (numAttr(dst) != nsrc+1)   nerr++;
+  if (intAttr(dst, "tag") != 4) nerr++;
+  EG_attributeDel(dst, NULL);
+
+  printf(" %s: errors = %d\n", title, nerr);
+  return nerr;
+}
+
+
+int main(int argc, char *argv[])
+{
+  int    stat, nface, nerr;
+  double data[6];
+  ego    context, body, *faces;
+
+  printf(" EG_open           = %d\n", EG_open(&context));
+  data[0] = data[1] = data[2] = 0.0;
+  data[3] = 1.0;
+  data[4] = 2.0;
+  data[5] = 3.0;
+  stat = EG_makeSolidBody(context, BOX, data, &body);
+  printf(" EG_makeSolidBody  = %d\n", stat);
+  if (stat != EGADS_SUCCESS) return 1;
+  stat = EG_getBodyTopos(body, NULL, FACE, &nface, &faces);
+  printf(" EG_getBodyTopos   = %d\n", stat);
+  if (stat != EGADS_SUCCESS) return 1;
+
+  nerr  = dupModify("replace", faces[0], faces[1]);
+  EG_setFullAttrs(context, 1);
+  nerr += dupModify("full   ", faces[2], faces[3]);
+  EG_setFullAttrs(context, 0);
+
+  EG_free(faces);
+  printf(" EG_deleteObject   = %d\n", EG_deleteObject(body));
+  printf(" EG_close          = %d\n", EG_close(context));
+  if (nerr != 0) printf(" %d attribute errors!\n", nerr);
+  return nerr;
+}
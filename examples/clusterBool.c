@@ -0,0 +1,218 @@
+/*
+ *      EGADS: Electronic Geometry Aircraft Design System
+ *
+ *             Compare EG_clusterBoolean with EG_generalBoolean
+ *
+ *      Copyright 2011-2022, Massachusetts Institute of Technology
+ *      Licensed under The GNU Lesser General Public License, version 2.1
+ *      See http://www.opensource.org/licenses/lgpl-2.1.php
+ *
+ */
+
+#include <math.h>
+#include <string.h>
+#include "egads.h"
+
+
+static int
+cmpTag(const void *a, const void *b)
+{
+  return strcmp(*(const char **) a, *(const char **) b);
+}
+
+
+/* tag every Face of a Body */
+static int
+tagFaces(ego body, const char *prefix)
+{
+  int  i, stat, nface;
+  char tag[64];
+  ego  *faces;
+
+  stat = EG_getBodyTopos(body, NULL, FACE, &nface, &faces);
+  if (stat != EGADS_SUCCESS) return stat;
+  for (i = 0; i < nface; i++) {
+    snprintf(tag, 64, "%s f%d", prefix, i+1);
+    stat = EG_attributeAdd(faces[i], "tag", ATTRSTRING, 0, NULL, NULL, tag);
+    if (stat != EGADS_SUCCESS) break;
+  }
+  EG_free(faces);
+  return stat;
+}
+
+
+/* the Face count, volume and sorted Face tags of a Model */
+static int
+modelInfo(ego model, int *nbody, int *nface, double *volume, const char ***tags)
+{
+  int          i, j, n, stat, oclass, mtype, atype, alen, *senses;
+  const int    *ints;
+  const double *reals;
+  const char   *str, **list;
+  double       props[14];
+  ego          geom, *bodies, *faces;
+
+  *nface  = 0;
+  *volume = 0.0;
+  *tags   = NULL;
+  stat    = EG_getTopology(model, &geom, &oclass, &mtype, NULL, nbody,
+                           &bodies, &senses);
+  if (stat != EGADS_SUCCESS) return stat;
+  for (i = 0; i < *nbody; i++) {
+    stat = EG_getBodyTopos(bodies[i], NULL, FACE, &n, NULL);
+    if (stat != EGADS_SUCCESS) return stat;
+    *nface += n;
+  }
+  list = (const char **) EG_alloc(*nface*sizeof(char *));
+  if (list == NULL) return EGADS_MALLOC;
+
+  for (n = i = 0; i < *nbody; i++) {
+    stat = EG_getMassProperties(bodies[i], props);
+    if (stat != EGADS_SUCCESS) {
+      EG_free(list);
+      return stat;
+    }
+    *volume += props[0];
+    stat = EG_getBodyTopos(bodies[i], NULL, FACE, &j, &faces);
+    if (stat != EGADS_SUCCESS) {
+      EG_free(list);
+      return stat;
+    }
+    for (j = j-1; j >= 0; j--, n++) {
+      list[n] = "";
+      stat    = EG_attributeRet(faces[j], "tag", &atype, &alen, &ints, &reals,
+                                &str);
+      if ((stat == EGADS_SUCCESS) && (atype == ATTRSTRING)) list[n] = str;
+    }
+    EG_free(faces);
+  }
+  qsort(list, n, sizeof(char *), cmpTag);
+  *tags = list;
+
+  return EGADS_SUCCESS;
+}
+
+
+/* run both Booleans and compare the results */
+static int
+compare(const char *title, ego src, ego tool)
+{
+  int        i, stat, nbody[2], nface[2], ndiff;
+  double     volume[2];
+  const char **tags[2];
+  ego        model[2];
+
+  stat = EG_generalBoolean(src, tool, SUBTRACTION, 0.0, &model[0]);
+  if (stat != EGADS_SUCCESS) {
+    printf(" %s: EG_generalBoolean = %d\n", title, stat);
+    return 1;
+  }
+  stat = EG_clusterBoolean(src, tool, SUBTRACTION, 0.0, &model[1]);
+  if (stat != EGADS_SUCCESS) {
+    printf(" %s: EG_clusterBoolean = %d\n", title, stat);
+    EG_deleteObject(model[0]);
+    return 1;
+  }
+  for (i = 0; i < 2; i++) {
+    stat = modelInfo(model[i], &nbody[i], &nface[i], &volume[i], &tags[i]);
+    if (stat != EGADS_SUCCESS) {
+      printf(" %s: modelInfo %d = %d\n", title, i, stat);
+      if (i == 1) EG_free(tags[0]);
+      EG_deleteObject(model[1]);
+      EG_deleteObject(model[0]);
+      return 1;
+    }
+  }
+
+  ndiff = 0;
+  if (nface[0] == nface[1])
+    for (i = 0; i < nface[0]; i++)
+      if (strcmp(tags[0][i], tags[1][i]) != 0) ndiff++;
+  printf(" %s: Bodies %d %d  Faces %d %d  Volume %lf %lf  tag diffs = %d\n",
+         title, nbody[0], nbody[1], nface[0], nface[1], volume[0], volume[1],
+         ndiff);
+  stat = 0;
+  if ((nbody[0] != nbody[1]) || (nface[0] != nface[1]) || (ndiff != 0) ||
+      (fabs(volume[0]-volume[1]) > 1.e-8*fabs(volume[0]))) {
+    printf(" %s: MISMATCH!\n", title);
+    stat = 1;
+  }
+
+  EG_free(tags[1]);
+  EG_free(tags[0]);
+  EG_deleteObject(model[1]);
+  EG_deleteObject(model[0]);
+  return stat;
+}
+
+
+int main(int argc, char *argv[])
+{
+  int    i, stat, nerr;
+  char   prefix[32];
+  double data[7];
+  ego    context, panels[2], tools[6], hits[3], src, tool, body, hit;
+  /* hole centers -- 3 through each panel (two overlap) and one that misses */
+  static double holes[6][2] = { {2.0, 2.0}, {2.5, 2.5}, {7.0, 6.0},
+                                {22.0, 3.0}, {26.0, 7.0}, {50.0, 50.0} };
+
+  printf(" EG_open           = %d\n", EG_open(&context));
+
+  /* two panels far apart */
+  for (i = 0; i < 2; i++) {
+    data[0] = 20.0*i;
+    data[1] = data[2] = 0.0;
+    data[3] = data[4] = 10.0;
+    data[5] = 1.0;
+    stat = EG_makeSolidBody(context, BOX, data, &panels[i]);
+    if (stat != EGADS_SUCCESS) {
+      printf(" EG_makeSolidBody panel %d = %d\n", i+1, stat);
+      return 1;
+    }
+    snprintf(prefix, 32, "panel %d", i+1);
+    tagFaces(panels[i], prefix);
+  }
+  for (i = 0; i < 6; i++) {
+    data[0] = data[3] = holes[i][0];
+    data[1] = data[4] = holes[i][1];
+    data[2] = -1.0;
+    data[5] =  2.0;
+    data[6] =  0.75;
+    stat = EG_makeSolidBody(context, CYLINDER, data, &tools[i]);
+    if (stat != EGADS_SUCCESS) {
+      printf(" EG_makeSolidBody tool %d = %d\n", i+1, stat);
+      return 1;
+    }
+    snprintf(prefix, 32, "tool %d", i+1);
+    tagFaces(tools[i], prefix);
+  }
+
+  /* one cluster per panel */
+  nerr = 0;
+  printf(" EG_makeTopology   = %d\n", EG_makeTopology(context, NULL, MODEL, 0,
+                                                      NULL, 2, panels, NULL,
+                                                      &src));
+  printf(" EG_makeTopology   = %d\n", EG_makeTopology(context, NULL, MODEL, 0,
+                                                      NULL, 6, tools, NULL,
+                                                      &tool));
+  nerr += compare("2 panels ", src, tool);
+
+  /* one panel with all of the tools -- those that miss it are dropped */
+  printf(" EG_copyObject     = %d\n", EG_copyObject(panels[0], NULL, &body));
+  nerr += compare("1 panel  ", body, tool);
+
+  /* only the tools that hit it -- a single cluster runs the single-shot SBO */
+  for (i = 0; i < 3; i++)
+    printf(" EG_copyObject     = %d\n", EG_copyObject(tools[i], NULL, &hits[i]));
+  printf(" EG_makeTopology   = %d\n", EG_makeTopology(context, NULL, MODEL, 0,
+                                                      NULL, 3, hits, NULL,
+                                                      &hit));
+  nerr += compare("1 cluster", body, hit);
+
+  printf(" EG_deleteObject   = %d\n", EG_deleteObject(hit));
+  printf(" EG_deleteObject   = %d\n", EG_deleteObject(body));
+  printf(" EG_deleteObject   = %d\n", EG_deleteObject(tool));
+  printf(" EG_deleteObject   = %d\n", EG_deleteObject(src));
+  printf(" EG_close          = %d\n", EG_close(context));
+  return nerr;
+}
@@ -0,0 +1,142 @@
+/*
+ *      EGADS: Electronic Geometry Aircraft Design System
+ *
+ *             Check that a fast EG_close does not leak
+ *
+ *      Copyright 2011-2022, Massachusetts Institute of Technology
+ *      Licensed under The GNU Lesser General Public License, version 2.1
+ *      See http://www.opensource.org/licenses/lgpl-2.1.php
+ *
+ */
+
+#include "egads.h"
+
+#if defined(__GLIBC__) && ((__GLIBC__ > 2) || (__GLIBC_MINOR__ >= 33))
+#include <malloc.h>
+#define INUSE
+#endif
+
+#define NCYCLE 10
+
+
+#ifdef INUSE
+static long
+inUse()
+{
+  return (long) mallinfo2().uordblks;
+}
+#endif
+
+
+/* one Context with every kind of Object left open at the close */
+static int
+cycle(int fast)
+{
+  int    i, stat, nface;
+  double data[7], params[3], xform[12];
+  ego    context, box, cyl, copy, model, tess, ebody, line, xf, *faces;
+
+  stat = EG_open(&context);
+  if (stat != EGADS_SUCCESS) return stat;
+  EG_setOutLevel(context, 0);
+  stat = EG_setFastClose(context, fast);
+  if (stat < EGADS_SUCCESS) return stat;
+
+  data[0] = data[1] = data[2] = 0.0;
+  data[3] = 1.0;
+  data[4] = 2.0;
+  data[5] = 3.0;
+  stat = EG_makeSolidBody(context, BOX, data, &box);
+  if (stat != EGADS_SUCCESS) return stat;
+  stat = EG_getBodyTopos(box, NULL, FACE, &nface, &faces);
+  if (stat != EGADS_SUCCESS) return stat;
+  for (i = 0; i < nface; i++)
+    EG_attributeAdd(faces[i], "face", ATTRINT, 1, &i, NULL, NULL);
+  EG_free(faces);
+
+  data[3] = data[4] = 0.0;
+  data[5] = 4.0;
+  data[6] = 0.5;
+  stat = EG_makeSolidBody(context, CYLINDER, data, &cyl);
+  if (stat != EGADS_SUCCESS) return stat;
+  stat = EG_copyObject(cyl, NULL, &copy);
+  if (stat != EGADS_SUCCESS) return stat;
+  stat = EG_makeTopology(context, NULL, MODEL, 0, NULL, 1, &copy, NULL,
+                         &model);
+  if (stat != EGADS_SUCCESS) return stat;
+
+  /* a Tessellation and an EBody on the box */
+  params[0] = 0.1;
+  params[1] = 0.01;
+  params[2] = 15.0;
+  stat = EG_makeTessBody(box, params, &tess);
+  if (stat != EGADS_SUCCESS) return stat;
+  stat = EG_initEBody(tess, 10.0, &ebody);
+  if (stat != EGADS_SUCCESS) return stat;
+  stat = EG_finishEBody(ebody);
+  if (stat != EGADS_SUCCESS) return stat;
+
+  /* loose geometry and a transform */
+  data[3] = data[4] = data[5] = 1.0;
+  stat = EG_makeGeometry(context, CURVE, LINE, NULL, NULL, data, &line);
+  if (stat != EGADS_SUCCESS) return stat;
+  for (i = 0; i < 12; i++) xform[i] = 0.0;
+  xform[0] = xform[5] = xform[10] = 1.0;
+  xform[3] = 2.0;
+  stat = EG_makeTransform(context, xform, &xf);
+  if (stat != EGADS_SUCCESS) return stat;
+
+  /* the cylinder goes, the box is still held by its Tessellation */
+  EG_deleteObject(cyl);
+  EG_deleteObject(box);
+
+  return EG_close(context);
+}
+
+
+int main(int argc, char *argv[])
+{
+  int    i, fast, stat;
+#ifdef INUSE
+  long   start, grow[2];
+#endif
+
+  /* warm up -- lazy allocations in OCC are made once */
+  for (fast = 0; fast < 2; fast++) {
+    stat = cycle(fast);
+    if (stat != EGADS_SUCCESS) {
+      printf(" cycle fast = %d: %d\n", fast, stat);
+      return 1;
+    }
+  }
+
+  for (fast = 0; fast < 2; fast++) {
+#ifdef INUSE
+    start = inUse();
+#endif
+    for (i = 0; i < NCYCLE; i++) {
+      stat = cycle(fast);
+      if (stat != EGADS_SUCCESS) {
+        printf(" cycle %d fast = %d: %d\n", i+1, fast, stat);
+        return 1;
+      }
+    }
+#ifdef INUSE
+    grow[fast] = inUse() - start;
+    printf(" fast = %d: %d cycles, %ld bytes left in use\n", fast, NCYCLE,
+           grow[fast]);
+#endif
+  }
+
+#ifdef INUSE
+  /* the fast close must not leave behind more than the normal close */
+  if (grow[1] > grow[0]) {
+    printf(" fast close leaks %ld bytes per cycle!\n",
+           (grow[1]-grow[0])/NCYCLE);
+    return 1;
+  }
+#else
+  printf(" no malloc statistics -- run under a leak checker!\n");
+#endif
+  return 0;
+}
@@ -0,0 +1,149 @@
+/*
+ *      EGADS: Electronic Geometry Aircraft Design System
+ *
+ *             Compare EG_approximateBatch with EG_approximate
+ *
+ *      Copyright 2011-2022, Massachusetts Institute of Technology
+ *      Licensed under The GNU Lesser General Public License, version 2.1
+ *      See http://www.opensource.org/licenses/lgpl-2.1.php
+ *
+ */
+
+#include <math.h>
+#include "egads.h"
+
+#define NFIT 8
+
+
+/* the number of reals in a BSpline's data */
+static int
+splineLen(int oclass, const int *header)
+{
+  int len;
+
+  if (oclass == CURVE) {
+    len = header[3] + 3*header[2];
+    if ((header[0]&2) != 0) len += header[2];
+  } else {
+    len = header[3] + header[6] + 3*header[2]*header[5];
+    if ((header[0]&2) != 0) len += header[2]*header[5];
+  }
+  return len;
+}
+
+
+/* compare two BSplines bit for bit */
+static int
+sameSpline(ego geom1, ego geom2)
+{
+  int    i, stat, len, oclass[2], mtype[2], *header[2];
+  double *data[2];
+  ego    ref;
+
+  stat = EG_getGeometry(geom1, &oclass[0], &mtype[0], &ref, &header[0],
+                        &data[0]);
+  if (stat != EGADS_SUCCESS) return stat;
+  stat = EG_getGeometry(geom2, &oclass[1], &mtype[1], &ref, &header[1],
+                        &data[1]);
+  if (stat != EGADS_SUCCESS) {
+    EG_free(header[0]);
+    EG_free(data[0]);
+    return stat;
+  }
+
+  stat = EGADS_SUCCESS;
+  if ((oclass[0] != oclass[1]) || (mtype[0] != BSPLINE) ||
+      (mtype[1] != BSPLINE)) {
+    stat = EGADS_GEOMERR;
+  } else {
+    len = oclass[0] == CURVE ? 4 : 7;
+    for (i = 0; i < len; i++)
+      if (header[0][i] != header[1][i]) stat = EGADS_GEOMERR;
+    if (stat == EGADS_SUCCESS) {
+      len = splineLen(oclass[0], header[0]);
+      for (i = 0; i < len; i++)
+        if (data[0][i] != data[1][i]) stat = EGADS_GEOMERR;
+    }
+  }
+
+  EG_free(header[1]);
+  EG_free(data[1]);
+  EG_free(header[0]);
+  EG_free(data[0]);
+  return stat;
+}
+
+
+int main(int argc, char *argv[])
+{
+  int          i, j, k, stat, nerr, sizes[2*NFIT];
+  double       t, s, *xyzs[NFIT];
+  const double *data[NFIT];
+  ego          context, batch[NFIT], single;
+  /* helices with different point counts, a line and a bump surface */
+  static int   npts[NFIT] = { 9, 17, 33, 65, 129, 200, 2, 0 };
+
+  printf(" EG_open           = %d\n", EG_open(&context));
+
+  for (i = 0; i < NFIT; i++) {
+    sizes[2*i  ] = npts[i];
+    sizes[2*i+1] = 0;
+    if (npts[i] == 0) {
+      sizes[2*i  ] = 12;
+      sizes[2*i+1] = 10;
+    }
+    xyzs[i] = (double *) EG_alloc(3*sizes[2*i]*
+                                  (sizes[2*i+1] == 0 ? 1 : sizes[2*i+1])*
+                                  sizeof(double));
+    if (xyzs[i] == NULL) {
+      printf(" EG_alloc %d = NULL!\n", i+1);
+      return 1;
+    }
+    data[i] = xyzs[i];
+    if (sizes[2*i+1] == 0) {
+      for (j = 0; j < sizes[2*i]; j++) {
+        t = (double) j/(sizes[2*i]-1);
+        xyzs[i][3*j  ] = cos(4.0*t*(i+1));
+        xyzs[i][3*j+1] = sin(4.0*t*(i+1));
+        xyzs[i][3*j+2] = t;
+      }
+    } else {
+      for (j = 0; j < sizes[2*i+1]; j++) {
+        s = (double) j/(sizes[2*i+1]-1);
+        for (k = 0; k < sizes[2*i]; k++) {
+          t = (double) k/(sizes[2*i]-1);
+          xyzs[i][3*(j*sizes[2*i]+k)  ] = t;
+          xyzs[i][3*(j*sizes[2*i]+k)+1] = s;
+          xyzs[i][3*(j*sizes[2*i]+k)+2] = 0.1*sin(3.0*t)*cos(2.0*s);
+        }
+      }
+    }
+  }
+
+  /* the fits together and one at a time must be the same */
+  nerr = 0;
+  stat = EG_approximateBatch(context, 0, 1.e-7, NFIT, sizes, data, batch);
+  printf(" EG_approximateBatch = %d\n", stat);
+  if (stat != EGADS_SUCCESS) return 1;
+  for (i = 0; i < NFIT; i++) {
+    stat = EG_approximate(context, 0, 1.e-7, &sizes[2*i], data[i], &single);
+    if (stat != EGADS_SUCCESS) {
+      printf(" EG_approximate %d = %d\n", i+1, stat);
+      nerr++;
+      continue;
+    }
+    stat = sameSpline(batch[i], single);
+    printf(" fit %d (%d x %d): same = %d\n", i+1, sizes[2*i], sizes[2*i+1],
+           stat);
+    if (stat != EGADS_SUCCESS) nerr++;
+    EG_deleteObject(single);
+  }
+
+  for (i = 0; i < NFIT; i++) {
+    EG_deleteObject(batch[i]);
+    EG_free(xyzs[i]);
+  }
+  printf(" EG_close          = %d\n", EG_close(context));
+  if (nerr != 0) printf(" %d fits differ!\n", nerr);
+  return nerr;
+}
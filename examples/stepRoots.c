@@ -0,0 +1,188 @@
+/*
+ *      EGADS: Electronic Geometry Aircraft Design System
+ *
+ *             Compare concurrent (bflg 32) & serial multi-root STEP reads
+ *
+ *      Copyright 2011-2022, Massachusetts Institute of Technology
+ *      Licensed under The GNU Lesser General Public License, version 2.1
+ *      See http://www.opensource.org/licenses/lgpl-2.1.php
+ *
+ */
+
+#include <math.h>
+#include <string.h>
+#include "egads.h"
+
+#define NBODY 6
+
+
+static int
+cmpName(const void *a, const void *b)
+{
+  return strcmp(*(const char **) a, *(const char **) b);
+}
+
+
+/* the Face count, volume and sorted Face Names of a Body */
+static int
+bodyInfo(ego body, int *nface, double *volume, const char ***names)
+{
+  int          i, stat, atype, alen;
+  const int    *ints;
+  const double *reals;
+  const char   *str, **list;
+  double       props[14];
+  ego          *faces;
+
+  *names = NULL;
+  stat   = EG_getMassProperties(body, props);
+  if (stat != EGADS_SUCCESS) return stat;
+  *volume = props[0];
+  stat    = EG_getBodyTopos(body, NULL, FACE, nface, &faces);
+  if (stat != EGADS_SUCCESS) return stat;
+  list = (const char **) EG_alloc(*nface*sizeof(char *));
+  if (list == NULL) {
+    EG_free(faces);
+    return EGADS_MALLOC;
+  }
+  for (i = 0; i < *nface; i++) {
+    list[i] = "";
+    stat    = EG_attributeRet(faces[i], "Name", &atype, &alen, &ints, &reals,
+                              &str);
+    if ((stat == EGADS_SUCCESS) && (atype == ATTRSTRING)) list[i] = str;
+  }
+  EG_free(faces);
+  qsort(list, *nface, sizeof(char *), cmpName);
+  *names = list;
+
+  return EGADS_SUCCESS;
+}
+
+
+/* the serial & concurrent reads must give the same Bodies in the same order */
+static int
+compare(ego model0, ego model1)
+{
+  int        i, j, stat, oclass, mtype, nbody[2], nface[2], *senses, nerr;
+  double     volume[2];
+  const char **names[2];
+  ego        geom, *bodies[2];
+
+  for (i = 0; i < 2; i++) {
+    stat = EG_getTopology(i == 0 ? model0 : model1, &geom, &oclass, &mtype,
+                          NULL, &nbody[i], &bodies[i], &senses);
+    if (stat != EGADS_SUCCESS) return 1;
+  }
+  printf(" Bodies: serial %d  concurrent %d\n", nbody[0], nbody[1]);
+  if ((nbody[0] != nbody[1]) || (nbody[0] != NBODY)) return 1;
+
+  nerr = 0;
+  for (i = 0; i < nbody[0]; i++) {
+    for (j = 0; j < 2; j++) {
+      stat = bodyInfo(bodies[j][i], &nface[j], &volume[j], &names[j]);
+      if (stat != EGADS_SUCCESS) {
+        printf(" Body %d: bodyInfo %d = %d\n", i+1, j, stat);
+        if (j == 1) EG_free(names[0]);
+        return nerr+1;
+      }
+    }
+    stat = 0;
+    if ((nface[0] != nface[1]) ||
+        (fabs(volume[0]-volume[1]) > 1.e-10*fabs(volume[0]))) {
+      stat = 1;
+    } else {
+      for (j = 0; j < nface[0]; j++)
+        if (strcmp(names[0][j], names[1][j]) != 0) stat = 1;
+    }
+    printf(" Body %d: Faces %d %d  Volume %lf %lf  first Name %s %s%s\n",
+           i+1, nface[0], nface[1], volume[0], volume[1], names[0][0],
+           names[1][0], stat == 0 ? "" : "  MISMATCH!");
+    nerr += stat;
+    EG_free(names[1]);
+    EG_free(names[0]);
+  }
+
+  return nerr;
+}
+
+
+int main(int argc, char *argv[])
+{
+  int        i, j, stat, major, minor, occ[2], nface, nerr;
+  char       name[32];
+  double     data[10];
+  const char *occrev, *str;
+  ego        context, bodies[NBODY], *faces, model, model0, model1;
+
+  EG_revision(&major, &minor, &occrev);
+  occ[0] = occ[1] = 0;
+  str    = strstr(occrev, "OpenCASCADE ");
+  if (str != NULL) sscanf(&str[12], "%d.%d", &occ[0], &occ[1]);
+  printf(" EGADS %d.%d %s\n", major, minor, occrev);
+
+  printf(" EG_open           = %d\n", EG_open(&context));
+
+  /* unrelated solids -- each is a STEP root */
+  for (i = 0; i < NBODY; i++) {
+    for (j = 0; j < 10; j++) data[j] = 0.0;
+    data[0] = 3.0*i;
+    if (i%3 == 0) {
+      data[3] = 1.0;
+      data[4] = 2.0;
+      data[5] = 1.0 + 0.5*i;
+      stat    = EG_makeSolidBody(context, BOX, data, &bodies[i]);
+    } else if (i%3 == 1) {
+      data[3] = data[0];
+      data[5] = 2.0;
+      data[6] = 0.25*i;
+      stat    = EG_makeSolidBody(context, CYLINDER, data, &bodies[i]);
+    } else {
+      data[3] = 0.2*i;
+      stat    = EG_makeSolidBody(context, SPHERE, data, &bodies[i]);
+    }
+    if (stat != EGADS_SUCCESS) {
+      printf(" EG_makeSolidBody %d = %d\n", i+1, stat);
+      return 1;
+    }
+    stat = EG_getBodyTopos(bodies[i], NULL, FACE, &nface, &faces);
+    if (stat != EGADS_SUCCESS) return 1;
+    for (j = 0; j < nface; j++) {
+      snprintf(name, 32, "body%d_face%d", i+1, j+1);
+      EG_attributeAdd(faces[j], "Name", ATTRSTRING, 0, NULL, NULL, name);
+    }
+    EG_free(faces);
+  }
+  printf(" EG_makeTopology   = %d\n", EG_makeTopology(context, NULL, MODEL, 0,
+                                                      NULL, NBODY, bodies,
+                                                      NULL, &model));
+  remove("stepRoots.step");
+  printf(" EG_saveModel      = %d\n", EG_saveModel(model, "stepRoots.step"));
+  printf(" EG_deleteObject   = %d\n", EG_deleteObject(model));
+
+  stat = EG_loadModel(context, 0, "stepRoots.step", &model0);
+  printf(" EG_loadModel      = %d\n", stat);
+  if (stat != EGADS_SUCCESS) return 1;
+  stat = EG_loadModel(context, 32, "stepRoots.step", &model1);
+  printf(" EG_loadModel 32   = %d\n", stat);
+
+  nerr = 0;
+  if ((occ[0] < 7) || ((occ[0] == 7) && (occ[1] < 8))) {
+    /* before 7.8 the concurrent transfers are refused */
+    if (stat != EGADS_RANGERR) {
+      printf(" OpenCASCADE %d.%d: bflg 32 must be refused!\n", occ[0], occ[1]);
+      nerr++;
+    }
+    if (stat == EGADS_SUCCESS) EG_deleteObject(model1);
+  } else if (stat != EGADS_SUCCESS) {
+    nerr++;
+  } else {
+    nerr += compare(model0, model1);
+    printf(" EG_deleteObject   = %d\n", EG_deleteObject(model1));
+  }
+
+  printf(" EG_deleteObject   = %d\n", EG_deleteObject(model0));
+  printf(" EG_close          = %d\n", EG_close(context));
+  remove("stepRoots.step");
+  if (nerr != 0) printf(" %d errors!\n", nerr);
+  return nerr;
+}
@@ -192,8 +192,7 @@ int main(int argc, char *argv[])
     /* make the quads */
     printf("\n");
     EG_setOutLevel(context, 0);
-    for (i = 0 ; i < bodydata[ibody].nfaces; i++)
-      EG_makeQuads(bodydata[ibody].tess, qparam, i+1);
+    EG_makeQuadsBatch(bodydata[ibody].tess, qparam, 0, NULL);
     EG_setOutLevel(context, 1);
   }
   printf(" \n");
@@ -76,6 +76,9 @@ __ProtoExt__ int  EG_copyObject( const ego object, /*@null@*/ void *oform,
                                  ego *copy );
 __ProtoExt__ int  EG_flipObject( const ego object, ego *flippedCopy );
 __ProtoExt__ int  EG_close( ego context );
+/* flag = 1: EG_close frees each Object's contents top-down without the
+   reference bookkeeping (still one Object at a time), then the slabs */
+__ProtoExt__ int  EG_setFastClose( ego context, int flag );
 __ProtoExt__ int  EG_setUserPointer( ego context, void *ptr );
 __ProtoExt__ int  EG_getUserPointer( const ego context, void **ptr );
 
@@ -128,15 +131,30 @@ __ProtoExt__ int  EG_invEvaluateGuess( const ego geom, double *xyz,
                                        double *param, double *results );
 __ProtoExt__ int  EG_arcLength( const ego geom, double t1, double t2,
                                 double *alen );
+__ProtoExt__ int  EG_arcLengthBatch( const ego geom, double t1, int n,
+                                     const double *ts, double *alens );
+__ProtoExt__ int  EG_invArcLength( const ego geom, double t1, double alen,
+                                   double *t );
+__ProtoExt__ int  EG_invArcLengthBatch( const ego geom, double t1, int n,
+                                        const double *alens, double *ts );
 __ProtoExt__ int  EG_curvature( const ego geom, const double *param, 
                                 double *results );
 __ProtoExt__ int  EG_approximate( ego context, int maxdeg, double tol,
                                   const int *sizes, const double *xyzs,
                                   ego *bspline );
+__ProtoExt__ int  EG_approximateBatch( ego context, int maxdeg, double tol,
+                                       int nfit, const int *sizes,
+                                       const double **xyzs, ego *bsplines );
 __ProtoExt__ int  EG_fitTriangles( ego context, int npts, double *xyzs,
                                    int ntris, const int *tris,
                                    /*@null@*/ const int *tric, double tol,
                                    ego *bspline );
+/* xyzs & tris are only read -- they may be memory-mapped by the caller, who
+   owns (and must keep) the mapping until EG_fitTrianglesStream returns */
+__ProtoExt__ int  EG_fitTrianglesStream( ego context, int npts,
+                                         const double *xyzs, int ntris,
+                                         const int *tris, int maxpts,
+                                         double tol, ego *bspline );
 __ProtoExt__ int  EG_otherCurve( const ego surface, const ego curve,
                                  double tol, ego *newcurve );
 __ProtoExt__ int  EG_isSame( const ego geom1, const ego geom2 );
@@ -173,6 +191,8 @@ __ProtoExt__ int  EG_indexBodyTopo( const ego body, const ego src );
 __ProtoExt__ int  EG_objectBodyTopo( const ego body, int oclass, int index,
                                      ego *obj );
 __ProtoExt__ int  EG_inTopology( const ego topo, const double *xyz );
+__ProtoExt__ int  EG_inTopologyBatch( const ego topo, int npts,
+                                      const double *xyzs, int *results );
 __ProtoExt__ int  EG_inFace( const ego face, const double *uv );
 __ProtoExt__ int  EG_getEdgeUV( const ego face, const ego edge, int sense,
                                 double t, double *UV );
@@ -188,6 +208,9 @@ __ProtoExt__ int  EG_getBoundingBox( const ego topo, double *bbox );
 __ProtoExt__ int  EG_getMassProperties( const ego topo, 
                                         /*@null@*/ double *result );
 __ProtoExt__ int  EG_isEquivalent( const ego topo1, const ego topo2 );
+__ProtoExt__ int  EG_fingerprint( const ego object, int flag, double *print );
+__ProtoExt__ int  EG_matchObjects( int nobj, const ego *objs, int flag,
+                                   int *nmatch, int **match );
 __ProtoExt__ int  EG_sewFaces( int nobj, const ego *objs, double toler,
                                int flag, ego *result );
 __ProtoExt__ int  EG_makeNmWireBody( int nobj, const ego *objs, double toler,
@@ -230,6 +253,8 @@ __ProtoExt__ int  EG_getTessLoops( const ego tess, int fIndex, int *nloop,
 __ProtoExt__ int  EG_getTessQuads( const ego tess, int *nquad,
                                    int **fIndices );
 __ProtoExt__ int  EG_makeQuads( ego tess, double *params, int fIndex );
+__ProtoExt__ int  EG_makeQuadsBatch( ego tess, double *params, int nIndex,
+                                     /*@null@*/ const int *fIndices );
 __ProtoExt__ int  EG_getQuads( const ego tess, int fIndex, int *len, 
                                   const double **xyz, const double **uv, 
                                   const int **ptype, const int **pindex, 
@@ -245,6 +270,9 @@ __ProtoExt__ int  EG_deleteEdgeVert( ego tess, int eIndex, int vIndex,
                                      int dir );
 __ProtoExt__ int  EG_moveEdgeVert( ego tess, int eIndex, int vIndex, 
                                    double t );
+__ProtoExt__ int  EG_beginEdgeEdits( ego tess );
+__ProtoExt__ int  EG_commitEdgeEdits( ego tess );
+__ProtoExt__ int  EG_abortEdgeEdits( ego tess );
  
 __ProtoExt__ int  EG_openTessBody( ego tess );
 __ProtoExt__ int  EG_initTessBody( ego object, ego *tess );
@@ -268,10 +296,15 @@ __ProtoExt__ int  EG_tessMassProps( const ego tess, double *props );
 __ProtoExt__ int  EG_fuseSheets( const ego src, const ego tool, ego *sheet );
 __ProtoExt__ int  EG_generalBoolean( ego src, ego tool, int oper, double tol,
                                      ego *model );
+__ProtoExt__ int  EG_clusterBoolean( ego src, ego tool, int oper, double tol,
+                                     ego *model );
 __ProtoExt__ int  EG_solidBoolean( const ego src, const ego tool, int oper, 
                                    ego *model );
 __ProtoExt__ int  EG_intersection( const ego src, const ego tool, int *nedge, 
                                    /*@null@*/ ego **facEdg, ego *model );
+__ProtoExt__ int  EG_intersectionBatch( const ego src, int ntool,
+                                        const ego *tools, int *nedge,
+                                        /*@null@*/ ego **facEdg, ego *model );
 __ProtoExt__ int  EG_imprintBody( const ego src, int nedge, const ego *facEdg, 
                                   ego *result );
 __ProtoExt__ int  EG_filletBody( const ego src, int nedge, const ego *edges, 
@@ -313,6 +346,8 @@ __ProtoExt__ int  EG_effectiveTri( ego EObj, double *uv, int *fIndex, int *itri,
 
 __ProtoExt__ int  EG_inTriExact( double *t1, double *t2, double *t3, double *p,
                                  double *w );
+__ProtoExt__ int  EG_inTriExactBatch( double *t1, double *t2, double *t3,
+                                      int n, double *p, double *w, int *in );
 #ifdef __cplusplus
 }
 #endif
@@ -152,6 +152,7 @@ typedef struct {
   egAttr    *attrs;             /* the attributes */
   int       nseqs;              /* number of sequenced attributes */
   egAttrSeq *seqs;              /* the sequenced attributes */
+  int       nref;               /* objects sharing the block (copy on write) */
 } egAttrs;
 
 
@@ -181,6 +182,9 @@ typedef struct {
   void     *mutex;              /* this thread's mutex */
   egObject *pool;               /* available object structures for use */
   egObject *last;               /* the last object in the list */
+  int      fastClose;           /* skip the dereferencing at close */
+  void     *slabs;              /* blocks of object structures */
+  void     *names;              /* interned attribute names */
 } egCntxt;
 
 
@@ -245,6 +249,7 @@ typedef struct {
   egTess1D *tess1d;             /* Edge tessellations */
   egTess2D *tess2d;             /* Face tessellations (tris then quads) */
   int      *globals;            /* global definitions */
+  void     *edits;              /* queued Edge vertex edits (or NULL) */
   double   params[6];           /* suite of parameters used */
   double   tparam[MTESSPARAM];
   int      nGlobal;             /* number of Global vertices */
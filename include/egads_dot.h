@@ -45,6 +45,12 @@ __ProtoExt__ int  EG_evaluate_dot( const ego geom,
                                    /*@null@*/ const double *params,
                                    /*@null@*/ const double *params_dot,
                                    double *results, double *results_dot );
+__ProtoExt__ int  EG_arcLength_dot( const ego geom, double t1, double t1_dot,
+                                    double t2, double t2_dot,
+                                    double *alen, double *alen_dot );
+__ProtoExt__ int  EG_invArcLength_dot( const ego geom, double t1, double t1_dot,
+                                       double alen, double alen_dot,
+                                       double *t, double *t_dot );
 __ProtoExt__ int  EG_approximate_dot( ego bspline, int mDeg, double tol,
                                       const int *sizes,
                                       const double *xyzs, const double *xyzs_dot );
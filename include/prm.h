@@ -20,6 +20,13 @@
 #define PRM_OK_FLOATER        6
 #define PRM_OK_UNROLLING      7
 
+#define PRM_SOLVE_BCG         0     /* biconjugate gradient (default) */
+#define PRM_SOLVE_ILU         1     /* ILU(0) preconditioned BiCGSTAB */
+#define PRM_SOLVE_BENCH       2     /* run both, report wall times, keep ILU */
+
+#define PRM_RELAX_SOR         0     /* lexicographic SOR (default) */
+#define PRM_RELAX_COLOR       1     /* multi-color SOR over the thread team */
+
 #define PRM_NOTCONVERGED   -401
 #define PRM_BADNUMVERTICES -402
 #define PRM_ZEROPIVOT      -403
@@ -238,6 +245,25 @@ prm_NormalizeUV(double  halo,           /* (in)   halo size */
 extern int
 prm_LimitGridSize(int      limit);      /* (in)   global size limit */
 
+/*
+ * select the sparse solver used by the Cfit and Grid fits
+ *      (a failed ILU solve falls back to the biconjugate gradient)
+ *      returns:  CAPS_SUCCESS
+ *                PRM_BADPARAM
+ */
+extern int
+prm_SetSolver(int      method);         /* (in)   PRM_SOLVE_BCG, _ILU or _BENCH */
+
+/*
+ * select the relaxation used by the Floater parameterization
+ *      (the colored sweeps run in parallel but change the order of the
+ *       updates, and so the resulting UVs)
+ *      returns:  CAPS_SUCCESS
+ *                PRM_BADPARAM
+ */
+extern int
+prm_SetRelax(int      method);          /* (in)   PRM_RELAX_SOR or _COLOR */
+
 /*
  * set up a fixed Cfit for a set of Vertices
  *      returns:  CAPS_SUCCESS
@@ -339,6 +365,37 @@ prm_BestGrid(int      nvrt,             /* (in)   number of Vertices */
              double   *maxerr,          /* (out)  maximum error at Vertices */
              double   *dotmin);         /* (out)  minimum dot product */
 
+/*
+ * prm_BestGrid that also returns the final Grid Tree (for prm_EvalGrid)
+ *      returns:  CAPS_SUCCESS
+ *                PRM_TOLERANCEUNMET
+ *                PRM_NOTCONVERGED
+ *                PRM_BADPARAM
+ */
+extern int
+prm_BestGridTree(int      nvrt,         /* (in)   number of Vertices */
+                 int      nvar,         /* (in)   number of dependent vars */
+                 prmUV    uv[],         /* (in)   array  of Parameters */
+                 double   var[],        /* (in)   array  of dependent vars */
+                 int      ntri,         /* (in)   number of Tris (optional) */
+      /*@null@*/ prmTri   tri[],        /* (in)   array  if Tris (optional) */
+                 double   tol,          /* (in)   tolerance on maximum error */
+                 int      periodic,     /* (in)   = 0  no periodicity */
+                                        /*        = 1  periodic in U */
+                                        /*        = 2  periodic in V */
+      /*@null@*/ int      ppnts[],      /* (in)   indices of periodic points */
+                 int      *nu,          /* (in)   limit on nu if > 0 */
+                                        /* (out)  number of Knots in U-dirn */
+                 int      *nv,          /* (in)   limit on nv if > 0 */
+                                        /* (out)  number of Knots in V-dirn */
+                 double   *grid[],      /* (out)  pointer to Grid of Knots
+                                                  NOTE: user must EG_free after use */
+                 double   *rmserr,      /* (out)  RMS     error at Vertices */
+                 double   *maxerr,      /* (out)  maximum error at Vertices */
+                 double   *dotmin,      /* (out)  minimum dot product */
+      /*@null@*/ gridTree *tree);       /* (out)  final Grid Tree
+                                                  NOTE: user must prm_FreeGrid after use */
+
 /*
  * evaluate the Cfit at the given uu
  *      returns:  CAPS_SUCCESS
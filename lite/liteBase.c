@@ -48,6 +48,8 @@ __PROTO_H_AND_D__ int  EG_importModel( egObject *context, const size_t nbytes,
                                        const char *stream, egObject **model );
 __PROTO_H_AND_D__ int  EG_exactInit( );
 __PROTO_H_AND_D__ void uvmap_struct_free( void *uvmap );
+__PROTO_H_AND_D__ void EG_cleanupEdgeEdits( egTessel *btess );
+__PROTO_H_AND_D__ void EG_freeClassify( void *classify );
 
 
 static const char *EGADSprop[2] = {STR(EGADSPROP),
@@ -116,6 +118,7 @@ EG_freeBlind(egObject *object)
     if (tess != NULL) {
       egTessel tess_, *tess_h = &tess_;
       EG_GET_TESSEL(tess_h, tess);
+      EG_cleanupEdgeEdits(tess_h);
       if (tess_h->xyzs != NULL) EG_FREE(tess_h->xyzs);
       if (tess_h->tess1d != NULL) {
         egTess1D tess1d_, *tess1d_h = &tess1d_;
@@ -213,6 +216,7 @@ EG_freeBlind(egObject *object)
     lshell = (liteShell *) object_h->blind;
     EG_GET_SHELL(lshell_h, lshell);
     EG_FREE(lshell_h->faces);
+    if (lshell_h->classify != NULL) EG_freeClassify(lshell_h->classify);
   } else if (object_h->oclass == BODY) {
     liteBody lbody_, *lbody_h = &lbody_;
     lbody = (liteBody *) object_h->blind;
@@ -226,6 +230,7 @@ EG_freeBlind(egObject *object)
     EG_FREE(lbody_h->faces.objs);
     EG_FREE(lbody_h->shells.objs);
     EG_FREE(lbody_h->senses);
+    if (lbody_h->classify != NULL) EG_freeClassify(lbody_h->classify);
   } else if (object_h->oclass == MODEL) {
     liteModel lmodel_, *lmodel_h = &lmodel_;
     lmodel = (liteModel *) object_h->blind;
@@ -370,6 +375,9 @@ EG_open(egObject **context)
   cntx_h->mutex      = EMP_LockCreate();
   cntx_h->pool       = NULL;
   cntx_h->last       = object;
+  cntx_h->fastClose  = 0;
+  cntx_h->slabs      = NULL;
+  cntx_h->names      = NULL;
   if (cntx_h->mutex == NULL)
     printf(" EMP Error: mutex creation = NULL (EG_open)!\n");
   EG_SET_CNTXT(cntx, cntx_h);
@@ -635,6 +643,7 @@ EG_deleteObject(egObject *object)
     if (tess != NULL) {
       egTessel tess_, *tess_h = &tess_;
       EG_GET_TESSEL(tess_h, tess);
+      EG_cleanupEdgeEdits(tess_h);
       if (tess_h->xyzs != NULL) EG_FREE(tess_h->xyzs);
       if (tess_h->tess1d != NULL) {
         egTess1D tess1d_, *tess1d_h = &tess1d_;
@@ -60,6 +60,7 @@ typedef struct {
   int       nfaces;               /* number of faces */
   egObject **faces;               /* face objects */
   double   bbox[6];               /* bounding box */
+  void     *classify;             /* point classifier (closed) or NULL */
 } liteShell;
 
 
@@ -80,6 +81,7 @@ typedef struct {
   liteMap shells;
   int     *senses;                /* shell outer/inner (solids) */
   double   bbox[6];               /* bounding box */
+  void    *classify;              /* point classifier (solids) or NULL */
 } liteBody;
 
 
@@ -150,6 +150,7 @@ static int EG_addStrAttr_d(egObject *obj, const char *name, const char *str)
       attrs->attrs  = NULL;
       attrs->nseqs  = 0;
       attrs->seqs   = NULL;
+      attrs->nref   = 1;
       obj->attrs    = attrs;
     }
     if (attrs->attrs == NULL) {
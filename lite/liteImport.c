@@ -352,6 +352,7 @@ EG_addStrAttr(egObject *obj, const char *name, const char *str)
       attrs_h->attrs  = NULL;
       attrs_h->nseqs  = 0;
       attrs_h->seqs   = NULL;
+      attrs_h->nref   = 1;
 /*@-nullret@*/
       EG_SET_ATTRS(attrs, attrs_h);
 /*@+nullret@*/
@@ -493,6 +494,7 @@ EG_readAttrs(stream_T *fp, egAttrs **attrx)
   attrs_h->attrs  = attr;
   attrs_h->nseqs  = 0;
   attrs_h->seqs   = NULL;
+  attrs_h->nref   = 1;
 /*@-nullret@*/
   EG_SET_ATTRS(attrs, attrs_h);
 /*@+nullret@*/
@@ -698,6 +700,7 @@ EG_readBody(egObject *context, egObject *mobject, int bindex, stream_T *fp)
   lbody_h->faces.objs     = NULL;
   lbody_h->shells.objs    = NULL;
   lbody_h->senses         = NULL;
+  lbody_h->classify       = NULL;
   lbody_h->pcurves.nobjs  = 0;
   lbody_h->curves.nobjs   = 0;
   lbody_h->surfaces.nobjs = 0;
@@ -1412,7 +1415,8 @@ EG_readBody(egObject *context, egObject *mobject, int bindex, stream_T *fp)
       if (n != 1) return EGADS_READERR;
       EG_NEW(&lshell, liteShell, 1);
       if (lshell == NULL) return EGADS_MALLOC;
-      lshell_h->nfaces = m;
+      lshell_h->nfaces   = m;
+      lshell_h->classify = NULL;
       n = Fread(lshell_h->bbox, sizeof(double), 6, fp);
       if (n != 6) {
         EG_FREE(lshell);
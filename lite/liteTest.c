@@ -9,7 +9,10 @@
  *
  */
 
+#include <math.h>
+#include <string.h>
 #include "egads.h"
+#include "egadsTris.h"
 
 #ifdef WIN32
 #define LONG long long
@@ -17,6 +20,13 @@
 #define LONG long
 #endif
 
+#ifndef PI
+#define PI 3.1415926535897932384626
+#endif
+
+extern int EG_fillArea(int nconts, const int *cntr, const double *vertices,
+                       int *tris, int *nfig8, int pass, fillArea *fa);
+
 static void
 attrOut(int level, ego object)
 {
@@ -395,6 +405,627 @@ parseOut(int level, ego object, /*@null@*/ ego body, int sense)
 }
 
 
+/* the closest Face classification that EG_inTopology used to do */
+static int
+closestFace(int nface, ego *faces, double *xyz)
+{
+  int    i, stat;
+  double d, dist, tol, param[2], uv[2], coord[3], dir[3], norm[3], data[18];
+  ego    face;
+  
+  dist = 1.e308;
+  face = NULL;
+  for (i = 0; i < nface; i++) {
+    stat = EG_getTolerance(faces[i], &tol);
+    if (stat != EGADS_SUCCESS) continue;
+    stat = EG_invEvaluate(faces[i], xyz, param, coord);
+    if (stat == EGADS_DEGEN)   continue;
+    if (stat != EGADS_SUCCESS) return stat;
+    d = sqrt((xyz[0]-coord[0])*(xyz[0]-coord[0]) +
+             (xyz[1]-coord[1])*(xyz[1]-coord[1]) +
+             (xyz[2]-coord[2])*(xyz[2]-coord[2]));
+    if (d < dist) {
+      if (d <= tol) return EGADS_SUCCESS;
+      dist  = d;
+      face  = faces[i];
+      uv[0] = param[0];
+      uv[1] = param[1];
+    }
+  }
+  if (face == NULL) return EGADS_OUTSIDE;
+  stat = EG_evaluate(face, uv, data);
+  if (stat != EGADS_SUCCESS) return stat;
+  norm[0] = data[4]*data[8] - data[5]*data[7];
+  norm[1] = data[5]*data[6] - data[3]*data[8];
+  norm[2] = data[3]*data[7] - data[4]*data[6];
+  if (face->mtype == SREVERSE) {
+    norm[0] = -norm[0];
+    norm[1] = -norm[1];
+    norm[2] = -norm[2];
+  }
+  if (norm[0]*norm[0] + norm[1]*norm[1] + norm[2]*norm[2] == 0.0)
+    return EGADS_DEGEN;
+  dir[0] = xyz[0] - data[0];
+  dir[1] = xyz[1] - data[1];
+  dir[2] = xyz[2] - data[2];
+  if (dir[0]*norm[0]+dir[1]*norm[1]+dir[2]*norm[2] > 0.0) return EGADS_OUTSIDE;
+  return EGADS_SUCCESS;
+}
+
+
+/* repeatable pseudo-random numbers in [-1, 1] */
+static double
+rndOff(void)
+{
+  static unsigned long seed = 12345;
+  
+  seed = (seed*1103515245 + 12345)&0x7fffffff;
+  return 2.0*(double) seed/2147483648.0 - 1.0;
+}
+
+
+/* compare EG_inTopology & EG_inTopologyBatch against the closest Face */
+static void
+classTest(ego body, int ibody, double size)
+{
+  int    i, j, k, m, n, stat, oclass, mtype, nface, nedge, nnode, nshell;
+  int    npts, per, *senses, *ssens, *type, *single, *batch;
+  int    cnt[5], diff[5], bdif[5], unres[5];
+  double d, uv[2], range[4], box[6], data[18], *xyzs;
+  ego    geom, *faces, *edges, *nodes, *shells, *objs;
+  static char *names[5] = {"Inside", "Outside", "near Edge", "near Node",
+                           "in Void"};
+  
+  stat = EG_getBodyTopos(body, NULL, FACE, &nface, &faces);
+  if (stat != EGADS_SUCCESS) return;
+  stat = EG_getBodyTopos(body, NULL, EDGE, &nedge, &edges);
+  if (stat != EGADS_SUCCESS) {
+    EG_free(faces);
+    return;
+  }
+  stat = EG_getBodyTopos(body, NULL, NODE, &nnode, &nodes);
+  if (stat != EGADS_SUCCESS) {
+    EG_free(edges);
+    EG_free(faces);
+    return;
+  }
+  stat = EG_getTopology(body, &geom, &oclass, &mtype, data, &nshell, &shells,
+                        &ssens);
+  if (stat != EGADS_SUCCESS) nshell = 0;
+  
+  npts = 18*nface + 20*nedge + 8*nnode + 9*nshell;
+  xyzs = (double *) malloc(3*npts*sizeof(double));
+  type = (int *)    malloc(3*npts*sizeof(int));
+  if ((xyzs == NULL) || (type == NULL)) {
+    if (xyzs != NULL) free(xyzs);
+    if (type != NULL) free(type);
+    EG_free(nodes);
+    EG_free(edges);
+    EG_free(faces);
+    return;
+  }
+  single = &type[  npts];
+  batch  = &type[2*npts];
+  
+  /* either side of the Faces */
+  n = 0;
+  for (i = 0; i < nface; i++) {
+    stat = EG_getRange(faces[i], range, &per);
+    if (stat != EGADS_SUCCESS) continue;
+    for (j = 1; j <= 3; j++)
+      for (k = 1; k <= 3; k++) {
+        uv[0] = range[0] + 0.25*j*(range[1]-range[0]);
+        uv[1] = range[2] + 0.25*k*(range[3]-range[2]);
+        stat  = EG_evaluate(faces[i], uv, data);
+        if (stat != EGADS_SUCCESS) continue;
+        box[0] = data[4]*data[8] - data[5]*data[7];
+        box[1] = data[5]*data[6] - data[3]*data[8];
+        box[2] = data[3]*data[7] - data[4]*data[6];
+        d      = sqrt(box[0]*box[0] + box[1]*box[1] + box[2]*box[2]);
+        if (d == 0.0) continue;
+        if (faces[i]->mtype == SREVERSE) d = -d;
+        for (m = 0; m < 3; m++) {
+          xyzs[3*n  +m] = data[m] - 0.01*size*box[m]/d;
+          xyzs[3*n+3+m] = data[m] + 0.01*size*box[m]/d;
+        }
+        type[n  ] = 0;
+        type[n+1] = 1;
+        n += 2;
+      }
+  }
+  
+  /* about the Edges */
+  for (i = 0; i < nedge; i++) {
+    if (edges[i]->mtype == DEGENERATE) continue;
+    stat = EG_getRange(edges[i], range, &per);
+    if (stat != EGADS_SUCCESS) continue;
+    for (j = 1; j <= 5; j++) {
+      uv[0] = range[0] + j*(range[1]-range[0])/6.0;
+      stat  = EG_evaluate(edges[i], uv, data);
+      if (stat != EGADS_SUCCESS) continue;
+      for (k = 0; k < 4; k++, n++) {
+        for (m = 0; m < 3; m++) xyzs[3*n+m] = data[m] + 0.002*size*rndOff();
+        type[n] = 2;
+      }
+    }
+  }
+  
+  /* about the Nodes */
+  for (i = 0; i < nnode; i++) {
+    stat = EG_getTopology(nodes[i], &geom, &oclass, &mtype, data, &m, &objs,
+                          &senses);
+    if (stat != EGADS_SUCCESS) continue;
+    for (k = 0; k < 8; k++, n++) {
+      for (m = 0; m < 3; m++) xyzs[3*n+m] = data[m] + 0.002*size*rndOff();
+      type[n] = 3;
+    }
+  }
+  
+  /* within the inner Shells */
+  for (i = 0; i < nshell; i++) {
+    if (ssens[i] > 0) continue;
+    stat = EG_getBoundingBox(shells[i], box);
+    if (stat != EGADS_SUCCESS) continue;
+    for (k = 0; k < 9; k++, n++) {
+      for (m = 0; m < 3; m++) {
+        d = 0.5*(box[m] + box[m+3]);
+        if (k != 0) d += 0.25*(box[m+3] - box[m])*rndOff();
+        xyzs[3*n+m] = d;
+      }
+      type[n] = 4;
+    }
+  }
+  
+  if (n != 0) {
+    for (i = 0; i < n; i++) single[i] = EG_inTopology(body, &xyzs[3*i]);
+    stat = EG_inTopologyBatch(body, n, xyzs, batch);
+    if (stat != EGADS_SUCCESS)
+      printf(" Body %d: EG_inTopologyBatch = %d\n", ibody, stat);
+    for (k = 0; k < 5; k++) cnt[k] = diff[k] = bdif[k] = unres[k] = 0;
+    for (i = 0; i < n; i++) {
+      k = type[i];
+      cnt[k]++;
+      if ((stat == EGADS_SUCCESS) && (batch[i] != single[i])) bdif[k]++;
+      m = closestFace(nface, faces, &xyzs[3*i]);
+      if (((m         != EGADS_SUCCESS) && (m         != EGADS_OUTSIDE)) ||
+          ((single[i] != EGADS_SUCCESS) && (single[i] != EGADS_OUTSIDE))) {
+        unres[k]++;
+      } else if (m != single[i]) {
+        diff[k]++;
+      }
+    }
+    for (k = 0; k < 5; k++) {
+      if (cnt[k] == 0) continue;
+      printf(" Body %d %-9s: %4d pts  closest Face diffs = %d  batch diffs = %d  unresolved = %d\n",
+             ibody, names[k], cnt[k], diff[k], bdif[k], unres[k]);
+    }
+  }
+  
+  free(type);
+  free(xyzs);
+  EG_free(nodes);
+  EG_free(edges);
+  EG_free(faces);
+}
+
+
+/* add a loop (in order) to the fill input -- uv[0] is the unused vertex */
+static void
+fillLoop(int n, double *xy, int *nc, int *cntr, int *npts, double *uv)
+{
+  int i;
+
+  cntr[*nc] = n;
+  for (i = 0; i < n; i++) {
+    uv[2*(*npts+i)+2] = xy[2*i  ];
+    uv[2*(*npts+i)+3] = xy[2*i+1];
+  }
+  *npts += n;
+  (*nc)++;
+}
+
+
+static int
+cmpKey(const void *a, const void *b)
+{
+  LONG ka = *(const LONG *) a, kb = *(const LONG *) b;
+
+  if (ka < kb) return -1;
+  if (ka > kb) return  1;
+  return 0;
+}
+
+
+/* is the fill a triangulation of the loops? */
+static int
+fillCheck(int nc, const int *cntr, const double *uv, int ntri, const int *tris)
+{
+  int    i, j, k, l, a, b, nbad, nseg, npts, *next;
+  double area, sum, loop;
+  LONG   key, *keys;
+
+  for (npts = i = 0; i < nc; i++) npts += cntr[i];
+  if (ntri != npts + 2*(nc-1) - 2) return 1;
+  next = (int *)  malloc((npts+1)*sizeof(int));
+  keys = (LONG *) malloc(3*ntri*sizeof(LONG));
+  if ((next == NULL) || (keys == NULL)) {
+    if (next != NULL) free(next);
+    if (keys != NULL) free(keys);
+    return 1;
+  }
+  for (l = 1, i = 0; i < nc; l += cntr[i], i++)
+    for (j = 0; j < cntr[i]; j++) next[l+j] = l + (j+1)%cntr[i];
+
+  /* every triangle positive and covering the area of the loops */
+  nbad = 0;
+  sum  = loop = 0.0;
+  for (i = 1; i <= npts; i++)
+    loop += uv[2*i]*uv[2*next[i]+1] - uv[2*next[i]]*uv[2*i+1];
+  for (i = 0; i < ntri; i++) {
+    a    = tris[3*i  ];
+    b    = tris[3*i+1];
+    k    = tris[3*i+2];
+    area = (uv[2*b]-uv[2*a])*(uv[2*k+1]-uv[2*a+1]) -
+           (uv[2*b+1]-uv[2*a+1])*(uv[2*k]-uv[2*a]);
+    if (area <= 0.0) nbad++;
+    sum += area;
+    for (j = 0; j < 3; j++)
+      keys[3*i+j] = (LONG) tris[3*i+j]*(npts+1) + tris[3*i+(j+1)%3];
+  }
+  if (fabs(sum-loop) > 1.e-10*fabs(loop)) nbad++;
+
+  /* each side is a loop segment or is matched by its reverse, once */
+  qsort(keys, 3*ntri, sizeof(LONG), cmpKey);
+  for (nseg = i = 0; i < 3*ntri; i++) {
+    if ((i > 0) && (keys[i] == keys[i-1])) nbad++;
+    a = keys[i]/(npts+1);
+    b = keys[i]%(npts+1);
+    if (next[a] == b) {
+      nseg++;
+      continue;
+    }
+    key = (LONG) b*(npts+1) + a;
+    if (bsearch(&key, keys, 3*ntri, sizeof(LONG), cmpKey) == NULL) nbad++;
+  }
+  if (nseg != npts) nbad++;
+
+  free(keys);
+  free(next);
+  return nbad;
+}
+
+
+/* fill loops large enough for the indexed front in EG_fillArea (128 or more
+   vertices) -- combs, staircases with aligned holes & circles with holes */
+static void
+fillTest(void)
+{
+  int      i, j, k, n, nc, npts, nfig8, ntri, pass, nfill, nbad;
+  int      cntr[8], *tris;
+  double   t, xy[2*512], *uv;
+  fillArea fa;
+
+  uv   = (double *) malloc(2*(1024+1)*sizeof(double));
+  tris = (int *)    malloc(3*(1024+16)*sizeof(int));
+  if ((uv == NULL) || (tris == NULL)) {
+    if (uv   != NULL) free(uv);
+    if (tris != NULL) free(tris);
+    return;
+  }
+  fa.pts   = NULL;
+  fa.segs  = NULL;
+  fa.front = NULL;
+  fa.grid  = NULL;
+  fa.link  = NULL;
+
+  nfill = nbad = 0;
+  for (k = 0; k < 3; k++) {
+    nc = npts = 0;
+    if (k == 0) {
+      /* a comb of 60 teeth */
+      for (n = i = 0; i < 60; i++) {
+        xy[2*n] = 2*i;   xy[2*n+1] = 0.0;  n++;
+        xy[2*n] = 2*i+1; xy[2*n+1] = 0.0;  n++;
+        xy[2*n] = 2*i+1; xy[2*n+1] = 10.0; n++;
+        xy[2*n] = 2*i+2; xy[2*n+1] = 10.0; n++;
+      }
+      xy[2*n] = 120.0; xy[2*n+1] = 11.0; n++;
+      xy[2*n] =   0.0; xy[2*n+1] = 11.0; n++;
+      fillLoop(n, xy, &nc, cntr, &npts, uv);
+    } else if (k == 1) {
+      /* a staircase with square holes on the same lines as the steps */
+      for (n = i = 0; i < 80; i++) {
+        xy[2*n] = i;   xy[2*n+1] = i;   n++;
+        xy[2*n] = i+1; xy[2*n+1] = i;   n++;
+      }
+      xy[2*n] = 80.0; xy[2*n+1] = 80.0; n++;
+      xy[2*n] =  0.0; xy[2*n+1] = 80.0; n++;
+      fillLoop(n, xy, &nc, cntr, &npts, uv);
+      for (j = 0; j < 5; j++) {
+        t = 15.0*j + 4.0;
+        xy[0] = 1.0; xy[1] = t;
+        xy[2] = 1.0; xy[3] = t+2.0;
+        xy[4] = 3.0; xy[5] = t+2.0;
+        xy[6] = 3.0; xy[7] = t;
+        fillLoop(4, xy, &nc, cntr, &npts, uv);
+      }
+    } else {
+      /* a circle with circular holes */
+      for (i = 0; i < 256; i++) {
+        t = 2.0*PI*i/256.0;
+        xy[2*i  ] = 10.0*cos(t);
+        xy[2*i+1] = 10.0*sin(t);
+      }
+      fillLoop(256, xy, &nc, cntr, &npts, uv);
+      for (j = 0; j < 3; j++)
+        for (i = 0; i < 32; i++) {
+          t = -2.0*PI*i/32.0;
+          xy[2*i  ] = 5.0*cos(2.0*PI*j/3.0) + 2.0*cos(t);
+          xy[2*i+1] = 5.0*sin(2.0*PI*j/3.0) + 2.0*sin(t);
+          if (i == 31) fillLoop(32, xy, &nc, cntr, &npts, uv);
+        }
+    }
+    uv[0] = uv[1] = 0.0;
+    for (pass = 0; pass <= 1; pass++) {
+      nfig8 = 0;
+      ntri  = EG_fillArea(nc, cntr, uv, tris, &nfig8, pass, &fa);
+      if (ntri > 0) break;
+    }
+    nfill++;
+    if ((ntri <= 0) || (fillCheck(nc, cntr, uv, ntri, tris) != 0)) nbad++;
+  }
+  printf(" Fill: %d loop sets (indexed front)  bad fills = %d\n", nfill, nbad);
+
+  if (fa.link  != NULL) EG_free(fa.link);
+  if (fa.grid  != NULL) EG_free(fa.grid);
+  if (fa.front != NULL) EG_free(fa.front);
+  if (fa.pts   != NULL) EG_free(fa.pts);
+  if (fa.segs  != NULL) EG_free(fa.segs);
+  free(tris);
+  free(uv);
+}
+
+
+/* compare EG_inTriExactBatch with EG_inTriExact -- many of the points are
+   on or next to the triangle's sides, where the batch filter gives up */
+static void
+predTest(void)
+{
+  int    i, j, k, n, stat, ntri, nin, diff, *in;
+  double t, w[3], *pts, *wb;
+  static double tris[3][6] = {{0.0, 0.0,  1.0, 0.0,  0.0, 1.0},
+                              {0.1, 0.2,  3.7, 1.3, -0.9, 2.9},
+                              {0.0, 0.0,  1.0, 1.e-9, 2.0, 0.0}};
+
+  n   = 3000;
+  pts = (double *) malloc(5*n*sizeof(double));
+  in  = (int *)    malloc(  n*sizeof(int));
+  if ((pts == NULL) || (in == NULL)) {
+    if (pts != NULL) free(pts);
+    if (in  != NULL) free(in);
+    return;
+  }
+  wb = &pts[2*n];
+
+  ntri = sizeof(tris)/(6*sizeof(double));
+  nin  = diff = 0;
+  for (k = 0; k < ntri; k++) {
+    for (i = 0; i < n; i++) {
+      if (i%3 == 0) {
+        /* anywhere about the triangle */
+        pts[2*i  ] = 2.0*rndOff();
+        pts[2*i+1] = 2.0*rndOff();
+      } else {
+        /* on a side (as rounded) and maybe nudged off it */
+        j = (i/3)%3;
+        t = 0.5 + 0.5*rndOff();
+        pts[2*i  ] = tris[k][2*j  ] + t*(tris[k][(2*j+2)%6] - tris[k][2*j  ]);
+        pts[2*i+1] = tris[k][2*j+1] + t*(tris[k][(2*j+3)%6] - tris[k][2*j+1]);
+        if (i%3 == 2) pts[2*i+1] = nextafter(pts[2*i+1], rndOff());
+      }
+    }
+    stat = EG_inTriExactBatch(&tris[k][0], &tris[k][2], &tris[k][4], n, pts,
+                              wb, in);
+    if (stat != EGADS_SUCCESS) {
+      printf(" Triangle %d: EG_inTriExactBatch = %d\n", k+1, stat);
+      diff++;
+      continue;
+    }
+    for (i = 0; i < n; i++) {
+      stat = EG_inTriExact(&tris[k][0], &tris[k][2], &tris[k][4], &pts[2*i],
+                           w);
+      if (stat == EGADS_SUCCESS) nin++;
+      if ((stat != in[i]) || (memcmp(w, &wb[3*i], 3*sizeof(double)) != 0))
+        diff++;
+    }
+  }
+  printf(" Predicates: %d triangles  %d pts  inside = %d  batch diffs = %d\n",
+         ntri, ntri*n, nin, diff);
+
+  free(in);
+  free(pts);
+}
+
+
+/* a checksum of the Edge & Face tessellations */
+static unsigned LONG
+hashBytes(unsigned LONG hash, const void *data, int len)
+{
+  int                 i;
+  const unsigned char *bytes;
+
+  bytes = (const unsigned char *) data;
+  for (i = 0; i < len; i++) hash = (hash^bytes[i])*1099511628211ULL;
+  return hash;
+}
+
+
+static unsigned LONG
+tessSum(ego tess, int nedge, int nface)
+{
+  int           i, stat, len, ntri;
+  const int     *ptype, *pindex, *tris, *tric;
+  const double  *xyz, *t, *uv;
+  unsigned LONG hash;
+
+  hash = 14695981039346656037ULL;
+  for (i = 1; i <= nedge; i++) {
+    stat = EG_getTessEdge(tess, i, &len, &xyz, &t);
+    if (stat != EGADS_SUCCESS) continue;
+    hash = hashBytes(hash, &len, sizeof(int));
+    hash = hashBytes(hash, xyz,  3*len*sizeof(double));
+    hash = hashBytes(hash, t,      len*sizeof(double));
+  }
+  for (i = 1; i <= nface; i++) {
+    stat = EG_getTessFace(tess, i, &len, &xyz, &uv, &ptype, &pindex, &ntri,
+                          &tris, &tric);
+    if (stat != EGADS_SUCCESS) continue;
+    hash = hashBytes(hash, &len,   sizeof(int));
+    hash = hashBytes(hash, &ntri,  sizeof(int));
+    hash = hashBytes(hash, xyz,    3*len*sizeof(double));
+    hash = hashBytes(hash, uv,     2*len*sizeof(double));
+    hash = hashBytes(hash, ptype,    len*sizeof(int));
+    hash = hashBytes(hash, pindex,   len*sizeof(int));
+    hash = hashBytes(hash, tris,  3*ntri*sizeof(int));
+    hash = hashBytes(hash, tric,  3*ntri*sizeof(int));
+  }
+
+  return hash;
+}
+
+
+/* exercise the Edge vertex edit transactions */
+static void
+editTest(ego body, int ibody, ego tess, double *params)
+{
+  int           i, j, k, stat, len, nedge, nface, e1, e2, iface, ivert;
+  int           nconf, rej, dabort, droll, dcommit;
+  double        tm, tins[2];
+  const double  *xyz, *t1, *t2;
+  unsigned LONG hash0, hash;
+  ego           tess2, *edges;
+  egTessel      *btess;
+  egTess2D      *tess2d;
+
+  stat = EG_getBodyTopos(body, NULL, EDGE, &nedge, &edges);
+  if (stat != EGADS_SUCCESS) return;
+  /* pick 2 Edges with enough vertices */
+  for (e1 = e2 = 0, i = 1; i <= nedge; i++) {
+    if (edges[i-1]->mtype == DEGENERATE) continue;
+    stat = EG_getTessEdge(tess, i, &len, &xyz, &t1);
+    if ((stat != EGADS_SUCCESS) || (len < 7)) continue;
+    if (e1 == 0) {
+      e1 = i;
+    } else {
+      e2 = i;
+      break;
+    }
+  }
+  EG_free(edges);
+  if (e2 == 0) return;
+  stat = EG_getBodyTopos(body, NULL, FACE, &nface, NULL);
+  if (stat != EGADS_SUCCESS) return;
+
+  EG_getTessEdge(tess, e1, &len, &xyz, &t1);
+  EG_getTessEdge(tess, e2, &len, &xyz, &t2);
+  tm      = 0.5*(t1[2] + t1[3]);
+  tins[0] = t2[0] + 0.25*(t2[1] - t2[0]);
+  tins[1] = t2[0] + 0.75*(t2[1] - t2[0]);
+  hash0   = tessSum(tess, nedge, nface);
+
+  /* edits touching a queued edit are rejected */
+  nconf = rej = 0;
+  stat  = EG_beginEdgeEdits(tess);
+  if (stat != EGADS_SUCCESS) {
+    printf(" Body %d: EG_beginEdgeEdits = %d\n", ibody, stat);
+    return;
+  }
+  stat = EG_moveEdgeVert(tess, e1, 3, tm);
+  if (stat != EGADS_SUCCESS)
+    printf(" Body %d: queued EG_moveEdgeVert = %d\n", ibody, stat);
+  nconf++;
+  if (EG_moveEdgeVert(tess, e1, 3, tm)    == EGADS_RANGERR) rej++;
+  nconf++;
+  if (EG_deleteEdgeVert(tess, e1, 4, 1)   == EGADS_RANGERR) rej++;
+  nconf++;
+  tins[0] = 0.5*(t1[1] + t1[2]);
+  if (EG_insertEdgeVerts(tess, e1, 2, 1, tins) == EGADS_RANGERR) rej++;
+  nconf++;
+  if (EG_beginEdgeEdits(tess)             == EGADS_TESSTATE) rej++;
+  tins[0] = t2[0] + 0.25*(t2[1] - t2[0]);
+  stat = EG_insertEdgeVerts(tess, e2, 1, 2, tins);
+  if (stat != EGADS_SUCCESS)
+    printf(" Body %d: queued EG_insertEdgeVerts = %d\n", ibody, stat);
+
+  /* abort leaves the tessellation alone & closes the transaction */
+  stat = EG_abortEdgeEdits(tess);
+  if (stat != EGADS_SUCCESS)
+    printf(" Body %d: EG_abortEdgeEdits = %d\n", ibody, stat);
+  dabort = 0;
+  if (tessSum(tess, nedge, nface)  != hash0)          dabort++;
+  if (EG_commitEdgeEdits(tess)     != EGADS_TESSTATE) dabort++;
+
+  /* a commit that fails part way applies nothing -- the Face vertex the
+     delete collapses is hidden so that the Edge e2 edit fails after the
+     move on e1 has been applied to the staged copy */
+  droll = 0;
+  EG_beginEdgeEdits(tess);
+  EG_moveEdgeVert(tess, e1, 3, tm);
+  EG_deleteEdgeVert(tess, e2, 2, 1);
+  btess = (egTessel *) tess->blind;
+  iface = btess->tess1d[e2-1].faces[0].index;
+  if (btess->tess1d[e2-1].faces[0].nface > 1)
+    iface = btess->tess1d[e2-1].faces[0].faces[0];
+  if (iface == 0) {
+    iface = btess->tess1d[e2-1].faces[1].index;
+    if (btess->tess1d[e2-1].faces[1].nface > 1)
+      iface = btess->tess1d[e2-1].faces[1].faces[0];
+  }
+  tess2d = &btess->tess2d[iface-1];
+  for (ivert = -1, k = 0; k < tess2d->npts; k++)
+    if ((tess2d->pindex[k] == e2) && (tess2d->ptype[k] == 2)) {
+      ivert = k;
+      break;
+    }
+  if (ivert >= 0) {
+    tess2d->ptype[ivert] = -2;
+    stat = EG_commitEdgeEdits(tess);
+    tess2d->ptype[ivert] =  2;
+    if (stat == EGADS_SUCCESS)                        droll++;
+    if (tessSum(tess, nedge, nface)  != hash0)        droll++;
+    if (EG_abortEdgeEdits(tess)      != EGADS_TESSTATE) droll++;
+  } else {
+    EG_abortEdgeEdits(tess);
+    droll++;
+  }
+
+  /* a commit matches the same edits made one at a time */
+  dcommit = 0;
+  stat = EG_makeTessBody(body, params, &tess2);
+  if (stat != EGADS_SUCCESS) {
+    printf(" Body %d: second EG_makeTessBody = %d\n", ibody, stat);
+    return;
+  }
+  EG_beginEdgeEdits(tess);
+  j  = EG_moveEdgeVert(tess, e1, 3, tm);
+  j += EG_deleteEdgeVert(tess, e1, 6, -1);
+  j += EG_insertEdgeVerts(tess, e2, 1, 2, tins);
+  stat = EG_commitEdgeEdits(tess);
+  if ((j != EGADS_SUCCESS) || (stat != EGADS_SUCCESS)) dcommit++;
+  j  = EG_moveEdgeVert(tess2, e1, 3, tm);
+  j += EG_deleteEdgeVert(tess2, e1, 6, -1);
+  j += EG_insertEdgeVerts(tess2, e2, 1, 2, tins);
+  if (j != EGADS_SUCCESS) dcommit++;
+  hash = tessSum(tess, nedge, nface);
+  if (hash == hash0)                            dcommit++;
+  if (hash != tessSum(tess2, nedge, nface))     dcommit++;
+  EG_deleteObject(tess2);
+
+  printf(" Body %d Edge edits: conflicts rejected = %d/%d  abort diffs = %d  rollback diffs = %d  commit diffs = %d\n",
+         ibody, rej, nconf, dabort, droll, dcommit);
+}
+
+
 int main(int argc, char *argv[])
 {
   int    i, j, k, n, nn, stat, oclass, mtype, nbodies, *senses;
@@ -501,9 +1132,18 @@ int main(int argc, char *argv[])
     params[2] = 15.0;
     stat = EG_makeTessBody(bodies[i], params, &obj);
     printf(" Tessellation of Body %d = %d\n", i+1, stat);
-    if (stat == EGADS_SUCCESS) EG_deleteObject(obj);
+    if (stat == EGADS_SUCCESS) {
+      if (mtype != WIREBODY) editTest(bodies[i], i+1, obj, params);
+      EG_deleteObject(obj);
+    }
+    if (mtype == SOLIDBODY) classTest(bodies[i], i+1, size);
   }
   
+  /* the batched predicates & the indexed fill */
+  predTest();
+  fillTest();
+  printf(" \n");
+
   /* scan through the objects */
   obj = context;
   nn  = n = 0;
@@ -16,12 +16,14 @@
 #include "egadsTypes.h"
 #include "egadsInternals.h"
 #include "liteClasses.h"
+#include "emp.h"
 
 
 #define PARAMACC         1.0e-4         /* parameter accuracy */
 #define CROSS(a,b,c)       a[0] = (b[1]*c[2]) - (b[2]*c[1]);\
                            a[1] = (b[2]*c[0]) - (b[0]*c[2]);\
                            a[2] = (b[0]*c[1]) - (b[1]*c[0])
+#define DOT(a,b)          (a[0]*b[0] + a[1]*b[1] + a[2]*b[2])
 
 #ifdef __HOST_AND_DEVICE__
 #undef __HOST_AND_DEVICE__
@@ -68,6 +70,14 @@ __PROTO_H_AND_D__ int EG_tolEObject( const egObject *topo, double *tol );
 __PROTO_H_AND_D__ int EG_getEEdgeUV( const egObject *face, const egObject *topo,
                                      int sensx, double t, double *uv );
 __PROTO_H_AND_D__ int EG_inEFace( const egObject *face, const double *uv );
+__PROTO_H_AND_D__ int EG_makeTessBody( egObject *object, double *params,
+                                       egObject **tess );
+__PROTO_H_AND_D__ int EG_getTessFace( const egObject *tess, int indx, int *len,
+                                      const double **xyz, const double **uv,
+                                      const int **ptype, const int **pindex,
+                                      int *ntri, const int **tris,
+                                      const int **tric );
+__PROTO_H_AND_D__ int EG_deleteObject( egObject *object );
 
 
 
@@ -914,8 +924,828 @@ EG_inFace(const egObject *face, const double *uv)
 }
 
 
-__HOST_AND_DEVICE__ int
-EG_inTopology(const egObject *topo, const double *xyz)
+/*
+ * Point classification against closed Shells and SolidBodies
+ *
+ *   A per-Body (or per-Shell) structure holds an axis-aligned box tree of the
+ *   Faces and of a watertight facet soup taken from a Body tessellation.
+ *   Points farther than the facet deviation (plus tolerance) from every
+ *   facet are classified by ray parity; only points near the boundary (or
+ *   when the rays are ambiguous) fall back to exact inverse evaluation on
+ *   the Faces the box tree cannot exclude.
+ */
+
+#define CLASSLEAF        4              /* max items in a box tree leaf */
+#define CLASSSTACK     128              /* box tree traversal stack depth */
+#define CLASSTIE         8              /* max Faces tied for closest */
+#define CLASSBLOCK     256              /* points claimed per thread visit */
+#define RAYEPS     1.0e-10              /* relative facet hit ambiguity */
+
+
+typedef struct {
+  double box[6];                /* bounding box of the items below */
+  int    first;                 /* leaf: first item -- else: left child */
+  int    n;                     /* leaf: number of items -- else: 0 */
+} liteBoxNode;
+
+
+typedef struct {
+  int         nnode;            /* number of nodes used */
+  liteBoxNode *nodes;           /* the nodes -- root is 0 */
+  int         *items;           /* item permutation referenced by leaves */
+} liteBoxTree;
+
+
+typedef struct {
+  int         nface;            /* number of Faces */
+  egObject    **faces;          /* the Faces (not owned) */
+  double      *fbox;            /* Face boxes grown by tolerance */
+  double      *margin;          /* Face tolerance + facet deviation */
+  liteBoxTree ftree;            /* Face box tree */
+  int         ntri;             /* number of facets -- 0 is exact only */
+  double      *txyz;            /* facet coordinates (9 per facet) */
+  double      *tbox;            /* facet boxes */
+  int         *tface;           /* Face index (bias 0) for each facet */
+  liteBoxTree ttree;            /* facet box tree */
+  double      tmax;             /* largest Face tolerance */
+  double      dmax;             /* largest margin */
+  double      bbox[6];          /* overall box grown by dmax */
+} liteClassify;
+
+
+/* structure to pass data to the threads classifying points */
+typedef struct {
+  void               *mutex;    /* the mutex or NULL for single thread */
+  long               master;    /* master thread ID */
+  int                end;       /* number of points */
+  int                index;     /* next point to claim */
+  const egObject     *topo;     /* the Object classified against */
+  const liteClassify *cls;      /* the classifier or NULL */
+  const double       *xyzs;     /* the points */
+  int                *results;  /* returned status for each point */
+} EMPclass;
+
+
+static double
+EG_boxDist2(const double *box, const double *xyz)
+{
+  int    k;
+  double d, dist = 0.0;
+
+  for (k = 0; k < 3; k++) {
+    if (xyz[k] < box[k]) {
+      d = box[k] - xyz[k];
+    } else if (xyz[k] > box[k+3]) {
+      d = xyz[k] - box[k+3];
+    } else {
+      continue;
+    }
+    dist += d*d;
+  }
+
+  return dist;
+}
+
+
+static int
+EG_boxRay(const double *box, const double *xyz, const double *dir)
+{
+  int    k;
+  double t0, t1, tmp, tmin = 0.0, tmax = 1.e308;
+
+  for (k = 0; k < 3; k++) {
+    if (dir[k] == 0.0) {
+      if ((xyz[k] < box[k]) || (xyz[k] > box[k+3])) return 0;
+      continue;
+    }
+    t0 = (box[k]   - xyz[k])/dir[k];
+    t1 = (box[k+3] - xyz[k])/dir[k];
+    if (t0 > t1) {
+      tmp = t0;
+      t0  = t1;
+      t1  = tmp;
+    }
+    if (t0 > tmin) tmin = t0;
+    if (t1 < tmax) tmax = t1;
+    if (tmin > tmax) return 0;
+  }
+
+  return 1;
+}
+
+
+/* partition items so that the k-th is in place along axis (quickselect) */
+static void
+EG_boxSelect(int *items, const double *boxes, int axis, int n, int k)
+{
+  int    i, j, tmp, lo = 0, hi = n-1;
+  double pivot;
+
+#define CENTER(m) (boxes[6*(m)+axis] + boxes[6*(m)+axis+3])
+  while (hi > lo) {
+    pivot = CENTER(items[(lo+hi)/2]);
+    i     = lo;
+    j     = hi;
+    while (i <= j) {
+      while (CENTER(items[i]) < pivot) i++;
+      while (CENTER(items[j]) > pivot) j--;
+      if (i <= j) {
+        tmp      = items[i];
+        items[i] = items[j];
+        items[j] = tmp;
+        i++;
+        j--;
+      }
+    }
+    if (k <= j) {
+      hi = j;
+    } else if (k >= i) {
+      lo = i;
+    } else {
+      break;
+    }
+  }
+#undef CENTER
+}
+
+
+static void
+EG_boxSplit(liteBoxTree *tree, const double *boxes, int inode, int first,
+            int n)
+{
+  int         i, k, m, axis;
+  double      cmin[3], cmax[3], c;
+  liteBoxNode *node;
+
+  node = &tree->nodes[inode];
+  m    = tree->items[first];
+  for (k = 0; k < 6; k++) node->box[k] = boxes[6*m+k];
+  for (k = 0; k < 3; k++) cmin[k] = cmax[k] = boxes[6*m+k] + boxes[6*m+k+3];
+  for (i = first+1; i < first+n; i++) {
+    m = tree->items[i];
+    for (k = 0; k < 3; k++) {
+      if (boxes[6*m+k  ] < node->box[k  ]) node->box[k  ] = boxes[6*m+k  ];
+      if (boxes[6*m+k+3] > node->box[k+3]) node->box[k+3] = boxes[6*m+k+3];
+      c = boxes[6*m+k] + boxes[6*m+k+3];
+      if (c < cmin[k]) cmin[k] = c;
+      if (c > cmax[k]) cmax[k] = c;
+    }
+  }
+
+  axis = 0;
+  if (cmax[1]-cmin[1] > cmax[axis]-cmin[axis]) axis = 1;
+  if (cmax[2]-cmin[2] > cmax[axis]-cmin[axis]) axis = 2;
+  if ((n <= CLASSLEAF) || (cmax[axis] == cmin[axis])) {
+    node->first = first;
+    node->n     = n;
+    return;
+  }
+
+  m = n/2;
+  EG_boxSelect(&tree->items[first], boxes, axis, n, m);
+  k            = tree->nnode;
+  tree->nnode += 2;
+  node->first  = k;
+  node->n      = 0;
+  EG_boxSplit(tree, boxes, k,   first,   m);
+  EG_boxSplit(tree, boxes, k+1, first+m, n-m);
+}
+
+
+static int
+EG_boxTree(int n, const double *boxes, liteBoxTree *tree)
+{
+  int i;
+
+  tree->nnode = 0;
+  tree->nodes = NULL;
+  tree->items = NULL;
+  if (n <= 0) return EGADS_SUCCESS;
+
+  tree->nodes = (liteBoxNode *) EG_alloc(2*n*sizeof(liteBoxNode));
+  tree->items = (int *)         EG_alloc(  n*sizeof(int));
+  if ((tree->nodes == NULL) || (tree->items == NULL)) {
+    if (tree->nodes != NULL) EG_free(tree->nodes);
+    if (tree->items != NULL) EG_free(tree->items);
+    tree->nodes = NULL;
+    tree->items = NULL;
+    return EGADS_MALLOC;
+  }
+  for (i = 0; i < n; i++) tree->items[i] = i;
+  tree->nnode = 1;
+  EG_boxSplit(tree, boxes, 0, 0, n);
+
+  return EGADS_SUCCESS;
+}
+
+
+/* squared distance from a point to a facet */
+static double
+EG_facetDist2(const double *p, const double *tri)
+{
+  int          k;
+  double       ab[3], ac[3], ap[3], bp[3], cp[3], q[3], d, dist;
+  double       d1, d2, d3, d4, d5, d6, va, vb, vc, v, w;
+  const double *a, *b, *c;
+
+  a = tri;
+  b = tri + 3;
+  c = tri + 6;
+  for (k = 0; k < 3; k++) {
+    ab[k] = b[k] - a[k];
+    ac[k] = c[k] - a[k];
+    ap[k] = p[k] - a[k];
+    bp[k] = p[k] - b[k];
+    cp[k] = p[k] - c[k];
+  }
+  d1 = DOT(ab, ap);
+  d2 = DOT(ac, ap);
+  d3 = DOT(ab, bp);
+  d4 = DOT(ac, bp);
+  d5 = DOT(ab, cp);
+  d6 = DOT(ac, cp);
+  vc = d1*d4 - d3*d2;
+  vb = d5*d2 - d1*d6;
+  va = d3*d6 - d5*d4;
+
+  if ((d1 <= 0.0) && (d2 <= 0.0)) {
+    for (k = 0; k < 3; k++) q[k] = a[k];
+  } else if ((d3 >= 0.0) && (d4 <= d3)) {
+    for (k = 0; k < 3; k++) q[k] = b[k];
+  } else if ((d6 >= 0.0) && (d5 <= d6)) {
+    for (k = 0; k < 3; k++) q[k] = c[k];
+  } else if ((vc <= 0.0) && (d1 >= 0.0) && (d3 <= 0.0)) {
+    v = d1/(d1 - d3);
+    for (k = 0; k < 3; k++) q[k] = a[k] + v*ab[k];
+  } else if ((vb <= 0.0) && (d2 >= 0.0) && (d6 <= 0.0)) {
+    w = d2/(d2 - d6);
+    for (k = 0; k < 3; k++) q[k] = a[k] + w*ac[k];
+  } else if ((va <= 0.0) && (d4-d3 >= 0.0) && (d5-d6 >= 0.0)) {
+    w = (d4 - d3)/((d4 - d3) + (d5 - d6));
+    for (k = 0; k < 3; k++) q[k] = b[k] + w*(c[k] - b[k]);
+  } else if (va+vb+vc == 0.0) {
+    /* degenerate facet -- use the closest vertex */
+    dist = DOT(ap, ap);
+    d    = DOT(bp, bp);
+    if (d < dist) dist = d;
+    d    = DOT(cp, cp);
+    if (d < dist) dist = d;
+    return dist;
+  } else {
+    v = vb/(va + vb + vc);
+    w = vc/(va + vb + vc);
+    for (k = 0; k < 3; k++) q[k] = a[k] + v*ab[k] + w*ac[k];
+  }
+
+  for (k = 0; k < 3; k++) q[k] = p[k] - q[k];
+  return DOT(q, q);
+}
+
+
+/* ray/facet crossing: 1 hit, 0 miss, -1 ambiguous (edge, vertex or plane) */
+static int
+EG_rayFacet(const double *xyz, const double *dir, const double *tri)
+{
+  int    k;
+  double e1[3], e2[3], s[3], p[3], q[3], n[3], det, scale, u, v, t;
+
+  for (k = 0; k < 3; k++) {
+    e1[k] = tri[3+k] - tri[k];
+    e2[k] = tri[6+k] - tri[k];
+    s[k]  = xyz[k]   - tri[k];
+  }
+  CROSS(n, e1, e2);
+  scale = sqrt(DOT(n, n));
+  if (scale == 0.0) return 0;
+
+  CROSS(p, dir, e2);
+  det = DOT(e1, p);
+  if (fabs(det) <= RAYEPS*scale) {
+    /* parallel -- only a problem if the ray lies in the plane */
+    if (fabs(DOT(s, n)) <= RAYEPS*scale*sqrt(scale)) return -1;
+    return 0;
+  }
+  u = DOT(s, p)/det;
+  if ((u < -RAYEPS) || (u > 1.0+RAYEPS)) return 0;
+  CROSS(q, s, e1);
+  v = DOT(dir, q)/det;
+  if ((v < -RAYEPS) || (u+v > 1.0+RAYEPS)) return 0;
+  t = DOT(e2, q)/det;
+  if (t < -RAYEPS*sqrt(scale)) return 0;
+
+  if (t <= RAYEPS*sqrt(scale)) return -1;
+  if ((u < RAYEPS) || (v < RAYEPS) || (u+v > 1.0-RAYEPS)) return -1;
+  return 1;
+}
+
+
+/* number of facet crossings mod 2, or -1 if the ray grazes anything */
+static int
+EG_rayParity(const liteClassify *cls, const double *xyz, const double *dir)
+{
+  int         i, k, hit, sp, parity = 0, stack[CLASSSTACK];
+  liteBoxNode *node;
+
+  stack[0] = 0;
+  sp       = 1;
+  while (sp > 0) {
+    node = &cls->ttree.nodes[stack[--sp]];
+    if (EG_boxRay(node->box, xyz, dir) == 0) continue;
+    if (node->n == 0) {
+      if (sp+2 > CLASSSTACK) return -1;
+      stack[sp++] = node->first;
+      stack[sp++] = node->first+1;
+      continue;
+    }
+    for (k = node->first; k < node->first+node->n; k++) {
+      i   = cls->ttree.items[k];
+      hit = EG_rayFacet(xyz, dir, &cls->txyz[9*i]);
+      if (hit < 0) return -1;
+      parity ^= hit;
+    }
+  }
+
+  return parity;
+}
+
+
+/* is the point within the margin of a facet of its Face? */
+static int
+EG_nearFacets(const liteClassify *cls, const double *xyz)
+{
+  int         i, k, sp, stack[CLASSSTACK];
+  double      dmax2;
+  liteBoxNode *node;
+
+  dmax2    = cls->dmax*cls->dmax;
+  stack[0] = 0;
+  sp       = 1;
+  while (sp > 0) {
+    node = &cls->ttree.nodes[stack[--sp]];
+    if (EG_boxDist2(node->box, xyz) > dmax2) continue;
+    if (node->n == 0) {
+      if (sp+2 > CLASSSTACK) return 1;
+      stack[sp++] = node->first;
+      stack[sp++] = node->first+1;
+      continue;
+    }
+    for (k = node->first; k < node->first+node->n; k++) {
+      i = cls->ttree.items[k];
+      if (EG_facetDist2(xyz, &cls->txyz[9*i]) <=
+          cls->margin[cls->tface[i]]*cls->margin[cls->tface[i]]) return 1;
+    }
+  }
+
+  return 0;
+}
+
+
+/* dot of the unit direction (Face point to xyz) with the outward normal */
+static int
+EG_faceSide(const egObject *face, const double *uv, const double *xyz,
+            double *dot)
+{
+  int    stat;
+  double d, dir[3], du[3], dv[3], norm[3], data[18];
+
+  *dot = 0.0;
+  stat = EG_evaluate(face, uv, data);
+  if (stat != EGADS_SUCCESS) return stat;
+  du[0] = data[3];
+  du[1] = data[4];
+  du[2] = data[5];
+  dv[0] = data[6];
+  dv[1] = data[7];
+  dv[2] = data[8];
+  CROSS(norm, du, dv);
+  if (face->mtype == SREVERSE) {
+    norm[0] = -norm[0];
+    norm[1] = -norm[1];
+    norm[2] = -norm[2];
+  }
+  d = sqrt(DOT(norm, norm));
+  if (d == 0.0) return EGADS_DEGEN;
+  dir[0] = xyz[0] - data[0];
+  dir[1] = xyz[1] - data[1];
+  dir[2] = xyz[2] - data[2];
+  d     *= sqrt(DOT(dir, dir));
+  if (d == 0.0) return EGADS_DEGEN;
+  *dot   = DOT(dir, norm)/d;
+
+  return EGADS_SUCCESS;
+}
+
+
+/* exact classification -- closest Face(s) pruned by the Face box tree */
+static int
+EG_classExact(const liteClassify *cls, const double *xyz)
+{
+  int         i, j, k, m, stat, sp, ncand = 0, stack[CLASSSTACK];
+  int         cand[CLASSTIE];
+  double      d, dmin = 1.e308, dot, best = 0.0, param[2], coord[3];
+  double      dist[CLASSTIE], uvs[2*CLASSTIE];
+  liteFace    *pface;
+  liteBoxNode *node;
+
+  stack[0] = 0;
+  sp       = 1;
+  while (sp > 0) {
+    node = &cls->ftree.nodes[stack[--sp]];
+    if (sqrt(EG_boxDist2(node->box, xyz)) > dmin+cls->tmax) continue;
+    if (node->n == 0) {
+      if (sp+2 > CLASSSTACK) return EGADS_RANGERR;
+      /* visit the nearer child first */
+      if (EG_boxDist2(cls->ftree.nodes[node->first  ].box, xyz) <
+          EG_boxDist2(cls->ftree.nodes[node->first+1].box, xyz)) {
+        stack[sp++] = node->first+1;
+        stack[sp++] = node->first;
+      } else {
+        stack[sp++] = node->first;
+        stack[sp++] = node->first+1;
+      }
+      continue;
+    }
+    for (k = node->first; k < node->first+node->n; k++) {
+      i = cls->ftree.items[k];
+      if (sqrt(EG_boxDist2(&cls->fbox[6*i], xyz)) > dmin+cls->tmax) continue;
+      pface = (liteFace *) cls->faces[i]->blind;
+      if (pface == NULL) continue;
+      stat  = EG_invEvaluate(cls->faces[i], (double *) xyz, param, coord);
+      if (stat == EGADS_DEGEN)   continue;
+      if (stat != EGADS_SUCCESS) return stat;
+      d = sqrt((xyz[0]-coord[0])*(xyz[0]-coord[0]) +
+               (xyz[1]-coord[1])*(xyz[1]-coord[1]) +
+               (xyz[2]-coord[2])*(xyz[2]-coord[2]));
+      if (d <= pface->tol) return EGADS_SUCCESS;
+      if (d < dmin) {
+        dmin = d;
+        for (m = j = 0; j < ncand; j++) {
+          if (dist[j] > dmin+cls->tmax) continue;
+          cand[m]      = cand[j];
+          dist[m]      = dist[j];
+          uvs[2*m  ]   = uvs[2*j  ];
+          uvs[2*m+1]   = uvs[2*j+1];
+          m++;
+        }
+        ncand = m;
+      }
+      if ((d > dmin+cls->tmax) || (ncand == CLASSTIE)) continue;
+      cand[ncand]      = i;
+      dist[ncand]      = d;
+      uvs[2*ncand  ]   = param[0];
+      uvs[2*ncand+1]   = param[1];
+      ncand++;
+    }
+  }
+  if (ncand == 0) return EGADS_OUTSIDE;
+
+  /* closest points shared by Faces (Edges & Nodes) -- most decisive wins */
+  for (j = 0; j < ncand; j++) {
+    if (dist[j] > dmin+cls->tmax) continue;
+    stat = EG_faceSide(cls->faces[cand[j]], &uvs[2*j], xyz, &dot);
+    if (stat != EGADS_SUCCESS) continue;
+    if (fabs(dot) > fabs(best)) best = dot;
+  }
+  if (best == 0.0) return EGADS_DEGEN;
+  if (best > 0.0)  return EGADS_OUTSIDE;
+  return EGADS_SUCCESS;
+}
+
+
+static int
+EG_classPoint(const liteClassify *cls, const double *xyz)
+{
+  int    i, parity;
+  /* skewed directions that avoid axis-aligned facet Edges */
+  static double dirs[3][3] = {{ 0.5773502691896258,  0.5345224838248488,
+                                0.6172133998483676},
+                              {-0.4082482904638630,  0.7071067811865475,
+                               -0.5773502691896258},
+                              { 0.6666666666666666, -0.3333333333333333,
+                               -0.6666666666666666}};
+
+  if ((xyz[0] < cls->bbox[0]) || (xyz[0] > cls->bbox[3]) ||
+      (xyz[1] < cls->bbox[1]) || (xyz[1] > cls->bbox[4]) ||
+      (xyz[2] < cls->bbox[2]) || (xyz[2] > cls->bbox[5]))
+    return EGADS_OUTSIDE;
+  if (cls->ntri == 0) return EG_classExact(cls, xyz);
+  if (EG_nearFacets(cls, xyz) == 1) return EG_classExact(cls, xyz);
+
+  for (i = 0; i < 3; i++) {
+    parity = EG_rayParity(cls, xyz, dirs[i]);
+    if (parity == 1) return EGADS_SUCCESS;
+    if (parity == 0) return EGADS_OUTSIDE;
+  }
+
+  return EG_classExact(cls, xyz);
+}
+
+
+__HOST_AND_DEVICE__ void
+EG_freeClassify(void *classify)
+{
+  liteClassify *cls;
+
+  cls = (liteClassify *) classify;
+  if (cls == NULL) return;
+
+  if (cls->faces       != NULL) EG_free(cls->faces);
+  if (cls->fbox        != NULL) EG_free(cls->fbox);
+  if (cls->margin      != NULL) EG_free(cls->margin);
+  if (cls->ftree.nodes != NULL) EG_free(cls->ftree.nodes);
+  if (cls->ftree.items != NULL) EG_free(cls->ftree.items);
+  if (cls->txyz        != NULL) EG_free(cls->txyz);
+  if (cls->tbox        != NULL) EG_free(cls->tbox);
+  if (cls->tface       != NULL) EG_free(cls->tface);
+  if (cls->ttree.nodes != NULL) EG_free(cls->ttree.nodes);
+  if (cls->ttree.items != NULL) EG_free(cls->ttree.items);
+  EG_free(cls);
+}
+
+
+/* fill the facets of the Faces from a Body tessellation */
+static int
+EG_classFacets(const egObject *body, liteClassify *cls)
+{
+  int          i, j, k, m, n, stat, index, len, ntri, nt, outLevel;
+  const int    *ptype, *pindex, *tris, *tric;
+  double       size, dev, d, params[3], uv[2], mid[3], data[18];
+  const double *xyz, *uvs;
+  egObject     *tess;
+
+  outLevel  = EG_outLevel(body);
+  size      = sqrt((cls->bbox[3]-cls->bbox[0])*(cls->bbox[3]-cls->bbox[0]) +
+                   (cls->bbox[4]-cls->bbox[1])*(cls->bbox[4]-cls->bbox[1]) +
+                   (cls->bbox[5]-cls->bbox[2])*(cls->bbox[5]-cls->bbox[2]));
+  params[0] = 0.1*size;
+  params[1] = 0.001*size;
+  params[2] = 15.0;
+  stat      = EG_makeTessBody((egObject *) body, params, &tess);
+  if (stat != EGADS_SUCCESS) {
+    if (outLevel > 1)
+      printf(" EGADS Info: EG_makeTessBody = %d (EG_classFacets)!\n", stat);
+    return stat;
+  }
+
+  /* all Faces must be there for parity to hold */
+  for (ntri = i = 0; i < cls->nface; i++) {
+    index = EG_indexBodyTopo(body, cls->faces[i]);
+    stat  = EG_getTessFace(tess, index, &len, &xyz, &uvs, &ptype, &pindex,
+                           &nt, &tris, &tric);
+    if ((index <= EGADS_SUCCESS) || (stat != EGADS_SUCCESS) || (nt == 0)) {
+      if (outLevel > 1)
+        printf(" EGADS Info: Face %d not tessellated (EG_classFacets)!\n",
+               index);
+      EG_deleteObject(tess);
+      return EGADS_TESSTATE;
+    }
+    ntri += nt;
+  }
+
+  cls->txyz  = (double *) EG_alloc(9*ntri*sizeof(double));
+  cls->tbox  = (double *) EG_alloc(6*ntri*sizeof(double));
+  cls->tface = (int *)    EG_alloc(  ntri*sizeof(int));
+  if ((cls->txyz == NULL) || (cls->tbox == NULL) || (cls->tface == NULL)) {
+    EG_deleteObject(tess);
+    return EGADS_MALLOC;
+  }
+
+  for (ntri = i = 0; i < cls->nface; i++) {
+    index = EG_indexBodyTopo(body, cls->faces[i]);
+    stat  = EG_getTessFace(tess, index, &len, &xyz, &uvs, &ptype, &pindex,
+                           &nt, &tris, &tric);
+    if (stat != EGADS_SUCCESS) {
+      EG_deleteObject(tess);
+      return stat;
+    }
+    /* deviation of the facet centroids & sides from the surface */
+    dev = 0.0;
+    for (j = 0; j < nt; j++, ntri++) {
+      for (k = 0; k < 3; k++) {
+        m = tris[3*j+k] - 1;
+        cls->txyz[9*ntri+3*k  ] = xyz[3*m  ];
+        cls->txyz[9*ntri+3*k+1] = xyz[3*m+1];
+        cls->txyz[9*ntri+3*k+2] = xyz[3*m+2];
+      }
+      cls->tface[ntri] = i;
+      for (k = 0; k < 3; k++) {
+        cls->tbox[6*ntri+k  ] = cls->txyz[9*ntri+k];
+        cls->tbox[6*ntri+k+3] = cls->txyz[9*ntri+k];
+        for (n = 1; n < 3; n++) {
+          d = cls->txyz[9*ntri+3*n+k];
+          if (d < cls->tbox[6*ntri+k  ]) cls->tbox[6*ntri+k  ] = d;
+          if (d > cls->tbox[6*ntri+k+3]) cls->tbox[6*ntri+k+3] = d;
+        }
+      }
+      for (n = 0; n < 4; n++) {
+        if (n == 3) {
+          uv[0] = uv[1] = 0.0;
+          for (k = 0; k < 3; k++) {
+            m = tris[3*j+k] - 1;
+            uv[0] += uvs[2*m  ]/3.0;
+            uv[1] += uvs[2*m+1]/3.0;
+          }
+          for (k = 0; k < 3; k++)
+            mid[k] = (cls->txyz[9*ntri+k] + cls->txyz[9*ntri+3+k] +
+                      cls->txyz[9*ntri+6+k])/3.0;
+        } else {
+          m     = tris[3*j+n] - 1;
+          k     = tris[3*j+(n+1)%3] - 1;
+          uv[0] = 0.5*(uvs[2*m  ] + uvs[2*k  ]);
+          uv[1] = 0.5*(uvs[2*m+1] + uvs[2*k+1]);
+          for (k = 0; k < 3; k++)
+            mid[k] = 0.5*(cls->txyz[9*ntri+3*n+k] +
+                          cls->txyz[9*ntri+3*((n+1)%3)+k]);
+        }
+        stat = EG_evaluate(cls->faces[i], uv, data);
+        if (stat != EGADS_SUCCESS) continue;
+        d = sqrt((data[0]-mid[0])*(data[0]-mid[0]) +
+                 (data[1]-mid[1])*(data[1]-mid[1]) +
+                 (data[2]-mid[2])*(data[2]-mid[2]));
+        if (d > dev) dev = d;
+      }
+    }
+    cls->margin[i] += 2.0*dev;
+  }
+  cls->ntri = ntri;
+  EG_deleteObject(tess);
+
+  return EG_boxTree(cls->ntri, cls->tbox, &cls->ttree);
+}
+
+
+static int
+EG_makeClassify(const egObject *topo, liteClassify **classify)
+{
+  int          i, k, stat, nface, outLevel;
+  egObject     **faces, *body;
+  liteFace     *pface;
+  liteShell    *pshell;
+  liteBody     *pbody;
+  liteClassify *cls;
+
+  *classify = NULL;
+  outLevel  = EG_outLevel(topo);
+  if (topo->oclass == SHELL) {
+    pshell = (liteShell *) topo->blind;
+    nface  = pshell->nfaces;
+    faces  = pshell->faces;
+    stat   = EG_getBody(topo, &body);
+    if (stat != EGADS_SUCCESS) body = NULL;
+  } else {
+    pbody  = (liteBody *) topo->blind;
+    nface  = pbody->faces.nobjs;
+    faces  = pbody->faces.objs;
+    body   = (egObject *) topo;
+  }
+  if (nface <= 0) return EGADS_NODATA;
+  for (i = 0; i < nface; i++)
+    if ((faces[i] == NULL) || (faces[i]->blind == NULL)) return EGADS_NODATA;
+
+  cls = (liteClassify *) EG_alloc(sizeof(liteClassify));
+  if (cls == NULL) return EGADS_MALLOC;
+  cls->nface       = nface;
+  cls->faces       = (egObject **) EG_alloc(nface*sizeof(egObject *));
+  cls->fbox        = (double *)    EG_alloc(6*nface*sizeof(double));
+  cls->margin      = (double *)    EG_alloc(nface*sizeof(double));
+  cls->ftree.nodes = NULL;
+  cls->ftree.items = NULL;
+  cls->ntri        = 0;
+  cls->txyz        = NULL;
+  cls->tbox        = NULL;
+  cls->tface       = NULL;
+  cls->ttree.nnode = 0;
+  cls->ttree.nodes = NULL;
+  cls->ttree.items = NULL;
+  cls->tmax        = 0.0;
+  if ((cls->faces == NULL) || (cls->fbox == NULL) || (cls->margin == NULL)) {
+    EG_freeClassify(cls);
+    return EGADS_MALLOC;
+  }
+
+  for (i = 0; i < nface; i++) {
+    pface          = (liteFace *) faces[i]->blind;
+    cls->faces[i]  = faces[i];
+    cls->margin[i] = pface->tol;
+    if (pface->tol > cls->tmax) cls->tmax = pface->tol;
+    for (k = 0; k < 3; k++) {
+      cls->fbox[6*i+k  ] = pface->bbox[k  ] - pface->tol;
+      cls->fbox[6*i+k+3] = pface->bbox[k+3] + pface->tol;
+      if ((i == 0) || (cls->fbox[6*i+k  ] < cls->bbox[k  ]))
+        cls->bbox[k  ] = cls->fbox[6*i+k  ];
+      if ((i == 0) || (cls->fbox[6*i+k+3] > cls->bbox[k+3]))
+        cls->bbox[k+3] = cls->fbox[6*i+k+3];
+    }
+  }
+  stat = EG_boxTree(nface, cls->fbox, &cls->ftree);
+  if (stat != EGADS_SUCCESS) {
+    EG_freeClassify(cls);
+    return stat;
+  }
+
+  /* facets are an accelerator -- without them everything is exact */
+  if (body != NULL) {
+    stat = EG_classFacets(body, cls);
+    if (stat != EGADS_SUCCESS) {
+      if (cls->txyz        != NULL) EG_free(cls->txyz);
+      if (cls->tbox        != NULL) EG_free(cls->tbox);
+      if (cls->tface       != NULL) EG_free(cls->tface);
+      if (cls->ttree.nodes != NULL) EG_free(cls->ttree.nodes);
+      if (cls->ttree.items != NULL) EG_free(cls->ttree.items);
+      cls->ntri        = 0;
+      cls->txyz        = NULL;
+      cls->tbox        = NULL;
+      cls->tface       = NULL;
+      cls->ttree.nodes = NULL;
+      cls->ttree.items = NULL;
+      for (i = 0; i < nface; i++)
+        cls->margin[i] = ((liteFace *) faces[i]->blind)->tol;
+    }
+  }
+  if (outLevel > 1)
+    printf(" EGADS Info: Classifier with %d Faces & %d facets!\n",
+           cls->nface, cls->ntri);
+
+  cls->dmax = 0.0;
+  for (i = 0; i < nface; i++)
+    if (cls->margin[i] > cls->dmax) cls->dmax = cls->margin[i];
+  for (k = 0; k < 3; k++) {
+    cls->bbox[k  ] -= cls->dmax;
+    cls->bbox[k+3] += cls->dmax;
+  }
+
+  *classify = cls;
+  return EGADS_SUCCESS;
+}
+
+
+/* get (or build on the Context's thread) the classifier for the Object */
+static int
+EG_getClassify(const egObject *topo, const liteClassify **classify)
+{
+  int          stat;
+  liteShell    *pshell = NULL;
+  liteBody     *pbody  = NULL;
+  liteClassify *cls;
+
+  *classify = NULL;
+  if ((topo->oclass == SHELL) && (topo->mtype == CLOSED)) {
+    pshell = (liteShell *) topo->blind;
+    cls    = (liteClassify *) pshell->classify;
+  } else if ((topo->oclass == BODY) && (topo->mtype == SOLIDBODY)) {
+    pbody  = (liteBody *) topo->blind;
+    cls    = (liteClassify *) pbody->classify;
+  } else {
+    return EGADS_NOTTOPO;
+  }
+  if (cls != NULL) {
+    /* a classifier without Faces records a failed build */
+    if (cls->nface == 0) return EGADS_NODATA;
+    *classify = cls;
+    return EGADS_SUCCESS;
+  }
+  if (EG_sameThread(topo)) return EGADS_CNTXTHRD;
+
+  stat = EG_makeClassify(topo, &cls);
+  if (stat != EGADS_SUCCESS) {
+    /* remember the failure so that it is not retried */
+    cls = (liteClassify *) EG_alloc(sizeof(liteClassify));
+    if (cls == NULL) return stat;
+    cls->nface       = 0;
+    cls->faces       = NULL;
+    cls->fbox        = NULL;
+    cls->margin      = NULL;
+    cls->ftree.nnode = 0;
+    cls->ftree.nodes = NULL;
+    cls->ftree.items = NULL;
+    cls->ntri        = 0;
+    cls->txyz        = NULL;
+    cls->tbox        = NULL;
+    cls->tface       = NULL;
+    cls->ttree.nnode = 0;
+    cls->ttree.nodes = NULL;
+    cls->ttree.items = NULL;
+    if (pshell != NULL) {
+      pshell->classify = cls;
+    } else {
+      pbody->classify  = cls;
+    }
+    return stat;
+  }
+  if (pshell != NULL) {
+    pshell->classify = cls;
+  } else {
+    pbody->classify  = cls;
+  }
+
+  *classify = cls;
+  return EGADS_SUCCESS;
+}
+
+
+/* the closest Face result -- never builds a classifier */
+__HOST_AND_DEVICE__ static int
+EG_inTopoFaces(const egObject *topo, const double *xyz)
 {
   int       i, j, stat;
   double    d, dist, param[2], uv[2], coord[3], dir[3], norm[3], data[18];
@@ -1057,3 +1887,158 @@ EG_inTopology(const egObject *topo, const double *xyz)
   
   return EGADS_NOTTOPO;
 }
+
+
+__HOST_AND_DEVICE__ int
+EG_inTopology(const egObject *topo, const double *xyz)
+{
+#ifndef __CUDA_ARCH__
+  const liteClassify *cls;
+  
+  if (topo == NULL)               return EGADS_NULLOBJ;
+  if (topo->magicnumber != MAGIC) return EGADS_NOTOBJ;
+  if (topo->blind == NULL)        return EGADS_NODATA;
+  
+  if (((topo->oclass == SHELL) && (topo->mtype == CLOSED)) ||
+      ((topo->oclass == BODY)  && (topo->mtype == SOLIDBODY)))
+    if (EG_getClassify(topo, &cls) == EGADS_SUCCESS)
+      return EG_classPoint(cls, xyz);
+#endif
+  
+  return EG_inTopoFaces(topo, xyz);
+}
+
+
+static void
+EG_classThread(void *struc)
+{
+  int      i, index;
+  long     ID;
+  EMPclass *cthread;
+
+  cthread = (EMPclass *) struc;
+
+  /* get our identifier */
+  ID = EMP_ThreadID();
+
+  /* look for work */
+  for (;;) {
+
+    /* only one thread at a time here -- controlled by a mutex! */
+    if (cthread->mutex != NULL) EMP_LockSet(cthread->mutex);
+    index           = cthread->index;
+    cthread->index += CLASSBLOCK;
+    if (cthread->mutex != NULL) EMP_LockRelease(cthread->mutex);
+    if (index >= cthread->end) break;
+
+    /* do the work */
+    for (i = index; (i < index+CLASSBLOCK) && (i < cthread->end); i++)
+      if (cthread->cls == NULL) {
+        cthread->results[i] = EG_inTopoFaces(cthread->topo,
+                                             &cthread->xyzs[3*i]);
+      } else {
+        cthread->results[i] = EG_classPoint(cthread->cls,
+                                            &cthread->xyzs[3*i]);
+      }
+  }
+
+  /* exhausted all work -- exit */
+  if (ID != cthread->master) EMP_ThreadExit();
+}
+
+
+int
+EG_inTopologyBatch(const egObject *topo, int npts, const double *xyzs,
+                   int *results)
+{
+  int               i, np, stat, outLevel;
+  long              start;
+  void              **threads = NULL;
+  EMPclass          cthread;
+  const liteClassify *cls = NULL;
+
+  if (topo == NULL)               return EGADS_NULLOBJ;
+  if (topo->magicnumber != MAGIC) return EGADS_NOTOBJ;
+  if (topo->blind == NULL)        return EGADS_NODATA;
+  if ((topo->oclass != EDGE) && (topo->oclass != FACE) &&
+      (topo->oclass != SHELL) && (topo->oclass != BODY))
+                                  return EGADS_NOTTOPO;
+  outLevel = EG_outLevel(topo);
+  if (npts <= 0) {
+    if (outLevel > 0)
+      printf(" EGADS Error: nPoints = %d (EG_inTopologyBatch)!\n", npts);
+    return EGADS_RANGERR;
+  }
+  if ((xyzs == NULL) || (results == NULL)) {
+    if (outLevel > 0)
+      printf(" EGADS Error: NULL Arguments (EG_inTopologyBatch)!\n");
+    return EGADS_NODATA;
+  }
+
+  /* build the classifier up front so the threads only read it */
+  if (((topo->oclass == SHELL) && (topo->mtype == CLOSED)) ||
+      ((topo->oclass == BODY)  && (topo->mtype == SOLIDBODY))) {
+    stat = EG_getClassify(topo, &cls);
+    if ((stat != EGADS_SUCCESS) && (outLevel > 1))
+      printf(" EGADS Info: EG_getClassify = %d (EG_inTopologyBatch)!\n",
+             stat);
+  }
+
+  /* set up for explicit multithreading */
+  cthread.mutex   = NULL;
+  cthread.master  = EMP_ThreadID();
+  cthread.end     = npts;
+  cthread.index   = 0;
+  cthread.topo    = topo;
+  cthread.cls     = cls;
+  cthread.xyzs    = xyzs;
+  cthread.results = results;
+
+  np = EMP_Init(&start);
+  if (outLevel > 1) printf(" EMP NumProcs = %d!\n", np);
+  if ((npts+CLASSBLOCK-1)/CLASSBLOCK < np) np = (npts+CLASSBLOCK-1)/CLASSBLOCK;
+
+  if (np > 1) {
+    /* create the mutex to handle list synchronization */
+    cthread.mutex = EMP_LockCreate();
+    if (cthread.mutex == NULL) {
+      printf(" EMP Error: mutex creation = NULL!\n");
+      np = 1;
+    } else {
+      /* get storage for our extra threads */
+      threads = (void **) malloc((np-1)*sizeof(void *));
+      if (threads == NULL) {
+        EMP_LockDestroy(cthread.mutex);
+        cthread.mutex = NULL;
+        np = 1;
+      }
+    }
+  }
+
+  /* create the threads and get going! */
+  if (threads != NULL)
+    for (i = 0; i < np-1; i++) {
+      threads[i] = EMP_ThreadCreate(EG_classThread, &cthread);
+      if (threads[i] == NULL)
+        printf(" EMP Error Creating Thread #%d!\n", i+1);
+    }
+  /* now run the thread block from the original thread */
+  EG_classThread(&cthread);
+
+  /* wait for all others to return */
+  if (threads != NULL)
+    for (i = 0; i < np-1; i++)
+      if (threads[i] != NULL) EMP_ThreadWait(threads[i]);
+
+  /* cleanup */
+  if (threads != NULL)
+    for (i = 0; i < np-1; i++)
+      if (threads[i] != NULL) EMP_ThreadDestroy(threads[i]);
+  if (cthread.mutex != NULL) EMP_LockDestroy(cthread.mutex);
+  if (threads != NULL) free(threads);
+  if (outLevel > 1)
+    printf(" EMP Number of Seconds on Classify Thread Block = %ld\n",
+           EMP_Done(&start));
+
+  return EGADS_SUCCESS;
+}
@@ -11,6 +11,7 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <stddef.h>
 #include <string.h>
 #include <math.h>
 
@@ -27,6 +28,16 @@
                           a[2] = (b[0]*c[1]) - (b[1]*c[0])
 #define DOT(a,b)         (a[0]*b[0] + a[1]*b[1] + a[2]*b[2])
 
+#define NAMEBINS          1021          /* hash bins for interned names */
+
+
+/* an interned attribute name -- one copy per Context */
+typedef struct egName {
+  struct egName *next;                  /* next name in the hash bin */
+  int           nref;                   /* number of attributes using it */
+  char          name[1];                /* the name (allocated to length) */
+} egName;
+
 
 
 extern int EG_fullAttrs( const egObject *obj );
@@ -37,6 +48,157 @@ extern int EG_getTopology( const egObject *topo, egObject **geom, int *oclass,
                            egObject ***children, int **senses );
 
 
+static unsigned int
+EG_nameHash(const char *name)
+{
+  unsigned int hash = 5381;
+
+  while (*name != 0) hash = 33*hash + (unsigned char) *name++;
+
+  return hash%NAMEBINS;
+}
+
+
+/* get the Context's copy of a name -- adding it when not found */
+/*@null@*/ char *
+EG_attrName(const egObject *obj, const char *name)
+{
+  int          len;
+  unsigned int bin;
+  egObject     *context;
+  egCntxt      *cntx;
+  egName       **bins, *ename;
+
+  context = EG_context(obj);
+  if (context == NULL) return NULL;
+  cntx = (egCntxt *) context->blind;
+  if (cntx == NULL) return NULL;
+  if (cntx->names == NULL) {
+    bins = (egName **) EG_alloc(NAMEBINS*sizeof(egName *));
+    if (bins == NULL) return NULL;
+    for (bin = 0; bin < NAMEBINS; bin++) bins[bin] = NULL;
+    cntx->names = bins;
+  }
+  bins = (egName **) cntx->names;
+
+  bin = EG_nameHash(name);
+  for (ename = bins[bin]; ename != NULL; ename = ename->next)
+    if (strcmp(ename->name, name) == 0) {
+      ename->nref++;
+      return ename->name;
+    }
+
+  len   = strlen(name);
+  ename = (egName *) EG_alloc(sizeof(egName)+len);
+  if (ename == NULL) return NULL;
+  memcpy(ename->name, name, len+1);
+  ename->nref = 1;
+  ename->next = bins[bin];
+  bins[bin]   = ename;
+
+  return ename->name;
+}
+
+
+static char *
+EG_nameRef(char *name)
+{
+  egName *ename;
+
+  ename = (egName *) (name - offsetof(egName, name));
+  ename->nref++;
+
+  return name;
+}
+
+
+static void
+EG_nameFree(const egObject *obj, /*@null@*/ char *name)
+{
+  unsigned int bin;
+  egObject     *context;
+  egCntxt      *cntx;
+  egName       **bins, *ename, *last, *entry;
+
+  if (name == NULL) return;
+  ename = (egName *) (name - offsetof(egName, name));
+  ename->nref--;
+  if (ename->nref > 0) return;
+
+  context = EG_context(obj);
+  if (context == NULL) return;
+  cntx = (egCntxt *) context->blind;
+  if (cntx == NULL) return;
+  bins = (egName **) cntx->names;
+  if (bins == NULL) return;
+
+  bin  = EG_nameHash(name);
+  last = NULL;
+  for (entry = bins[bin]; entry != NULL; entry = entry->next) {
+    if (entry == ename) {
+      if (last == NULL) {
+        bins[bin]  = entry->next;
+      } else {
+        last->next = entry->next;
+      }
+      EG_free(ename);
+      return;
+    }
+    last = entry;
+  }
+}
+
+
+void
+EG_attrNamesFree(/*@null@*/ void *names)
+{
+  int    i;
+  egName **bins, *ename, *next;
+
+  if (names == NULL) return;
+  bins = (egName **) names;
+  for (i = 0; i < NAMEBINS; i++)
+    for (ename = bins[i]; ename != NULL; ename = next) {
+      next = ename->next;
+      EG_free(ename);
+    }
+  EG_free(bins);
+}
+
+
+/* release an attribute block -- or just our use of it when shared */
+static void
+EG_attrsFree(const egObject *obj, egAttrs *attrs)
+{
+  int i;
+
+  /* a count of 0 (a block not made here) is taken as a single owner */
+  if (attrs->nref > 1) {
+    attrs->nref--;
+    return;
+  }
+
+  for (i = 0; i < attrs->nseqs; i++) {
+    EG_free(attrs->seqs[i].root);
+    EG_free(attrs->seqs[i].attrSeq);
+  }
+  if (attrs->seqs != NULL) EG_free(attrs->seqs);
+  for (i = 0; i < attrs->nattrs; i++) {
+    EG_nameFree(obj, attrs->attrs[i].name);
+    if (attrs->attrs[i].type == ATTRINT) {
+      if (attrs->attrs[i].length > 1) EG_free(attrs->attrs[i].vals.integers);
+    } else if ((attrs->attrs[i].type == ATTRREAL) ||
+               (attrs->attrs[i].type == ATTRCSYS)) {
+      if (attrs->attrs[i].length > 1) EG_free(attrs->attrs[i].vals.reals);
+    } else if (attrs->attrs[i].type == ATTRSTRING) {
+      EG_free(attrs->attrs[i].vals.string);
+    }
+  }
+  EG_free(attrs->attrs);
+  EG_free(attrs);
+}
+
+
 
 int
 EG_attributePrint(const egObject *obj)
@@ -89,10 +251,10 @@ EG_attributePrint(const egObject *obj)
 
 
 void
-EG_attrBuildSeq(egAttrs *attrs)
+EG_attrBuildSeq(const egObject *obj, egAttrs *attrs)
 {
   int       i, j, l, n, snum, *hit, nospace = 0, nseqs = 0;
-  char      *root, *newname;
+  char      *root, *newname, *name;
   egAttr    *attr;
   egAttrSeq *seqs = NULL, *tmp;
   
@@ -160,8 +322,11 @@ EG_attrBuildSeq(egAttrs *attrs)
     if (snum == 1) {
       if (nospace == 1) continue;
       /* remove existing seq number */
-      EG_free(attrs->attrs[i].name);
-      attrs->attrs[i].name = root;
+      name = EG_attrName(obj, root);
+      EG_free(root);
+      if (name == NULL) continue;
+      EG_nameFree(obj, attrs->attrs[i].name);
+      attrs->attrs[i].name = name;
       continue;
     }
     
@@ -224,10 +389,16 @@ EG_attrBuildSeq(egAttrs *attrs)
         continue;
       }
       snprintf(newname, n+8, "%s %d", root, j+1);
-      EG_free(attr->name);
-      attr->name = newname;
+      name = EG_attrName(obj, newname);
+      EG_free(newname);
+      if (name == NULL) {
+        printf(" EGADS Internal: Malloc on name %s!\n", root);
+        continue;
+      }
+      EG_nameFree(obj, attr->name);
+      attr->name = name;
 #ifdef DEBUG
-      printf(" seq = %d, newname = %s\n", j+1, newname);
+      printf(" seq = %d, newname = %s\n", j+1, name);
 #endif
     }
 #ifdef DEBUG
@@ -247,6 +418,67 @@ EG_attrBuildSeq(egAttrs *attrs)
 }
 
 
+/* give the object its own copy of a shared attribute block before a change */
+int
+EG_attrUnshare(egObject *obj)
+{
+  int     i, j, len;
+  egAttr  *attr;
+  egAttrs *attrs, *cattrs;
+
+  attrs = (egAttrs *) obj->attrs;
+  if (attrs == NULL)     return EGADS_SUCCESS;
+  /* 0 is treated as 1 -- see EG_attrsFree */
+  if (attrs->nref <= 1)  return EGADS_SUCCESS;
+
+  cattrs = (egAttrs *) EG_alloc(sizeof(egAttrs));
+  if (cattrs == NULL)    return EGADS_MALLOC;
+  attr = NULL;
+  if (attrs->nattrs != 0) {
+    attr = (egAttr *) EG_alloc(attrs->nattrs*sizeof(egAttr));
+    if (attr == NULL) {
+      EG_free(cattrs);
+      return EGADS_MALLOC;
+    }
+  }
+  for (i = 0; i < attrs->nattrs; i++) {
+    attr[i]      = attrs->attrs[i];
+    attr[i].name = EG_nameRef(attrs->attrs[i].name);
+    len          = attr[i].length;
+    if ((attr[i].type == ATTRINT) && (len > 1)) {
+      attr[i].vals.integers = (int *) EG_alloc(len*sizeof(int));
+      if (attr[i].vals.integers == NULL) {
+        attr[i].length = 0;
+      } else {
+        for (j = 0; j < len; j++)
+          attr[i].vals.integers[j] = attrs->attrs[i].vals.integers[j];
+      }
+    } else if (((attr[i].type == ATTRREAL) ||
+                (attr[i].type == ATTRCSYS)) && (len > 1)) {
+      attr[i].vals.reals = (double *) EG_alloc(len*sizeof(double));
+      if (attr[i].vals.reals == NULL) {
+        attr[i].length = 0;
+      } else {
+        for (j = 0; j < len; j++)
+          attr[i].vals.reals[j] = attrs->attrs[i].vals.reals[j];
+      }
+    } else if (attr[i].type == ATTRSTRING) {
+      attr[i].vals.string = EG_strdup(attrs->attrs[i].vals.string);
+    }
+  }
+  cattrs->nattrs = attrs->nattrs;
+  cattrs->attrs  = attr;
+  cattrs->nseqs  = 0;
+  cattrs->seqs   = NULL;
+  cattrs->nref   = 1;
+  if (attrs->nseqs != 0) EG_attrBuildSeq(obj, cattrs);
+
+  attrs->nref--;
+  obj->attrs = cattrs;
+  return EGADS_SUCCESS;
+}
+
+
 static int
 EG_constructCSys(egObject *obj, int outLevel, int len, const double *reals,
                  double *csys)
@@ -614,6 +846,16 @@ EG_attributeMerge(int flg, egObject *obj, const char *name, int atype, int lenx,
     if (stat != EGADS_SUCCESS) return stat;
   }
 
+  /* we are about to change the attributes -- make them ours */
+  stat = EG_attrUnshare(obj);
+  if (stat != EGADS_SUCCESS) {
+    if (outLevel > 0)
+      printf(" EGADS Error: Unshare MALLOC for %s (EG_attributeAdd)!\n",
+             name);
+    return stat;
+  }
+  attrs = (egAttrs *) obj->attrs;
+
   if (attrs != NULL)
     for (i = 0; i < attrs->nattrs; i++)
       if (strcmp(attrs->attrs[i].name,name) == 0) {
@@ -651,6 +893,7 @@ EG_attributeMerge(int flg, egObject *obj, const char *name, int atype, int lenx,
       attrs->attrs  = NULL;
       attrs->nseqs  = 0;
       attrs->seqs   = NULL;
+      attrs->nref   = 1;
       obj->attrs    = attrs;
     }
     if (attrs->attrs == NULL) {
@@ -668,7 +911,7 @@ EG_attributeMerge(int flg, egObject *obj, const char *name, int atype, int lenx,
     attrs->attrs = attr;
     find = attrs->nattrs;
     attrs->attrs[find].vals.string = NULL;
-    attrs->attrs[find].name        = EG_strdup(name);
+    attrs->attrs[find].name        = EG_attrName(obj, name);
     if (attrs->attrs[find].name == NULL) return EGADS_MALLOC;
     attrs->nattrs += 1;
   }
@@ -884,7 +1127,7 @@ EG_attributeAddSeq(egObject *obj, const char *name, int atype, int len,
     EG_free(newname);
     if (stat != EGADS_SUCCESS) return stat;
     
-    EG_attrBuildSeq(obj->attrs);
+    EG_attrBuildSeq(obj, obj->attrs);
     return seq;
   }
   
@@ -904,7 +1147,7 @@ EG_attributeAddSeq(egObject *obj, const char *name, int atype, int len,
   EG_free(newname);
   if (stat != EGADS_SUCCESS) return stat;
   
-  EG_attrBuildSeq(obj->attrs);
+  EG_attrBuildSeq(obj, obj->attrs);
   return seq;
 }
 
@@ -912,7 +1155,7 @@ EG_attributeAddSeq(egObject *obj, const char *name, int atype, int len,
 int
 EG_attributeDel(egObject *obj, /*@null@*/ const char *name)
 {
-  int     i, j, k, outLevel, find = -1;
+  int     i, j, k, stat, outLevel, find = -1;
   char    *cptr;
   egAttrs *attrs;
 
@@ -931,27 +1174,15 @@ EG_attributeDel(egObject *obj, /*@null@*/ const char *name)
 
     /* delete all attributes associated with the object */
     obj->attrs = NULL;
-    for (i = 0; i < attrs->nseqs; i++) {
-      EG_free(attrs->seqs[i].root);
-      EG_free(attrs->seqs[i].attrSeq);
-    }
-    if (attrs->seqs != NULL) EG_free(attrs->seqs);
-    for (i = 0; i < attrs->nattrs; i++) {
-      EG_free(attrs->attrs[i].name);
-      if (attrs->attrs[i].type == ATTRINT) {
-        if (attrs->attrs[i].length > 1) EG_free(attrs->attrs[i].vals.integers);
-      } else if ((attrs->attrs[i].type == ATTRREAL) ||
-                 (attrs->attrs[i].type == ATTRCSYS)) {
-        if (attrs->attrs[i].length > 1) EG_free(attrs->attrs[i].vals.reals);
-      } else if (attrs->attrs[i].type == ATTRSTRING) {
-        EG_free(attrs->attrs[i].vals.string);
-      }
-    }
-    EG_free(attrs->attrs);
-    EG_free(attrs);
+    EG_attrsFree(obj, attrs);
 
   } else {
 
+    /* we are about to change the attributes -- make them ours */
+    stat = EG_attrUnshare(obj);
+    if (stat != EGADS_SUCCESS) return stat;
+    attrs = (egAttrs *) obj->attrs;
+
     /* are we sequenced? */
     
     for (i = 0; i < attrs->nseqs; i++)
@@ -963,7 +1194,7 @@ EG_attributeDel(egObject *obj, /*@null@*/ const char *name)
       /* delete all attribues in the sequence */
       for (i = attrs->seqs[find].nSeq-1; i >= 0; i--) {
         j = attrs->seqs[find].attrSeq[i];
-        EG_free(attrs->attrs[j].name);
+        EG_nameFree(obj, attrs->attrs[j].name);
         if (attrs->attrs[j].type == ATTRINT) {
           if (attrs->attrs[j].length > 1)
             EG_free(attrs->attrs[j].vals.integers);
@@ -978,7 +1209,7 @@ EG_attributeDel(egObject *obj, /*@null@*/ const char *name)
           attrs->attrs[k-1] = attrs->attrs[k];
         attrs->nattrs -= 1;
       }
-      EG_attrBuildSeq(attrs);
+      EG_attrBuildSeq(obj, attrs);
       return EGADS_SUCCESS;
     }
     
@@ -1013,10 +1244,10 @@ EG_attributeDel(egObject *obj, /*@null@*/ const char *name)
     j = strlen(name);
     for (i = 0; i < j; i++)
       if (name[i] == 32) {
-        EG_attrBuildSeq(attrs);
+        EG_attrBuildSeq(obj, attrs);
         break;
       }
-    EG_free(cptr);
+    EG_nameFree(obj, cptr);
   }
 
   return EGADS_SUCCESS;
@@ -1224,7 +1455,7 @@ int
 EG_attributeXDup(const egObject *src, /*@null@*/ const double *xform,
                        egObject *dst)
 {
-  int     i, j, k, l, n, stat, len, outLevel, fullAttr, freer, *ints;
+  int     i, j, k, l, n, stat, len, outLevel, fullAttr, freer, ncsys, *ints;
   double  *reals;
   char    *str, *name;
   egAttr  *attr;
@@ -1254,37 +1485,30 @@ EG_attributeXDup(const egObject *src, /*@null@*/ const double *xform,
     dattrs = dst->attrs;
     if (dattrs != NULL) {
       dst->attrs = NULL;
-      for (i = 0; i < dattrs->nseqs; i++) {
-        EG_free(dattrs->seqs[i].root);
-        EG_free(dattrs->seqs[i].attrSeq);
-      }
-      if (dattrs->seqs != NULL) EG_free(dattrs->seqs);
-      dattrs->nseqs = 0;
-      dattrs->seqs  = NULL;
-      for (i = 0; i < dattrs->nattrs; i++) {
-        EG_free(dattrs->attrs[i].name);
-        if (dattrs->attrs[i].type == ATTRINT) {
-          if (dattrs->attrs[i].length > 1) EG_free(dattrs->attrs[i].vals.integers);
-        } else if ((dattrs->attrs[i].type == ATTRREAL) ||
-                   (dattrs->attrs[i].type == ATTRCSYS)) {
-          if (dattrs->attrs[i].length > 1) EG_free(dattrs->attrs[i].vals.reals);
-        } else if (dattrs->attrs[i].type == ATTRSTRING) {
-          EG_free(dattrs->attrs[i].vals.string);
-        }
-      }
-      EG_free(dattrs->attrs);
-      EG_free(dattrs);
+      EG_attrsFree(dst, dattrs);
     }
   }
   
   sattrs = src->attrs;
   if (sattrs == NULL) return EGADS_SUCCESS;
-  for (n = i = 0; i < sattrs->nattrs; i++)
-    if (sattrs->attrs[i].type != ATTRPTR) n++;
+  for (ncsys = n = i = 0; i < sattrs->nattrs; i++) {
+    if (sattrs->attrs[i].type != ATTRPTR)  n++;
+    if (sattrs->attrs[i].type == ATTRCSYS) ncsys++;
+  }
   if (n == 0) return EGADS_SUCCESS;
   
   dattrs = dst->attrs;
-  if (dattrs == NULL) {
+  if ((dattrs == NULL) && (n == sattrs->nattrs) &&
+      ((xform == NULL) || (ncsys == 0)) &&
+      (EG_context(src) == EG_context(dst))) {
+
+    /* nothing to change -- share the block until one side writes */
+    if (sattrs->nref < 1) sattrs->nref = 1;
+    sattrs->nref++;
+    dst->attrs = sattrs;
+    return EGADS_SUCCESS;
+
+  } else if (dattrs == NULL) {
 
     /* copy the attributes */
     dattrs = (egAttrs *) EG_alloc(sizeof(egAttrs));
@@ -1297,6 +1521,7 @@ EG_attributeXDup(const egObject *src, /*@null@*/ const double *xform,
     dattrs->attrs  = NULL;
     dattrs->nseqs  = 0;
     dattrs->seqs   = NULL;
+    dattrs->nref   = 1;
     dst->attrs     = dattrs;
     attr           = (egAttr *) EG_alloc(n*sizeof(egAttr));
     if (attr == NULL) {
@@ -1306,7 +1531,7 @@ EG_attributeXDup(const egObject *src, /*@null@*/ const double *xform,
     }
     for (k = i = 0; i < sattrs->nattrs; i++) {
       if (sattrs->attrs[i].type == ATTRPTR) continue;
-      attr[k].name   = EG_strdup(sattrs->attrs[i].name);
+      attr[k].name   = EG_attrName(dst, sattrs->attrs[i].name);
       attr[k].length = sattrs->attrs[i].length;
       attr[k].type   = sattrs->attrs[i].type;
       if (attr[k].type == ATTRINT) {
@@ -1417,7 +1642,12 @@ EG_attributeXDup(const egObject *src, /*@null@*/ const double *xform,
       if (freer == 1) EG_free(reals);
     }
   }
-  EG_attrBuildSeq(dattrs);
+  if (dst->attrs != NULL) {
+    /* a merge that changed nothing may still share the block */
+    stat = EG_attrUnshare(dst);
+    if (stat != EGADS_SUCCESS) return stat;
+    EG_attrBuildSeq(dst, dst->attrs);
+  }
   
   return EGADS_SUCCESS;
 }
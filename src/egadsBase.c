@@ -29,10 +29,18 @@
 
 
 #define ZERO            1.e-5           /* allow for float-like precision */
+#define EGSLAB          512             /* objects allocated per slab */
+#define NFCLASS         18              /* classes released at fast close */
 #define STRING(a)       #a
 #define STR(a)          STRING(a)
 
 
+typedef struct egSlab {
+  struct egSlab *next;                  /* the next slab in the context */
+  egObject      objs[EGSLAB];           /* the object structures */
+} egSlab;
+
+
   static char *EGADSprop[2] = {STR(EGADSPROP),
                                "\nEGADSprop: Copyright 2011-2022 MIT. All Rights Reserved."};
 
@@ -60,6 +68,7 @@
   extern int  EG_getTolerance( const egObject *topo, double *tol );
 
   extern int  EG_computeTessMap( egTessel *btess, int outLevel );
+  extern void EG_cleanupEdgeEdits( egTessel *btess );
   extern int  EG_initTessBody( egObject *object, egObject **tess );
   extern int  EG_getTessEdge( const egObject *tess, int eIndex, int *len,
                               const double **xyz, const double **t );
@@ -73,6 +82,7 @@
                               const double *xyz, const double *uv, int ntri,
                               const int *tris );
   extern int  EG_sampleSame( const egObject *obj1, const egObject *obj2 );
+  extern void EG_attrNamesFree( /*@null@*/ void *names );
 
 
 
@@ -286,6 +296,26 @@ EG_setFullAttrs(egObject *context, int fullAttrs)
 }
 
 
+int
+EG_setFastClose(egObject *context, int fastClose)
+{
+  int     old;
+  egCntxt *cntx;
+
+  if  (context == NULL)                   return EGADS_NULLOBJ;
+  if  (context->magicnumber != MAGIC)     return EGADS_NOTOBJ;
+  if  (context->oclass != CONTXT)         return EGADS_NOTCNTX;
+  if ((fastClose < 0) || (fastClose > 1)) return EGADS_RANGERR;
+  cntx = (egCntxt *) context->blind;
+  if  (cntx == NULL)                      return EGADS_NODATA;
+  if  (EG_sameThread(context))            return EGADS_CNTXTHRD;
+  old             = cntx->fastClose;
+  cntx->fastClose = fastClose;
+  
+  return old;
+}
+
+
 int
 EG_setTessParam(egObject *context, int iParam, double value, double *oldValue)
 {
@@ -308,9 +338,10 @@ EG_setTessParam(egObject *context, int iParam, double value, double *oldValue)
 int
 EG_makeObject(/*@null@*/ egObject *context, egObject **obj)
 {
-  int      outLevel;
+  int      i, outLevel;
   egObject *object, *prev;
   egCntxt  *cntx;
+  egSlab   *slab;
 
   if (context == NULL)               return EGADS_NULLOBJ;
   if (context->magicnumber != MAGIC) return EGADS_NOTOBJ;
@@ -323,13 +354,29 @@ EG_makeObject(/*@null@*/ egObject *context, egObject **obj)
   /* any objects in the pool? */
   object = cntx->pool;
   if (object == NULL) {
-    object = (egObject *) EG_alloc(sizeof(egObject));
-    if (object == NULL) {
+    /* no -- get a slab and put all but the first in the pool */
+    slab = (egSlab *) EG_alloc(sizeof(egSlab));
+    if (slab == NULL) {
       if (outLevel > 0) 
         printf(" EGADS Error: Malloc on Object (EG_makeObject)!\n");
       if (cntx->mutex != NULL) EMP_LockRelease(cntx->mutex);
       return EGADS_MALLOC;
     }
+    slab->next  = (egSlab *) cntx->slabs;
+    cntx->slabs = slab;
+    for (i = EGSLAB-1; i > 0; i--) {
+      slab->objs[i].magicnumber = MAGIC;
+      slab->objs[i].oclass      = EMPTY;
+      slab->objs[i].mtype       = NIL;
+      slab->objs[i].tref        = NULL;
+      slab->objs[i].attrs       = NULL;
+      slab->objs[i].blind       = NULL;
+      slab->objs[i].topObj      = context;
+      slab->objs[i].prev        = NULL;
+      slab->objs[i].next        = cntx->pool;
+      cntx->pool                = &slab->objs[i];
+    }
+    object = &slab->objs[0];
   } else {
     cntx->pool   = object->next;
     object->prev = NULL;
@@ -378,6 +425,9 @@ EG_open(egObject **context)
   cntx->mutex      = EMP_LockCreate();
   cntx->pool       = NULL;
   cntx->last       = object;
+  cntx->fastClose  = 0;
+  cntx->slabs      = NULL;
+  cntx->names      = NULL;
   if (cntx->mutex == NULL)
     printf(" EMP Error: mutex creation = NULL (EG_open)!\n");
   
@@ -550,14 +600,127 @@ EG_referenceTopObj(egObject *object, /*@null@*/ const egObject *ref)
 }
 
 
+static int EG_derefObj(egObject *object, /*@null@*/ const egObject *refx,
+                       int flg);
+
+
+/* release everything owned by the object (but not the object itself) */
 static int
-EG_derefObj(egObject *object, /*@null@*/ const egObject *refx, int flg)
+EG_freeBlind(egObject *context, egObject *object, int flg)
 {
   int      i, j, stat, outLevel;
+  egTessel *tess;
+
+  outLevel = ((egCntxt *) context->blind)->outLevel;
+
+  stat = EG_attributeDel(object, NULL);
+  if (stat != EGADS_SUCCESS)
+    if ((outLevel > 0) && (stat != EGADS_EMPTY))
+      printf(" EGADS Warning: Del Attributes = %d (EG_destroyObject)!\n",
+             stat);
+
+  stat = EGADS_SUCCESS;
+  if (object->oclass == TRANSFORM) {
+  
+    EG_free(object->blind);
+
+  } else if (object->oclass == TESSELLATION) {
+
+    tess = (egTessel *) object->blind;
+    if (tess != NULL) {
+      if (object->topObj == context) {
+        EG_dereferenceTopObj(tess->src, object);
+      } else {
+        EG_derefObj(tess->src, object, 0);
+      }
+      EG_cleanupEdgeEdits(tess);
+      if (tess->xyzs != NULL) EG_free(tess->xyzs);
+      if (tess->tess1d != NULL) {
+        for (i = 0; i < tess->nEdge; i++) {
+          if (tess->tess1d[i].faces[0].faces != NULL)
+            EG_free(tess->tess1d[i].faces[0].faces);
+          if (tess->tess1d[i].faces[1].faces != NULL)
+            EG_free(tess->tess1d[i].faces[1].faces);
+          if (tess->tess1d[i].faces[0].tric  != NULL)
+            EG_free(tess->tess1d[i].faces[0].tric);
+          if (tess->tess1d[i].faces[1].tric  != NULL)
+            EG_free(tess->tess1d[i].faces[1].tric);
+          if (tess->tess1d[i].xyz    != NULL)
+            EG_free(tess->tess1d[i].xyz);
+          if (tess->tess1d[i].t      != NULL)
+            EG_free(tess->tess1d[i].t);
+          if (tess->tess1d[i].global != NULL)
+            EG_free(tess->tess1d[i].global);
+        }
+        EG_free(tess->tess1d);
+      }
+      if (tess->tess2d != NULL) {
+        for (i = 0; i < 2*tess->nFace; i++) {
+          if (tess->tess2d[i].mKnots != NULL) 
+            EG_deleteObject(tess->tess2d[i].mKnots);
+          if (tess->tess2d[i].xyz    != NULL) 
+            EG_free(tess->tess2d[i].xyz);
+          if (tess->tess2d[i].uv     != NULL) 
+            EG_free(tess->tess2d[i].uv);
+          if (tess->tess2d[i].global != NULL)
+            EG_free(tess->tess2d[i].global);
+          if (tess->tess2d[i].ptype  != NULL) 
+            EG_free(tess->tess2d[i].ptype);
+          if (tess->tess2d[i].pindex != NULL) 
+            EG_free(tess->tess2d[i].pindex);
+          if (tess->tess2d[i].bary   != NULL)
+            EG_free(tess->tess2d[i].bary);
+          if (tess->tess2d[i].frame != NULL)
+            EG_free(tess->tess2d[i].frame);
+          if (tess->tess2d[i].frlps != NULL)
+            EG_free(tess->tess2d[i].frlps);
+          if (tess->tess2d[i].tris   != NULL) 
+            EG_free(tess->tess2d[i].tris);
+          if (tess->tess2d[i].tric   != NULL) 
+            EG_free(tess->tess2d[i].tric);
+          if (tess->tess2d[i].patch  != NULL) {
+            for (j = 0; j < tess->tess2d[i].npatch; j++) {
+              if (tess->tess2d[i].patch[j].ipts != NULL) 
+                EG_free(tess->tess2d[i].patch[j].ipts);
+              if (tess->tess2d[i].patch[j].bounds != NULL) 
+                EG_free(tess->tess2d[i].patch[j].bounds);
+            }
+            EG_free(tess->tess2d[i].patch);
+          }
+        }
+        EG_free(tess->tess2d);
+      }
+      if (tess->globals != NULL) EG_free(tess->globals);
+      EG_free(tess);
+    }
+
+  } else if (object->oclass <= SURFACE) {
+  
+    if ((object->oclass != NIL) && (flg == 0))
+      stat = EG_destroyGeometry(object);
+    
+  } else if (object->oclass == EBODY) {
+  
+    stat = EGADS_SUCCESS;
+    EG_destroyEBody(object, 0);
+  
+  } else {
+  
+    if (flg == 0) stat = EG_destroyTopology(object);
+
+  }
+
+  return stat;
+}
+
+
+static int
+EG_derefObj(egObject *object, /*@null@*/ const egObject *refx, int flg)
+{
+  int      i, stat, outLevel;
   LONG     ptr1, ptr2;
   egObject *pobj, *nobj, *obj, *context;
   egCntxt  *cntx;
-  egTessel *tess;
   const egObject *ref;
 
   if (object == NULL)               return EGADS_NULLOBJ;
@@ -569,6 +732,8 @@ EG_derefObj(egObject *object, /*@null@*/ const egObject *refx, int flg)
   if (context == NULL)              return EGADS_NOTCNTX;
   cntx = (egCntxt *) context->blind;
   if (cntx == NULL)                 return EGADS_NODATA;
+  /* fast close -- everything goes, no need to maintain references */
+  if (cntx->fastClose == 2)         return EGADS_SUCCESS;
   outLevel = cntx->outLevel;
   ref      = refx;
 
@@ -657,101 +822,7 @@ EG_derefObj(egObject *object, /*@null@*/ const egObject *refx, int flg)
   }
   if (object->tref != NULL) return EGADS_SUCCESS;
 
-  stat = EG_attributeDel(object, NULL);
-  if (stat != EGADS_SUCCESS)
-    if ((outLevel > 0) && (stat != EGADS_EMPTY))
-      printf(" EGADS Warning: Del Attributes = %d (EG_destroyObject)!\n",
-             stat);
-
-  stat = EGADS_SUCCESS;
-  if (object->oclass == TRANSFORM) {
-  
-    EG_free(object->blind);
-
-  } else if (object->oclass == TESSELLATION) {
-
-    tess = (egTessel *) object->blind;
-    if (tess != NULL) {
-      if (object->topObj == context) {
-        EG_dereferenceTopObj(tess->src, object);
-      } else {
-        EG_derefObj(tess->src, object, 0);
-      }
-      if (tess->xyzs != NULL) EG_free(tess->xyzs);
-      if (tess->tess1d != NULL) {
-        for (i = 0; i < tess->nEdge; i++) {
-          if (tess->tess1d[i].faces[0].faces != NULL)
-            EG_free(tess->tess1d[i].faces[0].faces);
-          if (tess->tess1d[i].faces[1].faces != NULL)
-            EG_free(tess->tess1d[i].faces[1].faces);
-          if (tess->tess1d[i].faces[0].tric  != NULL)
-            EG_free(tess->tess1d[i].faces[0].tric);
-          if (tess->tess1d[i].faces[1].tric  != NULL)
-            EG_free(tess->tess1d[i].faces[1].tric);
-          if (tess->tess1d[i].xyz    != NULL)
-            EG_free(tess->tess1d[i].xyz);
-          if (tess->tess1d[i].t      != NULL)
-            EG_free(tess->tess1d[i].t);
-          if (tess->tess1d[i].global != NULL)
-            EG_free(tess->tess1d[i].global);
-        }
-        EG_free(tess->tess1d);
-      }
-      if (tess->tess2d != NULL) {
-        for (i = 0; i < 2*tess->nFace; i++) {
-          if (tess->tess2d[i].mKnots != NULL) 
-            EG_deleteObject(tess->tess2d[i].mKnots);
-          if (tess->tess2d[i].xyz    != NULL) 
-            EG_free(tess->tess2d[i].xyz);
-          if (tess->tess2d[i].uv     != NULL) 
-            EG_free(tess->tess2d[i].uv);
-          if (tess->tess2d[i].global != NULL)
-            EG_free(tess->tess2d[i].global);
-          if (tess->tess2d[i].ptype  != NULL) 
-            EG_free(tess->tess2d[i].ptype);
-          if (tess->tess2d[i].pindex != NULL) 
-            EG_free(tess->tess2d[i].pindex);
-          if (tess->tess2d[i].bary   != NULL)
-            EG_free(tess->tess2d[i].bary);
-          if (tess->tess2d[i].frame != NULL)
-            EG_free(tess->tess2d[i].frame);
-          if (tess->tess2d[i].frlps != NULL)
-            EG_free(tess->tess2d[i].frlps);
-          if (tess->tess2d[i].tris   != NULL) 
-            EG_free(tess->tess2d[i].tris);
-          if (tess->tess2d[i].tric   != NULL) 
-            EG_free(tess->tess2d[i].tric);
-          if (tess->tess2d[i].patch  != NULL) {
-            for (j = 0; j < tess->tess2d[i].npatch; j++) {
-              if (tess->tess2d[i].patch[j].ipts != NULL) 
-                EG_free(tess->tess2d[i].patch[j].ipts);
-              if (tess->tess2d[i].patch[j].bounds != NULL) 
-                EG_free(tess->tess2d[i].patch[j].bounds);
-            }
-            EG_free(tess->tess2d[i].patch);
-          }
-        }
-        EG_free(tess->tess2d);
-      }
-      if (tess->globals != NULL) EG_free(tess->globals);
-      EG_free(tess);
-    }
-
-  } else if (object->oclass <= SURFACE) {
-  
-    if ((object->oclass != NIL) && (flg == 0))
-      stat = EG_destroyGeometry(object);
-    
-  } else if (object->oclass == EBODY) {
-  
-    stat = EGADS_SUCCESS;
-    EG_destroyEBody(object, 0);
-  
-  } else {
-  
-    if (flg == 0) stat = EG_destroyTopology(object);
-
-  }
+  stat = EG_freeBlind(context, object, flg);
   object->mtype  = object->oclass;
   object->oclass = EMPTY;
   object->blind  = NULL;
@@ -1530,12 +1601,27 @@ EG_flipObject(const egObject *object, egObject **copy)
 }
 
 
+/* fast close -- release the object's contents and mark it empty */
+static void
+EG_freeObj(egObject *context, egObject *obj)
+{
+  EG_freeBlind(context, obj, 0);
+  obj->mtype  = obj->oclass;
+  obj->oclass = EMPTY;
+  obj->blind  = NULL;
+}
+
+
 int
 EG_close(egObject *context)
 {
-  int      outLevel, cnt, ref, total, stat;
-  egObject *obj, *next, *last;
+  int      i, outLevel, cnt, ref, total, stat, rank[EBODY+1], start[NFCLASS+1];
+  egObject *obj, *next, *last, **objs;
   egCntxt  *cntx;
+  egSlab   *slab, *nslab;
+  static int fclass[NFCLASS] = {MODEL, TESSELLATION, EBODY, ESHELL, EFACE,
+                                ELOOPX, EEDGE, BODY, SHELL, FACE, LOOP, EDGE,
+                                NODE, SURFACE, CURVE, PCURVE, TRANSFORM, NIL};
 
   if (context == NULL)               return EGADS_NULLOBJ;
   if (context->magicnumber != MAGIC) return EGADS_NOTOBJ;
@@ -1576,6 +1662,34 @@ EG_close(egObject *context)
     printf(" EGADS Info: %d Objects, %d Reference in Use (of %d) at Close!\n",
            cnt, ref, total);
 
+  if (cntx->fastClose == 1) {
+
+    /* fast close -- release what each object owns from the top down (so
+       containers are gone before their children) and then drop the object
+       structures with their slabs, no reference bookkeeping is done; each
+       object's contents are still freed one at a time */
+    objs = (egObject **) EG_alloc((cnt+1)*sizeof(egObject *));
+    if (objs != NULL) {
+      if (cntx->mutex != NULL) EMP_LockSet(cntx->mutex);
+      cntx->fastClose = 2;
+      for (i = 0; i <= EBODY; i++) rank[i] = -1;
+      for (i = 0; i < NFCLASS; i++) rank[fclass[i]] = i;
+      /* bucket the objects by class */
+      for (i = 0; i <= NFCLASS; i++) start[i] = 0;
+      for (obj = context->next; obj != NULL; obj = obj->next)
+        if (rank[obj->oclass] >= 0) start[rank[obj->oclass]+1]++;
+      for (i = 0; i < NFCLASS; i++) start[i+1] += start[i];
+      for (obj = context->next; obj != NULL; obj = obj->next)
+        if (rank[obj->oclass] >= 0) objs[start[rank[obj->oclass]]++] = obj;
+      for (i = 0; i < start[NFCLASS-1]; i++) EG_freeObj(context, objs[i]);
+      EG_free(objs);
+      goto cleanup;
+    }
+    /* no room to sort -- do the normal close */
+    if (outLevel > 0)
+      printf(" EGADS Info: Malloc on Objects -- normal close (EG_close)!\n");
+  }
+
   /* delete unattached geometry and topology objects */
   
   EG_deleteObject(context);
@@ -1727,6 +1841,7 @@ EG_close(egObject *context)
     if ((cnt != 0) && (ref != 0))
       printf("             In Addition to %d Refereces\n", ref);  
 
+cleanup:
   /* clean up the pool */
   
   obj = cntx->pool;
@@ -1736,11 +1851,16 @@ EG_close(egObject *context)
       printf("             Class = %d\n", obj->oclass);
       break;
     }
-    next = obj->next;
-    EG_free(obj);
-    obj = next;
+    obj = obj->next;
+  }
+  slab = (egSlab *) cntx->slabs;
+  while (slab != NULL) {
+    nslab = slab->next;
+    EG_free(slab);
+    slab  = nslab;
   }
   EG_attributeDel(context, NULL);
+  EG_attrNamesFree(cntx->names);
   EG_free(context);
   if (cntx->mutex != NULL) EMP_LockRelease(cntx->mutex);
   if (cntx->mutex != NULL) EMP_LockDestroy(cntx->mutex);
@@ -14,6 +14,14 @@
 #include "egadsOCC.h"
 #include "Surreal/SurrealS.h"
 
+class egadsArcTab
+{
+public:
+  int    npanel;                        // number of Gauss panels
+  double *tab;                          // (t, cumulative length) at panel ends
+};
+
+
 class egadsPCurve
 {
 public:
@@ -25,6 +33,7 @@ public:
   double               *data;
   SurrealS<1>          *data_dot;
   double               trange[2];
+  egadsArcTab          *arcTab;         // arc-length table (filled on demand)
 };
 
 
@@ -39,6 +48,7 @@ public:
   double             *data;
   SurrealS<1>        *data_dot;
   double             trange[2];
+  egadsArcTab        *arcTab;           // arc-length table (filled on demand)
 };
 
 
@@ -87,6 +97,7 @@ public:
   egadsBox    bbox;
   int         filled;
   SurrealS<1> trange_dot[2];
+  egadsArcTab *arcTab;                  // arc-length table (filled on demand)
 };
 
 
@@ -116,6 +127,8 @@ public:
   double      urange[2];
   double      vrange[2];
   egadsBox    bbox;
+  int         massFill;                 // 1 - surface, 2 - volume filled
+  double      massProp[20];             // surface then volume moments
 };
 
 
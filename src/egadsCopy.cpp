@@ -220,6 +220,7 @@ EG_copyAttrTopo(egadsBody *pbody, /*@null@*/ double *xform, gp_Trsf form,
           BRep_Tool::Range(Edge, pedge->trange[0], pedge->trange[1]);
           pedge->filled      = 0;
           pedge->trange_dot[0] = pedge->trange_dot[1] = 0;
+          pedge->arcTab      = NULL;
           edgeo[k]->blind    = pedge;
           EG_copyAttrTopo(pbody, xform, form, sloop->edges[k], edgeo[k], topObj);
           if (index > 0) pbody->edges.objs[index-1] = edgeo[k];
@@ -339,6 +340,7 @@ EG_copyAttrTopo(egadsBody *pbody, /*@null@*/ double *xform, gp_Trsf form,
           egadsFace *pface   = new egadsFace;
           pface->face        = Face;
           pface->bbox.filled = 0;
+          pface->massFill    = 0;
           BRepTools::UVBounds(Face, pface->urange[0], pface->urange[1],
                                     pface->vrange[0], pface->vrange[1]);
           faceo[k]->blind    = pface;
@@ -463,6 +465,7 @@ EG_copyTopology(/*@null@*/ egObject *context, const egObject *topo,
     BRep_Tool::Range(Edge, pedge->trange[0], pedge->trange[1]);
     pedge->filled      = 0;
     pedge->trange_dot[0] = pedge->trange_dot[1] = 0;
+    pedge->arcTab      = NULL;
     obj->blind         = pedge;
     EG_copyAttrTopo(&ebody, xform, form, topo, obj, obj);
     
@@ -509,6 +512,7 @@ EG_copyTopology(/*@null@*/ egObject *context, const egObject *topo,
     TopoDS_Face Face   = TopoDS::Face(nTopo);
     pface->face        = Face;
     pface->bbox.filled = 0;
+    pface->massFill    = 0;
     BRepTools::UVBounds(Face, pface->urange[0], pface->urange[1],
                               pface->vrange[0], pface->vrange[1]);
     obj->blind         = pface;
@@ -613,6 +617,11 @@ EG_copyTopology(/*@null@*/ egObject *context, const egObject *topo,
           for (j = 0; j < 6; j++)
             pface->bbox.box[j] = pfacs->bbox.box[j];
         }
+        if (pfacs->massFill != 0) {
+          pface->massFill = pfacs->massFill;
+          for (j = 0; j < 20; j++)
+            pface->massProp[j] = pfacs->massProp[j];
+        }
       }
       for (i = 0; i < pbody->shells.map.Extent(); i++) {
         if (pbody->shells.objs[i] == NULL) continue;
@@ -969,6 +978,7 @@ EG_flipAttrTopo(egadsBody *pbody, egadsBody *tbody, const egObject *src,
           BRep_Tool::Range(Edge, pedge->trange[0], pedge->trange[1]);
           pedge->filled      = 0;
           pedge->trange_dot[0] = pedge->trange_dot[1] = 0;
+          pedge->arcTab      = NULL;
           edgeo[k]->blind    = pedge;
           edgeo[k]->oclass   = EDGE;
           EG_flipAttrTopo(pbody, tbody, src, edgeo[k], topObj);
@@ -1112,6 +1122,7 @@ EG_flipAttrTopo(egadsBody *pbody, egadsBody *tbody, const egObject *src,
           egadsFace *pface   = new egadsFace;
           pface->face        = Face;
           pface->bbox.filled = 0;
+          pface->massFill    = 0;
           BRepTools::UVBounds(Face, pface->urange[0], pface->urange[1],
                                     pface->vrange[0], pface->vrange[1]);
           faceo[k]->blind    = pface;
@@ -1253,6 +1264,7 @@ EG_flipTopology(const egObject *topo, egObject **copy)
     TopoDS_Face Face   = TopoDS::Face(nTopo);
     pface->face        = Face;
     pface->bbox.filled = 0;
+    pface->massFill    = 0;
     BRepTools::UVBounds(Face, pface->urange[0], pface->urange[1],
                               pface->vrange[0], pface->vrange[1]);
     obj->blind         = pface;
@@ -3189,6 +3189,8 @@ EG_coarseTris(int neloop, egELoop **eloops, void *uvmap)
   fast.pts   = NULL;
   fast.segs  = NULL;
   fast.front = NULL;
+  fast.grid  = NULL;
+  fast.link  = NULL;
   frame      = (int *) EG_alloc(3*ntri*sizeof(int));
   if (frame == NULL) {
     printf(" EGADS Error: Allocating %d frame (EG_coarseTris)!\n", ntri);
@@ -3200,6 +3202,8 @@ EG_coarseTris(int neloop, egELoop **eloops, void *uvmap)
   if (fast.segs  != NULL) EG_free(fast.segs);
   if (fast.pts   != NULL) EG_free(fast.pts);
   if (fast.front != NULL) EG_free(fast.front);
+  if (fast.grid  != NULL) EG_free(fast.grid);
+  if (fast.link  != NULL) EG_free(fast.link);
   EG_free(frame);
   EG_free(uvs);
   EG_free(nc);
@@ -15,6 +15,7 @@
 #include "egadsTypes.h"
 #include "egadsInternals.h"
 #include "egadsClasses.h"
+#include "emp.h"
 #define TEMPLATE template<class TT>
 #define DOUBLE TT
 #define CROSS(a,b,c)       (a)[0] = ((b)[1]*(c)[2]) - ((b)[2]*(c)[1]);\
@@ -25,6 +26,13 @@
 
 #define PARAMACC 1.0e-4         // parameter accuracy
 #define KNACC    1.0e-12	// knot accuracy
+#define ARCTOL   1.0e-12        // relative arc-length accuracy
+#define ARCEXT   1.0e-8         // relative extrapolation of arc-length tables
+#define ARCINF   1.0e20         // largest tabulated parameter
+#define ARCSEED  8              // initial panels for non-BSplines
+#define ARCDEPTH 24             // maximum panel bisections
+#define ARCMAXP  16384          // maximum panels in a table
+#define ARCITER  50             // maximum inverse iterations
 
 #ifdef WIN32
 #define DllExport   __declspec( dllexport )
@@ -45,6 +53,9 @@
   extern "C" int  EG_flipGeometry( const egObject *geom, egObject **copy );
   extern "C" int  EG_spline1d( egObject *context, int endc, int imax,
                                const double *xyz, double tol, egObject **ecrv );
+  extern "C" int  EG_spline1dBatch( egObject *context, int endc, int ncrv,
+                                    const int *imaxs, const double **xyzs,
+                                    double tol, egObject **ecrvs );
   extern "C" int  EG_spline2d( egObject *context, int endc,
                                /*@null@*/ const double **dr, int imax, int jmax,
                                const double *xyz, double tol, egObject **esrf );
@@ -151,9 +162,25 @@
                               double *alen );
   extern "C" int  EG_arcLength( const egObject *geom, double t1, double t2,
                                 double *alen );
+  extern "C" int  EG_arcLengthBatch( const egObject *geom, double t1, int n,
+                                     const double *ts, double *alens );
+  extern "C" int  EG_invArcLength( const egObject *geom, double t1, double alen,
+                                   double *t );
+  extern "C" int  EG_invArcLengthBatch( const egObject *geom, double t1, int n,
+                                        const double *alens, double *ts );
+  extern "C" int  EG_arcLength_dot( const egObject *geom, double t1,
+                                    double t1_dot, double t2, double t2_dot,
+                                    double *alen, double *alen_dot );
+  extern "C" int  EG_invArcLength_dot( const egObject *geom, double t1,
+                                       double t1_dot, double alen,
+                                       double alen_dot, double *t,
+                                       double *t_dot );
   extern "C" int  EG_approximate( egObject *context, int maxdeg, double tol,
                                   const int *sizes, const double *xyzs,
                                   egObject **bspline );
+  extern "C" int  EG_approximateBatch( egObject *context, int maxdeg, double tol,
+                                       int nfit, const int *sizes,
+                                       const double **xyzs, egObject **bsplines );
   extern "C" int  EG_approximate_dot( egObject *bspline, int maxdeg, double tol,
                                       const int *sizes,
                                       const double *data, const double *data_dot );
@@ -204,6 +231,10 @@ EG_addStrAttr(egObject *obj, const char *name, const char *str)
     printf(" EGADS Internal: BAD Name (EG_addStrAttr)!\n");
     return EGADS_INDEXERR;
   }
+  if (EG_attrUnshare(obj) != EGADS_SUCCESS) {
+    printf(" EGADS Internal: Unshare MALLOC for %s (EG_addStrAttr)!\n", name);
+    return EGADS_MALLOC;
+  }
   attrs = (egAttrs *) obj->attrs;
 
   if (attrs != NULL)
@@ -242,6 +273,7 @@ EG_addStrAttr(egObject *obj, const char *name, const char *str)
       attrs->attrs  = NULL;
       attrs->nseqs  = 0;
       attrs->seqs   = NULL;
+      attrs->nref   = 1;
       obj->attrs    = attrs;
     }
     if (attrs->attrs == NULL) {
@@ -258,7 +290,7 @@ EG_addStrAttr(egObject *obj, const char *name, const char *str)
     attrs->attrs = attr;
     find = attrs->nattrs;
     attrs->attrs[find].vals.string = NULL;
-    attrs->attrs[find].name        = EG_strdup(name);
+    attrs->attrs[find].name        = EG_attrName(obj, name);
     if (attrs->attrs[find].name == NULL) return EGADS_MALLOC;
     attrs->nattrs += 1;
   }
@@ -285,6 +317,10 @@ EG_destroyGeometry(egObject *geom)
       if (ppcurv->header   != NULL) EG_free(ppcurv->header);
       if (ppcurv->data     != NULL) EG_free(ppcurv->data);
       if (ppcurv->data_dot != NULL) EG_free(ppcurv->data_dot);
+      if (ppcurv->arcTab   != NULL) {
+        EG_free(ppcurv->arcTab->tab);
+        delete ppcurv->arcTab;
+      }
       obj = ppcurv->ref;
     }
     if (obj    != NULL)
@@ -302,6 +338,10 @@ EG_destroyGeometry(egObject *geom)
       if (pcurve->header   != NULL) EG_free(pcurve->header);
       if (pcurve->data     != NULL) EG_free(pcurve->data);
       if (pcurve->data_dot != NULL) EG_free(pcurve->data_dot);
+      if (pcurve->arcTab   != NULL) {
+        EG_free(pcurve->arcTab->tab);
+        delete pcurve->arcTab;
+      }
       obj = pcurve->ref;
     }
     if (obj    != NULL)
@@ -4001,6 +4041,7 @@ EG_completePCurve(egObject *geom, Handle(Geom2d_Curve) &hCurve)
   ppcurv->header      = NULL;
   ppcurv->data        = NULL;
   ppcurv->data_dot    = NULL;
+  ppcurv->arcTab      = NULL;
   geom->blind         = ppcurv;
 
   // stand alone geometry
@@ -4148,6 +4189,7 @@ EG_completeCurve(egObject *geom, Handle(Geom_Curve) &hCurve)
   pcurve->header     = NULL;
   pcurve->data       = NULL;
   pcurve->data_dot   = NULL;
+  pcurve->arcTab     = NULL;
   geom->blind        = pcurve;
 
   // stand alone geometry
@@ -5017,6 +5059,7 @@ EG_makeGeometry(egObject *context, int oclass, int mtype,
     ppcurv->header      = NULL;
     ppcurv->data        = NULL;
     ppcurv->data_dot    = NULL;
+    ppcurv->arcTab      = NULL;
     obj->blind          = ppcurv;
     EG_getGeometry(obj, &i, &j, &ref, &ppcurv->header, &ppcurv->data);
     EG_getGeometryLen(obj, &i, &ppcurv->dataLen);
@@ -5239,6 +5282,7 @@ EG_makeGeometry(egObject *context, int oclass, int mtype,
     pcurve->header     = NULL;
     pcurve->data       = NULL;
     pcurve->data_dot   = NULL;
+    pcurve->arcTab     = NULL;
     obj->blind         = pcurve;
     EG_getGeometry(obj, &i, &j, &ref, &pcurve->header, &pcurve->data);
     EG_getGeometryLen(obj, &i, &pcurve->dataLen);
@@ -7354,9 +7398,352 @@ EG_arcLenX(const egObject *geom, double t1, double t2, double *alen)
   return EGADS_SUCCESS;
 }
 
+
+/* cached arc-length tables
+ *    panels are adapted until 8-point Gauss-Legendre on the halves agrees
+ *    with the whole, so any sub-panel integral is at quadrature accuracy
+ */
+
+static double arcGx[4] = { 0.1834346424956498, 0.5255324099163290,
+                           0.7966664774136267, 0.9602898564975363 };
+static double arcGw[4] = { 0.3626837833783620, 0.3137066458778873,
+                           0.2223810344533745, 0.1012285362903763 };
+
+
+static double
+EG_arcSpeed(const egObject *curv, double t)
+{
+  if (curv->oclass == PCURVE) {
+    gp_Pnt2d P2d;
+    gp_Vec2d V2d;
+    egadsPCurve *ppcurv = (egadsPCurve *) curv->blind;
+    ppcurv->handle->D1(t, P2d, V2d);
+    return V2d.Magnitude();
+  }
+
+  gp_Pnt P;
+  gp_Vec V;
+  egadsCurve *pcurve = (egadsCurve *) curv->blind;
+  pcurve->handle->D1(t, P, V);
+  return V.Magnitude();
+}
+
+
+static double
+EG_arcGauss(const egObject *curv, double ta, double tb)
+{
+  int    i;
+  double tm, tr, sum = 0.0;
+
+  tm = 0.5*(ta + tb);
+  tr = 0.5*(tb - ta);
+  if (tr == 0.0) return 0.0;
+  for (i = 0; i < 4; i++)
+    sum += arcGw[i]*(EG_arcSpeed(curv, tm - tr*arcGx[i]) +
+                     EG_arcSpeed(curv, tm + tr*arcGx[i]));
+
+  return sum*tr;
+}
+
+
+static int
+EG_arcPanel(const egObject *curv, double ta, double tb, double whole,
+            int depth, int *npanel, int *mpanel, double **tab)
+{
+  int    stat, n;
+  double tm, left, right, *tmp;
+
+  tm    = 0.5*(ta + tb);
+  left  = EG_arcGauss(curv, ta, tm);
+  right = EG_arcGauss(curv, tm, tb);
+  if ((depth < ARCDEPTH) && (*npanel < ARCMAXP) &&
+      (fabs(left + right - whole) > ARCTOL*fabs(left + right))) {
+    stat = EG_arcPanel(curv, ta, tm, left,  depth+1, npanel, mpanel, tab);
+    if (stat != EGADS_SUCCESS) return stat;
+    return EG_arcPanel(curv, tm, tb, right, depth+1, npanel, mpanel, tab);
+  }
+
+  n = *npanel;
+  if (n+2 > *mpanel) {
+    tmp = (double *) EG_reall(*tab, 2*(*mpanel+257)*sizeof(double));
+    if (tmp == NULL) return EGADS_MALLOC;
+    *tab     = tmp;
+    *mpanel += 256;
+  }
+  tmp          = *tab;
+  tmp[2*n+2]   = tm;
+  tmp[2*n+3]   = tmp[2*n+1] + left;
+  tmp[2*n+4]   = tb;
+  tmp[2*n+5]   = tmp[2*n+3] + right;
+  *npanel      = n+2;
+
+  return EGADS_SUCCESS;
+}
+
+
+static int
+EG_arcBuild(const egObject *curv, double t0, double t1, egadsArcTab **table)
+{
+  int    i, stat, nseed, npanel, mpanel;
+  double *seed, *tab;
+
+  *table = NULL;
+  nseed  = ARCSEED;
+  seed   = NULL;
+  if (curv->mtype == BSPLINE) {
+    // start from the knots within the range so no panel straddles one
+    int nknot = 0;
+    Handle(Geom2d_BSplineCurve) h2d;
+    Handle(Geom_BSplineCurve)   h3d;
+    if (curv->oclass == PCURVE) {
+      egadsPCurve *ppcurv = (egadsPCurve *) curv->blind;
+      h2d = Handle(Geom2d_BSplineCurve)::DownCast(ppcurv->handle);
+      if (!h2d.IsNull())
+        if (!h2d->IsPeriodic()) nknot = h2d->NbKnots();
+    } else {
+      egadsCurve *pcurve = (egadsCurve *) curv->blind;
+      h3d = Handle(Geom_BSplineCurve)::DownCast(pcurve->handle);
+      if (!h3d.IsNull())
+        if (!h3d->IsPeriodic()) nknot = h3d->NbKnots();
+    }
+    if (nknot > 1) {
+      seed = (double *) EG_alloc((nknot+2)*sizeof(double));
+      if (seed == NULL) return EGADS_MALLOC;
+      nseed   = 0;
+      seed[0] = t0;
+      for (i = 1; i <= nknot; i++) {
+        double knot = h2d.IsNull() ? h3d->Knot(i) : h2d->Knot(i);
+        if (knot <= seed[nseed]+KNACC) continue;
+        if (knot >= t1-KNACC) break;
+        nseed++;
+        seed[nseed] = knot;
+      }
+      nseed++;
+      seed[nseed] = t1;
+    }
+  }
+
+  mpanel = 2*ARCSEED;
+  if (mpanel < 2*nseed) mpanel = 2*nseed;
+  tab    = (double *) EG_alloc(2*(mpanel+1)*sizeof(double));
+  if (tab == NULL) {
+    if (seed != NULL) EG_free(seed);
+    return EGADS_MALLOC;
+  }
+  tab[0] = t0;
+  tab[1] = 0.0;
+  npanel = 0;
+  for (stat = EGADS_SUCCESS, i = 0; i < nseed; i++) {
+    double ta = t0 + (t1 - t0)*i/nseed;
+    double tb = t0 + (t1 - t0)*(i+1)/nseed;
+    if (seed != NULL) {
+      ta = seed[i];
+      tb = seed[i+1];
+    }
+    stat = EG_arcPanel(curv, ta, tb, EG_arcGauss(curv, ta, tb), 0,
+                       &npanel, &mpanel, &tab);
+    if (stat != EGADS_SUCCESS) break;
+  }
+  if (seed != NULL) EG_free(seed);
+  if (stat != EGADS_SUCCESS) {
+    EG_free(tab);
+    return stat;
+  }
+
+  *table = new egadsArcTab;
+  (*table)->npanel = npanel;
+  (*table)->tab    = tab;
+  return EGADS_SUCCESS;
+}
+
+
+/* the table is built outside of the Context's lock -- published under it */
+static int
+EG_arcTable(const egObject *geom, const egObject **curv, egadsArcTab **table)
+{
+  int         stat;
+  double      *trange;
+  void        *mutex = NULL;
+  egObject    *context;
+  egCntxt     *cntx;
+  egadsArcTab **slot, *tab;
+
+  *curv  = NULL;
+  *table = NULL;
+  if (geom->oclass == PCURVE) {
+    egadsPCurve *ppcurv = (egadsPCurve *) geom->blind;
+    if (ppcurv == NULL) return EGADS_NULLOBJ;
+    *curv  = geom;
+    trange = ppcurv->trange;
+    slot   = &ppcurv->arcTab;
+  } else if (geom->oclass == CURVE) {
+    egadsCurve *pcurve = (egadsCurve *) geom->blind;
+    if (pcurve == NULL) return EGADS_NULLOBJ;
+    *curv  = geom;
+    trange = pcurve->trange;
+    slot   = &pcurve->arcTab;
+  } else {
+    if (geom->mtype == DEGENERATE) return EGADS_DEGEN;
+    egadsEdge *pedge = (egadsEdge *) geom->blind;
+    if (pedge == NULL) return EGADS_NULLOBJ;
+    if (pedge->curve        == NULL) return EGADS_NULLOBJ;
+    if (pedge->curve->blind == NULL) return EGADS_NODATA;
+    *curv  = pedge->curve;
+    trange = pedge->trange;
+    slot   = &pedge->arcTab;
+  }
+  // unbounded curves (Lines, Parabolas, ...) are not tabulated
+  if ((fabs(trange[0]) > ARCINF) || (fabs(trange[1]) > ARCINF) ||
+      (trange[1] <= trange[0])) return EGADS_RANGERR;
+
+  context = EG_context(geom);
+  if (context != NULL) {
+    cntx = (egCntxt *) context->blind;
+    if (cntx != NULL) mutex = cntx->mutex;
+  }
+
+  if (mutex != NULL) EMP_LockSet(mutex);
+  *table = *slot;
+  if (mutex != NULL) EMP_LockRelease(mutex);
+  if (*table != NULL) return EGADS_SUCCESS;
+
+  stat = EG_arcBuild(*curv, trange[0], trange[1], &tab);
+  if (stat != EGADS_SUCCESS) return stat;
+  if (mutex != NULL) EMP_LockSet(mutex);
+  if (*slot == NULL) *slot = tab;
+  *table = *slot;
+  if (mutex != NULL) EMP_LockRelease(mutex);
+  if (*table != tab) {
+    /* another thread got there first */
+    EG_free(tab->tab);
+    delete tab;
+  }
+
+  return EGADS_SUCCESS;
+}
+
+
+static int
+EG_arcInside(const egadsArcTab *table, double t)
+{
+  double t0, t1, tol;
+
+  t0  = table->tab[0];
+  t1  = table->tab[2*table->npanel];
+  tol = ARCEXT*(t1 - t0);
+  if ((t < t0-tol) || (t > t1+tol)) return 0;
+  return 1;
+}
+
+
+static int
+EG_arcFind(const egadsArcTab *table, double t)
+{
+  int    i0, i1, im;
+  double *tab = table->tab;
+
+  i0 = 0;
+  i1 = table->npanel;
+  while (i1-i0 > 1) {
+    im = (i0+i1)/2;
+    if (t < tab[2*im]) {
+      i1 = im;
+    } else {
+      i0 = im;
+    }
+  }
+  return i0;
+}
+
+
+static double
+EG_arcEval(const egObject *curv, const egadsArcTab *table, double t)
+{
+  int    i;
+  double *tab = table->tab;
+
+  i = EG_arcFind(table, t);
+  // integrate from the nearer end of the panel
+  if (t-tab[2*i] <= tab[2*i+2]-t)
+    return tab[2*i+1] + EG_arcGauss(curv, tab[2*i], t);
+  return tab[2*i+3] - EG_arcGauss(curv, t, tab[2*i+2]);
+}
+
+
+static int
+EG_arcInvert(const egObject *curv, const egadsArcTab *table, double s,
+             double *t)
+{
+  int    i, i0, i1, im, n;
+  double ta, tb, tt, tn, lo, hi, f, ds, *tab = table->tab;
+
+  n = table->npanel;
+  ds = ARCTOL*tab[2*n+1];
+  if ((s < -ARCEXT*tab[2*n+1]) || (s > (1.0+ARCEXT)*tab[2*n+1]))
+    return EGADS_RANGERR;
+  if (s <= 0.0) {
+    *t = tab[0];
+    return EGADS_SUCCESS;
+  }
+  if (s >= tab[2*n+1]) {
+    *t = tab[2*n];
+    return EGADS_SUCCESS;
+  }
+
+  // find the panel containing s
+  i0 = 0;
+  i1 = n;
+  while (i1-i0 > 1) {
+    im = (i0+i1)/2;
+    if (s < tab[2*im+1]) {
+      i1 = im;
+    } else {
+      i0 = im;
+    }
+  }
+  ta = lo = tab[2*i0];
+  tb = hi = tab[2*i0+2];
+  if (tab[2*i0+3] <= tab[2*i0+1]) {
+    *t = ta;
+    return EGADS_SUCCESS;
+  }
+
+  // safeguarded Newton within the panel
+  tt = ta + (s - tab[2*i0+1])*(tb - ta)/(tab[2*i0+3] - tab[2*i0+1]);
+  for (i = 0; i < ARCITER; i++) {
+    f = tab[2*i0+1] + EG_arcGauss(curv, ta, tt) - s;
+    if (fabs(f) <= ds) break;
+    if (f > 0.0) {
+      hi = tt;
+    } else {
+      lo = tt;
+    }
+    tn = EG_arcSpeed(curv, tt);
+    if (tn > 0.0) {
+      tn = tt - f/tn;
+    } else {
+      tn = lo;
+    }
+    if ((tn <= lo) || (tn >= hi)) tn = 0.5*(lo + hi);
+    if (fabs(tn-tt) <= KNACC*(tb-ta)) {
+      tt = tn;
+      break;
+    }
+    tt = tn;
+  }
+
+  *t = tt;
+  return EGADS_SUCCESS;
+}
+
+
 int
 EG_arcLength(const egObject *geom, double t1, double t2, double *alen)
 {
+  int            stat;
+  const egObject *curv;
+  egadsArcTab    *table;
+
   *alen = 0.0;
   if  (geom == NULL)               return EGADS_NULLOBJ;
   if  (geom->magicnumber != MAGIC) return EGADS_NOTOBJ;
@@ -7364,10 +7751,294 @@ EG_arcLength(const egObject *geom, double t1, double t2, double *alen)
   if  (geom->oclass == EEDGE)      return EG_arcELength(geom, t1, t2, alen);
   if ((geom->oclass != PCURVE) && (geom->oclass != CURVE) &&
       (geom->oclass != EDGE))      return EGADS_NOTGEOM;
+
+  stat = EG_arcTable(geom, &curv, &table);
+  if ((stat == EGADS_SUCCESS) && (EG_arcInside(table, t1) == 1) &&
+                                 (EG_arcInside(table, t2) == 1)) {
+    *alen = fabs(EG_arcEval(curv, table, t2) - EG_arcEval(curv, table, t1));
+    return EGADS_SUCCESS;
+  }
   return EG_arcLenX(geom, t1, t2, alen);
 }
 
 
+int
+EG_arcLengthBatch(const egObject *geom, double t1, int n, const double *ts,
+                  double *alens)
+{
+  int            i, stat;
+  double         s1;
+  const egObject *curv;
+  egadsArcTab    *table;
+
+  if  (geom == NULL)               return EGADS_NULLOBJ;
+  if  (geom->magicnumber != MAGIC) return EGADS_NOTOBJ;
+  if  (geom->blind == NULL)        return EGADS_NODATA;
+  if  (n <= 0)                     return EGADS_RANGERR;
+  if ((geom->oclass != PCURVE) && (geom->oclass != CURVE) &&
+      (geom->oclass != EDGE) && (geom->oclass != EEDGE))
+                                   return EGADS_NOTGEOM;
+
+  stat = EGADS_NOTGEOM;
+  if (geom->oclass != EEDGE) stat = EG_arcTable(geom, &curv, &table);
+  if ((stat != EGADS_SUCCESS) || (EG_arcInside(table, t1) == 0)) {
+    for (i = 0; i < n; i++) {
+      stat = EG_arcLength(geom, t1, ts[i], &alens[i]);
+      if (stat != EGADS_SUCCESS) return stat;
+    }
+    return EGADS_SUCCESS;
+  }
+
+  s1 = EG_arcEval(curv, table, t1);
+  for (i = 0; i < n; i++)
+    if (EG_arcInside(table, ts[i]) == 1) {
+      alens[i] = fabs(EG_arcEval(curv, table, ts[i]) - s1);
+    } else {
+      stat = EG_arcLenX(geom, t1, ts[i], &alens[i]);
+      if (stat != EGADS_SUCCESS) return stat;
+    }
+
+  return EGADS_SUCCESS;
+}
+
+
+static int
+EG_invArcLenX(const egObject *geom, double t1, double alen, double *t)
+{
+  if (geom->oclass == PCURVE) {
+
+    egadsPCurve *ppcurv = (egadsPCurve *) geom->blind;
+    Geom2dAdaptor_Curve AC(ppcurv->handle);
+    GCPnts_AbscissaPoint AP(AC, alen, t1);
+    if (!AP.IsDone()) return EGADS_GEOMERR;
+    *t = AP.Parameter();
+
+  } else {
+
+    egObject *curvo = (egObject *) geom;
+    if (geom->oclass == EDGE) {
+      egadsEdge *pedge = (egadsEdge *) geom->blind;
+      curvo = pedge->curve;
+    }
+    egadsCurve *pcurve = (egadsCurve *) curvo->blind;
+    GeomAdaptor_Curve AC(pcurve->handle);
+    GCPnts_AbscissaPoint AP(AC, alen, t1);
+    if (!AP.IsDone()) return EGADS_GEOMERR;
+    *t = AP.Parameter();
+
+  }
+
+  return EGADS_SUCCESS;
+}
+
+
+int
+EG_invArcLength(const egObject *geom, double t1, double alen, double *t)
+{
+  int            stat;
+  const egObject *curv;
+  egadsArcTab    *table;
+
+  *t = t1;
+  if  (geom == NULL)               return EGADS_NULLOBJ;
+  if  (geom->magicnumber != MAGIC) return EGADS_NOTOBJ;
+  if  (geom->blind == NULL)        return EGADS_NODATA;
+  if ((geom->oclass != PCURVE) && (geom->oclass != CURVE) &&
+      (geom->oclass != EDGE))      return EGADS_NOTGEOM;
+
+  stat = EG_arcTable(geom, &curv, &table);
+  if (stat == EGADS_DEGEN)   return stat;
+  if ((stat == EGADS_SUCCESS) && (EG_arcInside(table, t1) == 1)) {
+    stat = EG_arcInvert(curv, table, EG_arcEval(curv, table, t1)+alen, t);
+    /* lengths that run past the table go to OCC */
+    if (stat != EGADS_RANGERR) return stat;
+  }
+  if (curv == NULL) return stat;
+
+  return EG_invArcLenX(geom, t1, alen, t);
+}
+
+
+int
+EG_invArcLengthBatch(const egObject *geom, double t1, int n,
+                     const double *alens, double *ts)
+{
+  int            i, stat;
+  double         s1;
+  const egObject *curv;
+  egadsArcTab    *table;
+
+  if  (geom == NULL)               return EGADS_NULLOBJ;
+  if  (geom->magicnumber != MAGIC) return EGADS_NOTOBJ;
+  if  (geom->blind == NULL)        return EGADS_NODATA;
+  if  (n <= 0)                     return EGADS_RANGERR;
+  if ((geom->oclass != PCURVE) && (geom->oclass != CURVE) &&
+      (geom->oclass != EDGE))      return EGADS_NOTGEOM;
+
+  stat = EG_arcTable(geom, &curv, &table);
+  if (stat == EGADS_DEGEN) return stat;
+  if ((stat != EGADS_SUCCESS) || (EG_arcInside(table, t1) == 0)) {
+    if (curv == NULL) return stat;
+    for (i = 0; i < n; i++) {
+      stat = EG_invArcLenX(geom, t1, alens[i], &ts[i]);
+      if (stat != EGADS_SUCCESS) return stat;
+    }
+    return EGADS_SUCCESS;
+  }
+
+  s1 = EG_arcEval(curv, table, t1);
+  for (i = 0; i < n; i++) {
+    stat = EG_arcInvert(curv, table, s1+alens[i], &ts[i]);
+    if (stat == EGADS_RANGERR)
+      stat = EG_invArcLenX(geom, t1, alens[i], &ts[i]);
+    if (stat != EGADS_SUCCESS) return stat;
+  }
+
+  return EGADS_SUCCESS;
+}
+
+
+/* sensitivities -- integrate (C'.C'_dot)/|C'| over the tabulated panels */
+
+static int
+EG_arcGauss_dot(const egObject *geom, double ta, double tb, double *s,
+                double *s_dot)
+{
+  int    i, j, k, stat, dim;
+  double t, tm, tr, d, d_dot, result[9], result_dot[9];
+
+  dim = 3;
+  if (geom->oclass == PCURVE) dim = 2;
+  tm  = 0.5*(ta + tb);
+  tr  = 0.5*(tb - ta);
+  if (tr == 0.0) return EGADS_SUCCESS;
+  for (i = 0; i < 4; i++)
+    for (j = -1; j <= 1; j += 2) {
+      t    = tm + j*tr*arcGx[i];
+      stat = EG_evaluate_dot(geom, &t, NULL, result, result_dot);
+      if (stat != EGADS_SUCCESS) return stat;
+      d = d_dot = 0.0;
+      for (k = 0; k < dim; k++) {
+        d     += result[dim+k]*result[dim+k];
+        d_dot += result[dim+k]*result_dot[dim+k];
+      }
+      d = sqrt(d);
+      if (d == 0.0) continue;
+      *s     += arcGw[i]*tr*d;
+      *s_dot += arcGw[i]*tr*d_dot/d;
+    }
+
+  return EGADS_SUCCESS;
+}
+
+
+static int
+EG_arcLenDot(const egObject *geom, double t1, double t2, double *s,
+             double *s_dot)
+{
+  int            i, i1, i2, stat, own = 0;
+  double         lo, hi, ta, tb;
+  const egObject *curv;
+  egadsArcTab    *table;
+
+  *s = *s_dot = 0.0;
+  lo = t1;
+  hi = t2;
+  if (t2 < t1) {
+    lo = t2;
+    hi = t1;
+  }
+  stat = EG_arcTable(geom, &curv, &table);
+  if (stat == EGADS_DEGEN) return stat;
+  if ((stat != EGADS_SUCCESS) || (EG_arcInside(table, lo) == 0) ||
+                                 (EG_arcInside(table, hi) == 0)) {
+    if (curv == NULL) return stat;
+    stat = EG_arcBuild(curv, lo, hi, &table);
+    if (stat != EGADS_SUCCESS) return stat;
+    own = 1;
+  }
+
+  i1 = EG_arcFind(table, lo);
+  i2 = EG_arcFind(table, hi);
+  for (i = i1; i <= i2; i++) {
+    ta = table->tab[2*i  ];
+    tb = table->tab[2*i+2];
+    if (i == i1) ta = lo;
+    if (i == i2) tb = hi;
+    stat = EG_arcGauss_dot(geom, ta, tb, s, s_dot);
+    if (stat != EGADS_SUCCESS) break;
+  }
+  if (own == 1) {
+    EG_free(table->tab);
+    delete table;
+  }
+  if (t2 < t1) {
+    *s     = -*s;
+    *s_dot = -*s_dot;
+  }
+
+  return stat;
+}
+
+
+int
+EG_arcLength_dot(const egObject *geom, double t1, double t1_dot,
+                 double t2, double t2_dot, double *alen, double *alen_dot)
+{
+  int            stat;
+  double         s, s_dot;
+  const egObject *curv;
+  egadsArcTab    *table;
+
+  *alen = *alen_dot = 0.0;
+  if  (geom == NULL)               return EGADS_NULLOBJ;
+  if  (geom->magicnumber != MAGIC) return EGADS_NOTOBJ;
+  if  (geom->blind == NULL)        return EGADS_NODATA;
+  if ((geom->oclass != PCURVE) && (geom->oclass != CURVE) &&
+      (geom->oclass != EDGE))      return EGADS_NOTGEOM;
+
+  stat = EG_arcLenDot(geom, t1, t2, &s, &s_dot);
+  if (stat != EGADS_SUCCESS) return stat;
+  /* untabulated (unbounded) curves still give the speed */
+  stat = EG_arcTable(geom, &curv, &table);
+  if ((stat != EGADS_SUCCESS) && (stat != EGADS_RANGERR)) return stat;
+  if (curv == NULL) return EGADS_NULLOBJ;
+  s_dot += EG_arcSpeed(curv, t2)*t2_dot - EG_arcSpeed(curv, t1)*t1_dot;
+
+  *alen     = fabs(s);
+  *alen_dot = (s < 0.0) ? -s_dot : s_dot;
+  return EGADS_SUCCESS;
+}
+
+
+int
+EG_invArcLength_dot(const egObject *geom, double t1, double t1_dot,
+                    double alen, double alen_dot, double *t, double *t_dot)
+{
+  int            stat;
+  double         d, s, s_dot;
+  const egObject *curv;
+  egadsArcTab    *table;
+
+  *t_dot = 0.0;
+  stat   = EG_invArcLength(geom, t1, alen, t);
+  if (stat != EGADS_SUCCESS) return stat;
+
+  // s(t) - s(t1) = alen  =>  |C'(t)| t_dot = alen_dot - s_dot + |C'(t1)| t1_dot
+  stat = EG_arcLenDot(geom, t1, *t, &s, &s_dot);
+  if (stat != EGADS_SUCCESS) return stat;
+  /* untabulated (unbounded) curves still give the speed */
+  stat = EG_arcTable(geom, &curv, &table);
+  if ((stat != EGADS_SUCCESS) && (stat != EGADS_RANGERR)) return stat;
+  if (curv == NULL) return EGADS_NULLOBJ;
+  d = EG_arcSpeed(curv, *t);
+  if (d == 0.0) return EGADS_DEGEN;
+  *t_dot = (alen_dot - s_dot + EG_arcSpeed(curv, t1)*t1_dot)/d;
+
+  return EGADS_SUCCESS;
+}
+
+
 int
 EG_approximate(egObject *context, int maxdeg, double tol, const int *sizes,
                const double *data, egObject **bspline)
@@ -7467,6 +8138,7 @@ EG_approximate(egObject *context, int maxdeg, double tol, const int *sizes,
     pcurve->header     = NULL;
     pcurve->data       = NULL;
     pcurve->data_dot   = NULL;
+    pcurve->arcTab     = NULL;
     obj->blind         = pcurve;
     EG_getGeometry(obj, &i, &j, &ref, &pcurve->header, &pcurve->data);
     EG_getGeometryLen(obj, &i, &pcurve->dataLen);
@@ -7546,6 +8218,86 @@ EG_approximate(egObject *context, int maxdeg, double tol, const int *sizes,
 }
 
 
+int
+EG_approximateBatch(egObject *context, int maxdeg, double tol, int nfit,
+                    const int *sizes, const double **data, egObject **bsplines)
+{
+  int          i, n, stat, outLevel, *imaxs;
+  const double **xyzs;
+  egObject     **curves;
+
+  if (context == NULL)               return EGADS_NULLOBJ;
+  if (context->magicnumber != MAGIC) return EGADS_NOTOBJ;
+  if (context->oclass != CONTXT)     return EGADS_NOTCNTX;
+  if (EG_sameThread(context))        return EGADS_CNTXTHRD;
+  if (nfit <= 0)                     return EGADS_RANGERR;
+  outLevel = EG_outLevel(context);
+  for (i = 0; i < nfit; i++) bsplines[i] = NULL;
+
+  /* the EGADS cubic curve fits are done concurrently */
+  n = 0;
+  if ((maxdeg >= -1) && (maxdeg < 3))
+    for (i = 0; i < nfit; i++)
+      if (((sizes[2*i+1] == -1) || (sizes[2*i+1] == 0)) && (sizes[2*i] > 2))
+        n++;
+  if (n > 1) {
+    imaxs  = (int *)           EG_alloc(n*sizeof(int));
+    xyzs   = (const double **) EG_alloc(n*sizeof(double *));
+    curves = (egObject **)     EG_alloc(n*sizeof(egObject *));
+    if ((imaxs == NULL) || (xyzs == NULL) || (curves == NULL)) {
+      if (curves != NULL) EG_free(curves);
+      if (xyzs   != NULL) EG_free(xyzs);
+      if (imaxs  != NULL) EG_free(imaxs);
+      return EGADS_MALLOC;
+    }
+    for (n = i = 0; i < nfit; i++) {
+      if (((sizes[2*i+1] != -1) && (sizes[2*i+1] != 0)) ||
+          (sizes[2*i] <= 2)) continue;
+      imaxs[n] = sizes[2*i];
+      if (sizes[2*i+1] == -1) imaxs[n] = -sizes[2*i];
+      xyzs[n]  = data[i];
+      n++;
+    }
+    stat = EG_spline1dBatch(context, maxdeg, n, imaxs, xyzs, tol, curves);
+    if (stat == EGADS_SUCCESS)
+      for (n = i = 0; i < nfit; i++) {
+        if (((sizes[2*i+1] != -1) && (sizes[2*i+1] != 0)) ||
+            (sizes[2*i] <= 2)) continue;
+        bsplines[i] = curves[n];
+        n++;
+      }
+    EG_free(curves);
+    EG_free(xyzs);
+    EG_free(imaxs);
+    if (stat != EGADS_SUCCESS) {
+      if (outLevel > 0)
+        printf(" EGADS Error: EG_spline1dBatch = %d (EG_approximateBatch)!\n",
+               stat);
+      return stat;
+    }
+  }
+
+  /* the rest in order -- large surfaces are threaded internally */
+  for (i = 0; i < nfit; i++) {
+    if (bsplines[i] != NULL) continue;
+    stat = EG_approximate(context, maxdeg, tol, &sizes[2*i], data[i],
+                          &bsplines[i]);
+    if (stat == EGADS_SUCCESS) continue;
+    if (outLevel > 0)
+      printf(" EGADS Error: EG_approximate %d = %d (EG_approximateBatch)!\n",
+             i+1, stat);
+    for (n = 0; n < nfit; n++)
+      if (bsplines[n] != NULL) {
+        EG_deleteObject(bsplines[n]);
+        bsplines[n] = NULL;
+      }
+    return stat;
+  }
+
+  return EGADS_SUCCESS;
+}
+
+
 int
 EG_approximate_dot(egObject *bspline, int maxdeg, double tol, const int *sizes,
                    const SurrealS<1> *data)
@@ -8379,6 +9131,7 @@ EG_convertToBSplineRange(egObject *object, const double *range,
       ppcrv->header      = NULL;
       ppcrv->data        = NULL;
       ppcrv->data_dot    = NULL;
+      ppcrv->arcTab      = NULL;
       obj->blind         = ppcrv;
       EG_getGeometry(obj, &i, &j, &ref, &ppcrv->header, &ppcrv->data);
       EG_getGeometryLen(obj, &i, &ppcrv->dataLen);
@@ -8462,6 +9215,7 @@ EG_convertToBSplineRange(egObject *object, const double *range,
     pcurv->header     = NULL;
     pcurv->data       = NULL;
     pcurv->data_dot   = NULL;
+    pcurv->arcTab     = NULL;
     obj->blind        = pcurv;
     EG_getGeometry(obj, &i, &j, &ref, &pcurv->header, &pcurv->data);
     EG_getGeometryLen(obj, &i, &pcurv->dataLen);
@@ -8600,6 +9354,7 @@ EG_convertToBSpline(egObject *object, egObject **bspline)
     ppcrv->header      = NULL;
     ppcrv->data        = NULL;
     ppcrv->data_dot    = NULL;
+    ppcrv->arcTab      = NULL;
     obj->blind         = ppcrv;
     EG_getGeometry(obj, &i, &j, &ref, &ppcrv->header, &ppcrv->data);
     EG_getGeometryLen(obj, &i, &ppcrv->dataLen);
@@ -8677,6 +9432,7 @@ EG_convertToBSpline(egObject *object, egObject **bspline)
     pcurv->header     = NULL;
     pcurv->data       = NULL;
     pcurv->data_dot   = NULL;
+    pcurv->arcTab     = NULL;
     obj->blind        = pcurv;
     EG_getGeometry(obj, &i, &j, &ref, &pcurv->header, &pcurv->data);
     EG_getGeometryLen(obj, &i, &pcurv->dataLen);
@@ -8815,6 +9571,7 @@ EG_flattenBSpline(egObject *object, egObject **result)
     pcurvn->header      = NULL;
     pcurvn->data        = NULL;
     pcurvn->data_dot    = NULL;
+    pcurvn->arcTab      = NULL;
     obj->blind          = pcurvn;
     EG_getGeometry(obj, &ot, &mc, &ref, &pcurvn->header, &pcurvn->data);
     EG_getGeometryLen(obj, &mc, &pcurvn->dataLen);
@@ -8862,6 +9619,7 @@ EG_flattenBSpline(egObject *object, egObject **result)
     pcurvn->header     = NULL;
     pcurvn->data       = NULL;
     pcurvn->data_dot   = NULL;
+    pcurvn->arcTab     = NULL;
     obj->blind         = pcurvn;
     EG_getGeometry(obj, &ot, &mc, &ref, &pcurvn->header, &pcurvn->data);
     EG_getGeometryLen(obj, &mc, &pcurvn->dataLen);
@@ -9009,6 +9767,7 @@ EG_addKnots(const egObject *object, int nU, /*@null@*/ double *Us,
     pcurvn->header     = NULL;
     pcurvn->data       = NULL;
     pcurvn->data_dot   = NULL;
+    pcurvn->arcTab     = NULL;
     obj->blind         = pcurvn;
     EG_getGeometry(obj, &ot, &mc, &ref, &pcurvn->header, &pcurvn->data);
     EG_getGeometryLen(obj, &mc, &pcurvn->dataLen);
@@ -9502,6 +10261,8 @@ EG_mapTessTs(egTess1D src, egTess1D dst)
 int
 EG_relPosTs(egObject *geom, int n, const double *rel, double *ts, double *xyzs)
 {
+  int        i, stat;
+  double     alen, frac, t;
   egadsCurve *pcurve;
 
   if  (geom == NULL)               return EGADS_NULLOBJ;
@@ -9513,7 +10274,6 @@ EG_relPosTs(egObject *geom, int n, const double *rel, double *ts, double *xyzs)
   if (geom->oclass == CURVE) {
 
     pcurve = (egadsCurve *) geom->blind;
-    Handle(Geom_Curve) hCurve = pcurve->handle;
 
   } else {
 
@@ -9526,37 +10286,30 @@ EG_relPosTs(egObject *geom, int n, const double *rel, double *ts, double *xyzs)
 
   }
   if (pcurve == NULL) return EGADS_NULLOBJ;
-  GeomAdaptor_Curve AC(pcurve->handle);
-  double alen = GCPnts_AbscissaPoint::Length(AC, ts[0], ts[n-1]);
+  stat = EG_arcLength(geom, ts[0], ts[n-1], &alen);
+  if (stat != EGADS_SUCCESS) return stat;
   if (alen == 0.0) {
     printf(" EGADS Error: ArcLength of Segment is Zero (EG_relPosTs)!\n");
     return EGADS_GEOMERR;
   }
-  if (rel == NULL) {
-    for (int i = 1; i < n-1; i++) {
-      GCPnts_AbscissaPoint AP(AC, i*alen/(n-1), ts[0]);
-      if (!AP.IsDone()) continue;
-      double t    = AP.Parameter();
-      gp_Pnt P0;
-      pcurve->handle->D0(t, P0);
-      ts[i]       = t;
-      xyzs[3*i  ] = P0.X();
-      xyzs[3*i+1] = P0.Y();
-      xyzs[3*i+2] = P0.Z();
-    }
-  } else {
-    for (int i = 1; i < n-1; i++) {
-      GCPnts_AbscissaPoint AP(AC, rel[i-1]*alen, ts[0]);
-      if (!AP.IsDone()) continue;
-      double t    = AP.Parameter();
-/*    printf("    %d:  %lf %lf\n", i, ts[i], t);  */
-      gp_Pnt P0;
-      pcurve->handle->D0(t, P0);
-      ts[i]       = t;
-      xyzs[3*i  ] = P0.X();
-      xyzs[3*i+1] = P0.Y();
-      xyzs[3*i+2] = P0.Z();
+  // the arc-length table makes each position a lookup and a short Newton
+  for (i = 1; i < n-1; i++) {
+    if (rel == NULL) {
+      frac  = i;
+      frac /= n-1;
+    } else {
+      frac  = rel[i-1];
     }
+    if (ts[n-1] < ts[0]) frac = -frac;
+    stat = EG_invArcLength(geom, ts[0], frac*alen, &t);
+    if (stat != EGADS_SUCCESS) continue;
+/*  printf("    %d:  %lf %lf\n", i, ts[i], t);  */
+    gp_Pnt P0;
+    pcurve->handle->D0(t, P0);
+    ts[i]       = t;
+    xyzs[3*i  ] = P0.X();
+    xyzs[3*i+1] = P0.Y();
+    xyzs[3*i+2] = P0.Z();
   }
 
   return EGADS_SUCCESS;
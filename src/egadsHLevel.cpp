@@ -18,6 +18,7 @@
 #include "egadsInternals.h"
 #include "egadsClasses.h"
 #include "egadsStack.h"
+#include "emp.h"
 
 #define OCC_EXTRUDE
 #define OCC_ROTATE
@@ -62,6 +63,7 @@
                                /*@null@*/ const SurrealS<1> *param,
                                SurrealS<1> *result );
   extern "C" int  EG_tolerance( const egObject *topo, double *tol );
+  extern "C" int  EG_getBoundingBox( const egObject *topo, double *bbox );
   extern "C" int  EG_getTopology( const egObject *topo, egObject **geom,
                                   int *oclass, int *type,
                                   /*@null@*/ double *limits,
@@ -75,6 +77,8 @@
 
   extern "C" int  EG_generalBoolean( egObject *src, egObject *tool, int oper,
                                      double tol, egObject **model );
+  extern "C" int  EG_clusterBoolean( egObject *src, egObject *tool, int oper,
+                                     double tol, egObject **model );
   extern "C" int  EG_fuseSheets( const egObject *src, const egObject *tool,
                                  egObject **sheet );
   extern "C" int  EG_solidBoolean( const egObject *src, const egObject *tool,
@@ -82,6 +86,10 @@
   extern "C" int  EG_intersection( const egObject *src, const egObject *tool,
                                    int *nedge, /*@null@*/ egObject ***facEdg,
                                    egObject **model );
+  extern "C" int  EG_intersectionBatch( const egObject *src, int ntool,
+                                        const egObject **tools, int *nedge,
+                                        /*@null@*/ egObject ***facEdg,
+                                        egObject **model );
   extern "C" int  EG_imprintBody( const egObject *src, int nedge,
                                   const egObject **facEdg, egObject **result );
   extern "C" int  EG_filletBody( const egObject *src, int nedge,
@@ -972,101 +980,13 @@ EG_matchFaces(BRepAlgoAPI_BooleanOperation& BSO, const egObject *src,
 }
 
 
-int
-EG_generalBoolean(egObject *src, egObject *tool, int oper, double tol,
-                  egObject **model)
+static int
+EG_runGeneral(egObject *src, egObject *tool, int oper, double toler,
+              int parallel, TopTools_ListOfShape& sList,
+              TopTools_ListOfShape& tList, TopoDS_Shape& result,
+              egObject ***emap, egObject ***fmap)
 {
-  int          i, j, index, nerr, outLevel, stat;
-  double       toler = Precision::Confusion();
-  egObject     *context, *omodel, **emap = NULL, **fmap = NULL;
-  TopoDS_Shape result;
-
-  *model = NULL;
-  if  (src == NULL)               return EGADS_NULLOBJ;
-  if  (src->magicnumber != MAGIC) return EGADS_NOTOBJ;
-  if  (EG_sameThread(src))        return EGADS_CNTXTHRD;
-  if ((src->oclass != MODEL) && (src->oclass != BODY))
-                                  return EGADS_NOTBODY;
-  if  (src->blind == NULL)        return EGADS_NODATA;
-  outLevel = EG_outLevel(src);
-  context  = EG_context(src);
-  if (tol > 0.0) toler = tol;
-  if ((oper != SUBTRACTION) && (oper != INTERSECTION) &&
-      (oper != FUSION)      && (oper != SPLITTER)) {
-    if (outLevel > 0)
-      printf(" EGADS Error: BAD Operator = %d (EG_generalBoolean)!\n",
-             oper);
-    return EGADS_RANGERR;
-  }
-  if (tool == NULL) {
-    if (outLevel > 0)
-      printf(" EGADS Error: NULL Tool (EG_generalBoolean)!\n");
-    return EGADS_NULLOBJ;
-  }
-  if (tool->magicnumber != MAGIC) {
-    if (outLevel > 0)
-      printf(" EGADS Error: Tool is not an EGO (EG_generalBoolean)!\n");
-    return EGADS_NOTOBJ;
-  }
-  if (tool->blind == NULL) {
-    if (outLevel > 0)
-      printf(" EGADS Error: Tool has no data (EG_generalBoolean)!\n");
-    return EGADS_NODATA;
-  }
-  if (EG_sameThread(tool)) {
-    if (outLevel > 0)
-      printf(" EGADS Error: Bad Thread on Tool (EG_generalBoolean)!\n");
-    return EGADS_CNTXTHRD;
-  }
-  if (EG_context(tool) != context) {
-    if (outLevel > 0)
-      printf(" EGADS Error: Context mismatch (EG_generalBoolean)!\n");
-    return EGADS_MIXCNTX;
-  }
-  if ((tool->oclass > MODEL) || (tool->oclass < NODE)) {
-    if (outLevel > 0)
-      printf(" EGADS Error: Tool is not Topology (EG_generalBoolean)!\n");
-    return EGADS_NOTTOPO;
-  }
-
-  TopTools_ListOfShape sList, tList;
-  if (src->oclass == MODEL) {
-    egadsModel *pmdl = (egadsModel *) src->blind;
-    sList.Append(TopoDS::Compound(pmdl->shape));
-  } else {
-    egadsBody *pbody = (egadsBody *) src->blind;
-    if (src->mtype == SOLIDBODY) {
-      sList.Append(TopoDS::Solid(pbody->shape));
-    } else {
-      sList.Append(pbody->shape);
-    }
-  }
-  if (tool->oclass == MODEL) {
-    egadsModel *pmdl = (egadsModel *) tool->blind;
-    tList.Append(TopoDS::Compound(pmdl->shape));
-  } else if (tool->oclass == BODY) {
-    egadsBody *pbody = (egadsBody *) tool->blind;
-    if (tool->mtype == SOLIDBODY) {
-      tList.Append(TopoDS::Solid(pbody->shape));
-    } else {
-      tList.Append(pbody->shape);
-    }
-  } else if (tool->oclass == SHELL) {
-    egadsShell *pshell = (egadsShell *) tool->blind;
-    tList.Append(pshell->shell);
-  } else if (tool->oclass == FACE) {
-    egadsFace *pface = (egadsFace *) tool->blind;
-    tList.Append(pface->face);
-  } else if (tool->oclass == LOOP) {
-    egadsLoop *ploop = (egadsLoop *) tool->blind;
-    tList.Append(ploop->loop);
-  } else if (tool->oclass == EDGE) {
-    egadsEdge *pedge = (egadsEdge *) tool->blind;
-    tList.Append(pedge->edge);
-  } else {
-    egadsNode *pnode = (egadsNode *) tool->blind;
-    tList.Append(pnode->node);
-  }
+  int stat;
 
   if (oper == INTERSECTION) {
 
@@ -1078,6 +998,7 @@ EG_generalBoolean(egObject *src, egObject *tool, int oper, double tol,
       BSO.SetFuzzyValue(toler);
       BSO.SetNonDestructive(Standard_True);
       BSO.SetUseOBB(Standard_True);
+      if (parallel == 1) BSO.SetRunParallel(Standard_True);
       BSO.Build();
 #if !(defined(__APPLE__) && !defined(__clang__))
       if (BSO.HasErrors()) {
@@ -1090,7 +1011,7 @@ EG_generalBoolean(egObject *src, egObject *tool, int oper, double tol,
         return EGADS_GEOMERR;
       }
       result = BSO.Shape();
-      stat   = EG_matchGeneral(BSO, src, tool, result, &emap, &fmap);
+      stat   = EG_matchGeneral(BSO, src, tool, result, emap, fmap);
     }
     catch (const Standard_Failure& e) {
       printf(" EGADS Error: SBO Intersection Exception (EG_generalBoolean)!\n");
@@ -1112,6 +1033,7 @@ EG_generalBoolean(egObject *src, egObject *tool, int oper, double tol,
       BSO.SetFuzzyValue(toler);
       BSO.SetNonDestructive(Standard_True);
       BSO.SetUseOBB(Standard_True);
+      if (parallel == 1) BSO.SetRunParallel(Standard_True);
       BSO.Build();
 #if !(defined(__APPLE__) && !defined(__clang__))
       if (BSO.HasErrors()) {
@@ -1124,7 +1046,7 @@ EG_generalBoolean(egObject *src, egObject *tool, int oper, double tol,
         return EGADS_GEOMERR;
       }
       result = BSO.Shape();
-      stat   = EG_matchGeneral(BSO, src, tool, result, &emap, &fmap);
+      stat   = EG_matchGeneral(BSO, src, tool, result, emap, fmap);
     }
     catch (const Standard_Failure& e) {
       printf(" EGADS Error: SBO Subtraction Exception (EG_generalBoolean)!\n");
@@ -1146,6 +1068,7 @@ EG_generalBoolean(egObject *src, egObject *tool, int oper, double tol,
       BSO.SetFuzzyValue(toler);
       BSO.SetNonDestructive(Standard_True);
       BSO.SetUseOBB(Standard_True);
+      if (parallel == 1) BSO.SetRunParallel(Standard_True);
       BSO.Build();
 #if !(defined(__APPLE__) && !defined(__clang__))
       if (BSO.HasErrors()) {
@@ -1158,7 +1081,7 @@ EG_generalBoolean(egObject *src, egObject *tool, int oper, double tol,
         return EGADS_GEOMERR;
       }
       result = BSO.Shape();
-      stat   = EG_matchGeneral(BSO, src, tool, result, &emap, &fmap);
+      stat   = EG_matchGeneral(BSO, src, tool, result, emap, fmap);
     }
     catch (const Standard_Failure& e) {
       printf(" EGADS Error: SBO Fusion Exception (EG_generalBoolean)!\n");
@@ -1180,6 +1103,7 @@ EG_generalBoolean(egObject *src, egObject *tool, int oper, double tol,
       BSO.SetFuzzyValue(toler);
       BSO.SetNonDestructive(Standard_True);
       BSO.SetUseOBB(Standard_True);
+      if (parallel == 1) BSO.SetRunParallel(Standard_True);
       BSO.Build();
 #if !(defined(__APPLE__) && !defined(__clang__))
       if (BSO.HasErrors()) {
@@ -1192,7 +1116,7 @@ EG_generalBoolean(egObject *src, egObject *tool, int oper, double tol,
         return EGADS_GEOMERR;
       }
       result = BSO.Shape();
-      stat   = EG_matchSplitter(BSO, src, tool, result, &emap, &fmap);
+      stat   = EG_matchSplitter(BSO, src, tool, result, emap, fmap);
     }
     catch (const Standard_Failure& e) {
       printf(" EGADS Error: SBO Split Exception (EG_generalBoolean)!\n");
@@ -1205,6 +1129,519 @@ EG_generalBoolean(egObject *src, egObject *tool, int oper, double tol,
     }
 
   }
+
+  return stat;
+}
+
+
+/*
+ * cluster decomposition of a general Boolean
+ *
+ *   The source and tool pieces (Bodies in a Model) are grouped by their
+ *   overlapping (enlarged) bounding boxes. Each group cannot interact with
+ *   any other and is run as its own SBO (in parallel). Pieces in a group
+ *   without a counterpart are either passed through untouched or dropped
+ *   based on the operator. Each side of a group goes to OCC as a single
+ *   compound (as the single-shot SBO sees a Model), so pieces of the same
+ *   side are never fused with each other. The attribute mapping is done
+ *   against the full source and tool objects so propagation matches the
+ *   single-shot SBO.
+ *
+ *   Only the source pieces are separated. A single source piece with many
+ *   tools that all touch it (a panel with many holes) is one group and is
+ *   run as the single-shot SBO (with OCC's parallel mode) -- there is no
+ *   speedup for that case beyond dropping the tools that miss the source.
+ */
+
+typedef struct {
+  int          nsrc;            /* number of source pieces */
+  int          ntool;           /* number of tool pieces */
+  int          *pieces;         /* piece indices (source first) */
+  int          sbo;             /* 1 - run SBO, 0 - pass through, -1 drop */
+  int          stat;            /* SBO return status */
+  egObject     **emap;          /* Edge mapping (or NULL) */
+  egObject     **fmap;          /* Face mapping (or NULL) */
+  TopoDS_Shape result;          /* cluster result */
+} egCluster;
+
+typedef struct {
+  void         *mutex;          /* the mutex or NULL for single thread */
+  long         master;          /* master thread ID */
+  int          index;           /* next entry in order to consider */
+  int          end;             /* number of clusters with an SBO */
+  int          oper;            /* the Boolean operator */
+  int          parallel;        /* allow OCC to run threaded */
+  int          *order;          /* the SBO clusters -- largest first */
+  double       toler;           /* the fuzzy tolerance */
+  egObject     *src;            /* the source object */
+  egObject     *tool;           /* the tool object */
+  TopoDS_Shape *shapes;         /* the pieces */
+  egCluster    *clusters;       /* the clusters */
+} EMPcluster;
+
+
+static void
+EG_boolShape(const egObject *obj, TopoDS_Shape& shape)
+{
+  if (obj->oclass == MODEL) {
+    egadsModel *pmdl = (egadsModel *) obj->blind;
+    shape = TopoDS::Compound(pmdl->shape);
+  } else if (obj->oclass == BODY) {
+    egadsBody *pbody = (egadsBody *) obj->blind;
+    if (obj->mtype == SOLIDBODY) {
+      shape = TopoDS::Solid(pbody->shape);
+    } else {
+      shape = pbody->shape;
+    }
+  } else if (obj->oclass == SHELL) {
+    egadsShell *pshell = (egadsShell *) obj->blind;
+    shape = pshell->shell;
+  } else if (obj->oclass == FACE) {
+    egadsFace *pface = (egadsFace *) obj->blind;
+    shape = pface->face;
+  } else if (obj->oclass == LOOP) {
+    egadsLoop *ploop = (egadsLoop *) obj->blind;
+    shape = ploop->loop;
+  } else if (obj->oclass == EDGE) {
+    egadsEdge *pedge = (egadsEdge *) obj->blind;
+    shape = pedge->edge;
+  } else {
+    egadsNode *pnode = (egadsNode *) obj->blind;
+    shape = pnode->node;
+  }
+}
+
+
+static int
+EG_clusterRoot(int *parent, int i)
+{
+  while (parent[i] != i) {
+    parent[i] = parent[parent[i]];
+    i         = parent[i];
+  }
+  return i;
+}
+
+
+static void
+EG_clusterThread(void *struc)
+{
+  int        i, index;
+  long       ID;
+  egCluster  *clust;
+  EMPcluster *cthread;
+
+  cthread = (EMPcluster *) struc;
+
+  /* get our identifier */
+  ID = EMP_ThreadID();
+
+  /* look for work */
+  for (;;) {
+
+    /* only one thread at a time here -- controlled by a mutex! */
+    if (cthread->mutex != NULL) EMP_LockSet(cthread->mutex);
+    index = cthread->index;
+    cthread->index++;
+    if (cthread->mutex != NULL) EMP_LockRelease(cthread->mutex);
+    if (index >= cthread->end) break;
+
+    /* do the work -- one compound per side, as the single-shot SBO sees */
+    clust = &cthread->clusters[cthread->order[index]];
+    TopoDS_Compound sCompound, tCompound;
+    BRep_Builder    builder3D;
+    builder3D.MakeCompound(sCompound);
+    builder3D.MakeCompound(tCompound);
+    for (i = 0; i < clust->nsrc+clust->ntool; i++)
+      if (i < clust->nsrc) {
+        builder3D.Add(sCompound, cthread->shapes[clust->pieces[i]]);
+      } else {
+        builder3D.Add(tCompound, cthread->shapes[clust->pieces[i]]);
+      }
+    TopTools_ListOfShape sList, tList;
+    sList.Append(sCompound);
+    tList.Append(tCompound);
+    clust->stat = EG_runGeneral(cthread->src, cthread->tool, cthread->oper,
+                                cthread->toler, cthread->parallel, sList, tList,
+                                clust->result, &clust->emap, &clust->fmap);
+  }
+
+  /* exhausted all work -- exit */
+  if (ID != cthread->master) EMP_ThreadExit();
+}
+
+
+static int
+EG_clusterGeneral(int outLevel, egObject *src, egObject *tool, int oper,
+                  double toler, TopoDS_Shape& result, egObject ***emapping,
+                  egObject ***fmapping)
+{
+  int          i, j, k, n, np, stat, nsrc, ntool, npiece, nclust, nsbo;
+  int          fullAttrs, index, *parent = NULL, *pieces = NULL, *order = NULL;
+  long         start;
+  double       *boxes = NULL;
+  void         **threads = NULL;
+  egObject     **sbodies, **tbodies, **emap = NULL, **fmap = NULL;
+  egCluster    *clusters = NULL;
+  TopoDS_Shape *shapes   = NULL;
+  EMPcluster   cthread;
+
+  *emapping = NULL;
+  *fmapping = NULL;
+  fullAttrs = EG_fullAttrs(src);
+  nclust    = 0;
+
+  nsrc    = 1;
+  sbodies = &src;
+  if (src->oclass == MODEL) {
+    egadsModel *pmdl = (egadsModel *) src->blind;
+    nsrc    = pmdl->nbody;
+    sbodies = pmdl->bodies;
+  }
+  ntool   = 1;
+  tbodies = &tool;
+  if (tool->oclass == MODEL) {
+    egadsModel *pmdl = (egadsModel *) tool->blind;
+    ntool   = pmdl->nbody;
+    tbodies = pmdl->bodies;
+  }
+  npiece = nsrc + ntool;
+  if (npiece <= 2) return EGADS_OUTSIDE;
+
+  /* get the pieces and their bounding boxes */
+  boxes  = (double *) EG_alloc(6*npiece*sizeof(double));
+  parent = (int *)    EG_alloc(3*npiece*sizeof(int));
+  if ((boxes == NULL) || (parent == NULL)) {
+    stat = EGADS_MALLOC;
+    goto cleanup;
+  }
+  pieces = &parent[npiece];
+  order  = &parent[2*npiece];
+  shapes = new TopoDS_Shape[npiece];
+  for (i = 0; i < npiece; i++) {
+    egObject *obj = (i < nsrc) ? sbodies[i] : tbodies[i-nsrc];
+    if (obj        == NULL) {
+      stat = EGADS_NULLOBJ;
+      goto cleanup;
+    }
+    if (obj->blind == NULL) {
+      stat = EGADS_NODATA;
+      goto cleanup;
+    }
+    EG_boolShape(obj, shapes[i]);
+    stat = EG_getBoundingBox(obj, &boxes[6*i]);
+    if (stat != EGADS_SUCCESS) goto cleanup;
+    parent[i] = i;
+  }
+
+  /* union the pieces with overlapping boxes */
+  for (i = 0; i < npiece; i++)
+    for (j = i+1; j < npiece; j++) {
+      if (boxes[6*i  ]-toler > boxes[6*j+3]+toler) continue;
+      if (boxes[6*i+3]+toler < boxes[6*j  ]-toler) continue;
+      if (boxes[6*i+1]-toler > boxes[6*j+4]+toler) continue;
+      if (boxes[6*i+4]+toler < boxes[6*j+1]-toler) continue;
+      if (boxes[6*i+2]-toler > boxes[6*j+5]+toler) continue;
+      if (boxes[6*i+5]+toler < boxes[6*j+2]-toler) continue;
+      k = EG_clusterRoot(parent, i);
+      n = EG_clusterRoot(parent, j);
+      if (k < n) {
+        parent[n] = k;
+      } else {
+        parent[k] = n;
+      }
+    }
+  for (nclust = i = 0; i < npiece; i++) {
+    parent[i] = EG_clusterRoot(parent, i);
+    if (parent[i] == i) nclust++;
+  }
+
+  /* fill the clusters in order of their lowest piece index */
+  clusters = new egCluster[nclust];
+  for (n = i = 0; i < npiece; i++) {
+    if (parent[i] != i) continue;
+    clusters[n].nsrc   = clusters[n].ntool = 0;
+    clusters[n].stat   = EGADS_SUCCESS;
+    clusters[n].emap   = NULL;
+    clusters[n].fmap   = NULL;
+    clusters[n].pieces = NULL;
+    order[i] = n++;
+  }
+  for (i = 0; i < npiece; i++) {
+    k = order[parent[i]];
+    if (i < nsrc) {
+      clusters[k].nsrc++;
+    } else {
+      clusters[k].ntool++;
+    }
+  }
+  for (j = k = 0; k < nclust; k++) {
+    clusters[k].pieces = &pieces[j];
+    j += clusters[k].nsrc + clusters[k].ntool;
+    clusters[k].nsrc = clusters[k].ntool = 0;
+  }
+  for (i = 0; i < npiece; i++) {
+    k = order[parent[i]];
+    if (i < nsrc) {
+      clusters[k].pieces[clusters[k].nsrc++] = i;
+    } else {
+      clusters[k].pieces[clusters[k].nsrc+clusters[k].ntool++] = i;
+    }
+  }
+
+  /* what to do with each cluster */
+  for (nsbo = k = 0; k < nclust; k++) {
+    if ((clusters[k].nsrc != 0) && (clusters[k].ntool != 0)) {
+      clusters[k].sbo = 1;
+    } else if (clusters[k].nsrc != 0) {
+      clusters[k].sbo = (oper == INTERSECTION) ? -1 : 0;
+    } else {
+      clusters[k].sbo = (oper == FUSION) ? 0 : -1;
+    }
+    if (clusters[k].sbo == 1) order[nsbo++] = k;
+  }
+  if ((nclust == 1) && (clusters[0].sbo == 1)) {
+    stat = EGADS_OUTSIDE;
+    goto cleanup;
+  }
+  if (outLevel > 1)
+    printf(" Info: %d pieces in %d clusters with %d SBOs (EG_generalBoolean)\n",
+           npiece, nclust, nsbo);
+
+  /* biggest clusters first to balance the load */
+  for (i = 0; i < nsbo-1; i++)
+    for (j = i+1; j < nsbo; j++) {
+      k = order[i];
+      n = order[j];
+      if (clusters[n].nsrc+clusters[n].ntool <=
+          clusters[k].nsrc+clusters[k].ntool) continue;
+      order[i] = n;
+      order[j] = k;
+    }
+
+  /* set up for explicit multithreading */
+  cthread.mutex    = NULL;
+  cthread.master   = EMP_ThreadID();
+  cthread.index    = 0;
+  cthread.end      = nsbo;
+  cthread.oper     = oper;
+  cthread.parallel = 0;
+  cthread.order    = order;
+  cthread.toler    = toler;
+  cthread.src      = src;
+  cthread.tool     = tool;
+  cthread.shapes   = shapes;
+  cthread.clusters = clusters;
+
+  np = EMP_Init(&start);
+  if (outLevel > 1) printf(" EMP NumProcs = %d!\n", np);
+  if (nsbo < np) np = nsbo;
+  if (np <= 1) cthread.parallel = 1;
+
+  if (np > 1) {
+    /* create the mutex to handle list synchronization */
+    cthread.mutex = EMP_LockCreate();
+    if (cthread.mutex == NULL) {
+      printf(" EMP Error: mutex creation = NULL!\n");
+      np = 1;
+    } else {
+      /* get storage for our extra threads */
+      threads = (void **) malloc((np-1)*sizeof(void *));
+      if (threads == NULL) {
+        EMP_LockDestroy(cthread.mutex);
+        cthread.mutex = NULL;
+        np = 1;
+      }
+    }
+  }
+
+  /* create the threads and get going! */
+  if (threads != NULL)
+    for (i = 0; i < np-1; i++) {
+      threads[i] = EMP_ThreadCreate(EG_clusterThread, &cthread);
+      if (threads[i] == NULL)
+        printf(" EMP Error Creating Thread #%d!\n", i+1);
+    }
+  /* now run the thread block from the original thread */
+  EG_clusterThread(&cthread);
+
+  /* wait for all others to return */
+  if (threads != NULL)
+    for (i = 0; i < np-1; i++)
+      if (threads[i] != NULL) EMP_ThreadWait(threads[i]);
+
+  /* cleanup */
+  if (threads != NULL)
+    for (i = 0; i < np-1; i++)
+      if (threads[i] != NULL) EMP_ThreadDestroy(threads[i]);
+  if (cthread.mutex != NULL) EMP_LockDestroy(cthread.mutex);
+  if (threads != NULL) free(threads);
+  if (outLevel > 1)
+    printf(" EMP Number of Seconds on Boolean Thread Block = %ld\n",
+           EMP_Done(&start));
+
+  /* report the first failure */
+  for (k = 0; k < nclust; k++) {
+    if (clusters[k].sbo  != 1) continue;
+    if (clusters[k].stat == EGADS_SUCCESS) continue;
+    stat = clusters[k].stat;
+    goto cleanup;
+  }
+
+  /* assemble the result */
+  {
+    TopoDS_Compound compound;
+    BRep_Builder    builder3D;
+    builder3D.MakeCompound(compound);
+    for (k = 0; k < nclust; k++)
+      if (clusters[k].sbo == 1) {
+        if (clusters[k].result.ShapeType() == TopAbs_COMPOUND) {
+          TopoDS_Iterator it(clusters[k].result);
+          for (; it.More(); it.Next()) builder3D.Add(compound, it.Value());
+        } else {
+          builder3D.Add(compound, clusters[k].result);
+        }
+      } else if (clusters[k].sbo == 0) {
+        for (i = 0; i < clusters[k].nsrc+clusters[k].ntool; i++)
+          builder3D.Add(compound, shapes[clusters[k].pieces[i]]);
+      }
+    result = compound;
+  }
+
+  /* merge the attribute mappings */
+  {
+    TopTools_IndexedMapOfShape rmape, rmap;
+    TopExp::MapShapes(result, TopAbs_EDGE, rmape);
+    TopExp::MapShapes(result, TopAbs_FACE, rmap);
+    if ((fullAttrs != 0) && (rmape.Extent() != 0)) {
+      emap = (egObject **) EG_alloc(rmape.Extent()*sizeof(egObject *));
+      if (emap == NULL) {
+        stat = EGADS_MALLOC;
+        goto cleanup;
+      }
+      for (i = 0; i < rmape.Extent(); i++) emap[i] = NULL;
+    }
+    if (rmap.Extent() != 0) {
+      fmap = (egObject **) EG_alloc(rmap.Extent()*sizeof(egObject *));
+      if (fmap == NULL) {
+        if (emap != NULL) EG_free(emap);
+        stat = EGADS_MALLOC;
+        goto cleanup;
+      }
+      for (i = 0; i < rmap.Extent(); i++) fmap[i] = NULL;
+    }
+    for (k = 0; k < nclust; k++) {
+      if (clusters[k].sbo != 1) continue;
+      TopTools_IndexedMapOfShape cmape, cmap;
+      if ((emap != NULL) && (clusters[k].emap != NULL)) {
+        TopExp::MapShapes(clusters[k].result, TopAbs_EDGE, cmape);
+        for (i = 0; i < cmape.Extent(); i++) {
+          if (clusters[k].emap[i] == NULL) continue;
+          index = rmape.FindIndex(cmape(i+1));
+          if (index > 0) emap[index-1] = clusters[k].emap[i];
+        }
+      }
+      if ((fmap != NULL) && (clusters[k].fmap != NULL)) {
+        TopExp::MapShapes(clusters[k].result, TopAbs_FACE, cmap);
+        for (i = 0; i < cmap.Extent(); i++) {
+          if (clusters[k].fmap[i] == NULL) continue;
+          index = rmap.FindIndex(cmap(i+1));
+          if (index > 0) fmap[index-1] = clusters[k].fmap[i];
+        }
+      }
+    }
+  }
+  *emapping = emap;
+  *fmapping = fmap;
+  stat      = EGADS_SUCCESS;
+
+cleanup:
+  if (clusters != NULL) {
+    for (k = 0; k < nclust; k++) {
+      if (clusters[k].emap != NULL) EG_free(clusters[k].emap);
+      if (clusters[k].fmap != NULL) EG_free(clusters[k].fmap);
+    }
+    delete [] clusters;
+  }
+  if (shapes != NULL) delete [] shapes;
+  if (parent != NULL) EG_free(parent);
+  if (boxes  != NULL) EG_free(boxes);
+  return stat;
+}
+
+
+static int
+EG_booleanGeneral(egObject *src, egObject *tool, int oper, double tol,
+                  int cluster, egObject **model)
+{
+  int          i, j, index, nerr, outLevel, stat;
+  double       toler = Precision::Confusion();
+  egObject     *context, *omodel, **emap = NULL, **fmap = NULL;
+  TopoDS_Shape result;
+
+  *model = NULL;
+  if  (src == NULL)               return EGADS_NULLOBJ;
+  if  (src->magicnumber != MAGIC) return EGADS_NOTOBJ;
+  if  (EG_sameThread(src))        return EGADS_CNTXTHRD;
+  if ((src->oclass != MODEL) && (src->oclass != BODY))
+                                  return EGADS_NOTBODY;
+  if  (src->blind == NULL)        return EGADS_NODATA;
+  outLevel = EG_outLevel(src);
+  context  = EG_context(src);
+  if (tol > 0.0) toler = tol;
+  if ((oper != SUBTRACTION) && (oper != INTERSECTION) &&
+      (oper != FUSION)      && (oper != SPLITTER)) {
+    if (outLevel > 0)
+      printf(" EGADS Error: BAD Operator = %d (EG_generalBoolean)!\n",
+             oper);
+    return EGADS_RANGERR;
+  }
+  if (tool == NULL) {
+    if (outLevel > 0)
+      printf(" EGADS Error: NULL Tool (EG_generalBoolean)!\n");
+    return EGADS_NULLOBJ;
+  }
+  if (tool->magicnumber != MAGIC) {
+    if (outLevel > 0)
+      printf(" EGADS Error: Tool is not an EGO (EG_generalBoolean)!\n");
+    return EGADS_NOTOBJ;
+  }
+  if (tool->blind == NULL) {
+    if (outLevel > 0)
+      printf(" EGADS Error: Tool has no data (EG_generalBoolean)!\n");
+    return EGADS_NODATA;
+  }
+  if (EG_sameThread(tool)) {
+    if (outLevel > 0)
+      printf(" EGADS Error: Bad Thread on Tool (EG_generalBoolean)!\n");
+    return EGADS_CNTXTHRD;
+  }
+  if (EG_context(tool) != context) {
+    if (outLevel > 0)
+      printf(" EGADS Error: Context mismatch (EG_generalBoolean)!\n");
+    return EGADS_MIXCNTX;
+  }
+  if ((tool->oclass > MODEL) || (tool->oclass < NODE)) {
+    if (outLevel > 0)
+      printf(" EGADS Error: Tool is not Topology (EG_generalBoolean)!\n");
+    return EGADS_NOTTOPO;
+  }
+
+  TopoDS_Shape sShape, tShape;
+  TopTools_ListOfShape sList, tList;
+  EG_boolShape(src,  sShape);
+  EG_boolShape(tool, tShape);
+  sList.Append(sShape);
+  tList.Append(tShape);
+
+  stat = EGADS_OUTSIDE;
+  if (cluster == 1)
+    stat = EG_clusterGeneral(outLevel, src, tool, oper, toler, result,
+                             &emap, &fmap);
+  if (stat == EGADS_OUTSIDE)
+    stat = EG_runGeneral(src, tool, oper, toler, cluster, sList, tList, result,
+                         &emap, &fmap);
+  if (stat == EGADS_GEOMERR) return stat;
   if (stat != EGADS_SUCCESS) {
     if (outLevel > 0)
       printf(" EGADS Error: Attribute Mapping failed = %d (EG_generalBoolean)!\n",
@@ -1381,6 +1818,22 @@ EG_generalBoolean(egObject *src, egObject *tool, int oper, double tol,
 }
 
 
+int
+EG_generalBoolean(egObject *src, egObject *tool, int oper, double tol,
+                  egObject **model)
+{
+  return EG_booleanGeneral(src, tool, oper, tol, 0, model);
+}
+
+
+int
+EG_clusterBoolean(egObject *src, egObject *tool, int oper, double tol,
+                  egObject **model)
+{
+  return EG_booleanGeneral(src, tool, oper, tol, 1, model);
+}
+
+
 static int
 EG_modelBoolean(const egObject *src, const egObject *tool, int oper,
                       egObject **model)
@@ -2995,32 +3448,14 @@ EG_solidBoolean(const egObject *src, const egObject *tool, int oper,
 }
 
 
-int
-EG_intersection(const egObject *src, const egObject *tool, int *nEdge,
-                /*@null@*/ egObject ***facEdg, egObject **model)
+static int
+EG_sectionTool(int outLevel, egObject *context, const egObject *tool,
+               const egObject **face, TopoDS_Shape& s1)
 {
-  int             i, j, n, stat, outLevel, nloop, sense, index, found, nerr;
-  int             plane = 1;
-  egObject        *context = NULL, *omodel = NULL, *geom = NULL, **list = NULL;
-  const egObject  *face  = NULL;
-  egadsFace       *pface = NULL;
-  TopoDS_Shape    s1, result;
-  TopoDS_Vertex   V1, V2, Vs, lV1, lV2;
-  TopExp_Explorer Exp;
-
-  *nEdge = 0;
-  *model = NULL;
-  if (facEdg != NULL) *facEdg = NULL;
-  if  (src == NULL)               return EGADS_NULLOBJ;
-  if  (src->magicnumber != MAGIC) return EGADS_NOTOBJ;
-  if  (src->oclass != BODY)       return EGADS_NOTBODY;
-  if ((src->mtype != SOLIDBODY) && (src->mtype != SHEETBODY) &&
-      (src->mtype != FACEBODY))   return EGADS_NOTTOPO;
-  if  (src->blind == NULL)        return EGADS_NODATA;
-  if  (EG_sameThread(src))        return EGADS_CNTXTHRD;
-  outLevel = EG_outLevel(src);
-  context  = EG_context(src);
+  egObject  *geom;
+  egadsFace *pface;
 
+  *face = NULL;
   if (tool == NULL) {
     if (outLevel > 0)
       printf(" EGADS Error: NULL Tool (EG_intersection)!\n");
@@ -3050,9 +3485,9 @@ EG_intersection(const egObject *src, const egObject *tool, int *nEdge,
   if (tool->oclass == BODY) {
     egadsBody *pbodf = (egadsBody *) tool->blind;
     if (tool->mtype == FACEBODY) {
-      face = pbodf->faces.objs[0];
+      *face = pbodf->faces.objs[0];
     } else if (tool->mtype == SHEETBODY) {
-      if (pbodf->faces.map.Extent() == 1) face = pbodf->faces.objs[0];
+      if (pbodf->faces.map.Extent() == 1) *face = pbodf->faces.objs[0];
     } else if (tool->mtype == WIREBODY) {
       if (outLevel > 0)
         printf(" EGADS Error: Tool is a Wire Body (EG_intersection)!\n");
@@ -3064,18 +3499,17 @@ EG_intersection(const egObject *src, const egObject *tool, int *nEdge,
         printf(" EGADS Error: Tool is not a Face or Body (EG_intersection)!\n");
       return EGADS_NOTBODY;
     }
-    face = tool;
+    *face = tool;
   }
-  if (face != NULL) {
+  if (*face != NULL) {
     /* a single Face in tool */
-    pface = (egadsFace *) face->blind;
+    pface = (egadsFace *) (*face)->blind;
     geom  = pface->surface;
     if (geom->blind == NULL) {
       if (outLevel > 0)
         printf(" EGADS Error: Tool Surface is NULL (EG_intersection)!\n");
       return EGADS_NOTGEOM;
     }
-    if (geom->mtype != PLANE) plane = 0;
     s1 = pface->face;
   } else {
     /* multiple Faces in tool */
@@ -3083,27 +3517,39 @@ EG_intersection(const egObject *src, const egObject *tool, int *nEdge,
     s1 = pbodf->shape;
   }
 
-  egadsBody *pbody = (egadsBody *) src->blind;
-  BRepAlgoAPI_Section Sec(s1, pbody->shape, Standard_False);
-  Sec.ComputePCurveOn1(Standard_True);
-  Sec.ComputePCurveOn2(Standard_True);
-  Sec.Approximation(Standard_True);
-  Sec.Build();
-  if (!Sec.IsDone()) {
-    if (outLevel > 0)
-      printf(" EGADS Error: Can't Section (EG_intersection)!\n");
-    return EGADS_GEOMERR;
+  return EGADS_SUCCESS;
+}
+
+
+static int
+EG_sectionWires(egObject *context, int outLevel, const egObject *src,
+                const egObject *tool, /*@null@*/ const egObject *face,
+                BRepAlgoAPI_Section& Sec, TopoDS_Compound& compound,
+                int *nLoop, egObject ***wires, int *nPair,
+                /*@null@*/ egObject ***pairs)
+{
+  int           i, j, n, stat, nloop, sense, index, found, nerr, plane = 1;
+  egObject      *geom = NULL, **list = NULL;
+  egadsFace     *pface = NULL;
+  TopoDS_Shape  result;
+  TopoDS_Vertex V1, V2, Vs, lV1, lV2;
+  BRep_Builder  builder3D;
+
+  *nLoop = *nPair = 0;
+  *wires = NULL;
+  if (pairs != NULL) *pairs = NULL;
+  if (face  != NULL) {
+    pface = (egadsFace *) face->blind;
+    geom  = pface->surface;
+    if (geom->mtype != PLANE) plane = 0;
   }
+  egadsBody *pbody = (egadsBody *) src->blind;
   result = Sec.Shape();
 
   TopTools_IndexedMapOfShape MapE;
   TopExp::MapShapes(result, TopAbs_EDGE, MapE);
   int nedge = MapE.Extent();
-  if (nedge == 0) {
-    if (outLevel > 0)
-      printf(" EGADS Error: No Intersection (EG_intersection)!\n");
-    return EGADS_CONSTERR;
-  }
+  if (nedge == 0) return EGADS_CONSTERR;
 
   // find the Loops
   loopInfo *info = new loopInfo[nedge];
@@ -3206,9 +3652,6 @@ EG_intersection(const egObject *src, const egObject *tool, int *nEdge,
   }
 
   // make the OCC Wires and then the WireBodies
-  TopoDS_Compound compound;
-  BRep_Builder    builder3D;
-  builder3D.MakeCompound(compound);
   for (i = 0; i < nloop; i++) {
     BRepBuilderAPI_MakeWire MW;
     index = 0;
@@ -3348,8 +3791,8 @@ EG_intersection(const egObject *src, const egObject *tool, int *nEdge,
   }
 
   // fill in the Face/Edge pairs (if requested)
-  if (facEdg != NULL) {
-    *facEdg = list = (egObject **) EG_alloc(2*nedge*sizeof(egObject *));
+  if (pairs != NULL) {
+    *pairs = list = (egObject **) EG_alloc(2*nedge*sizeof(egObject *));
     n = 0;
     if (list != NULL)
       for (i = 0; i < nloop; i++) {
@@ -3367,10 +3810,21 @@ EG_intersection(const egObject *src, const egObject *tool, int *nEdge,
           }
         }
       }
-    *nEdge = n/2;
+    *nPair = n/2;
   }
 
-  // make the EGADS model
+  *nLoop = nloop;
+  *wires = wireo;
+  return EGADS_SUCCESS;
+}
+
+
+static int
+EG_sectionModel(egObject *context, TopoDS_Compound& compound, int nloop,
+                egObject **wireo, egObject **model)
+{
+  int      i, stat;
+  egObject *omodel = NULL;
 
   egadsModel *mshape  = new egadsModel;
   mshape->shape       = compound;
@@ -3403,6 +3857,398 @@ EG_intersection(const egObject *src, const egObject *tool, int *nEdge,
 }
 
 
+int
+EG_intersection(const egObject *src, const egObject *tool, int *nEdge,
+                /*@null@*/ egObject ***facEdg, egObject **model)
+{
+  int             stat, outLevel, nloop;
+  egObject        *context = NULL, **wireo = NULL;
+  const egObject  *face  = NULL;
+  TopoDS_Shape    s1;
+  TopoDS_Compound compound;
+  BRep_Builder    builder3D;
+
+  *nEdge = 0;
+  *model = NULL;
+  if (facEdg != NULL) *facEdg = NULL;
+  if  (src == NULL)               return EGADS_NULLOBJ;
+  if  (src->magicnumber != MAGIC) return EGADS_NOTOBJ;
+  if  (src->oclass != BODY)       return EGADS_NOTBODY;
+  if ((src->mtype != SOLIDBODY) && (src->mtype != SHEETBODY) &&
+      (src->mtype != FACEBODY))   return EGADS_NOTTOPO;
+  if  (src->blind == NULL)        return EGADS_NODATA;
+  if  (EG_sameThread(src))        return EGADS_CNTXTHRD;
+  outLevel = EG_outLevel(src);
+  context  = EG_context(src);
+
+  stat = EG_sectionTool(outLevel, context, tool, &face, s1);
+  if (stat != EGADS_SUCCESS) return stat;
+
+  egadsBody *pbody = (egadsBody *) src->blind;
+  BRepAlgoAPI_Section Sec(s1, pbody->shape, Standard_False);
+  Sec.ComputePCurveOn1(Standard_True);
+  Sec.ComputePCurveOn2(Standard_True);
+  Sec.Approximation(Standard_True);
+  Sec.Build();
+  if (!Sec.IsDone()) {
+    if (outLevel > 0)
+      printf(" EGADS Error: Can't Section (EG_intersection)!\n");
+    return EGADS_GEOMERR;
+  }
+
+  builder3D.MakeCompound(compound);
+  stat = EG_sectionWires(context, outLevel, src, tool, face, Sec, compound,
+                         &nloop, &wireo, nEdge, facEdg);
+  if (stat == EGADS_CONSTERR) {
+    if (outLevel > 0)
+      printf(" EGADS Error: No Intersection (EG_intersection)!\n");
+    return stat;
+  }
+  if (stat != EGADS_SUCCESS) return stat;
+
+  // make the EGADS model
+
+  stat = EG_sectionModel(context, compound, nloop, wireo, model);
+  if (stat != EGADS_SUCCESS) {
+    if (facEdg != NULL) {
+      if (*facEdg != NULL) EG_free(*facEdg);
+      *facEdg = NULL;
+    }
+    *nEdge = 0;
+  }
+  return stat;
+}
+
+
+/*
+ * Batch intersection of many tools against a single source Body
+ *
+ *   The source Face bounding boxes are found once and each tool is only
+ *   sectioned against the Faces its box touches (pruned entirely if none).
+ *   The OCC sections run concurrently; the WireBodies are then made in the
+ *   context thread and merged into a single Model and Face/Edge list for
+ *   one call to EG_imprintBody.
+ */
+
+typedef struct {
+  int                 stat;     /* section return status */
+  const egObject      *face;    /* the single tool Face (or NULL) */
+  TopoDS_Shape        s1;       /* the tool shape */
+  TopoDS_Shape        s2;       /* the source Faces touched by the tool */
+  BRepAlgoAPI_Section *sec;     /* the section (NULL if pruned) */
+} egSection;
+
+typedef struct {
+  void      *mutex;             /* the mutex or NULL for single thread */
+  long      master;             /* master thread ID */
+  int       index;              /* next entry in order to consider */
+  int       end;                /* number of tools to section */
+  int       parallel;           /* allow OCC to run threaded */
+  int       *order;             /* the tools that survive pruning */
+  egSection *sections;          /* the sections for each tool */
+} EMPsection;
+
+
+static void
+EG_sectionThread(void *struc)
+{
+  int        index;
+  long       ID;
+  egSection  *sect;
+  EMPsection *sthread;
+
+  sthread = (EMPsection *) struc;
+
+  /* get our identifier */
+  ID = EMP_ThreadID();
+
+  /* look for work */
+  for (;;) {
+
+    /* only one thread at a time here -- controlled by a mutex! */
+    if (sthread->mutex != NULL) EMP_LockSet(sthread->mutex);
+    index = sthread->index;
+    sthread->index++;
+    if (sthread->mutex != NULL) EMP_LockRelease(sthread->mutex);
+    if (index >= sthread->end) break;
+
+    /* do the work -- OCC only, no EGADS Objects are made here */
+    sect = &sthread->sections[sthread->order[index]];
+    try {
+      /* the source TShapes are shared -- leave their tolerances alone */
+      sect->sec = new BRepAlgoAPI_Section(sect->s1, sect->s2, Standard_False);
+#if CASVER >= 720
+      sect->sec->SetNonDestructive(Standard_True);
+#endif
+      sect->sec->ComputePCurveOn1(Standard_True);
+      sect->sec->ComputePCurveOn2(Standard_True);
+      sect->sec->Approximation(Standard_True);
+      if (sthread->parallel == 1) sect->sec->SetRunParallel(Standard_True);
+      sect->sec->Build();
+      if (!sect->sec->IsDone()) sect->stat = EGADS_GEOMERR;
+    }
+    catch (const Standard_Failure& e) {
+      printf(" EGADS Error: Section Exception (EG_intersectionBatch)!\n");
+      printf("              %s\n", e.GetMessageString());
+      sect->stat = EGADS_GEOMERR;
+    }
+    catch (...) {
+      printf(" EGADS Error: Section Exception (EG_intersectionBatch)!\n");
+      sect->stat = EGADS_GEOMERR;
+    }
+  }
+
+  /* exhausted all work -- exit */
+  if (ID != sthread->master) EMP_ThreadExit();
+}
+
+
+int
+EG_intersectionBatch(const egObject *src, int ntool, const egObject **tools,
+                     int *nEdge, /*@null@*/ egObject ***facEdg,
+                     egObject **model)
+{
+  int             i, j, k, n, np, stat, outLevel, nface, nsec, nloop, npair;
+  int             nwire = 0, nlist = 0, *order = NULL;
+  long            start;
+  double          toler, tbox[6], *boxes = NULL;
+  void            **threads = NULL;
+  egObject        *context, **wireo, **pairs, **tmp;
+  egObject        **wires = NULL, **list = NULL;
+  egadsBody       *pbody;
+  egSection       *sections = NULL;
+  TopoDS_Compound compound;
+  BRep_Builder    builder3D;
+  EMPsection      sthread;
+
+  *nEdge = 0;
+  *model = NULL;
+  if (facEdg != NULL) *facEdg = NULL;
+  if  (src == NULL)               return EGADS_NULLOBJ;
+  if  (src->magicnumber != MAGIC) return EGADS_NOTOBJ;
+  if  (src->oclass != BODY)       return EGADS_NOTBODY;
+  if ((src->mtype != SOLIDBODY) && (src->mtype != SHEETBODY) &&
+      (src->mtype != FACEBODY))   return EGADS_NOTTOPO;
+  if  (src->blind == NULL)        return EGADS_NODATA;
+  if  (EG_sameThread(src))        return EGADS_CNTXTHRD;
+  outLevel = EG_outLevel(src);
+  context  = EG_context(src);
+  if (tools == NULL) return EGADS_NULLOBJ;
+  if (ntool <= 0) {
+    if (outLevel > 0)
+      printf(" EGADS Error: nTool = %d (EG_intersectionBatch)!\n", ntool);
+    return EGADS_RANGERR;
+  }
+
+  /* prepare the source once -- the Face bounding boxes */
+  pbody = (egadsBody *) src->blind;
+  nface = pbody->faces.map.Extent();
+  stat  = EG_tolerance(src, &toler);
+  if (stat != EGADS_SUCCESS) return stat;
+  boxes = (double *) EG_alloc(6*nface*sizeof(double));
+  order = (int *)    EG_alloc(ntool*sizeof(int));
+  if ((boxes == NULL) || (order == NULL)) {
+    stat = EGADS_MALLOC;
+    goto cleanup;
+  }
+  for (i = 0; i < nface; i++) {
+    stat = EG_getBoundingBox(pbody->faces.objs[i], &boxes[6*i]);
+    if (stat != EGADS_SUCCESS) goto cleanup;
+  }
+
+  /* get the tools and the source Faces each may touch */
+  sections = new egSection[ntool];
+  for (i = 0; i < ntool; i++) {
+    sections[i].stat = EGADS_SUCCESS;
+    sections[i].face = NULL;
+    sections[i].sec  = NULL;
+  }
+  for (nsec = i = 0; i < ntool; i++) {
+    stat = EG_sectionTool(outLevel, context, tools[i], &sections[i].face,
+                          sections[i].s1);
+    if (stat == EGADS_SUCCESS) stat = EG_getBoundingBox(tools[i], tbox);
+    if (stat != EGADS_SUCCESS) {
+      if (outLevel > 0)
+        printf(" EGADS Error: Tool %d = %d (EG_intersectionBatch)!\n",
+               i+1, stat);
+      goto cleanup;
+    }
+    TopoDS_Compound touched;
+    builder3D.MakeCompound(touched);
+    for (n = j = 0; j < nface; j++) {
+      if (tbox[0]-toler > boxes[6*j+3]+toler) continue;
+      if (tbox[3]+toler < boxes[6*j  ]-toler) continue;
+      if (tbox[1]-toler > boxes[6*j+4]+toler) continue;
+      if (tbox[4]+toler < boxes[6*j+1]-toler) continue;
+      if (tbox[2]-toler > boxes[6*j+5]+toler) continue;
+      if (tbox[5]+toler < boxes[6*j+2]-toler) continue;
+      builder3D.Add(touched, pbody->faces.map(j+1));
+      n++;
+    }
+    if (n == 0) continue;
+    if (n == nface) {
+      sections[i].s2 = pbody->shape;
+    } else {
+      sections[i].s2 = touched;
+    }
+    order[nsec++] = i;
+  }
+  if (outLevel > 1)
+    printf(" Info: %d of %d tools survive pruning (EG_intersectionBatch)\n",
+           nsec, ntool);
+
+  /* set up for explicit multithreading */
+  sthread.mutex    = NULL;
+  sthread.master   = EMP_ThreadID();
+  sthread.index    = 0;
+  sthread.end      = nsec;
+  sthread.parallel = 0;
+  sthread.order    = order;
+  sthread.sections = sections;
+
+  np = EMP_Init(&start);
+  if (outLevel > 1) printf(" EMP NumProcs = %d!\n", np);
+  if (nsec < np) np = nsec;
+#if CASVER < 720
+  /* no non-destructive mode -- sections could retolerance shared shapes */
+  np = 1;
+#endif
+  if (np <= 1) sthread.parallel = 1;
+
+  if (np > 1) {
+    /* create the mutex to handle list synchronization */
+    sthread.mutex = EMP_LockCreate();
+    if (sthread.mutex == NULL) {
+      printf(" EMP Error: mutex creation = NULL!\n");
+      np = 1;
+    } else {
+      /* get storage for our extra threads */
+      threads = (void **) malloc((np-1)*sizeof(void *));
+      if (threads == NULL) {
+        EMP_LockDestroy(sthread.mutex);
+        sthread.mutex = NULL;
+        np = 1;
+      }
+    }
+  }
+
+  /* create the threads and get going! */
+  if (threads != NULL)
+    for (i = 0; i < np-1; i++) {
+      threads[i] = EMP_ThreadCreate(EG_sectionThread, &sthread);
+      if (threads[i] == NULL)
+        printf(" EMP Error Creating Thread #%d!\n", i+1);
+    }
+  /* now run the thread block from the original thread */
+  EG_sectionThread(&sthread);
+
+  /* wait for all others to return */
+  if (threads != NULL)
+    for (i = 0; i < np-1; i++)
+      if (threads[i] != NULL) EMP_ThreadWait(threads[i]);
+
+  /* cleanup */
+  if (threads != NULL)
+    for (i = 0; i < np-1; i++)
+      if (threads[i] != NULL) EMP_ThreadDestroy(threads[i]);
+  if (sthread.mutex != NULL) EMP_LockDestroy(sthread.mutex);
+  if (threads != NULL) free(threads);
+  if (outLevel > 1)
+    printf(" EMP Number of Seconds on Section Thread Block = %ld\n",
+           EMP_Done(&start));
+
+  /* report the first failure */
+  for (k = 0; k < nsec; k++) {
+    i = order[k];
+    if (sections[i].stat == EGADS_SUCCESS) continue;
+    if (outLevel > 0)
+      printf(" EGADS Error: Can't Section Tool %d (EG_intersectionBatch)!\n",
+             i+1);
+    stat = sections[i].stat;
+    goto cleanup;
+  }
+
+  /* make the WireBodies in tool order & merge them */
+  builder3D.MakeCompound(compound);
+  for (k = 0; k < nsec; k++) {
+    i    = order[k];
+    stat = EG_sectionWires(context, outLevel, src, tools[i], sections[i].face,
+                           *sections[i].sec, compound, &nloop, &wireo, &npair,
+                           (facEdg == NULL) ? NULL : &pairs);
+    if (stat == EGADS_CONSTERR) continue;
+    if (stat != EGADS_SUCCESS) goto cleanup;
+
+    if (nwire == 0) {
+      tmp = (egObject **) EG_alloc(nloop*sizeof(egObject *));
+    } else {
+      tmp = (egObject **) EG_reall(wires, (nwire+nloop)*sizeof(egObject *));
+    }
+    if (tmp == NULL) {
+      for (j = 0; j < nloop; j++) EG_deleteObject(wireo[j]);
+      delete [] wireo;
+      if ((facEdg != NULL) && (pairs != NULL)) EG_free(pairs);
+      stat = EGADS_MALLOC;
+      goto cleanup;
+    }
+    wires = tmp;
+    for (j = 0; j < nloop; j++) wires[nwire+j] = wireo[j];
+    nwire += nloop;
+    delete [] wireo;
+
+    if ((facEdg == NULL) || (pairs == NULL)) continue;
+    if (npair != 0) {
+      if (nlist == 0) {
+        tmp = (egObject **) EG_alloc(2*npair*sizeof(egObject *));
+      } else {
+        tmp = (egObject **) EG_reall(list,
+                                     2*(nlist+npair)*sizeof(egObject *));
+      }
+      if (tmp == NULL) {
+        EG_free(pairs);
+        stat = EGADS_MALLOC;
+        goto cleanup;
+      }
+      list = tmp;
+      for (j = 0; j < 2*npair; j++) list[2*nlist+j] = pairs[j];
+      nlist += npair;
+    }
+    EG_free(pairs);
+  }
+  if (nwire == 0) {
+    if (outLevel > 0)
+      printf(" EGADS Error: No Intersection (EG_intersectionBatch)!\n");
+    stat = EGADS_CONSTERR;
+    goto cleanup;
+  }
+
+  /* make the EGADS model -- takes ownership of the WireBodies */
+  wireo = new egObject*[nwire];
+  for (i = 0; i < nwire; i++) wireo[i] = wires[i];
+  n     = nwire;
+  nwire = 0;
+  stat  = EG_sectionModel(context, compound, n, wireo, model);
+  if (stat != EGADS_SUCCESS) goto cleanup;
+  if (facEdg != NULL) {
+    *nEdge  = nlist;
+    *facEdg = list;
+    list    = NULL;
+  }
+
+cleanup:
+  for (i = 0; i < nwire; i++) EG_deleteObject(wires[i]);
+  if (wires    != NULL) EG_free(wires);
+  if (list     != NULL) EG_free(list);
+  if (sections != NULL) {
+    for (i = 0; i < ntool; i++)
+      if (sections[i].sec != NULL) delete sections[i].sec;
+    delete [] sections;
+  }
+  if (order != NULL) EG_free(order);
+  if (boxes != NULL) EG_free(boxes);
+  return stat;
+}
+
+
 int
 EG_imprintBody(const egObject *src, int nedge, const egObject **facEdg,
                      egObject **result)
@@ -19,6 +19,7 @@
 #include "egadsTypes.h"
 #include "egadsInternals.h"
 #include "egadsClasses.h"
+#include "emp.h"
 #include <IGESControl_Controller.hxx>
 #include <IGESData_IGESModel.hxx>
 #include <IGESBasic_Name.hxx>
@@ -31,6 +32,13 @@
 #endif
 #include <StepRepr_RepresentationItem.hxx>
 #include <StepRepr_RepresentationContext.hxx>
+#include <StepRepr_Representation.hxx>
+#include <StepShape_TopologicalRepresentationItem.hxx>
+#include <StepShape_SolidModel.hxx>
+#include <StepGeom_Curve.hxx>
+#include <StepGeom_Surface.hxx>
+#include <StepGeom_Point.hxx>
+#include <StepGeom_Placement.hxx>
 #ifdef WRITECSYS
 #include <StepRepr_ConstructiveGeometryRepresentation.hxx>
 #include <StepRepr_HArray1OfRepresentationItem.hxx>
@@ -44,6 +52,8 @@
 #include <XSControl_TransferReader.hxx>
 #include <APIHeaderSection_MakeHeader.hxx>
 #include <Interface_Static.hxx>
+#include <Interface_InterfaceModel.hxx>
+#include <TopTools_SequenceOfShape.hxx>
 
 
 class egadsLabel
@@ -68,7 +78,7 @@ public:
   extern "C" void EG_initOCC( );
   extern "C" int  EG_destroyTopology( egObject *topo );
   extern "C" int  EG_fullAttrs( const egObject *obj );
-  extern "C" void EG_attrBuildSeq( egAttrs *attrs );
+  extern "C" void EG_attrBuildSeq( const egObject *obj, egAttrs *attrs );
   extern "C" void EG_readAttrs( egObject *obj, int nattr, FILE *fp );
   extern "C" void EG_writeAttr( egAttrs *attrs, FILE *fp );
   extern "C" int  EG_writeNumAttr( egAttrs *attrs );
@@ -605,7 +615,20 @@ EG_readAttrs(egObject *obj, int nattr, FILE *fp)
     }
 
     if (name != NULL) {
-      attr[n].name   = name;
+      attr[n].name = EG_attrName(obj, name);
+      EG_free(name);
+      name = attr[n].name;
+      if (name == NULL) {
+        if (type == ATTRINT) {
+          if ((len != 1) && (ivec != NULL)) EG_free(ivec);
+        } else if ((type == ATTRREAL) || (type == ATTRCSYS)) {
+          if ((len != 1) && (rvec != NULL)) EG_free(rvec);
+        } else {
+          if (string != NULL) EG_free(string);
+        }
+      }
+    }
+    if (name != NULL) {
       attr[n].type   = type;
       attr[n].length = len;
       if (type == ATTRINT) {
@@ -632,7 +655,8 @@ EG_readAttrs(egObject *obj, int nattr, FILE *fp)
     attrs->attrs  = attr;
     attrs->nseqs  = 0;
     attrs->seqs   = NULL;
-    if (nseq != 0) EG_attrBuildSeq(attrs);
+    attrs->nref   = 1;
+    if (nseq != 0) EG_attrBuildSeq(obj, attrs);
     obj->attrs    = attrs;
   }
 }
@@ -891,6 +915,498 @@ EG_importScale(const char *reader, const char *units, double *scale,
 }
 
 
+/* the names of the sub-shapes of one transferred root */
+static int
+EG_stepRootNames(const Handle(XSControl_TransferReader)& TR,
+                 const TopoDS_Shape& root, egadsLabel **labels)
+{
+  int        i, j, n, *hits;
+  const char **names;
+
+  *labels = NULL;
+  TopTools_IndexedMapOfShape MapAll;
+  TopExp::MapShapes(root, MapAll);
+  n     = MapAll.Extent();
+  hits  = (int *)         EG_alloc(n*sizeof(int));
+  names = (const char **) EG_alloc(n*sizeof(char *));
+  if ((hits == NULL) || (names == NULL)) {
+    if (names != NULL) EG_free(names);
+    if (hits  != NULL) EG_free(hits);
+    return 0;
+  }
+  for (i = 0, j = 1; j <= n; j++) {
+    const TopoDS_Shape& aShape = MapAll(j);
+    Handle(Standard_Transient) ent = TR->EntityFromShapeResult(aShape, 1);
+    if (ent.IsNull())          ent = TR->EntityFromShapeResult(aShape,-1);
+    if (ent.IsNull())          ent = TR->EntityFromShapeResult(aShape, 4);
+    if (ent.IsNull())          continue;
+    Handle(StepRepr_RepresentationItem) aReprItem;
+    aReprItem = Handle(StepRepr_RepresentationItem)::DownCast(ent);
+    if (aReprItem.IsNull())    continue;
+    const char *STEPname = aReprItem->Name()->ToCString();
+    if (STEPname == NULL)      continue;
+    if (strlen(STEPname) == 0) continue;
+    hits[i]  = j;
+    names[i] = STEPname;
+    i++;
+/*  printf(" %d/%d %s -> Name found: %s\n", j, n,
+           TopAbs::ShapeTypeToString(aShape.ShapeType()), STEPname);  */
+  }
+  if (i != 0) {
+    *labels = new egadsLabel[i];
+    for (j = 0; j < i; j++) {
+      (*labels)[j].shape     = MapAll(hits[j]);
+      (*labels)[j].shapeName = EG_strdup(names[j]);
+    }
+  }
+  EG_free(names);
+  EG_free(hits);
+
+  return i;
+}
+
+
+/* gather the per-root names in root order (frees the per-root lists) */
+static int
+EG_mergeLabels(int n, const int *nlabel, egadsLabel **rlabels,
+               egadsLabel **labels)
+{
+  int i, j, nas;
+
+  *labels = NULL;
+  for (nas = i = 0; i < n; i++) nas += nlabel[i];
+  if (nas != 0) {
+    *labels = new egadsLabel[nas];
+    for (nas = i = 0; i < n; i++)
+      for (j = 0; j < nlabel[i]; j++, nas++) {
+        (*labels)[nas].shape     = rlabels[i][j].shape;
+        (*labels)[nas].shapeName = rlabels[i][j].shapeName;
+      }
+  }
+  for (i = 0; i < n; i++)
+    if (rlabels[i] != NULL) delete [] rlabels[i];
+
+  return nas;
+}
+
+
+/*
+ * the lookups go through the single Transient Process of the reader, which
+ *   caches its last binder in place and so cannot be shared by threads --
+ *   the names are collected concurrently only in EG_stepTransfer, where each
+ *   thread has its own work session
+ */
+
+static int
+EG_stepNames(STEPControl_Reader& aReader, egadsLabel **labels)
+{
+  int        i, n, nas, *nlabel;
+  egadsLabel **rlabels;
+
+  *labels = NULL;
+  n       = aReader.NbShapes();
+  nlabel  = (int *)         EG_alloc(n*sizeof(int));
+  rlabels = (egadsLabel **) EG_alloc(n*sizeof(egadsLabel *));
+  if ((nlabel == NULL) || (rlabels == NULL)) {
+    if (rlabels != NULL) EG_free(rlabels);
+    if (nlabel  != NULL) EG_free(nlabel);
+    return 0;
+  }
+  const Handle(XSControl_WorkSession)& workSession = aReader.WS();
+  const Handle(XSControl_TransferReader)& TR = workSession->TransferReader();
+
+  /* a single pass over the sub-shapes of each root */
+  for (i = 0; i < n; i++)
+    nlabel[i] = EG_stepRootNames(TR, aReader.Shape(i+1), &rlabels[i]);
+
+  /* merge in root order */
+  nas = EG_mergeLabels(n, nlabel, rlabels, labels);
+  EG_free(rlabels);
+  EG_free(nlabel);
+
+  return nas;
+}
+
+
+/*
+ * concurrent STEP root transfers
+ *
+ *   Before OCC 7.8 the STEP actor keeps the length/angle unit factors of
+ *   the representation context being transferred in process-global state
+ *   (UnitsMethods, then StepData_GlobalFactors) -- concurrent roots could
+ *   then be scaled with each other's units. 7.8 carries the factors with
+ *   each transfer, so only then are the roots transferred concurrently.
+ */
+
+#if CASVER >= 780
+/* structure to pass data to the threads transferring STEP roots */
+typedef struct {
+  void                     *mutex;    /* the mutex or NULL for single thread */
+  long                     master;    /* master thread ID */
+  int                      index;     /* next group to transfer */
+  int                      end;       /* number of groups */
+  int                      slot;      /* next reader to hand out */
+  const int                *first;    /* start of each group in order */
+  const int                *order;    /* roots (bias 0) sorted by group */
+  int                      *ok;       /* transfer status for each root */
+  int                      *nlabel;   /* number of names for each root */
+  egadsLabel               **labels;  /* the names for each root */
+  TopTools_SequenceOfShape *shapes;   /* the shapes for each root */
+  STEPControl_Reader       *readers;  /* one work session per thread */
+} EMPxfer;
+
+
+static int
+EG_findGroup(int *parent, int i)
+{
+  while (parent[i] != i) {
+    parent[i] = parent[parent[i]];
+    i         = parent[i];
+  }
+  return i;
+}
+
+
+/* roots that share topology or representations must transfer together */
+static int
+EG_stepGroups(STEPControl_Reader& aReader, int nroot, int *group)
+{
+  int i, j, k, n, r, sp, nent, *owner, *mark, *stack;
+
+  const Handle(XSControl_WorkSession)& workSession = aReader.WS();
+  Handle(Interface_InterfaceModel) model = workSession->Model();
+  const Interface_Graph& graph = workSession->Graph();
+  nent  = model->NbEntities();
+  owner = (int *) EG_alloc(3*(nent+1)*sizeof(int));
+  if (owner == NULL) return EGADS_MALLOC;
+  mark  = &owner[  nent+1];
+  stack = &owner[2*nent+2];
+  for (i = 0; i <= nent; i++) owner[i] = mark[i] = 0;
+  for (r = 0; r < nroot; r++) group[r] = r;
+
+  for (r = 0; r < nroot; r++) {
+    n = model->Number(aReader.RootForTransfer(r+1));
+    if (n == 0) continue;
+    mark[n]  = r+1;
+    stack[0] = n;
+    sp       = 1;
+    while (sp > 0) {
+      n = stack[--sp];
+      Handle(Standard_Transient) ent = model->Value(n);
+      if (ent->IsKind(STANDARD_TYPE(StepShape_TopologicalRepresentationItem)) ||
+          ent->IsKind(STANDARD_TYPE(StepShape_SolidModel)) ||
+          ent->IsKind(STANDARD_TYPE(StepRepr_Representation))) {
+        if (owner[n] != 0) {
+          i = EG_findGroup(group, r);
+          j = EG_findGroup(group, owner[n]-1);
+          if (i < j) group[j] = i;
+          if (j < i) group[i] = j;
+          continue;
+        }
+        owner[n] = r+1;
+      }
+      /* the geometry below the topology is never shared as shapes */
+      if (ent->IsKind(STANDARD_TYPE(StepGeom_Curve))   ||
+          ent->IsKind(STANDARD_TYPE(StepGeom_Surface)) ||
+          ent->IsKind(STANDARD_TYPE(StepGeom_Point))   ||
+          ent->IsKind(STANDARD_TYPE(StepGeom_Placement))) continue;
+      Interface_EntityIterator subs = graph.Shareds(ent);
+      for (subs.Start(); subs.More(); subs.Next()) {
+        k = model->Number(subs.Value());
+        if ((k == 0) || (mark[k] == r+1)) continue;
+        mark[k]     = r+1;
+        stack[sp++] = k;
+      }
+    }
+  }
+  EG_free(owner);
+
+  for (n = r = 0; r < nroot; r++) {
+    group[r] = EG_findGroup(group, r);
+    if (group[r] == r) n++;
+  }
+  return n;
+}
+
+
+static void
+EG_stepXferThread(void *struc)
+{
+  int        i, j, k, m, r, index, slot, nshape;
+  long       ID;
+  egadsLabel *rlabels;
+  EMPxfer    *xthread;
+
+  xthread = (EMPxfer *) struc;
+
+  /* get our identifier & work session */
+  ID = EMP_ThreadID();
+  if (xthread->mutex != NULL) EMP_LockSet(xthread->mutex);
+  slot = xthread->slot;
+  xthread->slot++;
+  if (xthread->mutex != NULL) EMP_LockRelease(xthread->mutex);
+  STEPControl_Reader& rReader = xthread->readers[slot];
+  const Handle(XSControl_TransferReader)& TR = rReader.WS()->TransferReader();
+
+  /* look for work */
+  for (;;) {
+
+    /* only one thread at a time here -- controlled by a mutex! */
+    if (xthread->mutex != NULL) EMP_LockSet(xthread->mutex);
+    index = xthread->index;
+    xthread->index++;
+    if (xthread->mutex != NULL) EMP_LockRelease(xthread->mutex);
+    if (index >= xthread->end) break;
+
+    /* do the work -- the roots of the group in file order */
+    for (k = xthread->first[index]; k < xthread->first[index+1]; k++) {
+      r      = xthread->order[k];
+      nshape = rReader.NbShapes();
+      xthread->ok[r] = rReader.TransferRoot(r+1) ? 1 : 0;
+      for (i = nshape+1; i <= rReader.NbShapes(); i++)
+        xthread->shapes[r].Append(rReader.Shape(i));
+
+      /* names -- as EG_stepNames would find them */
+      for (i = 1; i <= xthread->shapes[r].Length(); i++) {
+        m = EG_stepRootNames(TR, xthread->shapes[r](i), &rlabels);
+        if (m == 0) continue;
+        if (xthread->labels[r] == NULL) {
+          xthread->labels[r] = rlabels;
+          xthread->nlabel[r] = m;
+          continue;
+        }
+        egadsLabel *tlabels = new egadsLabel[xthread->nlabel[r]+m];
+        for (j = 0; j < xthread->nlabel[r]; j++) {
+          tlabels[j].shape     = xthread->labels[r][j].shape;
+          tlabels[j].shapeName = xthread->labels[r][j].shapeName;
+        }
+        for (j = 0; j < m; j++) {
+          tlabels[xthread->nlabel[r]+j].shape     = rlabels[j].shape;
+          tlabels[xthread->nlabel[r]+j].shapeName = rlabels[j].shapeName;
+        }
+        delete [] xthread->labels[r];
+        delete [] rlabels;
+        xthread->labels[r]  = tlabels;
+        xthread->nlabel[r] += m;
+      }
+    }
+  }
+
+  /* exhausted all work -- exit */
+  if (ID != xthread->master) EMP_ThreadExit();
+}
+
+
+/* transfer independent roots concurrently in separate work sessions */
+static int
+EG_stepTransfer(int outLevel, STEPControl_Reader& aReader, int nroot,
+                TopTools_SequenceOfShape& shapes, egadsLabel **labels,
+                int *nas)
+{
+  int                      i, j, np, ngroup, *group, *first, *order, *ok;
+  int                      *nlabel;
+  long                     start;
+  void                     **threads = NULL;
+  egadsLabel               **rlabels;
+  TopTools_SequenceOfShape *rshapes;
+  STEPControl_Reader       *readers;
+  EMPxfer                  xthread;
+
+  *labels = NULL;
+  *nas    = 0;
+  group   = (int *) EG_alloc((4*nroot+1)*sizeof(int));
+  if (group == NULL) return EGADS_MALLOC;
+  first   = &group[  nroot];
+  order   = &group[2*nroot+1];
+  ok      = &group[3*nroot+1];
+  ngroup  = EG_stepGroups(aReader, nroot, group);
+  if (ngroup < 0) {
+    EG_free(group);
+    return ngroup;
+  }
+  if (outLevel > 1)
+    printf(" EGADS Info: %d STEP Roots in %d independent groups\n",
+           nroot, ngroup);
+  if (ngroup < 2) {
+    EG_free(group);
+    return EGADS_NOTFOUND;
+  }
+
+  /* order the roots by group (groups by first root) -- roots stay sorted */
+  for (i = 0; i < nroot; i++) first[i] = -1;
+  for (j = i = 0; i < nroot; i++)
+    if (group[i] == i) first[i] = j++;
+  for (i = 0; i < nroot; i++) ok[i] = first[group[i]];
+  for (i = 0; i <= ngroup; i++) first[i] = 0;
+  for (i = 0; i < nroot; i++) first[ok[i]+1]++;
+  for (i = 0; i < ngroup; i++) first[i+1] += first[i];
+  for (i = 0; i < nroot; i++) {
+    order[first[ok[i]]] = i;
+    first[ok[i]]++;
+  }
+  for (i = ngroup; i > 0; i--) first[i] = first[i-1];
+  first[0] = 0;
+
+  np = EMP_Init(&start);
+  if (outLevel > 1) printf(" EMP NumProcs = %d!\n", np);
+  if (ngroup < np) np = ngroup;
+
+  /* the work sessions share the parsed model -- made here, not in threads */
+  readers = new STEPControl_Reader[np];
+  for (i = 0; i < np; i++) {
+    readers[i].WS()->SetModel(aReader.WS()->Model());
+    if (readers[i].NbRootsForTransfer() != nroot) {
+      if (outLevel > 0)
+        printf(" EGADS Warning: Work Session %d sees %d Roots (EG_loadModel)!\n",
+               i+1, readers[i].NbRootsForTransfer());
+      delete [] readers;
+      EG_free(group);
+      return EGADS_NOTFOUND;
+    }
+  }
+
+  nlabel  = (int *)         EG_alloc(nroot*sizeof(int));
+  rlabels = (egadsLabel **) EG_alloc(nroot*sizeof(egadsLabel *));
+  if ((nlabel == NULL) || (rlabels == NULL)) {
+    if (rlabels != NULL) EG_free(rlabels);
+    if (nlabel  != NULL) EG_free(nlabel);
+    delete [] readers;
+    EG_free(group);
+    return EGADS_MALLOC;
+  }
+  rshapes = new TopTools_SequenceOfShape[nroot];
+  for (i = 0; i < nroot; i++) {
+    ok[i]      = 0;
+    nlabel[i]  = 0;
+    rlabels[i] = NULL;
+  }
+
+  /* set up for explicit multithreading -- each group on its own */
+  xthread.mutex   = NULL;
+  xthread.master  = EMP_ThreadID();
+  xthread.index   = 0;
+  xthread.end     = ngroup;
+  xthread.slot    = 0;
+  xthread.first   = first;
+  xthread.order   = order;
+  xthread.ok      = ok;
+  xthread.nlabel  = nlabel;
+  xthread.labels  = rlabels;
+  xthread.shapes  = rshapes;
+  xthread.readers = readers;
+
+  if (np > 1) {
+    /* create the mutex to handle list synchronization */
+    xthread.mutex = EMP_LockCreate();
+    if (xthread.mutex == NULL) {
+      printf(" EMP Error: mutex creation = NULL!\n");
+      np = 1;
+    } else {
+      /* get storage for our extra threads */
+      threads = (void **) malloc((np-1)*sizeof(void *));
+      if (threads == NULL) {
+        EMP_LockDestroy(xthread.mutex);
+        xthread.mutex = NULL;
+        np = 1;
+      }
+    }
+  }
+
+  /* create the threads and get going! */
+  if (threads != NULL)
+    for (i = 0; i < np-1; i++) {
+      threads[i] = EMP_ThreadCreate(EG_stepXferThread, &xthread);
+      if (threads[i] == NULL)
+        printf(" EMP Error Creating Thread #%d!\n", i+1);
+    }
+  /* now run the thread block from the original thread */
+  EG_stepXferThread(&xthread);
+
+  /* wait for all others to return */
+  if (threads != NULL)
+    for (i = 0; i < np-1; i++)
+      if (threads[i] != NULL) EMP_ThreadWait(threads[i]);
+
+  /* cleanup */
+  if (threads != NULL)
+    for (i = 0; i < np-1; i++)
+      if (threads[i] != NULL) EMP_ThreadDestroy(threads[i]);
+  if (xthread.mutex != NULL) EMP_LockDestroy(xthread.mutex);
+  if (threads != NULL) free(threads);
+  if (outLevel > 1)
+    printf(" EMP Number of Seconds on Transfer Thread Block = %ld\n",
+           EMP_Done(&start));
+
+  /* merge in root order -- as the serial transfers would have them */
+  for (i = 0; i < nroot; i++) {
+    if ((ok[i] == 0) && (outLevel > 0))
+      printf(" EGADS Warning: Transfer %d/%d is not OK!\n", i+1, nroot);
+    for (j = 1; j <= rshapes[i].Length(); j++) shapes.Append(rshapes[i](j));
+  }
+  *nas = EG_mergeLabels(nroot, nlabel, rlabels, labels);
+
+  delete [] rshapes;
+  delete [] readers;
+  EG_free(rlabels);
+  EG_free(nlabel);
+  EG_free(group);
+  return EGADS_SUCCESS;
+}
+
+
+#endif
+
+
+static void
+EG_nameTopos(TopTools_IndexedMapOfShape& lmap, const int *lname,
+             const egadsLabel *labels, egadsMap& tmap)
+{
+  int i, k;
+
+  for (i = 1; i <= tmap.map.Extent(); i++) {
+    k = lmap.FindIndex(tmap.map(i));
+    if (k == 0) continue;
+    EG_attributeAdd(tmap.objs[i-1], "Name", ATTRSTRING, 1, NULL, NULL,
+                    labels[lname[k-1]].shapeName);
+  }
+}
+
+
+static void
+EG_nameAttrs(egadsModel *mshape, int nas, const egadsLabel *labels)
+{
+  int i, k, ibody, *lname;
+
+  /* hash the named shapes -- the last name of a shape wins */
+  lname = (int *) EG_alloc(nas*sizeof(int));
+  if (lname == NULL) return;
+  TopTools_IndexedMapOfShape lmap;
+  for (i = 0; i < nas; i++) {
+    if (labels[i].shapeName == NULL) continue;
+    k = lmap.Add(labels[i].shape);
+    lname[k-1] = i;
+  }
+
+  /* a single sweep over the Body maps */
+  if (lmap.Extent() != 0)
+    for (ibody = 0; ibody < mshape->nbody; ibody++) {
+      egObject  *pobj  = mshape->bodies[ibody];
+      egadsBody *pbody = (egadsBody *) pobj->blind;
+      k = lmap.FindIndex(pbody->shape);
+      if (k != 0)
+        if (labels[lname[k-1]].shape.IsSame(pbody->shape))
+          EG_attributeAdd(pobj, "Name", ATTRSTRING, 1, NULL, NULL,
+                          labels[lname[k-1]].shapeName);
+      EG_nameTopos(lmap, lname, labels, pbody->nodes);
+      EG_nameTopos(lmap, lname, labels, pbody->edges);
+      EG_nameTopos(lmap, lname, labels, pbody->loops);
+      EG_nameTopos(lmap, lname, labels, pbody->faces);
+      EG_nameTopos(lmap, lname, labels, pbody->shells);
+    }
+  EG_free(lname);
+}
+
+
 int
 EG_loadModel(egObject *context, int bflg, const char *name, egObject **model)
 {
@@ -943,6 +1459,15 @@ EG_loadModel(egObject *context, int bflg, const char *name, egObject **model)
 
     /* STEP files */
 
+#if CASVER < 780
+    /* the concurrent transfers need the per-transfer unit factors of 7.8 */
+    if ((bflg&32) != 0) {
+      if (outLevel > 0)
+        printf(" EGADS Error: bflg 32 needs OpenCASCADE 7.8 (EG_loadModel)!\n");
+      return EGADS_RANGERR;
+    }
+#endif
+
     STEPControl_Reader aReader;
     IFSelect_ReturnStatus status = aReader.ReadFile(name);
     if (status != IFSelect_RetDone) {
@@ -972,13 +1497,30 @@ EG_loadModel(egObject *context, int bflg, const char *name, egObject **model)
     if (outLevel > 1)
       printf(" EGADS Info: %s Entries = %d\n", name, nroot);
 
-    for (i = 1; i <= nroot; i++) {
-      Standard_Boolean ok = aReader.TransferRoot(i);
-      if ((!ok) && (outLevel > 0))
-        printf(" EGADS Warning: Transfer %d/%d is not OK!\n", i, nroot);
+    // concurrent transfers of the independent roots (if asked for)
+    TopTools_SequenceOfShape shapes;
+    stat = EGADS_NOTFOUND;
+#if CASVER >= 780
+    if (((bflg&32) != 0) && (nroot > 1)) {
+      stat = EG_stepTransfer(outLevel, aReader, nroot, shapes, &labels, &nas);
+      if ((stat != EGADS_SUCCESS) && (outLevel > 1))
+        printf(" EGADS Info: EG_stepTransfer = %d -- serial (EG_loadModel)\n",
+               stat);
+    }
+#endif
+    if (stat != EGADS_SUCCESS) {
+      for (i = 1; i <= nroot; i++) {
+        Standard_Boolean ok = aReader.TransferRoot(i);
+        if ((!ok) && (outLevel > 0))
+          printf(" EGADS Warning: Transfer %d/%d is not OK!\n", i, nroot);
+      }
+      for (i = 1; i <= aReader.NbShapes(); i++) shapes.Append(aReader.Shape(i));
+
+      // collect the name attributes
+      nas = EG_stepNames(aReader, &labels);
     }
 
-    nbs = aReader.NbShapes();
+    nbs = shapes.Length();
     if (nbs <= 0) {
       if (outLevel > 0)
         printf(" EGADS Error: %s has No Shapes (EG_loadModel)!\n", 
@@ -988,71 +1530,20 @@ EG_loadModel(egObject *context, int bflg, const char *name, egObject **model)
     if (outLevel > 1)    
       printf(" EGADS Info: %s has %d Shape(s)\n", name, nbs);
 
+#ifdef STEPASSATTRS
     const Handle(XSControl_WorkSession)& workSession = aReader.WS();
     const Handle(XSControl_TransferReader)& TR = workSession->TransferReader();
-#ifdef STEPASSATTRS
     Handle(Standard_Type) tNAUO = STANDARD_TYPE(
                                        StepRepr_NextAssemblyUsageOccurrence);
     Handle(Standard_Type) tPD   = STANDARD_TYPE(StepBasic_ProductDefinition);
 #endif
-    // count the name attributes
-    nas = 0;
-    for (i = 1; i <= nbs; i++) {
-      TopoDS_Shape aShape = aReader.Shape(i);
-      TopTools_IndexedMapOfShape MapAll;
-      TopExp::MapShapes(aShape, MapAll);
-      for (int j = 1; j <= MapAll.Extent(); j++) {
-        TopoDS_Shape aShape = MapAll(j);
-        Handle(Standard_Transient) ent = TR->EntityFromShapeResult(aShape, 1);
-        if (ent.IsNull())          ent = TR->EntityFromShapeResult(aShape,-1);
-        if (ent.IsNull())          ent = TR->EntityFromShapeResult(aShape, 4);
-        if (ent.IsNull())          continue;
-        Handle(StepRepr_RepresentationItem) aReprItem;
-        aReprItem = Handle(StepRepr_RepresentationItem)::DownCast(ent);
-        if (aReprItem.IsNull())    continue;
-        const char *STEPname = aReprItem->Name()->ToCString();
-        if (STEPname == NULL)      continue;
-        if (strlen(STEPname) == 0) continue;
-        nas++;
-      }
-    }
-    if (nas != 0) {
-      printf("  Number of Name Attrs Found = %d\n", nas);
-      labels = new egadsLabel[nas];
-      for (i = 0; i < nas; i++) {
-        labels[i].shape.Nullify();
-        labels[i].shapeName = NULL;
-      }
-    }
+    if (nas != 0) printf("  Number of Name Attrs Found = %d\n", nas);
 
     TopoDS_Compound compound;
     BRep_Builder    builder3D;
     builder3D.MakeCompound(compound);
-    nas = 0;
     for (i = 1; i <= nbs; i++) {
-      TopoDS_Shape aShape = aReader.Shape(i);
-      if (labels != NULL) {
-        TopTools_IndexedMapOfShape MapAll;
-        TopExp::MapShapes(aShape, MapAll);
-        for (int j = 1; j <= MapAll.Extent(); j++) {
-          TopoDS_Shape aShape = MapAll(j);
-          Handle(Standard_Transient) ent = TR->EntityFromShapeResult(aShape, 1);
-          if (ent.IsNull())          ent = TR->EntityFromShapeResult(aShape,-1);
-          if (ent.IsNull())          ent = TR->EntityFromShapeResult(aShape, 4);
-          if (ent.IsNull())          continue;
-          Handle(StepRepr_RepresentationItem) aReprItem;
-          aReprItem = Handle(StepRepr_RepresentationItem)::DownCast(ent);
-          if (aReprItem.IsNull())    continue;
-          const char *STEPname = aReprItem->Name()->ToCString();
-          if (STEPname == NULL)      continue;
-          if (strlen(STEPname) == 0) continue;
-          labels[nas].shape     = aShape;
-          labels[nas].shapeName = EG_strdup(STEPname);
-          nas++;
-  /*      printf(" %d/%d %s -> Name found: %s\n", j, MapAll.Extent(),
-                 TopAbs::ShapeTypeToString(aShape.ShapeType()), STEPname);  */
-        }
-      }
+      TopoDS_Shape aShape = shapes(i);
 #ifdef STEPASSATTRS
       Handle(Standard_Transient) ent = TR->EntityFromShapeResult(aShape, 3);
       if (!ent.IsNull()) {
@@ -1692,33 +2183,9 @@ EG_loadModel(egObject *context, int bflg, const char *name, egObject **model)
   
   /* possibly assign attributes from IGES/STEP read */
   if (labels != NULL) {
-    for (i = 0; i < nas; i++) {
-      if (labels[i].shapeName == NULL) continue;
-      char *value = labels[i].shapeName;
-/*    printf(" Shape %2d: %s\n", i+1, value);  */
-      for (int ibody = 0; ibody < mshape->nbody; ibody++) {
-        egObject  *pobj   = mshape->bodies[ibody];
-        egadsBody *pbody  = (egadsBody *) pobj->blind;
-        if (pbody->shape == labels[i].shape)
-          EG_attributeAdd(pobj, "Name", ATTRSTRING, 1, NULL, NULL, value);
-        j = pbody->nodes.map.FindIndex(labels[i].shape);
-        if (j != 0) EG_attributeAdd(pbody->nodes.objs[j-1],  "Name", ATTRSTRING,
-                                    1, NULL, NULL, value);
-        j = pbody->edges.map.FindIndex(labels[i].shape);
-        if (j != 0) EG_attributeAdd(pbody->edges.objs[j-1],  "Name", ATTRSTRING,
-                                    1, NULL, NULL, value);
-        j = pbody->loops.map.FindIndex(labels[i].shape);
-        if (j != 0) EG_attributeAdd(pbody->loops.objs[j-1],  "Name", ATTRSTRING,
-                                    1, NULL, NULL, value);
-        j = pbody->faces.map.FindIndex(labels[i].shape);
-        if (j != 0) EG_attributeAdd(pbody->faces.objs[j-1],  "Name", ATTRSTRING,
-                                    1, NULL, NULL, value);
-        j = pbody->shells.map.FindIndex(labels[i].shape);
-        if (j != 0) EG_attributeAdd(pbody->shells.objs[j-1], "Name", ATTRSTRING,
-                                    1, NULL, NULL, value);
-      }
-      EG_free(value);
-    }
+    EG_nameAttrs(mshape, nas, labels);
+    for (i = 0; i < nas; i++)
+      if (labels[i].shapeName != NULL) EG_free(labels[i].shapeName);
     delete [] labels;
   }
   if (invalid != NULL) EG_free(invalid);
@@ -69,6 +69,9 @@ __ProtoExt__ int  EG_attributeXDup( const egObject *src,
                                     /*@null@*/ const double *xform,
                                           egObject *dst );
 __ProtoExt__ int  EG_attributePrint( const egObject *src );
+__ProtoExt__ int  EG_attrUnshare( egObject *obj );
+__ProtoExt__ /*@null@*/ char *
+                  EG_attrName( const egObject *obj, const char *name );
 
 #ifdef __cplusplus
 }
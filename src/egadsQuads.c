@@ -17,7 +17,8 @@
 #include "egadsInternals.h"
 
 
-#define MAXSIDE 2049
+#define MAXSIDE   2049
+#define SMOOTHTOL 1.e-8         /* relative displacement ending the passes */
 
 #define AREA2D(a,b,c)   ((a[0]-c[0])*(b[1]-c[1]) -  (a[1]-c[1])*(b[0]-c[0]))
 #define CROSS(a,b,c)      a[0] = (b[1]*c[2]) - (b[2]*c[1]);\
@@ -400,7 +401,8 @@ EG_smoothQuads(const egObject *face, qFill *q, int len, int npass)
 {
   int           i, j, i0, i1, i2, i3, status, pass;
   double        qarea, sum, big, delta1 = 0, sums[2], x1[3], x2[3], xn[3];
-  double        tAreaUV, tAreaXYZ, holdArea, results[18];
+  double        tAreaUV, tAreaXYZ, holdArea, results[18], wUV, moved, uvtol;
+  double        uvbox[4], *wxyz, *uv0;
   Node          *verts;
   static double wXYZ = 0.75;
 
@@ -473,22 +475,48 @@ EG_smoothQuads(const egObject *face, qFill *q, int len, int npass)
     }
   }
 
+  if (q->nquad == 0) return;
+
+  /* the xyz weights are fixed within a pass -- hold them per Quad */
+  wxyz = (double *) EG_alloc((q->nquad+2*q->nvert)*sizeof(double));
+  if (wxyz == NULL) {
+    if (q->outLevel > 0)
+      printf(" EGADS Info: Malloc on %d Quads (EG_smoothQuad)!\n", q->nquad);
+    return;
+  }
+  uv0 = &wxyz[q->nquad];
+
+  /* displacement tolerance for stopping the passes early */
+  uvbox[0] = uvbox[1] = verts[0].uv[0];
+  uvbox[2] = uvbox[3] = verts[0].uv[1];
+  for (j = 1; j < q->nvert; j++) {
+    if (verts[j].uv[0] < uvbox[0]) uvbox[0] = verts[j].uv[0];
+    if (verts[j].uv[0] > uvbox[1]) uvbox[1] = verts[j].uv[0];
+    if (verts[j].uv[1] < uvbox[2]) uvbox[2] = verts[j].uv[1];
+    if (verts[j].uv[1] > uvbox[3]) uvbox[3] = verts[j].uv[1];
+  }
+  uvtol = SMOOTHTOL*MAX(uvbox[1]-uvbox[0], uvbox[3]-uvbox[2]);
+
   /* pseudo non-linear loop */
 
   for (pass = 0; pass < npass; pass++) {
 
-    /* get xyz */
+    /* get xyz -- boundary vertices do not move after the first pass */
     for (j = 0; j < q->nvert; j++) {
+      if ((pass != 0) && (verts[j].area < 0.0)) continue;
       status = EG_evaluate(face, verts[j].uv, results);
       if (status != EGADS_SUCCESS) {
         if (q->outLevel > 0)
           printf(" EGADS Info: EG_evaluate = %d (EG_smoothQuad)!\n", 
                  status);
+        EG_free(wxyz);
         return;
       }
       verts[j].xyz[0] = results[0];
       verts[j].xyz[1] = results[1];
       verts[j].xyz[2] = results[2];
+      uv0[2*j  ]      = verts[j].uv[0];
+      uv0[2*j+1]      = verts[j].uv[1];
     }
 
     tAreaUV = tAreaXYZ = 0.0;
@@ -508,20 +536,19 @@ EG_smoothQuads(const egObject *face, qFill *q, int len, int npass)
       x1[2]     = verts[i1].xyz[2] - verts[i0].xyz[2];
       x2[2]     = verts[i2].xyz[2] - verts[i0].xyz[2];
       CROSS(xn, x1, x2);
-      holdArea  = DOT(xn, xn);
-      if (holdArea <  0.0) holdArea = -holdArea;
-      tAreaXYZ += holdArea;
+      wxyz[j]   = DOT(xn, xn);
       x1[0]     = verts[i3].xyz[0] - verts[i0].xyz[0];
       x1[1]     = verts[i3].xyz[1] - verts[i0].xyz[1];
       x1[2]     = verts[i3].xyz[2] - verts[i0].xyz[2];
       CROSS(xn, x2, x1);
-      holdArea  = DOT(xn, xn);
-      if (holdArea <  0.0) holdArea = -holdArea;
-      tAreaXYZ += holdArea;
+      wxyz[j]  += DOT(xn, xn);
+      tAreaXYZ += wxyz[j];
     }
 #ifdef DEBUG
     printf(" ** %d   Areas = %le  %le **\n", pass, tAreaUV, tAreaXYZ);
 #endif
+    wUV = (1.0-wXYZ)/tAreaUV;
+    for (j = 0; j < q->nquad; j++) wxyz[j] *= wXYZ/tAreaXYZ;
 
     /* outer iteration -- pass 2 (mix) */
     for (i = 0; i < len; i++) {
@@ -545,25 +572,7 @@ EG_smoothQuads(const egObject *face, qFill *q, int len, int npass)
           printf(" Quad %d: Neg Area = %le\n", j, qarea);
 #endif
         }
-        qarea *= (1.0-wXYZ)/tAreaUV;
-
-        x1[0]     = verts[i1].xyz[0] - verts[i0].xyz[0];
-        x2[0]     = verts[i2].xyz[0] - verts[i0].xyz[0];
-        x1[1]     = verts[i1].xyz[1] - verts[i0].xyz[1];
-        x2[1]     = verts[i2].xyz[1] - verts[i0].xyz[1];
-        x1[2]     = verts[i1].xyz[2] - verts[i0].xyz[2];
-        x2[2]     = verts[i2].xyz[2] - verts[i0].xyz[2];
-        CROSS(xn, x1, x2);
-        holdArea  = DOT(xn, xn);
-        if (holdArea <  0.0) holdArea = -holdArea;
-        qarea    += holdArea*wXYZ/tAreaXYZ;
-        x1[0]     = verts[i3].xyz[0] - verts[i0].xyz[0];
-        x1[1]     = verts[i3].xyz[1] - verts[i0].xyz[1];
-        x1[2]     = verts[i3].xyz[2] - verts[i0].xyz[2];
-        CROSS(xn, x2, x1);
-        holdArea  = DOT(xn, xn);
-        if (holdArea <  0.0) holdArea = -holdArea;
-        qarea    += holdArea*wXYZ/tAreaXYZ;
+        qarea = qarea*wUV + wxyz[j];
 
         sum = qarea*(verts[i0].uv[0] + verts[i1].uv[0] + verts[i2].uv[0] +
                      verts[i3].uv[0])/4.0;
@@ -604,8 +613,19 @@ EG_smoothQuads(const egObject *face, qFill *q, int len, int npass)
       }
     }
 
+    /* nothing moved enough to change the xyz weights -- converged */
+    moved = 0.0;
+    for (j = 0; j < q->nvert; j++) {
+      if (verts[j].area <= 0.0) continue;
+      sum = fabs(verts[j].uv[0] - uv0[2*j  ]);
+      if (moved < sum) moved = sum;
+      sum = fabs(verts[j].uv[1] - uv0[2*j+1]);
+      if (moved < sum) moved = sum;
+    }
+    if (moved <= uvtol) break;
   }
 
+  EG_free(wxyz);
 }
 
 
@@ -557,6 +557,74 @@ __HOST_AND_DEVICE__ REAL EG_orienTri(REAL *pa, REAL *pb, REAL *pc)
 }
 
 
+/* Batched form of EG_orienTri for many query points against one segment.
+ *   iq is the slot (0-pa, 1-pb or 2-pc) taken by the n points in pq (the
+ *   pointer passed for that slot is not used). The stage-A filter is run
+ *   branch free over a block of points so that it vectorizes; only points
+ *   that it cannot certify are passed to EG_orienTri, so the determinants
+ *   are bit-identical to the pointwise calls. Returns the number of points
+ *   that were not certified by the filter.                                 */
+
+#define ORIENTBLOCK 64
+
+__HOST_AND_DEVICE__ int
+EG_orienTriBatch(REAL *pa, REAL *pb, REAL *pc, int iq, int n, REAL *pq,
+                 REAL *dets)
+{
+  int  i, j, m, nadapt;
+  REAL acx, acy, bcx, bcy, detleft, detright, *q[3];
+  REAL errbound[ORIENTBLOCK];
+
+  acx = acy = bcx = bcy = 0.0;
+  if (iq == 0) {
+    bcx = pb[0] - pc[0];
+    bcy = pb[1] - pc[1];
+  } else if (iq == 1) {
+    acx = pa[0] - pc[0];
+    acy = pa[1] - pc[1];
+  }
+  q[0] = pa;
+  q[1] = pb;
+  q[2] = pc;
+
+  for (nadapt = j = 0; j < n; j += ORIENTBLOCK) {
+    m = n - j;
+    if (m > ORIENTBLOCK) m = ORIENTBLOCK;
+    if (iq == 0) {
+      for (i = 0; i < m; i++) {
+        detleft     = (pq[2*(i+j)  ] - pc[0]) * bcy;
+        detright    = (pq[2*(i+j)+1] - pc[1]) * bcx;
+        dets[i+j]   = detleft - detright;
+        errbound[i] = Absolute(detleft) + Absolute(detright);
+      }
+    } else if (iq == 1) {
+      for (i = 0; i < m; i++) {
+        detleft     = acx * (pq[2*(i+j)+1] - pc[1]);
+        detright    = acy * (pq[2*(i+j)  ] - pc[0]);
+        dets[i+j]   = detleft - detright;
+        errbound[i] = Absolute(detleft) + Absolute(detright);
+      }
+    } else {
+      for (i = 0; i < m; i++) {
+        detleft     = (pa[0] - pq[2*(i+j)  ]) * (pb[1] - pq[2*(i+j)+1]);
+        detright    = (pa[1] - pq[2*(i+j)+1]) * (pb[0] - pq[2*(i+j)  ]);
+        dets[i+j]   = detleft - detright;
+        errbound[i] = Absolute(detleft) + Absolute(detright);
+      }
+    }
+    /* anything the filter rejects is redone by the adaptive predicate */
+    for (i = 0; i < m; i++) {
+      if (Absolute(dets[i+j]) >= ccwerrboundA*errbound[i]) continue;
+      q[iq]     = &pq[2*(i+j)];
+      dets[i+j] = EG_orienTri(q[0], q[1], q[2]);
+      nadapt++;
+    }
+  }
+
+  return nadapt;
+}
+
+
 __HOST_AND_DEVICE__ static REAL
 orient3dadapt(REAL *pa, REAL *pb, REAL *pc, REAL *pd, REAL permanent)
 {
@@ -16,6 +16,7 @@
 #include "egadsTypes.h"
 #include "egadsInternals.h"
 #include "egadsStack.h"
+#include "emp.h"
 
 
 //#define DEBUG
@@ -75,6 +76,29 @@
     egObject **ents;
   } splitEnts;
 
+  typedef struct {
+    int      ndiv;              /* maximum divisions in each direction */
+    int      nx;                /* number of cells in U */
+    int      ny;                /* number of cells in V */
+    int      *head;             /* first endpoint in each cell or -1 */
+    int      *next;             /* next endpoint in the same cell or -1 */
+    double   box[2];            /* lower UV of the grid */
+    double   size[2];           /* cell size in U & V -- never below tol */
+  } endGrid;
+
+  typedef struct {
+    int      iFace;             /* Face index (bias 0) */
+    int      iSeg;              /* start of the Face's cuts in fe */
+    int      nEdge;             /* number of Edges to connect */
+    int      nLoop;             /* number of Loops found */
+    int      stat;              /* status from ordering the Loops */
+    int      *senses;           /* Edge senses */
+    int      *order;            /* Edge indices in Loop order */
+    int      *lcnt;             /* number of Edges in each Loop */
+    egObject **edges;           /* the Edges to be connected */
+    egObject **pcurves;         /* the PCurves or NULL for Planes */
+  } faceTrace;
+
 
   extern int  EG_getBody( const egObject *obj, egObject **body );
   extern int  EG_outLevel( const egObject *object );
@@ -282,28 +306,84 @@ EG_angleEdges(int fsense, double *dir1, double *dir2)
 
 
 static int
-EG_matchEndpts(int nEdges, edgeLoop *el, int n, double *uv, double tol)
+EG_gridCell(const endGrid *grid, int dir, double uv)
 {
-  int    i, m;
-  double dist;
-  
-  for (m = i = 0; i < nEdges; i++) {
-    if (el[i].connect[0] == -1) {
-      dist = sqrt((uv[0]-el[i].uvs[0][0])*(uv[0]-el[i].uvs[0][0]) +
-                  (uv[1]-el[i].uvs[0][1])*(uv[1]-el[i].uvs[0][1]));
-      if (dist < tol) {
-        el[i].connect[0] = n;
-        m++;
-/*      printf(" distance = %le (%le)\n", dist, tol);  */
-      }
+  int i, n;
+
+  n = (dir == 0) ? grid->nx : grid->ny;
+  i = (uv - grid->box[dir])/grid->size[dir];
+  if (i <  0) i = 0;
+  if (i >= n) i = n-1;
+
+  return i;
+}
+
+
+static void
+EG_fillGrid(int nEdges, edgeLoop *el, double tol, endGrid *grid)
+{
+  int    i, j, k, ix, iy;
+  double umax, vmax, cmin;
+
+  grid->box[0] = umax = el[0].uvs[0][0];
+  grid->box[1] = vmax = el[0].uvs[0][1];
+  for (i = 0; i < nEdges; i++)
+    for (j = 0; j < 2; j++) {
+      if (el[i].uvs[j][0] < grid->box[0]) grid->box[0] = el[i].uvs[j][0];
+      if (el[i].uvs[j][0] > umax)         umax         = el[i].uvs[j][0];
+      if (el[i].uvs[j][1] < grid->box[1]) grid->box[1] = el[i].uvs[j][1];
+      if (el[i].uvs[j][1] > vmax)         vmax         = el[i].uvs[j][1];
     }
-    if (el[i].connect[1] == -1) {
-      dist = sqrt((uv[0]-el[i].uvs[1][0])*(uv[0]-el[i].uvs[1][0]) +
-                  (uv[1]-el[i].uvs[1][1])*(uv[1]-el[i].uvs[1][1]));
-      if (dist < tol) {
-        el[i].connect[1] = n;
-        m++;
-/*      printf(" distance = %le (%le)\n", dist, tol);  */
+
+  /* cells are never smaller than tol -- matches are in neighboring cells;
+     a zero tol falls back to a small fraction of the box (or 1 if the end
+     points all coincide) so that the cells are never empty in size */
+  cmin = umax - grid->box[0];
+  if (vmax - grid->box[1] > cmin) cmin = vmax - grid->box[1];
+  cmin *= 1.e-8;
+  if (tol  > cmin) cmin = tol;
+  if (cmin <= 0.0) cmin = 1.0;
+  grid->size[0] = (umax - grid->box[0])/grid->ndiv;
+  grid->size[1] = (vmax - grid->box[1])/grid->ndiv;
+  if (grid->size[0] < cmin) grid->size[0] = cmin;
+  if (grid->size[1] < cmin) grid->size[1] = cmin;
+  grid->nx = (umax - grid->box[0])/grid->size[0] + 1;
+  grid->ny = (vmax - grid->box[1])/grid->size[1] + 1;
+  if (grid->nx > grid->ndiv+1) grid->nx = grid->ndiv+1;
+  if (grid->ny > grid->ndiv+1) grid->ny = grid->ndiv+1;
+
+  for (i = 0; i < grid->nx*grid->ny; i++) grid->head[i] = -1;
+  for (k = 2*nEdges-1; k >= 0; k--) {
+    ix = EG_gridCell(grid, 0, el[k/2].uvs[k%2][0]);
+    iy = EG_gridCell(grid, 1, el[k/2].uvs[k%2][1]);
+    grid->next[k]              = grid->head[iy*grid->nx+ix];
+    grid->head[iy*grid->nx+ix] = k;
+  }
+}
+
+
+static int
+EG_matchEndpts(edgeLoop *el, endGrid *grid, int n, double *uv, double tol)
+{
+  int    i, j, k, m, ix, iy, end;
+  double dist;
+
+  ix = EG_gridCell(grid, 0, uv[0]);
+  iy = EG_gridCell(grid, 1, uv[1]);
+  for (m = 0, j = iy-1; j <= iy+1; j++) {
+    if ((j < 0) || (j >= grid->ny)) continue;
+    for (i = ix-1; i <= ix+1; i++) {
+      if ((i < 0) || (i >= grid->nx)) continue;
+      for (k = grid->head[j*grid->nx+i]; k != -1; k = grid->next[k]) {
+        end = k%2;
+        if (el[k/2].connect[end] != -1) continue;
+        dist = sqrt((uv[0]-el[k/2].uvs[end][0])*(uv[0]-el[k/2].uvs[end][0]) +
+                    (uv[1]-el[k/2].uvs[end][1])*(uv[1]-el[k/2].uvs[end][1]));
+        if (dist < tol) {
+          el[k/2].connect[end] = n;
+          m++;
+/*        printf(" distance = %le (%le)\n", dist, tol);  */
+        }
       }
     }
   }
@@ -374,42 +454,41 @@ EG_adjustPeriod(double *param, double *range, double *srange, int sper)
 }
 
 static int
-EG_traceLoops(egObject *context, const egObject *face, int nEdges,
-              egObject **edges, int *senses, /*@null@*/ egObject **pcurves,
-              int *nLoops, egObject ***loops)
+EG_orderLoops(const egObject *face, int nEdges, egObject **edges, int *senses,
+              /*@null@*/ egObject **pcurves, int *nLoops, int *lcnt,
+              int *order)
 {
-  int      i, n, cnt, oclass, mtype, stat, fsense, outLevel, first, next, nNode;
-  int      j0, j1, sper, *sens, *sen, *ints;
+  int      i, j, m, n, cnt, oclass, mtype, stat, fsense, first, next, nNode;
+  int      j0, j1, sper, nPts, start, *sen, *ints, *bucket, *link;
   double   ang, angle, tol, range[4], srange[4], result[9], u[3], v[3], dir[2];
   double   frange[4], duv[4], uvs[2], uv[2], *pdata, *reals;
-  egObject *geom, *surf, *ref, *sref, **nodes, **objs, **list;
+  egObject *geom, *surf, *ref, *sref, **nodes;
   edgeLoop *el;
   nodeCnt  *nl;
+  endGrid  grid;
   
-  *nLoops  = 0;
-  *loops   = NULL;
-  el       = NULL;
-  objs     = NULL;
-  sens     = NULL;
-  outLevel = EG_outLevel(context);
+  *nLoops   = 0;
+  el        = NULL;
+  bucket    = NULL;
+  grid.head = NULL;
   
   /* look at Face */
   stat = EG_getTopology(face, &surf, &oclass, &fsense, frange, &n, &nodes,
                         &sen);
   if (stat != EGADS_SUCCESS) {
-    printf(" EGADS Error: Cannot get Face = %d (EG_traceLoops)!\n", stat);
+    printf(" EGADS Error: Cannot get Face = %d (EG_orderLoops)!\n", stat);
     return stat;
   }
   u[0] = u[1] = u[2] = 0.0;
   v[0] = v[1] = v[2] = 0.0;
   if (surf->mtype == PLANE) {
     if (pcurves != NULL) {
-      printf(" EGADS Error: Planar Surface with PCurves (EG_traceLoops)!\n");
+      printf(" EGADS Error: Planar Surface with PCurves (EG_orderLoops)!\n");
       return EGADS_TOPOERR;
     }
     stat = EG_getGeometry(surf, &oclass, &mtype, &ref, &sen, &pdata);
     if (stat != EGADS_SUCCESS) {
-      printf(" EGADS Error: Cannot get Plane = %d (EG_traceLoops)!\n", stat);
+      printf(" EGADS Error: Cannot get Plane = %d (EG_orderLoops)!\n", stat);
       return stat;
     }
     u[0] = pdata[3];
@@ -421,7 +500,7 @@ EG_traceLoops(egObject *context, const egObject *face, int nEdges,
     EG_free(pdata);
   } else {
     if (pcurves == NULL) {
-      printf(" EGADS Error: nonPlanar Surf without PCurves (EG_traceLoops)!\n");
+      printf(" EGADS Error: nonPlanar Surf without PCurves (EG_orderLoops)!\n");
       return EGADS_TOPOERR;
     }
   }
@@ -429,7 +508,7 @@ EG_traceLoops(egObject *context, const egObject *face, int nEdges,
   if (surf->mtype == TRIMMED) {
     stat = EG_getGeometry(surf, &oclass, &mtype, &sref, &ints, &reals);
     if (stat != EGADS_SUCCESS) {
-      printf(" EGADS Error: Cannot get Geometry = %d (EG_traceLoops)!\n", stat);
+      printf(" EGADS Error: Cannot get Geometry = %d (EG_orderLoops)!\n", stat);
       return stat;
     }
     if (ints != NULL) EG_free(ints);
@@ -437,7 +516,7 @@ EG_traceLoops(egObject *context, const egObject *face, int nEdges,
   }
   stat = EG_getRange(sref, srange, &sper);
   if (stat != EGADS_SUCCESS) {
-    printf(" EGADS Error: Cannot get Surf Range = %d (EG_traceLoops)!\n", stat);
+    printf(" EGADS Error: Cannot get Surf Range = %d (EG_orderLoops)!\n", stat);
     return stat;
   }
   
@@ -449,7 +528,7 @@ EG_traceLoops(egObject *context, const egObject *face, int nEdges,
     stat = EG_getTopology(edges[i], &geom, &oclass, &mtype, range, &n,
                           &nodes, &sen);
     if (stat != EGADS_SUCCESS) {
-      printf(" EGADS Error: Cannot get Edge %d = %d (EG_traceLoops)!\n",
+      printf(" EGADS Error: Cannot get Edge %d = %d (EG_orderLoops)!\n",
              i+1, stat);
       goto bail;
     }
@@ -467,7 +546,7 @@ EG_traceLoops(egObject *context, const egObject *face, int nEdges,
       if (pcurves != NULL) {
         stat = EG_evaluate(pcurves[i], &range[0], result);
         if (stat != EGADS_SUCCESS) {
-          printf(" EGADS Error: Cannot evaluate PCurve %d = %d (EG_traceLoops)!\n",
+          printf(" EGADS Error: Cannot evaluate PCurve %d = %d (EG_orderLoops)!\n",
                  i+1, stat);
           goto bail;
         }
@@ -479,7 +558,7 @@ EG_traceLoops(egObject *context, const egObject *face, int nEdges,
       } else {
         stat = EG_evaluate(edges[i], &range[0], result);
         if (stat != EGADS_SUCCESS) {
-          printf(" EGADS Error: Cannot evaluate Edge %d = %d (EG_traceLoops)!\n",
+          printf(" EGADS Error: Cannot evaluate Edge %d = %d (EG_orderLoops)!\n",
                  i+1, stat);
           goto bail;
         }
@@ -494,7 +573,7 @@ EG_traceLoops(egObject *context, const egObject *face, int nEdges,
       if (pcurves != NULL) {
         stat = EG_evaluate(pcurves[i], &range[1], result);
         if (stat != EGADS_SUCCESS) {
-          printf(" EGADS Error: Cannot evaluate PCurve %d = %d (EG_traceLoops)!\n",
+          printf(" EGADS Error: Cannot evaluate PCurve %d = %d (EG_orderLoops)!\n",
                  i+1, stat);
           goto bail;
         }
@@ -506,7 +585,7 @@ EG_traceLoops(egObject *context, const egObject *face, int nEdges,
       } else {
         stat = EG_evaluate(edges[i], &range[1], result);
         if (stat != EGADS_SUCCESS) {
-          printf(" EGADS Error: Cannot evaluate Edge %d = %d (EG_traceLoops)!\n",
+          printf(" EGADS Error: Cannot evaluate Edge %d = %d (EG_orderLoops)!\n",
                  i+1, stat);
           goto bail;
         }
@@ -525,7 +604,7 @@ EG_traceLoops(egObject *context, const egObject *face, int nEdges,
       if (pcurves != NULL) {
         stat = EG_evaluate(pcurves[i], &range[0], result);
         if (stat != EGADS_SUCCESS) {
-          printf(" EGADS Error: Cannot evaluate PCurve %d = %d (EG_traceLoops)!\n",
+          printf(" EGADS Error: Cannot evaluate PCurve %d = %d (EG_orderLoops)!\n",
                  i+1, stat);
           goto bail;
         }
@@ -537,7 +616,7 @@ EG_traceLoops(egObject *context, const egObject *face, int nEdges,
       } else {
         stat = EG_evaluate(edges[i], &range[0], result);
         if (stat != EGADS_SUCCESS) {
-          printf(" EGADS Error: Cannot evaluate Edge %d = %d (EG_traceLoops)!\n",
+          printf(" EGADS Error: Cannot evaluate Edge %d = %d (EG_orderLoops)!\n",
                  i+1, stat);
           goto bail;
         }
@@ -552,7 +631,7 @@ EG_traceLoops(egObject *context, const egObject *face, int nEdges,
       if (pcurves != NULL) {
         stat = EG_evaluate(pcurves[i], &range[1], result);
         if (stat != EGADS_SUCCESS) {
-          printf(" EGADS Error: Cannot evaluate PCurve %d = %d (EG_traceLoops)!\n",
+          printf(" EGADS Error: Cannot evaluate PCurve %d = %d (EG_orderLoops)!\n",
                  i+1, stat);
           goto bail;
         }
@@ -564,7 +643,7 @@ EG_traceLoops(egObject *context, const egObject *face, int nEdges,
       } else {
         stat = EG_evaluate(edges[i], &range[1], result);
         if (stat != EGADS_SUCCESS) {
-          printf(" EGADS Error: Cannot evaluate Edge %d = %d (EG_traceLoops)!\n",
+          printf(" EGADS Error: Cannot evaluate Edge %d = %d (EG_orderLoops)!\n",
                  i+1, stat);
           goto bail;
         }
@@ -581,7 +660,7 @@ EG_traceLoops(egObject *context, const egObject *face, int nEdges,
   /* figure out the uv tolerance for the existing Nodes */
   nl = (nodeCnt *) EG_alloc(2*nEdges*sizeof(nodeCnt));
   if (nl == NULL) {
-    printf(" EGADS Error: Cannot Malloc %d Nodes (EG_traceLoops)!\n", 2*nEdges);
+    printf(" EGADS Error: Cannot Malloc %d Nodes (EG_orderLoops)!\n", 2*nEdges);
     stat = EGADS_MALLOC;
     goto bail;
   }
@@ -665,11 +744,23 @@ EG_traceLoops(egObject *context, const egObject *face, int nEdges,
 #endif
   EG_free(nl);
   
+  /* hash the endpoints in uv -- the cells follow the tolerance */
+  grid.ndiv = sqrt(2.0*nEdges) + 1;
+  grid.head = (int *) EG_alloc(((grid.ndiv+1)*(grid.ndiv+1) + 2*nEdges)*
+                               sizeof(int));
+  if (grid.head == NULL) {
+    printf(" EGADS Error: Cannot Malloc %d Cells (EG_orderLoops)!\n",
+           (grid.ndiv+1)*(grid.ndiv+1));
+    stat = EGADS_MALLOC;
+    goto bail;
+  }
+  grid.next = &grid.head[(grid.ndiv+1)*(grid.ndiv+1)];
+  
   tol /= 10.0;
   cnt  = 0;
   do {
     if (cnt == 3) {
-      printf(" EGADS Error: Cannot match endPoints (EG_traceLoops)!\n");
+      printf(" EGADS Error: Cannot match endPoints (EG_orderLoops)!\n");
       for (i = 0; i < nEdges; i++) {
         printf(" Edge %d: start uv = [%lf,%lf],  end uv = [%lf,%lf]\n",
                i+1, el[i].uvs[0][0], el[i].uvs[0][1],
@@ -680,23 +771,25 @@ EG_traceLoops(egObject *context, const egObject *face, int nEdges,
     }
     for (i = 0; i < nEdges; i++) el[i].connect[0] = el[i].connect[1] = -1;
     tol *= 10.0;
+    EG_fillGrid(nEdges, el, tol, &grid);
     
     for (n = i = 0; i < nEdges; i++) {
       if (el[i].connect[0] == -1) {
         el[i].connect[0] = n;
-        stat = EG_matchEndpts(nEdges, el, n, el[i].uvs[0], tol);
+        stat = EG_matchEndpts(el, &grid, n, el[i].uvs[0], tol);
         if (stat != EGADS_SUCCESS) break;
         n++;
       }
       if (el[i].connect[1] == -1) {
         el[i].connect[1] = n;
-        stat = EG_matchEndpts(nEdges, el, n, el[i].uvs[1], tol);
+        stat = EG_matchEndpts(el, &grid, n, el[i].uvs[1], tol);
         if (stat != EGADS_SUCCESS) break;
         n++;
       }
     }
     cnt++;
   } while (i != nEdges);
+  nPts = n;
 #ifdef DEBUG
   for (i = 0; i < nEdges; i++) {
     printf(" Edge %d: %d start uv = [%lf,%lf],  %d end uv = [%lf,%lf]\n",
@@ -705,147 +798,169 @@ EG_traceLoops(egObject *context, const egObject *face, int nEdges,
   }
 #endif
   
-  objs = (egObject **) EG_alloc(2*nEdges*sizeof(egObject *));
-  if (objs == NULL) {
+  /* bucket the Edges by starting point (kept in Edge order) */
+  bucket = (int *) EG_alloc((nPts+nEdges)*sizeof(int));
+  if (bucket == NULL) {
     stat = EGADS_MALLOC;
     goto bail;
   }
-  sens = (int *) EG_alloc(nEdges*sizeof(int));
-  if (sens == NULL) {
-    stat = EGADS_MALLOC;
-    goto bail;
+  link = &bucket[nPts];
+  for (j = 0; j < nPts; j++) bucket[j] = -1;
+  for (i = nEdges-1; i >= 0; i--) {
+    link[i]                  = bucket[el[i].connect[0]];
+    bucket[el[i].connect[0]] = i;
   }
   
   /* connect the Edges to make Loops */
-  n = nEdges;
-  while (n != 0) {
-    for (i = 0; i < nEdges; i++)
-      if (el[i].edge != NULL) break;
-    first        = el[i].connect[0];
-    next         = el[i].connect[1];
-    dir[0]       = el[i].dir[1][0];
-    dir[1]       = el[i].dir[1][1];
-    sens[0]      = el[i].sense;
-    objs[0]      = el[i].edge;
-    objs[nEdges] = el[i].pcurve;
-    el[i].edge   = NULL;
-    n            = 1;
+  for (start = m = 0; m < nEdges; m += n) {
+    while (el[start].edge == NULL) start++;
+    i          = start;
+    first      = el[i].connect[0];
+    next       = el[i].connect[1];
+    dir[0]     = el[i].dir[1][0];
+    dir[1]     = el[i].dir[1][1];
+    order[m]   = i;
+    el[i].edge = NULL;
+    n          = 1;
 #ifdef DEBUG
     printf("  first   = %d  next = %d  n = %d  type = %d\n",
-           i, next, 0, objs[0]->mtype);
+           i, next, 0, edges[i]->mtype);
 #endif
     if (first != next) {
       do {
-        for (cnt = i = 0; i < nEdges; i++)
-          if ((el[i].connect[0] == next) && (el[i].edge != NULL)) cnt++;
+        for (cnt = 0, j = bucket[next]; j != -1; j = link[j])
+          if (el[j].edge != NULL) {
+            cnt++;
+            i = j;
+          }
         if (cnt == 0) {
-          printf(" EGADS Error: Open Loop (EG_traceLoops)!\n");
+          printf(" EGADS Error: Open Loop (EG_orderLoops)!\n");
           stat = EGADS_DEGEN;
           goto bail;
         }
-        if (cnt == 1) {
-          for (i = 0; i < nEdges; i++)
-            if ((el[i].connect[0] == next) && (el[i].edge != NULL)) break;
-        } else {
+        if (cnt != 1) {
           angle = 3.0*PI;
-          for (cnt = i = 0; i < nEdges; i++)
-            if ((el[i].connect[0] == next) && (el[i].edge != NULL)) {
-              ang = EG_angleEdges(fsense, dir, el[i].dir[0]);
+          for (cnt = 0, j = bucket[next]; j != -1; j = link[j])
+            if (el[j].edge != NULL) {
+              ang = EG_angleEdges(fsense, dir, el[j].dir[0]);
 #ifdef DEBUG
               printf(" %d/%d: ang = %lf (%lf)  type = %d\n",
-                     i, nEdges, ang, angle, el[i].edge->mtype);
+                     j, nEdges, ang, angle, el[j].edge->mtype);
               printf("       %lf %lf   %lf %lf\n", dir[0], dir[1],
-                     el[i].dir[0][0], el[i].dir[0][1]);
+                     el[j].dir[0][0], el[j].dir[0][1]);
 #endif
               if ((ang < angle) && (fabs(ang) > 1.e-7)) {
                 angle = ang;
-                cnt   = i;
+                cnt   = j;
               }
             }
           if (angle > 2.0*PI) {
-            printf(" EGADS Error: Cannot find Connection (EG_traceLoops)!\n");
+            printf(" EGADS Error: Cannot find Connection (EG_orderLoops)!\n");
             stat = EGADS_DEGEN;
             goto bail;
           }
           i = cnt;
         }
-        next           = el[i].connect[1];
-        dir[0]         = el[i].dir[1][0];
-        dir[1]         = el[i].dir[1][1];
-        sens[n]        = el[i].sense;
-        objs[n]        = el[i].edge;
-        objs[n+nEdges] = el[i].pcurve;
-        el[i].edge     = NULL;
+        next         = el[i].connect[1];
+        dir[0]       = el[i].dir[1][0];
+        dir[1]       = el[i].dir[1][1];
+        order[m+n]   = i;
+        el[i].edge   = NULL;
 #ifdef DEBUG
-        stat = -1;
-        if (objs[n] != NULL) stat = objs[n]->mtype;
         printf("  current = %d  next = %d  n = %d  type = %d\n",
-               i, next, n, stat);
+               i, next, n, edges[i]->mtype);
 #endif
         n++;
       } while (next != first);
     }
-    
-    /* make the loop */
-    if (*nLoops == 0) {
-      list = (egObject **) EG_alloc(sizeof(egObject *));
-    } else {
-      list = (egObject **) EG_reall(*loops, (*nLoops+1)*sizeof(egObject *));
-    }
-    if (list == NULL) {
-      stat = EGADS_MALLOC;
-      goto bail;
-    }
-    
 #ifdef DEBUG
-    printf(" EG_traceLoops: making %d Loop w/ %d of %d Edges!\n",
+    printf(" EG_orderLoops: Loop %d w/ %d of %d Edges!\n",
            *nLoops+1, n, nEdges);
+#endif
+    lcnt[*nLoops] = n;
+    *nLoops      += 1;
+  }
+  stat = EGADS_SUCCESS;
+  
+bail:
+  if (stat != EGADS_SUCCESS) *nLoops = 0;
+  if (bucket    != NULL) EG_free(bucket);
+  if (grid.head != NULL) EG_free(grid.head);
+  if (el        != NULL) EG_free(el);
+  return stat;
+}
+
+
+static int
+EG_makeLoops(egObject *context, const egObject *face, egObject **edges,
+             int *senses, /*@null@*/ egObject **pcurves, int nLoops,
+             const int *lcnt, const int *order, egObject ***loops)
+{
+  int      i, j, k, m, n, stat, oclass, fsense, outLevel, *sens, *sen;
+  double   frange[4];
+  egObject *surf, **nodes, **objs, **list;
+  
+  *loops   = NULL;
+  outLevel = EG_outLevel(context);
+  stat     = EG_getTopology(face, &surf, &oclass, &fsense, frange, &n, &nodes,
+                            &sen);
+  if (stat != EGADS_SUCCESS) {
+    printf(" EGADS Error: Cannot get Face = %d (EG_makeLoops)!\n", stat);
+    return stat;
+  }
+  
+  for (m = i = 0; i < nLoops; i++)
+    if (lcnt[i] > m) m = lcnt[i];
+  list = (egObject **) EG_alloc(nLoops*sizeof(egObject *));
+  objs = (egObject **) EG_alloc(2*m*sizeof(egObject *));
+  sens = (int *)       EG_alloc(m*sizeof(int));
+  if ((list == NULL) || (objs == NULL) || (sens == NULL)) {
+    if (sens != NULL) EG_free(sens);
+    if (objs != NULL) EG_free(objs);
+    if (list != NULL) EG_free(list);
+    return EGADS_MALLOC;
+  }
+  
+  for (k = i = 0; i < nLoops; i++) {
+    n = lcnt[i];
+    for (j = 0; j < n; j++, k++) {
+      objs[j] = edges[order[k]];
+      sens[j] = senses[order[k]];
+      if (pcurves != NULL) objs[j+n] = pcurves[order[k]];
+    }
+#ifdef DEBUG
+    printf(" EG_makeLoops: making %d Loop w/ %d Edges!\n", i+1, n);
 #endif
     if (pcurves != NULL) {
-      for (i = 0; i < n; i++) objs[i+n] = objs[i+nEdges];
       stat = EG_makeTopology(context, surf, LOOP, CLOSED, NULL, n, objs, sens,
-                             &list[*nLoops]);
+                             &list[i]);
     } else {
       stat = EG_makeTopology(context, NULL, LOOP, CLOSED, NULL, n, objs, sens,
-                             &list[*nLoops]);
+                             &list[i]);
     }
     if (stat != EGADS_SUCCESS) {
-      printf(" EGADS Error: makeTopology %d = %d (EG_traceLoops)!\n",
-             *nLoops+1, stat);
-      *loops = list;
-      goto bail;
+      printf(" EGADS Error: makeTopology %d = %d (EG_makeLoops)!\n",
+             i+1, stat);
+      break;
     }
-    if (list[*nLoops]->mtype == OPEN) {
+    if (list[i]->mtype == OPEN) {
       if (outLevel > 0)
-        printf("             Loop %d is Open (EG_traceLoops)!\n", *nLoops+1);
-      *nLoops += 1;
-      *loops   = list;
-      stat     = EGADS_TOPOERR;
-      goto bail;
+        printf("             Loop %d is Open (EG_makeLoops)!\n", i+1);
+      i++;
+      stat = EGADS_TOPOERR;
+      break;
     }
-    
-    *nLoops += 1;
-    *loops   = list;
-    
-    for (n = i = 0; i < nEdges; i++)
-      if (el[i].edge != NULL) n++;
   }
-  stat = EGADS_SUCCESS;
-  
-bail:
+  EG_free(sens);
+  EG_free(objs);
   if (stat != EGADS_SUCCESS) {
-    list = *loops;
-    if (list != NULL)
-      for (i = 0; i < *nLoops; i++)
-        EG_deleteObject(list[i]);
-    if (*loops != NULL) EG_free(*loops);
-    *loops  = NULL;
-    *nLoops = 0;
-  }
-  if (sens != NULL) EG_free(sens);
-  if (objs != NULL) EG_free(objs);
-  if (el   != NULL) EG_free(el);
-  return stat;
+    for (j = 0; j < i; j++) EG_deleteObject(list[j]);
+    EG_free(list);
+    return stat;
+  }
+  
+  *loops = list;
+  return EGADS_SUCCESS;
 }
 
 
@@ -906,16 +1021,26 @@ EG_cutDegenerate(int iSeg, edgeInfo *fe, egObject *edge)
 
 
 static int
-EG_splitFace(egObject *context, int iFace, int iSeg, edgeInfo *fe,
-             /*@unused@*/ splitEnts *sFaces, objStack *stack)
+EG_splitPrep(egObject *context, int iFace, int iSeg, edgeInfo *fe,
+             objStack *stack, faceTrace *trace)
 {
-  int       i, j, k, m, n, stat, oclass, mtype, nLoop, nEdge, fsense, nFace, ol;
-  int       nDegen, iper, *sens, *senses, *mark;
-  double    t, tol, toler, area, oarea;
-  double    uvbox[4], box[4], obox[4], uvs[6], d[2], trang[2], trange[2];
-  egObject  *ref, *surf, *pcurve, *face, **objs, **edges, **pcurves, **loops;
+  int       i, j, k, m, n, stat, oclass, mtype, nLoop, nEdge, fsense, ol;
+  int       nDegen, iper, *sens, *senses, *order;
+  double    t, tol, toler, uvbox[4], uvs[6], d[2], trang[2], trange[2];
+  egObject  *ref, *surf, *pcurve, **objs, **edges, **pcurves, **loops;
   degenEdge *degenCnt;
   
+  trace->iFace   = iFace;
+  trace->iSeg    = iSeg;
+  trace->nEdge   = 0;
+  trace->nLoop   = 0;
+  trace->stat    = EGADS_SUCCESS;
+  trace->senses  = NULL;
+  trace->order   = NULL;
+  trace->lcnt    = NULL;
+  trace->edges   = NULL;
+  trace->pcurves = NULL;
+  
   stat = EG_getTolerance(fe[iSeg].face, &tol);
   if (stat != EGADS_SUCCESS) return stat;
   stat = EG_getTopology(fe[iSeg].face, &surf, &oclass, &fsense, uvbox, &nLoop,
@@ -925,14 +1050,6 @@ EG_splitFace(egObject *context, int iFace, int iSeg, edgeInfo *fe,
            iFace+1, stat);
     return stat;
   }
-#ifdef DEBUG
-  for (i = 0; i < nLoop; i++) {
-    stat = EG_getUVinfo(surf, loops[i], box, &area);
-    if (stat == EGADS_SUCCESS)
-      printf(" %d: mtype = %d  or = %d  UVinfo = %lf  %lf %lf  %lf %lf\n",
-             i+1, surf->mtype, fsense, area, box[0], box[1], box[2], box[3]);
-  }
-#endif
   
   /* mark the degenerate NODE intersections on Degenerate Edges */
   for (nEdge = i = 0; i < nLoop; i++) {
@@ -1301,8 +1418,130 @@ EG_splitFace(egObject *context, int iFace, int iSeg, edgeInfo *fe,
   }
   if (degenCnt != NULL) EG_free(degenCnt);
   
-  stat = EG_traceLoops(context, fe[iSeg].face, nEdge, edges, senses, pcurves,
-                       &nLoop, &loops);
+  /* save away the Edges for ordering */
+  order = (int *) EG_alloc(2*nEdge*sizeof(int));
+  if (order == NULL) {
+    printf(" EGADS Internal: Face %d Cannot allocate %d Loop indices\n",
+           iFace+1, 2*nEdge);
+    if (pcurves != NULL) EG_free(pcurves);
+    EG_free(senses);
+    EG_free(edges);
+    return EGADS_MALLOC;
+  }
+  trace->nEdge   = nEdge;
+  trace->senses  = senses;
+  trace->order   = order;
+  trace->lcnt    = &order[nEdge];
+  trace->edges   = edges;
+  trace->pcurves = pcurves;
+  
+  return EGADS_SUCCESS;
+}
+
+
+static void
+EG_traceFree(int ntrace, faceTrace *traces)
+{
+  int i;
+  
+  for (i = 0; i < ntrace; i++) {
+    if (traces[i].pcurves != NULL) EG_free(traces[i].pcurves);
+    if (traces[i].senses  != NULL) EG_free(traces[i].senses);
+    if (traces[i].edges   != NULL) EG_free(traces[i].edges);
+    if (traces[i].order   != NULL) EG_free(traces[i].order);
+  }
+  EG_free(traces);
+}
+
+
+/* structure to pass data to the threads ordering the Loops */
+typedef struct {
+  void      *mutex;             /* the mutex or NULL for single thread */
+  long      master;             /* master thread ID */
+  int       end;                /* end of loop */
+  int       index;              /* current loop index */
+  edgeInfo  *fe;                /* the cut Edge information */
+  faceTrace *traces;            /* the Edges to connect for each Face */
+} EMPsplit;
+
+
+static void
+EG_splitThread(void *struc)
+{
+  int       index;
+  long      ID;
+  faceTrace *trace;
+  EMPsplit  *sthread;
+  
+  sthread = (EMPsplit *) struc;
+  
+  /* get our identifier */
+  ID = EMP_ThreadID();
+  
+  /* look for work */
+  for (;;) {
+    
+    /* only one thread at a time here -- controlled by a mutex! */
+    if (sthread->mutex != NULL) EMP_LockSet(sthread->mutex);
+    index = sthread->index;
+    sthread->index++;
+    if (sthread->mutex != NULL) EMP_LockRelease(sthread->mutex);
+    if (index >= sthread->end) break;
+    
+    /* do the work -- no Objects are made here */
+    trace        = &sthread->traces[index];
+    trace->stat  = EG_orderLoops(sthread->fe[trace->iSeg].face, trace->nEdge,
+                                 trace->edges, trace->senses, trace->pcurves,
+                                 &trace->nLoop, trace->lcnt, trace->order);
+  }
+  
+  /* exhausted all work -- exit */
+  if (ID != sthread->master) EMP_ThreadExit();
+}
+
+
+static int
+EG_splitFinish(egObject *context, edgeInfo *fe, splitEnts *sFaces,
+               objStack *stack, faceTrace *trace)
+{
+  int      i, j, k, m, stat, oclass, nLoop, fsense, nFace, ol, iFace, iSeg;
+  int      *sens, *mark;
+  double   tol, area, oarea, uvbox[4], box[4], obox[4];
+  egObject *surf, *face, **objs, **loops;
+#ifdef DEBUG
+  double   t;
+#endif
+  
+  iFace = trace->iFace;
+  iSeg  = trace->iSeg;
+  stat  = EG_getTolerance(fe[iSeg].face, &tol);
+  if (stat != EGADS_SUCCESS) return stat;
+  stat = EG_getTopology(fe[iSeg].face, &surf, &oclass, &fsense, uvbox, &nLoop,
+                        &loops, &sens);
+  if (stat != EGADS_SUCCESS) {
+    printf(" EGADS Internal: Face %d -- EG_getTopology = %d\n",
+           iFace+1, stat);
+    return stat;
+  }
+#ifdef DEBUG
+  for (i = 0; i < nLoop; i++) {
+    stat = EG_getUVinfo(surf, loops[i], box, &area);
+    if (stat == EGADS_SUCCESS)
+      printf(" %d: mtype = %d  or = %d  UVinfo = %lf  %lf %lf  %lf %lf\n",
+             i+1, surf->mtype, fsense, area, box[0], box[1], box[2], box[3]);
+  }
+#endif
+  
+  /* make the Loops from the ordered Edges */
+  loops = NULL;
+  nLoop = 0;
+  stat  = trace->stat;
+  if (stat == EGADS_SUCCESS) {
+    nLoop = trace->nLoop;
+    stat  = EG_makeLoops(context, fe[iSeg].face, trace->edges, trace->senses,
+                         trace->pcurves, nLoop, trace->lcnt, trace->order,
+                         &loops);
+  }
 #ifdef DEBUG
   printf(" EGADS Info: traceLoops = %d, returns %d loops!\n", stat, nLoop);
 #endif
@@ -1316,9 +1555,6 @@ EG_splitFace(egObject *context, int iFace, int iSeg, edgeInfo *fe,
       for (i = 0; i < nLoop; i++)
         EG_deleteObject(loops[i]);
       EG_free(loops);
-      if (pcurves != NULL) EG_free(pcurves);
-      EG_free(senses);
-      EG_free(edges);
       return EGADS_MALLOC;
     }
     for (i = 0; i < nLoop; i++) mark[i] = 0;
@@ -1332,9 +1568,6 @@ EG_splitFace(egObject *context, int iFace, int iSeg, edgeInfo *fe,
         for (j = i; j < nLoop; j++) EG_deleteObject(loops[j]);
         EG_free(mark);
         EG_free(loops);
-        if (pcurves != NULL) EG_free(pcurves);
-        EG_free(senses);
-        EG_free(edges);
         return stat;
       }
   
@@ -1345,9 +1578,6 @@ EG_splitFace(egObject *context, int iFace, int iSeg, edgeInfo *fe,
         for (j = i+1; j < nLoop; j++) EG_deleteObject(loops[j]);
         EG_free(mark);
         EG_free(loops);
-        if (pcurves != NULL) EG_free(pcurves);
-        EG_free(senses);
-        EG_free(edges);
         return stat;
       }
 #ifdef DEBUG
@@ -1384,9 +1614,6 @@ EG_splitFace(egObject *context, int iFace, int iSeg, edgeInfo *fe,
              iFace+1, j, nFace);
       EG_free(mark);
       EG_free(loops);
-      if (pcurves != NULL) EG_free(pcurves);
-      EG_free(senses);
-      EG_free(edges);
       return stat;
     }
     
@@ -1396,9 +1623,6 @@ EG_splitFace(egObject *context, int iFace, int iSeg, edgeInfo *fe,
       printf(" EGADS Internal: Face %d -- EG_splitAlloc = %d\n", iFace+1, stat);
       EG_free(mark);
       EG_free(loops);
-      if (pcurves != NULL) EG_free(pcurves);
-      EG_free(senses);
-      EG_free(edges);
       return stat;
     }
     
@@ -1420,9 +1644,6 @@ EG_splitFace(egObject *context, int iFace, int iSeg, edgeInfo *fe,
       if (objs != NULL) EG_free(objs);
       EG_free(mark);
       EG_free(loops);
-      if (pcurves != NULL) EG_free(pcurves);
-      EG_free(senses);
-      EG_free(edges);
       return EGADS_MALLOC;
     }
     
@@ -1459,9 +1680,6 @@ EG_splitFace(egObject *context, int iFace, int iSeg, edgeInfo *fe,
         EG_free(objs);
         EG_free(mark);
         EG_free(loops);
-        if (pcurves != NULL) EG_free(pcurves);
-        EG_free(senses);
-        EG_free(edges);
         return stat;
       }
       stat = EG_stackPush(stack, face);
@@ -1472,9 +1690,6 @@ EG_splitFace(egObject *context, int iFace, int iSeg, edgeInfo *fe,
         EG_free(objs);
         EG_free(mark);
         EG_free(loops);
-        if (pcurves != NULL) EG_free(pcurves);
-        EG_free(senses);
-        EG_free(edges);
         return stat;
       }
       EG_attributeDup(fe[iSeg].face, face);
@@ -1487,9 +1702,6 @@ EG_splitFace(egObject *context, int iFace, int iSeg, edgeInfo *fe,
     EG_free(loops);
   }
 
-  if (pcurves != NULL) EG_free(pcurves);
-  EG_free(senses);
-  EG_free(edges);
   return stat;
 }
 
@@ -1500,7 +1712,9 @@ EG_splitBody(const egObject *body, int nseg, const egObject **facEdg,
 {
   int       i, j, jj, k, kk, l, m, n, *senses, *sen, *newSen, *eface = NULL;
   int       oclass, mtype, oc, mt, len, per, outLevel, status = EGADS_SUCCESS;
-  int        nnodes,  nedges,  nfaces,  nshells;
+  int        nnodes,  nedges,  nfaces,  nshells, np, ntrace = 0;
+  long      start;
+  void      **threads = NULL;
   egObject  **nodes, **edges, **faces, **shells, **newObjs, **newFaces;
   egObject  *context, *ref, *lnodes[2], **children, **dum, **objs, *geom, *obj;
   egObject  *newBody;
@@ -1509,6 +1723,8 @@ EG_splitBody(const egObject *body, int nseg, const egObject **facEdg,
   edgeInfo  *fe;
   objStack  stack;
   splitEnts *sEdges = NULL, *sFaces = NULL;
+  faceTrace *traces = NULL;
+  EMPsplit  sthread;
 #ifdef WRITERESULT
   egObject    *model;
   static char fname[13] = "body_a.egads";
@@ -2306,12 +2522,86 @@ EG_splitBody(const egObject *body, int nseg, const egObject **facEdg,
   EG_splitInit(nfaces, &sFaces);
   if (sFaces == NULL) goto cleanup;
 
-  for (i = 0; i < nfaces; i++) {
+  /* collect the Edges for each cut Face -- makes Objects so serial */
+  for (i = 0; i < nfaces; i++)
+    if (eface[i] != -1) ntrace++;
+  if (ntrace != 0) {
+    traces = (faceTrace *) EG_alloc(ntrace*sizeof(faceTrace));
+    if (traces == NULL) {
+      status = EGADS_MALLOC;
+      goto cleanup;
+    }
+  }
+  for (ntrace = i = 0; i < nfaces; i++) {
     j = eface[i];
     if (j == -1) continue;
-    status = EG_splitFace(context, i, j, fe, sFaces, &stack);
+    status = EG_splitPrep(context, i, j, fe, &stack, &traces[ntrace]);
+#ifdef DEBUG
+    printf(" EG_splitPrep = %d\n", status);
+#endif
+    if (status != EGADS_SUCCESS) goto cleanup;
+    ntrace++;
+  }
+
+  /* set up for explicit multithreading -- each Face orders its Loops */
+  sthread.mutex  = NULL;
+  sthread.master = EMP_ThreadID();
+  sthread.index  = 0;
+  sthread.end    = ntrace;
+  sthread.fe     = fe;
+  sthread.traces = traces;
+
+  np = EMP_Init(&start);
+  if (outLevel > 1) printf(" EMP NumProcs = %d!\n", np);
+  if (ntrace < np) np = ntrace;
+
+  if (np > 1) {
+    /* create the mutex to handle list synchronization */
+    sthread.mutex = EMP_LockCreate();
+    if (sthread.mutex == NULL) {
+      printf(" EMP Error: mutex creation = NULL!\n");
+      np = 1;
+    } else {
+      /* get storage for our extra threads */
+      threads = (void **) malloc((np-1)*sizeof(void *));
+      if (threads == NULL) {
+        EMP_LockDestroy(sthread.mutex);
+        sthread.mutex = NULL;
+        np = 1;
+      }
+    }
+  }
+
+  /* create the threads and get going! */
+  if (threads != NULL)
+    for (i = 0; i < np-1; i++) {
+      threads[i] = EMP_ThreadCreate(EG_splitThread, &sthread);
+      if (threads[i] == NULL)
+        printf(" EMP Error Creating Thread #%d!\n", i+1);
+    }
+  /* now run the thread block from the original thread */
+  EG_splitThread(&sthread);
+
+  /* wait for all others to return */
+  if (threads != NULL)
+    for (i = 0; i < np-1; i++)
+      if (threads[i] != NULL) EMP_ThreadWait(threads[i]);
+
+  /* cleanup */
+  if (threads != NULL)
+    for (i = 0; i < np-1; i++)
+      if (threads[i] != NULL) EMP_ThreadDestroy(threads[i]);
+  if (sthread.mutex != NULL) EMP_LockDestroy(sthread.mutex);
+  if (threads != NULL) free(threads);
+  if (outLevel > 1)
+    printf(" EMP Number of Seconds on Loop Thread Block = %ld\n",
+           EMP_Done(&start));
+
+  /* make the Loops & split Faces back in this thread */
+  for (i = 0; i < ntrace; i++) {
+    status = EG_splitFinish(context, fe, sFaces, &stack, &traces[i]);
 #ifdef DEBUG
-    printf(" EG_splitFace = %d\n", status);
+    printf(" EG_splitFinish = %d\n", status);
 #endif
     if (status != EGADS_SUCCESS) goto cleanup;
   }
@@ -2449,6 +2739,7 @@ EG_splitBody(const egObject *body, int nseg, const egObject **facEdg,
   *result = obj;
   
 cleanup:
+  if (traces != NULL) EG_traceFree(ntrace, traces);
   EG_splitFree(nedges, &sEdges);
   EG_splitFree(nfaces, &sFaces);
   EG_stackPop(&stack, &ref);
@@ -13,14 +13,36 @@
 #include "egads_dot.h"
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <math.h>
 
+#include "emp.h"
+
 extern "C" int EG_sameThread( const ego object );
 extern "C" int EG_outLevel( const ego object );
 
 #define EPS 1.E-08
 #define PI  3.1415926535897931159979635
 
+/* minimum work (nC*nC per column solve) before threading the columns */
+#define MTSKIN 1000000
+
+
+template<class T>
+struct EMPskin
+{
+  void      *mutex;         /* the mutex or NULL for single thread */
+  long      master;         /* master thread ID */
+  int       index;          /* next column to solve */
+  int       end;            /* number of columns (nP) */
+  int       nC;             /* number of curves */
+  int       nP;             /* number of control points per curve */
+  const T   *A;             /* the factored collocation matrix */
+  const int *ipvt;          /* the pivots */
+  const T   *P_cross;       /* the compatible control points */
+  T         **net;          /* the resultant control net */
+};
+
 
 /* Computes Bsplines values for a given knot sequence */
 template<class T>
@@ -68,14 +90,15 @@ OneBasisFun (int p, int m, T U[], int i, T u)
 }
 
 
+/* LU factorization with partial pivoting -- the multipliers stay in place
+   (LINPACK style) so that each right-hand side is reduced exactly as a full
+   elimination would */
 template<class T>
 static int
-matsol(T    A[],           /* (in)  matrix to be solved (stored rowwise) */
-                           /* (out) upper-triangular form of matrix */
-       T    b[],           /* (in)  right hand side */
-                           /* (out) right-hand side after swapping */
+matfac(T    A[],           /* (in)  matrix to be factored (stored rowwise) */
+                           /* (out) L (multipliers) and U factors */
        int  n,             /* (in)  size of matrix */
-       T    x[])           /* (out) solution of A*x=b */
+       int  ipvt[])        /* (out) pivot row for each column */
 {
 
   int ir, jc, kc, imax;
@@ -97,21 +120,18 @@ matsol(T    A[],           /* (in)  matrix to be solved (stored rowwise) */
         amax = fabs(A[ir*n+kc]);
       }
     }
+    ipvt[kc] = imax;
 
     /* check for possibly-singular matrix (ie, near-zero pivot) */
     if (amax < EPS12) return EGADS_DEGEN;
 
-    /* if diagonal is not pivot, swap rows in A and b */
+    /* if diagonal is not pivot, swap the unreduced part of the rows */
     if (imax != kc) {
-      for (jc = 0; jc < n; jc++) {
+      for (jc = kc; jc < n; jc++) {
         swap         = A[kc  *n+jc];
         A[kc  *n+jc] = A[imax*n+jc];
         A[imax*n+jc] = swap;
       }
-
-      swap    = b[kc  ];
-      b[kc  ] = b[imax];
-      b[imax] = swap;
     }
 
     /* row-reduce part of matrix to the bottom of and right of [kc,kc] */
@@ -120,10 +140,35 @@ matsol(T    A[],           /* (in)  matrix to be solved (stored rowwise) */
 
       for (jc = kc+1; jc < n; jc++) A[ir*n+jc] -= fact * A[kc*n+jc];
 
-      b[ir] -= fact * b[kc];
+      A[ir*n+kc] = fact;
+    }
+  }
+
+  return EGADS_SUCCESS;
+}
+
 
-      A[ir*n+kc] = 0;
+/* solve A*x=b given the factorization from matfac */
+template<class T>
+static void
+matbks(const T A[],        /* (in)  factored matrix from matfac */
+       const int ipvt[],   /* (in)  pivots from matfac */
+       T    b[],           /* (in)  right hand side */
+                           /* (out) right-hand side after reduction */
+       int  n,             /* (in)  size of matrix */
+       T    x[])           /* (out) solution of A*x=b */
+{
+  int ir, jc, kc;
+  T   swap;
+
+  /* forward pass */
+  for (kc = 0; kc < n; kc++) {
+    if (ipvt[kc] != kc) {
+      swap        = b[kc];
+      b[kc]       = b[ipvt[kc]];
+      b[ipvt[kc]] = swap;
     }
+    for (ir = kc+1; ir < n; ir++) b[ir] -= A[ir*n+kc] * b[kc];
   }
 
   /* back-substitution pass */
@@ -133,7 +178,6 @@ matsol(T    A[],           /* (in)  matrix to be solved (stored rowwise) */
     for (kc = jc+1; kc < n; kc++) x[jc] -= A[jc*n+kc] * x[kc];
     x[jc] /= A[jc*n+jc];
   }
-  return EGADS_SUCCESS;
 }
 
 
@@ -596,6 +640,124 @@ bail:
   return stat;
 }
 
+
+/* interpolate the control point columns against the shared factorization */
+template<class T>
+static void
+skinThread(void *struc)
+{
+  int        index, d, n, nC, nP;
+  long       ID;
+  T          *b;
+  EMPskin<T> *sthread;
+
+  sthread = (EMPskin<T> *) struc;
+  nC      = sthread->nC;
+  nP      = sthread->nP;
+
+  /* get our identifier */
+  ID = EMP_ThreadID();
+
+  /* without scratch this thread takes no work -- others pick it up */
+  b = (T *) EG_alloc(2*nC*sizeof(T));
+  if (b != NULL) {
+
+    /* look for work */
+    for (;;) {
+
+      /* only one thread at a time here -- controlled by a mutex! */
+      if (sthread->mutex != NULL) EMP_LockSet(sthread->mutex);
+      index = sthread->index;
+      sthread->index++;
+      if (sthread->mutex != NULL) EMP_LockRelease(sthread->mutex);
+      if (index >= sthread->end) break;
+
+      /* do the work */
+      for (d = 0; d < 3; ++d) {
+        for (n = 0; n < nC; ++n) b[n] = sthread->P_cross[d+index*3+n*3*nP];
+        // Finds the Control Points such that the curve interpolates the original control points.
+        matbks(sthread->A, sthread->ipvt, b, nC, &b[nC]);
+        for (n = 0; n < nC; ++n) sthread->net[d][index*nC+n] = b[nC+n];
+      }
+    }
+    EG_free(b);
+  }
+
+  /* exhausted all work -- exit */
+  if (ID != sthread->master) EMP_ThreadExit();
+}
+
+
+/* solve for all columns of the control net -- A is factored once */
+template<class T>
+static int
+skinColumns(int nC, int nP, const T *A, const int *ipvt, const T *P_cross,
+            T **net)
+{
+  int        i, np;
+  void       **threads = NULL;
+  EMPskin<T> sthread;
+
+  /* set up for explicit multithreading */
+  sthread.mutex   = NULL;
+  sthread.master  = EMP_ThreadID();
+  sthread.index   = 0;
+  sthread.end     = nP;
+  sthread.nC      = nC;
+  sthread.nP      = nP;
+  sthread.A       = A;
+  sthread.ipvt    = ipvt;
+  sthread.P_cross = P_cross;
+  sthread.net     = net;
+
+  np = 1;
+  if (3.0*nP*nC*nC >= MTSKIN) np = EMP_Init(NULL);
+  if (nP < np) np = nP;
+  if (np > 1) {
+    /* create the mutex to handle list synchronization */
+    sthread.mutex = EMP_LockCreate();
+    if (sthread.mutex == NULL) {
+      printf(" EMP Error: mutex creation = NULL!\n");
+      np = 1;
+    } else {
+      /* get storage for our extra threads */
+      threads = (void **) malloc((np-1)*sizeof(void *));
+      if (threads == NULL) {
+        EMP_LockDestroy(sthread.mutex);
+        sthread.mutex = NULL;
+        np = 1;
+      }
+    }
+  }
+
+  /* create the threads and get going! */
+  if (threads != NULL)
+    for (i = 0; i < np-1; i++) {
+      threads[i] = EMP_ThreadCreate(skinThread<T>, &sthread);
+      if (threads[i] == NULL)
+        printf(" EMP Error Creating Thread #%d!\n", i+1);
+    }
+  /* now run the thread block from the original thread */
+  skinThread<T>(&sthread);
+
+  /* wait for all others to return */
+  if (threads != NULL)
+    for (i = 0; i < np-1; i++)
+      if (threads[i] != NULL) EMP_ThreadWait(threads[i]);
+
+  /* cleanup */
+  if (threads != NULL)
+    for (i = 0; i < np-1; i++)
+      if (threads[i] != NULL) EMP_ThreadDestroy(threads[i]);
+  if (sthread.mutex != NULL) EMP_LockDestroy(sthread.mutex);
+  if (threads != NULL) free(threads);
+
+  /* no thread could get scratch */
+  if (sthread.index < nP) return EGADS_MALLOC;
+  return EGADS_SUCCESS;
+}
+
+
 template<class T>
 int makeSkinningGeom(int nC, ego *sectionCurves, int skinning_degree,
                      int *splineInfo, T **splineData)
@@ -603,9 +765,10 @@ int makeSkinningGeom(int nC, ego *sectionCurves, int skinning_degree,
   T   *P_cross, *Uknots; // ptr to control points and commont knot vector
   int c = 0, d = 0, i = 0, j = 0, n=0, it = 0, stat, dimVknots = 0;
   int nP = 0, dimUknots = 0, degree = 0;
-  int blend = 0, dataLength = 0, offset = 0;
+  int dataLength = 0, offset = 0;
   T   sumVal, diam, dist, locCord;
-  T   *A = NULL, *A_aux = NULL, *net[3] , *b = NULL;
+  int *ipvt = NULL;
+  T   *A = NULL, *net[3] = {NULL, NULL, NULL};
   T   *v_param = NULL , *vKnots = NULL;
 
   int outLevel = EG_outLevel(sectionCurves[0]);
@@ -661,19 +824,17 @@ int makeSkinningGeom(int nC, ego *sectionCurves, int skinning_degree,
     vKnots[skinning_degree+j]  /= (double) skinning_degree;
   }
   // FIND SURFACE CONTROL NET ----> INTERPOLATING CROSS CURVES + SOLVING LINEAR SYSTEMS
-  A      = (T *) EG_alloc(nC*nC*sizeof(T));
-  A_aux  = (T *) EG_alloc(nC*nC*sizeof(T));
-  net[0] = (T *) EG_alloc(nP*nC*sizeof(T));
-  net[1] = (T *) EG_alloc(nP*nC*sizeof(T));
-  net[2] = (T *) EG_alloc(nP*nC*sizeof(T));
-  b      = (T *) EG_alloc(   nC*sizeof(T));
-  if ( (A == NULL) || (A_aux == NULL) || (net[0] == NULL) || (net[1] == NULL) ||
-       (net[2] == NULL) || (b == NULL) ) {
-    if (b      != NULL) EG_free(b);
+  A      = (T *)   EG_alloc(nC*nC*sizeof(T));
+  ipvt   = (int *) EG_alloc(   nC*sizeof(int));
+  net[0] = (T *)   EG_alloc(nP*nC*sizeof(T));
+  net[1] = (T *)   EG_alloc(nP*nC*sizeof(T));
+  net[2] = (T *)   EG_alloc(nP*nC*sizeof(T));
+  if ( (A == NULL) || (ipvt == NULL) || (net[0] == NULL) || (net[1] == NULL) ||
+       (net[2] == NULL) ) {
     if (net[2] != NULL) EG_free(net[2]);
     if (net[1] != NULL) EG_free(net[1]);
     if (net[0] != NULL) EG_free(net[0]);
-    if (A_aux  != NULL) EG_free(A_aux);
+    if (ipvt   != NULL) EG_free(ipvt);
     if (A      != NULL) EG_free(A);
     EG_free(vKnots);
     EG_free(v_param);
@@ -685,34 +846,25 @@ int makeSkinningGeom(int nC, ego *sectionCurves, int skinning_degree,
     for ( j = 0; j < nC; ++j, ++it )
       A[it] = OneBasisFun(skinning_degree, dimVknots-1, vKnots, j, v_param[i]);
 
-  for ( blend = 0; blend < nP; ++blend ) {
-    for ( d = 0; d < 3; ++d ) {
-      for ( n = 0; n < nC;    ++n ) b[n] = P_cross[ d+blend*3+n*3*nP ];
-      for ( n = 0; n < nC*nC; ++n ) A_aux[n] = A[n];
-      // Finds the Control Points such that the curve interpolates the original control points.
-      stat = matsol(A_aux, b, nC, &net[d][blend*nC]);
-      if (stat != EGADS_SUCCESS) {
-        if (outLevel > 0)
-          printf(" EGADS Error: Solving Linear System = %d!!\n", stat);
-        EG_free(b);
-        EG_free(net[2]);
-        EG_free(net[1]);
-        EG_free(net[0]);
-        EG_free(A_aux);
-        EG_free(A);
-        EG_free(vKnots);
-        EG_free(v_param);
-        EG_free(P_cross);
-        EG_free(Uknots);
-        return stat;
-      }
-    }
-  }
-  EG_free(b);
-  EG_free(A_aux);
+  // The collocation matrix is the same for every column (and carries the
+  // sensitivities for SurrealS) -- factor it once and solve all columns.
+  stat = matfac(A, nC, ipvt);
+  if (stat == EGADS_SUCCESS)
+    stat = skinColumns(nC, nP, A, ipvt, P_cross, net);
+  EG_free(ipvt);
   EG_free(A);
   EG_free(v_param);
   EG_free(P_cross);
+  if (stat != EGADS_SUCCESS) {
+    if (outLevel > 0)
+      printf(" EGADS Error: Solving Linear System = %d!!\n", stat);
+    EG_free(net[2]);
+    EG_free(net[1]);
+    EG_free(net[0]);
+    EG_free(vKnots);
+    EG_free(Uknots);
+    return stat;
+  }
 
   /* SURFACE BSPLINES */
   splineInfo[0] = 0;
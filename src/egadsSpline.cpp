@@ -17,6 +17,7 @@
 #include "egads_dot.h"
 #include "egadsClasses.h"
 #include "egadsStack.h"
+#include "emp.h"
 #include "Surreal/SurrealS.h"
 
 #define EGADS_SPLINE_VELS
@@ -221,6 +222,33 @@ struct egSpline
   }
 };
 
+template<class T>
+struct egStrip
+{
+  int         ruled;         /* 0 - loft, 1 - ruled, 2 - ruled w/ tangents */
+  int         iedge;         /* the stripe (Edge) index */
+  int         isec;          /* the section index (ruled only) */
+  int         jmax;          /* number of sections in the strip */
+  const T     *vknot;        /* knots in the loft direction */
+  const int   *vdata;        /* knot data in the loft direction */
+  const T     *sides[4];     /* the end treatments (loft only) */
+  egSequ<T>   *seq;          /* the sampling along the Edge */
+  T           *xyzs;         /* the points -- followed by t1 & tN */
+  egSpline<T> *surf;         /* the resultant surface */
+  int         stat;          /* the fit status */
+};
+
+template<class T>
+struct EMPstrip
+{
+  void        *mutex;        /* the mutex or NULL for single thread */
+  long        master;        /* master thread ID */
+  int         index;         /* next strip to fit */
+  int         end;           /* number of strips */
+  int         outLevel;      /* output level for messages */
+  egStrip<T>  *strips;       /* the strips */
+};
+
 #if defined(DEBUG) || defined(SPLINE_TECPLOT_DEBUG)
 static double value(double val)
 {
@@ -1793,6 +1821,125 @@ cleanup:
 }
 
 
+/* fit the surface for a single strip -- only works on the sampled points */
+template<class T>
+static int
+EG_stripSpline(int outLevel, egStrip<T> *strip)
+{
+  int     ncp;
+  const T *t1, *tN;
+
+  if (strip->ruled == 0)
+    return EG_loft2spline(outLevel, strip->vknot, strip->vdata, strip->sides,
+                          strip->seq, strip->jmax, strip->xyzs, 1.e-8,
+                          strip->surf->header, &strip->surf->data);
+
+  ncp = strip->seq->ncp;
+  t1  = tN = NULL;
+  if (strip->ruled == 2) {
+    t1 = &strip->xyzs[6*ncp  ];
+    tN = &strip->xyzs[6*ncp+6];
+  }
+  return EG_spline2dAppr<T>(1, ncp, 2, strip->xyzs, strip->seq->knots, NULL,
+                            NULL, t1, tN, NULL, NULL, NULL, NULL, 1.e-8,
+                            strip->surf->header, &strip->surf->data);
+}
+
+
+template<class T>
+static void
+EG_stripThread(void *struc)
+{
+  int         index;
+  long        ID;
+  EMPstrip<T> *sthread;
+
+  sthread = (EMPstrip<T> *) struc;
+
+  /* get our identifier */
+  ID = EMP_ThreadID();
+
+  /* look for work */
+  for (;;) {
+
+    /* only one thread at a time here -- controlled by a mutex! */
+    if (sthread->mutex != NULL) EMP_LockSet(sthread->mutex);
+    index = sthread->index;
+    sthread->index++;
+    if (sthread->mutex != NULL) EMP_LockRelease(sthread->mutex);
+    if (index >= sthread->end) break;
+
+    /* do the work */
+    sthread->strips[index].stat = EG_stripSpline(sthread->outLevel,
+                                                 &sthread->strips[index]);
+  }
+
+  /* exhausted all work -- exit */
+  if (ID != sthread->master) EMP_ThreadExit();
+}
+
+
+/* the strips are independent once sampled -- fit them concurrently,
+   the status of each is left in the strip */
+template<class T>
+static void
+EG_stripSplines(int outLevel, int nstrip, egStrip<T> *strips)
+{
+  int         i, np;
+  void        **threads = NULL;
+  EMPstrip<T> sthread;
+
+  /* set up for explicit multithreading */
+  sthread.mutex    = NULL;
+  sthread.master   = EMP_ThreadID();
+  sthread.index    = 0;
+  sthread.end      = nstrip;
+  sthread.outLevel = outLevel;
+  sthread.strips   = strips;
+
+  np = EMP_Init(NULL);
+  if (nstrip < np) np = nstrip;
+  if (np > 1) {
+    /* create the mutex to handle list synchronization */
+    sthread.mutex = EMP_LockCreate();
+    if (sthread.mutex == NULL) {
+      printf(" EMP Error: mutex creation = NULL!\n");
+      np = 1;
+    } else {
+      /* get storage for our extra threads */
+      threads = (void **) malloc((np-1)*sizeof(void *));
+      if (threads == NULL) {
+        EMP_LockDestroy(sthread.mutex);
+        sthread.mutex = NULL;
+        np = 1;
+      }
+    }
+  }
+
+  /* create the threads and get going! */
+  if (threads != NULL)
+    for (i = 0; i < np-1; i++) {
+      threads[i] = EMP_ThreadCreate(EG_stripThread<T>, &sthread);
+      if (threads[i] == NULL)
+        printf(" EMP Error Creating Thread #%d!\n", i+1);
+    }
+  /* now run the thread block from the original thread */
+  EG_stripThread<T>(&sthread);
+
+  /* wait for all others to return */
+  if (threads != NULL)
+    for (i = 0; i < np-1; i++)
+      if (threads[i] != NULL) EMP_ThreadWait(threads[i]);
+
+  /* cleanup */
+  if (threads != NULL)
+    for (i = 0; i < np-1; i++)
+      if (threads[i] != NULL) EMP_ThreadDestroy(threads[i]);
+  if (sthread.mutex != NULL) EMP_LockDestroy(sthread.mutex);
+  if (threads != NULL) free(threads);
+}
+
+
 #ifdef EGADS_SPLINE_VELS
 static int
 EG_secSplinePointsVels(const egadsSplineVels *vels,
@@ -2726,10 +2873,12 @@ EG_blendSpline(
   egSpline<T> *surfs=NULL, *curvsV=NULL, *curvsU=NULL, *neigbr[2]={NULL,NULL};
 #ifdef BLEND_SPLIT_CONSTRUCTION
   int nC0, iC0;
+  const T *sides[4]={NULL,NULL,NULL,NULL};
 #else
+  int nstrip;
+  egStrip<T>  *strips=NULL;
   egSpline<T> *blendsurfs=NULL;
 #endif
-  const T *sides[4]={NULL,NULL,NULL,NULL};
 
   *nsecC0_out = 0;
   *secsC0_out = NULL;
@@ -3218,44 +3367,61 @@ EG_blendSpline(
 #else
 
   blendsurfs = new egSpline<T>[nstripe];
-  if (blendsurfs == NULL) {
+  strips     = (egStrip<T> *) EG_alloc(nstripe*sizeof(egStrip<T>));
+  if ((blendsurfs == NULL) || (strips == NULL)) {
     if (outLevel > 0)
       printf(" EGADS Error: Allocation for %d Surfaces (EG_blend)!\n", nstripe);
     stat = EGADS_MALLOC;
     goto cleanup;
   }
 
-  for (j = 0; j < nstripe; j++) {
+  /* a single block holds the points for all strips */
+  for (n = j = 0; j < nstripe; j++) {
     if (j == te) continue;
-    xyzs = (T *) EG_alloc(3*(ncp[j].ncp+2)*nsec*sizeof(T));
-    if (xyzs == NULL) {
-      if (outLevel > 0)
-        printf(" EGADS Error: Allocation for %dX%d points (EG_blend)!\n",
-               ncp[j].ncp, nsec);
-      stat = EGADS_MALLOC;
-      goto cleanup;
-    }
-    t1 = &xyzs[3* ncp[j].ncp   *nsec];
-    tN = &xyzs[3*(ncp[j].ncp+1)*nsec];
+    n += 3*(ncp[j].ncp+2)*nsec;
+  }
+  xyzs = (T *) EG_alloc(n*sizeof(T));
+  if (xyzs == NULL) {
+    if (outLevel > 0)
+      printf(" EGADS Error: Allocation for %d points (EG_blend)!\n", n);
+    stat = EGADS_MALLOC;
+    goto cleanup;
+  }
+
+  for (nstrip = npt = j = 0; j < nstripe; j++) {
+    if (j == te) continue;
+    strips[nstrip].ruled = 0;
+    strips[nstrip].iedge = j;
+    strips[nstrip].isec  = 0;
+    strips[nstrip].jmax  = nsec;
+    strips[nstrip].vknot = vknot;
+    strips[nstrip].vdata = vdata;
+    strips[nstrip].seq   = &ncp[j];
+    strips[nstrip].xyzs  = &xyzs[npt];
+    strips[nstrip].surf  = &blendsurfs[j];
+    strips[nstrip].stat  = EGADS_SUCCESS;
+    npt += 3*(ncp[j].ncp+2)*nsec;
+    t1 = &strips[nstrip].xyzs[3* ncp[j].ncp   *nsec];
+    tN = &strips[nstrip].xyzs[3*(ncp[j].ncp+1)*nsec];
 
     if (planar == 0) {
-      sides[0] = t1;
-      sides[2] = tN;
+      strips[nstrip].sides[0] = t1;
+      strips[nstrip].sides[2] = tN;
     } else {
-      sides[0] = NULL;
-      sides[2] = NULL;
+      strips[nstrip].sides[0] = NULL;
+      strips[nstrip].sides[2] = NULL;
     }
 
-    sides[1] = begRC > 0 ? rc1 : NULL;
-    sides[3] = endRC > 0 ? rcN : NULL;
+    strips[nstrip].sides[1] = begRC > 0 ? rc1 : NULL;
+    strips[nstrip].sides[3] = endRC > 0 ? rcN : NULL;
 
     /* get the spline points across all sections for the current stripe */
 #ifdef EGADS_SPLINE_VELS
     stat = EG_secSplinePoints(vels, outLevel, 0, nsec, secs, j, NULL, ncp, &n,
-                              xyzs, t1, tN);
+                              strips[nstrip].xyzs, t1, tN);
 #else
-    stat = EG_secSplinePoints(outLevel, 0, nsec, secs, j, NULL, ncp, &n, xyzs,
-                              t1, tN);
+    stat = EG_secSplinePoints(outLevel, 0, nsec, secs, j, NULL, ncp, &n,
+                              strips[nstrip].xyzs, t1, tN);
 #endif
     if (stat != EGADS_SUCCESS) goto cleanup;
 
@@ -3263,25 +3429,29 @@ EG_blendSpline(
     {
       char filename[42];
       snprintf(filename, 42, "blendSplinePoints_%d.dat", j);
-      EG_tecplotSplinePoints(ncp[j].ncp, nsec, xyzs, filename);
+      EG_tecplotSplinePoints(ncp[j].ncp, nsec, strips[nstrip].xyzs, filename);
     }
 #endif
+    nstrip++;
+  }
 
-    /* get the BSpline surface */
-    stat = EG_loft2spline(outLevel, vknot, vdata,
-                          sides, &ncp[j], nsec, xyzs, 1.e-8,
-                          blendsurfs[j].header, &blendsurfs[j].data);
-    EG_free(xyzs);
-    xyzs = NULL;
+  /* get the BSpline surfaces */
+  EG_stripSplines(outLevel, nstrip, strips);
+  EG_free(xyzs);
+  xyzs = NULL;
+  for (k = 0; k < nstrip; k++) {
+    stat = strips[k].stat;
     if (stat != EGADS_SUCCESS) {
       if (outLevel > 0)
-        printf(" EGADS Error: Strip %d splined = %d (EG_blend)!\n", j+1, stat);
+        printf(" EGADS Error: Strip %d splined = %d (EG_blend)!\n",
+               strips[k].iedge+1, stat);
       goto cleanup;
     }
 
 #ifdef SPLINE_TECPLOT_DEBUG
     {
       char filename[42];
+      j = strips[k].iedge;
       snprintf(filename, 42, "blendSpline_%d.dat", j);
       EG_tecplotSpline(blendsurfs[j].header, blendsurfs[j].data, filename);
     }
@@ -3807,6 +3977,7 @@ cleanup:
   EG_free(snor);
   EG_free(nnor);
 #ifndef BLEND_SPLIT_CONSTRUCTION
+  EG_free(strips);
   delete [] blendsurfs;
 #endif
   if (ncp != NULL) EG_freeSeq(nstripe, ncp);
@@ -3839,11 +4010,12 @@ EG_ruledSpline(
                /*@null@*/egBay *bays, ego **nodes_out, egSpline<T> **curvsU_out,
                egSpline<T> **curvsV_out, egSpline<T> **surfs_out)
 {
-  int         i, j, k, outLevel, stat, isrf, inode, icrvU, icrvV;
-  int         nnode=0, ncurvU=0, ncurvV, nsurf=0, planar;
-  T           t1[6], tN[6], *xyzs=NULL;
+  int         i, j, k, n, outLevel, stat, isrf, inode, icrvU, icrvV;
+  int         nnode=0, ncurvU=0, ncurvV, nsurf=0, planar, nstrip, npt;
+  T           *t1, *tN, *xyzs=NULL;
   ego         *nodes=NULL;
   egSequ<T>   *ncp=NULL;
+  egStrip<T>  *strips=NULL;
   egSpline<T> *surfs=NULL, *curvsV=NULL, *curvsU=NULL;
   egBay       lbays[2];
 
@@ -3916,18 +4088,22 @@ EG_ruledSpline(
       nodes[0+j*inode] = nodes[nsec-1+j*inode];
   }
 
-  for (j = 0; j < nstripe; j++) {
-    xyzs = (T *) EG_alloc(6*ncp[j].ncp*sizeof(T));
-    if (xyzs == NULL)  {
-      if (outLevel > 0)
-        printf(" EGADS Error: Allocation for %dX%d points (EG_ruled)!\n",
-               ncp[j].ncp, nsec);
-      stat = EGADS_MALLOC;
-      goto cleanup;
-    }
+  /* a single block holds the points for all surfaces */
+  for (n = j = 0; j < nstripe; j++) n += (nsec-1)*(6*ncp[j].ncp+12);
+  xyzs   = (T *) EG_alloc(n*sizeof(T));
+  strips = (egStrip<T> *) EG_alloc(nsurf*sizeof(egStrip<T>));
+  if ((xyzs == NULL) || (strips == NULL)) {
+    if (outLevel > 0)
+      printf(" EGADS Error: Allocation for %d points (EG_ruled)!\n", n);
+    stat = EGADS_MALLOC;
+    goto cleanup;
+  }
 
-    /* first construct all surfaces (skipping degenerate ones) */
+  /* first sample all surfaces (skipping degenerate ones) */
+  for (nstrip = npt = j = 0; j < nstripe; j++) {
     for (i = 0; i < nsec-1; i++) {
+      t1 = &xyzs[npt+6*ncp[j].ncp  ];
+      tN = &xyzs[npt+6*ncp[j].ncp+6];
 
       if (bays == NULL) {
         /* skip multipicty of edges */
@@ -3937,10 +4113,10 @@ EG_ruledSpline(
         /* get the spline points between pairs of sections for the stripe */
   #ifdef EGADS_SPLINE_VELS
         stat = EG_secSplinePoints(vels, outLevel, i, 2, &secs[i], j, NULL, ncp,
-                                  &planar, xyzs, t1, tN);
+                                  &planar, &xyzs[npt], t1, tN);
   #else
         stat = EG_secSplinePoints(outLevel, i, 2, &secs[i], j, NULL, ncp,
-                                  &planar, xyzs, t1, tN);
+                                  &planar, &xyzs[npt], t1, tN);
   #endif
         if (stat != EGADS_SUCCESS) goto cleanup;
       } else {
@@ -3954,42 +4130,56 @@ EG_ruledSpline(
         /* get the spline points between pairs of sections for the bay */
   #ifdef EGADS_SPLINE_VELS
         stat = EG_secSplinePoints(vels, outLevel, i, 2, &secs[i], j, lbays, ncp,
-                                  &planar, xyzs, t1, tN);
+                                  &planar, &xyzs[npt], t1, tN);
   #else
         stat = EG_secSplinePoints(outLevel, i, 2, &secs[i], j, lbays, ncp,
-                                  &planar, xyzs, t1, tN);
+                                  &planar, &xyzs[npt], t1, tN);
   #endif
         if (stat != EGADS_SUCCESS) goto cleanup;
       }
 
-      /* get the BSpline surface */
-      if ((planar == 1) || (ncp[j].ncp == 3)) {
-        stat = EG_spline2dAppr<T>(1, ncp[j].ncp, 2, xyzs, ncp[j].knots, NULL,
-                                  NULL, NULL, NULL, NULL, NULL, NULL, NULL,
-                                  1.e-8, surfs[i+j*isrf].header,
-                                  &surfs[i+j*isrf].data);
-      } else {
-        stat = EG_spline2dAppr<T>(1, ncp[j].ncp, 2, xyzs, ncp[j].knots, NULL,
-                                  NULL, t1, tN, NULL, NULL, NULL, NULL,
-                                  1.e-8, surfs[i+j*isrf].header,
-                                  &surfs[i+j*isrf].data);
-      }
-      if (stat != EGADS_SUCCESS) {
-        if (outLevel > 0)
-          printf(" EGADS Error: Edge %d/%d spline2d = %d (EG_ruled)!\n",
-                 j+1, i+1, stat);
-        goto cleanup;
-      }
+      strips[nstrip].ruled = 2;
+      if ((planar == 1) || (ncp[j].ncp == 3)) strips[nstrip].ruled = 1;
+      strips[nstrip].iedge = j;
+      strips[nstrip].isec  = i;
+      strips[nstrip].jmax  = 2;
+      strips[nstrip].vknot = NULL;
+      strips[nstrip].vdata = NULL;
+      for (k = 0; k < 4; k++) strips[nstrip].sides[k] = NULL;
+      strips[nstrip].seq   = &ncp[j];
+      strips[nstrip].xyzs  = &xyzs[npt];
+      strips[nstrip].surf  = &surfs[i+j*isrf];
+      strips[nstrip].stat  = EGADS_SUCCESS;
+      npt += 6*ncp[j].ncp+12;
+      nstrip++;
+    }
+  }
+
+  /* get the BSpline surfaces */
+  EG_stripSplines(outLevel, nstrip, strips);
+  EG_free(xyzs);
+  xyzs = NULL;
+  for (k = 0; k < nstrip; k++) {
+    stat = strips[k].stat;
+    if (stat != EGADS_SUCCESS) {
+      if (outLevel > 0)
+        printf(" EGADS Error: Edge %d/%d spline2d = %d (EG_ruled)!\n",
+               strips[k].iedge+1, strips[k].isec+1, stat);
+      goto cleanup;
+    }
 
 #ifdef SPLINE_TECPLOT_DEBUG
-      {
-        char filename[42];
-        snprintf(filename, 42, "ruleSpline_%dx%d.dat", i,j);
-        EG_tecplotSpline(surfs[i+j*isrf].header, surfs[i+j*isrf].data, filename);
-      }
-#endif
+    {
+      char filename[42];
+      i = strips[k].isec;
+      j = strips[k].iedge;
+      snprintf(filename, 42, "ruleSpline_%dx%d.dat", i,j);
+      EG_tecplotSpline(surfs[i+j*isrf].header, surfs[i+j*isrf].data, filename);
     }
+#endif
+  }
 
+  for (j = 0; j < nstripe; j++) {
     /* construct the curves from the surfaces */
     for (i = 0; i < nsec-1; i++) {
       if (surfs[i+j*isrf].data == NULL) continue;
@@ -4059,9 +4249,6 @@ EG_ruledSpline(
         }
       }
     }
-
-    EG_free(xyzs);
-    xyzs = NULL;
   }
 
   stat = EGADS_SUCCESS;
@@ -4069,6 +4256,7 @@ EG_ruledSpline(
 cleanup:
   /* clean up all of our temps */
   EG_free(xyzs);
+  EG_free(strips);
   if (ncp != NULL) EG_freeSeq(nstripe, ncp);
   if (stat != EGADS_SUCCESS) {
     EG_free(nodes);
@@ -15,6 +15,7 @@
 
 #include "egads.h"
 #include "egads_dot.h"
+#include "emp.h"
 #include "Surreal/SurrealS.h"
 #include "Surreal/SurrealD.h"
 
@@ -27,6 +28,7 @@
 #define NITER    10000
 #define RELAX    0.15
 #define MAXDEG   21
+#define MTAPPX   16384   /* surface points before the rows are colored */
 #define CROSS(a,b,c)       a[0] = (b[1]*c[2]) - (b[2]*c[1]);\
                            a[1] = (b[2]*c[0]) - (b[0]*c[2]);\
                            a[2] = (b[0]*c[1]) - (b[1]*c[0])
@@ -374,6 +376,161 @@ EG_spline1dDeriv_dot(int *ivec, double *rdata, double *rdata_dot,
 }
 
 
+/* add a condition at knot u to the tridiagonal system for control point k:
+      scale * d^der/du^der (spline) = rhs
+   the fixed end control points are moved to the right hand side */
+
+template<class T>
+static int
+EG_spline1dRow(int k, int imax, T *knots, const T *cps, T u, int der,
+               T scale, const T *rhs, T *a, T *b, T *c, T *r)
+{
+  int i, j, m, span;
+  T   w, Nders[MAXDEG+1][MAXDEG+1], *Nder[MAXDEG+1];
+
+  for (i = 0; i <= 3; i++) Nder[i] = &Nders[i][0];
+  span = FindSpan(imax+6, 3, u, knots);
+  DersBasisFuns(span, 3, u, knots, der, Nder);
+
+  a[k] = b[k] = c[k] = 0.0;
+  r[3*k  ] = rhs[0];
+  r[3*k+1] = rhs[1];
+  r[3*k+2] = rhs[2];
+  for (j = 0; j <= 3; j++) {
+    m = span-3+j;
+    w = scale*Nders[der][j];
+    if (value(w) == 0.0) continue;
+    if ((m == 0) || (m == imax+1)) {
+      for (i = 0; i < 3; i++) r[3*k+i] -= w*cps[3*m+i];
+    } else if (m == k-1) {
+      a[k] += w;
+    } else if (m == k) {
+      b[k] += w;
+    } else if (m == k+1) {
+      c[k] += w;
+    } else {
+      return EGADS_OUTSIDE;
+    }
+  }
+
+  return EGADS_SUCCESS;
+}
+
+
+/* solve for the free control points directly (the conditions applied in the
+   iterations of EG_spline1dFit_impl) -- cps[1] through cps[imax] are only
+   touched on success */
+
+template<class T>
+static int
+EG_spline1dBand(int imax, int endc, /*@null@*/ const T *t1, const T *xyz,
+                /*@null@*/ const T *tn, T *knots, T *cps)
+{
+  int i, k, stat;
+  T   du, u20, u21, scale, rhs[3], *a, *b, *c, *r;
+
+  a = (T *) EG_alloc(6*(imax+2)*sizeof(T));
+  if (a == NULL) return EGADS_MALLOC;
+  b = &a[  imax+2];
+  c = &a[2*(imax+2)];
+  r = &a[3*(imax+2)];
+
+  /* condition at beginning */
+  du = knots[4] - knots[3];
+  if (t1 != NULL) {
+    rhs[0] = t1[0];
+    rhs[1] = t1[1];
+    rhs[2] = t1[2];
+    stat   = EG_spline1dRow(1, imax, knots, cps, knots[3], 1, du, rhs,
+                            a, b, c, r);
+  } else if (endc == 0) {
+    rhs[0] = rhs[1] = rhs[2] = 0.0;
+    scale  = 1.0;
+    stat   = EG_spline1dRow(1, imax, knots, cps, knots[3], 2, scale, rhs,
+                            a, b, c, r);
+  } else if (endc == 1) {
+    for (i = 0; i < 3; i++) rhs[i] = xyz[3+i] - xyz[i];
+    stat   = EG_spline1dRow(1, imax, knots, cps, knots[3], 1, du, rhs,
+                            a, b, c, r);
+  } else {
+    u20 = knots[5] - knots[3];
+    u21 = knots[5] - knots[4];
+    for (i = 0; i < 3; i++)
+      rhs[i] = (xyz[3+i]*u20*u20 - xyz[i]*u21*u21 - xyz[6+i]*du*du) /
+               (2.0*u21*du) - xyz[i];
+    scale  = 0.5*u20;
+    stat   = EG_spline1dRow(1, imax, knots, cps, knots[3], 1, scale, rhs,
+                            a, b, c, r);
+  }
+
+  /* interior spline points */
+  for (i = 1; i < imax-1; i++) {
+    if (stat != EGADS_SUCCESS) break;
+    scale = 1.0;
+    stat  = EG_spline1dRow(i+1, imax, knots, cps, knots[i+3], 0, scale,
+                           &xyz[3*i], a, b, c, r);
+  }
+
+  /* condition at end */
+  du = knots[imax+2] - knots[imax+1];
+  if (stat != EGADS_SUCCESS) {
+  } else if (tn != NULL) {
+    rhs[0] = tn[0];
+    rhs[1] = tn[1];
+    rhs[2] = tn[2];
+    stat   = EG_spline1dRow(imax, imax, knots, cps, knots[imax+2], 1, du, rhs,
+                            a, b, c, r);
+  } else if (endc == 0) {
+    rhs[0] = rhs[1] = rhs[2] = 0.0;
+    scale  = 1.0;
+    stat   = EG_spline1dRow(imax, imax, knots, cps, knots[imax+2], 2, scale,
+                            rhs, a, b, c, r);
+  } else if (endc == 1) {
+    for (i = 0; i < 3; i++) rhs[i] = xyz[3*(imax-1)+i] - xyz[3*(imax-2)+i];
+    stat   = EG_spline1dRow(imax, imax, knots, cps, knots[imax+2], 1, du, rhs,
+                            a, b, c, r);
+  } else {
+    u20 = knots[imax+2] - knots[imax];
+    u21 = knots[imax+1] - knots[imax];
+    for (i = 0; i < 3; i++)
+      rhs[i] = xyz[3*(imax-1)+i] -
+               (xyz[3*(imax-2)+i]*u20*u20 - xyz[3*(imax-1)+i]*u21*u21 -
+                xyz[3*(imax-3)+i]*du*du) / (2.0*u21*du);
+    scale  = 0.5*u20;
+    stat   = EG_spline1dRow(imax, imax, knots, cps, knots[imax+2], 1, scale,
+                            rhs, a, b, c, r);
+  }
+  if (stat != EGADS_SUCCESS) {
+    EG_free(a);
+    return stat;
+  }
+
+  /* forward elimination (Thomas) */
+  for (k = 1; k <= imax; k++) {
+    if (k > 1) {
+      b[k] -= a[k]*c[k-1];
+      for (i = 0; i < 3; i++) r[3*k+i] -= a[k]*r[3*k-3+i];
+    }
+    if (fabs(value(b[k])) <= 1.e-12*(fabs(value(a[k]))+fabs(value(c[k])))) {
+      EG_free(a);
+      return EGADS_DEGEN;
+    }
+    c[k] /= b[k];
+    for (i = 0; i < 3; i++) r[3*k+i] /= b[k];
+  }
+
+  /* back substitution */
+  for (k = imax; k >= 1; k--) {
+    if (k < imax)
+      for (i = 0; i < 3; i++) r[3*k+i] -= c[k]*r[3*k+3+i];
+    for (i = 0; i < 3; i++) cps[3*k+i] = r[3*k+i];
+  }
+
+  EG_free(a);
+  return EGADS_SUCCESS;
+}
+
+
 /*
  ************************************************************************
  *                                                                      *
@@ -621,6 +778,14 @@ EG_spline1dFit_impl(int endx, int imaxx, const T *t1, const T *xyz, const T *tn,
     cps[kk++] = xyz[3*(imax-1)+1];
     cps[kk++] = xyz[3*(imax-1)+2];
 
+    /* solve directly when not periodic & there are no flat spots -- the
+       iterations then only confirm the result (or start from the guess
+       above on failure) */
+    for (i = 0; i < imax; i++)
+        if ((mdata[i] == -2) || (mdata[i] == +2)) break;
+    if ((i == imax) && (periodic == 0))
+        (void) EG_spline1dBand(imax, endc, t1, xyz, tn, knots, cps);
+
     /* iterate to have knot evaluations match data points */
     for (iter = 0; iter < NITER; iter++) {
         dxyzmax = 0.0;
@@ -1104,6 +1269,184 @@ EG_spline1d(egObject *context, int endx, int imaxx, const double *xyz,
 }
 
 
+typedef struct {
+  void         *mutex;          /* the mutex or NULL for single thread */
+  long         master;          /* master thread ID */
+  int          index;           /* next curve to fit */
+  int          end;             /* number of curves */
+  int          endx;            /* the end condition */
+  double       tol;             /* the fit tolerance */
+  const int    *imaxs;          /* the (signed) number of points per curve */
+  const double **xyzs;          /* the points per curve */
+  int          *ivecs;          /* the headers -- 4 per curve */
+  double       **rvecs;         /* the data per curve */
+  int          *stats;          /* the status per curve */
+} EMPspline1d;
+
+
+static void
+EG_spline1dThread(void *struc)
+{
+  int         index;
+  long        ID;
+  EMPspline1d *sthread;
+
+  sthread = (EMPspline1d *) struc;
+
+  /* get our identifier */
+  ID = EMP_ThreadID();
+
+  /* look for work */
+  for (;;) {
+
+    /* only one thread at a time here -- controlled by a mutex! */
+    if (sthread->mutex != NULL) EMP_LockSet(sthread->mutex);
+    index = sthread->index;
+    sthread->index++;
+    if (sthread->mutex != NULL) EMP_LockRelease(sthread->mutex);
+    if (index >= sthread->end) break;
+
+    /* do the work */
+    sthread->stats[index] =
+      EG_spline1dFit_impl<double>(sthread->endx, sthread->imaxs[index], NULL,
+                                  sthread->xyzs[index], NULL, NULL,
+                                  sthread->tol, &sthread->ivecs[4*index],
+                                  sthread->rvecs[index]);
+  }
+
+  /* exhausted all work -- exit */
+  if (ID != sthread->master) EMP_ThreadExit();
+}
+
+
+extern "C"
+int
+EG_spline1dBatch(egObject *context, int endx, int ncrv, const int *imaxs,
+                 const double **xyzs, double tol, egObject **ecurvs)
+{
+  int         i, np, stat, fixed, imax, len, *imaxx = NULL, *ivecs = NULL;
+  int         *stats = NULL;
+  double      *rvec = NULL, **rvecs = NULL;
+  void        **threads = NULL;
+  EMPspline1d sthread;
+
+  for (i = 0; i < ncrv; i++) ecurvs[i] = NULL;
+  if (context == NULL)               return EGADS_NULLOBJ;
+  if (context->magicnumber != MAGIC) return EGADS_NOTOBJ;
+  if (context->oclass != CONTXT)     return EGADS_NOTCNTX;
+  if ((endx < -1) || (endx > 2))     return EGADS_RANGERR;
+  if (ncrv <= 0)                     return EGADS_SUCCESS;
+
+  /* the setup shared by all of the curves -- a single block for the data */
+  fixed = EG_fixedKnots(context);
+  imaxx = (int *)     EG_alloc(6*ncrv*sizeof(int));
+  rvecs = (double **) EG_alloc(ncrv*sizeof(double *));
+  if ((imaxx == NULL) || (rvecs == NULL)) {
+    stat = EGADS_MALLOC;
+    goto cleanup;
+  }
+  ivecs = &imaxx[  ncrv];
+  stats = &imaxx[5*ncrv];
+  for (len = i = 0; i < ncrv; i++) {
+    imax = imaxs[i];
+    if (imax < 0) imax = -imax;
+    if (imax < 2) {
+      stat = EGADS_DEGEN;
+      goto cleanup;
+    }
+    imaxx[i] = imaxs[i];
+    if ((fixed != 0) && (imaxx[i] > 0)) imaxx[i] = -imaxx[i];
+    len += (imax+6) + 6*(imax+2);
+  }
+  rvec = (double *) EG_alloc(len*sizeof(double));
+  if (rvec == NULL) {
+    stat = EGADS_MALLOC;
+    goto cleanup;
+  }
+  for (len = i = 0; i < ncrv; i++) {
+    imax     = imaxs[i];
+    if (imax < 0) imax = -imax;
+    rvecs[i] = &rvec[len];
+    len     += (imax+6) + 6*(imax+2);
+  }
+
+  /* set up for explicit multithreading */
+  sthread.mutex  = NULL;
+  sthread.master = EMP_ThreadID();
+  sthread.index  = 0;
+  sthread.end    = ncrv;
+  sthread.endx   = endx;
+  sthread.tol    = tol;
+  sthread.imaxs  = imaxx;
+  sthread.xyzs   = xyzs;
+  sthread.ivecs  = ivecs;
+  sthread.rvecs  = rvecs;
+  sthread.stats  = stats;
+
+  np = EMP_Init(NULL);
+  if (ncrv < np) np = ncrv;
+  if (np > 1) {
+    /* create the mutex to handle list synchronization */
+    sthread.mutex = EMP_LockCreate();
+    if (sthread.mutex == NULL) {
+      printf(" EMP Error: mutex creation = NULL!\n");
+      np = 1;
+    } else {
+      /* get storage for our extra threads */
+      threads = (void **) malloc((np-1)*sizeof(void *));
+      if (threads == NULL) {
+        EMP_LockDestroy(sthread.mutex);
+        sthread.mutex = NULL;
+        np = 1;
+      }
+    }
+  }
+
+  /* create the threads and get going! */
+  if (threads != NULL)
+    for (i = 0; i < np-1; i++) {
+      threads[i] = EMP_ThreadCreate(EG_spline1dThread, &sthread);
+      if (threads[i] == NULL)
+        printf(" EMP Error Creating Thread #%d!\n", i+1);
+    }
+  /* now run the thread block from the original thread */
+  EG_spline1dThread(&sthread);
+
+  /* wait for all others to return */
+  if (threads != NULL)
+    for (i = 0; i < np-1; i++)
+      if (threads[i] != NULL) EMP_ThreadWait(threads[i]);
+
+  /* cleanup */
+  if (threads != NULL)
+    for (i = 0; i < np-1; i++)
+      if (threads[i] != NULL) EMP_ThreadDestroy(threads[i]);
+  if (sthread.mutex != NULL) EMP_LockDestroy(sthread.mutex);
+  if (threads != NULL) free(threads);
+
+  /* make the curves in order from this thread */
+  for (i = 0; i < ncrv; i++) {
+    stat = stats[i];
+    if (stat != EGADS_SUCCESS) break;
+    stat = EG_makeGeometry(context, CURVE, BSPLINE, NULL, &ivecs[4*i],
+                           rvecs[i], &ecurvs[i]);
+    if (stat != EGADS_SUCCESS) break;
+  }
+  if (stat != EGADS_SUCCESS)
+    for (i = 0; i < ncrv; i++)
+      if (ecurvs[i] != NULL) {
+        EG_deleteObject(ecurvs[i]);
+        ecurvs[i] = NULL;
+      }
+
+cleanup:
+  if (rvec  != NULL) EG_free(rvec);
+  if (rvecs != NULL) EG_free(rvecs);
+  if (imaxx != NULL) EG_free(imaxx);
+  return stat;
+}
+
+
 extern "C"
 int
 EG_spline1dPCrv(egObject *context, int endx, int imax, const double *xy,
@@ -1405,6 +1748,231 @@ EG_getEllRad(const T *drnd, T *nell)
 }
 
 
+/* match the interior spline points in a row -- the evaluations use the
+   control points saved at the start of the iteration (rvec) */
+
+template<class T>
+static T
+EG_appxRow(int j, int imax, const T *xyz, const T *knotu, const T *knotv,
+           /*@null@*/ const int *vdata, int *header, T *rvec, T *cp)
+{
+    int i;
+    T   dx, dy, dz, dv, dxyzmax, uv[2], eval[18];
+
+    dxyzmax = 0.0;
+    uv[1] = knotv[j+3];
+    if (vdata != NULL) {
+        if (vdata[j] == +2) {
+            /* multiplicity 2 with flat spot on right
+               note: j is the second repeated data point */
+            dv = knotv[j+4] - knotv[j+3];
+            for (i = 1; i < imax-1; i++) {
+                uv[0] = knotu[i+3];
+                EG_spline2dDeriv_impl(header, rvec, 2, uv, eval);
+                dx = xyz[3*((i)+(j+1)*imax)  ] -
+                     xyz[3*((i)+(j  )*imax)  ] - dv*eval[ 9];
+                dy = xyz[3*((i)+(j+1)*imax)+1] -
+                     xyz[3*((i)+(j  )*imax)+1] - dv*eval[10];
+                dz = xyz[3*((i)+(j+1)*imax)+2] -
+                     xyz[3*((i)+(j  )*imax)+2] - dv*eval[11];
+                if (fabs(dx) > dxyzmax) dxyzmax = fabs(dx);
+                if (fabs(dy) > dxyzmax) dxyzmax = fabs(dy);
+                if (fabs(dz) > dxyzmax) dxyzmax = fabs(dz);
+                cp[3*((i+1)+(j+1)*(imax+2))  ] += RELAX * dx;
+                cp[3*((i+1)+(j+1)*(imax+2))+1] += RELAX * dy;
+                cp[3*((i+1)+(j+1)*(imax+2))+2] += RELAX * dz;
+            }
+            return dxyzmax;
+        }
+        if (vdata[j] == -2) {
+            /* multiplicity 2 with flat spot on left
+               note: j is the first repeated data point */
+            dv = knotv[j+3] - knotv[j+2];
+            for (i = 1; i < imax-1; i++) {
+                uv[0] = knotu[i+3];
+                EG_spline2dDeriv_impl(header, rvec, 2, uv, eval);
+                dx = xyz[3*((i)+(j-1)*imax)  ] -
+                     xyz[3*((i)+(j  )*imax)  ] + dv*eval[ 9];
+                dy = xyz[3*((i)+(j-1)*imax)+1] -
+                     xyz[3*((i)+(j  )*imax)+1] + dv*eval[10];
+                dz = xyz[3*((i)+(j-1)*imax)+2] -
+                     xyz[3*((i)+(j  )*imax)+2] + dv*eval[11];
+                if (fabs(dx) > dxyzmax) dxyzmax = fabs(dx);
+                if (fabs(dy) > dxyzmax) dxyzmax = fabs(dy);
+                if (fabs(dz) > dxyzmax) dxyzmax = fabs(dz);
+                cp[3*((i+1)+(j+1)*(imax+2))  ] += RELAX * dx;
+                cp[3*((i+1)+(j+1)*(imax+2))+1] += RELAX * dy;
+                cp[3*((i+1)+(j+1)*(imax+2))+2] += RELAX * dz;
+            }
+            return dxyzmax;
+        }
+    }
+
+    for (i = 1; i < imax-1; i++) {
+        uv[0] = knotu[i+3];
+        EG_spline2dEval_impl(header, rvec, uv, eval);
+        dx = xyz[3*((i)+(j)*imax)  ] - eval[0];
+        dy = xyz[3*((i)+(j)*imax)+1] - eval[1];
+        dz = xyz[3*((i)+(j)*imax)+2] - eval[2];
+        if (fabs(dx) > dxyzmax) dxyzmax = fabs(dx);
+        if (fabs(dy) > dxyzmax) dxyzmax = fabs(dy);
+        if (fabs(dz) > dxyzmax) dxyzmax = fabs(dz);
+        cp[3*((i+1)+(j+1)*(imax+2))  ] += dx;
+        cp[3*((i+1)+(j+1)*(imax+2))+1] += dy;
+        cp[3*((i+1)+(j+1)*(imax+2))+2] += dz;
+    }
+
+    return dxyzmax;
+}
+
+
+template<class T>
+static T
+EG_appxInterior(int imax, int jmax, const T *xyz, const T *knotu,
+                const T *knotv, /*@null@*/ const int *vdata, int *header,
+                T *rvec, T *cp)
+{
+    int j;
+    T   dxyzmax, rmax;
+
+    dxyzmax = 0.0;
+    for (j = 1; j < jmax-1; j++) {
+        rmax = EG_appxRow(j, imax, xyz, knotu, knotv, vdata, header, rvec, cp);
+        if (rmax > dxyzmax) dxyzmax = rmax;
+    }
+
+    return dxyzmax;
+}
+
+
+typedef struct {
+  void         *mutex;          /* the mutex or NULL for single thread */
+  long         master;          /* master thread ID */
+  int          index;           /* next row */
+  int          end;             /* number of rows */
+  int          imax;            /* points in a row */
+  const double *xyz;            /* the data points */
+  const double *knotu;          /* the U knots */
+  const double *knotv;          /* the V knots */
+  const int    *vdata;          /* the V multiplicities (or NULL) */
+  int          *header;         /* the spline header */
+  double       *rvec;           /* the spline data being evaluated */
+  double       *cp;             /* the control points being updated */
+  double       dxyzmax;         /* the largest change */
+} EMPappx;
+
+
+static void
+EG_appxThread(void *struc)
+{
+  int     index;
+  long    ID;
+  double  rmax, dxyzmax = 0.0;
+  EMPappx *athread;
+
+  athread = (EMPappx *) struc;
+
+  /* get our identifier */
+  ID = EMP_ThreadID();
+
+  /* look for work */
+  for (;;) {
+
+    /* only one thread at a time here -- controlled by a mutex! */
+    if (athread->mutex != NULL) EMP_LockSet(athread->mutex);
+    index = athread->index;
+    athread->index++;
+    if (athread->mutex != NULL) EMP_LockRelease(athread->mutex);
+    if (index >= athread->end) break;
+
+    /* do the work -- the rows only write their own control points */
+    rmax = EG_appxRow(index+1, athread->imax, athread->xyz, athread->knotu,
+                      athread->knotv, athread->vdata, athread->header,
+                      athread->rvec, athread->cp);
+    if (rmax > dxyzmax) dxyzmax = rmax;
+  }
+
+  /* the maximum does not depend on the order */
+  if (athread->mutex != NULL) EMP_LockSet(athread->mutex);
+  if (dxyzmax > athread->dxyzmax) athread->dxyzmax = dxyzmax;
+  if (athread->mutex != NULL) EMP_LockRelease(athread->mutex);
+
+  /* exhausted all work -- exit */
+  if (ID != athread->master) EMP_ThreadExit();
+}
+
+
+static double
+EG_appxInterior(int imax, int jmax, const double *xyz, const double *knotu,
+                const double *knotv, /*@null@*/ const int *vdata, int *header,
+                double *rvec, double *cp)
+{
+  int     i, np = 1;
+  void    **threads = NULL;
+  EMPappx athread;
+
+  if (imax*jmax >= MTAPPX) np = EMP_Init(NULL);
+  if (jmax-2 < np) np = jmax-2;
+  if (np <= 1)
+    return EG_appxInterior<double>(imax, jmax, xyz, knotu, knotv, vdata,
+                                   header, rvec, cp);
+
+  /* set up for explicit multithreading */
+  athread.mutex   = NULL;
+  athread.master  = EMP_ThreadID();
+  athread.index   = 0;
+  athread.end     = jmax-2;
+  athread.imax    = imax;
+  athread.xyz     = xyz;
+  athread.knotu   = knotu;
+  athread.knotv   = knotv;
+  athread.vdata   = vdata;
+  athread.header  = header;
+  athread.rvec    = rvec;
+  athread.cp      = cp;
+  athread.dxyzmax = 0.0;
+
+  /* create the mutex to handle list synchronization */
+  athread.mutex = EMP_LockCreate();
+  if (athread.mutex == NULL) {
+    printf(" EMP Error: mutex creation = NULL!\n");
+    np = 1;
+  } else {
+    /* get storage for our extra threads */
+    threads = (void **) malloc((np-1)*sizeof(void *));
+    if (threads == NULL) {
+      EMP_LockDestroy(athread.mutex);
+      athread.mutex = NULL;
+      np = 1;
+    }
+  }
+
+  /* create the threads and get going! */
+  if (threads != NULL)
+    for (i = 0; i < np-1; i++) {
+      threads[i] = EMP_ThreadCreate(EG_appxThread, &athread);
+      if (threads[i] == NULL)
+        printf(" EMP Error Creating Thread #%d!\n", i+1);
+    }
+  /* now run the thread block from the original thread */
+  EG_appxThread(&athread);
+
+  /* wait for all others to return */
+  if (threads != NULL)
+    for (i = 0; i < np-1; i++)
+      if (threads[i] != NULL) EMP_ThreadWait(threads[i]);
+
+  /* cleanup */
+  if (threads != NULL)
+    for (i = 0; i < np-1; i++)
+      if (threads[i] != NULL) EMP_ThreadDestroy(threads[i]);
+  if (athread.mutex != NULL) EMP_LockDestroy(athread.mutex);
+  if (threads != NULL) free(threads);
+
+  return athread.dxyzmax;
+}
+
+
 /*
  ************************************************************************
  *                                                                      *
@@ -2125,73 +2693,11 @@ EG_spline2dAppr(int endcx, int imaxx, int jmaxx, const T *xyz,
     /* iterate to have knot evaluations match data points */
     for (iter = 0; iter < NITER; iter++) {
 
-        dxyzmax = 0.0;
         for (i = 0; i < 3*icp*jcp; i++) cpsav[i] = cp[i];
 
         /* match interior spline points */
-        for (j = 1; j < jmax-1; j++) {
-            uv[1] = knotv[j+3];
-            if (vdata != NULL) {
-                if (vdata[j] == +2) {
-                    /* multiplicity 2 with flat spot on right
-                       note: j is the second repeated data point */
-                    dv = knotv[j+4] - knotv[j+3];
-                    for (i = 1; i < imax-1; i++) {
-                        uv[0] = knotu[i+3];
-                        EG_spline2dDeriv_impl(header, rvec, 2, uv, eval);
-                        dx = xyz[3*((i)+(j+1)*imax)  ] -
-                             xyz[3*((i)+(j  )*imax)  ] - dv*eval[ 9];
-                        dy = xyz[3*((i)+(j+1)*imax)+1] -
-                             xyz[3*((i)+(j  )*imax)+1] - dv*eval[10];
-                        dz = xyz[3*((i)+(j+1)*imax)+2] -
-                             xyz[3*((i)+(j  )*imax)+2] - dv*eval[11];
-                        if (fabs(dx) > dxyzmax) dxyzmax = fabs(dx);
-                        if (fabs(dy) > dxyzmax) dxyzmax = fabs(dy);
-                        if (fabs(dz) > dxyzmax) dxyzmax = fabs(dz);
-                        cp[3*((i+1)+(j+1)*(imax+2))  ] += RELAX * dx;
-                        cp[3*((i+1)+(j+1)*(imax+2))+1] += RELAX * dy;
-                        cp[3*((i+1)+(j+1)*(imax+2))+2] += RELAX * dz;
-                    }
-                    continue;
-                }
-                if (vdata[j] == -2) {
-                    /* multiplicity 2 with flat spot on left
-                       note: j is the first repeated data point */
-                    dv = knotv[j+3] - knotv[j+2];
-                    for (i = 1; i < imax-1; i++) {
-                        uv[0] = knotu[i+3];
-                        EG_spline2dDeriv_impl(header, rvec, 2, uv, eval);
-                        dx = xyz[3*((i)+(j-1)*imax)  ] -
-                             xyz[3*((i)+(j  )*imax)  ] + dv*eval[ 9];
-                        dy = xyz[3*((i)+(j-1)*imax)+1] -
-                             xyz[3*((i)+(j  )*imax)+1] + dv*eval[10];
-                        dz = xyz[3*((i)+(j-1)*imax)+2] -
-                             xyz[3*((i)+(j  )*imax)+2] + dv*eval[11];
-                        if (fabs(dx) > dxyzmax) dxyzmax = fabs(dx);
-                        if (fabs(dy) > dxyzmax) dxyzmax = fabs(dy);
-                        if (fabs(dz) > dxyzmax) dxyzmax = fabs(dz);
-                        cp[3*((i+1)+(j+1)*(imax+2))  ] += RELAX * dx;
-                        cp[3*((i+1)+(j+1)*(imax+2))+1] += RELAX * dy;
-                        cp[3*((i+1)+(j+1)*(imax+2))+2] += RELAX * dz;
-                    }
-                    continue;
-                }
-            }
-
-            for (i = 1; i < imax-1; i++) {
-                uv[0] = knotu[i+3];
-                EG_spline2dEval_impl(header, rvec, uv, eval);
-                dx = xyz[3*((i)+(j)*imax)  ] - eval[0];
-                dy = xyz[3*((i)+(j)*imax)+1] - eval[1];
-                dz = xyz[3*((i)+(j)*imax)+2] - eval[2];
-                if (fabs(dx) > dxyzmax) dxyzmax = fabs(dx);
-                if (fabs(dy) > dxyzmax) dxyzmax = fabs(dy);
-                if (fabs(dz) > dxyzmax) dxyzmax = fabs(dz);
-                cp[3*((i+1)+(j+1)*(imax+2))  ] += dx;
-                cp[3*((i+1)+(j+1)*(imax+2))+1] += dy;
-                cp[3*((i+1)+(j+1)*(imax+2))+2] += dz;
-            }
-        }
+        dxyzmax = EG_appxInterior(imax, jmax, xyz, knotu, knotv, vdata,
+                                  header, rvec, cp);
 
         /* point A */
         uv[0] = knotu[3];
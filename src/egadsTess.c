@@ -37,6 +37,7 @@
 
 #define NOTFILLED	-1
 #define TOL		 1.e-7
+#define FILLGRID         128    /* front size to index in EG_fillArea */
 #define UVTOL            1.e-4
 
 
@@ -122,6 +123,7 @@ __PROTO_H_AND_D__ int  EG_effectiveMap( egObject *EObject, double *eparam,
                                         /*@null@*/ const char   *str );
 #endif
 
+__PROTO_H_AND_D__ void EG_cleanupEdgeEdits( egTessel *btess );
 __PROTO_H_AND_D__ int  EG_tessellate( int outLevel, triStruct *ts, long tID );
 __PROTO_H_AND_D__ int  EG_quadFill( const egObject *face, double *parms,
                                     int *elens, double *uv, int *npts,
@@ -356,152 +358,632 @@ EG_checkTriangulation(egTessel *btess)
 #endif
 
 
+/*
+ * spatial index of the front for larger loops -- the loop vertices are
+ * bucketed in a uniform grid and the front segments are threaded by their
+ * right vertex; segments longer than a cell are kept in separate lists
+ */
+
+__HOST_AND_DEVICE__ static double
+EG_segLen2(const double *vertices, int i0, int i1)
+{
+  const double *uv0 = &vertices[2*i0], *uv1 = &vertices[2*i1];
+  
+  return DIST2(uv0, uv1);
+}
+
+
+__HOST_AND_DEVICE__ static void
+EG_frontUnlink(fillArea *fa, int s, int side)
+{
+  int       *vhead;
+  FrontLink *link = fa->link;
+  
+  if (link[s].vert[side] == -1) return;
+  vhead = &fa->grid[fa->ngrid[0]*fa->ngrid[1] + 1 + fa->nsegs +
+                    side*(fa->nsegs+1)];
+  if (link[s].prev[side] == -1) {
+    vhead[link[s].vert[side]] = link[s].next[side];
+  } else {
+    link[link[s].prev[side]].next[side] = link[s].next[side];
+  }
+  if (link[s].next[side] != -1)
+    link[link[s].next[side]].prev[side] = link[s].prev[side];
+  link[s].vert[side] = link[s].prev[side] = link[s].next[side] = -1;
+}
+
+
+__HOST_AND_DEVICE__ static void
+EG_frontLink(fillArea *fa, int s, const double *vertices)
+{
+  int       i, v, prev, next, *vhead;
+  double    cs;
+  FrontLink *link;
+
+  if (fa->ngrid[0] == 0) return;
+  link = fa->link;
+  
+  for (i = 0; i < 2; i++) {
+    v = (i == 0) ? fa->front[s].i0 : fa->front[s].i1;
+    if (link[s].vert[i] == v) continue;
+    EG_frontUnlink(fa, s, i);
+    vhead = &fa->grid[fa->ngrid[0]*fa->ngrid[1] + 1 + fa->nsegs +
+                      i*(fa->nsegs+1)];
+    /* keep the list in index order */
+    prev = -1;
+    next = vhead[v];
+    while ((next != -1) && (next < s)) {
+      prev = next;
+      next = link[next].next[i];
+    }
+    link[s].vert[i] = v;
+    link[s].prev[i] = prev;
+    link[s].next[i] = next;
+    if (next != -1) link[next].prev[i] = s;
+    if (prev == -1) {
+      vhead[v] = s;
+    } else {
+      link[prev].next[i] = s;
+    }
+  }
+  
+  if (link[s].lng != -1) return;
+  cs = fa->gbox[2];
+  if (EG_segLen2(vertices, fa->front[s].i0, fa->front[s].i1) <= cs*cs) return;
+  link[fa->nlong[1]].list = s;
+  link[s].lng             = fa->nlong[1];
+  fa->nlong[1]++;
+}
+
+
+/* step through the segments that may be at a vertex (side 0 for the left
+ * vertex and 1 for the right) in index order -- the lists are kept sorted
+ * and closed segments are dropped as they are passed; all segments are
+ * visited when the front is not indexed                                  */
+
+__HOST_AND_DEVICE__ static int
+EG_frontIter(fillArea *fa, int side, int v, int last)
+{
+  int i, j;
+  
+  if (fa->ngrid[0] == 0) return last+1;
+  
+  if (last == -1) {
+    i = fa->grid[fa->ngrid[0]*fa->ngrid[1] + 1 + fa->nsegs +
+                 side*(fa->nsegs+1) + v];
+  } else {
+    i = fa->link[last].next[side];
+  }
+  while (i != -1) {
+    if (fa->front[i].sright != NOTFILLED) return i;
+    j = fa->link[i].next[side];
+    EG_frontUnlink(fa, i, side);
+    i = j;
+  }
+  
+  return fa->nfront;
+}
+
+
+__HOST_AND_DEVICE__ static int
+EG_frontIndex(fillArea *fa, const double *vertices)
+{
+  int       i, j, n, nv, nx, ny, ncell, *cell, *cvert, *vhead, *olong, *itmp;
+  double    umin, umax, vmin, vmax, cs, d;
+  FrontLink *ltmp;
+
+  fa->ngrid[0] = fa->ngrid[1] = 0;
+  fa->nlong[0] = fa->nlong[1] = 0;
+  nv = fa->nsegs;
+
+  umin = umax = vertices[2];
+  vmin = vmax = vertices[3];
+  for (i = 2; i <= nv; i++) {
+    if (vertices[2*i  ] < umin) umin = vertices[2*i  ];
+    if (vertices[2*i  ] > umax) umax = vertices[2*i  ];
+    if (vertices[2*i+1] < vmin) vmin = vertices[2*i+1];
+    if (vertices[2*i+1] > vmax) vmax = vertices[2*i+1];
+  }
+  d  = MAX(umax-umin, vmax-vmin);
+  cs = sqrt((umax-umin)*(vmax-vmin)/nv);
+  if (cs < d/nv) cs = d/nv;
+  if (cs <= 0.0) return EGADS_DEGEN;
+  nx    = (umax-umin)/cs + 1;
+  ny    = (vmax-vmin)/cs + 1;
+  ncell = nx*ny;
+
+  /* cell starts, cell vertices, vertex heads & long original segments */
+  n = ncell + 1 + nv + 2*nv + 2 + nv;
+  if (fa->grid == NULL) {
+    fa->grid = (int *) EG_alloc(n*sizeof(int));
+    if (fa->grid == NULL) return EGADS_MALLOC;
+    fa->mgrid = n;
+  } else if (fa->mgrid < n) {
+    itmp = (int *) EG_reall(fa->grid, n*sizeof(int));
+    if (itmp == NULL) return EGADS_MALLOC;
+    fa->mgrid = n;
+    fa->grid  = itmp;
+  }
+  if (fa->link == NULL) {
+    fa->link = (FrontLink *) EG_alloc(fa->mfront*sizeof(FrontLink));
+    if (fa->link == NULL) return EGADS_MALLOC;
+    fa->mlink = fa->mfront;
+  } else if (fa->mlink < fa->mfront) {
+    ltmp = (FrontLink *) EG_reall(fa->link, fa->mfront*sizeof(FrontLink));
+    if (ltmp == NULL) return EGADS_MALLOC;
+    fa->mlink = fa->mfront;
+    fa->link  = ltmp;
+  }
+  cell  = fa->grid;
+  cvert = &cell[ncell+1];
+  vhead = &cvert[nv];
+  olong = &vhead[2*nv+2];
+
+  /* bucket the vertices */
+  for (i = 0; i <= ncell; i++) cell[i] = 0;
+  for (i = 1; i <= nv; i++) {
+    j = (int) ((vertices[2*i  ]-umin)/cs);
+    n = (int) ((vertices[2*i+1]-vmin)/cs);
+    if (j >= nx) j = nx-1;
+    if (n >= ny) n = ny-1;
+    cell[n*nx+j+1]++;
+  }
+  for (i = 0; i < ncell; i++) cell[i+1] += cell[i];
+  for (i = 1; i <= nv; i++) {
+    j = (int) ((vertices[2*i  ]-umin)/cs);
+    n = (int) ((vertices[2*i+1]-vmin)/cs);
+    if (j >= nx) j = nx-1;
+    if (n >= ny) n = ny-1;
+    cvert[cell[n*nx+j]] = i;
+    cell[n*nx+j]++;
+  }
+  for (i = ncell; i > 0; i--) cell[i] = cell[i-1];
+  cell[0] = 0;
+
+  /* original segments too long to be found from their right vertex */
+  for (i = 0; i < nv; i++)
+    if (EG_segLen2(vertices, fa->segs[2*i], fa->segs[2*i+1]) > cs*cs) {
+      olong[fa->nlong[0]] = i;
+      fa->nlong[0]++;
+    }
+
+  /* thread the front by its vertices */
+  for (i = 0; i < 2*nv+2; i++) vhead[i] = -1;
+  for (i = 0; i < fa->mlink; i++) {
+    fa->link[i].next[0] = fa->link[i].prev[0] = fa->link[i].vert[0] = -1;
+    fa->link[i].next[1] = fa->link[i].prev[1] = fa->link[i].vert[1] = -1;
+    fa->link[i].lng     = -1;
+  }
+  fa->ngrid[0] = nx;
+  fa->ngrid[1] = ny;
+  fa->gbox[0]  = umin;
+  fa->gbox[1]  = vmin;
+  fa->gbox[2]  = cs;
+  for (i = fa->nfront-1; i >= 0; i--)
+    for (j = 0; j < 2; j++) {
+      n = (j == 0) ? fa->front[i].i0 : fa->front[i].i1;
+      n += j*(nv+1);
+      fa->link[i].vert[j] = n - j*(nv+1);
+      fa->link[i].next[j] = vhead[n];
+      if (vhead[n] != -1) fa->link[vhead[n]].prev[j] = i;
+      vhead[n] = i;
+    }
+
+  return EGADS_SUCCESS;
+}
+
+
+/* get the range of cells covering a box in UV */
+
+__HOST_AND_DEVICE__ static void
+EG_frontCells(const fillArea *fa, double umin, double umax, double vmin,
+              double vmax, int *range)
+{
+  double cs = fa->gbox[2];
+  
+  range[0] = range[2] = 0;
+  range[1] = fa->ngrid[0]-1;
+  range[3] = fa->ngrid[1]-1;
+  if (umin > fa->gbox[0]) range[0] = MIN((umin-fa->gbox[0])/cs, range[1]);
+  if (vmin > fa->gbox[1]) range[2] = MIN((vmin-fa->gbox[1])/cs, range[3]);
+  if (umax < fa->gbox[0]) range[1] = -1;
+  else if (umax-fa->gbox[0] < range[1]*cs) range[1] = (umax-fa->gbox[0])/cs;
+  if (vmax < fa->gbox[1]) range[3] = -1;
+  else if (vmax-fa->gbox[1] < range[3]*cs) range[3] = (vmax-fa->gbox[1])/cs;
+}
+
+
 /* 
  * determine if this line segment crosses any active segments 
  * pass:      0 - first pass; conservative algorithm
  * 	      1 - second pass; use dirty tricks
  */
 
+typedef struct {
+  int    index;                 /* the front segment */
+  int    i2;                    /* the candidate vertex */
+  int    iF0;                   /* front segment vertices */
+  int    iF1;
+  int    pass;
+  double mid[2];                /* midpoint of the front segment */
+  double uv2[2];                /* candidate position */
+  double uvF0[2];
+  double uvF1[2];
+  double cosan;                 /* mid-uv2 coordinate frame */
+  double sinan;
+  double dist2;
+  double eps;
+} SegQuery;
+
+
+/* the transformed y of a point in the mid-uv2 frame -- zero on the line */
+
+__HOST_AND_DEVICE__ static double
+EG_queryY(const SegQuery *q, const double *uv)
+{
+  return (uv[1]-q->mid[1])*q->cosan - (uv[0]-q->mid[0])*q->sinan;
+}
+
+
+/* check against a segment of the current front */
+
 __HOST_AND_DEVICE__ static int
-EG_crossSeg(int index, const double *mid, int i2, const double *vertices, 
-            int pass, fillArea *fa)
+EG_crossFront(const SegQuery *q, int i, const double *vertices,
+              const fillArea *fa)
 {
-  int    i, i0, i1, iF0, iF1;
-  double angle, cosan, sinan, dist2, distF, eps, ty0, ty1, frac;
-  double uv0[2], uv1[2], uv2[2], x[2];
-  double uvF0[2], uvF1[2];
+  int    i0, i1;
+  double ty0, ty1, frac, uv0[2], uv1[2], x[2];
+
+  if ((i == q->index) || (fa->front[i].sright == NOTFILLED)) return 0;
+  if (fa->front[i].snew == 0) return 0;
+  i0 = fa->front[i].i0;
+  i1 = fa->front[i].i1;
+  if ((i0 == q->i2) || (i1 == q->i2)) return 0;
+  uv0[0] = vertices[2*i0  ];
+  uv0[1] = vertices[2*i0+1];
+  uv1[0] = vertices[2*i1  ];
+  uv1[1] = vertices[2*i1+1];
+
+  /* look to see if the transformed y's from uv2-mid cross 0.0 */
+  ty0 = EG_queryY(q, uv0);
+  ty1 = EG_queryY(q, uv1);
+  if ((ty0 == 0.0) && (ty1 == 0.0)) return 1;
+  if  (ty0*ty1 >= 0.0) return 0;
+
+  /* get fraction of line for crossing */
+  frac = -ty0/(ty1-ty0);
+  if ((frac < 0.0) || (frac > 1.0)) return 0;
+
+  /* get the actual coordinates */
+  x[0] = uv0[0] + frac*(uv1[0]-uv0[0]);
+  x[1] = uv0[1] + frac*(uv1[1]-uv0[1]);
+
+  /* are we in the range for the line seg? */
+  frac = (x[0]-q->mid[0])*q->cosan + (x[1]-q->mid[1])*q->sinan;
+  if ((frac > 0.0) && (frac*frac < q->dist2*(1.0+TOL))) return 2;
 
-  uv2[0] = vertices[2*i2  ];
-  uv2[1] = vertices[2*i2+1];
+  return 0;
+}
 
-  /*  Store away coordinates of front */
-  iF0 	  = fa->front[index].i0;
-  iF1 	  = fa->front[index].i1;
-  uvF0[0] = vertices[2*iF0  ];
-  uvF0[1] = vertices[2*iF0+1];
-  uvF1[0] = vertices[2*iF1  ];
-  uvF1[1] = vertices[2*iF1+1];
 
-  dist2  = DIST2( mid,  uv2);
-  distF  = DIST2(uvF0, uvF1);
-  eps    = (dist2 + distF) * DBL_EPSILON;
+/* check against a segment of our original loops */
 
-  /* transform so that we are in mid-uv2 coordinate frame */
-  angle = atan2(uv2[1]-mid[1], uv2[0]-mid[0]);
-  cosan = cos(angle);
-  sinan = sin(angle);
-
-  /* look at the current front */
-
-  for (i = 0; i < fa->nfront; i++) {
-    if ((i == index) || (fa->front[i].sright == NOTFILLED)) continue;
-    if (fa->front[i].snew == 0) continue;
-    i0 = fa->front[i].i0;
-    i1 = fa->front[i].i1;
-    if ((i0 == i2) || (i1 == i2)) continue;
-    uv0[0] = vertices[2*i0  ];
-    uv0[1] = vertices[2*i0+1];
-    uv1[0] = vertices[2*i1  ];
-    uv1[1] = vertices[2*i1+1];
+__HOST_AND_DEVICE__ static int
+EG_crossLoop(const SegQuery *q, int i, const double *vertices,
+             const fillArea *fa)
+{
+  int    i0, i1, i2, iF0, iF1;
+  double area10, area01, area11, area00, ty0, ty1, frac;
+  double uv0[2], uv1[2], x[2];
+  const double *uv2, *uvF0, *uvF1;
+
+  i2   = q->i2;
+  iF0  = q->iF0;
+  iF1  = q->iF1;
+  uv2  = q->uv2;
+  uvF0 = q->uvF0;
+  uvF1 = q->uvF1;
+  i0   = fa->segs[2*i  ];
+  i1   = fa->segs[2*i+1];
+
+  if (((i0 == fa->front[q->index].i0) && (i1 == fa->front[q->index].i1)) ||
+      ((i0 == fa->front[q->index].i1) && (i1 == fa->front[q->index].i0))) 
+    return 0;
+
+  uv0[0] = vertices[2*i0  ];
+  uv0[1] = vertices[2*i0+1];
+  uv1[0] = vertices[2*i1  ];
+  uv1[1] = vertices[2*i1+1];
+
+  if (q->pass != 0) {
+    area10 = AREA2D(uv2, uv1, uvF0);
+    area00 = AREA2D(uv2, uv0, uvF0);
+    area10 = ABS(area10);
+    area00 = ABS(area00);
+  }
+  if ((q->pass != 0) && area10 < q->eps && area00 < q->eps) {
+    /* I2 and Boundary Segment are collinear with IF0 (Front.I0) */
+    double del0[2], del1[2], del2[2];
+
+    VSUB2(uv2, uvF0, del2);
+    VSUB2(uv1, uvF0, del1);
+    VSUB2(uv0, uvF0, del0);
+    /*  See if I1 is between IF0 and I2 */
+    if (i1 != iF0 && DOT2(del2, del1) > 0 &&
+        DOT2(del2, del2) > DOT2(del1, del1)) return 5;
+    /*  See if I0 is between IF0 and I2 */
+    if (i0 != iF0 && DOT2(del2, del0) > 0 && 
+        DOT2(del2, del2) > DOT2(del0, del0)) return 6;
+  }
+  if (q->pass != 0) {
+    area11 = AREA2D(uv2, uv1, uvF1);
+    area01 = AREA2D(uv2, uv0, uvF1);
+    area11 = ABS(area11);
+    area01 = ABS(area01);
+  }
+  if ((q->pass != 0) && area11 < q->eps && area01 < q->eps) {
+    /* I2 and Boundary Segment are collinear with IF1 (Front.I1) */
+    double del0[2], del1[2], del2[2];
+
+    VSUB2(uv2, uvF1, del2);
+    VSUB2(uv1, uvF1, del1);
+    VSUB2(uv0, uvF1, del0);
+    /*  See if I1 is between IF1 and I2 */
+    if (i1 != iF1 && DOT2(del2, del1) > 0 &&
+        DOT2(del2, del2) > DOT2(del1, del1)) return 7;
+    /*  See if I0 is between IF1 and I2 */
+    if (i0 != iF1 && DOT2(del2, del0) > 0 && 
+        DOT2(del2, del2) > DOT2(del0, del0)) return 8;
+  }
+
+  if ((i1 == i2) || (i0 == i2)) return 0;
+  /* look to see if the transformed y's from uv2-mid cross 0.0 */
+  ty0 = EG_queryY(q, uv0);
+  ty1 = EG_queryY(q, uv1);
+  if ((ty0 == 0.0) && (ty1 == 0.0)) return 3;
+  if  (ty0*ty1 >= 0.0) return 0;
+
+  /* get fraction of line for crossing */
+  frac = -ty0/(ty1-ty0);
+  if ((frac < 0.0) || (frac > 1.0)) return 0;
+
+  /* get the actual coordinates */
+  x[0] = uv0[0] + frac*(uv1[0]-uv0[0]);
+  x[1] = uv0[1] + frac*(uv1[1]-uv0[1]);
+
+  /* are we in the range for the line seg? */
+  frac = (x[0]-q->mid[0])*q->cosan + (x[1]-q->mid[1])*q->sinan;
+  if ((frac > 0.0) && (frac*frac < q->dist2*(1.0+TOL))) return 4;
 
-    /* look to see if the transformed y's from uv2-mid cross 0.0 */
-    ty0 = (uv0[1]-mid[1])*cosan - (uv0[0]-mid[0])*sinan;
-    ty1 = (uv1[1]-mid[1])*cosan - (uv1[0]-mid[0])*sinan;
-    if ((ty0 == 0.0) && (ty1 == 0.0)) return 1;
-    if  (ty0*ty1 >= 0.0) continue;
+  return 0;
+}
 
-    /* get fraction of line for crossing */
-    frac = -ty0/(ty1-ty0);
-    if ((frac < 0.0) || (frac > 1.0)) continue;
 
-    /* get the actual coordinates */
-    x[0] = uv0[0] + frac*(uv1[0]-uv0[0]);
-    x[1] = uv0[1] + frac*(uv1[1]-uv0[1]);
+/* a segment on the query line vetoes however far away it is -- the long
+ * ones are always checked, so walk the cells along the line for the short
+ * ones (only a vertex on the line can end such a segment)                 */
 
-    /* are we in the range for the line seg? */
-    frac = (x[0]-mid[0])*cosan + (x[1]-mid[1])*sinan;
-    if ((frac > 0.0) && (frac*frac < dist2*(1.0+TOL))) return 2;
+__HOST_AND_DEVICE__ static int
+EG_crossLine(const SegQuery *q, const double *vertices, fillArea *fa)
+{
+  int    i, j, k, m, n, v, nx, ny, range[4], *cell, *cvert, *vhead;
+  double cs, ext, a0, a1, b0, b1, slope;
+
+  nx    = fa->ngrid[0];
+  ny    = fa->ngrid[1];
+  cs    = fa->gbox[2];
+  cell  = fa->grid;
+  cvert = &cell[nx*ny+1];
+  vhead = &cvert[2*fa->nsegs+1];
+  ext   = TOL*(MAX(nx, ny) + 1)*cs;
+
+  /* step along the columns (or rows) the line crosses more slowly */
+  for (k = 0; k < ((ABS(q->cosan) >= ABS(q->sinan)) ? nx : ny); k++) {
+    if (ABS(q->cosan) >= ABS(q->sinan)) {
+      slope = q->sinan/q->cosan;
+      a0    = fa->gbox[0] +  k   *cs - ext;
+      a1    = fa->gbox[0] + (k+1)*cs + ext;
+      b0    = q->mid[1] + (a0-q->mid[0])*slope;
+      b1    = q->mid[1] + (a1-q->mid[0])*slope;
+      EG_frontCells(fa, a0, a1, MIN(b0, b1)-ext, MAX(b0, b1)+ext, range);
+      range[0] = range[1] = k;
+    } else {
+      slope = q->cosan/q->sinan;
+      a0    = fa->gbox[1] +  k   *cs - ext;
+      a1    = fa->gbox[1] + (k+1)*cs + ext;
+      b0    = q->mid[0] + (a0-q->mid[1])*slope;
+      b1    = q->mid[0] + (a1-q->mid[1])*slope;
+      EG_frontCells(fa, MIN(b0, b1)-ext, MAX(b0, b1)+ext, a0, a1, range);
+      range[2] = range[3] = k;
+    }
+    for (j = range[2]; j <= range[3]; j++)
+      for (i = range[0]; i <= range[1]; i++)
+        for (m = cell[j*nx+i]; m < cell[j*nx+i+1]; m++) {
+          v = cvert[m];
+          if (EG_queryY(q, &vertices[2*v]) != 0.0) continue;
+          if (EG_crossLoop(q, v-1, vertices, fa) != 0) return 1;
+          for (n = vhead[v]; n != -1; n = fa->link[n].next[1])
+            if (EG_crossFront(q, n, vertices, fa) != 0) return 1;
+        }
   }
 
-  /* look at our original loops */
+  return 0;
+}
+
 
-  for (i = 0; i < fa->nsegs; i++) {
-    double area10, area01, area11, area00;
+__HOST_AND_DEVICE__ static int
+EG_crossSeg(int index, const double *mid, int i2, const double *vertices, 
+            int pass, fillArea *fa)
+{
+  int      i, j, k, stat, ncell, range[4], *cell, *cvert, *vhead, *olong;
+  double   angle, distF, cs, ext, umin, umax, vmin, vmax;
+  SegQuery q;
+
+  q.index   = index;
+  q.i2      = i2;
+  q.pass    = pass;
+  q.mid[0]  = mid[0];
+  q.mid[1]  = mid[1];
+  q.uv2[0]  = vertices[2*i2  ];
+  q.uv2[1]  = vertices[2*i2+1];
+
+  /*  Store away coordinates of front */
+  q.iF0     = fa->front[index].i0;
+  q.iF1     = fa->front[index].i1;
+  q.uvF0[0] = vertices[2*q.iF0  ];
+  q.uvF0[1] = vertices[2*q.iF0+1];
+  q.uvF1[0] = vertices[2*q.iF1  ];
+  q.uvF1[1] = vertices[2*q.iF1+1];
+
+  q.dist2   = DIST2(  mid,  q.uv2);
+  distF     = DIST2(q.uvF0, q.uvF1);
+  q.eps     = (q.dist2 + distF) * DBL_EPSILON;
+
+  /* transform so that we are in mid-uv2 coordinate frame */
+  angle   = atan2(q.uv2[1]-mid[1], q.uv2[0]-mid[0]);
+  q.cosan = cos(angle);
+  q.sinan = sin(angle);
 
-    i0 = fa->segs[2*i  ];
-    i1 = fa->segs[2*i+1];
+  if (fa->ngrid[0] == 0) {
 
-    if (((i0 == fa->front[index].i0) && (i1 == fa->front[index].i1)) ||
-        ((i0 == fa->front[index].i1) && (i1 == fa->front[index].i0))) 
+    /* look at the current front */
+    for (i = 0; i < fa->nfront; i++) {
+      stat = EG_crossFront(&q, i, vertices, fa);
+      if (stat != 0) return stat;
+    }
+
+    /* look at our original loops */
+    for (i = 0; i < fa->nsegs; i++) {
+      stat = EG_crossLoop(&q, i, vertices, fa);
+      if (stat != 0) return stat;
+    }
+
+    return 0;
+  }
+  
+  /* short segments that can reach the query have their right vertex
+     within a cell size of it -- the front segment is included to cover
+     the collinear checks of the second pass */
+  ncell = fa->ngrid[0]*fa->ngrid[1];
+  cell  = fa->grid;
+  cvert = &cell[ncell+1];
+  vhead = &cvert[2*fa->nsegs+1];
+  olong = &vhead[fa->nsegs+1];
+  cs    = fa->gbox[2];
+  umin  = MIN(MIN(mid[0], q.uv2[0]), MIN(q.uvF0[0], q.uvF1[0]));
+  umax  = MAX(MAX(mid[0], q.uv2[0]), MAX(q.uvF0[0], q.uvF1[0]));
+  vmin  = MIN(MIN(mid[1], q.uv2[1]), MIN(q.uvF0[1], q.uvF1[1]));
+  vmax  = MAX(MAX(mid[1], q.uv2[1]), MAX(q.uvF0[1], q.uvF1[1]));
+  ext   = cs + TOL*(MAX(umax-umin, vmax-vmin) + cs);
+  EG_frontCells(fa, umin-ext, umax+ext, vmin-ext, vmax+ext, range);
+  for (j = range[2]; j <= range[3]; j++)
+    for (i = range[0]; i <= range[1]; i++)
+      for (k = cell[j*fa->ngrid[0]+i]; k < cell[j*fa->ngrid[0]+i+1]; k++) {
+        stat = EG_crossLoop(&q, cvert[k]-1, vertices, fa);
+        if (stat != 0) return stat;
+        for (stat = vhead[cvert[k]]; stat != -1;
+             stat = fa->link[stat].next[1])
+          if (EG_crossFront(&q, stat, vertices, fa) != 0) return 1;
+      }
+  
+  /* the long ones */
+  for (k = 0; k < fa->nlong[0]; k++) {
+    stat = EG_crossLoop(&q, olong[k], vertices, fa);
+    if (stat != 0) return stat;
+  }
+  for (k = 0; k < fa->nlong[1]; k++) {
+    i = fa->link[k].list;
+    if ((fa->front[i].sright == NOTFILLED) ||
+        (EG_segLen2(vertices, fa->front[i].i0,
+                              fa->front[i].i1) <= cs*cs)) {
+      /* no longer an active long segment -- drop it */
+      fa->nlong[1]--;
+      j = fa->link[fa->nlong[1]].list;
+      fa->link[k].list = j;
+      fa->link[j].lng  = k;
+      fa->link[i].lng  = -1;
+      k--;
       continue;
+    }
+    stat = EG_crossFront(&q, i, vertices, fa);
+    if (stat != 0) return stat;
+  }
+
+  /* the short ones on the query line */
+  return EG_crossLine(&q, vertices, fa);
+}
 
-    uv0[0] = vertices[2*i0  ];
-    uv0[1] = vertices[2*i0+1];
-    uv1[0] = vertices[2*i1  ];
-    uv1[1] = vertices[2*i1+1];
 
-    if (pass != 0) {
-      area10 = AREA2D(uv2, uv1, uvF0);
-      area00 = AREA2D(uv2, uv0, uvF0);
-      area10 = ABS(area10);
-      area00 = ABS(area00);
-    }
-    if ((pass != 0) && area10 < eps && area00 < eps) {
-      /* I2 and Boundary Segment are collinear with IF0 (Front.I0) */
-      double del0[2], del1[2], del2[2];
-
-      VSUB2(uv2, uvF0, del2);
-      VSUB2(uv1, uvF0, del1);
-      VSUB2(uv0, uvF0, del0);
-      /*  See if I1 is between IF0 and I2 */
-      if (i1 != iF0 && DOT2(del2, del1) > 0 &&
-	  DOT2(del2, del2) > DOT2(del1, del1)) return 5;
-      /*  See if I0 is between IF0 and I2 */
-      if (i0 != iF0 && DOT2(del2, del0) > 0 && 
-	  DOT2(del2, del2) > DOT2(del0, del0)) return 6;
-    }
-    if (pass != 0) {
-      area11 = AREA2D(uv2, uv1, uvF1);
-      area01 = AREA2D(uv2, uv0, uvF1);
-      area11 = ABS(area11);
-      area01 = ABS(area01);
-    }
-    if ((pass != 0) && area11 < eps && area01 < eps) {
-      /* I2 and Boundary Segment are collinear with IF1 (Front.I1) */
-      double del0[2], del1[2], del2[2];
-
-      VSUB2(uv2, uvF1, del2);
-      VSUB2(uv1, uvF1, del1);
-      VSUB2(uv0, uvF1, del0);
-      /*  See if I1 is between IF1 and I2 */
-      if (i1 != iF1 && DOT2(del2, del1) > 0 &&
-	  DOT2(del2, del2) > DOT2(del1, del1)) return 7;
-      /*  See if I0 is between IF1 and I2 */
-      if (i0 != iF1 && DOT2(del2, del0) > 0 && 
-	  DOT2(del2, del2) > DOT2(del0, del0)) return 8;
-    }
-
-    if ((i1 == i2) || (i0 == i2)) continue;
-    /* look to see if the transformed y's from uv2-mid cross 0.0 */
-    ty0 = (uv0[1]-mid[1])*cosan - (uv0[0]-mid[0])*sinan;
-    ty1 = (uv1[1]-mid[1])*cosan - (uv1[0]-mid[0])*sinan;
-    if ((ty0 == 0.0) && (ty1 == 0.0)) return 3;
-    if  (ty0*ty1 >= 0.0) continue;
-
-    /* get fraction of line for crossing */
-    frac = -ty0/(ty1-ty0);
-    if ((frac < 0.0) || (frac > 1.0)) continue;
-
-    /* get the actual coordinates */
-    x[0] = uv0[0] + frac*(uv1[0]-uv0[0]);
-    x[1] = uv0[1] + frac*(uv1[1]-uv0[1]);
-
-    /* are we in the range for the line seg? */
-    frac = (x[0]-mid[0])*cosan + (x[1]-mid[1])*sinan;
-    if ((frac > 0.0) && (frac*frac < dist2*(1.0+TOL))) return 4;
+/* find the best candidate using the front index -- the rings of cells
+ * about the midpoint are searched until no vertex outside can do better */
+
+__HOST_AND_DEVICE__ static int
+EG_frontCandidate(int index, const double *mid, const double *vertices,
+                  int pass, fillArea *fa)
+{
+  int    i, j, k, l, m, n, i0, i1, i2, inc, indx2, nx, ny, cx, cy, *cell;
+  int    *cvert, *vhead;
+  double dist, d, area, len, cs, uv0[2], uv1[2], uv2[2];
+
+  nx    = fa->ngrid[0];
+  ny    = fa->ngrid[1];
+  cs    = fa->gbox[2];
+  cell  = fa->grid;
+  cvert = &cell[nx*ny+1];
+  vhead = &cvert[2*fa->nsegs+1];
+  i0    = fa->front[index].i0;
+  i1    = fa->front[index].i1;
+  uv0[0] = vertices[2*i0  ];
+  uv0[1] = vertices[2*i0+1];
+  uv1[0] = vertices[2*i1  ];
+  uv1[1] = vertices[2*i1+1];
+  len   = sqrt(DIST2(uv0, uv1));
+  cx    = MIN((mid[0]-fa->gbox[0])/cs, nx-1);
+  cy    = MIN((mid[1]-fa->gbox[1])/cs, ny-1);
+  if (cx < 0) cx = 0;
+  if (cy < 0) cy = 0;
+
+  /* d = |mid-uv2|^2/area >= |mid-uv2|/len -- ties go to the lowest index
+     to match the order of the exhaustive search */
+  indx2 = -1;
+  dist  = DBL_MAX;
+  for (k = 0; ; k++) {
+    if ((indx2 != -1) && (dist*len < (k-1)*cs)) break;
+    if ((cx-k < 0) && (cy-k < 0) && (cx+k >= nx) && (cy+k >= ny)) break;
+    for (j = cy-k; j <= cy+k; j++) {
+      if ((j < 0) || (j >= ny)) continue;
+      /* only the cells on the ring */
+      inc = 1;
+      if ((j != cy-k) && (j != cy+k)) inc = 2*k;
+      for (i = cx-k; i <= cx+k; i += inc) {
+        if ((i < 0) || (i >= nx)) continue;
+        for (l = cell[j*nx+i]; l < cell[j*nx+i+1]; l++) {
+          i2 = cvert[l];
+          if ((i2 == i0) || (i2 == i1) || (vhead[i2] == -1)) continue;
+          uv2[0] = vertices[2*i2  ];
+          uv2[1] = vertices[2*i2+1];
+          area   = AREA2D(uv0, uv1, uv2);
+          if (area <= 0.0) continue;
+          d = DIST2(mid, uv2)/area;
+          if (d > dist) continue;
+          for (m = vhead[i2]; m != -1; m = n) {
+            n = fa->link[m].next[1];
+            if (fa->front[m].sright == NOTFILLED) {
+              EG_frontUnlink(fa, m, 1);
+              continue;
+            }
+            if (m == index) continue;
+            if ((d == dist) && (m > indx2)) continue;
+            if (EG_crossSeg(index, mid, i2, vertices, pass, fa)) break;
+            dist  = d;
+            indx2 = m;
+          }
+        }
+      }
+    }
   }
 
-  return 0;
+  return indx2;
 }
 
 
@@ -540,6 +1022,7 @@ EG_fillArea(int nc, const int *cntr, const double *vertices, int *triangles,
   int    start, next, left, right, ntri, mtri;
   double side2, dist, d, area, uv0[2], uv1[2], uv2[2], mid[2];
   Front  *tmp;
+  FrontLink *ltmp;
   int    *itmp;
 
   ncontours = nc;
@@ -654,6 +1137,11 @@ EG_fillArea(int nc, const int *cntr, const double *vertices, int *triangles,
     start += cntr[i];
   }
 
+  /* index the front of larger loops */
+  fa->ngrid[0] = fa->ngrid[1] = 0;
+  if (fa->nfront >= FILLGRID)
+    if (EG_frontIndex(fa, vertices) == EGADS_MALLOC) return 0;
+
   /* collapse the front while building the triangle list*/
 
   neg = 0;
@@ -710,7 +1198,8 @@ EG_fillArea(int nc, const int *cntr, const double *vertices, int *triangles,
       i0 = fa->front[i].i0;
       i1 = fa->front[i].i1;
       if (fa->pts[i1] == 1) continue;
-      for (k = 0; k < fa->nfront; k++) {
+      for (k = EG_frontIter(fa, 0, i1, -1); k < fa->nfront;
+           k = EG_frontIter(fa, 0, i1, k)) {
         if (fa->front[k].sright == NOTFILLED) continue;
         if (k == fa->front[i].sright) continue;
         if (fa->front[k].i0 != i1) continue;
@@ -723,7 +1212,8 @@ EG_fillArea(int nc, const int *cntr, const double *vertices, int *triangles,
         uv2[1] = vertices[2*i2+1];
         area   = AREA2D(uv0, uv1, uv2);
         if ((neg == 0) && (area <= 0.0)) continue;
-        for (l = 0; l < fa->nfront; l++) {
+        for (l = EG_frontIter(fa, 1, i0, -1); l < fa->nfront;
+             l = EG_frontIter(fa, 1, i0, l)) {
           if (fa->front[l].sright == NOTFILLED) continue;
           if (fa->front[l].sleft  == NOTFILLED) continue;
           if ((fa->front[l].i0 == i2) && (fa->front[l].i1 == i0)) {
@@ -820,19 +1310,23 @@ small:
 
     indx2 = -1;
     dist  = DBL_MAX;
-    for (i = 0; i < fa->nfront; i++) {
-      if ((i == index) || (fa->front[i].sright == NOTFILLED)) continue;
-      i2 = fa->front[i].i1;
-      if ((i2 == i0) || (i2 == i1)) continue;
-      uv2[0] = vertices[2*i2  ];
-      uv2[1] = vertices[2*i2+1];
-      area   = AREA2D(uv0, uv1, uv2);
-      if (area > 0.0) {
-        d = DIST2(mid, uv2)/area;
-        if (d < dist) {
-          if (EG_crossSeg(index, mid, i2, vertices, pass, fa)) continue;
-          dist  = d;
-          indx2 = i;
+    if (fa->ngrid[0] != 0) {
+      indx2 = EG_frontCandidate(index, mid, vertices, pass, fa);
+    } else {
+      for (i = 0; i < fa->nfront; i++) {
+        if ((i == index) || (fa->front[i].sright == NOTFILLED)) continue;
+        i2 = fa->front[i].i1;
+        if ((i2 == i0) || (i2 == i1)) continue;
+        uv2[0] = vertices[2*i2  ];
+        uv2[1] = vertices[2*i2+1];
+        area   = AREA2D(uv0, uv1, uv2);
+        if (area > 0.0) {
+          d = DIST2(mid, uv2)/area;
+          if (d < dist) {
+            if (EG_crossSeg(index, mid, i2, vertices, pass, fa)) continue;
+            dist  = d;
+            indx2 = i;
+          }
         }
       }
     }
@@ -865,6 +1359,7 @@ small:
       fa->front[left].snew   = 1;
       fa->front[right].sleft = left;
       fa->front[index].sleft = fa->front[index].sright = NOTFILLED;
+      EG_frontLink(fa, left, vertices);
 
     } else if (i2 == fa->front[right].i1) {
       /* 2) candate is in the right segment */
@@ -874,6 +1369,7 @@ small:
       fa->front[right].i0    = i0;
       fa->front[right].snew  = 1;
       fa->front[index].sleft = fa->front[index].sright = NOTFILLED;
+      EG_frontLink(fa, right, vertices);
 
     } else {
       /* 3) some other situation */
@@ -883,7 +1379,8 @@ small:
       /* "figure 8" vertices? */
 
       if (fa->pts[i0] != 1) 
-        for (i = 0; i < fa->nfront; i++) {
+        for (i = EG_frontIter(fa, 1, i0, -1); i < fa->nfront;
+             i = EG_frontIter(fa, 1, i0, i)) {
           if (fa->front[i].sright == NOTFILLED) continue;
           if (fa->front[i].i0 != i2) continue;
           if (fa->front[i].i1 != i0) continue;
@@ -898,12 +1395,14 @@ small:
           fa->front[left].snew   = 1;
           fa->front[right].sleft = left;
           fa->front[index].sleft = fa->front[index].sright = NOTFILLED;
+          EG_frontLink(fa, left, vertices);
           start = 1;
           break;
         }
 
       if ((fa->pts[i1] != 1) && (start == 0))
-        for (i = 0; i < fa->nfront; i++) {
+        for (i = EG_frontIter(fa, 0, i1, -1); i < fa->nfront;
+             i = EG_frontIter(fa, 0, i1, i)) {
           if (fa->front[i].sright == NOTFILLED) continue;
           if (fa->front[i].i0 != i1) continue;
           if (fa->front[i].i1 != i2) continue;
@@ -918,6 +1417,7 @@ small:
           fa->front[right].i0    = i0;
           fa->front[right].snew  = 1;
           fa->front[index].sleft = fa->front[index].sright = NOTFILLED;
+          EG_frontLink(fa, right, vertices);
           start = 1;
           break;
         }
@@ -946,6 +1446,17 @@ small:
             fa->mfront = i;
             fa->front  =  tmp;
             fa->segs   = itmp;
+            if ((fa->ngrid[0] != 0) && (fa->mlink < i)) {
+              ltmp = (FrontLink *) EG_reall(fa->link, i*sizeof(FrontLink));
+              if (ltmp == NULL) return 0;
+              for (j = fa->mlink; j < i; j++) {
+                ltmp[j].next[0] = ltmp[j].prev[0] = ltmp[j].vert[0] = -1;
+                ltmp[j].next[1] = ltmp[j].prev[1] = ltmp[j].vert[1] = -1;
+                ltmp[j].lng     = -1;
+              }
+              fa->mlink = i;
+              fa->link  = ltmp;
+            }
           }
           next = fa->nfront;
           fa->nfront++;
@@ -963,6 +1474,8 @@ small:
         fa->front[next].i1      = i1;
         fa->front[next].sright  = right;
         fa->front[next].snew    = 1;
+        EG_frontLink(fa, index, vertices);
+        EG_frontLink(fa, next,  vertices);
       }
     }
 
@@ -2342,6 +2855,7 @@ EG_cleanupTess(egTessel *btess)
 {
   int i;
   
+  EG_cleanupEdgeEdits(btess);
   if (btess->xyzs != NULL) EG_free(btess->xyzs);
   
   if (btess->tess1d != NULL) {
@@ -4506,6 +5020,7 @@ EG_makeTessGeom(egObject *obj, double *params, int *sizes, egObject **tess)
   btess->tess1d  = NULL;
   btess->tess2d  = NULL;
   btess->globals = NULL;
+  btess->edits   = NULL;
   btess->nGlobal = 0;
   btess->nEdge   = 0;
   btess->nFace   = 0;
@@ -4737,12 +5252,206 @@ EG_deleteQuads(egTessel *btess, int iface)
 }
 
 
+/*
+ * Edge vertex edit transactions:
+ *   between EG_beginEdgeEdits and EG_commitEdgeEdits the calls to
+ *   EG_moveEdgeVert, EG_deleteEdgeVert and EG_insertEdgeVerts are checked
+ *   against the tessellation as it was when the transaction was opened and
+ *   queued. The indices therefore do not change as edits are added.
+ */
+
+#define EDITMOVE         0
+#define EDITDELETE       1
+#define EDITINSERT       2
+#define EDITCHUNK      256
+
+typedef struct {
+  int eIndex;                   /* Edge index (bias 1) */
+  int vIndex;                   /* vertex (move/delete) or segment (insert) */
+  int type;                     /* EDITMOVE, EDITDELETE or EDITINSERT */
+  int dir;                      /* collapse direction for deletes */
+  int npts;                     /* number of ts */
+  int its;                      /* offset into ts storage */
+} egEdgeEdit;
+
+typedef struct {
+  egEdgeEdit *edits;            /* the queued edits */
+  double     *ts;               /* storage for the parameters */
+  int        nedit;             /* number of edits */
+  int        medit;             /* allocated edits */
+  int        nts;               /* number of ts used */
+  int        mts;               /* allocated ts */
+} egEdgeEdits;
+
+
+__HOST_AND_DEVICE__ void
+EG_cleanupEdgeEdits(egTessel *btess)
+{
+  egEdgeEdits *queue;
+
+  if (btess->edits == NULL) return;
+  queue = (egEdgeEdits *) btess->edits;
+  if (queue->edits != NULL) EG_free(queue->edits);
+  if (queue->ts    != NULL) EG_free(queue->ts);
+  EG_free(queue);
+  btess->edits = NULL;
+}
+
+
+__HOST_AND_DEVICE__ static int
+EG_queueEdgeEdit(egTessel *btess, int type, int eIndex, int vIndex, int dir,
+                 int npts, /*@null@*/ const double *t, int outLevel)
+{
+  int         i, len, conflict;
+  egEdgeEdit  *edit, *tmp;
+  egEdgeEdits *queue;
+  double      *dtmp;
+
+  queue = (egEdgeEdits *) btess->edits;
+  
+  /* an edit may not touch vertices that another edit depends on */
+  for (i = 0; i < queue->nedit; i++) {
+    edit = &queue->edits[i];
+    if (edit->eIndex != eIndex) continue;
+    conflict = 0;
+    if (type == EDITINSERT) {
+      if (edit->type == EDITINSERT) {
+        if (edit->vIndex == vIndex) conflict = 1;
+      } else {
+        if ((edit->vIndex == vIndex) || (edit->vIndex == vIndex+1))
+          conflict = 1;
+      }
+    } else {
+      if (edit->type == EDITINSERT) {
+        if ((vIndex == edit->vIndex) || (vIndex == edit->vIndex+1))
+          conflict = 1;
+      } else {
+        if ((vIndex >= edit->vIndex-1) && (vIndex <= edit->vIndex+1))
+          conflict = 1;
+      }
+    }
+    if (conflict == 0) continue;
+    if (outLevel > 0)
+      printf(" EGADS Error: Edge %d vert %d conflicts with queued edit %d (EG_queueEdgeEdit)!\n",
+             eIndex, vIndex, i+1);
+    return EGADS_RANGERR;
+  }
+  
+  if (queue->nedit >= queue->medit) {
+    len = queue->medit + EDITCHUNK;
+    if (queue->edits == NULL) {
+      tmp = (egEdgeEdit *) EG_alloc(len*sizeof(egEdgeEdit));
+    } else {
+      tmp = (egEdgeEdit *) EG_reall(queue->edits, len*sizeof(egEdgeEdit));
+    }
+    if (tmp == NULL) return EGADS_MALLOC;
+    queue->edits = tmp;
+    queue->medit = len;
+  }
+  if (queue->nts+npts > queue->mts) {
+    len = queue->nts + npts + EDITCHUNK;
+    if (queue->ts == NULL) {
+      dtmp = (double *) EG_alloc(len*sizeof(double));
+    } else {
+      dtmp = (double *) EG_reall(queue->ts, len*sizeof(double));
+    }
+    if (dtmp == NULL) return EGADS_MALLOC;
+    queue->ts  = dtmp;
+    queue->mts = len;
+  }
+  
+  edit = &queue->edits[queue->nedit];
+  edit->eIndex = eIndex;
+  edit->vIndex = vIndex;
+  edit->type   = type;
+  edit->dir    = dir;
+  edit->npts   = npts;
+  edit->its    = queue->nts;
+  for (i = 0; i < npts; i++) queue->ts[queue->nts+i] = t[i];
+  queue->nts += npts;
+  queue->nedit++;
+  
+  return EGADS_SUCCESS;
+}
+
+
+__HOST_AND_DEVICE__ static int
+EG_edgeVertMove(egTessel *btess, egObject **edges, egObject **faces,
+                int eIndex, int vIndex, double t)
+{
+  int    i, j, m, nf, stat, iface, itri, ivrt, sense;
+  double result[9], uv[2];
+
+  stat = EG_evaluate(edges[eIndex-1], &t, result);
+  if (stat != EGADS_SUCCESS) return stat;
+  /* make sure we can get UVs */
+  for (m = 0; m < 2; m++) {
+    nf = btess->tess1d[eIndex-1].faces[m].nface;
+    for (j = 0; j < nf; j++) {
+      iface = btess->tess1d[eIndex-1].faces[m].index;
+      if (nf > 1) iface = btess->tess1d[eIndex-1].faces[m].faces[j];
+      if (iface != 0) {
+        sense = faces[iface-1]->mtype;
+        if (EG_faceConnIndex(btess->tess1d[eIndex-1].faces[1-m], iface) == 0)
+          sense = 0;
+        if (m == 0) sense = -sense;
+        stat = EG_getEdgeUV(faces[iface-1], edges[eIndex-1], sense, t, uv);
+        if (stat != EGADS_SUCCESS) return stat;
+      }
+    }
+  }
+  
+  /* got everything -- update the tessellation */
+  btess->tess1d[eIndex-1].xyz[3*vIndex-3] = result[0];
+  btess->tess1d[eIndex-1].xyz[3*vIndex-2] = result[1];
+  btess->tess1d[eIndex-1].xyz[3*vIndex-1] = result[2];
+  btess->tess1d[eIndex-1].t[vIndex-1]     = t;
+  for (m = 0; m < 2; m++) {
+    nf = btess->tess1d[eIndex-1].faces[m].nface;
+    for (j = 0; j < nf; j++) {
+      iface = btess->tess1d[eIndex-1].faces[m].index;
+      if (nf > 1) iface = btess->tess1d[eIndex-1].faces[m].faces[j];
+      if (iface == 0) continue;
+      sense = faces[iface-1]->mtype;
+      if (EG_faceConnIndex(btess->tess1d[eIndex-1].faces[1-m], iface) == 0)
+        sense = 0;
+      if (m == 0) sense = -sense;
+      EG_getEdgeUV(faces[iface-1], edges[eIndex-1], sense, t, uv);
+      itri = btess->tess1d[eIndex-1].faces[m].tric[(vIndex-1)*nf+j] - 1;
+      for (i = 0; i < 3; i++) {
+        ivrt = btess->tess2d[iface-1].tris[3*itri+i] - 1;
+        if ((btess->tess2d[iface-1].pindex[ivrt] == eIndex) &&
+            (btess->tess2d[iface-1].ptype[ivrt]  == vIndex)) {
+          btess->tess2d[iface-1].xyz[3*ivrt  ] = result[0];
+          btess->tess2d[iface-1].xyz[3*ivrt+1] = result[1];
+          btess->tess2d[iface-1].xyz[3*ivrt+2] = result[2];
+          btess->tess2d[iface-1].uv[2*ivrt  ]  = uv[0];
+          btess->tess2d[iface-1].uv[2*ivrt+1]  = uv[1];
+          break;
+        }
+      }
+      /* delete any quads & invalidate the frame */
+      if (btess->tess2d[iface-1].bary  != NULL)
+        EG_free(btess->tess2d[iface-1].bary);
+      btess->tess2d[iface-1].bary = NULL;
+      if (btess->tess2d[iface-1].frame != NULL)
+        EG_free(btess->tess2d[iface-1].frame);
+      btess->tess2d[iface-1].frame = NULL;
+      if (btess->tess2d[iface-1].frlps != NULL)
+        EG_free(btess->tess2d[iface-1].frlps);
+      btess->tess2d[iface-1].frlps = NULL;
+      EG_deleteQuads(btess, iface);
+    }
+  }
+  
+  return EGADS_SUCCESS;
+}
+
+
 __HOST_AND_DEVICE__ int
 EG_moveEdgeVert(egObject *tess, int eIndex, int vIndex, double t)
 {
-  int      i, j, m, nf, stat, outLevel, nedge, nface, iface, itri, ivrt;
-  int      sense;
-  double   result[9], uv[2];
+  int      stat, outLevel, nedge, nface;
   egTessel *btess;
   egObject *obj, **edges, **faces;
 
@@ -4795,7 +5504,7 @@ EG_moveEdgeVert(egObject *tess, int eIndex, int vIndex, double t)
              eIndex, btess->nEdge);
     return EGADS_INDEXERR;
   }
-  if ((vIndex < 2) || (eIndex >= btess->tess1d[eIndex-1].npts)) {
+  if ((vIndex < 2) || (vIndex >= btess->tess1d[eIndex-1].npts)) {
     if (outLevel > 0)
       printf(" EGADS Error: vIndex = %d [2-%d] (EG_moveEdgeVert)!\n",
              vIndex, btess->tess1d[eIndex-1].npts-1);
@@ -4809,6 +5518,10 @@ EG_moveEdgeVert(egObject *tess, int eIndex, int vIndex, double t)
                 btess->tess1d[eIndex-1].t[vIndex]);
     return EGADS_RANGERR;
   }
+  if (btess->edits != NULL)
+    return EG_queueEdgeEdit(btess, EDITMOVE, eIndex, vIndex, 0, 1, &t,
+                            outLevel);
+
   if (obj->oclass == EBODY) {
     stat = EG_getBodyTopos(obj, NULL, EEDGE, &nedge, &edges);
     if (stat != EGADS_SUCCESS) return stat;
@@ -4823,79 +5536,11 @@ EG_moveEdgeVert(egObject *tess, int eIndex, int vIndex, double t)
     return stat;
   }
   
-  stat = EG_evaluate(edges[eIndex-1], &t, result);
-  if (stat != EGADS_SUCCESS) {
-    EG_free(faces);
-    EG_free(edges);
-    return stat;
-  }
-  /* make sure we can get UVs */
-  for (m = 0; m < 2; m++) {
-    nf = btess->tess1d[eIndex-1].faces[m].nface;
-    for (j = 0; j < nf; j++) {
-      iface = btess->tess1d[eIndex-1].faces[m].index;
-      if (nf > 1) iface = btess->tess1d[eIndex-1].faces[m].faces[j];
-      if (iface != 0) {
-        sense = faces[iface-1]->mtype;
-        if (EG_faceConnIndex(btess->tess1d[eIndex-1].faces[1-m], iface) == 0)
-          sense = 0;
-        if (m == 0) sense = -sense;
-        stat = EG_getEdgeUV(faces[iface-1], edges[eIndex-1], sense, t, uv);
-        if (stat != EGADS_SUCCESS) {
-          EG_free(faces);
-          EG_free(edges);
-          return stat;
-        }
-      }
-    }
-  }
+  stat = EG_edgeVertMove(btess, edges, faces, eIndex, vIndex, t);
+  EG_free(faces);
+  EG_free(edges);
   
-  /* got everything -- update the tessellation */
-  btess->tess1d[eIndex-1].xyz[3*vIndex-3] = result[0];
-  btess->tess1d[eIndex-1].xyz[3*vIndex-2] = result[1];
-  btess->tess1d[eIndex-1].xyz[3*vIndex-1] = result[2];
-  btess->tess1d[eIndex-1].t[vIndex-1]     = t;
-  for (m = 0; m < 2; m++) {
-    nf = btess->tess1d[eIndex-1].faces[m].nface;
-    for (j = 0; j < nf; j++) {
-      iface = btess->tess1d[eIndex-1].faces[m].index;
-      if (nf > 1) iface = btess->tess1d[eIndex-1].faces[m].faces[j];
-      if (iface == 0) continue;
-      sense = faces[iface-1]->mtype;
-      if (EG_faceConnIndex(btess->tess1d[eIndex-1].faces[1-m], iface) == 0)
-        sense = 0;
-      if (m == 0) sense = -sense;
-      EG_getEdgeUV(faces[iface-1], edges[eIndex-1], sense, t, uv);
-      itri = btess->tess1d[eIndex-1].faces[m].tric[(vIndex-1)*nf+j] - 1;
-      for (i = 0; i < 3; i++) {
-        ivrt = btess->tess2d[iface-1].tris[3*itri+i] - 1;
-        if ((btess->tess2d[iface-1].pindex[ivrt] == eIndex) &&
-            (btess->tess2d[iface-1].ptype[ivrt]  == vIndex)) {
-          btess->tess2d[iface-1].xyz[3*ivrt  ] = result[0];
-          btess->tess2d[iface-1].xyz[3*ivrt+1] = result[1];
-          btess->tess2d[iface-1].xyz[3*ivrt+2] = result[2];
-          btess->tess2d[iface-1].uv[2*ivrt  ]  = uv[0];
-          btess->tess2d[iface-1].uv[2*ivrt+1]  = uv[1];
-          break;
-        }
-      }
-      /* delete any quads & invalidate the frame */
-      if (btess->tess2d[iface-1].bary  != NULL)
-        EG_free(btess->tess2d[iface-1].bary);
-      btess->tess2d[iface-1].bary = NULL;
-      if (btess->tess2d[iface-1].frame != NULL)
-        EG_free(btess->tess2d[iface-1].frame);
-      btess->tess2d[iface-1].frame = NULL;
-      if (btess->tess2d[iface-1].frlps != NULL)
-        EG_free(btess->tess2d[iface-1].frlps);
-      btess->tess2d[iface-1].frlps = NULL;
-      EG_deleteQuads(btess, iface);
-    }
-  }
-  EG_free(faces);
-  EG_free(edges);
-  
-  return EGADS_SUCCESS;
+  return stat;
 }
 
 
@@ -4928,74 +5573,12 @@ EG_cleanupTessMaps(egTessel *btess)
 }
 
 
-__HOST_AND_DEVICE__ int
-EG_deleteEdgeVert(egObject *tess, int eIndex, int vIndex, int dir)
+__HOST_AND_DEVICE__ static int
+EG_edgeVertDelete(egTessel *btess, int eIndex, int vIndex, int dir)
 {
-  int      i, k, m, n, nf, outLevel, iface, iv[2], it, ivert;
-  int      n1, n2, ie, i1, i2, i3, pt1, pi1, pt2, pi2, ref, nfr;
-  egTessel *btess;
-  egObject *obj;
+  int i, k, m, n, nf, iface, iv[2], it, ivert;
+  int n1, n2, ie, i1, i2, i3, pt1, pi1, pt2, pi2, ref, nfr;
 
-  if (tess == NULL)                 return EGADS_NULLOBJ;
-  if (tess->magicnumber != MAGIC)   return EGADS_NOTOBJ;
-  if (tess->oclass != TESSELLATION) return EGADS_NOTTESS;
-  if (EG_sameThread(tess))          return EGADS_CNTXTHRD;
-  outLevel = EG_outLevel(tess);
-  
-  if ((dir != -1) && (dir != 1)) {
-    if (outLevel > 0)
-      printf(" EGADS Error: Collapse Dir = %d (EG_deleteEdgeVert)!\n",
-             dir);  
-    return EGADS_RANGERR;
-  }
-  btess = (egTessel *) tess->blind;
-  if (btess == NULL) {
-    if (outLevel > 0)
-      printf(" EGADS Error: NULL Blind Object (EG_deleteEdgeVert)!\n");  
-    return EGADS_NOTFOUND;
-  }
-  if (btess->done != 1) {
-    if (outLevel > 0)
-      printf(" EGADS Error: Bad State (EG_deleteEdgeVerts)!\n");
-    return EGADS_TESSTATE;
-  }
-  obj = btess->src;
-  if (obj == NULL) {
-    if (outLevel > 0)
-      printf(" EGADS Error: NULL Source Object (EG_deleteEdgeVert)!\n");
-    return EGADS_NULLOBJ;
-  }
-  if (obj->magicnumber != MAGIC) {
-    if (outLevel > 0)
-      printf(" EGADS Error: Source Not an Object (EG_deleteEdgeVert)!\n");
-    return EGADS_NOTOBJ;
-  }
-  if ((obj->oclass != BODY) && (obj->oclass != EBODY)) {
-    if (outLevel > 0)
-      printf(" EGADS Error: Source Not Body (EG_deleteEdgeVert)!\n");
-    return EGADS_NOTBODY;
-  }
-  if (btess->tess1d == NULL) {
-    if (outLevel > 0)
-      printf(" EGADS Error: No Edge Tessellations (EG_deleteEdgeVert)!\n");
-    return EGADS_NODATA;  
-  }
-  if ((eIndex < 1) || (eIndex > btess->nEdge)) {
-    if (outLevel > 0)
-      printf(" EGADS Error: eIndex = %d [1-%d] (EG_deleteEdgeVert)!\n",
-             eIndex, btess->nEdge);
-    return EGADS_INDEXERR;
-  }
-  if ((vIndex < 2) || (eIndex >= btess->tess1d[eIndex-1].npts)) {
-    if (outLevel > 0)
-      printf(" EGADS Error: vIndex = %d [2-%d] (EG_deleteEdgeVert)!\n",
-             vIndex, btess->tess1d[eIndex-1].npts-1);
-    return EGADS_INDEXERR;
-  }
-  
-  /* cleanup mappings */
-  EG_cleanupTessMaps(btess);
- 
   /* fix up each face */
   for (m = 0; m < 2; m++) {
     nf = btess->tess1d[eIndex-1].faces[m].nface;
@@ -5254,15 +5837,512 @@ EG_deleteEdgeVert(egObject *tess, int eIndex, int vIndex, int dir)
 }
 
 
+__HOST_AND_DEVICE__ int
+EG_deleteEdgeVert(egObject *tess, int eIndex, int vIndex, int dir)
+{
+  int      outLevel;
+  egTessel *btess;
+  egObject *obj;
+
+  if (tess == NULL)                 return EGADS_NULLOBJ;
+  if (tess->magicnumber != MAGIC)   return EGADS_NOTOBJ;
+  if (tess->oclass != TESSELLATION) return EGADS_NOTTESS;
+  if (EG_sameThread(tess))          return EGADS_CNTXTHRD;
+  outLevel = EG_outLevel(tess);
+  
+  if ((dir != -1) && (dir != 1)) {
+    if (outLevel > 0)
+      printf(" EGADS Error: Collapse Dir = %d (EG_deleteEdgeVert)!\n",
+             dir);  
+    return EGADS_RANGERR;
+  }
+  btess = (egTessel *) tess->blind;
+  if (btess == NULL) {
+    if (outLevel > 0)
+      printf(" EGADS Error: NULL Blind Object (EG_deleteEdgeVert)!\n");  
+    return EGADS_NOTFOUND;
+  }
+  if (btess->done != 1) {
+    if (outLevel > 0)
+      printf(" EGADS Error: Bad State (EG_deleteEdgeVerts)!\n");
+    return EGADS_TESSTATE;
+  }
+  obj = btess->src;
+  if (obj == NULL) {
+    if (outLevel > 0)
+      printf(" EGADS Error: NULL Source Object (EG_deleteEdgeVert)!\n");
+    return EGADS_NULLOBJ;
+  }
+  if (obj->magicnumber != MAGIC) {
+    if (outLevel > 0)
+      printf(" EGADS Error: Source Not an Object (EG_deleteEdgeVert)!\n");
+    return EGADS_NOTOBJ;
+  }
+  if ((obj->oclass != BODY) && (obj->oclass != EBODY)) {
+    if (outLevel > 0)
+      printf(" EGADS Error: Source Not Body (EG_deleteEdgeVert)!\n");
+    return EGADS_NOTBODY;
+  }
+  if (btess->tess1d == NULL) {
+    if (outLevel > 0)
+      printf(" EGADS Error: No Edge Tessellations (EG_deleteEdgeVert)!\n");
+    return EGADS_NODATA;  
+  }
+  if ((eIndex < 1) || (eIndex > btess->nEdge)) {
+    if (outLevel > 0)
+      printf(" EGADS Error: eIndex = %d [1-%d] (EG_deleteEdgeVert)!\n",
+             eIndex, btess->nEdge);
+    return EGADS_INDEXERR;
+  }
+  if ((vIndex < 2) || (vIndex >= btess->tess1d[eIndex-1].npts)) {
+    if (outLevel > 0)
+      printf(" EGADS Error: vIndex = %d [2-%d] (EG_deleteEdgeVert)!\n",
+             vIndex, btess->tess1d[eIndex-1].npts-1);
+    return EGADS_INDEXERR;
+  }
+  
+  if (btess->edits != NULL)
+    return EG_queueEdgeEdit(btess, EDITDELETE, eIndex, vIndex, dir, 0, NULL,
+                            outLevel);
+  
+  /* cleanup mappings */
+  EG_cleanupTessMaps(btess);
+ 
+  return EG_edgeVertDelete(btess, eIndex, vIndex, dir);
+}
+
+
+/*
+ * inserts vertices into nseg segments of a single Edge in one pass -- segs
+ *   (bias 1) must be increasing and refer to the current Edge tessellation,
+ *   nins is the number of ts inserted in each segment and t holds all of the
+ *   ts packed in segment order. The Edge and each touching Face are rebuilt
+ *   once for the complete set of insertions.
+ */
+
+__HOST_AND_DEVICE__ static int
+EG_edgeVertsInsert(egTessel *btess, egObject **edges, egObject **faces,
+                   int eIndex, int nseg, const int *segs, const int *nins,
+                   const double *t, int outLevel)
+{
+  int      i, j, k, m, n, nf, nx, stat, iface, itri, npt0, ntot, cnt, stripe;
+  int      n0, n1, v0, v1, vert, vn, nl, nn, sense, pt1, pi1, pt2, pi2;
+  int      i1, i2, i3, it3[3], ie, ref, nfr, nrow, row, nv, nt, vbase, nuse;
+  int      *offs, *etric[2], **fints = NULL;
+  int      *pindex, *ptype, *tris, *tric;
+  double   result[9], *vals, *xyzs, *ts, *xyz, *uv, **freals = NULL;
+  egTess1D *tess1d;
+  egTess2D *tess2d;
+  
+  tess1d = &btess->tess1d[eIndex-1];
+  npt0   = tess1d->npts;
+  for (ntot = k = 0; k < nseg; k++) ntot += nins[k];
+  if (ntot == 0) return EGADS_SUCCESS;
+  
+  /* the shift in Edge index for each of the current vertices */
+  offs = (int *) EG_alloc((npt0+1)*sizeof(int));
+  if (offs == NULL) return EGADS_MALLOC;
+  offs[0] = 0;
+  for (j = k = 0, i = 1; i <= npt0; i++) {
+    offs[i] = j;
+    if (k >= nseg) continue;
+    if (segs[k] != i) continue;
+    j += nins[k];
+    k++;
+  }
+  
+  for (cnt = m = 0; m < 2; m++) {
+    nf = tess1d->faces[m].nface;
+    for (nx = 0; nx < nf; nx++) {
+      iface = tess1d->faces[m].index;
+      if (nf > 1) iface = tess1d->faces[m].faces[nx];
+      if (iface != 0) cnt++;
+    }
+  }
+  nuse   = cnt;
+  stripe = 3 + 2*nuse;
+  xyzs   = ts = NULL;
+  etric[0] = etric[1] = NULL;
+  vals   = (double *) EG_alloc(stripe*ntot*sizeof(double));
+  if (vals == NULL) {
+    if (outLevel > 0)
+      printf(" EGADS Error: Malloc on Tmp %d %d (EG_insertEdgeVerts)!\n",
+             ntot, stripe);
+    EG_free(offs);
+    return EGADS_MALLOC;
+  }
+  
+  /* get the new data on the Edge and Faces */
+  for (i = 0; i < ntot; i++) {
+    stat = EG_evaluate(edges[eIndex-1], &t[i], result);
+    if (stat != EGADS_SUCCESS) goto bail;
+    vals[stripe*i  ] = result[0];
+    vals[stripe*i+1] = result[1];
+    vals[stripe*i+2] = result[2];
+    for (cnt = m = 0; m < 2; m++) {
+      nf = tess1d->faces[m].nface;
+      for (nx = 0; nx < nf; nx++) {
+        iface = tess1d->faces[m].index;
+        if (nf > 1) iface = tess1d->faces[m].faces[nx];
+        if (iface == 0) continue;
+        sense = faces[iface-1]->mtype;
+        if (EG_faceConnIndex(tess1d->faces[1-m], iface) == 0) sense = 0;
+        if (m == 0) sense = -sense;
+        stat = EG_getEdgeUV(faces[iface-1], edges[eIndex-1], sense,
+                            t[i], &vals[stripe*i+3+2*cnt]);
+        if (stat != EGADS_SUCCESS) goto bail;
+        cnt++;
+      }
+    }
+  }
+  
+  /* get all of the memory we will need before touching anything */
+  stat = EGADS_MALLOC;
+  xyzs = (double *) EG_alloc(3*(npt0+ntot)*sizeof(double));
+  ts   = (double *) EG_alloc(  (npt0+ntot)*sizeof(double));
+  if ((xyzs == NULL) || (ts == NULL)) {
+    if (outLevel > 0)
+      printf(" EGADS Error: Malloc on Edge %d %d (EG_insertEdgeVerts)!\n",
+             ntot, npt0);
+    goto bail;
+  }
+  for (m = 0; m < 2; m++) {
+    nf = tess1d->faces[m].nface;
+    if (nf <= 0) continue;
+    etric[m] = (int *) EG_alloc(nf*(npt0+ntot-1)*sizeof(int));
+    if (etric[m] == NULL) {
+      if (outLevel > 0)
+        printf(" EGADS Error: Malloc on Edge%c %d %d (EG_insertEdgeVerts)!\n",
+               m == 0 ? '-' : '+', ntot, npt0-1);
+      goto bail;
+    }
+  }
+  if (nuse > 0) {
+    freals = (double **) EG_alloc(2*nuse*sizeof(double *));
+    if (freals == NULL) goto bail;
+    for (i = 0; i < 2*nuse; i++) freals[i] = NULL;
+    fints  = (int **)    EG_alloc(4*nuse*sizeof(int *));
+    if (fints  == NULL) goto bail;
+    for (i = 0; i < 4*nuse; i++) fints[i]  = NULL;
+  }
+  for (cnt = m = 0; m < 2; m++) {
+    nf = tess1d->faces[m].nface;
+    for (nx = 0; nx < nf; nx++) {
+      iface = tess1d->faces[m].index;
+      if (nf > 1) iface = tess1d->faces[m].faces[nx];
+      if (iface == 0) continue;
+      tess2d = &btess->tess2d[iface-1];
+      freals[2*cnt  ] = (double *) EG_alloc(3*(ntot+tess2d->npts)*
+                                            sizeof(double));
+      freals[2*cnt+1] = (double *) EG_alloc(2*(ntot+tess2d->npts)*
+                                            sizeof(double));
+      fints[4*cnt  ]  = (int *)    EG_alloc(  (ntot+tess2d->npts)*
+                                            sizeof(int));
+      fints[4*cnt+1]  = (int *)    EG_alloc(  (ntot+tess2d->npts)*
+                                            sizeof(int));
+      fints[4*cnt+2]  = (int *)    EG_alloc(3*(ntot+tess2d->ntris)*
+                                            sizeof(int));
+      fints[4*cnt+3]  = (int *)    EG_alloc(3*(ntot+tess2d->ntris)*
+                                            sizeof(int));
+      if ((freals[2*cnt] == NULL) || (freals[2*cnt+1] == NULL) ||
+          (fints[4*cnt]  == NULL) || (fints[4*cnt+1]  == NULL) ||
+          (fints[4*cnt+2] == NULL) || (fints[4*cnt+3] == NULL)) {
+        if (outLevel > 0)
+          printf(" EGADS Error: Malloc on Face %d %d (EG_insertEdgeVerts)!\n",
+                 iface, ntot);
+        goto bail;
+      }
+      cnt++;
+    }
+  }
+  
+  /* set the new Edge tessellation information */
+  for (j = i = k = 0; i < npt0; i++, j++) {
+    xyzs[3*j  ] = tess1d->xyz[3*i  ];
+    xyzs[3*j+1] = tess1d->xyz[3*i+1];
+    xyzs[3*j+2] = tess1d->xyz[3*i+2];
+    ts[j]       = tess1d->t[i];
+    if (i != npt0-1)
+      for (m = 0; m < 2; m++) {
+        if (etric[m] == NULL) continue;
+        nf = tess1d->faces[m].nface;
+        for (nx = 0; nx < nf; nx++)
+          etric[m][j*nf+nx] = tess1d->faces[m].tric[i*nf+nx];
+      }
+    if (k >= nseg) continue;
+    if (segs[k] != i+1) continue;
+    for (n = 0; n < nins[k]; n++) {
+      j++;
+      xyzs[3*j  ] = vals[stripe*(offs[i+1]+n)  ];
+      xyzs[3*j+1] = vals[stripe*(offs[i+1]+n)+1];
+      xyzs[3*j+2] = vals[stripe*(offs[i+1]+n)+2];
+      ts[j]       = t[offs[i+1]+n];
+      for (m = 0; m < 2; m++) {
+        if (etric[m] == NULL) continue;
+        nf = tess1d->faces[m].nface;
+        for (nx = 0; nx < nf; nx++) etric[m][j*nf+nx] = 0;
+      }
+    }
+    k++;
+  }
+  nrow = npt0 + ntot - 1;
+
+  /* do each Face touched by the Edge */
+  for (cnt = m = 0; m < 2; m++) {
+    nf = tess1d->faces[m].nface;
+    for (nx = 0; nx < nf; nx++) {
+      iface = tess1d->faces[m].index;
+      if (nf > 1) iface = tess1d->faces[m].faces[nx];
+      if (iface == 0) continue;
+      tess2d = &btess->tess2d[iface-1];
+      xyz    = freals[2*cnt  ];
+      uv     = freals[2*cnt+1];
+      ptype  = fints[4*cnt  ];
+      pindex = fints[4*cnt+1];
+      tris   = fints[4*cnt+2];
+      tric   = fints[4*cnt+3];
+      nv     = tess2d->npts;
+      nt     = tess2d->ntris;
+      for (i = 0; i < nv; i++) {
+        xyz[3*i  ] = tess2d->xyz[3*i  ];
+        xyz[3*i+1] = tess2d->xyz[3*i+1];
+        xyz[3*i+2] = tess2d->xyz[3*i+2];
+        uv[2*i  ]  = tess2d->uv[2*i  ];
+        uv[2*i+1]  = tess2d->uv[2*i+1];
+        ptype[i]   = tess2d->ptype[i];
+        pindex[i]  = tess2d->pindex[i];
+        if ((pindex[i] == eIndex) && (ptype[i] > 0))
+          ptype[i] += offs[ptype[i]];
+      }
+      for (k = 0; k < nseg; k++)
+        for (n = 0; n < nins[k]; n++) {
+          i = offs[segs[k]] + n;
+          xyz[3*(nv+i)  ] = vals[stripe*i  ];
+          xyz[3*(nv+i)+1] = vals[stripe*i+1];
+          xyz[3*(nv+i)+2] = vals[stripe*i+2];
+          uv[2*(nv+i)  ]  = vals[stripe*i+3+2*cnt  ];
+          uv[2*(nv+i)+1]  = vals[stripe*i+3+2*cnt+1];
+          ptype[nv+i]     = segs[k] + offs[segs[k]] + n+1;
+          pindex[nv+i]    = eIndex;
+        }
+      for (i = 0; i < 3*nt; i++) {
+        tris[i] = tess2d->tris[i];
+        tric[i] = tess2d->tric[i];
+      }
+      
+      /* split the triangle on each segment (from the back) */
+      for (k = nseg-1; k >= 0; k--) {
+        if (nins[k] == 0) continue;
+        row   = segs[k] - 1 + offs[segs[k]];
+        vbase = nv + offs[segs[k]];
+        itri  = etric[m][row*nf+nx];
+        sense = 1;
+        pt1   = segs[k]   + offs[segs[k]];
+        pt2   = segs[k]+1 + offs[segs[k]+1];
+        pi1   = pi2 = eIndex;
+        if (segs[k] == 1) {
+          pt1 = 0;
+          pi1 = tess1d->nodes[0];
+        }
+        if (segs[k]+1 == npt0) {
+          pt2 = 0;
+          pi2 = tess1d->nodes[1];
+        }
+        i1 = tris[3*itri-3]-1;
+        i2 = tris[3*itri-2]-1;
+        i3 = tris[3*itri-1]-1;
+        if (((pindex[i2] == pi1) && (ptype[i2] == pt1) &&
+             (pindex[i3] == pi2) && (ptype[i3] == pt2)) ||
+            ((pindex[i2] == pi2) && (ptype[i2] == pt2) &&
+             (pindex[i3] == pi1) && (ptype[i3] == pt1))) {
+          vert = i1 + 1;
+          v0   = i2 + 1;
+          v1   = i3 + 1;
+          n0   = tric[3*itri-2];
+          n1   = tric[3*itri-1];
+        } else if (((pindex[i1] == pi1) && (ptype[i1] == pt1) &&
+                    (pindex[i3] == pi2) && (ptype[i3] == pt2)) ||
+                   ((pindex[i1] == pi2) && (ptype[i1] == pt2) &&
+                    (pindex[i3] == pi1) && (ptype[i3] == pt1))) {
+          v1   = i1 + 1;
+          vert = i2 + 1;
+          v0   = i3 + 1;
+          n1   = tric[3*itri-3];
+          n0   = tric[3*itri-1];
+        } else if (((pindex[i1] == pi1) && (ptype[i1] == pt1) &&
+                    (pindex[i2] == pi2) && (ptype[i2] == pt2)) ||
+                   ((pindex[i1] == pi2) && (ptype[i1] == pt2) &&
+                    (pindex[i2] == pi1) && (ptype[i2] == pt1))) {
+          v0   = i1 + 1;
+          v1   = i2 + 1;
+          vert = i3 + 1;
+          n0   = tric[3*itri-3];
+          n1   = tric[3*itri-2];
+        } else {
+          printf(" EGADS Internal: Can not find segment for %d %d  %d %d - %d!\n",
+                 pt1, pi1, pt2, pi2, npt0);
+          /* fill in some values -- we are dropping through */
+          v0   = i1 + 1;
+          v1   = i2 + 1;
+          vert = i3 + 1;
+          n0   = tric[3*itri-3];
+          n1   = tric[3*itri-2];
+        }
+        if ((ptype[v1-1] == pt1) && (pindex[v1-1] == pi1)) {
+          i     =  v0;
+          v0    =  v1;
+          v1    =  i;
+#ifndef __clang_analyzer__
+          i     =  n0;
+#endif
+          n0    =  n1;
+#ifndef __clang_analyzer__
+          n1    =  i;
+#endif
+          sense = -1;
+        }
+        it3[0] = tris[3*itri-3];
+        it3[1] = tris[3*itri-2];
+        it3[2] = tris[3*itri-1];
+        for (i = 0; i < 3; i++) {
+          if (it3[i] == v1) tris[3*itri+i-3] = vbase + 1;
+          if (it3[i] == v0) tric[3*itri+i-3] = nt    + 1;
+        }
+        nl = itri;
+        for (i = 0; i < nins[k]; i++) {
+          j  = nt    + i;
+          v0 = vbase + i + 1;
+          vn = vbase + i + 2;
+          nn = j+2;
+          if (i == nins[k]-1) {
+            vn = v1;
+            nn = n0;
+          }
+          tris[3*j  ] =  vert;
+          tric[3*j  ] = -eIndex;
+          if (sense == 1) {
+            tris[3*j+1] = v0;
+            tris[3*j+2] = vn;
+            tric[3*j+1] = nn;
+            tric[3*j+2] = nl;
+          } else {
+            tris[3*j+1] = vn;
+            tris[3*j+2] = v0;
+            tric[3*j+1] = nl;
+            tric[3*j+2] = nn;
+          }
+          etric[m][nf*(row+1+i)+nx] = j + 1;
+          nl = j+1;
+        }
+        
+        /* the side opposite v0 is now in the last new triangle */
+        if (n0 > 0) {
+          for (i = 0; i < 3; i++)
+            if (tric[3*n0+i-3] == itri) tric[3*n0+i-3] = nt + nins[k];
+        } else if (n0 < 0) {
+          ie = -n0;
+          for (n = 0; n < 2; n++) {
+            if (ie == eIndex) {
+              if (etric[n] == NULL) continue;
+              nfr = tess1d->faces[n].nface;
+              ref = nx + 1;
+              if (n != m) ref = EG_faceConnIndex(tess1d->faces[n], iface);
+              if (ref == 0) continue;
+              for (i = 0; i < nrow; i++) {
+                if ((n == m) && (i >= row) && (i < row+nins[k])) continue;
+                if (etric[n][nfr*i+ref-1] == itri)
+                  etric[n][nfr*i+ref-1] = nt + nins[k];
+              }
+            } else {
+              if (btess->tess1d[ie-1].faces[n].tric == NULL) continue;
+              nfr = btess->tess1d[ie-1].faces[n].nface;
+              ref = EG_faceConnIndex(btess->tess1d[ie-1].faces[n], iface);
+              if (ref == 0) continue;
+              for (i = 0; i < btess->tess1d[ie-1].npts-1; i++)
+                if (btess->tess1d[ie-1].faces[n].tric[nfr*i+ref-1] == itri)
+                  btess->tess1d[ie-1].faces[n].tric[nfr*i+ref-1] = nt+nins[k];
+            }
+          }
+        }
+        nt += nins[k];
+      }
+
+      /* update the Face pointers */
+      if (tess2d->xyz    != NULL) EG_free(tess2d->xyz);
+      if (tess2d->uv     != NULL) EG_free(tess2d->uv);
+      if (tess2d->ptype  != NULL) EG_free(tess2d->ptype);
+      if (tess2d->pindex != NULL) EG_free(tess2d->pindex);
+      if (tess2d->bary   != NULL) EG_free(tess2d->bary);
+      if (tess2d->frame  != NULL) EG_free(tess2d->frame);
+      if (tess2d->frlps  != NULL) EG_free(tess2d->frlps);
+      if (tess2d->tris   != NULL) EG_free(tess2d->tris);
+      if (tess2d->tric   != NULL) EG_free(tess2d->tric);
+      tess2d->xyz    = xyz;
+      tess2d->uv     = uv;
+      tess2d->ptype  = ptype;
+      tess2d->pindex = pindex;
+      tess2d->bary   = NULL;
+      tess2d->frame  = NULL;
+      tess2d->frlps  = NULL;
+      tess2d->tris   = tris;
+      tess2d->tric   = tric;
+      tess2d->ntris  = nt;
+      tess2d->npts   = nv + ntot;
+      freals[2*cnt] = freals[2*cnt+1] = NULL;
+      fints[4*cnt]  = fints[4*cnt+1]  = fints[4*cnt+2] = fints[4*cnt+3] = NULL;
+
+      /* delete any quads and mark the frame as invalid */
+      EG_deleteQuads(btess, iface);
+
+      cnt++;
+    }
+  }
+  
+  /* set the updated Edge tessellation */
+  if (tess1d->faces[0].tric != NULL) EG_free(tess1d->faces[0].tric);
+  if (tess1d->faces[1].tric != NULL) EG_free(tess1d->faces[1].tric);
+  tess1d->faces[0].tric = etric[0];
+  tess1d->faces[1].tric = etric[1];
+  if (tess1d->xyz != NULL) EG_free(tess1d->xyz);
+  if (tess1d->t   != NULL) EG_free(tess1d->t);
+  tess1d->xyz   = xyzs;
+  tess1d->t     = ts;
+  tess1d->npts += ntot;
+  etric[0] = etric[1] = NULL;
+  xyzs     = ts       = NULL;
+  stat     = EGADS_SUCCESS;
+  
+#ifdef CHECK
+  EG_checkTriangulation(btess);
+#endif
+
+bail:
+  if (freals != NULL) {
+    for (i = 0; i < 2*nuse; i++)
+      if (freals[i] != NULL) EG_free(freals[i]);
+    EG_free(freals);
+  }
+  if (fints != NULL) {
+    for (i = 0; i < 4*nuse; i++)
+      if (fints[i] != NULL) EG_free(fints[i]);
+    EG_free(fints);
+  }
+  if (etric[0] != NULL) EG_free(etric[0]);
+  if (etric[1] != NULL) EG_free(etric[1]);
+  if (ts       != NULL) EG_free(ts);
+  if (xyzs     != NULL) EG_free(xyzs);
+  EG_free(vals);
+  EG_free(offs);
+  return stat;
+}
+
+
 __HOST_AND_DEVICE__ int
 EG_insertEdgeVerts(egObject *tess, int eIndex, int vIndex, int npts,
                    double *t)
 {
-  int      i, j, k, m, nf, nx, stat, outLevel, nedge, nface, iface, itri;
-  int      n0, n1, v0, v1, vert, vn, nl, nn, sense, pt1, pi1, pt2, pi2;
-  int      i1, i2, i3, cnt, stripe;
-  int      *etric[2], *pindex, *ptype, *tris, *tric;
-  double   result[9], *vals, *xyzs, *ts, *xyz, *uv;
+  int      i, m, nf, nx, stat, outLevel, nedge, nface, iface, itri;
+  int      i1, i2, i3, cnt;
   egTessel *btess;
   egObject *obj, **edges, **faces;
 
@@ -5397,419 +6477,522 @@ EG_insertEdgeVerts(egObject *tess, int eIndex, int vIndex, int npts,
     }
   }
 
-  stripe = 3 + 2*cnt;
-  vals   = (double *) EG_alloc(stripe*npts*sizeof(double));
-  if (vals == NULL) {
+  if (btess->edits != NULL)
+    return EG_queueEdgeEdit(btess, EDITINSERT, eIndex, vIndex, 0, npts, t,
+                            outLevel);
+
+  if (obj->oclass == EBODY) {
+    stat = EG_getBodyTopos(obj, NULL, EEDGE, &nedge, &edges);
+    if (stat != EGADS_SUCCESS) return stat;
+    stat = EG_getBodyTopos(obj, NULL, EFACE, &nface, &faces);
+  } else {
+    stat = EG_getBodyTopos(obj, NULL,  EDGE, &nedge, &edges);
+    if (stat != EGADS_SUCCESS) return stat;
+    stat = EG_getBodyTopos(obj, NULL,  FACE, &nface, &faces);
+  }
+  if (stat != EGADS_SUCCESS) {
+    EG_free(edges);
+    return stat;
+  }
+  
+  /* cleanup mappings */
+  EG_cleanupTessMaps(btess);
+  
+  stat = EG_edgeVertsInsert(btess, edges, faces, eIndex, 1, &vIndex, &npts,
+                            t, outLevel);
+  EG_free(faces);
+  EG_free(edges);
+
+  return stat;
+}
+
+
+__HOST_AND_DEVICE__ static int
+EG_edgeEditTess(const egObject *tess, const char *func, egTessel **btessx)
+{
+  int      outLevel;
+  egTessel *btess;
+  egObject *obj;
+  
+  *btessx = NULL;
+  if (tess == NULL)                 return EGADS_NULLOBJ;
+  if (tess->magicnumber != MAGIC)   return EGADS_NOTOBJ;
+  if (tess->oclass != TESSELLATION) return EGADS_NOTTESS;
+  if (EG_sameThread(tess))          return EGADS_CNTXTHRD;
+  outLevel = EG_outLevel(tess);
+  
+  btess = (egTessel *) tess->blind;
+  if (btess == NULL) {
+    if (outLevel > 0)
+      printf(" EGADS Error: NULL Blind Object (%s)!\n", func);
+    return EGADS_NOTFOUND;
+  }
+  if (btess->done != 1) {
+    if (outLevel > 0)
+      printf(" EGADS Error: Bad State (%s)!\n", func);
+    return EGADS_TESSTATE;
+  }
+  obj = btess->src;
+  if (obj == NULL) {
+    if (outLevel > 0)
+      printf(" EGADS Error: NULL Source Object (%s)!\n", func);
+    return EGADS_NULLOBJ;
+  }
+  if (obj->magicnumber != MAGIC) {
+    if (outLevel > 0)
+      printf(" EGADS Error: Source Not an Object (%s)!\n", func);
+    return EGADS_NOTOBJ;
+  }
+  if ((obj->oclass != BODY) && (obj->oclass != EBODY)) {
+    if (outLevel > 0)
+      printf(" EGADS Error: Source Not Body (%s)!\n", func);
+    return EGADS_NOTBODY;
+  }
+  if (btess->tess1d == NULL) {
+    if (outLevel > 0)
+      printf(" EGADS Error: No Edge Tessellations (%s)!\n", func);
+    return EGADS_NODATA;
+  }
+  
+  *btessx = btess;
+  return EGADS_SUCCESS;
+}
+
+
+__HOST_AND_DEVICE__ int
+EG_beginEdgeEdits(egObject *tess)
+{
+  int         stat;
+  egTessel    *btess;
+  egEdgeEdits *queue;
+  
+  stat = EG_edgeEditTess(tess, "EG_beginEdgeEdits", &btess);
+  if (stat != EGADS_SUCCESS) return stat;
+  if (btess->edits != NULL) {
+    if (EG_outLevel(tess) > 0)
+      printf(" EGADS Error: Edits already open (EG_beginEdgeEdits)!\n");
+    return EGADS_TESSTATE;
+  }
+  
+  queue = (egEdgeEdits *) EG_alloc(sizeof(egEdgeEdits));
+  if (queue == NULL) return EGADS_MALLOC;
+  queue->edits = NULL;
+  queue->ts    = NULL;
+  queue->nedit = queue->medit = 0;
+  queue->nts   = queue->mts   = 0;
+  btess->edits = queue;
+  
+  return EGADS_SUCCESS;
+}
+
+
+__HOST_AND_DEVICE__ int
+EG_abortEdgeEdits(egObject *tess)
+{
+  int      stat;
+  egTessel *btess;
+  
+  stat = EG_edgeEditTess(tess, "EG_abortEdgeEdits", &btess);
+  if (stat != EGADS_SUCCESS) return stat;
+  if (btess->edits == NULL) return EGADS_TESSTATE;
+  
+  EG_cleanupEdgeEdits(btess);
+  return EGADS_SUCCESS;
+}
+
+
+/*
+ * commits are atomic: the edits are applied to a staged copy of the Edges
+ *   and Faces that they can touch (the Faces adjacent to an edited Edge and
+ *   all of the Edges bounding those Faces). Everything else is shared. The
+ *   staged entries replace the originals only when every edit succeeds.
+ */
+
+__HOST_AND_DEVICE__ static void
+EG_freeEditStage(egTessel *stage, const int *mark, int nEdge, int nFace)
+{
+  int      i, m;
+  egTess1D *tess1d;
+  egTess2D *tess2d;
+  
+  if (stage->tess1d != NULL) {
+    for (i = 0; i < nEdge; i++) {
+      if (mark[i] == 0) continue;
+      tess1d = &stage->tess1d[i];
+      for (m = 0; m < 2; m++)
+        if (tess1d->faces[m].tric != NULL) EG_free(tess1d->faces[m].tric);
+      if (tess1d->xyz != NULL) EG_free(tess1d->xyz);
+      if (tess1d->t   != NULL) EG_free(tess1d->t);
+    }
+    EG_free(stage->tess1d);
+  }
+  if (stage->tess2d != NULL) {
+    for (i = 0; i < nFace; i++) {
+      if (mark[nEdge+i] == 0) continue;
+      tess2d = &stage->tess2d[i];
+      if (tess2d->xyz    != NULL) EG_free(tess2d->xyz);
+      if (tess2d->uv     != NULL) EG_free(tess2d->uv);
+      if (tess2d->ptype  != NULL) EG_free(tess2d->ptype);
+      if (tess2d->pindex != NULL) EG_free(tess2d->pindex);
+      if (tess2d->bary   != NULL) EG_free(tess2d->bary);
+      if (tess2d->frame  != NULL) EG_free(tess2d->frame);
+      if (tess2d->frlps  != NULL) EG_free(tess2d->frlps);
+      if (tess2d->tris   != NULL) EG_free(tess2d->tris);
+      if (tess2d->tric   != NULL) EG_free(tess2d->tric);
+    }
+    EG_free(stage->tess2d);
+  }
+  stage->tess1d = NULL;
+  stage->tess2d = NULL;
+}
+
+
+__HOST_AND_DEVICE__ static int
+EG_makeEditStage(const egTessel *btess, const egEdgeEdits *queue, int *mark,
+                 egTessel *stage)
+{
+  int      i, j, m, n, nf, iface, nEdge, nFace;
+  egTess1D *src1d, *tess1d;
+  egTess2D *src2d, *tess2d;
+  
+  nEdge = btess->nEdge;
+  nFace = btess->nFace;
+  
+  /* mark the Faces about the edited Edges */
+  for (i = 0; i < nEdge+nFace; i++) mark[i] = 0;
+  for (i = 0; i < queue->nedit; i++) {
+    src1d = &btess->tess1d[queue->edits[i].eIndex-1];
+    for (m = 0; m < 2; m++) {
+      nf = src1d->faces[m].nface;
+      for (j = 0; j < nf; j++) {
+        iface = src1d->faces[m].index;
+        if (nf > 1) iface = src1d->faces[m].faces[j];
+        if (iface != 0) mark[nEdge+iface-1] = 1;
+      }
+    }
+  }
+  /* and the Edges that bound them */
+  for (i = 0; i < nEdge; i++)
+    for (m = 0; m < 2; m++) {
+      nf = btess->tess1d[i].faces[m].nface;
+      for (j = 0; j < nf; j++) {
+        iface = btess->tess1d[i].faces[m].index;
+        if (nf > 1) iface = btess->tess1d[i].faces[m].faces[j];
+        if (iface != 0)
+          if (mark[nEdge+iface-1] != 0) mark[i] = 1;
+      }
+    }
+  
+  *stage        = *btess;
+  stage->tess1d = (egTess1D *) EG_alloc(nEdge*sizeof(egTess1D));
+  stage->tess2d = (egTess2D *) EG_alloc(2*nFace*sizeof(egTess2D));
+  if ((stage->tess1d == NULL) || (stage->tess2d == NULL)) {
+    if (stage->tess1d != NULL) EG_free(stage->tess1d);
+    if (stage->tess2d != NULL) EG_free(stage->tess2d);
+    stage->tess1d = NULL;
+    stage->tess2d = NULL;
+    return EGADS_MALLOC;
+  }
+  for (i = 0; i < nEdge; i++) {
+    stage->tess1d[i] = btess->tess1d[i];
+    if (mark[i] == 0) continue;
+    tess1d = &stage->tess1d[i];
+    tess1d->xyz = NULL;
+    tess1d->t   = NULL;
+    tess1d->faces[0].tric = tess1d->faces[1].tric = NULL;
+  }
+  for (i = 0; i < 2*nFace; i++) {
+    stage->tess2d[i] = btess->tess2d[i];
+    if (i >= nFace) {
+      /* the quads of a touched Face are always deleted */
+      if (mark[nEdge+i-nFace] == 0) continue;
+      tess2d = &stage->tess2d[i];
+      tess2d->xyz    = NULL;
+      tess2d->uv     = NULL;
+      tess2d->ptype  = NULL;
+      tess2d->pindex = NULL;
+      tess2d->npts   = 0;
+      tess2d->patch  = NULL;
+      tess2d->npatch = 0;
+      continue;
+    }
+    if (mark[nEdge+i] == 0) continue;
+    tess2d = &stage->tess2d[i];
+    tess2d->xyz    = NULL;
+    tess2d->uv     = NULL;
+    tess2d->ptype  = NULL;
+    tess2d->pindex = NULL;
+    tess2d->tris   = NULL;
+    tess2d->tric   = NULL;
+    /* as is the frame */
+    tess2d->bary   = NULL;
+    tess2d->frame  = NULL;
+    tess2d->frlps  = NULL;
+  }
+  
+  /* deep copies of the marked entries */
+  for (i = 0; i < nEdge; i++) {
+    if (mark[i] == 0) continue;
+    src1d  = &btess->tess1d[i];
+    tess1d = &stage->tess1d[i];
+    n      = src1d->npts;
+    if (n == 0) continue;
+    tess1d->xyz = (double *) EG_alloc(3*n*sizeof(double));
+    tess1d->t   = (double *) EG_alloc(  n*sizeof(double));
+    if ((tess1d->xyz == NULL) || (tess1d->t == NULL)) goto nomem;
+    for (j = 0; j < 3*n; j++) tess1d->xyz[j] = src1d->xyz[j];
+    for (j = 0;   j < n; j++) tess1d->t[j]   = src1d->t[j];
+    for (m = 0; m < 2; m++) {
+      if (src1d->faces[m].tric == NULL) continue;
+      nf = src1d->faces[m].nface*(n-1);
+      tess1d->faces[m].tric = (int *) EG_alloc(nf*sizeof(int));
+      if (tess1d->faces[m].tric == NULL) goto nomem;
+      for (j = 0; j < nf; j++) tess1d->faces[m].tric[j] = src1d->faces[m].tric[j];
+    }
+  }
+  for (i = 0; i < nFace; i++) {
+    if (mark[nEdge+i] == 0) continue;
+    src2d  = &btess->tess2d[i];
+    tess2d = &stage->tess2d[i];
+    n      = src2d->npts;
+    nf     = src2d->ntris;
+    if ((n == 0) || (nf == 0)) continue;
+    tess2d->xyz    = (double *) EG_alloc(3*n*sizeof(double));
+    tess2d->uv     = (double *) EG_alloc(2*n*sizeof(double));
+    tess2d->ptype  = (int *)    EG_alloc(  n*sizeof(int));
+    tess2d->pindex = (int *)    EG_alloc(  n*sizeof(int));
+    tess2d->tris   = (int *)    EG_alloc(3*nf*sizeof(int));
+    tess2d->tric   = (int *)    EG_alloc(3*nf*sizeof(int));
+    if ((tess2d->xyz   == NULL) || (tess2d->uv     == NULL) ||
+        (tess2d->ptype == NULL) || (tess2d->pindex == NULL) ||
+        (tess2d->tris  == NULL) || (tess2d->tric   == NULL)) goto nomem;
+    for (j = 0; j < 3*n; j++) tess2d->xyz[j] = src2d->xyz[j];
+    for (j = 0; j < 2*n; j++) tess2d->uv[j]  = src2d->uv[j];
+    for (j = 0; j <   n; j++) {
+      tess2d->ptype[j]  = src2d->ptype[j];
+      tess2d->pindex[j] = src2d->pindex[j];
+    }
+    for (j = 0; j < 3*nf; j++) {
+      tess2d->tris[j] = src2d->tris[j];
+      tess2d->tric[j] = src2d->tric[j];
+    }
+  }
+  
+  return EGADS_SUCCESS;
+  
+nomem:
+  EG_freeEditStage(stage, mark, nEdge, nFace);
+  return EGADS_MALLOC;
+}
+
+
+/* the staged entries replace the originals */
+
+__HOST_AND_DEVICE__ static void
+EG_swapEditStage(egTessel *btess, egTessel *stage, const int *mark)
+{
+  int      i, m, nEdge, nFace;
+  egTess1D *tess1d;
+  egTess2D *tess2d;
+  
+  nEdge = btess->nEdge;
+  nFace = btess->nFace;
+  for (i = 0; i < nEdge; i++) {
+    if (mark[i] == 0) continue;
+    tess1d = &btess->tess1d[i];
+    for (m = 0; m < 2; m++)
+      if (tess1d->faces[m].tric != NULL) EG_free(tess1d->faces[m].tric);
+    if (tess1d->xyz != NULL) EG_free(tess1d->xyz);
+    if (tess1d->t   != NULL) EG_free(tess1d->t);
+    *tess1d = stage->tess1d[i];
+  }
+  for (i = 0; i < nFace; i++) {
+    if (mark[nEdge+i] == 0) continue;
+    tess2d = &btess->tess2d[i];
+    if (tess2d->xyz    != NULL) EG_free(tess2d->xyz);
+    if (tess2d->uv     != NULL) EG_free(tess2d->uv);
+    if (tess2d->ptype  != NULL) EG_free(tess2d->ptype);
+    if (tess2d->pindex != NULL) EG_free(tess2d->pindex);
+    if (tess2d->bary   != NULL) EG_free(tess2d->bary);
+    if (tess2d->frame  != NULL) EG_free(tess2d->frame);
+    if (tess2d->frlps  != NULL) EG_free(tess2d->frlps);
+    if (tess2d->tris   != NULL) EG_free(tess2d->tris);
+    if (tess2d->tric   != NULL) EG_free(tess2d->tric);
+    *tess2d = stage->tess2d[i];
+    EG_deleteQuads(btess, i+1);
+  }
+  EG_free(stage->tess1d);
+  EG_free(stage->tess2d);
+  stage->tess1d = NULL;
+  stage->tess2d = NULL;
+}
+
+
+/*
+ * applies the queued edits: moves first (which do not change numbering),
+ *   then deletes from the back of each Edge and finally all of the inserts
+ *   for an Edge in a single pass. Any failure leaves the tessellation as it
+ *   was; otherwise the global maps are invalidated once.
+ */
+
+__HOST_AND_DEVICE__ int
+EG_commitEdgeEdits(egObject *tess)
+{
+  int         i, j, k, v, stat, outLevel, nedge, nface, eIndex, npt, nseg;
+  int         ndel, *ecnt, *order, *vop, *sop, *segs, *nins, *mark;
+  double      *ts;
+  egTessel    *btess, stage;
+  egEdgeEdit  *edit;
+  egEdgeEdits *queue;
+  egObject    *obj, **edges, **faces;
+  
+  stat = EG_edgeEditTess(tess, "EG_commitEdgeEdits", &btess);
+  if (stat != EGADS_SUCCESS) return stat;
+  outLevel = EG_outLevel(tess);
+  if (btess->edits == NULL) {
     if (outLevel > 0)
-      printf(" EGADS Error: Malloc on Tmp %d %d (EG_insertEdgeVerts)!\n",
-             npts, stripe);
-    return EGADS_MALLOC;
+      printf(" EGADS Error: No open Edits (EG_commitEdgeEdits)!\n");
+    return EGADS_TESSTATE;
   }
+  queue = (egEdgeEdits *) btess->edits;
+  if (queue->nedit == 0) {
+    EG_cleanupEdgeEdits(btess);
+    return EGADS_SUCCESS;
+  }
+  
+  obj = btess->src;
   if (obj->oclass == EBODY) {
     stat = EG_getBodyTopos(obj, NULL, EEDGE, &nedge, &edges);
-    if (stat != EGADS_SUCCESS) {
-      EG_free(vals);
-      return stat;
-    }
+    if (stat != EGADS_SUCCESS) return stat;
     stat = EG_getBodyTopos(obj, NULL, EFACE, &nface, &faces);
   } else {
     stat = EG_getBodyTopos(obj, NULL,  EDGE, &nedge, &edges);
-    if (stat != EGADS_SUCCESS) {
-      EG_free(vals);
-      return stat;
-    }
+    if (stat != EGADS_SUCCESS) return stat;
     stat = EG_getBodyTopos(obj, NULL,  FACE, &nface, &faces);
   }
   if (stat != EGADS_SUCCESS) {
     EG_free(edges);
-    EG_free(vals);
     return stat;
   }
-
-  /* get the new data on the Edge and Faces */
-  for (i = 0; i < npts; i++) {
-    stat = EG_evaluate(edges[eIndex-1], &t[i], result);
-    if (stat != EGADS_SUCCESS) {
-      EG_free(faces);
-      EG_free(edges);
-      EG_free(vals);
-      return stat;
-    }
-    vals[stripe*i  ] = result[0];
-    vals[stripe*i+1] = result[1];
-    vals[stripe*i+2] = result[2];
-    for (cnt = m = 0; m < 2; m++) {
-      nf = btess->tess1d[eIndex-1].faces[m].nface;
-      for (nx = 0; nx < nf; nx++) {
-        iface = btess->tess1d[eIndex-1].faces[m].index;
-        if (nf > 1) iface = btess->tess1d[eIndex-1].faces[m].faces[nx];
-        if (iface == 0) continue;
-        sense = faces[iface-1]->mtype;
-        if (EG_faceConnIndex(btess->tess1d[eIndex-1].faces[1-m], iface) == 0)
-          sense = 0;
-        if (m == 0) sense = -sense;
-        stat = EG_getEdgeUV(faces[iface-1], edges[eIndex-1], sense, 
-                            t[i], &vals[stripe*i+3+2*cnt]);
-        if (stat != EGADS_SUCCESS) {
-          EG_free(faces);
-          EG_free(edges);
-          EG_free(vals);
-          return stat;
-        }
-        cnt++;
-      }
-    }
-  }
-  EG_free(faces);
-  EG_free(edges);
   
-  /* get all of the Edge memory we will need */
-  xyzs = (double *) EG_alloc(3*(npts+btess->tess1d[eIndex-1].npts)*
-                             sizeof(double));
-  ts   = (double *) EG_alloc(  (npts+btess->tess1d[eIndex-1].npts)*
-                             sizeof(double));
-  if ((xyzs == NULL) || (ts == NULL)) {
-    if (outLevel > 0)
-      printf(" EGADS Error: Malloc on Edge %d %d (EG_insertEdgeVerts)!\n",
-             npts, btess->tess1d[eIndex-1].npts);
-    if (ts   != NULL) EG_free(ts);
-    if (xyzs != NULL) EG_free(xyzs);
-    EG_free(vals);
+  /* bucket the edits by Edge */
+  ecnt  = (int *) EG_alloc((btess->nEdge+1)*sizeof(int));
+  order = (int *) EG_alloc((3*queue->nedit)*sizeof(int));
+  ts    = (double *) EG_alloc(queue->nts*sizeof(double));
+  mark  = (int *) EG_alloc((btess->nEdge+btess->nFace)*sizeof(int));
+  if ((ecnt == NULL) || (order == NULL) || (mark == NULL) ||
+      ((ts == NULL) && (queue->nts > 0))) {
+    if (mark  != NULL) EG_free(mark);
+    if (ts    != NULL) EG_free(ts);
+    if (order != NULL) EG_free(order);
+    if (ecnt  != NULL) EG_free(ecnt);
+    EG_free(faces);
+    EG_free(edges);
     return EGADS_MALLOC;
   }
-  etric[0] = etric[1] = NULL;
-  nf = btess->tess1d[eIndex-1].faces[0].nface;
-  if (nf > 0) {
-    etric[0] = (int *) EG_alloc(nf*(npts+btess->tess1d[eIndex-1].npts-1)*
-                                sizeof(int));
-    if (etric[0] == NULL) {
-      if (outLevel > 0)
-        printf(" EGADS Error: Malloc on Edge- %d %d (EG_insertEdgeVerts)!\n",
-               npts, btess->tess1d[eIndex-1].npts-1);
-      EG_free(ts);
-      EG_free(xyzs);
-      EG_free(vals);
-      return EGADS_MALLOC;
-    }
+  segs = &order[  queue->nedit];
+  nins = &order[2*queue->nedit];
+  for (i = 0; i <= btess->nEdge; i++) ecnt[i] = 0;
+  for (i = 0; i < queue->nedit; i++) ecnt[queue->edits[i].eIndex]++;
+  for (i = 1; i <= btess->nEdge; i++) ecnt[i] += ecnt[i-1];
+  for (i = queue->nedit-1; i >= 0; i--) {
+    ecnt[queue->edits[i].eIndex]--;
+    order[ecnt[queue->edits[i].eIndex]] = i;
   }
-  nf = btess->tess1d[eIndex-1].faces[1].nface;
-  if (nf > 0) {
-    etric[1] = (int *) EG_alloc(nf*(npts+btess->tess1d[eIndex-1].npts-1)*
-                                sizeof(int));
-    if (etric[1] == NULL) {
-      if (outLevel > 0)
-        printf(" EGADS Error: Malloc on Edge+ %d %d (EG_insertEdgeVerts)!\n",
-               npts, btess->tess1d[eIndex-1].npts-1);
-      if (etric[0] != NULL) EG_free(etric[0]);
-      EG_free(ts);
-      EG_free(xyzs);
-      EG_free(vals);
-      return EGADS_MALLOC;
-    }
+  /* ecnt[e] is now the start of the Edge e bucket */
+  ecnt[0] = 0;
+
+  /* the edits are applied to the staged copy */
+  stat = EG_makeEditStage(btess, queue, mark, &stage);
+  if (stat != EGADS_SUCCESS) {
+    if (ts != NULL) EG_free(ts);
+    EG_free(mark);
+    EG_free(order);
+    EG_free(ecnt);
+    EG_free(faces);
+    EG_free(edges);
+    return stat;
   }
   
-  /* cleanup mappings */
-  EG_cleanupTessMaps(btess);
-  
-  /* set the new Edge tessellation information */
-  for (j = i = 0; i < btess->tess1d[eIndex-1].npts; i++, j++) {
-    xyzs[3*j  ] = btess->tess1d[eIndex-1].xyz[3*i  ];
-    xyzs[3*j+1] = btess->tess1d[eIndex-1].xyz[3*i+1];
-    xyzs[3*j+2] = btess->tess1d[eIndex-1].xyz[3*i+2];
-    ts[j]       = btess->tess1d[eIndex-1].t[i];
-    if (i != btess->tess1d[eIndex-1].npts-1)
-      for (m = 0; m < 2; m++) {
-        if (etric[m] == NULL) continue;
-        nf = btess->tess1d[eIndex-1].faces[m].nface;
-        for (nx = 0; nx < nf; nx++)
-          etric[m][j*nf+nx] = btess->tess1d[eIndex-1].faces[m].tric[i*nf+nx];
-      }
-    if (i != vIndex-1) continue;
-    for (k = 0; k < npts; k++) {
-      j++;
-      xyzs[3*j  ] = vals[stripe*k  ];
-      xyzs[3*j+1] = vals[stripe*k+1];
-      xyzs[3*j+2] = vals[stripe*k+2];
-      ts[j]       = t[k];
-      for (m = 0; m < 2; m++) {
-        if (etric[m] == NULL) continue;
-        nf = btess->tess1d[eIndex-1].faces[m].nface;
-        for (nx = 0; nx < nf; nx++) etric[m][j*nf+nx] = 0;
-      }
+  for (eIndex = 1; eIndex <= btess->nEdge; eIndex++) {
+    k = (eIndex == btess->nEdge) ? queue->nedit : ecnt[eIndex+1];
+    if (k == ecnt[eIndex]) continue;
+    npt = stage.tess1d[eIndex-1].npts;
+    vop = (int *) EG_alloc((2*npt+1)*sizeof(int));
+    if (vop == NULL) {
+      stat = EGADS_MALLOC;
+      break;
     }
-  }
-
-  /* do each Face touched by the Edge */
-  for (cnt = m = 0; m < 2; m++) {
-    nf = btess->tess1d[eIndex-1].faces[m].nface;
-    for (nx = 0; nx < nf; nx++) {
-      iface = btess->tess1d[eIndex-1].faces[m].index;
-      if (nf > 1) iface = btess->tess1d[eIndex-1].faces[m].faces[nx];
-      if (iface == 0) continue;
-      xyz    = (double *) EG_alloc(3*(npts+btess->tess2d[iface-1].npts)*
-                                   sizeof(double));
-      uv     = (double *) EG_alloc(2*(npts+btess->tess2d[iface-1].npts)*
-                                   sizeof(double));
-      ptype  = (int *)    EG_alloc(  (npts+btess->tess2d[iface-1].npts)*
-                                   sizeof(int));
-      pindex = (int *)    EG_alloc(  (npts+btess->tess2d[iface-1].npts)*
-                                   sizeof(int));
-      tris   = (int *)    EG_alloc(3*(npts+btess->tess2d[iface-1].ntris)*
-                                   sizeof(int));
-      tric   = (int *)    EG_alloc(3*(npts+btess->tess2d[iface-1].ntris)*
-                                   sizeof(int));
-      if ((xyz == NULL)    || (uv == NULL)   || (ptype == NULL) ||
-          (pindex == NULL) || (tris == NULL) || (tric == NULL)) {
-        if (outLevel > 0)
-          printf(" EGADS Error: Malloc on Edge %d %d (EG_insertEdgeVerts)!\n",
-                 npts, btess->tess1d[eIndex-1].npts);
-        if (tric     != NULL) EG_free(tric);
-        if (tris     != NULL) EG_free(tris);
-        if (pindex   != NULL) EG_free(pindex);
-        if (ptype    != NULL) EG_free(ptype);
-        if (uv       != NULL) EG_free(uv);
-        if (xyz      != NULL) EG_free(xyz);
-        if (etric[0] != NULL) EG_free(etric[0]);
-        if (etric[1] != NULL) EG_free(etric[1]);
-        EG_free(ts);
-        EG_free(xyzs);
-        EG_free(vals);
-        if (cnt != 0) EG_deleteObject(tess);
-        return EGADS_MALLOC;
-      }
-      for (i = 0; i < btess->tess2d[iface-1].npts; i++) {
-        xyz[3*i  ] = btess->tess2d[iface-1].xyz[3*i  ];
-        xyz[3*i+1] = btess->tess2d[iface-1].xyz[3*i+1];
-        xyz[3*i+2] = btess->tess2d[iface-1].xyz[3*i+2];
-        uv[2*i  ]  = btess->tess2d[iface-1].uv[2*i  ];
-        uv[2*i+1]  = btess->tess2d[iface-1].uv[2*i+1];
-        ptype[i]   = btess->tess2d[iface-1].ptype[i];
-        pindex[i]  = btess->tess2d[iface-1].pindex[i];
-        if (pindex[i] == eIndex) 
-          if (ptype[i] > vIndex) ptype[i] += npts;
-      }
-      j = btess->tess2d[iface-1].npts;
-      for (i = 0; i < npts; i++) {
-        xyz[3*(j+i)  ] = vals[stripe*i  ];
-        xyz[3*(j+i)+1] = vals[stripe*i+1];
-        xyz[3*(j+i)+2] = vals[stripe*i+2];
-        uv[2*(j+i)  ]  = vals[stripe*i+3+2*cnt  ];
-        uv[2*(j+i)+1]  = vals[stripe*i+3+2*cnt+1];
-        ptype[j+i]     = vIndex + i+1;
-        pindex[j+i]    = eIndex;
-      }
-      for (i = 0; i < btess->tess2d[iface-1].ntris; i++) {
-        tris[3*i  ] = btess->tess2d[iface-1].tris[3*i  ];
-        tris[3*i+1] = btess->tess2d[iface-1].tris[3*i+1];
-        tris[3*i+2] = btess->tess2d[iface-1].tris[3*i+2];
-        tric[3*i  ] = btess->tess2d[iface-1].tric[3*i  ];
-        tric[3*i+1] = btess->tess2d[iface-1].tric[3*i+1];
-        tric[3*i+2] = btess->tess2d[iface-1].tric[3*i+2];
-      }
-      
-      /* adjust the Face tessellation */
-      sense = 1;
-      if (etric[m] == NULL) {
-        printf(" EGADS Internal: Can not find Triangle %d!\n", m);
-        continue;
-      }
-      itri  = etric[m][(vIndex-1)*nf+nx];
-      pt1   =       vIndex;
-      pi1   = pi2 = eIndex;
-      pt2   = vIndex + 1;
-      if (vIndex == 1) {
-        pt1 = 0;
-        pi1 = btess->tess1d[eIndex-1].nodes[0];
-      }
-      if (pt2 == btess->tess1d[eIndex-1].npts) {
-        pt2 = 0;
-        pi2 = btess->tess1d[eIndex-1].nodes[1];
-      }
-      i1 = tris[3*itri-3]-1;
-      i2 = tris[3*itri-2]-1;
-      i3 = tris[3*itri-1]-1;        
-      if (((btess->tess2d[iface-1].pindex[i2] == pi1) &&
-           (btess->tess2d[iface-1].ptype[i2]  == pt1) &&
-           (btess->tess2d[iface-1].pindex[i3] == pi2) &&
-           (btess->tess2d[iface-1].ptype[i3]  == pt2)) || 
-          ((btess->tess2d[iface-1].pindex[i2] == pi2) &&
-           (btess->tess2d[iface-1].ptype[i2]  == pt2) &&
-           (btess->tess2d[iface-1].pindex[i3] == pi1) &&
-           (btess->tess2d[iface-1].ptype[i3]  == pt1))) {
-        vert = i1 + 1;
-        v0   = i2 + 1;
-        v1   = i3 + 1;
-        n0   = tric[3*itri-2];
-        n1   = tric[3*itri-1];
-/*      printf("    0: neighbor = %d\n", tric[m][3*itri-3]);  */
-      } else if (((btess->tess2d[iface-1].pindex[i1] == pi1) &&
-                  (btess->tess2d[iface-1].ptype[i1]  == pt1) &&
-                  (btess->tess2d[iface-1].pindex[i3] == pi2) &&
-                  (btess->tess2d[iface-1].ptype[i3]  == pt2)) || 
-                 ((btess->tess2d[iface-1].pindex[i1] == pi2) &&
-                  (btess->tess2d[iface-1].ptype[i1]  == pt2) &&
-                  (btess->tess2d[iface-1].pindex[i3] == pi1) &&
-                  (btess->tess2d[iface-1].ptype[i3]  == pt1))) {
-        v1   = i1 + 1;
-        vert = i2 + 1;
-        v0   = i3 + 1;
-        n1   = tric[3*itri-3];
-        n0   = tric[3*itri-1];
-/*      printf("    1: neighbor = %d\n", tric[m][3*itri-2]);  */
-      } else if (((btess->tess2d[iface-1].pindex[i1] == pi1) &&
-                  (btess->tess2d[iface-1].ptype[i1]  == pt1) &&
-                  (btess->tess2d[iface-1].pindex[i2] == pi2) &&
-                  (btess->tess2d[iface-1].ptype[i2]  == pt2)) || 
-                 ((btess->tess2d[iface-1].pindex[i1] == pi2) &&
-                  (btess->tess2d[iface-1].ptype[i1]  == pt2) &&
-                  (btess->tess2d[iface-1].pindex[i2] == pi1) &&
-                  (btess->tess2d[iface-1].ptype[i2]  == pt1))) {
-        v0   = i1 + 1;
-        v1   = i2 + 1;
-        vert = i3 + 1;
-        n0   = tric[3*itri-3];
-        n1   = tric[3*itri-2];
-/*      printf("    2: neighbor = %d\n", tric[m][3*itri-1]);  */
+    sop = &vop[npt+1];
+    for (i = 0; i < 2*npt+1; i++) vop[i] = -1;
+    for (i = ecnt[eIndex]; i < k; i++) {
+      edit = &queue->edits[order[i]];
+      if (edit->type == EDITINSERT) {
+        sop[edit->vIndex] = order[i];
       } else {
-        printf(" EGADS Internal: Can not find segment for %d %d  %d %d - %d!\n",
-               pt1, pi1, pt2, pi2, btess->tess1d[eIndex-1].npts);
-        /* fill in some values -- we are dropping through */
-        v0   = i1 + 1;
-        v1   = i2 + 1;
-        vert = i3 + 1;
-        n0   = tric[3*itri-3];
-        n1   = tric[3*itri-2];
-      }
-      if ((btess->tess2d[iface-1].ptype[v1-1]  == pt1) &&
-          (btess->tess2d[iface-1].pindex[v1-1] == pi1)) {
-        i     =  v0;
-        v0    =  v1;
-        v1    =  i;
-#ifndef __clang_analyzer__
-        i     =  n0;
-#endif
-        n0    =  n1;
-#ifndef __clang_analyzer__
-        n1    =  i;
-#endif
-        sense = -1;
-      }
-/*    printf("       %d: %d", iface, itri); 
-      printf(" vert = %d (%d/%d)  v0 = %d (%d/%d)  v1 = %d (%d/%d), sense = %d\n", 
-             vert, btess->tess2d[iface-1].ptype[vert-1], 
-                   btess->tess2d[iface-1].pindex[vert-1], 
-             v0,   btess->tess2d[iface-1].ptype[v0-1], 
-                   btess->tess2d[iface-1].pindex[v0-1], 
-             v1,   btess->tess2d[iface-1].ptype[v1-1], 
-                   btess->tess2d[iface-1].pindex[v1-1], sense);  */
-      for (i = 0; i < 3; i++) {
-        if (btess->tess2d[iface-1].tris[3*itri+i-3] == v1) 
-          tris[3*itri+i-3] = btess->tess2d[iface-1].npts  + 1;
-        if (btess->tess2d[iface-1].tris[3*itri+i-3] == v0) 
-          tric[3*itri+i-3] = btess->tess2d[iface-1].ntris + 1;
-      } 
-      nl = itri;
-      for (i = 0; i < npts; i++) {
-        j  = btess->tess2d[iface-1].ntris + i;
-        v0 = btess->tess2d[iface-1].npts  + i + 1;
-        vn = btess->tess2d[iface-1].npts  + i + 2;
-        nn = j+2;
-        if (i == npts-1) {
-          vn = v1;
-          nn = n0;
-        }
-        tris[3*j  ] =  vert;
-        tric[3*j  ] = -eIndex;
-        if (sense == 1) {
-          tris[3*j+1] = v0;
-          tris[3*j+2] = vn;
-          tric[3*j+1] = nn;
-          tric[3*j+2] = nl;
-        } else {
-          tris[3*j+1] = vn;
-          tris[3*j+2] = v0;
-          tric[3*j+1] = nl;
-          tric[3*j+2] = nn;
-        }
-        etric[m][nf*(vIndex+i)+nx] = j + 1;
-        nl = j+1;
+        vop[edit->vIndex] = order[i];
       }
-      if (n0 > 0) {
-        for (i = 0; i < 3; i++)
-          if (btess->tess2d[iface-1].tric[3*n0+i-3] == itri) 
-            tric[3*n0+i-3] = btess->tess2d[iface-1].ntris+npts;
-      } else if (n0 < 0) {
-        j = -n0 - 1;
-        if (btess->tess1d[j].faces[0].index == iface) {
-          for (k = i = 0; i < btess->tess1d[j].npts-1; i++)
-            if (etric[m][nf*i+nx] == itri) k++;
-          for (i = 0; i < btess->tess1d[j].npts-1; i++) {
-            if ((k > 1) && (i >= vIndex-1) && (i < vIndex+npts-1)) continue;
-            if (etric[m][nf*i+nx] == itri)
-              etric[m][nf*i+nx] = btess->tess2d[iface-1].ntris+npts;
-          }
-        }
+    }
+    
+    /* moves -- numbering is unchanged */
+    for (v = 2; v < npt; v++) {
+      if (vop[v] < 0) continue;
+      edit = &queue->edits[vop[v]];
+      if (edit->type != EDITMOVE) continue;
+      stat = EG_edgeVertMove(&stage, edges, faces, eIndex, v,
+                             queue->ts[edit->its]);
+      if (stat != EGADS_SUCCESS) break;
+    }
+    
+    /* deletes from the back so the lower indices remain valid */
+    if (stat == EGADS_SUCCESS)
+      for (v = npt-1; v > 1; v--) {
+        if (vop[v] < 0) continue;
+        edit = &queue->edits[vop[v]];
+        if (edit->type != EDITDELETE) continue;
+        stat = EG_edgeVertDelete(&stage, eIndex, v, edit->dir);
+        if (stat != EGADS_SUCCESS) break;
       }
 
-      /* update the Face pointers */
-      if (btess->tess2d[iface-1].xyz    != NULL) 
-        EG_free(btess->tess2d[iface-1].xyz);
-      if (btess->tess2d[iface-1].uv     != NULL) 
-        EG_free(btess->tess2d[iface-1].uv);
-      if (btess->tess2d[iface-1].ptype  != NULL) 
-        EG_free(btess->tess2d[iface-1].ptype);
-      if (btess->tess2d[iface-1].pindex != NULL) 
-        EG_free(btess->tess2d[iface-1].pindex);
-      if (btess->tess2d[iface-1].bary   != NULL)
-        EG_free(btess->tess2d[iface-1].bary);
-      if (btess->tess2d[iface-1].frame  != NULL)
-        EG_free(btess->tess2d[iface-1].frame);
-      if (btess->tess2d[iface-1].frlps != NULL)
-        EG_free(btess->tess2d[iface-1].frlps);
-      if (btess->tess2d[iface-1].tris   != NULL)
-        EG_free(btess->tess2d[iface-1].tris);
-      if (btess->tess2d[iface-1].tric   != NULL) 
-        EG_free(btess->tess2d[iface-1].tric);
-      btess->tess2d[iface-1].xyz    = xyz;
-      btess->tess2d[iface-1].uv     = uv;
-      btess->tess2d[iface-1].ptype  = ptype;
-      btess->tess2d[iface-1].pindex = pindex;
-      btess->tess2d[iface-1].bary   = NULL;
-      btess->tess2d[iface-1].frame  = NULL;
-      btess->tess2d[iface-1].frlps  = NULL;
-      btess->tess2d[iface-1].tris   = tris;
-      btess->tess2d[iface-1].tric   = tric;
-      btess->tess2d[iface-1].ntris += npts;
-      btess->tess2d[iface-1].npts  += npts;
-
-      /* delete any quads and mark the frame as invalid */
-      EG_deleteQuads(btess, iface);
-
-      cnt++;
-    }
+    /* all inserts in one pass -- segments shifted by the deletes */
+    if (stat == EGADS_SUCCESS) {
+      for (nseg = ndel = j = 0, v = 1; v < npt; v++) {
+        if (vop[v] >= 0)
+          if (queue->edits[vop[v]].type == EDITDELETE) ndel++;
+        if (sop[v] < 0) continue;
+        edit       = &queue->edits[sop[v]];
+        segs[nseg] = v - ndel;
+        nins[nseg] = edit->npts;
+        for (i = 0; i < edit->npts; i++, j++) ts[j] = queue->ts[edit->its+i];
+        nseg++;
+      }
+      if (nseg != 0)
+        stat = EG_edgeVertsInsert(&stage, edges, faces, eIndex, nseg, segs,
+                                  nins, ts, outLevel);
+    }
+    EG_free(vop);
+    if (stat != EGADS_SUCCESS) break;
+  }
+  if (stat == EGADS_SUCCESS) {
+    EG_swapEditStage(btess, &stage, mark);
+    /* cleanup mappings */
+    EG_cleanupTessMaps(btess);
+  } else {
+    if (outLevel > 0)
+      printf(" EGADS Error: Edge %d = %d -- nothing applied (EG_commitEdgeEdits)!\n",
+             eIndex, stat);
+    EG_freeEditStage(&stage, mark, btess->nEdge, btess->nFace);
   }
-  EG_free(vals);
   
-  /* set the updated Edge tessellation */
-  if (btess->tess1d[eIndex-1].faces[0].tric != NULL) 
-    EG_free(btess->tess1d[eIndex-1].faces[0].tric);
-  if (btess->tess1d[eIndex-1].faces[1].tric != NULL) 
-    EG_free(btess->tess1d[eIndex-1].faces[1].tric);
-  btess->tess1d[eIndex-1].faces[0].tric = etric[0];
-  btess->tess1d[eIndex-1].faces[1].tric = etric[1];
-  if (btess->tess1d[eIndex-1].xyz  != NULL) 
-    EG_free(btess->tess1d[eIndex-1].xyz);
-  if (btess->tess1d[eIndex-1].t    != NULL) 
-    EG_free(btess->tess1d[eIndex-1].t);
-  btess->tess1d[eIndex-1].xyz   = xyzs;
-  btess->tess1d[eIndex-1].t     = ts;
-  btess->tess1d[eIndex-1].npts += npts;
+  if (ts != NULL) EG_free(ts);
+  EG_free(mark);
+  EG_free(order);
+  EG_free(ecnt);
+  EG_free(faces);
+  EG_free(edges);
+  EG_cleanupEdgeEdits(btess);
   
-#ifdef CHECK
-  EG_checkTriangulation(btess);
-#endif
-
-  return EGADS_SUCCESS;
+  return stat;
 }
 
 
@@ -5874,6 +7057,8 @@ EG_tessThread(void *struc)
   fast.pts     = NULL;
   fast.segs    = NULL;
   fast.front   = NULL;
+  fast.grid    = NULL;
+  fast.link    = NULL;
  
   /* look for work */
   for (;;) {
@@ -5968,6 +7153,8 @@ EG_tessThread(void *struc)
   if (fast.segs  != NULL) EG_free(fast.segs);
   if (fast.pts   != NULL) EG_free(fast.pts);
   if (fast.front != NULL) EG_free(fast.front);
+  if (fast.grid  != NULL) EG_free(fast.grid);
+  if (fast.link  != NULL) EG_free(fast.link);
   
   if (ID != tthread->master) EMP_ThreadExit();
 }
@@ -6032,6 +7219,7 @@ EG_makeTessBody(egObject *object, double *paramx, egObject **tess)
   btess->tess1d    = NULL;
   btess->tess2d    = NULL;
   btess->globals   = NULL;
+  btess->edits     = NULL;
   btess->nGlobal   = 0;
   btess->nEdge     = 0;
   btess->nFace     = 0;
@@ -6972,6 +8160,7 @@ EG_mapTessBody(egObject *tess, egObject *body, egObject **mapTess)
   mtess->tess1d    = NULL;
   mtess->tess2d    = NULL;
   mtess->globals   = NULL;
+  mtess->edits     = NULL;
   mtess->nGlobal   = 0;
   mtess->nEdge     = btess->nEdge;
   mtess->nFace     = btess->nFace;
@@ -7973,100 +9162,56 @@ EG_quadLoop(egTessel *btess, int outLevel, int nedge, int *eindex,
         t1[0] /= dist;
         t1[1] /= dist;
         t1[2] /= dist;
-      }
-      dist = t0[0]*t1[0] + t0[1]*t1[1] + t0[2]*t1[2];
-      if (outLevel > 1)
-        printf("  Dot between %d %d = %lf\n", ie0+1, ie1+1, dist);
-      if (dist > dmax) {
-        dmax = dist;
-        imax = i;
-      }
-    }
-    if (imax == -1) return EGADS_INDEXERR;
-    if (dmax < 1.0-edgeTOL) return EGADS_INDEXERR;
-
-    for (i = imax; i < 3; i++) lim[i] = lim[i+1];
-    lim[3]++;
-    nside--;
-    if (outLevel > 1)
-      printf("  endIndex = %d %d %d %d,  nSide = %d\n", 
-             lim[0], lim[1], lim[2], lim[3], nside);
-  }
-
-  return EGADS_SUCCESS;
-}
-
-
-__HOST_AND_DEVICE__ int
-EG_makeQuads(egObject *tess, double *parms, int index)
-{
-  int          i, j, k, l, m, n, outLevel, stat, oclass, mtype, ftype, atype;
-  int          nface, nloop, nedge, sens, npt, nx, alen, *eindex, lim[4];
-  int          npts, npat, save, iv, iv1, nside, pats[34], lens[4];
-  int          *ptype, *pindex, *pin, *vpats, *senses, *ntable;
-  double       *uvs, *quv, *xyz, *xyzs, limits[4], res[18], area;
-  connect      *etable;
-  egTessel     *btess;
-  egPatch      *patch;
-  egObject     *obj, *geom, *loop, **faces, **loops, **edges;
-  const double *aReals;
-  const int    *aInts;
-  const char   *aStr;
-
-  if (tess == NULL)                 return EGADS_NULLOBJ;
-  if (tess->magicnumber != MAGIC)   return EGADS_NOTOBJ;
-  if (tess->oclass != TESSELLATION) return EGADS_NOTTESS;
-  if (EG_sameThread(tess))          return EGADS_CNTXTHRD;
-  outLevel = EG_outLevel(tess);
-  
-  btess = (egTessel *) tess->blind;
-  if (btess == NULL) {
-    if (outLevel > 0)
-      printf(" EGADS Error: NULL Blind Object (EG_makeQuads)!\n");  
-    return EGADS_NOTFOUND;
-  }
-  obj = btess->src;
-  if (obj == NULL) {
-    if (outLevel > 0)
-      printf(" EGADS Error: NULL Source Object (EG_makeQuads)!\n");
-    return EGADS_NULLOBJ;
-  }
-  if (obj->magicnumber != MAGIC) {
-    if (outLevel > 0)
-      printf(" EGADS Error: Source Not an Object (EG_makeQuads)!\n");
-    return EGADS_NOTOBJ;
-  }
-  if ((obj->oclass != BODY) && (obj->oclass != EBODY)) {
-    if (outLevel > 0)
-      printf(" EGADS Error: Source Not Body (EG_makeQuads)!\n");
-    return EGADS_NOTBODY;
-  }
-  if (btess->tess2d == NULL) {
-    if (outLevel > 0)
-      printf(" EGADS Error: No Face Tessellations (EG_makeQuads)!\n");
-    return EGADS_NODATA;  
-  }
-  if ((index < 1) || (index > btess->nFace)) {
-    if (outLevel > 0)
-      printf(" EGADS Error: Index = %d [1-%d] (EG_makeQuads)!\n",
-             index, btess->nFace);
-    return EGADS_INDEXERR;
-  }
+      }
+      dist = t0[0]*t1[0] + t0[1]*t1[1] + t0[2]*t1[2];
+      if (outLevel > 1)
+        printf("  Dot between %d %d = %lf\n", ie0+1, ie1+1, dist);
+      if (dist > dmax) {
+        dmax = dist;
+        imax = i;
+      }
+    }
+    if (imax == -1) return EGADS_INDEXERR;
+    if (dmax < 1.0-edgeTOL) return EGADS_INDEXERR;
 
-  /* quad patch based on current Edge tessellations */
-  
-  if (obj->oclass == EBODY) {
-    stat = EG_getBodyTopos(obj, NULL, EFACE, &nface, &faces);
-  } else {
-    stat = EG_getBodyTopos(obj, NULL,  FACE, &nface, &faces);
+    for (i = imax; i < 3; i++) lim[i] = lim[i+1];
+    lim[3]++;
+    nside--;
+    if (outLevel > 1)
+      printf("  endIndex = %d %d %d %d,  nSide = %d\n", 
+             lim[0], lim[1], lim[2], lim[3], nside);
   }
-  if (stat != EGADS_SUCCESS) return stat;
+
+  return EGADS_SUCCESS;
+}
+
+
+/* fill a single Face with quad patches -- only reads the tessellation */
+
+__HOST_AND_DEVICE__ static int
+EG_quadFace(egTessel *btess, egObject **faces, double *parms, int index,
+            int outLevel, egTess2D *quad)
+{
+  int          i, j, k, l, m, n, stat, oclass, mtype, ftype, atype;
+  int          nloop, nedge, sens, npt, nx, alen, *eindex, lim[4];
+  int          npts, npat, save, iv, iv1, nside, pats[34], lens[4];
+  int          *ptype, *pindex, *pin, *vpats, *senses, *ntable;
+  double       *uvs, *quv, *xyz, *xyzs, limits[4], res[18], area;
+  connect      *etable;
+  egPatch      *patch;
+  egObject     *geom, *loop, **loops, **edges;
+  const double *aReals;
+  const int    *aInts;
+  const char   *aStr;
+
+  quad->xyz    = quad->uv     = NULL;
+  quad->ptype  = quad->pindex = NULL;
+  quad->patch  = NULL;
+  quad->npts   = quad->npatch = 0;
+
   stat = EG_getTopology(faces[index-1], &geom, &oclass, &ftype, limits,
                         &nloop, &loops, &senses);
-  if (stat != EGADS_SUCCESS) {
-    EG_free(faces);
-    return stat;
-  }
+  if (stat != EGADS_SUCCESS) return stat;
   loop = loops[0];
   if (nloop != 1) {
     loop = NULL;
@@ -8094,21 +9239,16 @@ EG_makeQuads(egObject *tess, double *parms, int index)
      if (outLevel > 0)
         printf(" EGADS Error: Face %d has %d loops (EG_makeQuads)!\n",
                index, nloop);
-      EG_free(faces);
       return EGADS_TOPOERR;
     }
   }
   stat = EG_getTopology(loop, &geom, &oclass, &mtype, limits, &nedge, &edges,
                         &senses);
-  if (stat != EGADS_SUCCESS) {
-    EG_free(faces);
-    return stat;
-  }
+  if (stat != EGADS_SUCCESS) return stat;
   if (nedge < 4) {
     if (outLevel > 0)
       printf(" EGADS Error: %d Edges in Face %d (EG_makeQuads)!\n", 
              nedge, index);
-    EG_free(faces);
     return EGADS_INDEXERR;
   }
 
@@ -8118,7 +9258,6 @@ EG_makeQuads(egObject *tess, double *parms, int index)
     if (outLevel > 0)
       printf(" EGADS Error: Malloc on %d Edges (EG_makeQuads)!\n",
              nedge);
-    EG_free(faces);
     return EGADS_MALLOC;
   }
   for (i = 0; i < nedge; i++) {
@@ -8127,7 +9266,6 @@ EG_makeQuads(egObject *tess, double *parms, int index)
         printf(" EGADS Error: Edge in Face %d is Degenerate (EG_makeQuads)!\n", 
                index);
       EG_free(eindex);
-      EG_free(faces);
       return EGADS_INDEXERR;
     }
     eindex[i] = 0;
@@ -8140,7 +9278,6 @@ EG_makeQuads(egObject *tess, double *parms, int index)
       if (outLevel > 0)
         printf(" EGADS Error: Edge Not Found in Tess (EG_makeQuads)!\n");
       EG_free(eindex);
-      EG_free(faces);
       return EGADS_NOTFOUND;
     }
   }
@@ -8158,7 +9295,6 @@ EG_makeQuads(egObject *tess, double *parms, int index)
         printf(" EGADS Error: %d Edges in Face %d (EG_makeQuads)!\n", 
                nedge, index);
       EG_free(eindex);
-      EG_free(faces);
       return stat;
     }
   }
@@ -8180,7 +9316,6 @@ EG_makeQuads(egObject *tess, double *parms, int index)
       printf(" EGADS Error: Malloc on %d XYZs (EG_makeQuads)!\n",
              npts);
     EG_free(eindex);
-    EG_free(faces);
     return EGADS_MALLOC;
   }
   uvs = (double *) EG_alloc(2*npts*sizeof(double));
@@ -8190,7 +9325,6 @@ EG_makeQuads(egObject *tess, double *parms, int index)
              npts);
     EG_free(xyzs);
     EG_free(eindex);
-    EG_free(faces);
     return EGADS_MALLOC;
   }
   pin = (int *) EG_alloc(3*npts*sizeof(int));
@@ -8201,7 +9335,6 @@ EG_makeQuads(egObject *tess, double *parms, int index)
     EG_free(uvs);
     EG_free(xyzs);
     EG_free(eindex);
-    EG_free(faces);
     return EGADS_MALLOC;
   }
  
@@ -8226,7 +9359,6 @@ EG_makeQuads(egObject *tess, double *parms, int index)
           EG_free(pin);
           EG_free(xyzs);
           EG_free(eindex);
-          EG_free(faces);
           return stat;        
         }
         xyzs[3*npts  ] = btess->tess1d[j].xyz[3*k  ];
@@ -8249,7 +9381,6 @@ EG_makeQuads(egObject *tess, double *parms, int index)
           EG_free(pin);
           EG_free(xyzs);
           EG_free(eindex);
-          EG_free(faces);
           return stat;        
         }
         xyzs[3*npts  ] = btess->tess1d[j].xyz[3*k  ];
@@ -8284,7 +9415,6 @@ EG_makeQuads(egObject *tess, double *parms, int index)
              stat);
     EG_free(pin);
     EG_free(xyzs);
-    EG_free(faces);
     return EGADS_CONSTERR;
   }
 
@@ -8302,7 +9432,6 @@ EG_makeQuads(egObject *tess, double *parms, int index)
     EG_free(quv);
     EG_free(pin);
     EG_free(xyzs);
-    EG_free(faces);
     return EGADS_MALLOC;
   }
   for (i = 0; i < npts; i++) {
@@ -8320,7 +9449,6 @@ EG_makeQuads(egObject *tess, double *parms, int index)
     xyz[3*i+1] = res[1];
     xyz[3*i+2] = res[2];
   }
-  EG_free(faces);
   patch = (egPatch *) EG_alloc(npat*sizeof(egPatch));
   if (patch == NULL) {
     if (outLevel > 0)
@@ -8449,24 +9577,316 @@ EG_makeQuads(egObject *tess, double *parms, int index)
   EG_free(vpats);
   EG_free(pin);
   
+
+  quad->xyz    = xyz;
+  quad->uv     = quv;
+  quad->ptype  = ptype;
+  quad->pindex = pindex;
+  quad->npts   = npt;
+  quad->patch  = patch;
+  quad->npatch = npat;
+  
+  return EGADS_SUCCESS;
+}
+
+
+__HOST_AND_DEVICE__ static void
+EG_saveQuads(egTessel *btess, int index, egTess2D *quad)
+{
+  int i;
+
   /* delete any existing quads */
   EG_deleteQuads(btess, index);
 
   /* save away the patches */
-
   i = btess->nFace + index - 1;
-  btess->tess2d[i].xyz    = xyz;
-  btess->tess2d[i].uv     = quv;
-  btess->tess2d[i].ptype  = ptype;
-  btess->tess2d[i].pindex = pindex;
-  btess->tess2d[i].npts   = npt;
-  btess->tess2d[i].patch  = patch;
-  btess->tess2d[i].npatch = npat;
+  btess->tess2d[i].xyz    = quad->xyz;
+  btess->tess2d[i].uv     = quad->uv;
+  btess->tess2d[i].ptype  = quad->ptype;
+  btess->tess2d[i].pindex = quad->pindex;
+  btess->tess2d[i].npts   = quad->npts;
+  btess->tess2d[i].patch  = quad->patch;
+  btess->tess2d[i].npatch = quad->npatch;
+}
+
+
+__HOST_AND_DEVICE__ int
+EG_makeQuads(egObject *tess, double *parms, int index)
+{
+  int      outLevel, stat, nface;
+  egTessel *btess;
+  egTess2D quad;
+  egObject *obj, **faces;
+
+  if (tess == NULL)                 return EGADS_NULLOBJ;
+  if (tess->magicnumber != MAGIC)   return EGADS_NOTOBJ;
+  if (tess->oclass != TESSELLATION) return EGADS_NOTTESS;
+  if (EG_sameThread(tess))          return EGADS_CNTXTHRD;
+  outLevel = EG_outLevel(tess);
+  
+  btess = (egTessel *) tess->blind;
+  if (btess == NULL) {
+    if (outLevel > 0)
+      printf(" EGADS Error: NULL Blind Object (EG_makeQuads)!\n");  
+    return EGADS_NOTFOUND;
+  }
+  obj = btess->src;
+  if (obj == NULL) {
+    if (outLevel > 0)
+      printf(" EGADS Error: NULL Source Object (EG_makeQuads)!\n");
+    return EGADS_NULLOBJ;
+  }
+  if (obj->magicnumber != MAGIC) {
+    if (outLevel > 0)
+      printf(" EGADS Error: Source Not an Object (EG_makeQuads)!\n");
+    return EGADS_NOTOBJ;
+  }
+  if ((obj->oclass != BODY) && (obj->oclass != EBODY)) {
+    if (outLevel > 0)
+      printf(" EGADS Error: Source Not Body (EG_makeQuads)!\n");
+    return EGADS_NOTBODY;
+  }
+  if (btess->tess2d == NULL) {
+    if (outLevel > 0)
+      printf(" EGADS Error: No Face Tessellations (EG_makeQuads)!\n");
+    return EGADS_NODATA;  
+  }
+  if ((index < 1) || (index > btess->nFace)) {
+    if (outLevel > 0)
+      printf(" EGADS Error: Index = %d [1-%d] (EG_makeQuads)!\n",
+             index, btess->nFace);
+    return EGADS_INDEXERR;
+  }
+
+  /* quad patch based on current Edge tessellations */
   
+  if (obj->oclass == EBODY) {
+    stat = EG_getBodyTopos(obj, NULL, EFACE, &nface, &faces);
+  } else {
+    stat = EG_getBodyTopos(obj, NULL,  FACE, &nface, &faces);
+  }
+  if (stat != EGADS_SUCCESS) return stat;
+  stat = EG_quadFace(btess, faces, parms, index, outLevel, &quad);
+  EG_free(faces);
+  if (stat != EGADS_SUCCESS) return stat;
+
+  EG_saveQuads(btess, index, &quad);
   return EGADS_SUCCESS;
 }
 
 
+/* structure to pass data to the threads filling Faces with quads */
+typedef struct {
+  void      *mutex;             /* the mutex or NULL for single thread */
+  long      master;             /* master thread ID */
+  int       end;                /* end of loop */
+  int       index;              /* current loop index */
+  int       outLevel;
+  const int *findex;            /* Face index for each entry (bias 1) */
+  int       *stats;             /* returned status for each entry */
+  double    *parms;             /* quadding parameters */
+  egTessel  *btess;             /* tessellation structure */
+  egObject  **faces;            /* Face Object list */
+  egTess2D  *quads;             /* filled patches for each entry */
+} EMPquads;
+
+
+__HOST_AND_DEVICE__ static void
+EG_quadFaceThread(void *struc)
+{
+  int      index;
+  long     ID;
+  EMPquads *qthread;
+
+  qthread = (EMPquads *) struc;
+
+  /* get our identifier */
+  ID = EMP_ThreadID();
+
+  /* look for work */
+  for (;;) {
+
+    /* only one thread at a time here -- controlled by a mutex! */
+    if (qthread->mutex != NULL) EMP_LockSet(qthread->mutex);
+    index = qthread->index;
+    qthread->index++;
+    if (qthread->mutex != NULL) EMP_LockRelease(qthread->mutex);
+    if (index >= qthread->end) break;
+
+    /* do the work */
+    qthread->stats[index] = EG_quadFace(qthread->btess, qthread->faces,
+                                        qthread->parms, qthread->findex[index],
+                                        qthread->outLevel,
+                                        &qthread->quads[index]);
+  }
+
+  /* exhausted all work -- exit */
+  if (ID != qthread->master) EMP_ThreadExit();
+}
+
+
+__HOST_AND_DEVICE__ int
+EG_makeQuadsBatch(egObject *tess, double *parms, int nindex,
+                  /*@null@*/ const int *indices)
+{
+  int      i, np, outLevel, stat, nface, *findex, *stats;
+  long     start;
+  void     **threads = NULL;
+  egTessel *btess;
+  egTess2D *quads;
+  egObject *obj, **faces;
+  EMPquads qthread;
+
+  if (tess == NULL)                 return EGADS_NULLOBJ;
+  if (tess->magicnumber != MAGIC)   return EGADS_NOTOBJ;
+  if (tess->oclass != TESSELLATION) return EGADS_NOTTESS;
+  if (EG_sameThread(tess))          return EGADS_CNTXTHRD;
+  outLevel = EG_outLevel(tess);
+  
+  btess = (egTessel *) tess->blind;
+  if (btess == NULL) {
+    if (outLevel > 0)
+      printf(" EGADS Error: NULL Blind Object (EG_makeQuadsBatch)!\n");  
+    return EGADS_NOTFOUND;
+  }
+  obj = btess->src;
+  if (obj == NULL) {
+    if (outLevel > 0)
+      printf(" EGADS Error: NULL Source Object (EG_makeQuadsBatch)!\n");
+    return EGADS_NULLOBJ;
+  }
+  if (obj->magicnumber != MAGIC) {
+    if (outLevel > 0)
+      printf(" EGADS Error: Source Not an Object (EG_makeQuadsBatch)!\n");
+    return EGADS_NOTOBJ;
+  }
+  if ((obj->oclass != BODY) && (obj->oclass != EBODY)) {
+    if (outLevel > 0)
+      printf(" EGADS Error: Source Not Body (EG_makeQuadsBatch)!\n");
+    return EGADS_NOTBODY;
+  }
+  if (btess->tess2d == NULL) {
+    if (outLevel > 0)
+      printf(" EGADS Error: No Face Tessellations (EG_makeQuadsBatch)!\n");
+    return EGADS_NODATA;  
+  }
+  if (indices == NULL) nindex = btess->nFace;
+  if (nindex <= 0) {
+    if (outLevel > 0)
+      printf(" EGADS Error: nIndex = %d (EG_makeQuadsBatch)!\n", nindex);
+    return EGADS_INDEXERR;
+  }
+  if (indices != NULL)
+    for (i = 0; i < nindex; i++)
+      if ((indices[i] < 1) || (indices[i] > btess->nFace)) {
+        if (outLevel > 0)
+          printf(" EGADS Error: Index %d = %d [1-%d] (EG_makeQuadsBatch)!\n",
+                 i+1, indices[i], btess->nFace);
+        return EGADS_INDEXERR;
+      }
+
+  if (obj->oclass == EBODY) {
+    stat = EG_getBodyTopos(obj, NULL, EFACE, &nface, &faces);
+  } else {
+    stat = EG_getBodyTopos(obj, NULL,  FACE, &nface, &faces);
+  }
+  if (stat != EGADS_SUCCESS) return stat;
+
+  findex = (int *)      EG_alloc(2*nindex*sizeof(int));
+  quads  = (egTess2D *) EG_alloc(  nindex*sizeof(egTess2D));
+  if ((findex == NULL) || (quads == NULL)) {
+    if (outLevel > 0)
+      printf(" EGADS Error: Malloc on %d Faces (EG_makeQuadsBatch)!\n",
+             nindex);
+    if (quads  != NULL) EG_free(quads);
+    if (findex != NULL) EG_free(findex);
+    EG_free(faces);
+    return EGADS_MALLOC;
+  }
+  stats = &findex[nindex];
+  for (i = 0; i < nindex; i++) {
+    findex[i] = (indices == NULL) ? i+1 : indices[i];
+    stats[i]  = EGADS_SUCCESS;
+  }
+
+  /* set up for explicit multithreading -- each Face fills on its own */
+  qthread.mutex    = NULL;
+  qthread.master   = EMP_ThreadID();
+  qthread.index    = 0;
+  qthread.end      = nindex;
+  qthread.outLevel = outLevel;
+  qthread.findex   = findex;
+  qthread.stats    = stats;
+  qthread.parms    = parms;
+  qthread.btess    = btess;
+  qthread.faces    = faces;
+  qthread.quads    = quads;
+
+  np = EMP_Init(&start);
+  if (outLevel > 1) printf(" EMP NumProcs = %d!\n", np);
+  if (nindex < np) np = nindex;
+
+  if (np > 1) {
+    /* create the mutex to handle list synchronization */
+    qthread.mutex = EMP_LockCreate();
+    if (qthread.mutex == NULL) {
+      printf(" EMP Error: mutex creation = NULL!\n");
+      np = 1;
+    } else {
+      /* get storage for our extra threads */
+      threads = (void **) malloc((np-1)*sizeof(void *));
+      if (threads == NULL) {
+        EMP_LockDestroy(qthread.mutex);
+        qthread.mutex = NULL;
+        np = 1;
+      }
+    }
+  }
+
+  /* create the threads and get going! */
+  if (threads != NULL)
+    for (i = 0; i < np-1; i++) {
+      threads[i] = EMP_ThreadCreate(EG_quadFaceThread, &qthread);
+      if (threads[i] == NULL)
+        printf(" EMP Error Creating Thread #%d!\n", i+1);
+    }
+  /* now run the thread block from the original thread */
+  EG_quadFaceThread(&qthread);
+
+  /* wait for all others to return */
+  if (threads != NULL)
+    for (i = 0; i < np-1; i++)
+      if (threads[i] != NULL) EMP_ThreadWait(threads[i]);
+
+  /* cleanup */
+  if (threads != NULL)
+    for (i = 0; i < np-1; i++)
+      if (threads[i] != NULL) EMP_ThreadDestroy(threads[i]);
+  if (qthread.mutex != NULL) EMP_LockDestroy(qthread.mutex);
+  if (threads != NULL) free(threads);
+  if (outLevel > 1)
+    printf(" EMP Number of Seconds on Quad Thread Block = %ld\n",
+           EMP_Done(&start));
+  EG_free(faces);
+
+  /* store in order -- report the first failure but keep the rest */
+  for (stat = EGADS_SUCCESS, i = 0; i < nindex; i++) {
+    if (stats[i] == EGADS_SUCCESS) {
+      EG_saveQuads(btess, findex[i], &quads[i]);
+      continue;
+    }
+    if (outLevel > 0)
+      printf(" EGADS Warning: Face %d -> EG_makeQuads = %d (EG_makeQuadsBatch)!\n",
+             findex[i], stats[i]);
+    if (stat == EGADS_SUCCESS) stat = stats[i];
+  }
+  EG_free(quads);
+  EG_free(findex);
+
+  return stat;
+}
+
+
 __HOST_AND_DEVICE__ int
 EG_getQuads(const egObject *tess, int index, int *len, const double **xyz, 
             const double **uv, const int **ptype, const int **pindex, 
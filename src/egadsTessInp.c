@@ -243,6 +243,7 @@ EG_initTessBody(egObject *object, egObject **tess)
   btess->tess1d    = NULL;
   btess->tess2d    = NULL;
   btess->globals   = NULL;
+  btess->edits     = NULL;
   btess->nGlobal   = 0;
   btess->nEdge     = nedge;
   btess->nFace     = nface;
@@ -1855,6 +1856,8 @@ EG_setTessFacX(const egObject *tess, int index, int len, const double *xyz,
   fast.pts   = NULL;
   fast.segs  = NULL;
   fast.front = NULL;
+  fast.grid  = NULL;
+  fast.link  = NULL;
   frame = (int *) EG_alloc(3*ntrix*sizeof(int));
   if (frame == NULL) {
     if (outLevel > 0)
@@ -1899,6 +1902,8 @@ EG_setTessFacX(const egObject *tess, int index, int len, const double *xyz,
   if (fast.segs  != NULL) EG_free(fast.segs);
   if (fast.pts   != NULL) EG_free(fast.pts);
   if (fast.front != NULL) EG_free(fast.front);
+  if (fast.grid  != NULL) EG_free(fast.grid);
+  if (fast.link  != NULL) EG_free(fast.link);
   EG_free(uvs);
   if (n != ntrix) {
     printf(" EGADS Error: Face %d - Can't Triangulate Frame (EG_setTessFace)!\n",
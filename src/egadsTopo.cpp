@@ -17,6 +17,7 @@
 #include "egadsTypes.h"
 #include "egadsInternals.h"
 #include "egadsClasses.h"
+#include "emp.h"
 
 #define OCC_SOLIDS
 //#define OCC_MAKEFACE
@@ -39,6 +40,29 @@ static const Standard_Integer NCONTROL=23;
     double CG[4];               /* Center of Gravity, then Length */
   } edgeID;
 
+  typedef struct {
+    void     *mutex;            /* the mutex or NULL for single thread */
+    long     master;            /* master thread ID */
+    int      index;             /* next Face to fill */
+    int      end;               /* number of Faces */
+    int      fill;              /* 0 - bbox, 1 - surface, 2 - w/ volume */
+    int      stat;              /* the first failure */
+    egObject **faces;           /* the Faces to fill */
+  } EMPfaces;
+
+#define MATCHBLOCK 64
+
+  typedef struct {
+    void     *mutex;            /* the mutex or NULL for single thread */
+    long     master;            /* master thread ID */
+    int      index;             /* next candidate pair */
+    int      end;               /* number of candidate pairs */
+    int      flag;              /* 0 - EG_isSame, 1 - EG_isEquivalent */
+    const egObject **objs;      /* the objects */
+    int      *pairs;            /* the candidate pairs (0 bias) */
+    int      *hits;             /* the status of each pair */
+  } EMPmatch;
+
 class tmpEdge
 {
 public:
@@ -149,6 +173,10 @@ public:
   extern "C" int  EG_getMassProperties( const egObject *topo,
                                         /*@null@*/ double *props );
   extern "C" int  EG_isEquivalent( const egObject *topo1, const egObject *topo2 );
+  extern "C" int  EG_fingerprint( const egObject *object, int flag,
+                                  double *print );
+  extern "C" int  EG_matchObjects( int nobj, const egObject **objs, int flag,
+                                   int *nmatch, int **match );
   extern "C" int  EG_isPlanar( const egObject *topo );
   extern "C" int  EG_getEdgeUVX( const egObject *face, const egObject *edge,
                                  int sense, double t, double *result );
@@ -166,6 +194,8 @@ public:
                                 double **data );
   extern "C" int  EG_getBody( const egObject *topo, egObject **result );
   extern "C" int  EG_inTopology( const egObject *topo, const double *xyz );
+  extern "C" int  EG_inTopologyBatch( const egObject *topo, int npts,
+                                      const double *xyzs, int *results );
   extern "C" int  EG_inFace( const egObject *face, const double *uv );
   extern "C" int  EG_inFaceOCC( const egObject *face, double tol,
                                 const double *uv );
@@ -468,6 +498,10 @@ EG_destroyTopology(egObject *topo)
         EG_dereferenceTopObj(pedge->nodes[0], topo);
         EG_dereferenceTopObj(pedge->nodes[1], topo);
       }
+      if (pedge->arcTab != NULL) {
+        EG_free(pedge->arcTab->tab);
+        delete pedge->arcTab;
+      }
       delete pedge;
     }
 
@@ -1122,6 +1156,7 @@ EG_fillTopoObjs(egObject *object, egObject *topObj)
         BRep_Tool::Range(Edge, pedge->trange[0], pedge->trange[1]);
         pedge->filled      = 0;
         pedge->trange_dot[0] = pedge->trange_dot[1] = 0;
+        pedge->arcTab      = NULL;
         edgeo[k]->blind  = pedge;
         EG_fillTopoObjs(edgeo[k], topObj);
       }
@@ -1598,6 +1633,7 @@ EG_traverseBody(egObject *context, int i, egObject *bobj, egObject *topObj,
     BRep_Tool::Range(Edge, pedge->trange[0], pedge->trange[1]);
     pedge->filled      = 0;
     pedge->trange_dot[0] = pedge->trange_dot[1] = 0;
+    pedge->arcTab      = NULL;
     // special catch for old egads files and the use of zero radius circles
     if ((degen == 0) && (geom->mtype == CIRCLE)) {
       Handle(Geom_Curve) hCurve = BRep_Tool::Curve(Edge, t1, t2);
@@ -1780,6 +1816,7 @@ EG_traverseBody(egObject *context, int i, egObject *bobj, egObject *topObj,
     pface->senses      = senses;
     pface->topFlg      = 0;
     pface->bbox.filled = 0;
+    pface->massFill    = 0;
     BRepTools::UVBounds(Face, pface->urange[0], pface->urange[1],
                               pface->vrange[0], pface->vrange[1]);
     obj->blind         = pface;
@@ -2873,6 +2910,7 @@ EG_makeTopology(egObject *context, /*@null@*/ egObject *geom,
       BRep_Tool::Range(Edge, pedge->trange[0], pedge->trange[1]);
       pedge->filled      = 0;
       pedge->trange_dot[0] = pedge->trange_dot[1] = 0;
+      pedge->arcTab      = NULL;
       obj->oclass        = EDGE;
       obj->blind         = pedge;
       obj->topObj        = context;
@@ -3058,6 +3096,7 @@ EG_makeTopology(egObject *context, /*@null@*/ egObject *geom,
     BRep_Tool::Range(Edge, pedge->trange[0], pedge->trange[1]);
     pedge->filled      = 0;
     pedge->trange_dot[0] = pedge->trange_dot[1] = 0;
+    pedge->arcTab      = NULL;
     obj->oclass        = EDGE;
     obj->blind         = pedge;
     obj->topObj        = context;
@@ -3672,6 +3711,7 @@ EG_makeTopology(egObject *context, /*@null@*/ egObject *geom,
     pface->senses      = lsense;
     pface->topFlg      = 1;
     pface->bbox.filled = 0;
+    pface->massFill    = 0;
     BRepTools::UVBounds(face, pface->urange[0], pface->urange[1],
                               pface->vrange[0], pface->vrange[1]);
     obj->blind         = pface;
@@ -5296,6 +5336,7 @@ EG_makeFace(egObject *object, int mtype,
     pface->senses      = senses;
     pface->topFlg      = 0;
     pface->bbox.filled = 0;
+    pface->massFill    = 0;
     BRepTools::UVBounds(Face, pface->urange[0], pface->urange[1],
                               pface->vrange[0], pface->vrange[1]);
     obj->blind       = pface;
@@ -5483,6 +5524,7 @@ EG_makeFace(egObject *object, int mtype,
   pface->senses      = senses;
   pface->topFlg      = 0;
   pface->bbox.filled = 0;
+  pface->massFill    = 0;
   BRepTools::UVBounds(Face, pface->urange[0], pface->urange[1],
                             pface->vrange[0], pface->vrange[1]);
   obj->blind         = pface;
@@ -6277,6 +6319,434 @@ EG_makeSolidBody_dot(egObject *body, int stypx,
 }
 
 
+/* the Face surface & volume integrals are kept as moments about the origin
+ * (mass, first moments, then xx, yy, zz, xy, xz & yz second moments) so
+ * that any collection of Faces can be summed directly */
+
+static void
+EG_propMoments(const GProp_GProps& props, double *raw)
+{
+  double m, c[3];
+
+  gp_Pnt CofG  = props.CentreOfMass();
+  gp_Mat Inert = props.MatrixOfInertia();
+  m      = props.Mass();
+  c[0]   = CofG.X();
+  c[1]   = CofG.Y();
+  c[2]   = CofG.Z();
+  raw[0] = m;
+  raw[1] = m*c[0];
+  raw[2] = m*c[1];
+  raw[3] = m*c[2];
+  m     *= 2.0;
+  raw[4] = 0.5*(Inert.Value(2,2) + Inert.Value(3,3) - Inert.Value(1,1) +
+                m*c[0]*c[0]);
+  raw[5] = 0.5*(Inert.Value(1,1) + Inert.Value(3,3) - Inert.Value(2,2) +
+                m*c[1]*c[1]);
+  raw[6] = 0.5*(Inert.Value(1,1) + Inert.Value(2,2) - Inert.Value(3,3) +
+                m*c[2]*c[2]);
+  m     *= 0.5;
+  raw[7] = m*c[0]*c[1] - Inert.Value(1,2);
+  raw[8] = m*c[0]*c[2] - Inert.Value(1,3);
+  raw[9] = m*c[1]*c[2] - Inert.Value(2,3);
+}
+
+
+/* fills the CG & the inertia matrix (about the CG) from summed moments */
+static void
+EG_momentProps(const double *raw, double *data)
+{
+  double m, c[3], cxx, cyy, czz, cxy, cxz, cyz;
+
+  m    = raw[0];
+  c[0] = c[1] = c[2] = 0.0;
+  if (m != 0.0) {
+    c[0] = raw[1]/m;
+    c[1] = raw[2]/m;
+    c[2] = raw[3]/m;
+  }
+  cxx = raw[4] - m*c[0]*c[0];
+  cyy = raw[5] - m*c[1]*c[1];
+  czz = raw[6] - m*c[2]*c[2];
+  cxy = raw[7] - m*c[0]*c[1];
+  cxz = raw[8] - m*c[0]*c[2];
+  cyz = raw[9] - m*c[1]*c[2];
+
+  data[ 2] = c[0];
+  data[ 3] = c[1];
+  data[ 4] = c[2];
+  data[ 5] =  cyy + czz;
+  data[ 6] = -cxy;
+  data[ 7] = -cxz;
+  data[ 8] = -cxy;
+  data[ 9] =  cxx + czz;
+  data[10] = -cyz;
+  data[11] = -cxz;
+  data[12] = -cyz;
+  data[13] =  cxx + cyy;
+}
+
+
+static int
+EG_faceMass(const egObject *face, int fill)
+{
+  BRepGProp    BProps;
+  GProp_GProps SProps, VProps;
+
+  egadsFace *pface = (egadsFace *) face->blind;
+  try {
+    if ((pface->massFill&1) == 0) {
+      BProps.SurfaceProperties(pface->face, SProps);
+      EG_propMoments(SProps, &pface->massProp[0]);
+    }
+    if ((fill == 2) && ((pface->massFill&2) == 0)) {
+      BProps.VolumeProperties(pface->face, VProps);
+      EG_propMoments(VProps, &pface->massProp[10]);
+    }
+  }
+  catch (const Standard_Failure& e) {
+    printf(" EGADS Warning: Mass Property failure (EG_getMassProperties)!\n");
+    printf("                %s\n", e.GetMessageString());
+    return EGADS_GEOMERR;
+  }
+  catch (...) {
+    printf(" EGADS Warning: Mass Property failure (EG_getMassProperties)!\n");
+    return EGADS_GEOMERR;
+  }
+  pface->massFill |= (fill == 2) ? 3 : 1;
+
+  return EGADS_SUCCESS;
+}
+
+
+static void
+EG_faceThread(void *struc)
+{
+  int      index, stat;
+  long     ID;
+  double   box[6];
+  EMPfaces *fthread;
+
+  fthread = (EMPfaces *) struc;
+
+  /* get our identifier */
+  ID = EMP_ThreadID();
+
+  /* look for work */
+  for (;;) {
+
+    /* only one thread at a time here -- controlled by a mutex! */
+    if (fthread->mutex != NULL) EMP_LockSet(fthread->mutex);
+    index = fthread->index;
+    fthread->index++;
+    if (fthread->mutex != NULL) EMP_LockRelease(fthread->mutex);
+    if (index >= fthread->end) break;
+
+    /* do the work */
+    if (fthread->fill == 0) {
+      stat = EG_getBoundingBX(fthread->faces[index], box);
+    } else {
+      stat = EG_faceMass(fthread->faces[index], fthread->fill);
+    }
+    if (stat != EGADS_SUCCESS) {
+      if (fthread->mutex != NULL) EMP_LockSet(fthread->mutex);
+      if (fthread->stat == EGADS_SUCCESS) fthread->stat = stat;
+      if (fthread->mutex != NULL) EMP_LockRelease(fthread->mutex);
+    }
+  }
+
+  /* exhausted all work -- exit */
+  if (ID != fthread->master) EMP_ThreadExit();
+}
+
+
+static int
+EG_comparePtr(const void *a, const void *b)
+{
+  const egObject *pa = *(egObject *const *) a;
+  const egObject *pb = *(egObject *const *) b;
+
+  if (pa < pb) return -1;
+  if (pa > pb) return  1;
+  return 0;
+}
+
+
+/* fills the bbox (fill = 0) or mass (1 - surface, 2 - also volume) caches
+ * of the Faces that are missing them -- the Faces are independent so this
+ * is done concurrently */
+static int
+EG_fillFaces(int nface, egObject **faces, int fill)
+{
+  int      i, n, np, need;
+  void     **threads = NULL;
+  egObject **todo;
+  EMPfaces fthread;
+
+  need = (fill == 2) ? 3 : 1;
+
+  todo = (egObject **) EG_alloc(nface*sizeof(egObject *));
+  if (todo == NULL) return EGADS_MALLOC;
+  for (n = i = 0; i < nface; i++) {
+    egadsFace *pface = (egadsFace *) faces[i]->blind;
+    if (fill == 0) {
+      if (pface->bbox.filled != 0) continue;
+    } else {
+      if ((pface->massFill&need) == need) continue;
+    }
+    todo[n] = faces[i];
+    n++;
+  }
+  /* Faces can be seen more than once -- only do each once */
+  if (n > 1) {
+    qsort(todo, n, sizeof(egObject *), EG_comparePtr);
+    for (np = 1, i = 1; i < n; i++) {
+      if (todo[i] == todo[np-1]) continue;
+      todo[np] = todo[i];
+      np++;
+    }
+    n = np;
+  }
+  if (n == 0) {
+    EG_free(todo);
+    return EGADS_SUCCESS;
+  }
+
+  /* set up for explicit multithreading */
+  fthread.mutex  = NULL;
+  fthread.master = EMP_ThreadID();
+  fthread.index  = 0;
+  fthread.end    = n;
+  fthread.fill   = fill;
+  fthread.stat   = EGADS_SUCCESS;
+  fthread.faces  = todo;
+
+  np = EMP_Init(NULL);
+  if (n < np) np = n;
+  if (np > 1) {
+    /* create the mutex to handle list synchronization */
+    fthread.mutex = EMP_LockCreate();
+    if (fthread.mutex == NULL) {
+      printf(" EMP Error: mutex creation = NULL!\n");
+      np = 1;
+    } else {
+      /* get storage for our extra threads */
+      threads = (void **) malloc((np-1)*sizeof(void *));
+      if (threads == NULL) {
+        EMP_LockDestroy(fthread.mutex);
+        fthread.mutex = NULL;
+        np = 1;
+      }
+    }
+  }
+
+  /* create the threads and get going! */
+  if (threads != NULL)
+    for (i = 0; i < np-1; i++) {
+      threads[i] = EMP_ThreadCreate(EG_faceThread, &fthread);
+      if (threads[i] == NULL)
+        printf(" EMP Error Creating Thread #%d!\n", i+1);
+    }
+  /* now run the thread block from the original thread */
+  EG_faceThread(&fthread);
+
+  /* wait for all others to return */
+  if (threads != NULL)
+    for (i = 0; i < np-1; i++)
+      if (threads[i] != NULL) EMP_ThreadWait(threads[i]);
+
+  /* cleanup */
+  if (threads != NULL)
+    for (i = 0; i < np-1; i++)
+      if (threads[i] != NULL) EMP_ThreadDestroy(threads[i]);
+  if (fthread.mutex != NULL) EMP_LockDestroy(fthread.mutex);
+  if (threads != NULL) free(threads);
+  EG_free(todo);
+
+  return fthread.stat;
+}
+
+
+/* assembles the bounding box of a Shell, non-Wire Body or Model from the
+ * (cached) boxes of its parts -- EGADS_EMPTY if there are no Faces */
+static int
+EG_assembleBox(const egObject *topo, double *bbox)
+{
+  int      i, j, n, nface, stat;
+  double   box[6];
+  egObject **faces;
+
+  if (topo->oclass == SHELL) {
+    egadsShell *pshell = (egadsShell *) topo->blind;
+    nface = pshell->nfaces;
+    if (nface == 0) return EGADS_EMPTY;
+    stat  = EG_fillFaces(nface, pshell->faces, 0);
+    if (stat != EGADS_SUCCESS) return stat;
+    for (i = 0; i < nface; i++) {
+      egadsFace *pface = (egadsFace *) pshell->faces[i]->blind;
+      if (i == 0) {
+        for (j = 0; j < 6; j++) bbox[j] = pface->bbox.box[j];
+        continue;
+      }
+      for (j = 0; j < 3; j++) {
+        if (pface->bbox.box[j  ] < bbox[j  ]) bbox[j  ] = pface->bbox.box[j  ];
+        if (pface->bbox.box[j+3] > bbox[j+3]) bbox[j+3] = pface->bbox.box[j+3];
+      }
+    }
+    return EGADS_SUCCESS;
+  }
+
+  if (topo->oclass == BODY) {
+    egadsBody *pbody = (egadsBody *) topo->blind;
+    nface = pbody->faces.map.Extent();
+    if (nface == 0) return EGADS_EMPTY;
+    stat  = EG_fillFaces(nface, pbody->faces.objs, 0);
+    if (stat != EGADS_SUCCESS) return stat;
+    for (i = 0; i < nface; i++) {
+      egadsFace *pface = (egadsFace *) pbody->faces.objs[i]->blind;
+      if (i == 0) {
+        for (j = 0; j < 6; j++) bbox[j] = pface->bbox.box[j];
+        continue;
+      }
+      for (j = 0; j < 3; j++) {
+        if (pface->bbox.box[j  ] < bbox[j  ]) bbox[j  ] = pface->bbox.box[j  ];
+        if (pface->bbox.box[j+3] > bbox[j+3]) bbox[j+3] = pface->bbox.box[j+3];
+      }
+    }
+    return EGADS_SUCCESS;
+  }
+
+  /* Model -- fill all of the Body Faces at once, then the Bodies */
+  egadsModel *pmodel = (egadsModel *) topo->blind;
+  for (nface = i = 0; i < pmodel->nbody; i++) {
+    if (pmodel->bodies[i] == NULL) continue;
+    egadsBody *pbody = (egadsBody *) pmodel->bodies[i]->blind;
+    if (pbody == NULL) continue;
+    if (pmodel->bodies[i]->mtype == WIREBODY) continue;
+    nface += pbody->faces.map.Extent();
+  }
+  if (nface != 0) {
+    faces = (egObject **) EG_alloc(nface*sizeof(egObject *));
+    if (faces == NULL) return EGADS_MALLOC;
+    for (nface = i = 0; i < pmodel->nbody; i++) {
+      if (pmodel->bodies[i] == NULL) continue;
+      egadsBody *pbody = (egadsBody *) pmodel->bodies[i]->blind;
+      if (pbody == NULL) continue;
+      if (pmodel->bodies[i]->mtype == WIREBODY) continue;
+      for (j = 0; j < pbody->faces.map.Extent(); j++, nface++)
+        faces[nface] = pbody->faces.objs[j];
+    }
+    stat = EG_fillFaces(nface, faces, 0);
+    EG_free(faces);
+    if (stat != EGADS_SUCCESS) return stat;
+  }
+  for (n = i = 0; i < pmodel->nbody; i++) {
+    if (pmodel->bodies[i] == NULL) continue;
+    if (pmodel->bodies[i]->blind == NULL) continue;
+    stat = EG_getBoundingBX(pmodel->bodies[i], box);
+    if (stat != EGADS_SUCCESS) return stat;
+    if (n == 0) {
+      for (j = 0; j < 6; j++) bbox[j] = box[j];
+    } else {
+      for (j = 0; j < 3; j++) {
+        if (box[j  ] < bbox[j  ]) bbox[j  ] = box[j  ];
+        if (box[j+3] > bbox[j+3]) bbox[j+3] = box[j+3];
+      }
+    }
+    n++;
+  }
+  if (n == 0) return EGADS_EMPTY;
+
+  return EGADS_SUCCESS;
+}
+
+
+/* sums the mass properties of Faces, Shells or non-Wire Bodies from the
+ * (cached) Face integrals -- EGADS_EMPTY if there are no Faces */
+static int
+EG_sumMassProps(int nTopo, egObject **topos, double *data)
+{
+  int             i, j, n, fill, stat, *signs;
+  double          surf[10], vol[10];
+  egObject        **faces;
+  TopExp_Explorer Exp;
+
+  fill = 1;
+  if ((topos[0]->oclass == BODY) && (topos[0]->mtype == SOLIDBODY)) fill = 2;
+
+  /* collect the Face occurrences */
+  for (n = i = 0; i < nTopo; i++)
+    if (topos[i]->oclass == FACE) {
+      n++;
+    } else if (topos[i]->oclass == SHELL) {
+      egadsShell *pshell = (egadsShell *) topos[i]->blind;
+      n += pshell->nfaces;
+    } else {
+      egadsBody *pbody = (egadsBody *) topos[i]->blind;
+      for (Exp.Init(pbody->shape, TopAbs_FACE); Exp.More(); Exp.Next()) n++;
+    }
+  if (n == 0) return EGADS_EMPTY;
+
+  faces = (egObject **) EG_alloc(n*sizeof(egObject *));
+  signs = (int *)       EG_alloc(n*sizeof(int));
+  if ((faces == NULL) || (signs == NULL)) {
+    if (faces != NULL) EG_free(faces);
+    if (signs != NULL) EG_free(signs);
+    return EGADS_MALLOC;
+  }
+  for (n = i = 0; i < nTopo; i++)
+    if (topos[i]->oclass == FACE) {
+      faces[n] = topos[i];
+      signs[n] = 1;
+      n++;
+    } else if (topos[i]->oclass == SHELL) {
+      egadsShell *pshell = (egadsShell *) topos[i]->blind;
+      for (j = 0; j < pshell->nfaces; j++, n++) {
+        faces[n] = pshell->faces[j];
+        signs[n] = 1;
+      }
+    } else {
+      /* the volume contribution depends on the Face's use in the Body */
+      egadsBody *pbody = (egadsBody *) topos[i]->blind;
+      for (Exp.Init(pbody->shape, TopAbs_FACE); Exp.More(); Exp.Next(), n++) {
+        TopoDS_Face Face = TopoDS::Face(Exp.Current());
+        j = pbody->faces.map.FindIndex(Face);
+        if ((j == 0) || (pbody->faces.objs[j-1] == NULL)) {
+          EG_free(signs);
+          EG_free(faces);
+          return EGADS_NOTFOUND;
+        }
+        faces[n] = pbody->faces.objs[j-1];
+        egadsFace *pface = (egadsFace *) faces[n]->blind;
+        signs[n] = 1;
+        if (Face.Orientation() != pface->face.Orientation()) signs[n] = -1;
+      }
+    }
+
+  stat = EG_fillFaces(n, faces, fill);
+  if (stat == EGADS_SUCCESS) {
+    for (j = 0; j < 10; j++) surf[j] = vol[j] = 0.0;
+    for (i = 0; i < n; i++) {
+      egadsFace *pface = (egadsFace *) faces[i]->blind;
+      for (j = 0; j < 10; j++) surf[j] += pface->massProp[j];
+      if (fill == 2)
+        for (j = 0; j < 10; j++) vol[j] += signs[i]*pface->massProp[j+10];
+    }
+    data[1] = surf[0];
+    if (fill == 2) {
+      data[0] = vol[0];
+      EG_momentProps(vol,  data);
+    } else {
+      EG_momentProps(surf, data);
+    }
+  }
+  EG_free(signs);
+  EG_free(faces);
+
+  return stat;
+}
+
+
 int
 EG_getBoundingBX(const egObject *topo, double *bbox)
 {
@@ -6377,6 +6847,20 @@ EG_getBoundingBX(const egObject *topo, double *bbox)
     }
   }
 
+#if CASVER >= 730
+  /* assemble Shells, non-Wire Bodies & Models from their parts */
+  if ((topo->oclass == SHELL) || (topo->oclass == MODEL) ||
+      ((topo->oclass == BODY) && (topo->mtype != WIREBODY))) {
+    int stat = EG_assembleBox(topo, bbox);
+    if (stat == EGADS_SUCCESS) {
+      ebox->filled = 1;
+      for (i = 0; i < 6; i++) ebox->box[i] = bbox[i];
+      return EGADS_SUCCESS;
+    }
+    if (stat != EGADS_EMPTY) return stat;
+  }
+#endif
+
   /* no -- lets compute the bounding box */
   try {
 
@@ -6494,7 +6978,7 @@ EG_getBoundingBox(const egObject *topo, double *bbox)
 int
 EG_massProperties(int nTopo, egObject **topos, double *data)
 {
-  int           i;
+  int           i, stat;
   egObject      *topo;
   gp_Pnt        CofG, pv;
   gp_Mat        Inert;
@@ -6559,7 +7043,24 @@ EG_massProperties(int nTopo, egObject **topos, double *data)
         }
       }
     }
-  } else {
+  }
+
+  /* Faces, Shells & non-Wire Bodies are summed from the Face caches */
+  if ((topo->oclass == FACE) || (topo->oclass == SHELL) ||
+      ((topo->oclass == BODY) && (topo->mtype != WIREBODY))) {
+    stat = EG_sumMassProps(nTopo, topos, data);
+    if (stat != EGADS_EMPTY) {
+      if ((stat == EGADS_SUCCESS) && (topo->oclass == BODY) && (nTopo == 1)) {
+        egadsBody *pbody = (egadsBody *) topo->blind;
+        for (i = 0; i < 14; i++) pbody->massProp[i] = data[i];
+        pbody->massFill = 1;
+      }
+      return stat;
+    }
+    for (i = 0; i < 14; i++) data[i] = 0.0;
+  }
+
+  if (nTopo > 1) {
     TopoDS_Compound compound;
     BRep_Builder builder3D;
     builder3D.MakeCompound(compound);
@@ -6645,7 +7146,7 @@ EG_massProperties(int nTopo, egObject **topos, double *data)
 int
 EG_getMassProperties(const egObject *topo, /*@null@*/ double *data)
 {
-  int           i;
+  int           i, stat;
   gp_Pnt        CofG, pv;
   gp_Mat        Inert;
   BRepGProp     BProps;
@@ -6707,6 +7208,21 @@ EG_getMassProperties(const egObject *topo, /*@null@*/ double *data)
     }
   }
 
+  /* Faces, Shells & non-Wire Bodies are summed from the Face caches */
+  if ((topo->oclass == FACE) || (topo->oclass == SHELL) ||
+      ((topo->oclass == BODY) && (topo->mtype != WIREBODY))) {
+    stat = EG_sumMassProps(1, (egObject **) &topo, data);
+    if (stat != EGADS_EMPTY) {
+      if ((stat == EGADS_SUCCESS) && (topo->oclass == BODY)) {
+        egadsBody *pbody = (egadsBody *) topo->blind;
+        for (i = 0; i < 14; i++) pbody->massProp[i] = data[i];
+        pbody->massFill = 1;
+      }
+      return stat;
+    }
+    for (i = 0; i < 14; i++) data[i] = 0.0;
+  }
+
   /* use the appropriate dimensional methods */
   if ((topo->oclass == EDGE) || (topo->oclass == LOOP)) {
 
@@ -6764,11 +7280,255 @@ EG_getMassProperties(const egObject *topo, /*@null@*/ double *data)
 }
 
 
+/* the anchor point & radius of a curve or surface -- two geometries that are
+ * EG_isSame have anchors within the sum of their radii */
+static int
+EG_geomPrint(const egObject *geom, double *print)
+{
+  int      i, stat, oclass, mtype, nk, nc, *info;
+  double   scale, d, nrm[3], *rv;
+  egObject *ref;
+
+  stat = EG_getGeometry(geom, &oclass, &mtype, &ref, &info, &rv);
+  if (stat != EGADS_SUCCESS) return stat;
+
+  /* these compare their reference */
+  if ((mtype == TRIMMED) || (mtype == OFFSET) ||
+      ((oclass == SURFACE) && ((mtype == EXTRUSION) ||
+                               (mtype == REVOLUTION)))) {
+    if (info != NULL) EG_free(info);
+    EG_free(rv);
+    return EG_geomPrint(ref, print);
+  }
+
+  print[1] = 0.0;
+  print[2] = rv[0];
+  print[3] = rv[1];
+  print[4] = rv[2];
+  print[5] = 0.0;
+  if ((mtype == BEZIER) || (mtype == BSPLINE)) {
+    /* the first control point -- compared relative to the largest value */
+    if (oclass == CURVE) {
+      nk = 0;
+      if (mtype == BSPLINE) nk = info[3];
+      nc = nk + 3*info[2];
+      if ((info[0]&2) != 0) nc += info[2];
+      print[1] = info[2];
+    } else {
+      nk = 0;
+      if (mtype == BSPLINE) {
+        nk = info[3] + info[6];
+        nc = nk + 3*info[2]*info[5];
+        if ((info[0]&2) != 0) nc += info[2]*info[5];
+        print[1] = info[2]*info[5];
+      } else {
+        nc = 3*info[2]*info[4];
+        if ((info[0]&2) != 0) nc += info[2]*info[4];
+        print[1] = info[2]*info[4];
+      }
+    }
+    for (scale = 0.0, i = nk; i < nc; i++)
+      if (fabs(rv[i]) > scale) scale = fabs(rv[i]);
+    print[2] = rv[nk  ];
+    print[3] = rv[nk+1];
+    print[4] = rv[nk+2];
+    print[5] = 1.e-14*scale;
+  } else if ((oclass == SURFACE) && (mtype == PLANE)) {
+    /* planes are sampled -- use the point nearest the origin */
+    nrm[0] = rv[4]*rv[8] - rv[5]*rv[7];
+    nrm[1] = rv[5]*rv[6] - rv[3]*rv[8];
+    nrm[2] = rv[3]*rv[7] - rv[4]*rv[6];
+    d      = sqrt(nrm[0]*nrm[0] + nrm[1]*nrm[1] + nrm[2]*nrm[2]);
+    if (d != 0.0) {
+      nrm[0] /= d;
+      nrm[1] /= d;
+      nrm[2] /= d;
+    }
+    d        = nrm[0]*rv[0] + nrm[1]*rv[1] + nrm[2]*rv[2];
+    print[2] = d*nrm[0];
+    print[3] = d*nrm[1];
+    print[4] = d*nrm[2];
+    print[5] = 1.e-6*(1.0 + sqrt(rv[0]*rv[0] + rv[1]*rv[1] + rv[2]*rv[2]));
+  }
+  if (info != NULL) EG_free(info);
+  EG_free(rv);
+
+  return EGADS_SUCCESS;
+}
+
+
+/* fills a fingerprint for an object
+ *
+ * where: object - the object (Node/Edge/Curve/Face/Surface for flag = 0,
+ *                             any topology for flag = 1)
+ *        flag   - 0 for EG_isSame, 1 for EG_isEquivalent
+ *        print  - the returned fingerprint (6 in length):
+ *                 [0] & [1] - keys that must be equal for a match
+ *                 [2-4]     - an anchor point
+ *                 [5]       - the anchor radius (negative for no anchor)
+ *
+ * two objects can only be the same (or equivalent) if the keys match and
+ * each anchor coordinate is within the sum of the radii
+ */
+int
+EG_fingerprint(const egObject *object, int flag, double *print)
+{
+  int      i, stat;
+  double   tol, toler;
+  egObject *geom;
+
+  if  (object == NULL)               return EGADS_NULLOBJ;
+  if  (object->magicnumber != MAGIC) return EGADS_NOTOBJ;
+  if  (object->blind == NULL)        return EGADS_NODATA;
+  if  (print == NULL)                return EGADS_NONAME;
+  for (i = 0; i < 6; i++) print[i] = 0.0;
+  print[5] = -1.0;
+
+  if (flag == 0) {
+    if ((object->oclass != NODE)  && (object->oclass != EDGE)  &&
+        (object->oclass != CURVE) && (object->oclass != FACE)  &&
+        (object->oclass != SURFACE)) return EGADS_NOTGEOM;
+  } else {
+    if ((object->oclass < NODE) ||
+        (object->oclass > MODEL))    return EGADS_NOTTOPO;
+  }
+
+  /* Nodes are the same for both */
+  if (object->oclass == NODE) {
+    egadsNode *pnode = (egadsNode *) object->blind;
+    stat = EG_getTolerance(object, &tol);
+    if (stat != EGADS_SUCCESS) return stat;
+    print[0] = 100*NODE;
+    print[2] = pnode->xyz[0];
+    print[3] = pnode->xyz[1];
+    print[4] = pnode->xyz[2];
+    print[5] = tol;
+    return EGADS_SUCCESS;
+  }
+
+  if (flag == 0) {
+
+    /* Edges & Curves (Faces & Surfaces) compare the geometry */
+    geom = (egObject *) object;
+    if (object->oclass == EDGE) {
+      if (object->mtype == DEGENERATE) {
+        print[0] = 100*EDGE + DEGENERATE;
+        return EGADS_SUCCESS;
+      }
+      egadsEdge *pedge = (egadsEdge *) object->blind;
+      geom = pedge->curve;
+    } else if (object->oclass == FACE) {
+      egadsFace *pface = (egadsFace *) object->blind;
+      geom = pface->surface;
+    }
+    if (geom == NULL)               return EGADS_NULLOBJ;
+    if (geom->magicnumber != MAGIC) return EGADS_NOTOBJ;
+    print[0] = 100*geom->oclass + geom->mtype;
+    return EG_geomPrint(geom, print);
+
+  }
+
+  if (object->oclass == EDGE) {
+
+    /* the Nodes must be the same -- use their average */
+    egadsEdge *pedge = (egadsEdge *) object->blind;
+    print[0] = 100*EDGE + object->mtype;
+    print[1] = -1.0;
+    if (pedge->curve != NULL) print[1] = pedge->curve->mtype;
+    if (object->mtype == DEGENERATE) print[1] = -1.0;
+    stat = EG_getTolerance(pedge->nodes[0], &tol);
+    if (stat != EGADS_SUCCESS) return stat;
+    egadsNode *pnode0 = (egadsNode *) pedge->nodes[0]->blind;
+    print[2] = pnode0->xyz[0];
+    print[3] = pnode0->xyz[1];
+    print[4] = pnode0->xyz[2];
+    if (object->mtype == TWONODE) {
+      stat = EG_getTolerance(pedge->nodes[1], &toler);
+      if (stat != EGADS_SUCCESS) return stat;
+      if (toler > tol) tol = toler;
+      egadsNode *pnode1 = (egadsNode *) pedge->nodes[1]->blind;
+      print[2] = 0.5*(print[2] + pnode1->xyz[0]);
+      print[3] = 0.5*(print[3] + pnode1->xyz[1]);
+      print[4] = 0.5*(print[4] + pnode1->xyz[2]);
+    }
+    print[5] = tol;
+
+  } else if (object->oclass == LOOP) {
+
+    /* Edges only need to be found -- no anchor */
+    egadsLoop *ploop = (egadsLoop *) object->blind;
+    print[0] = 100*LOOP;
+    print[1] = ploop->nedges;
+
+  } else if (object->oclass == FACE) {
+
+    egadsFace *pface = (egadsFace *) object->blind;
+    if (pface->surface == NULL) return EGADS_NULLOBJ;
+    stat = EG_geomPrint(pface->surface, print);
+    if (stat != EGADS_SUCCESS) return stat;
+    print[0] = 100*FACE + pface->surface->mtype;
+    print[1] = pface->nloops;
+
+  } else if (object->oclass == SHELL) {
+
+    /* the Faces are compared in order -- use the first */
+    egadsShell *pshell = (egadsShell *) object->blind;
+    if (pshell->nfaces > 0) {
+      stat = EG_fingerprint(pshell->faces[0], 1, print);
+      if (stat != EGADS_SUCCESS) return stat;
+    }
+    print[0] = 100*SHELL;
+    print[1] = pshell->nfaces;
+
+  } else if (object->oclass == BODY) {
+
+    egadsBody *pbody = (egadsBody *) object->blind;
+    if (pbody->shells.map.Extent() != 0) {
+      stat = EG_fingerprint(pbody->shells.objs[0], 1, print);
+    } else if (pbody->faces.map.Extent() != 0) {
+      stat = EG_fingerprint(pbody->faces.objs[0],  1, print);
+    } else if (pbody->edges.map.Extent() != 0) {
+      stat = EG_fingerprint(pbody->edges.objs[0],  1, print);
+    } else {
+      stat = EGADS_SUCCESS;
+    }
+    if (stat != EGADS_SUCCESS) return stat;
+    print[0] = 100*BODY;
+    print[1] = pbody->faces.map.Extent()*1000.0 + pbody->edges.map.Extent();
+
+  } else {
+
+    print[0] = 100*MODEL;
+    print[5] = -1.0;
+
+  }
+
+  return EGADS_SUCCESS;
+}
+
+
+static int
+EG_printMatch(const double *print1, const double *print2)
+{
+  double r;
+
+  if (print1[0] != print2[0]) return 0;
+  if (print1[1] != print2[1]) return 0;
+  if ((print1[5] < 0.0) || (print2[5] < 0.0)) return 1;
+  r = print1[5] + print2[5];
+  if (fabs(print1[2] - print2[2]) > r) return 0;
+  if (fabs(print1[3] - print2[3]) > r) return 0;
+  if (fabs(print1[4] - print2[4]) > r) return 0;
+
+  return 1;
+}
+
+
 int
 EG_isEquivalent(const egObject *topo1, const egObject *topo2)
 {
   int          i, j, n, stat;
-  double       t, tol, result1[9], result2[9];
+  double       t, tol, result1[9], result2[9], print1[6], print2[6];
   TopoDS_Shape shape1, shape2;
 
   if (topo1 == topo2)                 return EGADS_SUCCESS;
@@ -6875,13 +7635,20 @@ EG_isEquivalent(const egObject *topo1, const egObject *topo2)
     egadsLoop *ploop2 = (egadsLoop *) topo2->blind;
 
     if (ploop1->nedges != ploop2->nedges) return EGADS_OUTSIDE;
+    /* only look at Edges whose fingerprints can match -- an Edge that
+       cannot be fingerprinted is always compared */
     for (i = 0; i < ploop1->nedges; i++) {
-      for (n = j = 0; j < ploop2->nedges; j++)
+      stat = EG_fingerprint(ploop1->edges[i], 1, print1);
+      for (n = j = 0; j < ploop2->nedges; j++) {
+        if ((stat == EGADS_SUCCESS) &&
+            (EG_fingerprint(ploop2->edges[j], 1, print2) == EGADS_SUCCESS) &&
+            (EG_printMatch(print1, print2) == 0)) continue;
         if (EG_isEquivalent(ploop1->edges[i], ploop2->edges[j]) ==
             EGADS_SUCCESS) {
           n = j+1;
           break;
         }
+      }
       if (n == 0) return EGADS_OUTSIDE;
     }
     return EGADS_SUCCESS;
@@ -6952,6 +7719,237 @@ EG_isEquivalent(const egObject *topo1, const egObject *topo2)
 }
 
 
+static void
+EG_matchThread(void *struc)
+{
+  int      i, j, k, index, end;
+  long     ID;
+  EMPmatch *mthread;
+
+  mthread = (EMPmatch *) struc;
+
+  /* get our identifier */
+  ID = EMP_ThreadID();
+
+  /* look for work */
+  for (;;) {
+
+    /* only one thread at a time here -- controlled by a mutex! */
+    if (mthread->mutex != NULL) EMP_LockSet(mthread->mutex);
+    index = mthread->index;
+    mthread->index += MATCHBLOCK;
+    if (mthread->mutex != NULL) EMP_LockRelease(mthread->mutex);
+    if (index >= mthread->end) break;
+
+    /* do the work -- a block of candidate pairs */
+    end = index + MATCHBLOCK;
+    if (end > mthread->end) end = mthread->end;
+    for (k = index; k < end; k++) {
+      i = mthread->pairs[2*k  ];
+      j = mthread->pairs[2*k+1];
+      if (mthread->flag == 0) {
+        mthread->hits[k] = EG_isSame(mthread->objs[i], mthread->objs[j]);
+      } else {
+        mthread->hits[k] = EG_isEquivalent(mthread->objs[i], mthread->objs[j]);
+      }
+    }
+  }
+
+  /* exhausted all work -- exit */
+  if (ID != mthread->master) EMP_ThreadExit();
+}
+
+
+static int
+EG_comparePrint(const void *a, const void *b)
+{
+  const double *pa = (const double *) a;
+  const double *pb = (const double *) b;
+
+  /* [0] & [1] are keys, then the anchor's x, then the object index */
+  if (pa[0] < pb[0]) return -1;
+  if (pa[0] > pb[0]) return  1;
+  if (pa[1] < pb[1]) return -1;
+  if (pa[1] > pb[1]) return  1;
+  if (pa[2] < pb[2]) return -1;
+  if (pa[2] > pb[2]) return  1;
+  if (pa[6] < pb[6]) return -1;
+  if (pa[6] > pb[6]) return  1;
+  return 0;
+}
+
+
+static int
+EG_comparePair(const void *a, const void *b)
+{
+  const int *pa = (const int *) a;
+  const int *pb = (const int *) b;
+
+  if (pa[0] != pb[0]) return pa[0] - pb[0];
+  return pa[1] - pb[1];
+}
+
+
+/* finds all of the pairs of objects that are the same (or equivalent)
+ *
+ * where: nobj  - the number of objects
+ *        objs  - the objects
+ *        flag  - 0 for EG_isSame, 1 for EG_isEquivalent
+ *        nmatch - the returned number of matching pairs
+ *        match  - the returned pairs of 1-bias indices into objs (2*nmatch
+ *                 in length, i < j in each pair, sorted) -- freed by EG_free
+ *
+ * objects are bucketed by fingerprint and the exact test is only applied to
+ * pairs whose fingerprints can match
+ */
+int
+EG_matchObjects(int nobj, const egObject **objs, int flag, int *nmatch,
+                int **match)
+{
+  int      i, j, k, n, np, stat, mpair, npair, *pairs, *tmp;
+  double   rmax, *prints;
+  void     **threads = NULL;
+  EMPmatch mthread;
+
+  *nmatch = 0;
+  *match  = NULL;
+  if (nobj <= 1)                   return EGADS_EMPTY;
+  if (objs == NULL)                return EGADS_NULLOBJ;
+  if ((flag != 0) && (flag != 1))  return EGADS_RANGERR;
+
+  /* get the fingerprints -- [6] holds the index */
+  prints = (double *) EG_alloc(7*nobj*sizeof(double));
+  if (prints == NULL) return EGADS_MALLOC;
+  for (i = 0; i < nobj; i++) {
+    stat = EG_fingerprint(objs[i], flag, &prints[7*i]);
+    if (stat != EGADS_SUCCESS) {
+      EG_free(prints);
+      return stat;
+    }
+    prints[7*i+6] = i;
+  }
+  qsort(prints, nobj, 7*sizeof(double), EG_comparePrint);
+
+  /* sweep each bucket along x */
+  mpair = nobj;
+  npair = 0;
+  pairs = (int *) EG_alloc(2*mpair*sizeof(int));
+  if (pairs == NULL) {
+    EG_free(prints);
+    return EGADS_MALLOC;
+  }
+  for (i = 0; i < nobj; i = k) {
+    rmax = prints[7*i+5];
+    for (k = i+1; k < nobj; k++) {
+      if (prints[7*k  ] != prints[7*i  ]) break;
+      if (prints[7*k+1] != prints[7*i+1]) break;
+      if (prints[7*k+5] > rmax) rmax = prints[7*k+5];
+    }
+    for (n = i; n < k; n++)
+      for (j = n+1; j < k; j++) {
+        if ((prints[7*n+5] >= 0.0) && (prints[7*j+5] >= 0.0))
+          if (prints[7*j+2] - prints[7*n+2] > prints[7*n+5] + rmax) break;
+        if (EG_printMatch(&prints[7*n], &prints[7*j]) == 0) continue;
+        if (npair >= mpair) {
+          mpair *= 2;
+          tmp    = (int *) EG_reall(pairs, 2*mpair*sizeof(int));
+          if (tmp == NULL) {
+            EG_free(pairs);
+            EG_free(prints);
+            return EGADS_MALLOC;
+          }
+          pairs = tmp;
+        }
+        pairs[2*npair  ] = prints[7*n+6];
+        pairs[2*npair+1] = prints[7*j+6];
+        if (pairs[2*npair] > pairs[2*npair+1]) {
+          pairs[2*npair  ] = prints[7*j+6];
+          pairs[2*npair+1] = prints[7*n+6];
+        }
+        npair++;
+      }
+  }
+  EG_free(prints);
+  if (npair == 0) {
+    EG_free(pairs);
+    return EGADS_SUCCESS;
+  }
+
+  /* the exact tests */
+  mthread.hits = (int *) EG_alloc(npair*sizeof(int));
+  if (mthread.hits == NULL) {
+    EG_free(pairs);
+    return EGADS_MALLOC;
+  }
+  mthread.mutex  = NULL;
+  mthread.master = EMP_ThreadID();
+  mthread.index  = 0;
+  mthread.end    = npair;
+  mthread.flag   = flag;
+  mthread.objs   = objs;
+  mthread.pairs  = pairs;
+
+  np = EMP_Init(NULL);
+  if ((npair+MATCHBLOCK-1)/MATCHBLOCK < np) np = (npair+MATCHBLOCK-1)/MATCHBLOCK;
+  if (np > 1) {
+    /* create the mutex to handle list synchronization */
+    mthread.mutex = EMP_LockCreate();
+    if (mthread.mutex == NULL) {
+      printf(" EMP Error: mutex creation = NULL!\n");
+      np = 1;
+    } else {
+      /* get storage for our extra threads */
+      threads = (void **) malloc((np-1)*sizeof(void *));
+      if (threads == NULL) {
+        EMP_LockDestroy(mthread.mutex);
+        mthread.mutex = NULL;
+        np = 1;
+      }
+    }
+  }
+
+  /* create the threads and get going! */
+  if (threads != NULL)
+    for (i = 0; i < np-1; i++) {
+      threads[i] = EMP_ThreadCreate(EG_matchThread, &mthread);
+      if (threads[i] == NULL)
+        printf(" EMP Error Creating Thread #%d!\n", i+1);
+    }
+  /* now run the thread block from the original thread */
+  EG_matchThread(&mthread);
+
+  /* wait for all others to return */
+  if (threads != NULL)
+    for (i = 0; i < np-1; i++)
+      if (threads[i] != NULL) EMP_ThreadWait(threads[i]);
+
+  /* cleanup */
+  if (threads != NULL)
+    for (i = 0; i < np-1; i++)
+      if (threads[i] != NULL) EMP_ThreadDestroy(threads[i]);
+  if (mthread.mutex != NULL) EMP_LockDestroy(mthread.mutex);
+  if (threads != NULL) free(threads);
+
+  /* keep the hits */
+  for (n = k = 0; k < npair; k++) {
+    if (mthread.hits[k] != EGADS_SUCCESS) continue;
+    pairs[2*n  ] = pairs[2*k  ] + 1;
+    pairs[2*n+1] = pairs[2*k+1] + 1;
+    n++;
+  }
+  EG_free(mthread.hits);
+  if (n == 0) {
+    EG_free(pairs);
+    return EGADS_SUCCESS;
+  }
+  qsort(pairs, n, 2*sizeof(int), EG_comparePair);
+
+  *nmatch = n;
+  *match  = pairs;
+  return EGADS_SUCCESS;
+}
+
+
 int
 EG_isPlanar(const egObject *topo)
 {
@@ -8171,6 +9169,82 @@ EG_inTopology(const egObject *topo, const double *xyz)
 }
 
 
+int
+EG_inTopologyBatch(const egObject *topo, int npts, const double *xyzs,
+                   int *results)
+{
+  int           i, stat, outLevel;
+  Standard_Real tol;
+  TopoDS_Solid  solid;
+
+  if (topo == NULL)               return EGADS_NULLOBJ;
+  if (topo->magicnumber != MAGIC) return EGADS_NOTOBJ;
+  if (topo->blind == NULL)        return EGADS_NODATA;
+  if ((topo->oclass != EDGE) && (topo->oclass != FACE) &&
+      (topo->oclass != SHELL) && (topo->oclass != BODY))
+                                  return EGADS_NOTTOPO;
+  outLevel = EG_outLevel(topo);
+  if (npts <= 0) {
+    if (outLevel > 0)
+      printf(" EGADS Error: nPoints = %d (EG_inTopologyBatch)!\n", npts);
+    return EGADS_RANGERR;
+  }
+  if ((xyzs == NULL) || (results == NULL)) {
+    if (outLevel > 0)
+      printf(" EGADS Error: NULL Arguments (EG_inTopologyBatch)!\n");
+    return EGADS_NODATA;
+  }
+
+  if ((topo->oclass == SHELL) && (topo->mtype == CLOSED)) {
+    egadsShell *pshell = (egadsShell *) topo->blind;
+    BRep_Builder builder3D;
+    builder3D.MakeSolid(solid);
+    builder3D.Add(solid, pshell->shell);
+    try {
+      BRepLib::OrientClosedSolid(solid);
+    }
+    catch (const Standard_Failure& e) {
+      printf(" EGADS Warning: Cannot Orient Solid (EG_inTopologyBatch)!\n");
+      printf("                %s\n", e.GetMessageString());
+      return EGADS_TOPOERR;
+    }
+    catch (...) {
+      printf(" EGADS Warning: Cannot Orient Solid (EG_inTopologyBatch)!\n");
+      return EGADS_TOPOERR;
+    }
+  } else if ((topo->oclass == BODY) && (topo->mtype == SOLIDBODY)) {
+    egadsBody *pbody = (egadsBody *) topo->blind;
+    solid = TopoDS::Solid(pbody->shape);
+  } else {
+    for (i = 0; i < npts; i++)
+      results[i] = EG_inTopology(topo, &xyzs[3*i]);
+    return EGADS_SUCCESS;
+  }
+
+  stat = EG_tolerance(topo, &tol);
+  if (stat != EGADS_SUCCESS) {
+    if (outLevel > 0)
+      printf(" EGADS Warning: EG_tolerance = %d (EG_inTopologyBatch)!\n",
+             stat);
+    return stat;
+  }
+
+  /* one classifier -- its Face data is set up once for all of the points */
+  BRepClass3d_SolidClassifier sClassifier(solid);
+  for (i = 0; i < npts; i++) {
+    gp_Pnt pnt(xyzs[3*i], xyzs[3*i+1], xyzs[3*i+2]);
+    sClassifier.Perform(pnt, tol);
+    if (sClassifier.State() == TopAbs_OUT) {
+      results[i] = EGADS_OUTSIDE;
+    } else {
+      results[i] = EGADS_SUCCESS;
+    }
+  }
+
+  return EGADS_SUCCESS;
+}
+
+
 int
 EG_inFace(const egObject *face, const double *uv)
 {
@@ -16,6 +16,7 @@
 #include "egadsTris.h"
 #ifndef LITE
 #include "prm.h"
+#include "emp.h"
 #endif
 
 
@@ -28,6 +29,11 @@
 #define CUTANG          3.10
 #define MAXANG          3.13
 #define MAXORCNT        500
+#define STREAMPTS       250000  /* default representatives for streaming fit */
+#define STREAMCHUNK     16384   /* points per chunk in the streaming passes */
+#define STREAMROUNDS    4       /* active-set rounds in the streaming fit */
+#define STREAMPASSES    4       /* attempts at a representative triangulation */
+#define INTRIBLOCK      64      /* points per block in EG_inTriExactBatch */
 
 
 #define AREA2D(a,b,c)   ((a[0]-c[0])*(b[1]-c[1]) - (a[1]-c[1])*(b[0]-c[0]))
@@ -70,6 +76,9 @@ __PROTO_H_AND_D__ int  EG_quad2tris (long tID, const egObject *face,
                                      int *ntris, int **tris, int *tfi);
 
 __PROTO_H_AND_D__ double EG_orienTri(double *t0, double *t1, double *t2);
+__PROTO_H_AND_D__ int    EG_orienTriBatch(double *pa, double *pb, double *pc,
+                                         int iq, int n, double *pq,
+                                         double *dets);
 
 
 /*
@@ -3151,15 +3160,12 @@ EG_sign(double s)
 }
 
 
-__HOST_AND_DEVICE__ int
-EG_inTriExact(double *t1, double *t2, double *t3, double *p, double *w)
+__HOST_AND_DEVICE__ static int
+EG_inTriSigns(double *w)
 {
   int    d1, d2, d3;
   double sum;
   
-  w[0] = EG_orienTri(t2, t3, p);
-  w[1] = EG_orienTri(t1, p,  t3);
-  w[2] = EG_orienTri(t1, t2, p);
   d1   = EG_sign(w[0]);
   d2   = EG_sign(w[1]);
   d3   = EG_sign(w[2]);
@@ -3191,55 +3197,129 @@ EG_inTriExact(double *t1, double *t2, double *t3, double *p, double *w)
 }
 
 
+__HOST_AND_DEVICE__ int
+EG_inTriExact(double *t1, double *t2, double *t3, double *p, double *w)
+{
+  w[0] = EG_orienTri(t2, t3, p);
+  w[1] = EG_orienTri(t1, p,  t3);
+  w[2] = EG_orienTri(t1, t2, p);
+  
+  return EG_inTriSigns(w);
+}
+
+
+/* many points (p is 2*n) against a single triangle -- w is 3*n and in is
+ * filled with what EG_inTriExact would return for each point           */
+
+__HOST_AND_DEVICE__ int
+EG_inTriExactBatch(double *t1, double *t2, double *t3, int n, double *p,
+                   double *w, int *in)
+{
+  int    i, j, m;
+  double w0[INTRIBLOCK], w1[INTRIBLOCK], w2[INTRIBLOCK];
+  
+  for (j = 0; j < n; j += INTRIBLOCK) {
+    m = n - j;
+    if (m > INTRIBLOCK) m = INTRIBLOCK;
+    EG_orienTriBatch(t2,   t3,   NULL, 2, m, &p[2*j], w0);
+    EG_orienTriBatch(t1,   NULL, t3,   1, m, &p[2*j], w1);
+    EG_orienTriBatch(t1,   t2,   NULL, 2, m, &p[2*j], w2);
+    for (i = 0; i < m; i++) {
+      w[3*(i+j)  ] = w0[i];
+      w[3*(i+j)+1] = w1[i];
+      w[3*(i+j)+2] = w2[i];
+      in[i+j]      = EG_inTriSigns(&w[3*(i+j)]);
+    }
+  }
+  
+  return EGADS_SUCCESS;
+}
+
+
 int
 EG_baryFrame(egTess2D *tess2d)
 {
-  int    i, j, i0, i1, i2, cls;
-  double neg, w[3];
+  int    i, j, k, n, m, i0, i1, i2, *cls, *act, *in;
+  double *neg, *puv, *ws, w[3];
 
   tess2d->bary = (egBary *) EG_alloc(tess2d->npts*sizeof(egBary));
   if (tess2d->bary == NULL) return EGADS_MALLOC;
+  cls = (int *)    EG_alloc(3*tess2d->npts*sizeof(int));
+  neg = (double *) EG_alloc(6*tess2d->npts*sizeof(double));
+  if ((cls == NULL) || (neg == NULL)) {
+    if (cls != NULL) EG_free(cls);
+    if (neg != NULL) EG_free(neg);
+    EG_free(tess2d->bary);
+    tess2d->bary = NULL;
+    return EGADS_MALLOC;
+  }
+  act = &cls[  tess2d->npts];
+  in  = &cls[2*tess2d->npts];
+  puv = &neg[  tess2d->npts];
+  ws  = &neg[3*tess2d->npts];
   
   for (i = 0; i < tess2d->npts; i++) {
     tess2d->bary[i].tri  = 0;
-    tess2d->bary[i].w[0] = tess2d->bary[i].w[1] = neg = 0.0;
-    for (cls = j = 0; j < tess2d->nframe; j++) {
-      i0 = tess2d->frame[3*j  ] - 1;
-      i1 = tess2d->frame[3*j+1] - 1;
-      i2 = tess2d->frame[3*j+2] - 1;
-      if (EG_inTriExact(&tess2d->uv[2*i0], &tess2d->uv[2*i1], &tess2d->uv[2*i2],
-                        &tess2d->uv[2*i],  w) == EGADS_SUCCESS) {
+    tess2d->bary[i].w[0] = tess2d->bary[i].w[1] = neg[i] = 0.0;
+    cls[i]     = 0;
+    act[i]     = i;
+    puv[2*i  ] = tess2d->uv[2*i  ];
+    puv[2*i+1] = tess2d->uv[2*i+1];
+  }
+  
+  /* sweep the frame triangles over the points not yet located */
+  n = tess2d->npts;
+  for (j = 0; (j < tess2d->nframe) && (n > 0); j++) {
+    i0 = tess2d->frame[3*j  ] - 1;
+    i1 = tess2d->frame[3*j+1] - 1;
+    i2 = tess2d->frame[3*j+2] - 1;
+    EG_inTriExactBatch(&tess2d->uv[2*i0], &tess2d->uv[2*i1],
+                       &tess2d->uv[2*i2], n, puv, ws, in);
+    for (m = k = 0; k < n; k++) {
+      i = act[k];
+      if (in[k] == EGADS_SUCCESS) {
         tess2d->bary[i].tri  = j+1;
-        tess2d->bary[i].w[0] = w[0];
-        tess2d->bary[i].w[1] = w[1];
-        break;
+        tess2d->bary[i].w[0] = ws[3*k  ];
+        tess2d->bary[i].w[1] = ws[3*k+1];
+        continue;
       }
-      if (w[1] < w[0]) w[0] = w[1];
-      if (w[2] < w[0]) w[0] = w[2];
-      if (cls == 0) {
-        cls = j+1;
-        neg = w[0];
+      w[0] = ws[3*k];
+      if (ws[3*k+1] < w[0]) w[0] = ws[3*k+1];
+      if (ws[3*k+2] < w[0]) w[0] = ws[3*k+2];
+      if (cls[i] == 0) {
+        cls[i] = j+1;
+        neg[i] = w[0];
       } else {
-        if (w[0] > neg) {
-          cls = j+1;
-          neg = w[0];
+        if (w[0] > neg[i]) {
+          cls[i] = j+1;
+          neg[i] = w[0];
         }
       }
+      act[m]     = i;
+      puv[2*m  ] = puv[2*k  ];
+      puv[2*m+1] = puv[2*k+1];
+      m++;
     }
-    if ((cls == 0) && (tess2d->bary[i].tri == 0)) {
+    n = m;
+  }
+  
+  for (i = 0; i < tess2d->npts; i++) {
+    if ((cls[i] == 0) && (tess2d->bary[i].tri == 0)) {
       printf(" EGADS Error: No frame triangle found for %lf %lf  %d!\n",
              tess2d->uv[2*i], tess2d->uv[2*i+1], i+1);
+      EG_free(neg);
+      EG_free(cls);
       EG_free(tess2d->bary);
       tess2d->bary = NULL;
       return EGADS_NOTFOUND;
     }
     if (tess2d->bary[i].tri == 0) {
-      i0 = tess2d->frame[3*cls-3] - 1;
-      i1 = tess2d->frame[3*cls-2] - 1;
-      i2 = tess2d->frame[3*cls-1] - 1;
+      i0 = tess2d->frame[3*cls[i]-3] - 1;
+      i1 = tess2d->frame[3*cls[i]-2] - 1;
+      i2 = tess2d->frame[3*cls[i]-1] - 1;
       EG_inTriExact(&tess2d->uv[2*i0], &tess2d->uv[2*i1], &tess2d->uv[2*i2],
                     &tess2d->uv[2*i],  w);
-      tess2d->bary[i].tri  = cls;
+      tess2d->bary[i].tri  = cls[i];
       tess2d->bary[i].w[0] = w[0];
       tess2d->bary[i].w[1] = w[1];
       printf(" EGADS Warning: Extrapolation for %lf %lf  %d (EG_baryFrame)!\n",
@@ -3255,6 +3335,8 @@ EG_baryFrame(egTess2D *tess2d)
              tess2d->uv[2*i2+1], w[2]);
     }
   }
+  EG_free(neg);
+  EG_free(cls);
   
   return EGADS_SUCCESS;
 }
@@ -3301,17 +3383,156 @@ EG_baryTess(egTess2D tess2d, const double *uv, double *w)
 
 
 #ifndef LITE
+
+typedef struct {
+  int    key[3];                /* cell indices */
+  int    rep;                   /* representative index or -1 (empty) */
+} fitCell;
+
+typedef struct {
+  int     nhash;                /* size of the table (power of 2) */
+  int     nrep;                 /* number of representatives */
+  int     mrep;                 /* allocated representatives */
+  fitCell *cells;               /* hash table of occupied cells */
+  double  *rxyz;                /* representative coordinates (sums) */
+  int     *rcnt;                /* number of points in the cell */
+  double  xyz0[3];              /* lower corner of the bounding box */
+  double  size;                 /* cell size */
+} fitGrid;
+
+typedef struct {
+  void     *mutex;              /* the mutex or NULL for single thread */
+  long     master;              /* master thread ID */
+  int      index;               /* next chunk */
+  int      nchunk;              /* number of chunks */
+  int      mode;                /* 0 - check, 1 - select */
+  int      npts;                /* number of points */
+  const double *xyzs;           /* the points */
+  double   tol;                 /* tolerance */
+  int      per;                 /* periodicity of the parameterization */
+  fitGrid  *cgrid;              /* cell hash */
+  int      *ftri;               /* offsets into jtri for each representative */
+  int      *jtri;               /* reduced tris at each representative */
+  int      *rtris;              /* reduced tris */
+  prmUV    *ruv;                /* representative parameters */
+  gridTree tree;                /* the fit */
+  int      *nover;              /* per chunk: number over tol */
+  int      *nskip;              /* per chunk: number not located */
+  double   *emax;               /* per chunk: maximum error */
+  double   *esum;               /* per chunk: sum of squared errors */
+  int      stride;              /* select every stride-th point over tol */
+  double   *axyz;               /* selected coordinates */
+  prmUV    *auv;                /* selected parameters */
+} EMPfit;
+
+
+static int
+EG_fitNeighbors(int npts, int ntris, prmTri *ptris)
+{
+  int     i, j, n, *vtab;
+  connect *etab;
+
+  vtab = (int *) EG_alloc(npts*sizeof(int));
+  if (vtab == NULL) return EGADS_MALLOC;
+  etab = (connect *) EG_alloc(ntris*3*sizeof(connect));
+  if (etab == NULL) {
+    EG_free(vtab);
+    return EGADS_MALLOC;
+  }
+  n = NOTFILLED;
+  for (j = 0; j < npts; j++) vtab[j] = NOTFILLED;
+  for (i = 0; i < ntris;  i++) {
+    EG_makeConnect( ptris[i].indices[1], ptris[i].indices[2],
+                   &ptris[i].neigh[0], &n, vtab, etab, 0);
+    EG_makeConnect( ptris[i].indices[0], ptris[i].indices[2],
+                   &ptris[i].neigh[1], &n, vtab, etab, 0);
+    EG_makeConnect( ptris[i].indices[0], ptris[i].indices[1],
+                   &ptris[i].neigh[2], &n, vtab, etab, 0);
+  }
+  /* find any unconnected triangle sides */
+  for (j = 0; j <= n; j++) {
+    if (etab[j].tri == NULL) continue;
+/*  printf(" EGADS Info: Unconnected Side %d %d = %d\n",
+           etab[j].node1+1, etab[j].node2+1, *etab[j].tri); */
+    *etab[j].tri = 0;
+  }
+  EG_free(etab);
+  EG_free(vtab);
+
+  return EGADS_SUCCESS;
+}
+
+
+/* get the parameterization -- n is the stage reached */
+
+static int
+EG_fitParam(int outLevel, int npts, double *xyzs, int ntris, prmTri *ptris,
+            prmUV *uv, int *per, int **ppnts, int *n)
+{
+  int    stat, type;
+  prmXYZ *pxyz;
+
+  pxyz = (prmXYZ *) xyzs;
+  *n   = 1;
+  stat = EGADS_SUCCESS;
+  type = prm_CreateUV(0, ntris, ptris, NULL, npts, NULL, NULL, uv, pxyz,
+                      per, ppnts);
+  if (outLevel > 1) {
+    printf(" EG_fitTriangles: prm_CreateUV = %d  per = %d\n", type, *per);
+    if (type == PRM_NOGLOBALUV) {
+      printf("                  npts = %d  ntris = %d\n", npts, ntris);
+/*    for (i = 0; i < npts; i++)
+        printf("         %d:  %lf %lf %lf\n",
+               i, xyzs[3*i  ], xyzs[3*i+1], xyzs[3*i+2]);  */
+    }
+  }
+  if (type <= 0) return stat;
+
+  *n   = 2;
+  stat = prm_SmoothUV(3, *per, *ppnts, ntris, ptris, npts, 3, uv, xyzs);
+  if (outLevel > 1)
+    printf(" EG_fitTriangles: prm_SmoothUV = %d\n", stat);
+  if (stat == EGADS_MALLOC)     stat = EGADS_SUCCESS;
+  if (stat == PRM_NOTCONVERGED) stat = EGADS_SUCCESS;
+  while ((stat != EGADS_SUCCESS) && (type < 7)) {
+    if (*ppnts != NULL) EG_free(*ppnts);
+    *ppnts = NULL;
+    type++;
+    if (type < 6) type = 6;
+    *n   = 1;
+    stat = prm_CreateUV(type, ntris, ptris, NULL, npts, NULL, NULL, uv, pxyz,
+                        per, ppnts);
+    if (outLevel > 1)
+      printf(" EG_fitTriangles: prm_CreateUV = %d  per = %d\n", stat, *per);
+    if (stat < EGADS_SUCCESS) continue;
+    *n   = 2;
+    stat = prm_SmoothUV(3, *per, *ppnts, ntris, ptris, npts, 3, uv, xyzs);
+    if (outLevel > 1)
+      printf(" EG_fitTriangles: prm_SmoothUV = %d\n", stat);
+    if (stat == EGADS_MALLOC)     stat = EGADS_SUCCESS;
+    if (stat == PRM_NOTCONVERGED) stat = EGADS_SUCCESS;
+  }
+  if (stat != EGADS_SUCCESS) return stat;
+
+  *n   = 3;
+  stat = prm_NormalizeUV(0.01, *per, npts, uv);
+  if (outLevel > 1)
+    printf(" EG_fitTriangles: prm_NormalizeUV = %d\n", stat);
+  if (stat == EGADS_SUCCESS) *n = 4;
+
+  return stat;
+}
+
+
 int
 EG_fitTriangles(egObject *context, int npts, double *xyzs, int ntris,
                 const int *tris, /*@null@*/ const int *tric, double tol,
                 egObject **bspline)
 {
-  int     i, j, n, outLevel, stat, type, nu, nv, per, sizes[2], *ppnts, *vtab;
+  int     i, n, outLevel, stat, nu, nv, per, sizes[2], *ppnts = NULL;
   double  rmserr, maxerr, dotmin, *grid = NULL;
-  prmXYZ  *pxyz;
   prmTri  *ptris;
   prmUV   *uv;
-  connect *etab;
   
   *bspline = NULL;
   if (context == NULL)               return EGADS_NULLOBJ;
@@ -3320,7 +3541,6 @@ EG_fitTriangles(egObject *context, int npts, double *xyzs, int ntris,
   if (EG_sameThread(context))        return EGADS_CNTXTHRD;
   if ((ntris <= 0) || (npts <= 0))   return EGADS_EMPTY;
   outLevel = EG_outLevel(context);
-  pxyz     = (prmXYZ *) xyzs;
   
   ptris = (prmTri *) EG_alloc(ntris*sizeof(prmTri));
   if (ptris == NULL) return EGADS_MALLOC;
@@ -3363,36 +3583,11 @@ EG_fitTriangles(egObject *context, int npts, double *xyzs, int ntris,
   
   /* get connectivity if not supplied */
   if (tric == NULL) {
-    vtab = (int *) EG_alloc(npts*sizeof(int));
-    if (vtab == NULL) {
-      EG_free(ptris);
-      return EGADS_MALLOC;
-    }
-    etab = (connect *) EG_alloc(ntris*3*sizeof(connect));
-    if (etab == NULL) {
-      EG_free(vtab);
+    stat = EG_fitNeighbors(npts, ntris, ptris);
+    if (stat != EGADS_SUCCESS) {
       EG_free(ptris);
-      return EGADS_MALLOC;
+      return stat;
     }
-    n = NOTFILLED;
-    for (j = 0; j < npts; j++) vtab[j] = NOTFILLED;
-    for (i = 0; i < ntris;  i++) {
-      EG_makeConnect( ptris[i].indices[1], ptris[i].indices[2],
-                     &ptris[i].neigh[0], &n, vtab, etab, 0);
-      EG_makeConnect( ptris[i].indices[0], ptris[i].indices[2],
-                     &ptris[i].neigh[1], &n, vtab, etab, 0);
-      EG_makeConnect( ptris[i].indices[0], ptris[i].indices[1],
-                     &ptris[i].neigh[2], &n, vtab, etab, 0);
-    }
-    /* find any unconnected triangle sides */
-    for (j = 0; j <= n; j++) {
-      if (etab[j].tri == NULL) continue;
-/*    printf(" EGADS Info: Unconnected Side %d %d = %d\n",
-             etab[j].node1+1, etab[j].node2+1, *etab[j].tri); */
-      *etab[j].tri = 0;
-    }
-    EG_free(etab);
-    EG_free(vtab);
   }
   
   /* get the memory needed */
@@ -3403,64 +3598,20 @@ EG_fitTriangles(egObject *context, int npts, double *xyzs, int ntris,
   }
   
   /* get the parameterization & fit the surface */
-  n    = 1;
-  stat = EGADS_SUCCESS;
-  type = prm_CreateUV(0, ntris, ptris, NULL, npts, NULL, NULL, uv, pxyz,
-                      &per, &ppnts);
-  if (outLevel > 1) {
-    printf(" EG_fitTriangles: prm_CreateUV = %d  per = %d\n", type, per);
-    if (type == PRM_NOGLOBALUV) {
-      printf("                  npts = %d  ntris = %d\n", npts, ntris);
-/*    for (i = 0; i < npts; i++)
-        printf("         %d:  %lf %lf %lf\n",
-               i, xyzs[3*i  ], xyzs[3*i+1], xyzs[3*i+2]);  */
+  stat = EG_fitParam(outLevel, npts, xyzs, ntris, ptris, uv, &per, &ppnts, &n);
+  if ((stat == EGADS_SUCCESS) && (n == 4)) {
+    nu   = 2*npts;
+    nv   = 0;
+    stat = prm_BestGrid(npts, 3, uv, xyzs, ntris, ptris, tol, per, ppnts,
+                        &nu, &nv, &grid, &rmserr, &maxerr, &dotmin);
+    if (stat == PRM_TOLERANCEUNMET) {
+      printf(" EG_fitTriangles: Tolerance not met: %lf (%lf)!\n",
+             maxerr, tol);
+      stat = EGADS_SUCCESS;
     }
-  }
-  if (type > 0) {
-    n    = 2;
-    stat = prm_SmoothUV(3, per, ppnts, ntris, ptris, npts, 3, uv, xyzs);
     if (outLevel > 1)
-      printf(" EG_fitTriangles: prm_SmoothUV = %d\n", stat);
-    if (stat == EGADS_MALLOC)     stat = EGADS_SUCCESS;
-    if (stat == PRM_NOTCONVERGED) stat = EGADS_SUCCESS;
-    while ((stat != EGADS_SUCCESS) && (type < 7)) {
-      if (ppnts != NULL) EG_free(ppnts);
-      type++;
-      if (type < 6) type = 6;
-      n    = 1;
-      stat = prm_CreateUV(type, ntris, ptris, NULL, npts, NULL, NULL, uv, pxyz,
-                          &per, &ppnts);
-      if (outLevel > 1)
-        printf(" EG_fitTriangles: prm_CreateUV = %d  per = %d\n", stat, per);
-      if (stat < EGADS_SUCCESS) continue;
-      n    = 2;
-      stat = prm_SmoothUV(3, per, ppnts, ntris, ptris, npts, 3, uv, xyzs);
-      if (outLevel > 1)
-        printf(" EG_fitTriangles: prm_SmoothUV = %d\n", stat);
-      if (stat == EGADS_MALLOC)     stat = EGADS_SUCCESS;
-      if (stat == PRM_NOTCONVERGED) stat = EGADS_SUCCESS;
-    }
-    if (stat == EGADS_SUCCESS) {
-      n    = 3;
-      stat = prm_NormalizeUV(0.01, per, npts, uv);
-      if (outLevel > 1)
-        printf(" EG_fitTriangles: prm_NormalizeUV = %d\n", stat);
-      if (stat == EGADS_SUCCESS) {
-        n    = 4;
-        nu   = 2*npts;
-        nv   = 0;
-        stat = prm_BestGrid(npts, 3, uv, xyzs, ntris, ptris, tol, per, ppnts,
-                            &nu, &nv, &grid, &rmserr, &maxerr, &dotmin);
-        if (stat == PRM_TOLERANCEUNMET) {
-          printf(" EG_fitTriangles: Tolerance not met: %lf (%lf)!\n",
-                 maxerr, tol);
-          stat = EGADS_SUCCESS;
-        }
-        if (outLevel > 1)
-          printf(" EG_fitTriangles: prm_BestGrid = %d  %d %d  %lf %lf (%lf)\n",
-                 stat, nu, nv, rmserr, maxerr, tol);
-      }
-    }
+      printf(" EG_fitTriangles: prm_BestGrid = %d  %d %d  %lf %lf (%lf)\n",
+             stat, nu, nv, rmserr, maxerr, tol);
   }
   EG_free(uv);
   EG_free(ptris);
@@ -3484,4 +3635,818 @@ EG_fitTriangles(egObject *context, int npts, double *xyzs, int ntris,
   
   return stat;
 }
+
+
+/*
+ * streaming fit -- the parameterization is built on a representative
+ *                  triangulation (cell clustering of the points) and the
+ *                  fit is checked against all of the points in chunks
+ */
+
+static int
+EG_fitCellFind(fitGrid *cgrid, const double *xyz, int add)
+{
+  int          i, key[3], *rcnt;
+  unsigned int h;
+  double       *rxyz;
+  fitCell      *cells;
+
+  key[0] = (int) floor((xyz[0] - cgrid->xyz0[0])/cgrid->size);
+  key[1] = (int) floor((xyz[1] - cgrid->xyz0[1])/cgrid->size);
+  key[2] = (int) floor((xyz[2] - cgrid->xyz0[2])/cgrid->size);
+  h      = ((unsigned int) key[0]*73856093u) ^ ((unsigned int) key[1]*19349663u) ^
+           ((unsigned int) key[2]*83492791u);
+  h     &= cgrid->nhash-1;
+
+  for (;;) {
+    if (cgrid->cells[h].rep == -1) break;
+    if ((cgrid->cells[h].key[0] == key[0]) &&
+        (cgrid->cells[h].key[1] == key[1]) &&
+        (cgrid->cells[h].key[2] == key[2])) {
+      i = cgrid->cells[h].rep;
+      if (add == 1) {
+        cgrid->rxyz[3*i  ] += xyz[0];
+        cgrid->rxyz[3*i+1] += xyz[1];
+        cgrid->rxyz[3*i+2] += xyz[2];
+        cgrid->rcnt[i]++;
+      }
+      return i;
+    }
+    h = (h+1) & (cgrid->nhash-1);
+  }
+  if (add == 0) return -1;
+
+  /* new cell -- grow the tables as needed */
+  if (cgrid->nrep >= cgrid->mrep) {
+    i    = cgrid->mrep + cgrid->mrep/2 + 1024;
+    rxyz = (double *) EG_reall(cgrid->rxyz, 3*i*sizeof(double));
+    if (rxyz == NULL) return EGADS_MALLOC;
+    cgrid->rxyz = rxyz;
+    rcnt = (int *)    EG_reall(cgrid->rcnt,   i*sizeof(int));
+    if (rcnt == NULL) return EGADS_MALLOC;
+    cgrid->rcnt = rcnt;
+    cgrid->mrep = i;
+  }
+  i = cgrid->nrep;
+  cgrid->cells[h].key[0] = key[0];
+  cgrid->cells[h].key[1] = key[1];
+  cgrid->cells[h].key[2] = key[2];
+  cgrid->cells[h].rep    = i;
+  cgrid->rxyz[3*i  ]     = xyz[0];
+  cgrid->rxyz[3*i+1]     = xyz[1];
+  cgrid->rxyz[3*i+2]     = xyz[2];
+  cgrid->rcnt[i]         = 1;
+  cgrid->nrep++;
+
+  if (2*cgrid->nrep > cgrid->nhash) {
+    /* rehash */
+    cells = cgrid->cells;
+    cgrid->cells = (fitCell *) EG_alloc(2*cgrid->nhash*sizeof(fitCell));
+    if (cgrid->cells == NULL) {
+      cgrid->cells = cells;
+      return EGADS_MALLOC;
+    }
+    for (i = 0; i < 2*cgrid->nhash; i++) cgrid->cells[i].rep = -1;
+    cgrid->nhash *= 2;
+    for (i = 0; i < cgrid->nhash/2; i++) {
+      if (cells[i].rep == -1) continue;
+      h = ((unsigned int) cells[i].key[0]*73856093u) ^
+          ((unsigned int) cells[i].key[1]*19349663u) ^
+          ((unsigned int) cells[i].key[2]*83492791u);
+      h &= cgrid->nhash-1;
+      while (cgrid->cells[h].rep != -1) h = (h+1) & (cgrid->nhash-1);
+      cgrid->cells[h] = cells[i];
+    }
+    EG_free(cells);
+  }
+
+  return cgrid->nrep-1;
+}
+
+
+static int
+EG_fitEdgeComp(const void *a, const void *b)
+{
+  const int *e1 = (const int *) a;
+  const int *e2 = (const int *) b;
+
+  if (e1[0] != e2[0]) return (e1[0] < e2[0]) ? -1 : 1;
+  if (e1[1] != e2[1]) return (e1[1] < e2[1]) ? -1 : 1;
+  return 0;
+}
+
+
+/* make the reduced triangulation an oriented manifold -- drop the offending
+   triangles and keep the largest connected piece */
+
+static int
+EG_fitRepair(int nrep, int *nrt, int *rtris)
+{
+  int i, j, k, n, i0, i1, iter, nbad, ntri, *edges, *mark, *cnt, *nint, *nbnd;
+
+  ntri  = *nrt;
+  edges = (int *) EG_alloc(12*ntri*sizeof(int));
+  mark  = (int *) EG_alloc(ntri*sizeof(int));
+  cnt   = (int *) EG_alloc(3*nrep*sizeof(int));
+  if ((edges == NULL) || (mark == NULL) || (cnt == NULL)) {
+    if (cnt   != NULL) EG_free(cnt);
+    if (mark  != NULL) EG_free(mark);
+    if (edges != NULL) EG_free(edges);
+    return EGADS_MALLOC;
+  }
+  nint = &cnt[  nrep];
+  nbnd = &cnt[2*nrep];
+
+  nbad = 1;
+  for (iter = 0; iter < STREAMPASSES*2; iter++) {
+    if (ntri == 0) break;
+    for (i = 0; i < ntri; i++) {
+      mark[i] = 0;
+      for (j = 0; j < 3; j++) {
+        i0 = rtris[3*i+sides[j][0]];
+        i1 = rtris[3*i+sides[j][1]];
+        edges[12*i+4*j  ] = MIN(i0, i1);
+        edges[12*i+4*j+1] = MAX(i0, i1);
+        edges[12*i+4*j+2] = (i0 < i1) ? 1 : -1;
+        edges[12*i+4*j+3] = i;
+      }
+    }
+    qsort(edges, 3*ntri, 4*sizeof(int), EG_fitEdgeComp);
+    for (i = 0; i < 3*nrep; i++) cnt[i] = 0;
+    for (i = 0; i < 3*ntri; i++) cnt[rtris[i]]++;
+
+    /* edges: at most 2 uses with opposite senses */
+    nbad = 0;
+    for (i = 0; i < 3*ntri; i = j) {
+      for (j = i+1; j < 3*ntri; j++)
+        if (EG_fitEdgeComp(&edges[4*i], &edges[4*j]) != 0) break;
+      k = j - i;
+      if ((k > 2) || ((k == 2) && (edges[4*i+2] == edges[4*i+6]))) {
+        for (n = i; n < j; n++) mark[edges[4*n+3]] = 1;
+        nbad++;
+      } else if (k == 2) {
+        nint[edges[4*i]]++;
+        nint[edges[4*i+1]]++;
+      } else {
+        nbnd[edges[4*i]]++;
+        nbnd[edges[4*i+1]]++;
+      }
+    }
+
+    /* vertices: a single fan (only meaningful with good edges) */
+    if (nbad == 0)
+      for (i = 0; i < ntri; i++)
+        for (j = 0; j < 3; j++) {
+          n = rtris[3*i+j];
+          if (((nbnd[n] != 0) && (nbnd[n] != 2)) ||
+              (cnt[n] - nint[n] != nbnd[n]/2)) {
+            mark[i] = 1;
+            nbad++;
+          }
+        }
+    if (nbad == 0) break;
+
+    for (n = i = 0; i < ntri; i++) {
+      if (mark[i] == 1) continue;
+      rtris[3*n  ] = rtris[3*i  ];
+      rtris[3*n+1] = rtris[3*i+1];
+      rtris[3*n+2] = rtris[3*i+2];
+      n++;
+    }
+    ntri = n;
+  }
+  EG_free(cnt);
+  if ((nbad != 0) || (ntri == 0)) {
+    EG_free(mark);
+    EG_free(edges);
+    return EGADS_TOPOERR;
+  }
+
+  /* connected pieces (union-find over the shared edges) */
+  for (i = 0; i < ntri; i++) mark[i] = i;
+  for (i = 0; i < 3*ntri; i++) {
+    if (i+1 == 3*ntri) break;
+    if (EG_fitEdgeComp(&edges[4*i], &edges[4*i+4]) != 0) continue;
+    i0 = edges[4*i+3];
+    while (mark[i0] != i0) i0 = mark[i0] = mark[mark[i0]];
+    i1 = edges[4*i+7];
+    while (mark[i1] != i1) i1 = mark[i1] = mark[mark[i1]];
+    if (i0 < i1) {
+      mark[i1] = i0;
+    } else {
+      mark[i0] = i1;
+    }
+  }
+  for (i = 0; i < ntri; i++) {
+    edges[i] = 0;
+    i0 = i;
+    while (mark[i0] != i0) i0 = mark[i0];
+    mark[i] = i0;
+  }
+  for (i = 0; i < ntri; i++) edges[mark[i]]++;
+  for (k = i = 0; i < ntri; i++)
+    if (edges[i] > edges[k]) k = i;
+  for (n = i = 0; i < ntri; i++) {
+    if (mark[i] != k) continue;
+    rtris[3*n  ] = rtris[3*i  ];
+    rtris[3*n+1] = rtris[3*i+1];
+    rtris[3*n+2] = rtris[3*i+2];
+    n++;
+  }
+  *nrt = n;
+
+  EG_free(mark);
+  EG_free(edges);
+  return EGADS_SUCCESS;
+}
+
+
+/* build the representative triangulation for the current cell size */
+
+static int
+EG_fitCluster(int npts, const double *xyzs, int ntris, const int *tris,
+              fitGrid *cgrid, int *nrt, int **rtris)
+{
+  int          i, j, k, stat, r[3], nhash, mtri, ntri, *rtri, *hash, *tmp;
+  unsigned int h;
+
+  *nrt   = 0;
+  *rtris = NULL;
+
+  /* representatives */
+  for (i = 0; i < npts; i++) {
+    stat = EG_fitCellFind(cgrid, &xyzs[3*i], 1);
+    if (stat < EGADS_SUCCESS) return stat;
+  }
+  for (i = 0; i < cgrid->nrep; i++) {
+    cgrid->rxyz[3*i  ] /= cgrid->rcnt[i];
+    cgrid->rxyz[3*i+1] /= cgrid->rcnt[i];
+    cgrid->rxyz[3*i+2] /= cgrid->rcnt[i];
+  }
+
+  /* reduced triangles -- drop the collapsed ones and duplicates */
+  mtri  = 2*cgrid->nrep + 1024;
+  nhash = 1;
+  while (nhash < 2*mtri) nhash *= 2;
+  rtri = (int *) EG_alloc(3*mtri*sizeof(int));
+  hash = (int *) EG_alloc(nhash*sizeof(int));
+  if ((rtri == NULL) || (hash == NULL)) {
+    EG_free(hash);
+    EG_free(rtri);
+    return EGADS_MALLOC;
+  }
+  for (i = 0; i < nhash; i++) hash[i] = -1;
+
+  ntri = 0;
+  for (i = 0; i < ntris; i++) {
+    for (j = 0; j < 3; j++)
+      r[j] = EG_fitCellFind(cgrid, &xyzs[3*tris[3*i+j]-3], 0);
+    if ((r[0] == r[1]) || (r[1] == r[2]) || (r[0] == r[2])) continue;
+    h  = (unsigned int) (r[0]+r[1]+r[2])*2654435761u;
+    h ^= (unsigned int) MIN(r[0], MIN(r[1], r[2]))*40503u;
+    h &= nhash-1;
+    while (hash[h] != -1) {
+      k = hash[h];
+      if ((MIN(r[0],MIN(r[1],r[2])) ==
+           MIN(rtri[3*k],MIN(rtri[3*k+1],rtri[3*k+2]))) &&
+          (MAX(r[0],MAX(r[1],r[2])) ==
+           MAX(rtri[3*k],MAX(rtri[3*k+1],rtri[3*k+2]))) &&
+          (r[0]+r[1]+r[2] == rtri[3*k]+rtri[3*k+1]+rtri[3*k+2])) break;
+      h = (h+1) & (nhash-1);
+    }
+    if (hash[h] != -1) continue;
+    if (ntri >= mtri) {
+      k   = mtri + mtri/2;
+      tmp = (int *) EG_reall(rtri, 3*k*sizeof(int));
+      if (tmp == NULL) {
+        EG_free(hash);
+        EG_free(rtri);
+        return EGADS_MALLOC;
+      }
+      rtri = tmp;
+      mtri = k;
+    }
+    if (2*ntri >= nhash) {
+      /* rehash */
+      EG_free(hash);
+      nhash *= 2;
+      hash   = (int *) EG_alloc(nhash*sizeof(int));
+      if (hash == NULL) {
+        EG_free(rtri);
+        return EGADS_MALLOC;
+      }
+      for (k = 0; k < nhash; k++) hash[k] = -1;
+      for (k = 0; k <= ntri; k++) {
+        if (k == ntri) {
+          rtri[3*k  ] = r[0];
+          rtri[3*k+1] = r[1];
+          rtri[3*k+2] = r[2];
+        }
+        h  = (unsigned int) (rtri[3*k]+rtri[3*k+1]+rtri[3*k+2])*2654435761u;
+        h ^= (unsigned int) MIN(rtri[3*k],MIN(rtri[3*k+1],rtri[3*k+2]))*40503u;
+        h &= nhash-1;
+        while (hash[h] != -1) h = (h+1) & (nhash-1);
+        hash[h] = k;
+      }
+      ntri++;
+      continue;
+    }
+    hash[h]       = ntri;
+    rtri[3*ntri  ] = r[0];
+    rtri[3*ntri+1] = r[1];
+    rtri[3*ntri+2] = r[2];
+    ntri++;
+  }
+  EG_free(hash);
+
+  if (ntri == 0) {
+    EG_free(rtri);
+    return EGADS_DEGEN;
+  }
+  *rtris = rtri;
+  stat   = EG_fitRepair(cgrid->nrep, &ntri, rtri);
+  if (stat != EGADS_SUCCESS) return stat;
+  *nrt   = ntri;
+
+  /* drop the representatives not used by a triangle */
+  tmp = (int *) EG_alloc(cgrid->nrep*sizeof(int));
+  if (tmp == NULL) return EGADS_MALLOC;
+  for (i = 0; i < cgrid->nrep; i++) tmp[i] = -1;
+  for (i = 0; i < 3*ntri; i++) tmp[rtri[i]] = 0;
+  for (k = i = 0; i < cgrid->nrep; i++) {
+    if (tmp[i] == -1) continue;
+    cgrid->rxyz[3*k  ] = cgrid->rxyz[3*i  ];
+    cgrid->rxyz[3*k+1] = cgrid->rxyz[3*i+1];
+    cgrid->rxyz[3*k+2] = cgrid->rxyz[3*i+2];
+    cgrid->rcnt[k]     = cgrid->rcnt[i];
+    tmp[i]             = k++;
+  }
+  for (i = 0; i < 3*ntri; i++) rtri[i] = tmp[rtri[i]];
+  for (i = 0; i < cgrid->nhash; i++) {
+    if (cgrid->cells[i].rep < 0) continue;
+    cgrid->cells[i].rep = tmp[cgrid->cells[i].rep];
+    /* still occupied (for probing) but without a representative */
+    if (cgrid->cells[i].rep == -1) cgrid->cells[i].rep = -2;
+  }
+  cgrid->nrep = k;
+  EG_free(tmp);
+
+  return EGADS_SUCCESS;
+}
+
+
+/* find the parameters of a point from the fan of its representative */
+
+static int
+EG_fitProject(EMPfit *fit, const double *xyz, prmUV *uv)
+{
+  int    i, j, r, *t;
+  double d, dmin, a, w[3], u[3], v[3], e0[3], e1[3], e2[3], *p0, *p1, *p2;
+
+  r = EG_fitCellFind(fit->cgrid, xyz, 0);
+  if (r < 0) return EGADS_NOTFOUND;
+
+  dmin = -1.0;
+  for (j = fit->ftri[r]; j < fit->ftri[r+1]; j++) {
+    t  = &fit->rtris[3*fit->jtri[j]];
+    p0 = &fit->cgrid->rxyz[3*t[0]];
+    p1 = &fit->cgrid->rxyz[3*t[1]];
+    p2 = &fit->cgrid->rxyz[3*t[2]];
+    for (i = 0; i < 3; i++) {
+      e0[i] = p1[i] - p0[i];
+      e1[i] = p2[i] - p0[i];
+      e2[i] = xyz[i] - p0[i];
+    }
+    a = DOT(e0,e0)*DOT(e1,e1) - DOT(e0,e1)*DOT(e0,e1);
+    if (a <= 0.0) continue;
+    w[1] = (DOT(e1,e1)*DOT(e2,e0) - DOT(e0,e1)*DOT(e2,e1))/a;
+    w[2] = (DOT(e0,e0)*DOT(e2,e1) - DOT(e0,e1)*DOT(e2,e0))/a;
+    w[0] = 1.0 - w[1] - w[2];
+    if ((w[0] < 0.0) || (w[1] < 0.0) || (w[2] < 0.0)) {
+      w[0] = MAX(w[0], 0.0);
+      w[1] = MAX(w[1], 0.0);
+      w[2] = MAX(w[2], 0.0);
+      a    = w[0] + w[1] + w[2];
+      w[0] /= a;
+      w[1] /= a;
+      w[2] /= a;
+    }
+    d = 0.0;
+    for (i = 0; i < 3; i++) {
+      a  = w[0]*p0[i] + w[1]*p1[i] + w[2]*p2[i] - xyz[i];
+      d += a*a;
+    }
+    if ((dmin >= 0.0) && (d >= dmin)) continue;
+    dmin = d;
+    for (i = 0; i < 3; i++) {
+      u[i] = fit->ruv[t[i]].u;
+      v[i] = fit->ruv[t[i]].v;
+    }
+    /* a Triangle across the seam -- unwrap it to the high side */
+    if (fit->per == 1) {
+      a = MAX(MAX(u[0], u[1]), u[2]);
+      for (i = 0; i < 3; i++) if (a-u[i] > 0.5) u[i] += 1.0;
+    } else if (fit->per == 2) {
+      a = MAX(MAX(v[0], v[1]), v[2]);
+      for (i = 0; i < 3; i++) if (a-v[i] > 0.5) v[i] += 1.0;
+    }
+    uv->u = w[0]*u[0] + w[1]*u[1] + w[2]*u[2];
+    uv->v = w[0]*v[0] + w[1]*v[1] + w[2]*v[2];
+    if ((fit->per == 1) && (uv->u > 1.0)) uv->u -= 1.0;
+    if ((fit->per == 2) && (uv->v > 1.0)) uv->v -= 1.0;
+  }
+  if (dmin < 0.0) return EGADS_NOTFOUND;
+
+  return EGADS_SUCCESS;
+}
+
+
+/* refine the parameters of a point against the current fit (Gauss-Newton) */
+
+static void
+EG_fitInvert(EMPfit *fit, const double *xyz, prmUV *uv, double *pnt)
+{
+  int    i, it;
+  double a, b, c, r0, r1, det, d[3], du[3], dv[3];
+
+  for (it = 0; it < 4; it++) {
+    prm_EvalGrid(fit->tree, *uv, pnt, du, dv, NULL, NULL, NULL);
+    for (i = 0; i < 3; i++) d[i] = xyz[i] - pnt[i];
+    a   = DOT(du,du);
+    b   = DOT(du,dv);
+    c   = DOT(dv,dv);
+    r0  = DOT(du,d);
+    r1  = DOT(dv,d);
+    det = a*c - b*b;
+    if (det <= 0.0) return;
+    uv->u += (c*r0 - b*r1)/det;
+    uv->v += (a*r1 - b*r0)/det;
+    if (fit->per == 1) {
+      uv->u -= floor(uv->u);
+    } else {
+      uv->u  = MIN(MAX(uv->u, 0.0), 1.0);
+    }
+    if (fit->per == 2) {
+      uv->v -= floor(uv->v);
+    } else {
+      uv->v  = MIN(MAX(uv->v, 0.0), 1.0);
+    }
+  }
+  prm_EvalGrid(fit->tree, *uv, pnt, NULL, NULL, NULL, NULL, NULL);
+}
+
+
+static void
+EG_fitStreamThread(void *struc)
+{
+  int    i, j, index, ilo, ihi, rank;
+  long   ID;
+  double err, e, xyz[3];
+  prmUV  uv;
+  EMPfit *fit;
+
+  fit = (EMPfit *) struc;
+
+  /* get our identifier */
+  ID = EMP_ThreadID();
+
+  /* look for work */
+  for (;;) {
+
+    /* only one thread at a time here -- controlled by a mutex! */
+    if (fit->mutex != NULL) EMP_LockSet(fit->mutex);
+    index = fit->index;
+    fit->index++;
+    if (fit->mutex != NULL) EMP_LockRelease(fit->mutex);
+
+    if (index >= fit->nchunk) break;
+    ilo = index*STREAMCHUNK;
+    ihi = MIN(ilo+STREAMCHUNK, fit->npts);
+
+    /* do the work */
+    rank = 0;
+    if (fit->mode == 0) {
+      fit->nover[index] = fit->nskip[index] = 0;
+      fit->emax[index]  = fit->esum[index]  = 0.0;
+    } else {
+      rank = fit->nover[index];
+    }
+    for (i = ilo; i < ihi; i++) {
+      if (EG_fitProject(fit, &fit->xyzs[3*i], &uv) != EGADS_SUCCESS) {
+        if (fit->mode == 0) fit->nskip[index]++;
+        continue;
+      }
+      EG_fitInvert(fit, &fit->xyzs[3*i], &uv, xyz);
+      err = 0.0;
+      for (j = 0; j < 3; j++) {
+        e = fabs(fit->xyzs[3*i+j] - xyz[j]);
+        if (e > err) err = e;
+        if (fit->mode == 0) fit->esum[index] += e*e;
+      }
+      if ((fit->mode == 0) && (err > fit->emax[index])) fit->emax[index] = err;
+      if (err <= fit->tol) continue;
+      if (fit->mode == 0) {
+        fit->nover[index]++;
+      } else {
+        if (rank%fit->stride == 0) {
+          j = rank/fit->stride;
+          fit->axyz[3*j  ] = fit->xyzs[3*i  ];
+          fit->axyz[3*j+1] = fit->xyzs[3*i+1];
+          fit->axyz[3*j+2] = fit->xyzs[3*i+2];
+          fit->auv[j]      = uv;
+        }
+        rank++;
+      }
+    }
+  }
+
+  /* exhausted all work -- exit */
+  if (ID != fit->master) EMP_ThreadExit();
+}
+
+
+static void
+EG_fitStreamPass(int np, EMPfit *fit, int mode)
+{
+  int  i;
+  void **threads = NULL;
+
+  fit->mode   = mode;
+  fit->index  = 0;
+  fit->mutex  = NULL;
+  fit->master = EMP_ThreadID();
+  np          = MIN(np, fit->nchunk);
+  if (np > 1) {
+    fit->mutex = EMP_LockCreate();
+    if (fit->mutex != NULL) {
+      threads = (void **) malloc((np-1)*sizeof(void *));
+      if (threads == NULL) {
+        EMP_LockDestroy(fit->mutex);
+        fit->mutex = NULL;
+      }
+    }
+  }
+  if (threads != NULL)
+    for (i = 0; i < np-1; i++)
+      threads[i] = EMP_ThreadCreate(EG_fitStreamThread, fit);
+
+  /* now run the thread block from the original thread */
+  EG_fitStreamThread(fit);
+
+  /* wait for all others to return and cleanup */
+  if (threads != NULL) {
+    for (i = 0; i < np-1; i++)
+      if (threads[i] != NULL) EMP_ThreadWait(threads[i]);
+    for (i = 0; i < np-1; i++)
+      if (threads[i] != NULL) EMP_ThreadDestroy(threads[i]);
+    free(threads);
+  }
+  if (fit->mutex != NULL) EMP_LockDestroy(fit->mutex);
+  fit->mutex = NULL;
+}
+
+
+int
+EG_fitTrianglesStream(egObject *context, int npts, const double *xyzs,
+                      int ntris, const int *tris, int maxpts, double tol,
+                      egObject **bspline)
+{
+  int     i, j, n, outLevel, stat, nu, nv, per, sizes[2], *ppnts = NULL;
+  int     np, pass, round, nrt, nact, cap, nadd, nover, nskip, unmet;
+  int     *rtris = NULL;
+  double  rmserr, maxerr, dotmin, area, emax, esum, d1[3], d2[3], nrm[3];
+  double  *grid = NULL, *axyz = NULL;
+  prmTri  *ptris = NULL;
+  prmUV   *auv   = NULL;
+  fitGrid cgrid;
+  EMPfit  fit;
+
+  *bspline = NULL;
+  if (context == NULL)               return EGADS_NULLOBJ;
+  if (context->magicnumber != MAGIC) return EGADS_NOTOBJ;
+  if (context->oclass != CONTXT)     return EGADS_NOTCNTX;
+  if (EG_sameThread(context))        return EGADS_CNTXTHRD;
+  if ((ntris <= 0) || (npts <= 0))   return EGADS_EMPTY;
+  outLevel = EG_outLevel(context);
+  if (maxpts <= 0) maxpts = STREAMPTS;
+
+  /* small enough to do directly */
+  if (npts <= maxpts)
+    return EG_fitTriangles(context, npts, (double *) xyzs, ntris, tris, NULL,
+                           tol, bspline);
+
+  /* validate & get the bounding box and surface area */
+  cgrid.xyz0[0] = cgrid.xyz0[1] = cgrid.xyz0[2] = DBL_MAX;
+  for (i = 0; i < npts; i++)
+    for (j = 0; j < 3; j++)
+      if (xyzs[3*i+j] < cgrid.xyz0[j]) cgrid.xyz0[j] = xyzs[3*i+j];
+  area = 0.0;
+  for (i = 0; i < ntris; i++) {
+    if ((tris[3*i  ] < 1) || (tris[3*i  ] > npts) ||
+        (tris[3*i+1] < 1) || (tris[3*i+1] > npts) ||
+        (tris[3*i+2] < 1) || (tris[3*i+2] > npts)) {
+      if (outLevel > 0) {
+        printf(" EGADS Warning: %d bad tris [1-%d] (EG_fitTrianglesStream)!\n",
+               i+1, npts);
+        printf("                tris = %d %d %d\n",
+               tris[3*i  ], tris[3*i+1], tris[3*i+2]);
+      }
+      return EGADS_INDEXERR;
+    }
+    for (j = 0; j < 3; j++) {
+      d1[j] = xyzs[3*tris[3*i+1]+j-3] - xyzs[3*tris[3*i]+j-3];
+      d2[j] = xyzs[3*tris[3*i+2]+j-3] - xyzs[3*tris[3*i]+j-3];
+    }
+    CROSS(nrm, d1, d2);
+    area += 0.5*sqrt(DOT(nrm, nrm));
+  }
+  if (area <= 0.0) return EGADS_DEGEN;
+
+  cgrid.nhash = 1;
+  while (cgrid.nhash < 4*maxpts) cgrid.nhash *= 2;
+  cgrid.nrep  = cgrid.mrep = 0;
+  cgrid.rxyz  = NULL;
+  cgrid.rcnt  = NULL;
+  cgrid.cells = (fitCell *) EG_alloc(cgrid.nhash*sizeof(fitCell));
+  if (cgrid.cells == NULL) return EGADS_MALLOC;
+  fit.tree.cell = NULL;
+  fit.tree.knot = NULL;
+  fit.ftri      = NULL;
+  fit.jtri      = NULL;
+  fit.nover     = NULL;
+  fit.emax      = NULL;
+  n             = 0;
+  unmet         = 0;
+  emax          = 0.0;
+
+  /* representative triangulation -- shrink the cells until it is valid */
+  cgrid.size = sqrt(area/maxpts);
+  for (pass = 0; pass < STREAMPASSES; pass++) {
+    for (i = 0; i < cgrid.nhash; i++) cgrid.cells[i].rep = -1;
+    cgrid.nrep = 0;
+    stat = EG_fitCluster(npts, xyzs, ntris, tris, &cgrid, &nrt, &rtris);
+    if (outLevel > 1)
+      printf(" EG_fitTrianglesStream: cell = %le  nrep = %d  ntri = %d  stat = %d\n",
+             cgrid.size, cgrid.nrep, nrt, stat);
+    if (stat != EGADS_TOPOERR) break;
+    EG_free(rtris);
+    rtris      = NULL;
+    cgrid.size /= 1.5;
+  }
+  if (stat != EGADS_SUCCESS) {
+    if (outLevel > 0)
+      printf(" EGADS Warning: Representative Triangulation = %d (EG_fitTrianglesStream)!\n",
+             stat);
+    goto cleanup;
+  }
+
+  /* the representatives start the active set */
+  cap  = MAX(maxpts/4, 1);
+  ptris = (prmTri *) EG_alloc(nrt*sizeof(prmTri));
+  axyz  = (double *) EG_alloc(3*(cgrid.nrep+STREAMROUNDS*cap)*sizeof(double));
+  auv   = (prmUV *)  EG_alloc(  (cgrid.nrep+STREAMROUNDS*cap)*sizeof(prmUV));
+  if ((ptris == NULL) || (axyz == NULL) || (auv == NULL)) {
+    stat = EGADS_MALLOC;
+    goto cleanup;
+  }
+  for (i = 0; i < nrt; i++) {
+    ptris[i].own        = 1;
+    ptris[i].indices[0] = rtris[3*i  ] + 1;
+    ptris[i].indices[1] = rtris[3*i+1] + 1;
+    ptris[i].indices[2] = rtris[3*i+2] + 1;
+    ptris[i].neigh[0]   = ptris[i].neigh[1] = ptris[i].neigh[2] = i+1;
+  }
+  stat = EG_fitNeighbors(cgrid.nrep, nrt, ptris);
+  if (stat != EGADS_SUCCESS) goto cleanup;
+  nact = cgrid.nrep;
+  for (i = 0; i < 3*nact; i++) axyz[i] = cgrid.rxyz[i];
+
+  /* get the parameterization */
+  stat = EG_fitParam(outLevel, nact, axyz, nrt, ptris, auv, &per, &ppnts, &n);
+  if ((stat != EGADS_SUCCESS) || (n != 4)) goto cleanup;
+
+  /* the Triangles at each representative */
+  fit.ftri = (int *) EG_alloc((nact+1)*sizeof(int));
+  fit.jtri = (int *) EG_alloc(3*nrt*sizeof(int));
+  if ((fit.ftri == NULL) || (fit.jtri == NULL)) {
+    stat = EGADS_MALLOC;
+    goto cleanup;
+  }
+  for (i = 0; i <= nact;  i++) fit.ftri[i] = 0;
+  for (i = 0; i < 3*nrt; i++) fit.ftri[rtris[i]+1]++;
+  for (i = 0; i <  nact;  i++) fit.ftri[i+1] += fit.ftri[i];
+  for (i = 0; i < 3*nrt; i++) fit.jtri[fit.ftri[rtris[i]]++] = i/3;
+  for (i = nact; i > 0; i--) fit.ftri[i] = fit.ftri[i-1];
+  fit.ftri[0] = 0;
+
+  /* set up the chunked passes over all of the points */
+  fit.npts   = npts;
+  fit.xyzs   = xyzs;
+  fit.tol    = tol;
+  fit.per    = per;
+  fit.cgrid  = &cgrid;
+  fit.rtris  = rtris;
+  fit.ruv    = auv;
+  fit.nchunk = (npts + STREAMCHUNK - 1)/STREAMCHUNK;
+  fit.stride = 1;
+  fit.nover  = (int *)    EG_alloc(2*fit.nchunk*sizeof(int));
+  fit.emax   = (double *) EG_alloc(2*fit.nchunk*sizeof(double));
+  if ((fit.nover == NULL) || (fit.emax == NULL)) {
+    stat = EGADS_MALLOC;
+    goto cleanup;
+  }
+  fit.nskip = &fit.nover[fit.nchunk];
+  fit.esum  = &fit.emax[fit.nchunk];
+  np        = EMP_Init(NULL);
+
+  /* fit the active set & add the worst points until all are in tolerance */
+  for (round = 0; ; round++) {
+    prm_FreeGrid(&fit.tree);
+    if (grid != NULL) EG_free(grid);
+    grid = NULL;
+    n    = 4;
+    nu   = 2*nact;
+    nv   = 0;
+    stat = prm_BestGridTree(nact, 3, auv, axyz, nrt, ptris, tol, per, ppnts,
+                            &nu, &nv, &grid, &rmserr, &maxerr, &dotmin,
+                            &fit.tree);
+    unmet = 0;
+    if (stat == PRM_TOLERANCEUNMET) {
+      unmet = 1;
+      stat  = EGADS_SUCCESS;
+    }
+    if (outLevel > 1)
+      printf(" EG_fitTrianglesStream: prm_BestGrid = %d  %d %d  %lf %lf (%lf)  nact = %d\n",
+             stat, nu, nv, rmserr, maxerr, tol, nact);
+    emax = maxerr;
+    if (stat != EGADS_SUCCESS) break;
+
+    /* check all of the points */
+    EG_fitStreamPass(np, &fit, 0);
+    nover = nskip = 0;
+    emax  = esum  = 0.0;
+    for (i = 0; i < fit.nchunk; i++) {
+      nover += fit.nover[i];
+      nskip += fit.nskip[i];
+      esum  += fit.esum[i];
+      if (fit.emax[i] > emax) emax = fit.emax[i];
+    }
+    if (outLevel > 1)
+      printf(" EG_fitTrianglesStream: round %d  over = %d  skip = %d  rms = %lf  max = %lf\n",
+             round, nover, nskip, sqrt(esum/(3.0*MAX(npts-nskip, 1))), emax);
+    if ((nover == 0) || (unmet == 1) || (round == STREAMROUNDS)) break;
+
+    /* add an even sampling of the points that are out of tolerance */
+    fit.stride = (nover + cap - 1)/cap;
+    nadd       = (nover + fit.stride - 1)/fit.stride;
+    for (j = i = 0; i < fit.nchunk; i++) {
+      n            = fit.nover[i];
+      fit.nover[i] = j;
+      j           += n;
+    }
+    fit.axyz = &axyz[3*nact];
+    fit.auv  = &auv[nact];
+    EG_fitStreamPass(np, &fit, 1);
+    nact += nadd;
+  }
+  if ((stat == EGADS_SUCCESS) && ((unmet == 1) || (emax > tol))) {
+    printf(" EG_fitTrianglesStream: Tolerance not met: %lf (%lf)!\n",
+           emax, tol);
+  }
+
+cleanup:
+  prm_FreeGrid(&fit.tree);
+  if (fit.emax  != NULL) EG_free(fit.emax);
+  if (fit.nover != NULL) EG_free(fit.nover);
+  if (fit.jtri  != NULL) EG_free(fit.jtri);
+  if (fit.ftri  != NULL) EG_free(fit.ftri);
+  if (ppnts     != NULL) EG_free(ppnts);
+  if (auv       != NULL) EG_free(auv);
+  if (axyz      != NULL) EG_free(axyz);
+  if (ptris     != NULL) EG_free(ptris);
+  if (rtris     != NULL) EG_free(rtris);
+  if (cgrid.rcnt != NULL) EG_free(cgrid.rcnt);
+  if (cgrid.rxyz != NULL) EG_free(cgrid.rxyz);
+  EG_free(cgrid.cells);
+  if ((stat != EGADS_SUCCESS) || (grid == NULL)) {
+    if (grid != NULL) EG_free(grid);
+    if (stat == EGADS_SUCCESS) stat = EGADS_CONSTERR;
+    if (outLevel > 0)
+      printf(" EGADS Warning: Create/Smooth/Normalize/BestGrid %d = %d (EG_fitTrianglesStream)!\n",
+             n, stat);
+    return stat;
+  }
+
+  /* make the surface */
+  sizes[0] = sizes[1] = 0;
+#ifndef __clang_analyzer__
+  sizes[0] = nu;
+  sizes[1] = nv;
+#endif
+  stat = EG_approximate(context, 0, tol, sizes, grid, bspline);
+  EG_free(grid);
+
+  return stat;
+}
+
 #endif
@@ -127,6 +127,14 @@
     short mark;                 /* is this segment marked? */
   } Front;
   
+  typedef struct {
+    int next[2];                /* next segment at the same left/right vertex */
+    int prev[2];                /* previous segment at the same vertex */
+    int vert[2];                /* vertices the segment is listed under */
+    int lng;                    /* position in the long segment list */
+    int list;                   /* long segment list entry */
+  } FrontLink;
+  
   typedef struct {
     int    mfront;
     int    nfront;
@@ -136,6 +144,14 @@
     int    nsegs;
     int   *segs;
     Front *front;
+    int    ngrid[2];            /* front index -- cells in u & v (0 off) */
+    int    nlong[2];            /* long original & new segments */
+    double gbox[3];             /* index origin & cell size */
+    int    mgrid;
+    int   *grid;                /* cell starts & vertices, left & right
+                                   vertex heads, long original segments */
+    int    mlink;
+    FrontLink *link;
   } fillArea;
 
   typedef struct {
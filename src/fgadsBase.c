@@ -29,6 +29,7 @@
   extern int  EG_setOutLevel(egObject *context, int outLevel);
   extern int  EG_setFixedKnots(egObject *context, int fixed);
   extern int  EG_setFullAttrs(egObject *context, int full);
+  extern int  EG_setFastClose(egObject *context, int fast);
   extern int  EG_setTessParam(egObject *context, int iParam, double value,
                              double *oldValue);
   extern int  EG_getContext(egObject *object, egObject **context);
@@ -212,6 +213,20 @@ ig_setfullattrs_(INT8 *cntxt, int *out)
 }
 
 
+int
+#ifdef WIN32
+IG_SETFASTCLOSE (INT8 *cntxt, int *out)
+#else
+ig_setfastclose_(INT8 *cntxt, int *out)
+#endif
+{
+  egObject *context;
+
+  context = (egObject *) *cntxt;
+  return EG_setFastClose(context, *out);
+}
+
+
 int
 #ifdef WIN32
 IG_SETTESSPARAM (INT8 *cntxt, int *iparam, double *val, double *oldval)
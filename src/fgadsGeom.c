@@ -33,11 +33,26 @@
                                  double *param, double *results);
   extern int EG_arcLength(const egObject *geom, double t1, double t2,
                           double *alen);
+  extern int EG_invArcLength(const egObject *geom, double t1, double alen,
+                             double *t);
+  extern int EG_arcLengthBatch(const egObject *geom, double t1, int n,
+                               const double *ts, double *alens);
+  extern int EG_invArcLengthBatch(const egObject *geom, double t1, int n,
+                                  const double *alens, double *ts);
+  extern int EG_arcLength_dot(const egObject *geom, double t1, double t1_dot,
+                              double t2, double t2_dot, double *alen,
+                              double *alen_dot);
+  extern int EG_invArcLength_dot(const egObject *geom, double t1,
+                                 double t1_dot, double alen, double alen_dot,
+                                 double *t, double *t_dot);
   extern int EG_curvature(const egObject *geom, const double *param,
                           double *crva);
   extern int EG_approximate(egObject *context, int maxdeg, double tol,
                             const int *sizes, const double *xyzs, 
                             egObject **bspline);
+  extern int EG_approximateBatch(egObject *context, int maxdeg, double tol,
+                                 int nfit, const int *sizes,
+                                 const double **xyzs, egObject **bsplines);
   extern int EG_otherCurve(const egObject *surface, const egObject *curve, 
                            double tol, egObject **newcrv);
   extern int EG_isoCline(const egObject *surface, int iUV, double value, 
@@ -166,6 +181,80 @@ ig_arclength_(INT8 *obj, double *t1, double *t2, double *alen)
 }
 
 
+int
+#ifdef WIN32
+IG_INVARCLENGTH (INT8 *obj, double *t1, double *alen, double *t)
+#else
+ig_invarclength_(INT8 *obj, double *t1, double *alen, double *t)
+#endif
+{
+  egObject *object;
+  
+  object = (egObject *) *obj;
+  return EG_invArcLength(object, *t1, *alen, t);
+}
+
+
+int
+#ifdef WIN32
+IG_ARCLENGTHBATCH (INT8 *obj, double *t1, int *n, double *ts, double *alens)
+#else
+ig_arclengthbatch_(INT8 *obj, double *t1, int *n, double *ts, double *alens)
+#endif
+{
+  egObject *object;
+  
+  object = (egObject *) *obj;
+  return EG_arcLengthBatch(object, *t1, *n, ts, alens);
+}
+
+
+int
+#ifdef WIN32
+IG_INVARCLENGTHBATCH (INT8 *obj, double *t1, int *n, double *alens, double *ts)
+#else
+ig_invarclengthbatch_(INT8 *obj, double *t1, int *n, double *alens, double *ts)
+#endif
+{
+  egObject *object;
+  
+  object = (egObject *) *obj;
+  return EG_invArcLengthBatch(object, *t1, *n, alens, ts);
+}
+
+
+int
+#ifdef WIN32
+IG_ARCLENGTH_DOT (INT8 *obj, double *t1, double *t1_dot, double *t2,
+                  double *t2_dot, double *alen, double *alen_dot)
+#else
+ig_arclength_dot_(INT8 *obj, double *t1, double *t1_dot, double *t2,
+                  double *t2_dot, double *alen, double *alen_dot)
+#endif
+{
+  egObject *object;
+  
+  object = (egObject *) *obj;
+  return EG_arcLength_dot(object, *t1, *t1_dot, *t2, *t2_dot, alen, alen_dot);
+}
+
+
+int
+#ifdef WIN32
+IG_INVARCLENGTH_DOT (INT8 *obj, double *t1, double *t1_dot, double *alen,
+                     double *alen_dot, double *t, double *t_dot)
+#else
+ig_invarclength_dot_(INT8 *obj, double *t1, double *t1_dot, double *alen,
+                     double *alen_dot, double *t, double *t_dot)
+#endif
+{
+  egObject *object;
+  
+  object = (egObject *) *obj;
+  return EG_invArcLength_dot(object, *t1, *t1_dot, *alen, *alen_dot, t, t_dot);
+}
+
+
 int
 #ifdef WIN32
 IG_CURVATURE (INT8 *obj, double *param, double *crva)
@@ -200,6 +289,48 @@ ig_approximate_(INT8 *cntx, int *maxdeg, double *tol, const int *size,
 }
 
 
+/* the point sets are packed one after the other in xyzs */
+int
+#ifdef WIN32
+IG_APPROXIMATEBATCH (INT8 *cntx, int *maxdeg, double *tol, int *nfit,
+                     const int *sizes, const double *xyzs, INT8 *igeoms)
+#else
+ig_approximatebatch_(INT8 *cntx, int *maxdeg, double *tol, int *nfit,
+                     const int *sizes, const double *xyzs, INT8 *igeoms)
+#endif
+{
+  int          i, n, stat;
+  const double **data;
+  egObject     *context, **geoms;
+
+  if (*nfit <= 0) return EGADS_RANGERR;
+  for (i = 0; i < *nfit; i++) igeoms[i] = 0;
+  context = (egObject *) *cntx;
+  data    = (const double **) EG_alloc(*nfit*sizeof(double *));
+  geoms   = (egObject **)     EG_alloc(*nfit*sizeof(egObject *));
+  if ((data == NULL) || (geoms == NULL)) {
+    if (geoms != NULL) EG_free(geoms);
+    if (data  != NULL) EG_free(data);
+    return EGADS_MALLOC;
+  }
+  for (n = i = 0; i < *nfit; i++) {
+    data[i] = &xyzs[n];
+    if (sizes[2*i+1] <= 0) {
+      n += 3*sizes[2*i];
+    } else {
+      n += 3*sizes[2*i]*sizes[2*i+1];
+    }
+  }
+  stat = EG_approximateBatch(context, *maxdeg, *tol, *nfit, sizes, data,
+                             geoms);
+  if (stat == EGADS_SUCCESS)
+    for (i = 0; i < *nfit; i++) igeoms[i] = (INT8) geoms[i];
+  EG_free(geoms);
+  EG_free(data);
+  return stat;
+}
+
+
 int
 #ifdef WIN32
 IG_OTHERCURVE (INT8 *isurf, INT8 *icrv, double *tol, INT8 *igeom)
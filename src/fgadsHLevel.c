@@ -21,11 +21,17 @@
                            egObject **sheet);
   extern int EG_generalBoolean(egObject *src, egObject *tool, int oper,
                                double tol, egObject **model);
+  extern int EG_clusterBoolean(egObject *src, egObject *tool, int oper,
+                               double tol, egObject **model);
   extern int EG_solidBoolean(const egObject *src, const egObject *tool,
                              int oper, egObject **model);
   extern int EG_intersection(const egObject *src, const egObject *tool,
                              int *nedge, /*@null@*/ egObject ***facEdg,
                              egObject **model);
+  extern int EG_intersectionBatch(const egObject *src, int ntool,
+                                  const egObject **tools, int *nedge,
+                                  /*@null@*/ egObject ***facEdg,
+                                  egObject **model);
   extern int EG_imprintBody(const egObject *src, int nedge, 
                             egObject **facEdg, egObject **result);
   extern int EG_filletBody(const egObject *src, int nedge, 
@@ -91,6 +97,27 @@ ig_generalboolean_(INT8 *isrc, INT8 *itool, int *oper, double *tol,
 }
 
 
+int
+#ifdef WIN32
+IG_CLUSTERBOOLEAN (INT8 *isrc, INT8 *itool, int *oper, double *tol,
+                   INT8 *imodel)
+#else
+ig_clusterboolean_(INT8 *isrc, INT8 *itool, int *oper, double *tol,
+                   INT8 *imodel)
+#endif
+{
+  int      stat;
+  egObject *src, *tool, *model;
+  
+  *imodel = 0;
+  src     = (egObject *) *isrc;
+  tool    = (egObject *) *itool;
+  stat    = EG_clusterBoolean(src, tool, *oper, *tol, &model);
+  if (stat == EGADS_SUCCESS) *imodel = (INT8) model;
+  return stat;
+}
+
+
 int
 #ifdef WIN32
 IG_SOLIDBOOLEAN (INT8 *isrc, INT8 *itool, int *oper, INT8 *imodel)
@@ -142,6 +169,45 @@ ig_intersection_(INT8 *isrc, INT8 *itool, int *nedge,
 }
 
 
+int
+#ifdef WIN32
+IG_INTERSECTIONBATCH (INT8 *isrc, int *ntool, INT8 *itools, int *nedge,
+                      INT8 **facedg8, INT8 *imodel)
+#else
+ig_intersectionbatch_(INT8 *isrc, int *ntool, INT8 *itools, int *nedge,
+                      INT8 **facedg8, INT8 *imodel)
+#endif
+{
+  int      i, stat;
+  INT8     *cobjs;
+  egObject *src, *model, **facEdg, **tools;
+  
+  *nedge  = 0;
+  *imodel = 0;
+  if (*ntool <= 0) return EGADS_RANGERR;
+  src   = (egObject *) *isrc;
+  tools = (egObject **) EG_alloc(*ntool*sizeof(egObject *));
+  if (tools == NULL) return EGADS_MALLOC;
+  for (i = 0; i < *ntool; i++)
+    tools[i] = (egObject *) itools[i];
+
+  stat = EG_intersectionBatch(src, *ntool, (const egObject **) tools, nedge,
+                              &facEdg, &model);
+  EG_free(tools);
+  if (stat == EGADS_SUCCESS) {
+    *facedg8 = cobjs = (INT8 *) EG_alloc(*nedge*2*sizeof(INT8));
+    if (cobjs == NULL) {
+      EG_free(facEdg);
+      return EGADS_MALLOC;
+    }
+    for (i = 0; i < *nedge*2; i++) cobjs[i] = (INT8) facEdg[i];
+    EG_free(facEdg);
+    *imodel = (INT8) model;
+  }
+  return stat;
+}
+
+
 int
 #ifdef WIN32
 IG_IMPRINTBODY (INT8 *isrc, int *nedge, INT8 *facEdg, INT8 *irslt)
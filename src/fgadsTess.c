@@ -44,6 +44,8 @@
 
   extern int  EG_getTessQuads(const egObject *tess, int *nquad, int **fIndices);
   extern int  EG_makeQuads(egObject *tess, double *params, int fIndex);
+  extern int  EG_makeQuadsBatch(egObject *tess, double *params, int nIndex,
+                                const int *fIndices);
   extern int  EG_getQuads(const egObject *tess, int fIndex, int *len,
                           const double **xyz, const double **uv,
                           const int **ptype, const int **pindex, int *npatch);
@@ -55,6 +57,9 @@
                                  int npts, double *t);
   extern int  EG_deleteEdgeVert(egObject *tess, int eIndex, int vIndex, int dir);
   extern int  EG_moveEdgeVert(egObject *tess, int eIndex, int vIndex, double t);
+  extern int  EG_beginEdgeEdits(egObject *tess);
+  extern int  EG_commitEdgeEdits(egObject *tess);
+  extern int  EG_abortEdgeEdits(egObject *tess);
 
   extern int  EG_openTessBody(egObject *tess);
   extern int  EG_initTessBody(egObject *object, egObject **tess);
@@ -292,6 +297,21 @@ ig_makequads_(INT8 *obj, double *parms, int *fIndex)
 }
 
 
+int
+#ifdef WIN32
+IG_MAKEQUADSBATCH (INT8 *obj, double *parms, int *nIndex, int *fIndices)
+#else
+ig_makequadsbatch_(INT8 *obj, double *parms, int *nIndex, int *fIndices)
+#endif
+{
+  egObject *object;
+
+  object = (egObject *) *obj;
+  if (*nIndex == 0) return EG_makeQuadsBatch(object, parms, 0, NULL);
+  return EG_makeQuadsBatch(object, parms, *nIndex, fIndices);
+}
+
+
 int
 #ifdef WIN32
 IG_GETQUADS (INT8 *obj, int *index, int *len, const double **xyz, 
@@ -394,6 +414,48 @@ ig_moveedgevert_(INT8 *obj, int *index, int *vert, double *t)
 }
 
 
+int
+#ifdef WIN32
+IG_BEGINEDGEEDITS (INT8 *obj)
+#else
+ig_beginedgeedits_(INT8 *obj)
+#endif
+{
+  egObject *object;
+
+  object = (egObject *) *obj;
+  return EG_beginEdgeEdits(object);
+}
+
+
+int
+#ifdef WIN32
+IG_COMMITEDGEEDITS (INT8 *obj)
+#else
+ig_commitedgeedits_(INT8 *obj)
+#endif
+{
+  egObject *object;
+
+  object = (egObject *) *obj;
+  return EG_commitEdgeEdits(object);
+}
+
+
+int
+#ifdef WIN32
+IG_ABORTEDGEEDITS (INT8 *obj)
+#else
+ig_abortedgeedits_(INT8 *obj)
+#endif
+{
+  egObject *object;
+
+  object = (egObject *) *obj;
+  return EG_abortEdgeEdits(object);
+}
+
+
 int
 #ifdef WIN32
 IG_OPENTESSBODY (INT8 *obj)
@@ -49,6 +49,9 @@
   extern int EG_getBoundingBox(const egObject *topo, double *box);
   extern int EG_getMassProperties(const egObject *topo, /*@null@*/ double *dat);
   extern int EG_isEquivalent(const egObject *topo1, const egObject *topo2);
+  extern int EG_fingerprint(const egObject *object, int flag, double *print);
+  extern int EG_matchObjects(int nobj, const egObject **objs, int flag,
+                             int *nmatch, int **match);
   extern int EG_loadModel(egObject *context, int bflg, const char *name, 
                           egObject **model);
   extern int EG_saveModel(const egObject *model, const char *name);
@@ -58,6 +61,8 @@
                            int sense, int nt, const double *ts, double *uvs);
   extern int EG_getBody(const egObject *obj, egObject **body);
   extern int EG_inTopology(const egObject *topo, const double *xyz);
+  extern int EG_inTopologyBatch(const egObject *topo, int npts,
+                                const double *xyzs, int *results);
   extern int EG_inFace(const egObject *face, const double *uv);
   extern int EG_inFaceOCC(const egObject *face, double tol, const double *uv);
   extern int EG_getWindingAngle(egObject *edge, double t, double *angle);
@@ -392,6 +397,44 @@ ig_isequivalent_(INT8 *itopo1, INT8 *itopo2)
 }
 
 
+int
+#ifdef WIN32
+IG_FINGERPRINT (INT8 *iobj, int *flag, double *print)
+#else
+ig_fingerprint_(INT8 *iobj, int *flag, double *print)
+#endif
+{
+  egObject *object;
+
+  object = (egObject *) *iobj;
+  return EG_fingerprint(object, *flag, print);
+}
+
+
+int
+#ifdef WIN32
+IG_MATCHOBJECTS (int *nobj, INT8 *obj, int *flag, int *nMatch, int **matches)
+#else
+ig_matchobjects_(int *nobj, INT8 *obj, int *flag, int *nMatch, int **matches)
+#endif
+{
+  int            i, stat;
+  const egObject **objs;
+
+  *nMatch  = 0;
+  *matches = NULL;
+  if (*nobj <= 1) return EGADS_EMPTY;
+  objs = (const egObject **) EG_alloc(*nobj*sizeof(egObject *));
+  if (objs == NULL) return EGADS_MALLOC;
+  for (i = 0; i < *nobj; i++)
+    objs[i] = (egObject *) obj[i];
+
+  stat = EG_matchObjects(*nobj, objs, *flag, nMatch, matches);
+  EG_free((void *) objs);
+  return stat;
+}
+
+
 int
 #ifdef WIN32
 IG_LOADMODEL (INT8 *cntxt, int *bflg, const char *name, INT8 *model,
@@ -501,6 +544,20 @@ ig_intopology_(INT8 *itopo, const double *xyz)
 }
 
 
+int
+#ifdef WIN32
+IG_INTOPOLOGYBATCH (INT8 *itopo, int *npts, const double *xyzs, int *results)
+#else
+ig_intopologybatch_(INT8 *itopo, int *npts, const double *xyzs, int *results)
+#endif
+{
+  egObject *topo;
+  
+  topo = (egObject *) *itopo;
+  return EG_inTopologyBatch(topo, *npts, xyzs, results);
+}
+
+
 int
 #ifdef WIN32
 IG_INFACE (INT8 *iface, const double *uv)
@@ -50,7 +50,7 @@ static int    splineWithGaps1d        (int, double[], double[], int, int,
 /*
  * external routines defined in prmUV
  */
-extern int    sparseBCG               (double[], int[], double[], double[]);
+extern int    sparseSolve             (double[], int[], double[], double[]);
 
 /*
  * global constants
@@ -1480,8 +1480,8 @@ splineWithGaps1d(int      nvrt,              /* (in)   number of Vertices to fit
         /*
          * solve for the new x-locations
          */
-        status = sparseBCG(asmf, ismf, xx, rhs);
-        DPRINT1("sparseBCG -> status=%d", status);
+        status = sparseSolve(asmf, ismf, xx, rhs);
+        DPRINT1("sparseSolve -> status=%d", status);
         CHECK_STATUS;
 
         if (ipin > maxpin) break;
@@ -17,6 +17,7 @@
 #include <math.h>
 
 #include "prm.h"
+#include "emp.h"
 #include "egadsTypes.h"
 #include "egadsInternals.h"
 
@@ -25,6 +26,24 @@
 #endif
 
 
+/*
+ * a trial refinement (run on its own thread)
+ */
+typedef struct {
+    int      dtype;                          /* division type */
+    gridTree *tree;                          /* Grid Tree to refine */
+    int      nvrt;                           /* number of Vertices */
+    int      periodic;                       /* periodicity flag */
+    int      *ppnts;                         /* indices of periodic points */
+    prmUV    *uv;                            /* array  of Vertices */
+    double   *rin;                           /* residuals to fit */
+    double   *resid;                         /* new residuals */
+    double   rmserr;                         /* RMS     error at Vertices */
+    double   maxerr;                         /* maximum error at Vertices */
+    int      status;                         /* return status */
+    long     master;                         /* master thread ID */
+} prmTrial;
+
 /*
  * internal routines defined below
  */
@@ -41,9 +60,10 @@ static double evalToLevel             (gridTree*, int, int, prmUV);
 #endif
 static int    finestCell              (gridTree*, double, double);
 static int    globalRefine2d          (int, gridTree*, int, int, /*@null@*/int[],
-                                       prmUV[], double[], double*, double*);
+                                       prmUV[], double[], double[], double*, double*);
 static int    initialTree2d           (gridTree*, int, int, int, /*@null@*/int[],
                                        prmUV[], double[], double*, double*);
+static void   refineTrial             (void*);
 #ifdef GRAFIC
 static void   plotGrid                (int, int, int, int, prmUV[], double[], double[], double[]);
 static void   plotGridImage           (int*, void*, void*, void*, void*, void*,
@@ -72,7 +92,7 @@ static int    splineWithGaps2d        (int, prmUV[], double[], int, /*@null@*/in
  * external routines defined in prmUV
  */
 extern int    printSMF                (FILE*, double[], int[], double[], double[]);
-extern int    sparseBCG               (double[], int[], double[], double[]);
+extern int    sparseSolve             (double[], int[], double[], double[]);
 
 /*
  * global constants
@@ -236,7 +256,7 @@ static FILE     *dbg_fp = NULL;         /* file pointer for debug information */
 #define RALLOC(PTR,TYPE,SIZE) \
         DPRINT3("rallocing %s in routine %s (size=%d)", #PTR, routine, SIZE);\
         realloc_temp = EG_reall(PTR, (SIZE) * sizeof(TYPE)); \
-        if (PTR == NULL) {\
+        if (realloc_temp == NULL) {\
             GI_OUT2("ERROR:: RALLOC PROBLEM for %s in routine %s", #PTR, routine);\
             status = EGADS_MALLOC;\
             goto cleanup;\
@@ -247,7 +267,6 @@ static FILE     *dbg_fp = NULL;         /* file pointer for debug information */
         DPRINT2("freeing %s in routine %s", #PTR, routine);\
         EG_free(PTR);\
         PTR = NULL;
-static void *realloc_temp = NULL;            /* used by RALLOC macro */
 #define MEMCPY(DEST,SRC,SIZE) \
         if ((SIZE) > 0) {\
             memcpy(DEST,SRC,SIZE);\
@@ -355,6 +374,7 @@ copyGrid(gridTree *dest,                     /* (out)  pointer to destination Tr
          gridTree *src)                      /* (in)   pointer to source Tree */
 {
     int         status = EGADS_SUCCESS;      /* (out)  return status */
+    void        *realloc_temp = NULL;        /* used by RALLOC macro */
 
     ROUTINE(copyGrid);
     DPRINT1("%s() {",
@@ -362,12 +382,6 @@ copyGrid(gridTree *dest,                     /* (out)  pointer to destination Tr
 
     /* ----------------------------------------------------------------------- */
 
-    /*
-     * free any arrays in the desitnation
-     */
-    FREE(dest->cell);
-    FREE(dest->knot);
-
     /*
      * copy the scalar data
      */
@@ -382,10 +396,10 @@ copyGrid(gridTree *dest,                     /* (out)  pointer to destination Tr
 #endif
 
     /*
-     * allocate new arrays
+     * reuse (grow) the arrays in the destination
      */
-    MALLOC(dest->cell, gridCell,   dest->ncel                );
-    MALLOC(dest->knot, double,    (dest->nknt)*4*(dest->nvar));
+    RALLOC(dest->cell, gridCell,   dest->ncel                );
+    RALLOC(dest->knot, double,    (dest->nknt)*4*(dest->nvar));
 
     if (src->cell != NULL)
     MEMCPY(dest->cell, src->cell, (dest->ncel)               *sizeof(gridCell));
@@ -424,6 +438,7 @@ divideCell(gridTree *tree,                   /* (in)   pointer to Grid Tree */
     int         nborws, nborwn, nbores, nboren;
     int         nborsw, nborse, nbornw, nborne;
     double      umin, umax, vmin, vmax;
+    void        *realloc_temp = NULL;        /* used by RALLOC macro */
 
     int         nvar4 = 4 * tree->nvar;
 
@@ -1231,7 +1246,9 @@ globalRefine2d(int      dtype,               /* (in)   division type */
                int      periodic,            /* (in)   periodicity flag */
     /*@null@*/ int      ppnts[],             /* (in)   indices of periodic points */
                prmUV    uv[],                /* (in)   array  of Vertices */
-               double   resid[],             /* (both) array  of residuals */
+               double   rin[],               /* (in)   array  of residuals to fit */
+               double   resid[],             /* (out)  array  of new residuals */
+                                             /*        (may be the same as rin) */
                double   *rmserr,             /* (out)  RMS     error at Vertices */
                double   *maxerr)             /* (out)  maximum error at Vertices */
 {
@@ -1335,7 +1352,7 @@ globalRefine2d(int      dtype,               /* (in)   division type */
          * copy the Vertex data into xvrt
          */
         for (ivrt = 0; ivrt < nvrt; ivrt++) {
-            xvrt[ivrt] = resid[nvar*ivrt+ivar];
+            xvrt[ivrt] = rin[nvar*ivrt+ivar];
         }
 
         /*
@@ -1386,6 +1403,10 @@ globalRefine2d(int      dtype,               /* (in)   division type */
         uu = uv[ivrt].u;
         vv = uv[ivrt].v;
 
+        for (ivar = 0; ivar < nvar; ivar++) {
+            resid[nvar*ivrt+ivar] = rin[nvar*ivrt+ivar];
+        }
+
         for (icel = ncel; icel < tree->ncel; icel++) {
             umin = tree->cell[icel].umin;
             umax = tree->cell[icel].umax;
@@ -1433,6 +1454,31 @@ globalRefine2d(int      dtype,               /* (in)   division type */
 }
 
 
+
+/*
+ ********************************************************************************
+ *                                                                              *
+ * refineTrial -- thread entry for a trial globalRefine2d                       *
+ *                                                                              *
+ ********************************************************************************
+ */
+static void
+refineTrial(void     *struc)                 /* (in)   prmTrial structure */
+{
+    prmTrial    *trial = (prmTrial *) struc;
+
+    /* ----------------------------------------------------------------------- */
+
+    trial->status = globalRefine2d(trial->dtype, trial->tree, trial->nvrt,
+                                   trial->periodic, trial->ppnts, trial->uv,
+                                   trial->rin, trial->resid,
+                                   &trial->rmserr, &trial->maxerr);
+
+    if (EMP_ThreadID() != trial->master) EMP_ThreadExit();
+}
+
+
+
 
 /*
  ********************************************************************************
@@ -3358,8 +3404,8 @@ splineWithGaps2d(int      nvrt,              /* (in)   number of Vertices to fit
     /*
      * solve for the new x-locations
      */
-    status = sparseBCG(asmf, ismf, xx, rhs);
-    DPRINT1("sparseBCG -> status=%d", status);
+    status = sparseSolve(asmf, ismf, xx, rhs);
+    DPRINT1("sparseSolve -> status=%d", status);
     CHECK_STATUS;
 
     /*
@@ -3559,7 +3605,7 @@ prm_FixedGrid(int      nvrt,                 /* (in)   number of Vertices */
         if (tree.nv < nv) dtype += 2;
 
         status = globalRefine2d(dtype, &tree, nvrt, periodic, ppnts,
-                                uv, resid0, rmserr, maxerr);
+                                uv, resid0, resid0, rmserr, maxerr);
         CHECK_STATUS;
 
         PPRINT4("   (%4d,%4d)  rmserr=%12.6f  maxerr=%12.6f",
@@ -3645,6 +3691,43 @@ prm_BestGrid(int      nvrt,                  /* (in)   number of Vertices */
              double   *rmserr,               /* (out)  RMS     error at Vertices */
              double   *maxerr,               /* (out)  maximum error at Vertices */
              double   *dotmin)               /* (out)  minimum dot product */
+{
+    return prm_BestGridTree(nvrt, nvar, uv, var, ntri, tri, tol, periodic,
+                            ppnts, nu, nv, grid, rmserr, maxerr, dotmin, NULL);
+}
+
+
+
+
+/*
+ ********************************************************************************
+ *                                                                              *
+ * prm_BestGridTree -- prm_BestGrid that also returns the Grid Tree             *
+ *                                                                              *
+ ********************************************************************************
+ */
+extern int
+prm_BestGridTree(int      nvrt,              /* (in)   number of Vertices */
+                 int      nvar,              /* (in)   number of dependent vars */
+                 prmUV    uv[],              /* (in)   array  of Parameters */
+                 double   var[],             /* (in)   array  of dependent vars */
+                 int      ntri,              /* (in)   number of Triangles (optional) */
+      /*@null@*/ prmTri   tri[],             /* (in)   array  of Triangles (optional) */
+                 double   tol,               /* (in)   tolerance on maximum error */
+                 int      periodic,          /* (in)   = 0  no periodicity */
+                                             /*        = 1  periodic in U */
+                                             /*        = 2  periodic in V */
+      /*@null@*/ int      ppnts[],           /* (in)   indices of periodic points */
+                 int      *nu,               /* (in)   limit on nu if > 0 */
+                                             /* (out)  number of Knots in U-dirn */
+                 int      *nv,               /* (in)   limit on nv if > 0 */
+                                             /* (out)  number of Knots in V-dirn */
+                 double   *grid[],           /* (out)  pointer to grid of Knots */
+                 double   *rmserr,           /* (out)  RMS     error at Vertices */
+                 double   *maxerr,           /* (out)  maximum error at Vertices */
+                 double   *dotmin,           /* (out)  minimum dot product */
+      /*@null@*/ gridTree *tout)             /* (out)  the final Grid Tree
+                                                       NOTE: user must prm_FreeGrid after use */
 {
     int         status = EGADS_SUCCESS;      /* (out)  return status */
                                              /*        EGADS_SUCCESS */
@@ -3656,12 +3739,17 @@ prm_BestGrid(int      nvrt,                  /* (in)   number of Vertices */
     double      *resid2 = NULL;
     double      *ddu    = NULL;
     double      *ddv    = NULL;
+    double      *rtemp;
+    void        *thread;
 
     gridTree    tree0;
     gridTree    tree1;
     gridTree    tree2;
+    gridTree    ttemp;
+    prmTrial    trial1;
+    prmTrial    trial2;
 
-    int         iu, iv, iuv, numax, nvmax, nuvmax, ivrt, ivar, nsize, i;
+    int         iu, iv, iuv, numax, nvmax, nuvmax, ivrt, ivar, nsize, i, np;
 #ifdef DEBUG
     int         ivrt_max, ivar_max;
     double      resid_max;
@@ -3671,11 +3759,18 @@ prm_BestGrid(int      nvrt,                  /* (in)   number of Vertices */
     prmUV       uuvv;
     char        tag[2];
 
-    ROUTINE(prm_BestGrid);
+    ROUTINE(prm_BestGridTree);
   
     /*
      * initialize the pointers in the Trees
      */
+    if (tout != NULL) {
+        tout->ncel = 0;
+        tout->nknt = 0;
+        tout->cell = NULL;
+        tout->knot = NULL;
+    }
+
     tree0.cell = NULL;
     tree0.knot = NULL;
 
@@ -3765,9 +3860,9 @@ prm_BestGrid(int      nvrt,                  /* (in)   number of Vertices */
      * the initial residual is just the original data
      */
     nsize = nvrt * nvar * sizeof(double);
-    MALLOC(resid0, double, nsize);
-    MALLOC(resid1, double, nsize);
-    MALLOC(resid2, double, nsize);
+    MALLOC(resid0, double, nvrt*nvar);
+    MALLOC(resid1, double, nvrt*nvar);
+    MALLOC(resid2, double, nvrt*nvar);
 
     MEMCPY(resid0, var,    nsize);
 
@@ -3783,49 +3878,91 @@ prm_BestGrid(int      nvrt,                  /* (in)   number of Vertices */
     DPRINT4("   (%4d,%4d)  rmserr=%12.6f  maxerr=%12.6f",
             tree0.nu, tree0.nv, *rmserr, *maxerr);
 
+    /*
+     * fixed parts of the trial refinements
+     */
+    np = EMP_Init(NULL);
+
+    trial1.dtype    = 1;
+    trial1.tree     = &tree1;
+    trial2.dtype    = 2;
+    trial2.tree     = &tree2;
+    trial1.master   = trial2.master   = EMP_ThreadID();
+    trial1.nvrt     = trial2.nvrt     = nvrt;
+    trial1.periodic = trial2.periodic = periodic;
+    trial1.ppnts    = trial2.ppnts    = ppnts;
+    trial1.uv       = trial2.uv       = uv;
+
     /*
      * keep refining until desired tolerance is met (or max size is reached)
      */
     while (*maxerr > tol && (tree0.nu)*(tree0.nv) < nuvmax) {
 
         /*
-         * try refinement type 1
+         * set up refinement type 1 (U) and type 2 (V) trials
          */
+        trial1.status = EGADS_SUCCESS;
+        trial1.rmserr = HUGEQ;
+        trial1.maxerr = HUGEQ;
         if (tree0.nu < numax) {
-            copyGrid(&tree1, &tree0);
-            MEMCPY(resid1, resid0, nsize);
+            status = copyGrid(&tree1, &tree0);
+            CHECK_STATUS;
+
+            trial1.rin   = resid0;
+            trial1.resid = resid1;
+        }
 
-            status = globalRefine2d(1, &tree1, nvrt, periodic, ppnts,
-                                    uv, resid1, &rmserr1, &maxerr1);
+        trial2.status = EGADS_SUCCESS;
+        trial2.rmserr = HUGEQ;
+        trial2.maxerr = HUGEQ;
+        if (tree0.nv < nvmax) {
+            status = copyGrid(&tree2, &tree0);
             CHECK_STATUS;
 
-            PPRINT4("   (%4d,%4d)  rmserr=%12.6f  maxerr=%12.6f",
-                    tree1.nu, tree1.nv, rmserr1, maxerr1);
-            DPRINT4("   (%4d,%4d)  rmserr=%12.6f  maxerr=%12.6f",
-                    tree1.nu, tree1.nv, rmserr1, maxerr1);
-        } else {
-            rmserr1 = HUGEQ;
-            maxerr1 = HUGEQ;
+            trial2.rin   = resid0;
+            trial2.resid = resid2;
         }
 
         /*
-         * try refinement type 2
+         * the trials are independent -- run type 1 on a second thread
+         *    (when available) while this thread does type 2
          */
+        thread = NULL;
+        if (tree0.nu < numax && tree0.nv < nvmax && np > 1) {
+            thread = EMP_ThreadCreate(refineTrial, &trial1);
+        }
+        if (tree0.nu < numax && thread == NULL) {
+            refineTrial(&trial1);
+        }
         if (tree0.nv < nvmax) {
-            copyGrid(&tree2, &tree0);
-            MEMCPY(resid2, resid0, nsize);
+            refineTrial(&trial2);
+        }
+        if (thread != NULL) {
+            EMP_ThreadWait(thread);
+            EMP_ThreadDestroy(thread);
+        }
 
-            status = globalRefine2d(2, &tree2, nvrt, periodic, ppnts,
-                                    uv, resid2, &rmserr2, &maxerr2);
-            CHECK_STATUS;
+        status = trial1.status;
+        CHECK_STATUS;
+        status = trial2.status;
+        CHECK_STATUS;
 
+        rmserr1 = trial1.rmserr;
+        maxerr1 = trial1.maxerr;
+        rmserr2 = trial2.rmserr;
+        maxerr2 = trial2.maxerr;
+
+        if (tree0.nu < numax) {
+            PPRINT4("   (%4d,%4d)  rmserr=%12.6f  maxerr=%12.6f",
+                    tree1.nu, tree1.nv, rmserr1, maxerr1);
+            DPRINT4("   (%4d,%4d)  rmserr=%12.6f  maxerr=%12.6f",
+                    tree1.nu, tree1.nv, rmserr1, maxerr1);
+        }
+        if (tree0.nv < nvmax) {
             PPRINT4("   (%4d,%4d)  rmserr=%12.6f  maxerr=%12.6f",
                     tree2.nu, tree2.nv, rmserr2, maxerr2);
             DPRINT4("   (%4d,%4d)  rmserr=%12.6f  maxerr=%12.6f",
                     tree2.nu, tree2.nv, rmserr2, maxerr2);
-        } else {
-            rmserr2 = HUGEQ;
-            maxerr2 = HUGEQ;
         }
 
         /*
@@ -3843,17 +3980,33 @@ prm_BestGrid(int      nvrt,                  /* (in)   number of Vertices */
             break;
 
         /*
-         * keep the better of refinement 1 or 2
+         * neither refinement could be tried
+         */
+        } else if (rmserr1 == HUGEQ && rmserr2 == HUGEQ) {
+
+            status = PRM_TOLERANCEUNMET;
+            break;
+
+        /*
+         * keep the better of refinement 1 or 2 (by swapping, not copying)
          */
         } else if (rmserr1 < rmserr2) {
-            copyGrid(&tree0, &tree1);
-            MEMCPY(resid0, resid1, nsize);
+            ttemp  = tree0;
+            tree0  = tree1;
+            tree1  = ttemp;
+            rtemp  = resid0;
+            resid0 = resid1;
+            resid1 = rtemp;
             *rmserr = rmserr1;
             *maxerr = maxerr1;
 
         } else {
-            copyGrid(&tree0, &tree2);
-            MEMCPY(resid0, resid2, nsize);
+            ttemp  = tree0;
+            tree0  = tree2;
+            tree2  = ttemp;
+            rtemp  = resid0;
+            resid0 = resid2;
+            resid2 = rtemp;
             *rmserr = rmserr2;
             *maxerr = maxerr2;
         }
@@ -3946,6 +4099,15 @@ prm_BestGrid(int      nvrt,                  /* (in)   number of Vertices */
         *dotmin = computeDotmin(&tree0, nvar, uv, var, ntri, tri);
     }
 
+    /*
+     * hand the Tree back (if requested)
+     */
+    if (tout != NULL) {
+        *tout      = tree0;
+        tree0.cell = NULL;
+        tree0.knot = NULL;
+    }
+
  cleanup:
     prm_FreeGrid(&tree2);
     prm_FreeGrid(&tree1);
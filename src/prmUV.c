@@ -16,11 +16,13 @@
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
+#include <time.h>
 
 #include "egadsTypes.h"
 #include "egadsInternals.h"
 #include "egadsTris.h"
 #include "prm.h"
+#include "emp.h"
 
 extern int EG_fillArea(int nconts, const int *cntr, const double *vertices,
                        int *tris, int *nfig8, int pass, fillArea *fa);
@@ -46,11 +48,103 @@ typedef struct {
 } sparseMat;
 
 
+/*
+ * a team of threads that is created once and then reused for many
+ *    chunked loops (so that an iterative solve does not create and
+ *    destroy its threads every pass)
+ */
+typedef void (*teamFunc)(void *data, int ilo, int ihi);
+
+typedef struct {
+  void     *mutex;              /* the mutex or NULL for single thread */
+  void     *gate[2];            /* held by the master while no loop is posted */
+  long     master;              /* master thread ID */
+  int      nthread;             /* number of threads (including the master) */
+  void     **threads;           /* the other threads (nthread-1) */
+  int      task;                /* serial number of the posted loop */
+  int      nbusy;               /* threads not yet done with the posted loop */
+  int      quit;                /* =1 tells the threads to exit */
+  int      index;               /* next chunk of items */
+  int      nchunk;              /* number of chunks */
+  int      chunk;               /* number of items in a chunk */
+  int      n;                   /* number of items */
+  teamFunc func;                /* applied to each chunk of items */
+  void     *data;               /* passed to func */
+} EMPteam;
+
+
+/*
+ * used by the threaded SMF matrix-vector product
+ */
+typedef struct {
+  double  *asmf;                /* sparse-matrix data */
+  int     *ismf;                /* sparse-matrix indices */
+  double  *x;                   /* the vector */
+  double  *y;                   /* the product */
+} prmMult;
+
+
+/*
+ * Vertex-to-Triangle adjacency (CSR) -- the entries for Vertex i are
+ *    jtri[itri[i]] ... jtri[itri[i+1]-1], each 3*(Triangle)+(corner),
+ *    in ascending Triangle order
+ */
+typedef struct {
+  int     nvrt;                 /* number of Vertices */
+  int     *itri;                /* offsets (nvrt+1) */
+  int     *jtri;                /* Triangle/corner entries */
+} prmAdj;
+
+
+/*
+ * data for the smoothUVcoords passes
+ */
+typedef struct {
+  prmTri  *tri;                 /* array of Triangles */
+  prmAdj  *adj;                 /* Vertex-to-Triangle adjacency */
+  prmUV   *uv;                  /* array of Parameters */
+  double  *du;                  /* U change (sum) at each Vertex */
+  double  *dv;                  /* V change (sum) at each Vertex */
+  double  *nn;                  /* weight at each Vertex */
+  double  *part;                /* minimum area in each chunk of Triangles */
+  double  omega;                /* under-relaxation factor */
+} prmSmooth;
+
+
+/*
+ * data for the colored successive-over-relaxation in floaterParameterization
+ */
+typedef struct {
+  double  *asmf;                /* sparse-matrix data */
+  int     *ismf;                /* sparse-matrix indices */
+  double  *urhs;                /* RHS for U */
+  double  *vrhs;                /* RHS for V */
+  prmUV   *uv;                  /* array of Parameters */
+  int     *list;                /* Vertices of the current color */
+  double  *part;                /* residual sum in each chunk of Vertices */
+  double  omega;                /* over-relaxation factor */
+} prmSOR;
+
+
 /*
  * internal routines defined below
  */
 static void   surfaceNormal           (int, int, int, prmXYZ[], double*, double[]);
-static int    smoothUVcoords          (int, prmTri[], int, prmUV[], double*);
+static double wallSeconds             ();
+static void   teamChunks              (EMPteam*);
+static void   teamThread              (void*);
+static void   teamCreate              (int, EMPteam*);
+static void   teamRun                 (EMPteam*, int, int, teamFunc, void*);
+static void   teamDestroy             (EMPteam*);
+static int    buildVrtTri             (int, prmTri[], int, prmAdj*);
+static void   freeVrtTri              (prmAdj*);
+static int    colorSMF                (int, int[], int*, int**, int**);
+static void   smoothDelta             (void*, int, int);
+static void   smoothUpdate            (void*, int, int);
+static void   smoothArea              (void*, int, int);
+static int    smoothUVcoords          (int, prmTri[], int, prmAdj*, EMPteam*, prmUV[], double*);
+static void   floaterSOR              (void*, int, int);
+static void   floaterResid            (void*, int, int);
 static void   layDownTriangle         (prmXYZ[], prmUV[], int, int, int);
 static void   layDownTriangle2        (prmUV[], double, double, int, double, double,
                                        int, double, double, int);
@@ -76,6 +170,14 @@ static void   plotTrisImage           (int*, void*, void*, void*, void*, void*,
  */
 extern int    printSMF                (FILE*, double[], int[], double[], double[]);
 extern int    sparseBCG               (double[], int[], double[], double[]);
+extern int    sparseILU               (double[], int[], double[], double[]);
+extern int    sparseSolve             (double[], int[], double[], double[]);
+
+/*
+ * global variables
+ */
+static int    globalSolver = PRM_SOLVE_BCG;   /* set by prm_SetSolver */
+static int    globalRelax  = PRM_RELAX_SOR;   /* set by prm_SetRelax */
 
 /*
  * global constants
@@ -86,6 +188,10 @@ extern int    sparseBCG               (double[], int[], double[], double[]);
 #define  EPS20           1.0e-20
 #define  TWOPI           2.0*PI
 #define  MAXLOOPS        500
+#define  SMFPERTHREAD    50000           /* min nonzeros per matvec thread */
+#define  TEAMSPIN        10000           /* polls before the master yields */
+#define  VRTCHUNK        4096            /* items per threaded chunk */
+#define  NCHUNK(N)       (((N) + VRTCHUNK - 1) / VRTCHUNK)
 
 /*
 * useful macros
@@ -460,800 +566,961 @@ fillSmat(sparseMat *mat, int i, int *kk, double *asmf, int *ismf)
   *kk = k;
   return EGADS_SUCCESS;
 }
-
+
 /*
  ********************************************************************************
  *                                                                              *
- * surfaceNormal -- compute surface normal for a Triangle                       *
+ * teamChunks -- do chunks of the posted loop until there are none left         *
  *                                                                              *
  ********************************************************************************
  */
 static void
-surfaceNormal(int      iv0,                  /* (in)   first  Vertex (bias-0) */
-              int      iv1,                  /* (in)   second Vertex (bias-0) */
-              int      iv2,                  /* (in)   third  Vertex (bias-0) */
-              prmXYZ   xyz[],                /* (in)   array of Coordinates */
-              double   *area,                /* (out)  area of Triangle */
-              double   norm[])               /* (out)  components of the unit normal */
+teamChunks(EMPteam  *team)                   /* (in)   EMPteam structure */
 {
+    int         index, ilo, ihi;
 
-//    ROUTINE(surfaceNormal);
-
-    /* ----------------------------------------------------------------------- */
-
-    if ((iv0 < 0) || (iv1 < 0) || (iv2 < 0)) {
-        *area   = 0.0;
-        norm[0] = 0.0;
-        norm[1] = 0.0;
-        norm[2] = 0.0;
+    /* look for work */
+    for (;;) {
 
-    } else {
-        norm[0] = (xyz[iv1].y - xyz[iv0].y) * (xyz[iv2].z - xyz[iv0].z)
-                - (xyz[iv2].y - xyz[iv0].y) * (xyz[iv1].z - xyz[iv0].z);
-        norm[1] = (xyz[iv1].z - xyz[iv0].z) * (xyz[iv2].x - xyz[iv0].x)
-                - (xyz[iv2].z - xyz[iv0].z) * (xyz[iv1].x - xyz[iv0].x);
-        norm[2] = (xyz[iv1].x - xyz[iv0].x) * (xyz[iv2].y - xyz[iv0].y)
-                - (xyz[iv2].x - xyz[iv0].x) * (xyz[iv1].y - xyz[iv0].y);
+        /* only one thread at a time here -- controlled by a mutex! */
+        if (team->mutex != NULL) EMP_LockSet(team->mutex);
+        index = team->index;
+        team->index++;
+        if (team->mutex != NULL) EMP_LockRelease(team->mutex);
 
-        *area = NORM012(norm);
+        if (index >= team->nchunk) break;
+        ilo = index * team->chunk;
+        ihi = MIN(ilo + team->chunk, team->n);
 
-        if ((*area) > 0) {
-            norm[0] /= (*area);
-            norm[1] /= (*area);
-            norm[2] /= (*area);
-        }
+        /* do the work */
+        team->func(team->data, ilo, ihi);
     }
-
-// cleanup:
 }
 
 
-
+
+
 /*
  ********************************************************************************
  *                                                                              *
- * smoothUVcoords -- smooth UV coordinates                                      *
+ * teamThread -- thread block that waits for and runs the posted loops          *
  *                                                                              *
  ********************************************************************************
  */
-static int
-smoothUVcoords(int      ntri,                /* (in)   number of Triangles */
-               prmTri   tri[],               /* (in)   array  of Triangles */
-               int      nvrt,                /* (in)   number of Vertices */
-               prmUV    uv[],                /* (both) array of Parameters */
-               double   *amin)               /* (out)  minimum area */
+static void
+teamThread(void     *struc)                  /* (in)   EMPteam structure */
 {
-    int         status = EGADS_SUCCESS;      /* (out)  return status */
-                                             /*        EGADS_SUCCESS */
-
-    double      *du = NULL;
-    double      *dv = NULL;
-    double      *nn = NULL;
+    int         task, mytask = 0, quit;
+    EMPteam     *team = (EMPteam *) struc;
 
-    int         ivrt, iv0, iv1, iv2;
-    int         itri;
-    double      usum, vsum, area2;
+    for (;;) {
 
-    double      omega = 0.50;
+        /* block until the master posts the next loop (or quits) by
+           releasing the gate for that loop */
+        EMP_LockSet(    team->gate[(mytask+1)%2]);
+        EMP_LockRelease(team->gate[(mytask+1)%2]);
 
-    ROUTINE(smoothUVcoords);
-    DPRINT3("%s(ntri=%d, nvrt=%d) {",
-            routine, ntri, nvrt);
+        EMP_LockSet(team->mutex);
+        task = team->task;
+        quit = team->quit;
+        EMP_LockRelease(team->mutex);
 
-    /* ----------------------------------------------------------------------- */
+        if (quit == 1) break;
+        mytask = task;
 
-    /*
-     * get work arrays
-     */
-    MALLOC(du, double, nvrt);
-    MALLOC(dv, double, nvrt);
-    MALLOC(nn, double, nvrt);
+        teamChunks(team);
 
-    /*
-     * initialize the sums (du, dv, and nn)
-     */
-    for (ivrt = 0; ivrt < nvrt; ivrt++) {
-        du[ivrt] = 0;
-        dv[ivrt] = 0;
-        nn[ivrt] = 0;
+        /* tell the master that we are done with this loop */
+        EMP_LockSet(team->mutex);
+        team->nbusy--;
+        EMP_LockRelease(team->mutex);
     }
 
-    /*
-     * accumulate sums (du, dv, and nn) at each of the Vertices
-     */
-    for (itri = 0; itri < ntri; itri++) {
-        iv0 = tri[itri].indices[0] - 1;
-        iv1 = tri[itri].indices[1] - 1;
-        iv2 = tri[itri].indices[2] - 1;
-
-        usum = uv[iv0].u + uv[iv1].u + uv[iv2].u;
-        vsum = uv[iv0].v + uv[iv1].v + uv[iv2].v;
+    /* told to quit -- exit */
+    EMP_ThreadExit();
+}
 
-        du[iv0] += usum - 3 * uv[iv0].u;
-        du[iv1] += usum - 3 * uv[iv1].u;
-        du[iv2] += usum - 3 * uv[iv2].u;
-        dv[iv0] += vsum - 3 * uv[iv0].v;
-        dv[iv1] += vsum - 3 * uv[iv1].v;
-        dv[iv2] += vsum - 3 * uv[iv2].v;
-        nn[iv0] += 2;
-        nn[iv1] += 2;
-        nn[iv2] += 2;
-    }
 
-    /*
-     * zero out du and dv on the boundary
-     */
-    for (itri = 0; itri < ntri; itri++) {
-        if (tri[itri].neigh[1] <= 0 || tri[itri].neigh[2] <= 0) {
-            du[tri[itri].indices[0]-1] = 0.0;
-            dv[tri[itri].indices[0]-1] = 0.0;
-        }
 
-        if (tri[itri].neigh[2] <= 0 || tri[itri].neigh[0] <= 0) {
-            du[tri[itri].indices[1]-1] = 0.0;
-            dv[tri[itri].indices[1]-1] = 0.0;
-        }
 
-        if (tri[itri].neigh[0] <= 0 || tri[itri].neigh[1] <= 0) {
-            du[tri[itri].indices[2]-1] = 0.0;
-            dv[tri[itri].indices[2]-1] = 0.0;
-        }
-    }
+/*
+ ********************************************************************************
+ *                                                                              *
+ * teamCreate -- start a team of np threads (teamDestroy when done)             *
+ *                                                                              *
+ ********************************************************************************
+ */
+static void
+teamCreate(int      np,                      /* (in)   number of threads to use */
+           EMPteam  *team)                   /* (out)  EMPteam structure */
+{
+    int         i;
 
-    /*
-     * update the Vertex locations with under-relaxation
-     */
+    /* ----------------------------------------------------------------------- */
 
-    for (ivrt = 0; ivrt < nvrt; ivrt++) {
-        uv[ivrt].u += omega * du[ivrt] / nn[ivrt];
-        uv[ivrt].v += omega * dv[ivrt] / nn[ivrt];
+    team->mutex   = NULL;
+    team->gate[0] = NULL;
+    team->gate[1] = NULL;
+    team->master  = EMP_ThreadID();
+    team->nthread = 1;
+    team->threads = NULL;
+    team->task    = 0;
+    team->nbusy   = 0;
+    team->quit    = 0;
+    team->index   = 0;
+    team->nchunk  = 0;
+    team->chunk   = 1;
+    team->n       = 0;
+    team->func    = NULL;
+    team->data    = NULL;
+
+    if (np <= 1) return;
+
+    team->mutex   = EMP_LockCreate();
+    team->gate[0] = EMP_LockCreate();
+    team->gate[1] = EMP_LockCreate();
+    team->threads = (void **) malloc((np-1)*sizeof(void *));
+    if (team->mutex   == NULL || team->gate[0] == NULL ||
+        team->gate[1] == NULL || team->threads == NULL) {
+        if (team->threads != NULL) free(team->threads);
+        if (team->gate[1] != NULL) EMP_LockDestroy(team->gate[1]);
+        if (team->gate[0] != NULL) EMP_LockDestroy(team->gate[0]);
+        if (team->mutex   != NULL) EMP_LockDestroy(team->mutex);
+        team->mutex   = NULL;
+        team->gate[0] = NULL;
+        team->gate[1] = NULL;
+        team->threads = NULL;
+        return;
     }
 
-    /*
-     * keep track of the smallest area
-     */
-    *amin = +HUGEQ;
-    for (itri = 0; itri < ntri; itri++) {
-        iv0 = tri[itri].indices[0] - 1;
-        iv1 = tri[itri].indices[1] - 1;
-        iv2 = tri[itri].indices[2] - 1;
+    /* the threads block on the gates (rather than spin) between loops */
+    EMP_LockSet(team->gate[0]);
+    EMP_LockSet(team->gate[1]);
 
-        area2 = (uv[iv1].u - uv[iv0].u) * (uv[iv2].v - uv[iv0].v)
-              - (uv[iv1].v - uv[iv0].v) * (uv[iv2].u - uv[iv0].u);
-        *amin = MIN(*amin, area2);
+    /* only count the threads that actually started */
+    for (i = 0; i < np-1; i++) {
+        team->threads[team->nthread-1] = EMP_ThreadCreate(teamThread, team);
+        if (team->threads[team->nthread-1] != NULL) team->nthread++;
     }
+}
 
- cleanup:
-    FREE(du);
-    FREE(dv);
-    FREE(nn);
 
-    DPRINT2("%s --> status=%d}", routine, status);
-    return status;
-}
 
 
-
 /*
  ********************************************************************************
  *                                                                              *
- * layDownTriangle -- lay down a Triangle to unroll                             *
+ * teamRun -- apply func to n items in chunks of the given size (threaded)      *
  *                                                                              *
  ********************************************************************************
  */
 static void
-layDownTriangle(prmXYZ    xyz[],             /* (both) array of Coordinates */
-                prmUV     uv[],              /* (both) array of Parameters */
-                int       iv0,               /* (in)   base Vertex 1 */
-                int       iv1,               /* (in)   base Vertex 2 */
-                int       iv2)               /* (in)   Vertex to be defined */
+teamRun(EMPteam  *team,                      /* (in)   EMPteam structure */
+        int      n,                          /* (in)   number of items */
+        int      chunk,                      /* (in)   number of items in a chunk */
+        teamFunc func,                       /* (in)   applied to each chunk */
+        void     *data)                      /* (in)   passed to func */
 {
-    double len01, len12, len20, phi, tht, area;
-
-//    ROUTINE(layDownTriangle);
+    int         ilo, ispin, nbusy;
 
     /* ----------------------------------------------------------------------- */
 
-    /*
-     * compute lengths
-     */
-    len01 = sqrt(  SQR(xyz[iv0].x - xyz[iv1].x)
-                 + SQR(xyz[iv0].y - xyz[iv1].y)
-                 + SQR(xyz[iv0].z - xyz[iv1].z));
-    len12 = sqrt(  SQR(xyz[iv1].x - xyz[iv2].x)
-                 + SQR(xyz[iv1].y - xyz[iv2].y)
-                 + SQR(xyz[iv1].z - xyz[iv2].z));
-    len20 = sqrt(  SQR(xyz[iv2].x - xyz[iv0].x)
-                 + SQR(xyz[iv2].y - xyz[iv0].y)
-                 + SQR(xyz[iv2].z - xyz[iv0].z));
+    /* not worth waking the other threads for a single chunk */
+    if (team->nthread <= 1 || n <= chunk) {
+        for (ilo = 0; ilo < n; ilo += chunk) {
+            func(data, ilo, MIN(ilo + chunk, n));
+        }
+        return;
+    }
 
-    /*
-     * place Vertex iv2 (using law of cosines)
-     */
-    phi = atan2(uv[iv1].v - uv[iv0].v, uv[iv1].u - uv[iv0].u);
-    tht = ACOS( (SQR(len01) - SQR(len12) + SQR(len20))
-              / (    len01  *   2.0      *     len20 ));
+    /* post the loop */
+    EMP_LockSet(team->mutex);
+    team->index  = 0;
+    team->nchunk = (n + chunk - 1) / chunk;
+    team->chunk  = chunk;
+    team->n      = n;
+    team->func   = func;
+    team->data   = data;
+    team->nbusy  = team->nthread - 1;
+    team->task++;
+    EMP_LockRelease(team->mutex);
+
+    /* open the gate for this loop */
+    EMP_LockRelease(team->gate[team->task%2]);
+
+    /* take part from the original thread */
+    teamChunks(team);
+
+    /* wait for all others to finish the loop */
+    for (ispin = 0; ; ispin++) {
+        EMP_LockSet(team->mutex);
+        nbusy = team->nbusy;
+        EMP_LockRelease(team->mutex);
+
+        if (nbusy <= 0) break;
+        if (ispin >= TEAMSPIN) EMP_ThreadSpin();
+    }
 
-    uv[iv2].u = uv[iv0].u + len20 * cos(phi - tht);
-    uv[iv2].v = uv[iv0].v + len20 * sin(phi - tht);
+    /* every thread is through (and waiting at the other gate) -- close it */
+    EMP_LockSet(team->gate[team->task%2]);
+}
 
-    /*
-     * make Triangle on other side of 0-1 if a negative area
-     */
-    area = (uv[iv1].u - uv[iv0].u) * (uv[iv2].v - uv[iv0].v)
-         - (uv[iv1].v - uv[iv0].v) * (uv[iv2].u - uv[iv0].u);
 
-    if (area < 0.0) {
-        uv[iv2].u = uv[iv0].u + len20 * cos(phi + tht);
-        uv[iv2].v = uv[iv0].v + len20 * sin(phi + tht);
-    }
-}
 
 
-
 /*
  ********************************************************************************
  *                                                                              *
- * layDownTriangle2 -- lay down a Triangle for jones' transformation            *
+ * teamDestroy -- stop the team's threads and cleanup                           *
  *                                                                              *
  ********************************************************************************
  */
 static void
-layDownTriangle2(prmUV     uv[],
-                 double    u0,
-                 double    v0,
-                 int       iv0,
-                 double    u1,
-                 double    v1,
-                 int       iv1,
-                 double    u2,
-                 double    v2,
-                 int       iv2)
+teamDestroy(EMPteam  *team)                  /* (both) EMPteam structure */
 {
-    double len01, len12, len20, phi, tht;
-
-//    ROUTINE(layDownTriangle2);
+    int         i;
 
     /* ----------------------------------------------------------------------- */
 
-    /*
-     * compute lengths
-     */
-    len01 = sqrt(SQR(u0 - u1) + SQR(v0 - v1));
-    len12 = sqrt(SQR(u1 - u2) + SQR(v1 - v2));
-    len20 = sqrt(SQR(u2 - u0) + SQR(v2 - v0));
+    if (team->threads != NULL) {
+        EMP_LockSet(team->mutex);
+        team->quit = 1;
+        EMP_LockRelease(team->mutex);
 
-    /*
-     * place Vertex iv2 (using law of cosines)
-     */
-    phi = atan2(uv[iv1].v - uv[iv0].v,
-                uv[iv1].u - uv[iv0].u);
-    tht = ACOS((SQR(len20) - SQR(len12) + SQR(len01)) / (2.0 * len20 * len01));
+        /* the threads are waiting at the gate for the next loop */
+        EMP_LockRelease(team->gate[(team->task+1)%2]);
 
-    uv[iv2].u = uv[iv0].u + len20 * cos(phi + tht);
-    uv[iv2].v = uv[iv0].v + len20 * sin(phi + tht);
+        for (i = 0; i < team->nthread-1; i++) {
+            EMP_ThreadWait(team->threads[i]);
+        }
+        for (i = 0; i < team->nthread-1; i++) {
+            EMP_ThreadDestroy(team->threads[i]);
+        }
+        free(team->threads);
+
+        EMP_LockRelease(team->gate[team->task%2]);
+    }
+    if (team->gate[1] != NULL) EMP_LockDestroy(team->gate[1]);
+    if (team->gate[0] != NULL) EMP_LockDestroy(team->gate[0]);
+    if (team->mutex   != NULL) EMP_LockDestroy(team->mutex);
+
+    team->mutex   = NULL;
+    team->gate[0] = NULL;
+    team->gate[1] = NULL;
+    team->threads = NULL;
+    team->nthread = 1;
 }
+
+
 
 
-
 /*
  ********************************************************************************
  *                                                                              *
- * axialProjection -- use axial projection (if possible)                        *
+ * buildVrtTri -- build the Vertex-to-Triangle adjacency (CSR)                  *
  *                                                                              *
  ********************************************************************************
  */
 static int
-axialProjection(int          ntri,           /* (in)   number of Triangles */
-                prmTri       tri[],          /* (in)   array  of Triangles */
-                int          nvrt,           /* (in)   number of Vertices */
-                prmXYZ       xyz[],          /* (in)   array  of Coordinates */
-                prmUV        uv[])           /* (out)  array  of Parameters */
+buildVrtTri(int      ntri,                   /* (in)   number of Triangles */
+            prmTri   tri[],                  /* (in)   array  of Triangles */
+            int      nvrt,                   /* (in)   number of Vertices */
+            prmAdj   *adj)                   /* (out)  adjacency (freeVrtTri when done) */
 {
-    int         status = PRM_NOGLOBALUV;     /* (out)  return status */
-                                             /*        PRM_NOGLOBALUV */
-                                             /*        PRM_OK_AXIAL */
+    int         status = EGADS_SUCCESS;      /* (out)  return status */
+                                             /*        EGADS_SUCCESS */
 
-    double      area;
-    int         change;
-    double      dx, dy, dz;
-    int         itri;
-    int         ivrt, iv0, iv1, iv2;
-    int         nneg;
-    int         pass;
-    double      theta0, theta1, theta2;
-    double      xcent, ycent, zcent;
-    double      xmin,  xmax,  ymin,  ymax,  zmin,  zmax;
-    double      xmin1, xmax1, ymin1, ymax1, zmin1, zmax1;
-    double      xmin2, xmax2, ymin2, ymax2, zmin2, zmax2;
+    int         itri, ic, ivrt;
+    int         *fill = NULL;
 
-    ROUTINE(axialProjection);
+    ROUTINE(buildVrtTri);
     DPRINT3("%s(ntri=%d, nvrt=%d) {",
             routine, ntri, nvrt);
 
     /* ----------------------------------------------------------------------- */
 
+    adj->nvrt = nvrt;
+    adj->itri = NULL;
+    adj->jtri = NULL;
+
+    MALLOC(adj->itri, int, nvrt+1);
+    MALLOC(adj->jtri, int, 3*ntri+1);
+    MALLOC(fill,      int, nvrt  );
+
     /*
-     * find the minimum and maximum extents of the Vertices in the tessellation
+     * count the Triangle corners at each Vertex
      */
-    xmin = xyz[0].x;
-    xmax = xyz[0].x;
-    ymin = xyz[0].y;
-    ymax = xyz[0].y;
-    zmin = xyz[0].z;
-    zmax = xyz[0].z;
-
-    for (ivrt = 1; ivrt < nvrt; ivrt++) {
-        xmin = MIN(xmin, xyz[ivrt].x);
-        xmax = MAX(xmax, xyz[ivrt].x);
-        ymin = MIN(ymin, xyz[ivrt].y);
-        ymax = MAX(ymax, xyz[ivrt].y);
-        zmin = MIN(zmin, xyz[ivrt].z);
-        zmax = MAX(zmax, xyz[ivrt].z);
+    for (ivrt = 0; ivrt <= nvrt; ivrt++) {
+        adj->itri[ivrt] = 0;
+    }
+    for (itri = 0; itri < ntri; itri++) {
+        for (ic = 0; ic < 3; ic++) {
+            ivrt = tri[itri].indices[ic] - 1;
+            if (ivrt < 0 || ivrt >= nvrt) {
+                status = EGADS_INDEXERR;
+                goto cleanup;
+            }
+            adj->itri[ivrt+1]++;
+        }
+    }
+    for (ivrt = 0; ivrt < nvrt; ivrt++) {
+        adj->itri[ivrt+1] += adj->itri[ivrt];
+        fill[ivrt]         = adj->itri[ivrt];
     }
-    DPRINT3("xmin=%10.5f   ymin=%10.5f   zmin=%10.5f", xmin, ymin, zmin);
-    DPRINT3("xmax=%10.5f   ymax=%10.5f   zmax=%10.5f", xmax, ymax, zmax);
 
     /*
-     * the x-extent is larger than the other two extents, so try an
-     *    axis that is aligned with the x-axis
+     * fill the entries (in Triangle order)
      */
-    if ((xmax-xmin) > (ymax-ymin) && (xmax-xmin) > (zmax-zmin)) {
-        DPRINT0("potential axis in x-direction");
-
-        /*
-         * find the center of the Vertices within the last 1 percent of the x extent
-         */
-        dx   = 0.01 * (xmax - xmin);
+    for (itri = 0; itri < ntri; itri++) {
+        for (ic = 0; ic < 3; ic++) {
+            ivrt = tri[itri].indices[ic] - 1;
+            adj->jtri[fill[ivrt]++] = 3 * itri + ic;
+        }
+    }
 
-        ymin1 = +HUGEQ;
-        ymax1 = -HUGEQ;
-        ymin2 = +HUGEQ;
-        ymax2 = -HUGEQ;
-        zmin1 = +HUGEQ;
-        zmax1 = -HUGEQ;
-        zmin2 = +HUGEQ;
-        zmax2 = -HUGEQ;
+ cleanup:
+    FREE(fill);
+    if (status != EGADS_SUCCESS) {
+        freeVrtTri(adj);
+    }
 
-        for (ivrt = 0; ivrt < nvrt; ivrt++) {
-            if (xyz[ivrt].x < xmin+dx) {
-                ymin1 = MIN(ymin1, xyz[ivrt].y);
-                ymax1 = MAX(ymax1, xyz[ivrt].y);
-                zmin1 = MIN(zmin1, xyz[ivrt].z);
-                zmax1 = MAX(zmax1, xyz[ivrt].z);
-            } else if (xyz[ivrt].x > xmax-dx) {
-                ymin2 = MIN(ymin2, xyz[ivrt].y);
-                ymax2 = MAX(ymax2, xyz[ivrt].y);
-                zmin2 = MIN(zmin2, xyz[ivrt].z);
-                zmax2 = MAX(zmax2, xyz[ivrt].z);
-            }
-        }
+    DPRINT2("%s --> status=%d}", routine, status);
+    return status;
+}
 
-        ymin = MAX(ymin1, ymin2);
-        ymax = MIN(ymax1, ymax2);
-        zmin = MAX(zmin1, zmin2);
-        zmax = MIN(zmax1, zmax2);
 
-        /*
-         * try placing the axis at the center and at each of the extents
-         */
-        for (pass = 0; pass < 5; pass++) {
-            if (pass == 0) {
-                xcent = (xmin + xmax) / 2;
-                ycent = (ymin + ymax) / 2;
-                zcent = (zmin + zmax) / 2;
-            } else if (pass == 1) {
-                xcent = (xmin + xmax) / 2;
-                ycent =  ymin            ;
-                zcent = (zmin + zmax) / 2;
-            } else if (pass == 2) {
-                xcent = (xmin + xmax) / 2;
-                ycent =         ymax     ;
-                zcent = (zmin + zmax) / 2;
-            } else if (pass == 3) {
-                xcent = (xmin + xmax) / 2;
-                ycent = (ymin + ymax) / 2;
-                zcent =  zmin            ;
-            } else {
-                xcent = (xmin + xmax) / 2;
-                ycent = (ymin + ymax) / 2;
-                zcent =         zmax     ;
-            }
-            DPRINT3("xcent=%10.5f  ycent=%10.5f  zcent=%10.5f", xcent, ycent, zcent);
 
-            /*
-             * assign u=x and v=theta for every Vertex
-             */
-            for (ivrt = 0; ivrt < nvrt; ivrt++) {
-                uv[ivrt].u = xmin - 1;
-            }
+
+/*
+ ********************************************************************************
+ *                                                                              *
+ * freeVrtTri -- free the Vertex-to-Triangle adjacency                          *
+ *                                                                              *
+ ********************************************************************************
+ */
+static void
+freeVrtTri(prmAdj   *adj)                    /* (both) adjacency */
+{
+    ROUTINE(freeVrtTri);
 
-            uv[0].u = xyz[0].x;
-            uv[0].v = atan2(xyz[0].y - ycent, xyz[0].z - zcent);
+    /* ----------------------------------------------------------------------- */
 
-            change = 1;
-            while (change > 0) {
-                change = 0;
+    FREE(adj->itri);
+    FREE(adj->jtri);
+    adj->nvrt = 0;
+}
 
-                for (itri = 0; itri < ntri; itri++) {
-                    iv0 = tri[itri].indices[0] - 1;
-                    iv1 = tri[itri].indices[1] - 1;
-                    iv2 = tri[itri].indices[2] - 1;
 
 
-                    if (uv[iv0].u >= xmin) {
-                        theta0 = uv[iv0].v;
+
+/*
+ ********************************************************************************
+ *                                                                              *
+ * colorSMF -- greedy coloring of the rows of an SMF matrix so that no          *
+ *             two rows of the same color reference each other                  *
+ *                                                                              *
+ ********************************************************************************
+ */
+static int
+colorSMF(int      n,                         /* (in)   number of rows */
+         int      ismf[],                    /* (in)   sparse-matrix indices */
+         int      *ncolor,                   /* (out)  number of colors */
+         int      *icolor[],                 /* (out)  offsets (ncolor+1) */
+         int      *jcolor[])                 /* (out)  rows of each color (ascending)
+                                                       NOTE: user must EG_free both */
+{
+    int         status = EGADS_SUCCESS;      /* (out)  return status */
+                                             /*        EGADS_SUCCESS */
 
-                        if (uv[iv1].u < xmin) {
-                            theta1 = atan2(xyz[iv1].y - ycent, xyz[iv1].z - zcent);
+    int         i, j, k, ic, maxdeg;
+    int         *it    = NULL;               /* transpose offsets */
+    int         *jt    = NULL;               /* transpose columns */
+    int         *color = NULL;
+    int         *stamp = NULL;
 
-                            if (theta1 < theta0 - PI) theta1 += TWOPI;
-                            if (theta1 > theta0 + PI) theta1 -= TWOPI;
+    ROUTINE(colorSMF);
+    DPRINT2("%s(n=%d) {",
+            routine, n);
 
-                            uv[iv1].u = xyz[iv1].x;
-                            uv[iv1].v = theta1;
-                            change++;
-                        }
+    /* ----------------------------------------------------------------------- */
 
-                        if (uv[iv2].u < xmin) {
-                            theta2 = atan2(xyz[iv2].y - ycent, xyz[iv2].z - zcent);
+    *ncolor = 0;
+    *icolor = NULL;
+    *jcolor = NULL;
 
-                            if (theta2 < theta0 - PI) theta2 += TWOPI;
-                            if (theta2 > theta0 + PI) theta2 -= TWOPI;
+    /*
+     * build the transpose structure so the conflicts are symmetric
+     */
+    MALLOC(it,    int, n+1);
+    MALLOC(jt,    int, ismf[n]-ismf[0]+1);
+    MALLOC(color, int, n  );
 
-                            uv[iv2].u = xyz[iv2].x;
-                            uv[iv2].v = theta2;
-                            change++;
-                        }
-                    }
+    for (i = 0; i <= n; i++) {
+        it[i] = 0;
+    }
+    for (i = 0; i < n; i++) {
+        for (k = ismf[i]; k < ismf[i+1]; k++) {
+            it[ismf[k]+1]++;
+        }
+    }
+    for (i = 0; i < n; i++) {
+        it[i+1] += it[i];
+        color[i] = it[i];
+    }
+    for (i = 0; i < n; i++) {
+        for (k = ismf[i]; k < ismf[i+1]; k++) {
+            jt[color[ismf[k]]++] = i;
+        }
+    }
 
-                    if (uv[iv1].u >= xmin) {
-                        theta1 = uv[iv1].v;
+    maxdeg = 0;
+    for (i = 0; i < n; i++) {
+        maxdeg = MAX(maxdeg, (ismf[i+1] - ismf[i]) + (it[i+1] - it[i]));
+    }
 
-                        if (uv[iv2].u < xmin) {
-                            theta2 = atan2(xyz[iv2].y - ycent, xyz[iv2].z - zcent);
+    MALLOC(stamp, int, maxdeg+1);
+    for (ic = 0; ic <= maxdeg; ic++) {
+        stamp[ic] = -1;
+    }
 
-                            if (theta2 < theta1 - PI) theta2 += TWOPI;
-                            if (theta2 > theta1 + PI) theta2 -= TWOPI;
+    /*
+     * greedy coloring (in row order)
+     */
+    for (i = 0; i < n; i++) {
+        color[i] = -1;
+    }
+    for (i = 0; i < n; i++) {
+        for (k = ismf[i]; k < ismf[i+1]; k++) {
+            j = ismf[k];
+            if (color[j] >= 0) stamp[color[j]] = i;
+        }
+        for (k = it[i]; k < it[i+1]; k++) {
+            j = jt[k];
+            if (color[j] >= 0) stamp[color[j]] = i;
+        }
 
-                            uv[iv2].u = xyz[iv2].x;
-                            uv[iv2].v = theta2;
-                            change++;
-                        }
+        ic = 0;
+        while (stamp[ic] == i) ic++;
+        color[i] = ic;
+        *ncolor  = MAX(*ncolor, ic+1);
+    }
+    DPRINT1("ncolor=%d", *ncolor);
 
-                        if (uv[iv0].u < xmin) {
-                            theta0 = atan2(xyz[iv0].y - ycent, xyz[iv0].z - zcent);
+    /*
+     * store the rows by color
+     */
+    MALLOC(*icolor, int, *ncolor+1);
+    MALLOC(*jcolor, int, n+1      );
 
-                            if (theta0 < theta1 - PI) theta0 += TWOPI;
-                            if (theta0 > theta1 + PI) theta0 -= TWOPI;
+    for (ic = 0; ic <= *ncolor; ic++) {
+        (*icolor)[ic] = 0;
+    }
+    for (i = 0; i < n; i++) {
+        (*icolor)[color[i]+1]++;
+    }
+    for (ic = 0; ic < *ncolor; ic++) {
+        (*icolor)[ic+1] += (*icolor)[ic];
+        stamp[ic]        = (*icolor)[ic];
+    }
+    for (i = 0; i < n; i++) {
+        (*jcolor)[stamp[color[i]]++] = i;
+    }
 
-                            uv[iv0].u = xyz[iv0].x;
-                            uv[iv0].v = theta0;
-                            change++;
-                        }
-                    }
+ cleanup:
+    if (status != EGADS_SUCCESS) {
+        FREE(*icolor);
+        FREE(*jcolor);
+        *ncolor = 0;
+    }
+    FREE(stamp);
+    FREE(color);
+    FREE(jt);
+    FREE(it);
 
-                    if (uv[iv2].u >= xmin) {
-                        theta2 = uv[iv2].v;
+    DPRINT2("%s --> status=%d}", routine, status);
+    return status;
+}
 
-                        if (uv[iv0].u < xmin) {
-                            theta0 = atan2(xyz[iv0].y - ycent, xyz[iv0].z - zcent);
 
-                            if (theta0 < theta2 - PI) theta0 += TWOPI;
-                            if (theta0 > theta2 + PI) theta0 -= TWOPI;
+
+/*
+ ********************************************************************************
+ *                                                                              *
+ * surfaceNormal -- compute surface normal for a Triangle                       *
+ *                                                                              *
+ ********************************************************************************
+ */
+static void
+surfaceNormal(int      iv0,                  /* (in)   first  Vertex (bias-0) */
+              int      iv1,                  /* (in)   second Vertex (bias-0) */
+              int      iv2,                  /* (in)   third  Vertex (bias-0) */
+              prmXYZ   xyz[],                /* (in)   array of Coordinates */
+              double   *area,                /* (out)  area of Triangle */
+              double   norm[])               /* (out)  components of the unit normal */
+{
 
-                            uv[iv0].u = xyz[iv0].x;
-                            uv[iv0].v = theta0;
-                            change++;
-                        }
+//    ROUTINE(surfaceNormal);
 
-                        if (uv[iv1].u < xmin) {
-                            theta1 = atan2(xyz[iv1].y - ycent, xyz[iv1].z - zcent);
+    /* ----------------------------------------------------------------------- */
 
-                            if (theta1 < theta2 - PI) theta1 += TWOPI;
-                            if (theta1 > theta2 + PI) theta1 -= TWOPI;
+    if ((iv0 < 0) || (iv1 < 0) || (iv2 < 0)) {
+        *area   = 0.0;
+        norm[0] = 0.0;
+        norm[1] = 0.0;
+        norm[2] = 0.0;
 
-                            uv[iv1].u = xyz[iv1].x;
-                            uv[iv1].v = theta1;
-                            change++;
-                        }
-                    }
-                }
-                DPRINT1("   change=%d", change);
-            }
+    } else {
+        norm[0] = (xyz[iv1].y - xyz[iv0].y) * (xyz[iv2].z - xyz[iv0].z)
+                - (xyz[iv2].y - xyz[iv0].y) * (xyz[iv1].z - xyz[iv0].z);
+        norm[1] = (xyz[iv1].z - xyz[iv0].z) * (xyz[iv2].x - xyz[iv0].x)
+                - (xyz[iv2].z - xyz[iv0].z) * (xyz[iv1].x - xyz[iv0].x);
+        norm[2] = (xyz[iv1].x - xyz[iv0].x) * (xyz[iv2].y - xyz[iv0].y)
+                - (xyz[iv2].x - xyz[iv0].x) * (xyz[iv1].y - xyz[iv0].y);
 
-            /*
-             * make sure that all Triangles have outward pointing normals
-             */
-            nneg = 0;
-            for (itri = 0; itri < ntri; itri++) {
-                iv0 = tri[itri].indices[0] - 1;
-                iv1 = tri[itri].indices[1] - 1;
-                iv2 = tri[itri].indices[2] - 1;
+        *area = NORM012(norm);
 
-                area = (uv[iv1].u - uv[iv0].u) * (uv[iv2].v - uv[iv0].v)
-                     - (uv[iv1].v - uv[iv0].v) * (uv[iv2].u - uv[iv0].u);
-                if (area <= 0) {
-                    nneg++;
-                }
-            }
-
-            /*
-             * if we got here, then the x-axial projection was successful
-             */
-            if (nneg == 0) {
-                DPRINT0("   x-axial projection was successful");
-
-                status = PRM_OK_AXIAL;
-                goto cleanup;
-            } else {
-                DPRINT2("   there were %d non-positive areas (ntri=%d)", nneg, ntri);
-            }
+        if ((*area) > 0) {
+            norm[0] /= (*area);
+            norm[1] /= (*area);
+            norm[2] /= (*area);
         }
     }
 
-    /*
-     * the y-extent is larger than the other two extents, so try an
-     *    axis that is aligned with the y-axis
-     */
-    if ((ymax-ymin) > (zmax-zmin) && (ymax-ymin) > (xmax-xmin)) {
-        DPRINT0("potential axis in y-direction");
+// cleanup:
+}
 
-        /*
-         * find the center of the Vertices within the last 1 percent of the x extent
-         */
-        dy   = 0.01 * (ymax - ymin);
 
-        zmin1 = +HUGEQ;
-        zmax1 = -HUGEQ;
-        zmin2 = +HUGEQ;
-        zmax2 = -HUGEQ;
-        xmin1 = +HUGEQ;
-        xmax1 = -HUGEQ;
-        xmin2 = +HUGEQ;
-        xmax2 = -HUGEQ;
+
+/*
+ ********************************************************************************
+ *                                                                              *
+ * smoothDelta -- gather the smoothing changes at a range of Vertices           *
+ *                                                                              *
+ ********************************************************************************
+ */
+static void
+smoothDelta(void     *data,                  /* (in)   prmSmooth structure */
+            int      ilo,                    /* (in)   first Vertex */
+            int      ihi)                    /* (in)   last  Vertex (+1) */
+{
+    prmSmooth   *smooth = (prmSmooth *) data;
+    prmTri      *tri    = smooth->tri;
+    prmUV       *uv     = smooth->uv;
 
-        for (ivrt = 0; ivrt < nvrt; ivrt++) {
-            if (xyz[ivrt].y < ymin+dy) {
-                zmin1 = MIN(zmin1, xyz[ivrt].z);
-                zmax1 = MAX(zmax1, xyz[ivrt].z);
-                xmin1 = MIN(xmin1, xyz[ivrt].x);
-                xmax1 = MAX(xmax1, xyz[ivrt].x);
-            } else if (xyz[ivrt].y > ymax-dy) {
-                zmin2 = MIN(zmin2, xyz[ivrt].z);
-                zmax2 = MAX(zmax2, xyz[ivrt].z);
-                xmin2 = MIN(xmin2, xyz[ivrt].x);
-                xmax2 = MAX(xmax2, xyz[ivrt].x);
+    int         ivrt, k, itri, ic, iv0, iv1, iv2, bound;
+    double      usum, vsum, du, dv, nn;
+
+    /* ----------------------------------------------------------------------- */
+
+    for (ivrt = ilo; ivrt < ihi; ivrt++) {
+        du    = 0;
+        dv    = 0;
+        nn    = 0;
+        bound = 0;
+
+        /* same Triangle (and corner) order as a sweep over the Triangles */
+        for (k = smooth->adj->itri[ivrt]; k < smooth->adj->itri[ivrt+1]; k++) {
+            itri = smooth->adj->jtri[k] / 3;
+            ic   = smooth->adj->jtri[k] % 3;
+
+            iv0 = tri[itri].indices[0] - 1;
+            iv1 = tri[itri].indices[1] - 1;
+            iv2 = tri[itri].indices[2] - 1;
+
+            usum = uv[iv0].u + uv[iv1].u + uv[iv2].u;
+            vsum = uv[iv0].v + uv[iv1].v + uv[iv2].v;
+
+            du += usum - 3 * uv[ivrt].u;
+            dv += vsum - 3 * uv[ivrt].v;
+            nn += 2;
+
+            if (tri[itri].neigh[(ic+1)%3] <= 0 || tri[itri].neigh[(ic+2)%3] <= 0) {
+                bound = 1;
             }
         }
 
-        zmin = MAX(zmin1, zmin2);
-        zmax = MIN(zmax1, zmax2);
-        xmin = MAX(xmin1, xmin2);
-        xmax = MIN(xmax1, xmax2);
-
         /*
-         * try placing the axis at the center and at each of the extents
+         * zero out du and dv on the boundary
          */
-        for (pass = 0; pass < 5; pass++) {
-            if (pass == 0) {
-                ycent = (ymin + ymax) / 2;
-                zcent = (zmin + zmax) / 2;
-                xcent = (xmin + xmax) / 2;
-            } else if (pass == 1) {
-                ycent = (ymin + ymax) / 2;
-                zcent =  zmin            ;
-                xcent = (xmin + xmax) / 2;
-            } else if (pass == 2) {
-                ycent = (ymin + ymax) / 2;
-                zcent =         zmax     ;
-                xcent = (xmin + xmax) / 2;
-            } else if (pass == 3) {
-                ycent = (ymin + ymax) / 2;
-                zcent = (zmin + zmax) / 2;
-                xcent =  xmin            ;
-            } else {
-                ycent = (ymin + ymax) / 2;
-                zcent = (zmin + zmax) / 2;
-                xcent =         xmax     ;
-            }
-            DPRINT3("xcent=%10.5f  ycent=%10.5f  zcent=%10.5f", xcent, ycent, zcent);
+        if (bound == 1) {
+            du = 0.0;
+            dv = 0.0;
+        }
 
-            /*
-             * assign u=y and v=theta for every Veretx
-             */
-            for (ivrt = 0; ivrt < nvrt; ivrt++) {
-                uv[ivrt].u = ymin - 1;
-            }
+        smooth->du[ivrt] = du;
+        smooth->dv[ivrt] = dv;
+        smooth->nn[ivrt] = nn;
+    }
+}
 
-            uv[0].u = xyz[0].y;
-            uv[0].v = atan2(xyz[0].z - zcent, xyz[0].x - xcent);
 
-            change = 1;
-            while (change > 0) {
-                change = 0;
 
-                for (itri = 0; itri < ntri; itri++) {
-                    iv0 = tri[itri].indices[0] - 1;
-                    iv1 = tri[itri].indices[1] - 1;
-                    iv2 = tri[itri].indices[2] - 1;
+
+/*
+ ********************************************************************************
+ *                                                                              *
+ * smoothUpdate -- apply the smoothing changes at a range of Vertices           *
+ *                                                                              *
+ ********************************************************************************
+ */
+static void
+smoothUpdate(void     *data,                 /* (in)   prmSmooth structure */
+             int      ilo,                   /* (in)   first Vertex */
+             int      ihi)                   /* (in)   last  Vertex (+1) */
+{
+    prmSmooth   *smooth = (prmSmooth *) data;
 
+    int         ivrt;
 
-                    if (uv[iv0].u >= ymin) {
-                        theta0 = uv[iv0].v;
+    /* ----------------------------------------------------------------------- */
 
-                        if (uv[iv1].u < ymin) {
-                            theta1 = atan2(xyz[iv1].z - zcent, xyz[iv1].x - xcent);
+    for (ivrt = ilo; ivrt < ihi; ivrt++) {
+        if (smooth->nn[ivrt] <= 0) continue;
 
-                            if (theta1 < theta0 - PI) theta1 += TWOPI;
-                            if (theta1 > theta0 + PI) theta1 -= TWOPI;
+        smooth->uv[ivrt].u += smooth->omega * smooth->du[ivrt] / smooth->nn[ivrt];
+        smooth->uv[ivrt].v += smooth->omega * smooth->dv[ivrt] / smooth->nn[ivrt];
+    }
+}
 
-                            uv[iv1].u = xyz[iv1].y;
-                            uv[iv1].v = theta1;
-                            change++;
-                        }
 
-                        if (uv[iv2].u < ymin) {
-                            theta2 = atan2(xyz[iv2].z - zcent, xyz[iv2].x - xcent);
 
-                            if (theta2 < theta0 - PI) theta2 += TWOPI;
-                            if (theta2 > theta0 + PI) theta2 -= TWOPI;
+
+/*
+ ********************************************************************************
+ *                                                                              *
+ * smoothArea -- smallest (UV) area over a range of Triangles                   *
+ *                                                                              *
+ ********************************************************************************
+ */
+static void
+smoothArea(void     *data,                   /* (in)   prmSmooth structure */
+           int      ilo,                     /* (in)   first Triangle */
+           int      ihi)                     /* (in)   last  Triangle (+1) */
+{
+    prmSmooth   *smooth = (prmSmooth *) data;
+    prmTri      *tri    = smooth->tri;
+    prmUV       *uv     = smooth->uv;
+    double      *part   = &smooth->part[ilo/VRTCHUNK];
 
-                            uv[iv2].u = xyz[iv2].y;
-                            uv[iv2].v = theta2;
-                            change++;
-                        }
-                    }
+    int         itri, iv0, iv1, iv2;
+    double      area2;
 
-                    if (uv[iv1].u >= ymin) {
-                        theta1 = uv[iv1].v;
+    /* ----------------------------------------------------------------------- */
 
-                        if (uv[iv2].u < ymin) {
-                            theta2 = atan2(xyz[iv2].z - zcent, xyz[iv2].x - xcent);
+    part[0] = +HUGEQ;
+    for (itri = ilo; itri < ihi; itri++) {
+        iv0 = tri[itri].indices[0] - 1;
+        iv1 = tri[itri].indices[1] - 1;
+        iv2 = tri[itri].indices[2] - 1;
 
-                            if (theta2 < theta1 - PI) theta2 += TWOPI;
-                            if (theta2 > theta1 + PI) theta2 -= TWOPI;
+        area2 = (uv[iv1].u - uv[iv0].u) * (uv[iv2].v - uv[iv0].v)
+              - (uv[iv1].v - uv[iv0].v) * (uv[iv2].u - uv[iv0].u);
+        part[0] = MIN(part[0], area2);
+    }
+}
 
-                            uv[iv2].u = xyz[iv2].y;
-                            uv[iv2].v = theta2;
-                            change++;
-                        }
 
-                        if (uv[iv0].u < ymin) {
-                            theta0 = atan2(xyz[iv0].z - zcent, xyz[iv0].x - xcent);
 
-                            if (theta0 < theta1 - PI) theta0 += TWOPI;
-                            if (theta0 > theta1 + PI) theta0 -= TWOPI;
+
+/*
+ ********************************************************************************
+ *                                                                              *
+ * smoothUVcoords -- smooth UV coordinates                                      *
+ *                                                                              *
+ ********************************************************************************
+ */
+static int
+smoothUVcoords(int      ntri,                /* (in)   number of Triangles */
+               prmTri   tri[],               /* (in)   array  of Triangles */
+               int      nvrt,                /* (in)   number of Vertices */
+               prmAdj   *adj,                /* (in)   Vertex-to-Triangle adjacency */
+               EMPteam  *team,               /* (in)   team of threads to use */
+               prmUV    uv[],                /* (both) array of Parameters */
+               double   *amin)               /* (out)  minimum area */
+{
+    int         status = EGADS_SUCCESS;      /* (out)  return status */
+                                             /*        EGADS_SUCCESS */
 
-                            uv[iv0].u = xyz[iv0].y;
-                            uv[iv0].v = theta0;
-                            change++;
-                        }
-                    }
+    int         i;
+    prmSmooth   smooth;
 
-                    if (uv[iv2].u >= ymin) {
-                        theta2 = uv[iv2].v;
+    ROUTINE(smoothUVcoords);
+    DPRINT3("%s(ntri=%d, nvrt=%d) {",
+            routine, ntri, nvrt);
 
-                        if (uv[iv0].u < ymin) {
-                            theta0 = atan2(xyz[iv0].z - zcent, xyz[iv0].x - xcent);
+    /* ----------------------------------------------------------------------- */
 
-                            if (theta0 < theta2 - PI) theta0 += TWOPI;
-                            if (theta0 > theta2 + PI) theta0 -= TWOPI;
+    smooth.tri   = tri;
+    smooth.adj   = adj;
+    smooth.uv    = uv;
+    smooth.du    = NULL;
+    smooth.dv    = NULL;
+    smooth.nn    = NULL;
+    smooth.part  = NULL;
+    smooth.omega = 0.50;
 
-                            uv[iv0].u = xyz[iv0].y;
-                            uv[iv0].v = theta0;
-                            change++;
-                        }
+    /*
+     * get work arrays
+     */
+    MALLOC(smooth.du, double, nvrt);
+    MALLOC(smooth.dv, double, nvrt);
+    MALLOC(smooth.nn, double, nvrt);
+    MALLOC(smooth.part, double, NCHUNK(ntri)+1);
 
-                        if (uv[iv1].u < ymin) {
-                            theta1 = atan2(xyz[iv1].z - zcent, xyz[iv1].x - xcent);
+    /*
+     * gather sums (du, dv, and nn) at each of the Vertices (zero on the
+     *    boundary) and then update the Vertex locations with under-relaxation
+     *    (Jacobi, so each half is independent per Vertex)
+     */
+    teamRun(team, nvrt, VRTCHUNK, smoothDelta,  &smooth);
+    teamRun(team, nvrt, VRTCHUNK, smoothUpdate, &smooth);
 
-                            if (theta1 < theta2 - PI) theta1 += TWOPI;
-                            if (theta1 > theta2 + PI) theta1 -= TWOPI;
+    /*
+     * keep track of the smallest area
+     */
+    teamRun(team, ntri, VRTCHUNK, smoothArea,   &smooth);
 
-                            uv[iv1].u = xyz[iv1].y;
-                            uv[iv1].v = theta1;
-                            change++;
-                        }
-                    }
-                }
-                DPRINT1("   change=%d", change);
-            }
+    *amin = +HUGEQ;
+    for (i = 0; i < NCHUNK(ntri); i++) {
+        *amin = MIN(*amin, smooth.part[i]);
+    }
 
-            /*
-             * make sure that all Triangles have outward pointing normals
-             */
-            nneg = 0;
-            for (itri = 0; itri < ntri; itri++) {
-                iv0 = tri[itri].indices[0] - 1;
-                iv1 = tri[itri].indices[1] - 1;
-                iv2 = tri[itri].indices[2] - 1;
+ cleanup:
+    FREE(smooth.part);
+    FREE(smooth.du);
+    FREE(smooth.dv);
+    FREE(smooth.nn);
 
-                area = (uv[iv1].u - uv[iv0].u) * (uv[iv2].v - uv[iv0].v)
-                     - (uv[iv1].v - uv[iv0].v) * (uv[iv2].u - uv[iv0].u);
-                if (area <= 0) {
-                    nneg++;
-                }
-            }
+    DPRINT2("%s --> status=%d}", routine, status);
+    return status;
+}
 
-            /*
-             * if we got here, then the y-axial projection was successful
-             */
-            if (nneg == 0) {
-                DPRINT0("   y-axial projection was successful");
 
-                status = PRM_OK_AXIAL;
-                goto cleanup;
-            } else {
-                DPRINT2("   there were %d non-positive areas (ntri=%d)", nneg, ntri);
-            }
-        }
+
+/*
+ ********************************************************************************
+ *                                                                              *
+ * layDownTriangle -- lay down a Triangle to unroll                             *
+ *                                                                              *
+ ********************************************************************************
+ */
+static void
+layDownTriangle(prmXYZ    xyz[],             /* (both) array of Coordinates */
+                prmUV     uv[],              /* (both) array of Parameters */
+                int       iv0,               /* (in)   base Vertex 1 */
+                int       iv1,               /* (in)   base Vertex 2 */
+                int       iv2)               /* (in)   Vertex to be defined */
+{
+    double len01, len12, len20, phi, tht, area;
+
+//    ROUTINE(layDownTriangle);
+
+    /* ----------------------------------------------------------------------- */
+
+    /*
+     * compute lengths
+     */
+    len01 = sqrt(  SQR(xyz[iv0].x - xyz[iv1].x)
+                 + SQR(xyz[iv0].y - xyz[iv1].y)
+                 + SQR(xyz[iv0].z - xyz[iv1].z));
+    len12 = sqrt(  SQR(xyz[iv1].x - xyz[iv2].x)
+                 + SQR(xyz[iv1].y - xyz[iv2].y)
+                 + SQR(xyz[iv1].z - xyz[iv2].z));
+    len20 = sqrt(  SQR(xyz[iv2].x - xyz[iv0].x)
+                 + SQR(xyz[iv2].y - xyz[iv0].y)
+                 + SQR(xyz[iv2].z - xyz[iv0].z));
+
+    /*
+     * place Vertex iv2 (using law of cosines)
+     */
+    phi = atan2(uv[iv1].v - uv[iv0].v, uv[iv1].u - uv[iv0].u);
+    tht = ACOS( (SQR(len01) - SQR(len12) + SQR(len20))
+              / (    len01  *   2.0      *     len20 ));
+
+    uv[iv2].u = uv[iv0].u + len20 * cos(phi - tht);
+    uv[iv2].v = uv[iv0].v + len20 * sin(phi - tht);
+
+    /*
+     * make Triangle on other side of 0-1 if a negative area
+     */
+    area = (uv[iv1].u - uv[iv0].u) * (uv[iv2].v - uv[iv0].v)
+         - (uv[iv1].v - uv[iv0].v) * (uv[iv2].u - uv[iv0].u);
+
+    if (area < 0.0) {
+        uv[iv2].u = uv[iv0].u + len20 * cos(phi + tht);
+        uv[iv2].v = uv[iv0].v + len20 * sin(phi + tht);
     }
+}
+
+
+
+/*
+ ********************************************************************************
+ *                                                                              *
+ * layDownTriangle2 -- lay down a Triangle for jones' transformation            *
+ *                                                                              *
+ ********************************************************************************
+ */
+static void
+layDownTriangle2(prmUV     uv[],
+                 double    u0,
+                 double    v0,
+                 int       iv0,
+                 double    u1,
+                 double    v1,
+                 int       iv1,
+                 double    u2,
+                 double    v2,
+                 int       iv2)
+{
+    double len01, len12, len20, phi, tht;
+
+//    ROUTINE(layDownTriangle2);
+
+    /* ----------------------------------------------------------------------- */
 
     /*
-     * the z-extent is larger than the other two extents, so try an
-     *    axis that is aligned with the z-axis
+     * compute lengths
      */
-    if ((zmax-zmin) > (xmax-xmin) && (zmax-zmin) > (ymax-ymin)) {
-        DPRINT0("potential axis in z-direction");
+    len01 = sqrt(SQR(u0 - u1) + SQR(v0 - v1));
+    len12 = sqrt(SQR(u1 - u2) + SQR(v1 - v2));
+    len20 = sqrt(SQR(u2 - u0) + SQR(v2 - v0));
+
+    /*
+     * place Vertex iv2 (using law of cosines)
+     */
+    phi = atan2(uv[iv1].v - uv[iv0].v,
+                uv[iv1].u - uv[iv0].u);
+    tht = ACOS((SQR(len20) - SQR(len12) + SQR(len01)) / (2.0 * len20 * len01));
+
+    uv[iv2].u = uv[iv0].u + len20 * cos(phi + tht);
+    uv[iv2].v = uv[iv0].v + len20 * sin(phi + tht);
+}
+
+
+
+/*
+ ********************************************************************************
+ *                                                                              *
+ * axialProjection -- use axial projection (if possible)                        *
+ *                                                                              *
+ ********************************************************************************
+ */
+static int
+axialProjection(int          ntri,           /* (in)   number of Triangles */
+                prmTri       tri[],          /* (in)   array  of Triangles */
+                int          nvrt,           /* (in)   number of Vertices */
+                prmXYZ       xyz[],          /* (in)   array  of Coordinates */
+                prmUV        uv[])           /* (out)  array  of Parameters */
+{
+    int         status = PRM_NOGLOBALUV;     /* (out)  return status */
+                                             /*        PRM_NOGLOBALUV */
+                                             /*        PRM_OK_AXIAL */
+
+    double      area;
+    int         change;
+    double      dx, dy, dz;
+    int         itri;
+    int         ivrt, iv0, iv1, iv2;
+    int         nneg;
+    int         pass;
+    double      theta0, theta1, theta2;
+    double      xcent, ycent, zcent;
+    double      xmin,  xmax,  ymin,  ymax,  zmin,  zmax;
+    double      xmin1, xmax1, ymin1, ymax1, zmin1, zmax1;
+    double      xmin2, xmax2, ymin2, ymax2, zmin2, zmax2;
+
+    ROUTINE(axialProjection);
+    DPRINT3("%s(ntri=%d, nvrt=%d) {",
+            routine, ntri, nvrt);
+
+    /* ----------------------------------------------------------------------- */
+
+    /*
+     * find the minimum and maximum extents of the Vertices in the tessellation
+     */
+    xmin = xyz[0].x;
+    xmax = xyz[0].x;
+    ymin = xyz[0].y;
+    ymax = xyz[0].y;
+    zmin = xyz[0].z;
+    zmax = xyz[0].z;
+
+    for (ivrt = 1; ivrt < nvrt; ivrt++) {
+        xmin = MIN(xmin, xyz[ivrt].x);
+        xmax = MAX(xmax, xyz[ivrt].x);
+        ymin = MIN(ymin, xyz[ivrt].y);
+        ymax = MAX(ymax, xyz[ivrt].y);
+        zmin = MIN(zmin, xyz[ivrt].z);
+        zmax = MAX(zmax, xyz[ivrt].z);
+    }
+    DPRINT3("xmin=%10.5f   ymin=%10.5f   zmin=%10.5f", xmin, ymin, zmin);
+    DPRINT3("xmax=%10.5f   ymax=%10.5f   zmax=%10.5f", xmax, ymax, zmax);
+
+    /*
+     * the x-extent is larger than the other two extents, so try an
+     *    axis that is aligned with the x-axis
+     */
+    if ((xmax-xmin) > (ymax-ymin) && (xmax-xmin) > (zmax-zmin)) {
+        DPRINT0("potential axis in x-direction");
 
         /*
          * find the center of the Vertices within the last 1 percent of the x extent
          */
-        dz   = 0.01 * (zmax - zmin);
+        dx   = 0.01 * (xmax - xmin);
 
-        xmin1 = +HUGEQ;
-        xmax1 = -HUGEQ;
-        xmin2 = +HUGEQ;
-        xmax2 = -HUGEQ;
         ymin1 = +HUGEQ;
         ymax1 = -HUGEQ;
         ymin2 = +HUGEQ;
         ymax2 = -HUGEQ;
+        zmin1 = +HUGEQ;
+        zmax1 = -HUGEQ;
+        zmin2 = +HUGEQ;
+        zmax2 = -HUGEQ;
 
         for (ivrt = 0; ivrt < nvrt; ivrt++) {
-            if (xyz[ivrt].z < zmin+dz) {
-                xmin1 = MIN(xmin1, xyz[ivrt].x);
-                xmax1 = MAX(xmax1, xyz[ivrt].x);
+            if (xyz[ivrt].x < xmin+dx) {
                 ymin1 = MIN(ymin1, xyz[ivrt].y);
                 ymax1 = MAX(ymax1, xyz[ivrt].y);
-            } else if (xyz[ivrt].z > zmax-dz) {
-                xmin2 = MIN(xmin2, xyz[ivrt].x);
-                xmax2 = MAX(xmax2, xyz[ivrt].x);
+                zmin1 = MIN(zmin1, xyz[ivrt].z);
+                zmax1 = MAX(zmax1, xyz[ivrt].z);
+            } else if (xyz[ivrt].x > xmax-dx) {
                 ymin2 = MIN(ymin2, xyz[ivrt].y);
                 ymax2 = MAX(ymax2, xyz[ivrt].y);
+                zmin2 = MIN(zmin2, xyz[ivrt].z);
+                zmax2 = MAX(zmax2, xyz[ivrt].z);
             }
         }
 
-        xmin = MAX(xmin1, xmin2);
-        xmax = MIN(xmax1, xmax2);
         ymin = MAX(ymin1, ymin2);
         ymax = MIN(ymax1, ymax2);
+        zmin = MAX(zmin1, zmin2);
+        zmax = MIN(zmax1, zmax2);
 
         /*
          * try placing the axis at the center and at each of the extents
          */
         for (pass = 0; pass < 5; pass++) {
             if (pass == 0) {
-                zcent = (zmin + zmax) / 2;
                 xcent = (xmin + xmax) / 2;
                 ycent = (ymin + ymax) / 2;
+                zcent = (zmin + zmax) / 2;
             } else if (pass == 1) {
+                xcent = (xmin + xmax) / 2;
+                ycent =  ymin            ;
                 zcent = (zmin + zmax) / 2;
-                xcent =  xmin            ;
-                ycent = (ymin + ymax) / 2;
             } else if (pass == 2) {
+                xcent = (xmin + xmax) / 2;
+                ycent =         ymax     ;
                 zcent = (zmin + zmax) / 2;
-                xcent =         xmax     ;
-                ycent = (ymin + ymax) / 2;
             } else if (pass == 3) {
-                zcent = (zmin + zmax) / 2;
                 xcent = (xmin + xmax) / 2;
-                ycent =  ymin            ;
+                ycent = (ymin + ymax) / 2;
+                zcent =  zmin            ;
             } else {
-                zcent = (zmin + zmax) / 2;
                 xcent = (xmin + xmax) / 2;
-                ycent =         ymax     ;
+                ycent = (ymin + ymax) / 2;
+                zcent =         zmax     ;
             }
             DPRINT3("xcent=%10.5f  ycent=%10.5f  zcent=%10.5f", xcent, ycent, zcent);
 
@@ -1261,11 +1528,11 @@ axialProjection(int          ntri,           /* (in)   number of Triangles */
              * assign u=x and v=theta for every Vertex
              */
             for (ivrt = 0; ivrt < nvrt; ivrt++) {
-                uv[ivrt].u = zmin - 1;
+                uv[ivrt].u = xmin - 1;
             }
 
-            uv[0].u = xyz[0].z;
-            uv[0].v = atan2(xyz[0].x - xcent, xyz[0].y - ycent);
+            uv[0].u = xyz[0].x;
+            uv[0].v = atan2(xyz[0].y - ycent, xyz[0].z - zcent);
 
             change = 1;
             while (change > 0) {
@@ -1277,79 +1544,79 @@ axialProjection(int          ntri,           /* (in)   number of Triangles */
                     iv2 = tri[itri].indices[2] - 1;
 
 
-                    if (uv[iv0].u >= zmin) {
+                    if (uv[iv0].u >= xmin) {
                         theta0 = uv[iv0].v;
 
-                        if (uv[iv1].u < zmin) {
-                            theta1 = atan2(xyz[iv1].x - xcent, xyz[iv1].y - ycent);
+                        if (uv[iv1].u < xmin) {
+                            theta1 = atan2(xyz[iv1].y - ycent, xyz[iv1].z - zcent);
 
                             if (theta1 < theta0 - PI) theta1 += TWOPI;
                             if (theta1 > theta0 + PI) theta1 -= TWOPI;
 
-                            uv[iv1].u = xyz[iv1].z;
+                            uv[iv1].u = xyz[iv1].x;
                             uv[iv1].v = theta1;
                             change++;
                         }
 
-                        if (uv[iv2].u < zmin) {
-                            theta2 = atan2(xyz[iv2].x - xcent, xyz[iv2].y - ycent);
+                        if (uv[iv2].u < xmin) {
+                            theta2 = atan2(xyz[iv2].y - ycent, xyz[iv2].z - zcent);
 
                             if (theta2 < theta0 - PI) theta2 += TWOPI;
                             if (theta2 > theta0 + PI) theta2 -= TWOPI;
 
-                            uv[iv2].u = xyz[iv2].z;
+                            uv[iv2].u = xyz[iv2].x;
                             uv[iv2].v = theta2;
                             change++;
                         }
                     }
 
-                    if (uv[iv1].u >= zmin) {
+                    if (uv[iv1].u >= xmin) {
                         theta1 = uv[iv1].v;
 
-                        if (uv[iv2].u < zmin) {
-                            theta2 = atan2(xyz[iv2].x - xcent, xyz[iv2].y - ycent);
+                        if (uv[iv2].u < xmin) {
+                            theta2 = atan2(xyz[iv2].y - ycent, xyz[iv2].z - zcent);
 
                             if (theta2 < theta1 - PI) theta2 += TWOPI;
                             if (theta2 > theta1 + PI) theta2 -= TWOPI;
 
-                            uv[iv2].u = xyz[iv2].z;
+                            uv[iv2].u = xyz[iv2].x;
                             uv[iv2].v = theta2;
                             change++;
                         }
 
-                        if (uv[iv0].u < zmin) {
-                            theta0 = atan2(xyz[iv0].x - xcent, xyz[iv0].y - ycent);
+                        if (uv[iv0].u < xmin) {
+                            theta0 = atan2(xyz[iv0].y - ycent, xyz[iv0].z - zcent);
 
                             if (theta0 < theta1 - PI) theta0 += TWOPI;
                             if (theta0 > theta1 + PI) theta0 -= TWOPI;
 
-                            uv[iv0].u = xyz[iv0].z;
+                            uv[iv0].u = xyz[iv0].x;
                             uv[iv0].v = theta0;
                             change++;
                         }
                     }
 
-                    if (uv[iv2].u >= zmin) {
+                    if (uv[iv2].u >= xmin) {
                         theta2 = uv[iv2].v;
 
-                        if (uv[iv0].u < zmin) {
-                            theta0 = atan2(xyz[iv0].x - xcent, xyz[iv0].y - ycent);
+                        if (uv[iv0].u < xmin) {
+                            theta0 = atan2(xyz[iv0].y - ycent, xyz[iv0].z - zcent);
 
                             if (theta0 < theta2 - PI) theta0 += TWOPI;
                             if (theta0 > theta2 + PI) theta0 -= TWOPI;
 
-                            uv[iv0].u = xyz[iv0].z;
+                            uv[iv0].u = xyz[iv0].x;
                             uv[iv0].v = theta0;
                             change++;
                         }
 
-                        if (uv[iv1].u < zmin) {
-                            theta1 = atan2(xyz[iv1].x - xcent, xyz[iv1].y - ycent);
+                        if (uv[iv1].u < xmin) {
+                            theta1 = atan2(xyz[iv1].y - ycent, xyz[iv1].z - zcent);
 
                             if (theta1 < theta2 - PI) theta1 += TWOPI;
                             if (theta1 > theta2 + PI) theta1 -= TWOPI;
 
-                            uv[iv1].u = xyz[iv1].z;
+                            uv[iv1].u = xyz[iv1].x;
                             uv[iv1].v = theta1;
                             change++;
                         }
@@ -1375,10 +1642,10 @@ axialProjection(int          ntri,           /* (in)   number of Triangles */
             }
 
             /*
-             * if we got here, then the z-axial projection was successful
+             * if we got here, then the x-axial projection was successful
              */
             if (nneg == 0) {
-                DPRINT0("   z-axial projection was successful");
+                DPRINT0("   x-axial projection was successful");
 
                 status = PRM_OK_AXIAL;
                 goto cleanup;
@@ -1388,1147 +1655,1370 @@ axialProjection(int          ntri,           /* (in)   number of Triangles */
         }
     }
 
-    status = PRM_NOGLOBALUV;
+    /*
+     * the y-extent is larger than the other two extents, so try an
+     *    axis that is aligned with the y-axis
+     */
+    if ((ymax-ymin) > (zmax-zmin) && (ymax-ymin) > (xmax-xmin)) {
+        DPRINT0("potential axis in y-direction");
 
- cleanup:
-    DPRINT2("%s --> status=%d}", routine, status);
-    return status;
-}
+        /*
+         * find the center of the Vertices within the last 1 percent of the x extent
+         */
+        dy   = 0.01 * (ymax - ymin);
 
+        zmin1 = +HUGEQ;
+        zmax1 = -HUGEQ;
+        zmin2 = +HUGEQ;
+        zmax2 = -HUGEQ;
+        xmin1 = +HUGEQ;
+        xmax1 = -HUGEQ;
+        xmin2 = +HUGEQ;
+        xmax2 = -HUGEQ;
 
-
-/*
- ********************************************************************************
- *                                                                              *
- * floaterParameterization -- use floater's transformation (if possible)        *
- *                                                                              *
- ********************************************************************************
- */
-static int
-floaterParameterization(int        ntri,     /* (in)   number of Triangles */
-                        prmTri     tri[],    /* (in)   array  of Triangles */
-                        int        nvrt,     /* (in)   number of Vertices */
-                        prmXYZ     xyz[],    /* (in)   array  of Coordinates */
-                        prmUV      uv[])     /* (out)  array of  Parameters */
-{
-    int         status = PRM_NOGLOBALUV;     /* (out)  return status */
-                                             /*        PRM_NOGLOBALUV */
-                                             /*        PRM_OK_FLOATER */
+        for (ivrt = 0; ivrt < nvrt; ivrt++) {
+            if (xyz[ivrt].y < ymin+dy) {
+                zmin1 = MIN(zmin1, xyz[ivrt].z);
+                zmax1 = MAX(zmax1, xyz[ivrt].z);
+                xmin1 = MIN(xmin1, xyz[ivrt].x);
+                xmax1 = MAX(xmax1, xyz[ivrt].x);
+            } else if (xyz[ivrt].y > ymax-dy) {
+                zmin2 = MIN(zmin2, xyz[ivrt].z);
+                zmax2 = MAX(zmax2, xyz[ivrt].z);
+                xmin2 = MIN(xmin2, xyz[ivrt].x);
+                xmax2 = MAX(xmax2, xyz[ivrt].x);
+            }
+        }
 
-    typedef struct {
-        int     vrt;                         /* first Vertex in Loop */
-        int     nvrt;                        /* number of Vertex in Loop */
-        double  alen;                        /* length (in XYZ) of Loop */
-    } lup_t;
+        zmin = MAX(zmin1, zmin2);
+        zmax = MIN(zmax1, zmax2);
+        xmin = MAX(xmin1, xmin2);
+        xmax = MIN(xmax1, xmax2);
 
-    lup_t       *lups = NULL;                /* array  of Loops */
-    int         nlup;                        /* number of Loops */
+        /*
+         * try placing the axis at the center and at each of the extents
+         */
+        for (pass = 0; pass < 5; pass++) {
+            if (pass == 0) {
+                ycent = (ymin + ymax) / 2;
+                zcent = (zmin + zmax) / 2;
+                xcent = (xmin + xmax) / 2;
+            } else if (pass == 1) {
+                ycent = (ymin + ymax) / 2;
+                zcent =  zmin            ;
+                xcent = (xmin + xmax) / 2;
+            } else if (pass == 2) {
+                ycent = (ymin + ymax) / 2;
+                zcent =         zmax     ;
+                xcent = (xmin + xmax) / 2;
+            } else if (pass == 3) {
+                ycent = (ymin + ymax) / 2;
+                zcent = (zmin + zmax) / 2;
+                xcent =  xmin            ;
+            } else {
+                ycent = (ymin + ymax) / 2;
+                zcent = (zmin + zmax) / 2;
+                xcent =         xmax     ;
+            }
+            DPRINT3("xcent=%10.5f  ycent=%10.5f  zcent=%10.5f", xcent, ycent, zcent);
 
-    typedef struct {
-        int     next;                        /* next boundary Vertex */
-        int     lup;                         /* Loop number */
-        double  ang;                         /* angle at Loop Vertices */
-    } vrt_t;
-    vrt_t       *vrts = NULL;                /* array of boundary Vertices */
+            /*
+             * assign u=y and v=theta for every Veretx
+             */
+            for (ivrt = 0; ivrt < nvrt; ivrt++) {
+                uv[ivrt].u = ymin - 1;
+            }
 
-    sparseMat   amat;                        /* full matrix */
-    double      *asmf   = NULL;
-    int         *ismf   = NULL;
-    double      *urhs   = NULL;
-    double      *vrhs   = NULL;
-    prmTri      *newTri = NULL;
-    int         *ihole  = NULL;
-    double      *ahole  = NULL;
+            uv[0].u = xyz[0].y;
+            uv[0].v = atan2(xyz[0].z - zcent, xyz[0].x - xcent);
 
-    double      ang0, ang1, ang2, ang3, ang4, ang5;
-    double      area, amin;
-    double      d1sq, d2sq, d3sq;
-    double      d01sq, d12sq, d20sq, d23sq;
-    double      d30sq, d04sq, d41sq, d15sq, d52sq;
-    double      du, dv;
-    double      dist;
-    double      err=1, erru, errv;
-    int         found;
-    int         i, j, k, ii, nn, im1, ip1;
-    int         imin;
-    int         iter, itmax=1000;
-    int         itri, oldNtri, tmp;
-    int         ivrt, oldIvrt, iv0, iv1, iv2, iv3, iv4, iv5;
-    int         lup;
-    int         newNtri, count;
-    int         nneg;
-    int         outer;
-    double      xold, yold, zold, told, gold, hold;
-    double      xnew, ynew, znew, tnew, unew, vnew;
-    int         nhole;
+            change = 1;
+            while (change > 0) {
+                change = 0;
 
-    double      errtol = 0.000001;
-    double      frac = 0.25;
-    double      omega = 1.6;
+                for (itri = 0; itri < ntri; itri++) {
+                    iv0 = tri[itri].indices[0] - 1;
+                    iv1 = tri[itri].indices[1] - 1;
+                    iv2 = tri[itri].indices[2] - 1;
 
-    ROUTINE(floaterParameterization);
-    DPRINT3("%s(ntri=%d, nvrt=%d) {",
-            routine, ntri, nvrt);
 
-    /* ----------------------------------------------------------------------- */
-  
-    amat.ni = 0;
-    amat.is = NULL;
+                    if (uv[iv0].u >= ymin) {
+                        theta0 = uv[iv0].v;
 
-    /*
-     * allocate storage that will be used to keep track of the Loop
-     *    number and the next Vertex in the Loop
-     */
-    MALLOC(vrts, vrt_t,  nvrt    );
-    MALLOC(lups, lup_t,  MAXLOOPS);
-    MALLOC(urhs, double, nvrt    );
-    MALLOC(vrhs, double, nvrt    );
+                        if (uv[iv1].u < ymin) {
+                            theta1 = atan2(xyz[iv1].z - zcent, xyz[iv1].x - xcent);
 
-    /*
-     * for each Vertex that is along a boundary of the Quilt, keep track of
-     *    the next Vertex on the boundary
-     */
-    DPRINT0("finding next Vertex");
-    for (ivrt = 0; ivrt < nvrt; ivrt++) {
-        vrts[ivrt].next = -1;
-        vrts[ivrt].lup  = -1;
-    }
+                            if (theta1 < theta0 - PI) theta1 += TWOPI;
+                            if (theta1 > theta0 + PI) theta1 -= TWOPI;
 
-    nn = 0;
-    for (itri = 0; itri < ntri; itri++) {
-        iv0 = tri[itri].indices[0] - 1;
-        iv1 = tri[itri].indices[1] - 1;
-        iv2 = tri[itri].indices[2] - 1;
+                            uv[iv1].u = xyz[iv1].y;
+                            uv[iv1].v = theta1;
+                            change++;
+                        }
 
-        if (tri[itri].neigh[0] <= 0) {
-            nn++;
-            if (vrts[iv1].next == -1) {
-                vrts[iv1].next = iv2;
-            }
-        }
-        if (tri[itri].neigh[1] <= 0) {
-            nn++;
-            if (vrts[iv2].next == -1) {
-                vrts[iv2].next = iv0;
-            }
-        }
-        if (tri[itri].neigh[2] <= 0) {
-            nn++;
-            if (vrts[iv0].next == -1) {
-                vrts[iv0].next = iv1;
-            }
-        }
-    }
+                        if (uv[iv2].u < ymin) {
+                            theta2 = atan2(xyz[iv2].z - zcent, xyz[iv2].x - xcent);
 
-    /*
-     * if there are no boundary Triangles, then return without setting UVtype
-     */
-    if (nn == 0) {
-        DPRINT0("no boundary Tiangles were found");
-        status = PRM_NOGLOBALUV;
-        goto cleanup;
-    }
+                            if (theta2 < theta0 - PI) theta2 += TWOPI;
+                            if (theta2 > theta0 + PI) theta2 -= TWOPI;
 
-    /*
-     * associate each boundary Vertex with a Loop
-     */
-    DPRINT0("associating boundary Vertices with Loops");
-    for (ivrt = 0; ivrt < nvrt; ivrt++) {
-        DPRINT2("vrts[%5d].next = %5d", ivrt, vrts[ivrt].next);
-    }
-    nlup = 0;
-    while (1) {
+                            uv[iv2].u = xyz[iv2].y;
+                            uv[iv2].v = theta2;
+                            change++;
+                        }
+                    }
 
-        /*
-         * find a Vertex that has a next but not a Loop
-         */
-        found = 0;
-        for (ivrt = 0; ivrt < nvrt; ivrt++) {
-            if ((vrts[ivrt].next >= 0) && (vrts[ivrt].lup < 0)) {
-                vrts[ivrt].lup = nlup;
-                vrts[ivrt].ang = 0;
+                    if (uv[iv1].u >= ymin) {
+                        theta1 = uv[iv1].v;
 
-                lups[nlup].vrt  = ivrt;
-                lups[nlup].nvrt = 1;
-                lups[nlup].alen = 0;
-                nlup++;
+                        if (uv[iv2].u < ymin) {
+                            theta2 = atan2(xyz[iv2].z - zcent, xyz[iv2].x - xcent);
 
-                found++;
-                break;
-            }
-        }
+                            if (theta2 < theta1 - PI) theta2 += TWOPI;
+                            if (theta2 > theta1 + PI) theta2 -= TWOPI;
 
-        /*
-         * if no unassigned boundary Vertex is found, then exit
-         */
-        if (found == 0) {
-            break;
-        }
-        DPRINT4("lups[%d].vrt=%x, .nvrt=%d, alen=%f",
-                nlup-1, lups[nlup-1].vrt,
-                        lups[nlup-1].nvrt,
-                        lups[nlup-1].alen);
+                            uv[iv2].u = xyz[iv2].y;
+                            uv[iv2].v = theta2;
+                            change++;
+                        }
 
-        /*
-         * assign all the Vertices in the Loop
-         */
-        count = 0;
-        oldIvrt = ivrt;
-        ivrt    = vrts[ivrt].next;
-        while (ivrt != lups[nlup-1].vrt && ivrt != -1) {
-            vrts[ivrt].lup = nlup - 1;
-            vrts[ivrt].ang = 0;
+                        if (uv[iv0].u < ymin) {
+                            theta0 = atan2(xyz[iv0].z - zcent, xyz[iv0].x - xcent);
 
-            lups[nlup-1].nvrt++;
-            lups[nlup-1].alen += sqrt(  SQR(xyz[ivrt].x - xyz[oldIvrt].x)
-                                      + SQR(xyz[ivrt].y - xyz[oldIvrt].y)
-                                      + SQR(xyz[ivrt].z - xyz[oldIvrt].z));
+                            if (theta0 < theta1 - PI) theta0 += TWOPI;
+                            if (theta0 > theta1 + PI) theta0 -= TWOPI;
 
-            oldIvrt = ivrt;
-            ivrt    = vrts[ivrt].next;
-            count++;
-            if (count > nvrt+1) {
-                status = PRM_NOGLOBALUV;
-                goto cleanup;
+                            uv[iv0].u = xyz[iv0].y;
+                            uv[iv0].v = theta0;
+                            change++;
+                        }
+                    }
+
+                    if (uv[iv2].u >= ymin) {
+                        theta2 = uv[iv2].v;
+
+                        if (uv[iv0].u < ymin) {
+                            theta0 = atan2(xyz[iv0].z - zcent, xyz[iv0].x - xcent);
+
+                            if (theta0 < theta2 - PI) theta0 += TWOPI;
+                            if (theta0 > theta2 + PI) theta0 -= TWOPI;
+
+                            uv[iv0].u = xyz[iv0].y;
+                            uv[iv0].v = theta0;
+                            change++;
+                        }
+
+                        if (uv[iv1].u < ymin) {
+                            theta1 = atan2(xyz[iv1].z - zcent, xyz[iv1].x - xcent);
+
+                            if (theta1 < theta2 - PI) theta1 += TWOPI;
+                            if (theta1 > theta2 + PI) theta1 -= TWOPI;
+
+                            uv[iv1].u = xyz[iv1].y;
+                            uv[iv1].v = theta1;
+                            change++;
+                        }
+                    }
+                }
+                DPRINT1("   change=%d", change);
             }
-        }
-        if ( ivrt == -1 ) {
-            status = PRM_NOGLOBALUV;
-            goto cleanup;
-        }
 
-        DPRINT4("lup[%d].vrt=%x   .nvrt=%d   .alen=%f",
-                nlup-1, lups[nlup-1].vrt, lups[nlup-1].nvrt, lups[nlup-1].alen);
-    }
+            /*
+             * make sure that all Triangles have outward pointing normals
+             */
+            nneg = 0;
+            for (itri = 0; itri < ntri; itri++) {
+                iv0 = tri[itri].indices[0] - 1;
+                iv1 = tri[itri].indices[1] - 1;
+                iv2 = tri[itri].indices[2] - 1;
 
-    /*
-     * the outer Loop is the Loop with the greatest length (in XYZ)
-     */
-    DPRINT0("selecting outer Loop");
-    outer = 0;
-    for (lup = 1; lup < nlup; lup++) {
-        if (lups[lup].alen > lups[outer].alen) {
-            outer = lup;
-        }
-    }
-    DPRINT1("outer Loop is %d", outer);
+                area = (uv[iv1].u - uv[iv0].u) * (uv[iv2].v - uv[iv0].v)
+                     - (uv[iv1].v - uv[iv0].v) * (uv[iv2].u - uv[iv0].u);
+                if (area <= 0) {
+                    nneg++;
+                }
+            }
 
-    /*
-     * count the number of new Triangles we will have when we fill the
-     *    inner Loops
-     */
-    newNtri = ntri;
-    for (lup = 0; lup < nlup; lup++) {
-        if (lup != outer) {
-            newNtri += lups[lup].nvrt - 2;
+            /*
+             * if we got here, then the y-axial projection was successful
+             */
+            if (nneg == 0) {
+                DPRINT0("   y-axial projection was successful");
+
+                status = PRM_OK_AXIAL;
+                goto cleanup;
+            } else {
+                DPRINT2("   there were %d non-positive areas (ntri=%d)", nneg, ntri);
+            }
         }
     }
-    DPRINT1("newNtri=%d", newNtri);
-
-    /*
-     * get new tri array that is big enough for the new Triangles
-     */
-    MALLOC(newTri, prmTri, newNtri);
-    memcpy(newTri, tri, ntri*sizeof(prmTri));
 
     /*
-     * fill the inner Loops with Triangles
+     * the z-extent is larger than the other two extents, so try an
+     *    axis that is aligned with the z-axis
      */
-    DPRINT0("filling inner Loops with Triangles");
-    oldNtri = ntri;
-    if (nlup > 1) {
+    if ((zmax-zmin) > (xmax-xmin) && (zmax-zmin) > (ymax-ymin)) {
+        DPRINT0("potential axis in z-direction");
 
         /*
-         * allocate arrays for closing holes
+         * find the center of the Vertices within the last 1 percent of the x extent
          */
-        MALLOC(ihole, int,    nvrt);
-        MALLOC(ahole, double, nvrt);
+        dz   = 0.01 * (zmax - zmin);
 
-        /*
-         * fill the inner Loops
-         */
-        for (lup = 0; lup < nlup; lup++) {
-            if (lup == outer) continue;
-            DPRINT1("filling Loop %d", lup);
+        xmin1 = +HUGEQ;
+        xmax1 = -HUGEQ;
+        xmin2 = +HUGEQ;
+        xmax2 = -HUGEQ;
+        ymin1 = +HUGEQ;
+        ymax1 = -HUGEQ;
+        ymin2 = +HUGEQ;
+        ymax2 = -HUGEQ;
 
-            /*
-             * make a list of the hole Vertices (ie, the Vertices that make
-             *    up the Loop
-             */
+        for (ivrt = 0; ivrt < nvrt; ivrt++) {
+            if (xyz[ivrt].z < zmin+dz) {
+                xmin1 = MIN(xmin1, xyz[ivrt].x);
+                xmax1 = MAX(xmax1, xyz[ivrt].x);
+                ymin1 = MIN(ymin1, xyz[ivrt].y);
+                ymax1 = MAX(ymax1, xyz[ivrt].y);
+            } else if (xyz[ivrt].z > zmax-dz) {
+                xmin2 = MIN(xmin2, xyz[ivrt].x);
+                xmax2 = MAX(xmax2, xyz[ivrt].x);
+                ymin2 = MIN(ymin2, xyz[ivrt].y);
+                ymax2 = MAX(ymax2, xyz[ivrt].y);
+            }
+        }
 
-            nhole    = lups[lup].nvrt;
-            ihole[0] = lups[lup].vrt;
+        xmin = MAX(xmin1, xmin2);
+        xmax = MIN(xmax1, xmax2);
+        ymin = MAX(ymin1, ymin2);
+        ymax = MIN(ymax1, ymax2);
 
-            for (i = 1; i < nhole; i++) {
-                ihole[i] = vrts[ihole[i-1]].next;
+        /*
+         * try placing the axis at the center and at each of the extents
+         */
+        for (pass = 0; pass < 5; pass++) {
+            if (pass == 0) {
+                zcent = (zmin + zmax) / 2;
+                xcent = (xmin + xmax) / 2;
+                ycent = (ymin + ymax) / 2;
+            } else if (pass == 1) {
+                zcent = (zmin + zmax) / 2;
+                xcent =  xmin            ;
+                ycent = (ymin + ymax) / 2;
+            } else if (pass == 2) {
+                zcent = (zmin + zmax) / 2;
+                xcent =         xmax     ;
+                ycent = (ymin + ymax) / 2;
+            } else if (pass == 3) {
+                zcent = (zmin + zmax) / 2;
+                xcent = (xmin + xmax) / 2;
+                ycent =  ymin            ;
+            } else {
+                zcent = (zmin + zmax) / 2;
+                xcent = (xmin + xmax) / 2;
+                ycent =         ymax     ;
             }
-            DPRINT1("nhole=%d", nhole);
+            DPRINT3("xcent=%10.5f  ycent=%10.5f  zcent=%10.5f", xcent, ycent, zcent);
 
             /*
-             * one-by-one, cut off the hole Vertex with the smallest angle
+             * assign u=x and v=theta for every Vertex
              */
-            while (nhole > 3) {
+            for (ivrt = 0; ivrt < nvrt; ivrt++) {
+                uv[ivrt].u = zmin - 1;
+            }
 
-                /*
-                 * compute the angle at each hole Vertex
-                 */
-                for (i = 0; i < nhole; i++) {
-                    im1 = i - 1;
-                    ip1 = i + 1;
-                    if (im1 <  0    ) im1 += nhole;
-                    if (ip1 == nhole) ip1 -= nhole;
+            uv[0].u = xyz[0].z;
+            uv[0].v = atan2(xyz[0].x - xcent, xyz[0].y - ycent);
 
-                    d1sq = SQR(xyz[ihole[i  ]].x - xyz[ihole[im1]].x)
-                         + SQR(xyz[ihole[i  ]].y - xyz[ihole[im1]].y)
-                         + SQR(xyz[ihole[i  ]].z - xyz[ihole[im1]].z);
-                    d2sq = SQR(xyz[ihole[ip1]].x - xyz[ihole[i  ]].x)
-                         + SQR(xyz[ihole[ip1]].y - xyz[ihole[i  ]].y)
-                         + SQR(xyz[ihole[ip1]].z - xyz[ihole[i  ]].z);
-                    d3sq = SQR(xyz[ihole[im1]].x - xyz[ihole[ip1]].x)
-                         + SQR(xyz[ihole[im1]].y - xyz[ihole[ip1]].y)
-                         + SQR(xyz[ihole[im1]].z - xyz[ihole[ip1]].z);
+            change = 1;
+            while (change > 0) {
+                change = 0;
 
-                    ahole[i] = ACOS((d1sq + d2sq - d3sq) / 2 / sqrt(d1sq * d2sq));
-                    DPRINT5("i=%5d %5d %5d %5d %10.5f", nhole, i, im1, ip1, ahole[i]);
-                }
+                for (itri = 0; itri < ntri; itri++) {
+                    iv0 = tri[itri].indices[0] - 1;
+                    iv1 = tri[itri].indices[1] - 1;
+                    iv2 = tri[itri].indices[2] - 1;
 
-                /*
-                 * minimum angle (which will be cut off)
-                 */
-                amin = ahole[0];
-                imin = 0;
 
-                for (i = 2; i < nhole; i++) {
-                    if (ahole[i] < amin) {
-                        amin = ahole[i];
-                        imin = i;
+                    if (uv[iv0].u >= zmin) {
+                        theta0 = uv[iv0].v;
+
+                        if (uv[iv1].u < zmin) {
+                            theta1 = atan2(xyz[iv1].x - xcent, xyz[iv1].y - ycent);
+
+                            if (theta1 < theta0 - PI) theta1 += TWOPI;
+                            if (theta1 > theta0 + PI) theta1 -= TWOPI;
+
+                            uv[iv1].u = xyz[iv1].z;
+                            uv[iv1].v = theta1;
+                            change++;
+                        }
+
+                        if (uv[iv2].u < zmin) {
+                            theta2 = atan2(xyz[iv2].x - xcent, xyz[iv2].y - ycent);
+
+                            if (theta2 < theta0 - PI) theta2 += TWOPI;
+                            if (theta2 > theta0 + PI) theta2 -= TWOPI;
+
+                            uv[iv2].u = xyz[iv2].z;
+                            uv[iv2].v = theta2;
+                            change++;
+                        }
                     }
-                }
-                DPRINT2("imin=%d   amin=%f", imin, amin);
 
-                /*
-                 * make new Triangle
-                 */
-                im1 = imin - 1;
-                ip1 = imin + 1;
-                if (im1 <  0    ) im1 += nhole;
-                if (ip1 == nhole) ip1 -= nhole;
+                    if (uv[iv1].u >= zmin) {
+                        theta1 = uv[iv1].v;
 
-                newTri[ntri].indices[0] = ihole[imin] + 1;
-                newTri[ntri].indices[1] = ihole[im1 ] + 1;
-                newTri[ntri].indices[2] = ihole[ip1 ] + 1;
-                newTri[ntri].neigh[0] = 0;
-                newTri[ntri].neigh[1] = 0;
-                newTri[ntri].neigh[2] = 0;
-                ntri++;
+                        if (uv[iv2].u < zmin) {
+                            theta2 = atan2(xyz[iv2].x - xcent, xyz[iv2].y - ycent);
 
-                /*
-                 * remove imin from hole list
-                 */
-                nhole--;
-                for (j = imin; j < nhole; j++) {
-                    ihole[j] = ihole[j+1];
-                    ahole[j] = ahole[j+1];
+                            if (theta2 < theta1 - PI) theta2 += TWOPI;
+                            if (theta2 > theta1 + PI) theta2 -= TWOPI;
+
+                            uv[iv2].u = xyz[iv2].z;
+                            uv[iv2].v = theta2;
+                            change++;
+                        }
+
+                        if (uv[iv0].u < zmin) {
+                            theta0 = atan2(xyz[iv0].x - xcent, xyz[iv0].y - ycent);
+
+                            if (theta0 < theta1 - PI) theta0 += TWOPI;
+                            if (theta0 > theta1 + PI) theta0 -= TWOPI;
+
+                            uv[iv0].u = xyz[iv0].z;
+                            uv[iv0].v = theta0;
+                            change++;
+                        }
+                    }
+
+                    if (uv[iv2].u >= zmin) {
+                        theta2 = uv[iv2].v;
+
+                        if (uv[iv0].u < zmin) {
+                            theta0 = atan2(xyz[iv0].x - xcent, xyz[iv0].y - ycent);
+
+                            if (theta0 < theta2 - PI) theta0 += TWOPI;
+                            if (theta0 > theta2 + PI) theta0 -= TWOPI;
+
+                            uv[iv0].u = xyz[iv0].z;
+                            uv[iv0].v = theta0;
+                            change++;
+                        }
+
+                        if (uv[iv1].u < zmin) {
+                            theta1 = atan2(xyz[iv1].x - xcent, xyz[iv1].y - ycent);
+
+                            if (theta1 < theta2 - PI) theta1 += TWOPI;
+                            if (theta1 > theta2 + PI) theta1 -= TWOPI;
+
+                            uv[iv1].u = xyz[iv1].z;
+                            uv[iv1].v = theta1;
+                            change++;
+                        }
+                    }
                 }
+                DPRINT1("   change=%d", change);
             }
 
             /*
-             * make the final Triangle with the last 3 entries in the hole list
+             * make sure that all Triangles have outward pointing normals
              */
-            newTri[ntri].indices[0] = ihole[3] + 1;
-            newTri[ntri].indices[1] = ihole[2] + 1;
-            newTri[ntri].indices[2] = ihole[1] + 1;
-            newTri[ntri].neigh[0] = 0;
-            newTri[ntri].neigh[1] = 0;
-            newTri[ntri].neigh[2] = 0;
-            ntri++;
-        }
-
-        /*
-         * set up the Triangle neighbor information for the new Triangles
-         *    (note the backwards loop since it is most likely that the neighbor
-         *    will be near the end of the list)
-         */
-        for (i = oldNtri; i < ntri; i++) {
-            DPRINT1("neighbors for Triangle %d", i);
-            iv0 = newTri[i].indices[0];
-            iv1 = newTri[i].indices[1];
-            iv2 = newTri[i].indices[2];
+            nneg = 0;
+            for (itri = 0; itri < ntri; itri++) {
+                iv0 = tri[itri].indices[0] - 1;
+                iv1 = tri[itri].indices[1] - 1;
+                iv2 = tri[itri].indices[2] - 1;
 
-            for (j = ntri-1; j >= 0; j--) {
-                if        (newTri[j].indices[2] == iv1 && newTri[j].indices[1] == iv2) {
-                    newTri[i].neigh[0] = j + 1;
-                    newTri[j].neigh[0] = i + 1;
-                } else if (newTri[j].indices[0] == iv1 && newTri[j].indices[2] == iv2) {
-                    newTri[i].neigh[0] = j + 1;
-                    newTri[j].neigh[1] = i + 1;
-                } else if (newTri[j].indices[1] == iv1 && newTri[j].indices[0] == iv2) {
-                    newTri[i].neigh[0] = j + 1;
-                    newTri[j].neigh[2] = i + 1;
+                area = (uv[iv1].u - uv[iv0].u) * (uv[iv2].v - uv[iv0].v)
+                     - (uv[iv1].v - uv[iv0].v) * (uv[iv2].u - uv[iv0].u);
+                if (area <= 0) {
+                    nneg++;
                 }
             }
 
-            for (j = ntri-1; j >= 0; j--) {
-                if        (newTri[j].indices[2] == iv2 && newTri[j].indices[1] == iv0) {
-                    newTri[i].neigh[1] = j + 1;
-                    newTri[j].neigh[0] = i + 1;
-                } else if (newTri[j].indices[0] == iv2 && newTri[j].indices[2] == iv0) {
-                    newTri[i].neigh[1] = j + 1;
-                    newTri[j].neigh[1] = i + 1;
-                } else if (newTri[j].indices[1] == iv2 && newTri[j].indices[0] == iv0) {
-                    newTri[i].neigh[1] = j + 1;
-                    newTri[j].neigh[2] = i + 1;
-                }
-            }
+            /*
+             * if we got here, then the z-axial projection was successful
+             */
+            if (nneg == 0) {
+                DPRINT0("   z-axial projection was successful");
 
-            for (j = ntri-1; j >= 0; j--) {
-                if        (newTri[j].indices[2] == iv0 && newTri[j].indices[1] == iv1) {
-                    newTri[i].neigh[2] = j + 1;
-                    newTri[j].neigh[0] = i + 1;
-                } else if (newTri[j].indices[0] == iv0 && newTri[j].indices[2] == iv1) {
-                    newTri[i].neigh[2] = j + 1;
-                    newTri[j].neigh[1] = i + 1;
-                } else if (newTri[j].indices[1] == iv0 && newTri[j].indices[0] == iv1) {
-                    newTri[i].neigh[2] = j + 1;
-                    newTri[j].neigh[2] = i + 1;
-                }
+                status = PRM_OK_AXIAL;
+                goto cleanup;
+            } else {
+                DPRINT2("   there were %d non-positive areas (ntri=%d)", nneg, ntri);
             }
         }
     }
 
-    /*
-     * compute the angle at each boundary Vertex associated with the outer Loop
-     */
-    DPRINT0("computing boundary angles");
-    for (itri = 0; itri < ntri; itri++) {
-        iv0 = newTri[itri].indices[0] - 1;
-        iv1 = newTri[itri].indices[1] - 1;
-        iv2 = newTri[itri].indices[2] - 1;
+    status = PRM_NOGLOBALUV;
 
-        if (vrts[iv0].lup >= 0 || vrts[iv1].lup >= 0 || vrts[iv2].lup >= 0) {
-            d01sq = SQR(xyz[iv0].x - xyz[iv1].x)
-                  + SQR(xyz[iv0].y - xyz[iv1].y)
-                  + SQR(xyz[iv0].z - xyz[iv1].z);
-            d12sq = SQR(xyz[iv1].x - xyz[iv2].x)
-                  + SQR(xyz[iv1].y - xyz[iv2].y)
-                  + SQR(xyz[iv1].z - xyz[iv2].z);
-            d20sq = SQR(xyz[iv2].x - xyz[iv0].x)
-                  + SQR(xyz[iv2].y - xyz[iv0].y)
-                  + SQR(xyz[iv2].z - xyz[iv0].z);
+ cleanup:
+    DPRINT2("%s --> status=%d}", routine, status);
+    return status;
+}
 
-            ang0 = ACOS((d20sq + d01sq - d12sq) / 2 / sqrt(d20sq * d01sq));
-            ang1 = ACOS((d01sq + d12sq - d20sq) / 2 / sqrt(d01sq * d12sq));
-            ang2 = ACOS((d12sq + d20sq - d01sq) / 2 / sqrt(d12sq * d20sq));
 
-            if (vrts[iv0].lup >= 0) {vrts[iv0].ang += ang0;}
-            if (vrts[iv1].lup >= 0) {vrts[iv1].ang += ang1;}
-            if (vrts[iv2].lup >= 0) {vrts[iv2].ang += ang2;}
+
+/*
+ ********************************************************************************
+ *                                                                              *
+ * floaterSOR -- over-relax a range of Vertices (all of one color)              *
+ *                                                                              *
+ ********************************************************************************
+ */
+static void
+floaterSOR(void     *data,                   /* (in)   prmSOR structure */
+           int      ilo,                     /* (in)   first entry in list */
+           int      ihi)                     /* (in)   last  entry in list (+1) */
+{
+    prmSOR      *sor  = (prmSOR *) data;
+    double      *asmf = sor->asmf;
+    int         *ismf = sor->ismf;
+    prmUV       *uv   = sor->uv;
+
+    int         i, j, k, idx;
+    double      du, dv;
+
+    /* ----------------------------------------------------------------------- */
+
+    for (idx = ilo; idx < ihi; idx++) {
+        i  = sor->list[idx];
+        du = sor->urhs[i] - asmf[i] * uv[i].u;
+        dv = sor->vrhs[i] - asmf[i] * uv[i].v;
+
+        for (k = ismf[i]; k < ismf[i+1]; k++) {
+            j    = ismf[k];
+            du  -= asmf[k] * uv[j].u;
+            dv  -= asmf[k] * uv[j].v;
         }
+
+        uv[i].u += sor->omega * du / asmf[i];
+        uv[i].v += sor->omega * dv / asmf[i];
     }
+}
 
-    /*
-     * lay out the outer Loop (in UV) by marching along the Loop
-     */
-    DPRINT0("laying out outer Loop");
-    ivrt       = lups[outer].vrt;
-    uv[ivrt].u = 0;
-    uv[ivrt].v = 0;
 
-    xold = xyz[ivrt].x;
-    yold = xyz[ivrt].y;
-    zold = xyz[ivrt].z;
-    gold = 0;
-    hold = 0;
-    told = 0;
 
-    do {
-        ivrt = vrts[ivrt].next;
+
+/*
+ ********************************************************************************
+ *                                                                              *
+ * floaterResid -- sum of the squared residuals over a range of Vertices        *
+ *                                                                              *
+ ********************************************************************************
+ */
+static void
+floaterResid(void     *data,                 /* (in)   prmSOR structure */
+             int      ilo,                   /* (in)   first Vertex */
+             int      ihi)                   /* (in)   last  Vertex (+1) */
+{
+    prmSOR      *sor  = (prmSOR *) data;
+    double      *asmf = sor->asmf;
+    int         *ismf = sor->ismf;
+    prmUV       *uv   = sor->uv;
+    double      *part = &sor->part[ilo/VRTCHUNK];
 
-        xnew = xyz[ivrt].x;
-        ynew = xyz[ivrt].y;
-        znew = xyz[ivrt].z;
+    int         i, j, k;
+    double      erru, errv;
 
-        dist = sqrt(SQR(xnew - xold) + SQR(ynew - yold) + SQR(znew - zold));
+    /* ----------------------------------------------------------------------- */
 
-        unew = gold + dist * cos(told);
-        vnew = hold + dist * sin(told);
-        tnew = told + PI - vrts[ivrt].ang;
+    part[0] = 0;
+    for (i = ilo; i < ihi; i++) {
+        erru = sor->urhs[i] - asmf[i] * uv[i].u;
+        errv = sor->vrhs[i] - asmf[i] * uv[i].v;
 
-        uv[ivrt].u = unew;
-        uv[ivrt].v = vnew;
+        for (k = ismf[i]; k < ismf[i+1]; k++) {
+            j     = ismf[k];
+            erru -= asmf[k] * uv[j].u;
+            errv -= asmf[k] * uv[j].v;
+        }
 
-        xold = xnew;
-        yold = ynew;
-        zold = znew;
-        gold = unew;
-        hold = vnew;
-        told = tnew;
+        part[0] += SQR(erru) + SQR(errv);
+    }
+}
 
-    } while (ivrt != lups[outer].vrt);
 
-    /*
-     * determine how close we came to closing the Loop (in UV)
-     */
-    ivrt = lups[outer].vrt;
-    dist = sqrt(SQR(uv[ivrt].u) + SQR(uv[ivrt].v));
-    DPRINT1("closing dist=%f", dist);
 
-    /*
-     * if the Loop is almost closed, close it by linearly adjusting the UV
-     */
-    DPRINT0("closing outer Loop");
-    if (dist < frac*lups[outer].alen) {
-        du   = uv[ivrt].u / lups[outer].nvrt;
-        dv   = uv[ivrt].v / lups[outer].nvrt;
-        DPRINT2("adjusting by du=%f,  dv=%f", du, dv);
+
+/*
+ ********************************************************************************
+ *                                                                              *
+ * floaterParameterization -- use floater's transformation (if possible)        *
+ *                                                                              *
+ ********************************************************************************
+ */
+static int
+floaterParameterization(int        ntri,     /* (in)   number of Triangles */
+                        prmTri     tri[],    /* (in)   array  of Triangles */
+                        int        nvrt,     /* (in)   number of Vertices */
+                        prmXYZ     xyz[],    /* (in)   array  of Coordinates */
+                        prmUV      uv[])     /* (out)  array of  Parameters */
+{
+    int         status = PRM_NOGLOBALUV;     /* (out)  return status */
+                                             /*        PRM_NOGLOBALUV */
+                                             /*        PRM_OK_FLOATER */
 
-        ii = 0;
-        do {
-            ivrt = vrts[ivrt].next;
-            ii++;
+    typedef struct {
+        int     vrt;                         /* first Vertex in Loop */
+        int     nvrt;                        /* number of Vertex in Loop */
+        double  alen;                        /* length (in XYZ) of Loop */
+    } lup_t;
 
-            uv[ivrt].u -= (ii * du);
-            uv[ivrt].v -= (ii * dv);
-        } while (ivrt != lups[outer].vrt);
+    lup_t       *lups = NULL;                /* array  of Loops */
+    int         nlup;                        /* number of Loops */
 
-    /*
-     * otherwise, remap the outer Loop to the unit circle
-     */
-    } else {
-        DPRINT0("mapping to circle");
-        ivrt = lups[outer].vrt;
+    typedef struct {
+        int     next;                        /* next boundary Vertex */
+        int     lup;                         /* Loop number */
+        double  ang;                         /* angle at Loop Vertices */
+    } vrt_t;
+    vrt_t       *vrts = NULL;                /* array of boundary Vertices */
 
-        xold = xyz[ivrt].x;
-        yold = xyz[ivrt].y;
-        zold = xyz[ivrt].z;
-        told = 0.0;
+    sparseMat   amat;                        /* full matrix */
+    double      *asmf   = NULL;
+    int         *ismf   = NULL;
+    double      *urhs   = NULL;
+    double      *vrhs   = NULL;
+    prmTri      *newTri = NULL;
+    int         *ihole  = NULL;
+    double      *ahole  = NULL;
 
-        uv[ivrt].u = cos(told);
-        uv[ivrt].v = sin(told);
+    double      ang0, ang1, ang2, ang3, ang4, ang5;
+    double      area, amin;
+    double      d1sq, d2sq, d3sq;
+    double      d01sq, d12sq, d20sq, d23sq;
+    double      d30sq, d04sq, d41sq, d15sq, d52sq;
+    double      du, dv;
+    double      dist;
+    double      err=1, erru, errv;
+    int         found;
+    int         i, j, k, ii, nn, im1, ip1;
+    int         imin;
+    int         iter, itmax=1000;
+    int         itri, oldNtri, tmp;
+    int         ivrt, oldIvrt, iv0, iv1, iv2, iv3, iv4, iv5;
+    int         lup;
+    int         newNtri, count;
+    int         nneg;
+    int         outer;
+    double      xold, yold, zold, told, gold, hold;
+    double      xnew, ynew, znew, tnew, unew, vnew;
+    int         nhole;
+    int         np, ic, ncolor;
+    int         *icolor = NULL;
+    int         *jcolor = NULL;
+    double      *part   = NULL;
+    prmSOR      sor;
+    EMPteam     team;
 
-        ivrt = vrts[ivrt].next;
-        while (ivrt != lups[outer].vrt) {
-            xnew = xyz[ivrt].x;
-            ynew = xyz[ivrt].y;
-            znew = xyz[ivrt].z;
+    double      errtol = 0.000001;
+    double      frac = 0.25;
+    double      omega = 1.6;
 
-            dist = sqrt(SQR(xnew - xold) + SQR(ynew - yold)
-                                         + SQR(znew - zold));
-            told = told + TWOPI * dist / lups[outer].alen;
+    ROUTINE(floaterParameterization);
+    DPRINT3("%s(ntri=%d, nvrt=%d) {",
+            routine, ntri, nvrt);
 
-            uv[ivrt].u = cos(told);
-            uv[ivrt].v = sin(told);
+    /* ----------------------------------------------------------------------- */
+  
+    amat.ni = 0;
+    amat.is = NULL;
 
-            ivrt = vrts[ivrt].next;
-            xold = xnew;
-            yold = ynew;
-            zold = znew;
-        }
-    }
+    team.mutex   = NULL;
+    team.gate[0] = NULL;
+    team.gate[1] = NULL;
+    team.threads = NULL;
 
     /*
-     * initialize the amat matrix (which will be used to solve for the UV
-     *    at all interior Vertices)
+     * allocate storage that will be used to keep track of the Loop
+     *    number and the next Vertex in the Loop
      */
-    status = initSmat(nvrt, &amat);
-    CHECK_STATUS;
+    MALLOC(vrts, vrt_t,  nvrt    );
+    MALLOC(lups, lup_t,  MAXLOOPS);
+    MALLOC(urhs, double, nvrt    );
+    MALLOC(vrhs, double, nvrt    );
 
     /*
-     * find the mean value weights at each Vertex due to its neighbors.  the
-     *    weigt function is the "mean value coordinates" function as described
-     *    by M. Floater
-     *
-     *                   iv3--------iv2---------iv5
-     *                     \         /\a5       /
-     *                      \       /a2\       /
-     *                       \     /    \     /
-     *                        \a3 / itri \   /
-     *                         \ /a0    a1\ /
-     *                         iv0--------iv1
-     *                           \     a4 /
-     *                            \      /
-     *                             \    /
-     *                              \  /
-     *                               \/
-     *                              iv4
+     * for each Vertex that is along a boundary of the Quilt, keep track of
+     *    the next Vertex on the boundary
      */
-    DPRINT0("finding mean value weights");
-    for (itri = 0; itri < ntri; itri++) {
-        iv0 = newTri[itri].indices[0] - 1;
-        iv1 = newTri[itri].indices[1] - 1;
-        iv2 = newTri[itri].indices[2] - 1;
-
-        d01sq = SQR(xyz[iv0].x - xyz[iv1].x)
-              + SQR(xyz[iv0].y - xyz[iv1].y)
-              + SQR(xyz[iv0].z - xyz[iv1].z);
-        d12sq = SQR(xyz[iv1].x - xyz[iv2].x)
-              + SQR(xyz[iv1].y - xyz[iv2].y)
-              + SQR(xyz[iv1].z - xyz[iv2].z);
-        d20sq = SQR(xyz[iv2].x - xyz[iv0].x)
-              + SQR(xyz[iv2].y - xyz[iv0].y)
-              + SQR(xyz[iv2].z - xyz[iv0].z);
+    DPRINT0("finding next Vertex");
+    for (ivrt = 0; ivrt < nvrt; ivrt++) {
+        vrts[ivrt].next = -1;
+        vrts[ivrt].lup  = -1;
+    }
 
-        ang0 = ACOS((d20sq + d01sq - d12sq) / 2 / sqrt(d20sq * d01sq));
-        ang1 = ACOS((d01sq + d12sq - d20sq) / 2 / sqrt(d01sq * d12sq));
-        ang2 = ACOS((d12sq + d20sq - d01sq) / 2 / sqrt(d12sq * d20sq));
+    nn = 0;
+    for (itri = 0; itri < ntri; itri++) {
+        iv0 = tri[itri].indices[0] - 1;
+        iv1 = tri[itri].indices[1] - 1;
+        iv2 = tri[itri].indices[2] - 1;
 
-        if (newTri[itri].neigh[1] > 0) {
-            tmp = newTri[itri].neigh[1] -  1;
-            if (       newTri[tmp].neigh[0]-1 == itri) {
-                iv3 =  newTri[tmp].indices[0]-1;
-            } else if (newTri[tmp].neigh[1]-1 == itri) {
-                iv3 =  newTri[tmp].indices[1]-1;
-            } else {
-                iv3 =  newTri[tmp].indices[2]-1;
+        if (tri[itri].neigh[0] <= 0) {
+            nn++;
+            if (vrts[iv1].next == -1) {
+                vrts[iv1].next = iv2;
             }
-
-            d23sq = SQR(xyz[iv2].x - xyz[iv3].x)
-                  + SQR(xyz[iv2].y - xyz[iv3].y)
-                  + SQR(xyz[iv2].z - xyz[iv3].z);
-            d30sq = SQR(xyz[iv3].x - xyz[iv0].x)
-                  + SQR(xyz[iv3].y - xyz[iv0].y)
-                  + SQR(xyz[iv3].z - xyz[iv0].z);
-
-            ang3 = ACOS((d30sq + d20sq - d23sq) / 2 / sqrt(d30sq * d20sq));
-
-            status = setSmat(&amat, iv0, iv2,
-                             (tan(ang0/2) + tan(ang3/2)) / sqrt(d20sq));
-            CHECK_STATUS;
         }
-
-        if (newTri[itri].neigh[2] > 0) {
-            tmp = newTri[itri].neigh[2] -  1;
-            if (       newTri[tmp].neigh[0]-1 == itri) {
-                iv4 =  newTri[tmp].indices[0]-1;
-            } else if (newTri[tmp].neigh[1]-1 == itri) {
-                iv4 =  newTri[tmp].indices[1]-1;
-            } else {
-                iv4 =  newTri[tmp].indices[2]-1;
+        if (tri[itri].neigh[1] <= 0) {
+            nn++;
+            if (vrts[iv2].next == -1) {
+                vrts[iv2].next = iv0;
             }
-
-            d04sq = SQR(xyz[iv0].x - xyz[iv4].x)
-                  + SQR(xyz[iv0].y - xyz[iv4].y)
-                  + SQR(xyz[iv0].z - xyz[iv4].z);
-            d41sq = SQR(xyz[iv4].x - xyz[iv1].x)
-                  + SQR(xyz[iv4].y - xyz[iv1].y)
-                  + SQR(xyz[iv4].z - xyz[iv1].z);
-
-            ang4 = ACOS((d41sq + d01sq - d04sq) / 2 / sqrt(d41sq * d01sq));
-
-            status = setSmat(&amat, iv1, iv0,
-                             (tan(ang1/2) + tan(ang4/2)) / sqrt(d01sq));
-            CHECK_STATUS;
         }
-
-        if (newTri[itri].neigh[0] > 0) {
-            tmp = newTri[itri].neigh[0] -  1;
-            if (       newTri[tmp].neigh[0]-1 == itri) {
-                iv5 =  newTri[tmp].indices[0]-1;
-            } else if (newTri[tmp].neigh[1]-1 == itri) {
-                iv5 =  newTri[tmp].indices[1]-1;
-            } else {
-                iv5 =  newTri[tmp].indices[2]-1;
+        if (tri[itri].neigh[2] <= 0) {
+            nn++;
+            if (vrts[iv0].next == -1) {
+                vrts[iv0].next = iv1;
             }
+        }
+    }
 
-            d15sq = SQR(xyz[iv1].x - xyz[iv5].x)
-                  + SQR(xyz[iv1].y - xyz[iv5].y)
-                  + SQR(xyz[iv1].z - xyz[iv5].z);
-            d52sq = SQR(xyz[iv5].x - xyz[iv2].x)
-                  + SQR(xyz[iv5].y - xyz[iv2].y)
-                  + SQR(xyz[iv5].z - xyz[iv2].z);
-
-            ang5 = ACOS((d52sq + d12sq - d15sq) / 2 / sqrt(d52sq * d12sq));
-
-            status = setSmat(&amat, iv2, iv1,
-                             (tan(ang2/2) + tan(ang5/2)) / sqrt(d12sq));
-            CHECK_STATUS;
-        }
+    /*
+     * if there are no boundary Triangles, then return without setting UVtype
+     */
+    if (nn == 0) {
+        DPRINT0("no boundary Tiangles were found");
+        status = PRM_NOGLOBALUV;
+        goto cleanup;
     }
 
     /*
-     * set up the final amat and the right-hand sides
+     * associate each boundary Vertex with a Loop
      */
-    for (i = 0; i < nvrt; i++) {
+    DPRINT0("associating boundary Vertices with Loops");
+    for (ivrt = 0; ivrt < nvrt; ivrt++) {
+        DPRINT2("vrts[%5d].next = %5d", ivrt, vrts[ivrt].next);
+    }
+    nlup = 0;
+    while (1) {
 
         /*
-         * for interior Vertices, normalize the weights, set the diagonal to 1,
-         *    and zero-out the right-hand sides
+         * find a Vertex that has a next but not a Loop
          */
-        if (vrts[i].lup != outer) {
-            status = divSmat(&amat, i);
-            CHECK_STATUS;
-            status = setSmat(&amat, i, i, 1.0);
-            CHECK_STATUS;
+        found = 0;
+        for (ivrt = 0; ivrt < nvrt; ivrt++) {
+            if ((vrts[ivrt].next >= 0) && (vrts[ivrt].lup < 0)) {
+                vrts[ivrt].lup = nlup;
+                vrts[ivrt].ang = 0;
 
-            urhs[i] = 0;
-            vrhs[i] = 0;
+                lups[nlup].vrt  = ivrt;
+                lups[nlup].nvrt = 1;
+                lups[nlup].alen = 0;
+                nlup++;
 
-            uv[i].u = 0;
-            uv[i].v = 0;
+                found++;
+                break;
+            }
+        }
 
         /*
-         * for boundary Vertices, zero-out all amat elements, set the diagonal
-         *    to 1, and store the boundary values in the RHS
+         * if no unassigned boundary Vertex is found, then exit
          */
-        } else {
-            status = diagSmat(&amat, i);
-            CHECK_STATUS;
-            status = setSmat(&amat, i, i, 1.0);
-            CHECK_STATUS;
+        if (found == 0) {
+            break;
+        }
+        DPRINT4("lups[%d].vrt=%x, .nvrt=%d, alen=%f",
+                nlup-1, lups[nlup-1].vrt,
+                        lups[nlup-1].nvrt,
+                        lups[nlup-1].alen);
 
-            urhs[i] = uv[i].u;
-            vrhs[i] = uv[i].v;
+        /*
+         * assign all the Vertices in the Loop
+         */
+        count = 0;
+        oldIvrt = ivrt;
+        ivrt    = vrts[ivrt].next;
+        while (ivrt != lups[nlup-1].vrt && ivrt != -1) {
+            vrts[ivrt].lup = nlup - 1;
+            vrts[ivrt].ang = 0;
+
+            lups[nlup-1].nvrt++;
+            lups[nlup-1].alen += sqrt(  SQR(xyz[ivrt].x - xyz[oldIvrt].x)
+                                      + SQR(xyz[ivrt].y - xyz[oldIvrt].y)
+                                      + SQR(xyz[ivrt].z - xyz[oldIvrt].z));
+
+            oldIvrt = ivrt;
+            ivrt    = vrts[ivrt].next;
+            count++;
+            if (count > nvrt+1) {
+                status = PRM_NOGLOBALUV;
+                goto cleanup;
+            }
+        }
+        if ( ivrt == -1 ) {
+            status = PRM_NOGLOBALUV;
+            goto cleanup;
         }
+
+        DPRINT4("lup[%d].vrt=%x   .nvrt=%d   .alen=%f",
+                nlup-1, lups[nlup-1].vrt, lups[nlup-1].nvrt, lups[nlup-1].alen);
     }
 
     /*
-     * count the number of non-zero entries in amat
+     * the outer Loop is the Loop with the greatest length (in XYZ)
      */
-    nn = countSmat(&amat);
+    DPRINT0("selecting outer Loop");
+    outer = 0;
+    for (lup = 1; lup < nlup; lup++) {
+        if (lups[lup].alen > lups[outer].alen) {
+            outer = lup;
+        }
+    }
+    DPRINT1("outer Loop is %d", outer);
 
     /*
-     * allocate matrices for sparse-matrix form.  this form is as
-     *    described in 'Numerical Recipes'
+     * count the number of new Triangles we will have when we fill the
+     *    inner Loops
      */
-    DPRINT0("setting up sparse matrix");
-    MALLOC(asmf, double, nn+2);
-    MALLOC(ismf, int,    nn+2);
+    newNtri = ntri;
+    for (lup = 0; lup < nlup; lup++) {
+        if (lup != outer) {
+            newNtri += lups[lup].nvrt - 2;
+        }
+    }
+    DPRINT1("newNtri=%d", newNtri);
 
     /*
-     * store the matrix in sparse-matrix form (which will make
-     *    the iterations below much more efficient)
+     * get new tri array that is big enough for the new Triangles
      */
-    for (j = 0; j < nvrt; j++) {
-      status = getSmat(&amat, j, j, &asmf[j]);
-      CHECK_STATUS;
-    }
-  
-    ismf[0] = nvrt + 2;
-  
-    k = nvrt + 1;
-    for (i = 0; i < nvrt; i++) {
-      status = fillSmat(&amat, i, &k, asmf, ismf);
-      CHECK_STATUS;
-      ismf[i+1] = k + 1;
-    }
+    MALLOC(newTri, prmTri, newNtri);
+    memcpy(newTri, tri, ntri*sizeof(prmTri));
 
     /*
-     * solve for the Gs and Hs using successive-over-relaxation
+     * fill the inner Loops with Triangles
      */
-    DPRINT0("solving sparse matrix");
-    for (iter = 0; iter < itmax; iter++) {
+    DPRINT0("filling inner Loops with Triangles");
+    oldNtri = ntri;
+    if (nlup > 1) {
 
         /*
-         * apply successive-over-relaxation
+         * allocate arrays for closing holes
          */
-        for (i = 0; i < nvrt; i++) {
-            du = urhs[i] - asmf[i] * uv[i].u;
-            dv = vrhs[i] - asmf[i] * uv[i].v;
-
-            for (k = ismf[i]; k < ismf[i+1]; k++) {
-                j    = ismf[k];
-                du  -= asmf[k] * uv[j].u;
-                dv  -= asmf[k] * uv[j].v;
-            }
-
-            uv[i].u += omega * du / asmf[i];
-            uv[i].v += omega * dv / asmf[i];
-        }
+        MALLOC(ihole, int,    nvrt);
+        MALLOC(ahole, double, nvrt);
 
         /*
-         * compute the norm of the residual
+         * fill the inner Loops
          */
-        err = 0;
-        for (i = 0; i < nvrt; i++) {
-            erru = urhs[i] - asmf[i] * uv[i].u;
-            errv = vrhs[i] - asmf[i] * uv[i].v;
-
-            for (k = ismf[i]; k < ismf[i+1]; k++) {
-                j     = ismf[k];
-                erru -= asmf[k] * uv[j].u;
-                errv -= asmf[k] * uv[j].v;
-            }
+        for (lup = 0; lup < nlup; lup++) {
+            if (lup == outer) continue;
+            DPRINT1("filling Loop %d", lup);
 
-            err += SQR(erru) + SQR(errv);
-        }
-        err = sqrt(err);
+            /*
+             * make a list of the hole Vertices (ie, the Vertices that make
+             *    up the Loop
+             */
 
-        /*
-         * exit if converged
-         */
-        DPRINT2("iter=%5d   err=%15.8e", iter, err);
-        if (err < errtol) break;
-    }
+            nhole    = lups[lup].nvrt;
+            ihole[0] = lups[lup].vrt;
 
-    /*
-     * find the number of Triangles with negative areas (in UV)
-     */
-    DPRINT0("checking final Triangles");
-    nneg = 0;
-    for (itri = 0; itri < oldNtri; itri++) {
-        iv0 = newTri[itri].indices[0] - 1;
-        iv1 = newTri[itri].indices[1] - 1;
-        iv2 = newTri[itri].indices[2] - 1;
+            for (i = 1; i < nhole; i++) {
+                ihole[i] = vrts[ihole[i-1]].next;
+            }
+            DPRINT1("nhole=%d", nhole);
 
-        area = (uv[iv1].u - uv[iv0].u) * (uv[iv2].v - uv[iv0].v)
-             - (uv[iv1].v - uv[iv0].v) * (uv[iv2].u - uv[iv0].u);
+            /*
+             * one-by-one, cut off the hole Vertex with the smallest angle
+             */
+            while (nhole > 3) {
 
-        if (area < 0) nneg++;
-    }
-    DPRINT2("floater parameterization has nneg=%d of %d", nneg, ntri);
+                /*
+                 * compute the angle at each hole Vertex
+                 */
+                for (i = 0; i < nhole; i++) {
+                    im1 = i - 1;
+                    ip1 = i + 1;
+                    if (im1 <  0    ) im1 += nhole;
+                    if (ip1 == nhole) ip1 -= nhole;
 
-    /*
-     * if we converged and none of the Triangles have negative areas,
-     *    then set the UVtype
-     */
-    if (err < errtol && nneg == 0) {
-        status = PRM_OK_FLOATER;
-    } else {
-        status = PRM_NOGLOBALUV;
-    }
+                    d1sq = SQR(xyz[ihole[i  ]].x - xyz[ihole[im1]].x)
+                         + SQR(xyz[ihole[i  ]].y - xyz[ihole[im1]].y)
+                         + SQR(xyz[ihole[i  ]].z - xyz[ihole[im1]].z);
+                    d2sq = SQR(xyz[ihole[ip1]].x - xyz[ihole[i  ]].x)
+                         + SQR(xyz[ihole[ip1]].y - xyz[ihole[i  ]].y)
+                         + SQR(xyz[ihole[ip1]].z - xyz[ihole[i  ]].z);
+                    d3sq = SQR(xyz[ihole[im1]].x - xyz[ihole[ip1]].x)
+                         + SQR(xyz[ihole[im1]].y - xyz[ihole[ip1]].y)
+                         + SQR(xyz[ihole[im1]].z - xyz[ihole[ip1]].z);
 
- cleanup:
-    freeSmat(&amat);
-    FREE(vrts);
-    FREE(lups);
-    FREE(urhs);
-    FREE(vrhs);
-    FREE(asmf);
-    FREE(ismf);
-    FREE(newTri);
-    FREE(ihole);
-    FREE(ahole);
+                    ahole[i] = ACOS((d1sq + d2sq - d3sq) / 2 / sqrt(d1sq * d2sq));
+                    DPRINT5("i=%5d %5d %5d %5d %10.5f", nhole, i, im1, ip1, ahole[i]);
+                }
 
-    DPRINT2("%s --> status=%d}", routine, status);
-    return status;
-}
+                /*
+                 * minimum angle (which will be cut off)
+                 */
+                amin = ahole[0];
+                imin = 0;
 
+                for (i = 2; i < nhole; i++) {
+                    if (ahole[i] < amin) {
+                        amin = ahole[i];
+                        imin = i;
+                    }
+                }
+                DPRINT2("imin=%d   amin=%f", imin, amin);
 
-
-/*
- ********************************************************************************
- *                                                                              *
- * jonesTransformation -- use jones' transformation (if possible)               *
- *                                                                              *
- ********************************************************************************
- */
-static int
-jonesTransformation(int      ntri,           /* (in)   number of Triangles */
-                    prmTri   tri[],          /* (in)   array  of Triangles */
-                    prmUVF   uvf[],          /* (in)   array  of UVF for Triangles */
-                    int      nvrt,           /* (in)   number of Vertices */
-                    prmUV    uv[])           /* (out)  array  of Parameters */
-{
-    int         status = PRM_NOGLOBALUV;     /* (out)  return status */
-                                             /*        PRM_NOGLOBALUV */
-                                             /*        PRM_OK_JONES */
+                /*
+                 * make new Triangle
+                 */
+                im1 = imin - 1;
+                ip1 = imin + 1;
+                if (im1 <  0    ) im1 += nhole;
+                if (ip1 == nhole) ip1 -= nhole;
 
-    int         *itmap = NULL;               /* Triangle mapping status */
-                                             /*          (0=not mapped, 1=scheduled, 2=mapped) */
-    int         *ivmap = NULL;               /* Vertex   mapping status */
-                                             /*          (0=not mapped, 1=mapped) */
-    int         *list  = NULL;               /* FIFO list of Triangles to process */
+                newTri[ntri].indices[0] = ihole[imin] + 1;
+                newTri[ntri].indices[1] = ihole[im1 ] + 1;
+                newTri[ntri].indices[2] = ihole[ip1 ] + 1;
+                newTri[ntri].neigh[0] = 0;
+                newTri[ntri].neigh[1] = 0;
+                newTri[ntri].neigh[2] = 0;
+                ntri++;
 
-    double      area;
-    int         itri, jtri;
-    int         ivrt, iv0, iv1, iv2;
-    int         jlist, nlist, nneg, side;
+                /*
+                 * remove imin from hole list
+                 */
+                nhole--;
+                for (j = imin; j < nhole; j++) {
+                    ihole[j] = ihole[j+1];
+                    ahole[j] = ahole[j+1];
+                }
+            }
 
-    ROUTINE(jonesTransformation);
-    DPRINT3("%s(ntri=%d, nvrt=%d) {",
-            routine, ntri, nvrt);
+            /*
+             * make the final Triangle with the last 3 entries in the hole list
+             */
+            newTri[ntri].indices[0] = ihole[3] + 1;
+            newTri[ntri].indices[1] = ihole[2] + 1;
+            newTri[ntri].indices[2] = ihole[1] + 1;
+            newTri[ntri].neigh[0] = 0;
+            newTri[ntri].neigh[1] = 0;
+            newTri[ntri].neigh[2] = 0;
+            ntri++;
+        }
 
-    /* ----------------------------------------------------------------------- */
+        /*
+         * set up the Triangle neighbor information for the new Triangles
+         *    (note the backwards loop since it is most likely that the neighbor
+         *    will be near the end of the list)
+         */
+        for (i = oldNtri; i < ntri; i++) {
+            DPRINT1("neighbors for Triangle %d", i);
+            iv0 = newTri[i].indices[0];
+            iv1 = newTri[i].indices[1];
+            iv2 = newTri[i].indices[2];
 
-   /*
-     * get the arrays that will keep track of the mapping status of
-     *    the Vertices and Triangles
-     */
-    MALLOC(ivmap, int, nvrt);
-    MALLOC(itmap, int, ntri);
-    MALLOC(list,  int, ntri);
+            for (j = ntri-1; j >= 0; j--) {
+                if        (newTri[j].indices[2] == iv1 && newTri[j].indices[1] == iv2) {
+                    newTri[i].neigh[0] = j + 1;
+                    newTri[j].neigh[0] = i + 1;
+                } else if (newTri[j].indices[0] == iv1 && newTri[j].indices[2] == iv2) {
+                    newTri[i].neigh[0] = j + 1;
+                    newTri[j].neigh[1] = i + 1;
+                } else if (newTri[j].indices[1] == iv1 && newTri[j].indices[0] == iv2) {
+                    newTri[i].neigh[0] = j + 1;
+                    newTri[j].neigh[2] = i + 1;
+                }
+            }
+
+            for (j = ntri-1; j >= 0; j--) {
+                if        (newTri[j].indices[2] == iv2 && newTri[j].indices[1] == iv0) {
+                    newTri[i].neigh[1] = j + 1;
+                    newTri[j].neigh[0] = i + 1;
+                } else if (newTri[j].indices[0] == iv2 && newTri[j].indices[2] == iv0) {
+                    newTri[i].neigh[1] = j + 1;
+                    newTri[j].neigh[1] = i + 1;
+                } else if (newTri[j].indices[1] == iv2 && newTri[j].indices[0] == iv0) {
+                    newTri[i].neigh[1] = j + 1;
+                    newTri[j].neigh[2] = i + 1;
+                }
+            }
+
+            for (j = ntri-1; j >= 0; j--) {
+                if        (newTri[j].indices[2] == iv0 && newTri[j].indices[1] == iv1) {
+                    newTri[i].neigh[2] = j + 1;
+                    newTri[j].neigh[0] = i + 1;
+                } else if (newTri[j].indices[0] == iv0 && newTri[j].indices[2] == iv1) {
+                    newTri[i].neigh[2] = j + 1;
+                    newTri[j].neigh[1] = i + 1;
+                } else if (newTri[j].indices[1] == iv0 && newTri[j].indices[0] == iv1) {
+                    newTri[i].neigh[2] = j + 1;
+                    newTri[j].neigh[2] = i + 1;
+                }
+            }
+        }
+    }
 
     /*
-     * mark all Vertices and Triangles as not mapped
+     * compute the angle at each boundary Vertex associated with the outer Loop
      */
-    for (ivrt = 0; ivrt < nvrt; ivrt++) {
-        ivmap[ivrt] = 0;
-    }
+    DPRINT0("computing boundary angles");
     for (itri = 0; itri < ntri; itri++) {
-        itmap[itri] = 0;
+        iv0 = newTri[itri].indices[0] - 1;
+        iv1 = newTri[itri].indices[1] - 1;
+        iv2 = newTri[itri].indices[2] - 1;
+
+        if (vrts[iv0].lup >= 0 || vrts[iv1].lup >= 0 || vrts[iv2].lup >= 0) {
+            d01sq = SQR(xyz[iv0].x - xyz[iv1].x)
+                  + SQR(xyz[iv0].y - xyz[iv1].y)
+                  + SQR(xyz[iv0].z - xyz[iv1].z);
+            d12sq = SQR(xyz[iv1].x - xyz[iv2].x)
+                  + SQR(xyz[iv1].y - xyz[iv2].y)
+                  + SQR(xyz[iv1].z - xyz[iv2].z);
+            d20sq = SQR(xyz[iv2].x - xyz[iv0].x)
+                  + SQR(xyz[iv2].y - xyz[iv0].y)
+                  + SQR(xyz[iv2].z - xyz[iv0].z);
+
+            ang0 = ACOS((d20sq + d01sq - d12sq) / 2 / sqrt(d20sq * d01sq));
+            ang1 = ACOS((d01sq + d12sq - d20sq) / 2 / sqrt(d01sq * d12sq));
+            ang2 = ACOS((d12sq + d20sq - d01sq) / 2 / sqrt(d12sq * d20sq));
+
+            if (vrts[iv0].lup >= 0) {vrts[iv0].ang += ang0;}
+            if (vrts[iv1].lup >= 0) {vrts[iv1].ang += ang1;}
+            if (vrts[iv2].lup >= 0) {vrts[iv2].ang += ang2;}
+        }
     }
 
     /*
-     * set up the coordinates for the first Triangle by copying UV
-     *    from the first Triangle
+     * lay out the outer Loop (in UV) by marching along the Loop
      */
-    itri = 0;
+    DPRINT0("laying out outer Loop");
+    ivrt       = lups[outer].vrt;
+    uv[ivrt].u = 0;
+    uv[ivrt].v = 0;
 
-    iv0 = tri[itri].indices[0] - 1;
-    iv1 = tri[itri].indices[1] - 1;
-    iv2 = tri[itri].indices[2] - 1;
+    xold = xyz[ivrt].x;
+    yold = xyz[ivrt].y;
+    zold = xyz[ivrt].z;
+    gold = 0;
+    hold = 0;
+    told = 0;
 
-    uv[iv0].u = uvf[itri].u0;
-    uv[iv0].v = uvf[itri].v0;
+    do {
+        ivrt = vrts[ivrt].next;
 
-    uv[iv1].u = uvf[itri].u1;
-    uv[iv1].v = uvf[itri].v1;
+        xnew = xyz[ivrt].x;
+        ynew = xyz[ivrt].y;
+        znew = xyz[ivrt].z;
 
-    uv[iv2].u = uvf[itri].u2;
-    uv[iv2].v = uvf[itri].v2;
+        dist = sqrt(SQR(xnew - xold) + SQR(ynew - yold) + SQR(znew - zold));
 
-    ivmap[iv0] = 1;
-    ivmap[iv1] = 1;
-    ivmap[iv2] = 1;
+        unew = gold + dist * cos(told);
+        vnew = hold + dist * sin(told);
+        tnew = told + PI - vrts[ivrt].ang;
 
-    itmap[itri] = 2;
+        uv[ivrt].u = unew;
+        uv[ivrt].v = vnew;
 
-    /*
-     * flip this Triangle over if its area was negative
-     */
-    area = (uv[iv1].u - uv[iv0].u) * (uv[iv2].v - uv[iv0].v)
-         - (uv[iv1].v - uv[iv0].v) * (uv[iv2].u - uv[iv0].u);
+        xold = xnew;
+        yold = ynew;
+        zold = znew;
+        gold = unew;
+        hold = vnew;
+        told = tnew;
 
-    if (area < 0) {
-        uv[iv0].u *= -1;
-        uv[iv1].u *= -1;
-        uv[iv2].u *= -1;
+    } while (ivrt != lups[outer].vrt);
 
-        DPRINT1("triangle flipped because area = %f", area);
-    }
+    /*
+     * determine how close we came to closing the Loop (in UV)
+     */
+    ivrt = lups[outer].vrt;
+    dist = sqrt(SQR(uv[ivrt].u) + SQR(uv[ivrt].v));
+    DPRINT1("closing dist=%f", dist);
 
     /*
-     * initialize the first-in-first-out list of Triangles to process
+     * if the Loop is almost closed, close it by linearly adjusting the UV
      */
-    nlist = 0;                  /* number of entries in list */
-    jlist = 0;                  /* next list item to process */
+    DPRINT0("closing outer Loop");
+    if (dist < frac*lups[outer].alen) {
+        du   = uv[ivrt].u / lups[outer].nvrt;
+        dv   = uv[ivrt].v / lups[outer].nvrt;
+        DPRINT2("adjusting by du=%f,  dv=%f", du, dv);
 
-    for (side = 0; side < 3; side++) {
-        jtri = tri[itri].neigh[side] - 1;
+        ii = 0;
+        do {
+            ivrt = vrts[ivrt].next;
+            ii++;
 
-        if (jtri >= 0 && itmap[jtri] == 0) {
-            itmap[jtri]   = 1;
-            list[nlist++] = jtri;
-        }
-    }
+            uv[ivrt].u -= (ii * du);
+            uv[ivrt].v -= (ii * dv);
+        } while (ivrt != lups[outer].vrt);
 
     /*
-     * process each list item (first-in-first-out)
+     * otherwise, remap the outer Loop to the unit circle
      */
-    while (jlist < nlist) {
-        itri = list[jlist++];
-        iv0  = tri[itri].indices[0] - 1;
-        iv1  = tri[itri].indices[1] - 1;
-        iv2  = tri[itri].indices[2] - 1;
+    } else {
+        DPRINT0("mapping to circle");
+        ivrt = lups[outer].vrt;
 
-        if        ((ivmap[iv0] == 1) && (ivmap[iv1] == 1) && (ivmap[iv2] == 1)) {
-            itmap[itri] = 2;
-        } else if ((ivmap[iv0] == 1) && (ivmap[iv1] == 1)) {
-            layDownTriangle2(uv, uvf[itri].u0, uvf[itri].v0, iv0,
-                                 uvf[itri].u1, uvf[itri].v1, iv1,
-                                 uvf[itri].u2, uvf[itri].v2, iv2);
+        xold = xyz[ivrt].x;
+        yold = xyz[ivrt].y;
+        zold = xyz[ivrt].z;
+        told = 0.0;
 
-            ivmap[iv2 ] = 1;
-            itmap[itri] = 2;
-        } else if ((ivmap[iv1] == 1) && (ivmap[iv2] == 1)) {
-            layDownTriangle2(uv, uvf[itri].u1, uvf[itri].v1, iv1,
-                                 uvf[itri].u2, uvf[itri].v2, iv2,
-                                 uvf[itri].u0, uvf[itri].v0, iv0);
+        uv[ivrt].u = cos(told);
+        uv[ivrt].v = sin(told);
 
-            ivmap[iv0 ] = 1;
-            itmap[itri] = 2;
-        } else if ((ivmap[iv2] == 1) && (ivmap[iv0] == 1)) {
-            layDownTriangle2(uv, uvf[itri].u2, uvf[itri].v2, iv2,
-                                 uvf[itri].u0, uvf[itri].v0, iv0,
-                                 uvf[itri].u1, uvf[itri].v1, iv1);
+        ivrt = vrts[ivrt].next;
+        while (ivrt != lups[outer].vrt) {
+            xnew = xyz[ivrt].x;
+            ynew = xyz[ivrt].y;
+            znew = xyz[ivrt].z;
 
-            ivmap[iv1 ] = 1;
-            itmap[itri] = 2;
-        }
+            dist = sqrt(SQR(xnew - xold) + SQR(ynew - yold)
+                                         + SQR(znew - zold));
+            told = told + TWOPI * dist / lups[outer].alen;
 
-        /*
-         * add the neighbors to the list to process
-         */
-        for (side = 0; side < 3; side++) {
-            jtri = tri[itri].neigh[side] - 1;
+            uv[ivrt].u = cos(told);
+            uv[ivrt].v = sin(told);
 
-            if (jtri >= 0 && itmap[jtri] == 0) {
-                itmap[jtri]   = 1;
-                list[nlist++] = jtri;
-            }
+            ivrt = vrts[ivrt].next;
+            xold = xnew;
+            yold = ynew;
+            zold = znew;
         }
     }
 
     /*
-     * count the number of Triangles with a positive area
+     * initialize the amat matrix (which will be used to solve for the UV
+     *    at all interior Vertices)
      */
-    nneg = 0;
-    for (itri = 0; itri < ntri; itri++) {
-        iv0 = tri[itri].indices[0] - 1;
-        iv1 = tri[itri].indices[1] - 1;
-        iv2 = tri[itri].indices[2] - 1;
-
-        area = (uv[iv1].u - uv[iv0].u) * (uv[iv2].v - uv[iv0].v)
-             - (uv[iv1].v - uv[iv0].v) * (uv[iv2].u - uv[iv0].u);
-        if (area < EPS12) nneg++;
-    }
-    DPRINT2("jones transformation has nneg=%d of %d", nneg, ntri);
+    status = initSmat(nvrt, &amat);
+    CHECK_STATUS;
 
     /*
-     * if all the areas are positive, set UVtype
-     *    and use the newly-slitted tessellation
+     * find the mean value weights at each Vertex due to its neighbors.  the
+     *    weigt function is the "mean value coordinates" function as described
+     *    by M. Floater
+     *
+     *                   iv3--------iv2---------iv5
+     *                     \         /\a5       /
+     *                      \       /a2\       /
+     *                       \     /    \     /
+     *                        \a3 / itri \   /
+     *                         \ /a0    a1\ /
+     *                         iv0--------iv1
+     *                           \     a4 /
+     *                            \      /
+     *                             \    /
+     *                              \  /
+     *                               \/
+     *                              iv4
      */
-    if (nneg == 0) {
-        status = PRM_OK_JONES;
-    } else {
-
-#ifdef GRAFIC
-        plotTris(ntri, tri, nvrt, uv,
-                 "~U~V~Jones transformation with negative areas");
-#endif
-
-        status = PRM_NOGLOBALUV;
-    }
-
- cleanup:
-    FREE(ivmap);
-    FREE(itmap);
-    FREE(list );
+    DPRINT0("finding mean value weights");
+    for (itri = 0; itri < ntri; itri++) {
+        iv0 = newTri[itri].indices[0] - 1;
+        iv1 = newTri[itri].indices[1] - 1;
+        iv2 = newTri[itri].indices[2] - 1;
 
-    DPRINT2("%s --> status=%d}", routine, status);
-    return status;
-}
+        d01sq = SQR(xyz[iv0].x - xyz[iv1].x)
+              + SQR(xyz[iv0].y - xyz[iv1].y)
+              + SQR(xyz[iv0].z - xyz[iv1].z);
+        d12sq = SQR(xyz[iv1].x - xyz[iv2].x)
+              + SQR(xyz[iv1].y - xyz[iv2].y)
+              + SQR(xyz[iv1].z - xyz[iv2].z);
+        d20sq = SQR(xyz[iv2].x - xyz[iv0].x)
+              + SQR(xyz[iv2].y - xyz[iv0].y)
+              + SQR(xyz[iv2].z - xyz[iv0].z);
 
+        ang0 = ACOS((d20sq + d01sq - d12sq) / 2 / sqrt(d20sq * d01sq));
+        ang1 = ACOS((d01sq + d12sq - d20sq) / 2 / sqrt(d01sq * d12sq));
+        ang2 = ACOS((d12sq + d20sq - d01sq) / 2 / sqrt(d12sq * d20sq));
 
-
-/*
- ********************************************************************************
- *                                                                              *
- * planarProjection -- use planar projection (if possible)                      *
- *                                                                              *
- ********************************************************************************
- */
-static int
-planarProjection(int      ntri,              /* (in)   number of Triangles */
-                 prmTri   tri[],             /* (in)   array  of Triangles */
-                 int      nvrt,              /* (in)   number of Vertices */
-                 prmXYZ   xyz[],             /* (in)   array  of Coordinates */
-                 prmUV    uv[])              /* (out)  array  of Parameters */
-{
-    int         status = PRM_NOGLOBALUV;     /* (out)  return status */
-                                             /*        PRM_NOGLOBALUV */
-                                             /*        PRM_OK_PLANAR */
+        if (newTri[itri].neigh[1] > 0) {
+            tmp = newTri[itri].neigh[1] -  1;
+            if (       newTri[tmp].neigh[0]-1 == itri) {
+                iv3 =  newTri[tmp].indices[0]-1;
+            } else if (newTri[tmp].neigh[1]-1 == itri) {
+                iv3 =  newTri[tmp].indices[1]-1;
+            } else {
+                iv3 =  newTri[tmp].indices[2]-1;
+            }
 
-    double      area, areax, areay, areaz, areamax;
-    int         itri;
-    int         ivrt, iv0, iv1, iv2;
-    double      norm[3];
-    int         nneg, npos;
+            d23sq = SQR(xyz[iv2].x - xyz[iv3].x)
+                  + SQR(xyz[iv2].y - xyz[iv3].y)
+                  + SQR(xyz[iv2].z - xyz[iv3].z);
+            d30sq = SQR(xyz[iv3].x - xyz[iv0].x)
+                  + SQR(xyz[iv3].y - xyz[iv0].y)
+                  + SQR(xyz[iv3].z - xyz[iv0].z);
 
-    ROUTINE(planarProjection);
-    DPRINT3("%s(ntri=%d, nvrt=%d) {",
-            routine, ntri, nvrt);
+            ang3 = ACOS((d30sq + d20sq - d23sq) / 2 / sqrt(d30sq * d20sq));
 
-    /* ----------------------------------------------------------------------- */
+            status = setSmat(&amat, iv0, iv2,
+                             (tan(ang0/2) + tan(ang3/2)) / sqrt(d20sq));
+            CHECK_STATUS;
+        }
 
-    /*
-     * find the total area vector
-     */
-    areax   = 0;
-    areay   = 0;
-    areaz   = 0;
-    areamax = 0;
+        if (newTri[itri].neigh[2] > 0) {
+            tmp = newTri[itri].neigh[2] -  1;
+            if (       newTri[tmp].neigh[0]-1 == itri) {
+                iv4 =  newTri[tmp].indices[0]-1;
+            } else if (newTri[tmp].neigh[1]-1 == itri) {
+                iv4 =  newTri[tmp].indices[1]-1;
+            } else {
+                iv4 =  newTri[tmp].indices[2]-1;
+            }
 
-    for (itri = 0; itri < ntri; itri++) {
-        surfaceNormal(tri[itri].indices[0]-1,
-                      tri[itri].indices[1]-1,
-                      tri[itri].indices[2]-1, xyz, &area, norm);
+            d04sq = SQR(xyz[iv0].x - xyz[iv4].x)
+                  + SQR(xyz[iv0].y - xyz[iv4].y)
+                  + SQR(xyz[iv0].z - xyz[iv4].z);
+            d41sq = SQR(xyz[iv4].x - xyz[iv1].x)
+                  + SQR(xyz[iv4].y - xyz[iv1].y)
+                  + SQR(xyz[iv4].z - xyz[iv1].z);
 
-        areax += area * norm[0];
-        areay += area * norm[1];
-        areaz += area * norm[2];
+            ang4 = ACOS((d41sq + d01sq - d04sq) / 2 / sqrt(d41sq * d01sq));
 
-        areamax = MAX(areamax, area);
-    }
+            status = setSmat(&amat, iv1, iv0,
+                             (tan(ang1/2) + tan(ang4/2)) / sqrt(d01sq));
+            CHECK_STATUS;
+        }
 
-    DPRINT3("areax=%10.5f   areay=%10.5f   areaz=%10.5f",
-            areax, areay, areaz);
+        if (newTri[itri].neigh[0] > 0) {
+            tmp = newTri[itri].neigh[0] -  1;
+            if (       newTri[tmp].neigh[0]-1 == itri) {
+                iv5 =  newTri[tmp].indices[0]-1;
+            } else if (newTri[tmp].neigh[1]-1 == itri) {
+                iv5 =  newTri[tmp].indices[1]-1;
+            } else {
+                iv5 =  newTri[tmp].indices[2]-1;
+            }
 
-    /*
-     * exit if the area is very small (which probably means that there is
-     *    no projection direction
-     */
-    area  = sqrt(SQR(areax) + SQR(areay) + SQR(areaz));
-    if (area < areamax) {
-        goto cleanup;
-    } else {
-        areax /= area;
-        areay /= area;
-        areaz /= area;
-    }
+            d15sq = SQR(xyz[iv1].x - xyz[iv5].x)
+                  + SQR(xyz[iv1].y - xyz[iv5].y)
+                  + SQR(xyz[iv1].z - xyz[iv5].z);
+            d52sq = SQR(xyz[iv5].x - xyz[iv2].x)
+                  + SQR(xyz[iv5].y - xyz[iv2].y)
+                  + SQR(xyz[iv5].z - xyz[iv2].z);
 
-    DPRINT3("areax=%10.5f, areay=%10.5f, areaz=%10.5f", areax, areay, areaz);
+            ang5 = ACOS((d52sq + d12sq - d15sq) / 2 / sqrt(d52sq * d12sq));
 
-    /*
-     * convert all xyz to uv
-     */
-    if        (fabs(areax) <= fabs(areay) && fabs(areax) <= fabs(areaz)) {
-        DPRINT0("typeX::  y,z->U  x->V");
-        for (ivrt = 0; ivrt < nvrt; ivrt++) {
-            uv[ivrt].u = areay * xyz[ivrt].z - areaz * xyz[ivrt].y;
-            uv[ivrt].v =         xyz[ivrt].x;
-        }
-    } else if (fabs(areay) <= fabs(areaz) && fabs(areay) <= fabs(areax)) {
-        DPRINT0("typeY::  z,x->U  y->V");
-        for (ivrt = 0; ivrt < nvrt; ivrt++) {
-            uv[ivrt].u = areaz * xyz[ivrt].x - areax * xyz[ivrt].z;
-            uv[ivrt].v =         xyz[ivrt].y;
-        }
-    } else {
-        DPRINT0("typeZ::  x,y->U  z->V");
-        for (ivrt = 0; ivrt < nvrt; ivrt++) {
-            uv[ivrt].u = areax * xyz[ivrt].y - areay * xyz[ivrt].x;
-            uv[ivrt].v =         xyz[ivrt].z;
+            status = setSmat(&amat, iv2, iv1,
+                             (tan(ang2/2) + tan(ang5/2)) / sqrt(d12sq));
+            CHECK_STATUS;
         }
     }
 
     /*
-     * make sure that all Triangles have outward pointing normals
+     * set up the final amat and the right-hand sides
      */
-    nneg = 0;
-    npos = 0;
-    for (itri = 0; itri < ntri; itri++) {
-        iv0 = tri[itri].indices[0] - 1;
-        iv1 = tri[itri].indices[1] - 1;
-        iv2 = tri[itri].indices[2] - 1;
+    for (i = 0; i < nvrt; i++) {
 
-        area = (uv[iv1].u - uv[iv0].u) * (uv[iv2].v - uv[iv0].v)
-             - (uv[iv1].v - uv[iv0].v) * (uv[iv2].u - uv[iv0].u);
-        if (area < 0) {
-            nneg++;
-        } else if (area > 0) {
-            npos++;
+        /*
+         * for interior Vertices, normalize the weights, set the diagonal to 1,
+         *    and zero-out the right-hand sides
+         */
+        if (vrts[i].lup != outer) {
+            status = divSmat(&amat, i);
+            CHECK_STATUS;
+            status = setSmat(&amat, i, i, 1.0);
+            CHECK_STATUS;
+
+            urhs[i] = 0;
+            vrhs[i] = 0;
+
+            uv[i].u = 0;
+            uv[i].v = 0;
+
+        /*
+         * for boundary Vertices, zero-out all amat elements, set the diagonal
+         *    to 1, and store the boundary values in the RHS
+         */
+        } else {
+            status = diagSmat(&amat, i);
+            CHECK_STATUS;
+            status = setSmat(&amat, i, i, 1.0);
+            CHECK_STATUS;
+
+            urhs[i] = uv[i].u;
+            vrhs[i] = uv[i].v;
         }
     }
-    DPRINT3("ntri=%d   nneg=%d   npos=%d", ntri, nneg, npos);
 
     /*
-     * if we got here, then the projection to the rotated z-plane was successful
+     * count the number of non-zero entries in amat
      */
-    if (npos == ntri) {
-        DPRINT0("   positive planar projection was successful");
-        status = PRM_OK_PLANAR;
-    } else if (nneg == ntri) {
-        DPRINT0("   negative planar projection was successful");
-        for (ivrt = 0; ivrt < nvrt; ivrt++) {
-            uv[ivrt].v = -(uv[ivrt].v);
+    nn = countSmat(&amat);
+
+    /*
+     * allocate matrices for sparse-matrix form.  this form is as
+     *    described in 'Numerical Recipes'
+     */
+    DPRINT0("setting up sparse matrix");
+    MALLOC(asmf, double, nn+2);
+    MALLOC(ismf, int,    nn+2);
+
+    /*
+     * store the matrix in sparse-matrix form (which will make
+     *    the iterations below much more efficient)
+     */
+    for (j = 0; j < nvrt; j++) {
+      status = getSmat(&amat, j, j, &asmf[j]);
+      CHECK_STATUS;
+    }
+  
+    ismf[0] = nvrt + 2;
+  
+    k = nvrt + 1;
+    for (i = 0; i < nvrt; i++) {
+      status = fillSmat(&amat, i, &k, asmf, ismf);
+      CHECK_STATUS;
+      ismf[i+1] = k + 1;
+    }
+
+    /*
+     * solve for the Gs and Hs using (lexicographic) successive-over-relaxation
+     */
+    if (globalRelax == PRM_RELAX_SOR) {
+        DPRINT0("solving sparse matrix");
+        for (iter = 0; iter < itmax; iter++) {
+
+            /*
+             * apply successive-over-relaxation
+             */
+            for (i = 0; i < nvrt; i++) {
+                du = urhs[i] - asmf[i] * uv[i].u;
+                dv = vrhs[i] - asmf[i] * uv[i].v;
+
+                for (k = ismf[i]; k < ismf[i+1]; k++) {
+                    j    = ismf[k];
+                    du  -= asmf[k] * uv[j].u;
+                    dv  -= asmf[k] * uv[j].v;
+                }
+
+                uv[i].u += omega * du / asmf[i];
+                uv[i].v += omega * dv / asmf[i];
+            }
+
+            /*
+             * compute the norm of the residual
+             */
+            err = 0;
+            for (i = 0; i < nvrt; i++) {
+                erru = urhs[i] - asmf[i] * uv[i].u;
+                errv = vrhs[i] - asmf[i] * uv[i].v;
+
+                for (k = ismf[i]; k < ismf[i+1]; k++) {
+                    j     = ismf[k];
+                    erru -= asmf[k] * uv[j].u;
+                    errv -= asmf[k] * uv[j].v;
+                }
+
+                err += SQR(erru) + SQR(errv);
+            }
+            err = sqrt(err);
+
+            /*
+             * exit if converged
+             */
+            DPRINT2("iter=%5d   err=%15.8e", iter, err);
+            if (err < errtol) break;
         }
-        status = PRM_OK_PLANAR;
+
+    /*
+     * or color the Vertices so that each color can be relaxed in parallel
+     *    (this changes the order of the updates, and so the UVs)
+     */
     } else {
-        DPRINT0("   planar projection failed");
+        status = colorSMF(nvrt, ismf, &ncolor, &icolor, &jcolor);
+        CHECK_STATUS;
+
+        MALLOC(part, double, NCHUNK(nvrt)+1);
+
+        /*
+         * one team of threads for all of the sweeps below
+         */
+        np = EMP_Init(NULL);
+        teamCreate(np, &team);
+
+        sor.asmf  = asmf;
+        sor.ismf  = ismf;
+        sor.urhs  = urhs;
+        sor.vrhs  = vrhs;
+        sor.uv    = uv;
+        sor.list  = NULL;
+        sor.part  = part;
+        sor.omega = omega;
+
+        /*
+         * solve for the Gs and Hs using (multi-color) successive-over-relaxation
+         */
+        DPRINT0("solving sparse matrix (colored)");
+        for (iter = 0; iter < itmax; iter++) {
+
+            /*
+             * apply successive-over-relaxation one color at a time
+             */
+            for (ic = 0; ic < ncolor; ic++) {
+                sor.list = &jcolor[icolor[ic]];
+                teamRun(&team, icolor[ic+1]-icolor[ic], VRTCHUNK, floaterSOR, &sor);
+            }
+            sor.list = NULL;
+
+            /*
+             * compute the norm of the residual
+             */
+            teamRun(&team, nvrt, VRTCHUNK, floaterResid, &sor);
+
+            err = 0;
+            for (i = 0; i < NCHUNK(nvrt); i++) {
+                err += part[i];
+            }
+            err = sqrt(err);
+
+            /*
+             * exit if converged
+             */
+            DPRINT2("iter=%5d   err=%15.8e", iter, err);
+            if (err < errtol) break;
+        }
+    }
+
+    /*
+     * find the number of Triangles with negative areas (in UV)
+     */
+    DPRINT0("checking final Triangles");
+    nneg = 0;
+    for (itri = 0; itri < oldNtri; itri++) {
+        iv0 = newTri[itri].indices[0] - 1;
+        iv1 = newTri[itri].indices[1] - 1;
+        iv2 = newTri[itri].indices[2] - 1;
+
+        area = (uv[iv1].u - uv[iv0].u) * (uv[iv2].v - uv[iv0].v)
+             - (uv[iv1].v - uv[iv0].v) * (uv[iv2].u - uv[iv0].u);
+
+        if (area < 0) nneg++;
+    }
+    DPRINT2("floater parameterization has nneg=%d of %d", nneg, ntri);
+
+    /*
+     * if we converged and none of the Triangles have negative areas,
+     *    then set the UVtype
+     */
+    if (err < errtol && nneg == 0) {
+        status = PRM_OK_FLOATER;
+    } else {
+        status = PRM_NOGLOBALUV;
     }
 
  cleanup:
+    teamDestroy(&team);
+    freeSmat(&amat);
+    FREE(part);
+    FREE(icolor);
+    FREE(jcolor);
+    FREE(vrts);
+    FREE(lups);
+    FREE(urhs);
+    FREE(vrhs);
+    FREE(asmf);
+    FREE(ismf);
+    FREE(newTri);
+    FREE(ihole);
+    FREE(ahole);
+
     DPRINT2("%s --> status=%d}", routine, status);
     return status;
 }
@@ -2538,140 +3028,193 @@ planarProjection(int      ntri,              /* (in)   number of Triangles */
 /*
  ********************************************************************************
  *                                                                              *
- * simpleProjection -- use simple projection (if possible)                      *
+ * jonesTransformation -- use jones' transformation (if possible)               *
  *                                                                              *
  ********************************************************************************
  */
 static int
-simpleProjection(int      ntri,              /* (in)   number of Triangles */
-                 prmTri   tri[],             /* (in)   array  of Triangles */
-                 int      nvrt,              /* (in)   number of Vertices */
-                 prmXYZ   xyz[],             /* (in)   array  of Coordinates */
-                 prmUV    uv[])              /* (out)  array  of Parameters */
+jonesTransformation(int      ntri,           /* (in)   number of Triangles */
+                    prmTri   tri[],          /* (in)   array  of Triangles */
+                    prmUVF   uvf[],          /* (in)   array  of UVF for Triangles */
+                    int      nvrt,           /* (in)   number of Vertices */
+                    prmUV    uv[])           /* (out)  array  of Parameters */
 {
     int         status = PRM_NOGLOBALUV;     /* (out)  return status */
                                              /*        PRM_NOGLOBALUV */
-                                             /*        PRM_OK_SIMPLE */
+                                             /*        PRM_OK_JONES */
 
-    double      area, norm[3];
-    int         itri, ivrt, iposx, inegx, iposy, inegy, iposz, inegz;
-    int         iv0, iv1, iv2, npos, nneg;
+    int         *itmap = NULL;               /* Triangle mapping status */
+                                             /*          (0=not mapped, 1=scheduled, 2=mapped) */
+    int         *ivmap = NULL;               /* Vertex   mapping status */
+                                             /*          (0=not mapped, 1=mapped) */
+    int         *list  = NULL;               /* FIFO list of Triangles to process */
 
-    double      sin10 = 0.17365;
+    double      area;
+    int         itri, jtri;
+    int         ivrt, iv0, iv1, iv2;
+    int         jlist, nlist, nneg, side;
 
-    ROUTINE(simpleProjection);
+    ROUTINE(jonesTransformation);
     DPRINT3("%s(ntri=%d, nvrt=%d) {",
             routine, ntri, nvrt);
 
     /* ----------------------------------------------------------------------- */
 
-    /*
-     * initially all projections are assumed to be possible
+   /*
+     * get the arrays that will keep track of the mapping status of
+     *    the Vertices and Triangles
      */
-    iposx = 1;
-    inegx = 1;
-    iposy = 1;
-    inegy = 1;
-    iposz = 1;
-    inegz = 1;
+    MALLOC(ivmap, int, nvrt);
+    MALLOC(itmap, int, ntri);
+    MALLOC(list,  int, ntri);
 
     /*
-     * loop through Triangles and eliminate possible projections
+     * mark all Vertices and Triangles as not mapped
      */
+    for (ivrt = 0; ivrt < nvrt; ivrt++) {
+        ivmap[ivrt] = 0;
+    }
     for (itri = 0; itri < ntri; itri++) {
-        iv0 = tri[itri].indices[0] - 1;
-        iv1 = tri[itri].indices[1] - 1;
-        iv2 = tri[itri].indices[2] - 1;
+        itmap[itri] = 0;
+    }
 
-        surfaceNormal(iv0, iv1, iv2, xyz, &area, norm);
+    /*
+     * set up the coordinates for the first Triangle by copying UV
+     *    from the first Triangle
+     */
+    itri = 0;
 
-        if (norm[0] < +sin10) iposx = 0;
-        if (norm[0] > -sin10) inegx = 0;
-        if (norm[1] < +sin10) iposy = 0;
-        if (norm[1] > -sin10) inegy = 0;
-        if (norm[2] < +sin10) iposz = 0;
-        if (norm[2] > -sin10) inegz = 0;
+    iv0 = tri[itri].indices[0] - 1;
+    iv1 = tri[itri].indices[1] - 1;
+    iv2 = tri[itri].indices[2] - 1;
+
+    uv[iv0].u = uvf[itri].u0;
+    uv[iv0].v = uvf[itri].v0;
+
+    uv[iv1].u = uvf[itri].u1;
+    uv[iv1].v = uvf[itri].v1;
+
+    uv[iv2].u = uvf[itri].u2;
+    uv[iv2].v = uvf[itri].v2;
+
+    ivmap[iv0] = 1;
+    ivmap[iv1] = 1;
+    ivmap[iv2] = 1;
+
+    itmap[itri] = 2;
+
+    /*
+     * flip this Triangle over if its area was negative
+     */
+    area = (uv[iv1].u - uv[iv0].u) * (uv[iv2].v - uv[iv0].v)
+         - (uv[iv1].v - uv[iv0].v) * (uv[iv2].u - uv[iv0].u);
+
+    if (area < 0) {
+        uv[iv0].u *= -1;
+        uv[iv1].u *= -1;
+        uv[iv2].u *= -1;
+
+        DPRINT1("triangle flipped because area = %f", area);
     }
-    DPRINT6("iposx=%d inegx=%d  iposy=%d inegy=%d  iposz=%d inegz=%d",
-            iposx, inegx, iposy, inegy, iposz, inegz);
 
     /*
-     * perform the first avalable transformation
+     * initialize the first-in-first-out list of Triangles to process
      */
-    if        (iposx == 1) {
-        DPRINT0("   simple +x projection");
-        for (ivrt = 0; ivrt < nvrt; ivrt++) {
-            uv[ivrt].u = xyz[ivrt].y;
-            uv[ivrt].v = xyz[ivrt].z;
-        }
-        status = PRM_OK_SIMPLE;
-    } else if (inegx == 1) {
-        DPRINT0("   simple -x projection");
-        for (ivrt = 0; ivrt < nvrt; ivrt++) {
-            uv[ivrt].u = xyz[ivrt].z;
-            uv[ivrt].v = xyz[ivrt].y;
-        }
-        status = PRM_OK_SIMPLE;
-    } else if (iposy == 1) {
-        DPRINT0("   simple +y projection");
-        for (ivrt = 0; ivrt < nvrt; ivrt++) {
-            uv[ivrt].u = xyz[ivrt].z;
-            uv[ivrt].v = xyz[ivrt].x;
-        }
-        status = PRM_OK_SIMPLE;
-    } else if (inegy == 1) {
-        DPRINT0("   simple -y projection");
-        for (ivrt = 0; ivrt < nvrt; ivrt++) {
-            uv[ivrt].u = xyz[ivrt].x;
-            uv[ivrt].v = xyz[ivrt].z;
-        }
-        status = PRM_OK_SIMPLE;
-    } else if (iposz == 1) {
-        DPRINT0("   simple +z projection");
-        for (ivrt = 0; ivrt < nvrt; ivrt++) {
-            uv[ivrt].u = xyz[ivrt].x;
-            uv[ivrt].v = xyz[ivrt].y;
-        }
-        status = PRM_OK_SIMPLE;
-    } else if (inegz == 1) {
-        DPRINT0("   simple -z projection");
-        for (ivrt = 0; ivrt < nvrt; ivrt++) {
-            uv[ivrt].u = xyz[ivrt].y;
-            uv[ivrt].v = xyz[ivrt].x;
+    nlist = 0;                  /* number of entries in list */
+    jlist = 0;                  /* next list item to process */
+
+    for (side = 0; side < 3; side++) {
+        jtri = tri[itri].neigh[side] - 1;
+
+        if (jtri >= 0 && itmap[jtri] == 0) {
+            itmap[jtri]   = 1;
+            list[nlist++] = jtri;
         }
-        status = PRM_OK_SIMPLE;
-    } else {
-        DPRINT0("   simple projection failed");
     }
 
     /*
-     * make sure that all Triangles have outward pointing normals
+     * process each list item (first-in-first-out)
      */
-    if (status == PRM_OK_SIMPLE) {
-        nneg = 0;
-        npos = 0;
-        for (itri = 0; itri < ntri; itri++) {
-            iv0 = tri[itri].indices[0] - 1;
-            iv1 = tri[itri].indices[1] - 1;
-            iv2 = tri[itri].indices[2] - 1;
+    while (jlist < nlist) {
+        itri = list[jlist++];
+        iv0  = tri[itri].indices[0] - 1;
+        iv1  = tri[itri].indices[1] - 1;
+        iv2  = tri[itri].indices[2] - 1;
 
-            area = (uv[iv1].u - uv[iv0].u) * (uv[iv2].v - uv[iv0].v)
-                 - (uv[iv1].v - uv[iv0].v) * (uv[iv2].u - uv[iv0].u);
-            if (area < 0) {
-                nneg++;
-            } else if (area > 0) {
-                npos++;
-            }
+        if        ((ivmap[iv0] == 1) && (ivmap[iv1] == 1) && (ivmap[iv2] == 1)) {
+            itmap[itri] = 2;
+        } else if ((ivmap[iv0] == 1) && (ivmap[iv1] == 1)) {
+            layDownTriangle2(uv, uvf[itri].u0, uvf[itri].v0, iv0,
+                                 uvf[itri].u1, uvf[itri].v1, iv1,
+                                 uvf[itri].u2, uvf[itri].v2, iv2);
+
+            ivmap[iv2 ] = 1;
+            itmap[itri] = 2;
+        } else if ((ivmap[iv1] == 1) && (ivmap[iv2] == 1)) {
+            layDownTriangle2(uv, uvf[itri].u1, uvf[itri].v1, iv1,
+                                 uvf[itri].u2, uvf[itri].v2, iv2,
+                                 uvf[itri].u0, uvf[itri].v0, iv0);
+
+            ivmap[iv0 ] = 1;
+            itmap[itri] = 2;
+        } else if ((ivmap[iv2] == 1) && (ivmap[iv0] == 1)) {
+            layDownTriangle2(uv, uvf[itri].u2, uvf[itri].v2, iv2,
+                                 uvf[itri].u0, uvf[itri].v0, iv0,
+                                 uvf[itri].u1, uvf[itri].v1, iv1);
+
+            ivmap[iv1 ] = 1;
+            itmap[itri] = 2;
         }
-        DPRINT3("ntri=%d   nneg=%d   npos=%d", ntri, nneg, npos);
 
-        if (nneg != 0) {
-            status = PRM_NOGLOBALUV;
-            goto cleanup;
+        /*
+         * add the neighbors to the list to process
+         */
+        for (side = 0; side < 3; side++) {
+            jtri = tri[itri].neigh[side] - 1;
+
+            if (jtri >= 0 && itmap[jtri] == 0) {
+                itmap[jtri]   = 1;
+                list[nlist++] = jtri;
+            }
         }
     }
 
-cleanup:
+    /*
+     * count the number of Triangles with a positive area
+     */
+    nneg = 0;
+    for (itri = 0; itri < ntri; itri++) {
+        iv0 = tri[itri].indices[0] - 1;
+        iv1 = tri[itri].indices[1] - 1;
+        iv2 = tri[itri].indices[2] - 1;
+
+        area = (uv[iv1].u - uv[iv0].u) * (uv[iv2].v - uv[iv0].v)
+             - (uv[iv1].v - uv[iv0].v) * (uv[iv2].u - uv[iv0].u);
+        if (area < EPS12) nneg++;
+    }
+    DPRINT2("jones transformation has nneg=%d of %d", nneg, ntri);
+
+    /*
+     * if all the areas are positive, set UVtype
+     *    and use the newly-slitted tessellation
+     */
+    if (nneg == 0) {
+        status = PRM_OK_JONES;
+    } else {
+
+#ifdef GRAFIC
+        plotTris(ntri, tri, nvrt, uv,
+                 "~U~V~Jones transformation with negative areas");
+#endif
+
+        status = PRM_NOGLOBALUV;
+    }
+
+ cleanup:
+    FREE(ivmap);
+    FREE(itmap);
+    FREE(list );
+
     DPRINT2("%s --> status=%d}", routine, status);
     return status;
 }
@@ -2681,1006 +3224,1751 @@ cleanup:
 /*
  ********************************************************************************
  *                                                                              *
- * unroll -- unroll (if possible)                                               *
+ * planarProjection -- use planar projection (if possible)                      *
  *                                                                              *
  ********************************************************************************
  */
 static int
-unroll(int      ntri,                        /* (in)   number of Triangles */
-       prmTri   tri[],                       /* (in)   array  of Triangles */
-       int      nvrt,                        /* (in)   number of Vertices */
-       prmXYZ   xyz[],                       /* (in)   array  of Coordinates */
-       prmUV    uv[])                        /* (out)  array  of Parameters */
+planarProjection(int      ntri,              /* (in)   number of Triangles */
+                 prmTri   tri[],             /* (in)   array  of Triangles */
+                 int      nvrt,              /* (in)   number of Vertices */
+                 prmXYZ   xyz[],             /* (in)   array  of Coordinates */
+                 prmUV    uv[])              /* (out)  array  of Parameters */
 {
     int         status = PRM_NOGLOBALUV;     /* (out)  return status */
                                              /*        PRM_NOGLOBALUV */
-                                             /*        PRM_OK_UNROLLING  */
-
-    int         *itmap = NULL;               /* Triangle mapping status */
-                                             /*          (0=not mapped, 1=scheduled, 2=mapped) */
-    int         *ivmap = NULL;               /* Vertex   mapping status */
-                                             /*          (0=not mapped, 1=mapped) */
-    int         *list  = NULL;               /* FIFO list of Triangles to process */
+                                             /*        PRM_OK_PLANAR */
 
-    double      area;
-    int         done[5][5][5];
-    double      error, error_min;
-    double      ubar, vbar, unew, vnew;
-    int         itheta;
-    int         i, j, k;
-    int         ibeg;
-    int         itri, jtri;
+    double      area, areax, areay, areaz, areamax;
+    int         itri;
     int         ivrt, iv0, iv1, iv2;
-    int         jlist;
-    int         nlist;
-    int         nneg;
-    int         side;
-    double      theta, theta_min, costht, sintht;
-    double      xmin, ymin, zmin;
-    double      xmax, ymax, zmax;
+    double      norm[3];
+    int         nneg, npos;
 
-    ROUTINE(unroll);
+    ROUTINE(planarProjection);
     DPRINT3("%s(ntri=%d, nvrt=%d) {",
             routine, ntri, nvrt);
 
     /* ----------------------------------------------------------------------- */
 
     /*
-     * get the arrays that will keep track of the mapping status of
-     *    the Vertices and Triangles
+     * find the total area vector
      */
-    MALLOC(ivmap, int, nvrt);
-    MALLOC(itmap, int, ntri);
-    MALLOC(list,  int, ntri);
+    areax   = 0;
+    areay   = 0;
+    areaz   = 0;
+    areamax = 0;
 
-    /*
-     * start unrolling at one Triangle in each "region" of the Quilt's
-     *    bounding box
-     */
-    for (k = 0; k < 5; k++) {
-        for (j = 0; j < 5; j++) {
-            for (i = 0; i < 5; i++) {
-                done[i][j][k] = 0;
-            }
-        }
-    }
+    for (itri = 0; itri < ntri; itri++) {
+        surfaceNormal(tri[itri].indices[0]-1,
+                      tri[itri].indices[1]-1,
+                      tri[itri].indices[2]-1, xyz, &area, norm);
 
-    xmin = +HUGEQ;
-    xmax = -HUGEQ;
-    ymin = +HUGEQ;
-    ymax = -HUGEQ;
-    zmin = +HUGEQ;
-    zmax = -HUGEQ;
+        areax += area * norm[0];
+        areay += area * norm[1];
+        areaz += area * norm[2];
 
-    for (ivrt = 0; ivrt < nvrt; ivrt++) {
-        xmin = MIN(xmin, xyz[ivrt].x);
-        xmax = MAX(xmax, xyz[ivrt].x);
-        ymin = MIN(ymin, xyz[ivrt].y);
-        ymax = MAX(ymax, xyz[ivrt].y);
-        zmin = MIN(zmin, xyz[ivrt].z);
-        zmax = MAX(zmax, xyz[ivrt].z);
+        areamax = MAX(areamax, area);
     }
 
-    for (ibeg = 0; ibeg < ntri; ibeg++) {
-        iv0 = tri[ibeg].indices[0] - 1;
+    DPRINT3("areax=%10.5f   areay=%10.5f   areaz=%10.5f",
+            areax, areay, areaz);
 
-        i = MINMAX(0, (int)(4.99 * (xyz[iv0].x - xmin) / (xmax - xmin)), 4);
-        j = MINMAX(0, (int)(4.99 * (xyz[iv0].y - ymin) / (ymax - ymin)), 4);
-        k = MINMAX(0, (int)(4.99 * (xyz[iv0].z - zmin) / (zmax - zmin)), 4);
+    /*
+     * exit if the area is very small (which probably means that there is
+     *    no projection direction
+     */
+    area  = sqrt(SQR(areax) + SQR(areay) + SQR(areaz));
+    if (area < areamax) {
+        goto cleanup;
+    } else {
+        areax /= area;
+        areay /= area;
+        areaz /= area;
+    }
 
-        if (done[i][j][k] == 0) {
-            done[i][j][k] = 1;
+    DPRINT3("areax=%10.5f, areay=%10.5f, areaz=%10.5f", areax, areay, areaz);
 
-            /*
-             * mark all Vertices and Triangles as not mapped
-             */
-            for (ivrt = 0; ivrt < nvrt; ivrt++) {
-                ivmap[ivrt] = 0;
-            }
-            for (itri = 0; itri < ntri; itri++) {
+    /*
+     * convert all xyz to uv
+     */
+    if        (fabs(areax) <= fabs(areay) && fabs(areax) <= fabs(areaz)) {
+        DPRINT0("typeX::  y,z->U  x->V");
+        for (ivrt = 0; ivrt < nvrt; ivrt++) {
+            uv[ivrt].u = areay * xyz[ivrt].z - areaz * xyz[ivrt].y;
+            uv[ivrt].v =         xyz[ivrt].x;
+        }
+    } else if (fabs(areay) <= fabs(areaz) && fabs(areay) <= fabs(areax)) {
+        DPRINT0("typeY::  z,x->U  y->V");
+        for (ivrt = 0; ivrt < nvrt; ivrt++) {
+            uv[ivrt].u = areaz * xyz[ivrt].x - areax * xyz[ivrt].z;
+            uv[ivrt].v =         xyz[ivrt].y;
+        }
+    } else {
+        DPRINT0("typeZ::  x,y->U  z->V");
+        for (ivrt = 0; ivrt < nvrt; ivrt++) {
+            uv[ivrt].u = areax * xyz[ivrt].y - areay * xyz[ivrt].x;
+            uv[ivrt].v =         xyz[ivrt].z;
+        }
+    }
+
+    /*
+     * make sure that all Triangles have outward pointing normals
+     */
+    nneg = 0;
+    npos = 0;
+    for (itri = 0; itri < ntri; itri++) {
+        iv0 = tri[itri].indices[0] - 1;
+        iv1 = tri[itri].indices[1] - 1;
+        iv2 = tri[itri].indices[2] - 1;
+
+        area = (uv[iv1].u - uv[iv0].u) * (uv[iv2].v - uv[iv0].v)
+             - (uv[iv1].v - uv[iv0].v) * (uv[iv2].u - uv[iv0].u);
+        if (area < 0) {
+            nneg++;
+        } else if (area > 0) {
+            npos++;
+        }
+    }
+    DPRINT3("ntri=%d   nneg=%d   npos=%d", ntri, nneg, npos);
+
+    /*
+     * if we got here, then the projection to the rotated z-plane was successful
+     */
+    if (npos == ntri) {
+        DPRINT0("   positive planar projection was successful");
+        status = PRM_OK_PLANAR;
+    } else if (nneg == ntri) {
+        DPRINT0("   negative planar projection was successful");
+        for (ivrt = 0; ivrt < nvrt; ivrt++) {
+            uv[ivrt].v = -(uv[ivrt].v);
+        }
+        status = PRM_OK_PLANAR;
+    } else {
+        DPRINT0("   planar projection failed");
+    }
+
+ cleanup:
+    DPRINT2("%s --> status=%d}", routine, status);
+    return status;
+}
+
+
+
+/*
+ ********************************************************************************
+ *                                                                              *
+ * simpleProjection -- use simple projection (if possible)                      *
+ *                                                                              *
+ ********************************************************************************
+ */
+static int
+simpleProjection(int      ntri,              /* (in)   number of Triangles */
+                 prmTri   tri[],             /* (in)   array  of Triangles */
+                 int      nvrt,              /* (in)   number of Vertices */
+                 prmXYZ   xyz[],             /* (in)   array  of Coordinates */
+                 prmUV    uv[])              /* (out)  array  of Parameters */
+{
+    int         status = PRM_NOGLOBALUV;     /* (out)  return status */
+                                             /*        PRM_NOGLOBALUV */
+                                             /*        PRM_OK_SIMPLE */
+
+    double      area, norm[3];
+    int         itri, ivrt, iposx, inegx, iposy, inegy, iposz, inegz;
+    int         iv0, iv1, iv2, npos, nneg;
+
+    double      sin10 = 0.17365;
+
+    ROUTINE(simpleProjection);
+    DPRINT3("%s(ntri=%d, nvrt=%d) {",
+            routine, ntri, nvrt);
+
+    /* ----------------------------------------------------------------------- */
+
+    /*
+     * initially all projections are assumed to be possible
+     */
+    iposx = 1;
+    inegx = 1;
+    iposy = 1;
+    inegy = 1;
+    iposz = 1;
+    inegz = 1;
+
+    /*
+     * loop through Triangles and eliminate possible projections
+     */
+    for (itri = 0; itri < ntri; itri++) {
+        iv0 = tri[itri].indices[0] - 1;
+        iv1 = tri[itri].indices[1] - 1;
+        iv2 = tri[itri].indices[2] - 1;
+
+        surfaceNormal(iv0, iv1, iv2, xyz, &area, norm);
+
+        if (norm[0] < +sin10) iposx = 0;
+        if (norm[0] > -sin10) inegx = 0;
+        if (norm[1] < +sin10) iposy = 0;
+        if (norm[1] > -sin10) inegy = 0;
+        if (norm[2] < +sin10) iposz = 0;
+        if (norm[2] > -sin10) inegz = 0;
+    }
+    DPRINT6("iposx=%d inegx=%d  iposy=%d inegy=%d  iposz=%d inegz=%d",
+            iposx, inegx, iposy, inegy, iposz, inegz);
+
+    /*
+     * perform the first avalable transformation
+     */
+    if        (iposx == 1) {
+        DPRINT0("   simple +x projection");
+        for (ivrt = 0; ivrt < nvrt; ivrt++) {
+            uv[ivrt].u = xyz[ivrt].y;
+            uv[ivrt].v = xyz[ivrt].z;
+        }
+        status = PRM_OK_SIMPLE;
+    } else if (inegx == 1) {
+        DPRINT0("   simple -x projection");
+        for (ivrt = 0; ivrt < nvrt; ivrt++) {
+            uv[ivrt].u = xyz[ivrt].z;
+            uv[ivrt].v = xyz[ivrt].y;
+        }
+        status = PRM_OK_SIMPLE;
+    } else if (iposy == 1) {
+        DPRINT0("   simple +y projection");
+        for (ivrt = 0; ivrt < nvrt; ivrt++) {
+            uv[ivrt].u = xyz[ivrt].z;
+            uv[ivrt].v = xyz[ivrt].x;
+        }
+        status = PRM_OK_SIMPLE;
+    } else if (inegy == 1) {
+        DPRINT0("   simple -y projection");
+        for (ivrt = 0; ivrt < nvrt; ivrt++) {
+            uv[ivrt].u = xyz[ivrt].x;
+            uv[ivrt].v = xyz[ivrt].z;
+        }
+        status = PRM_OK_SIMPLE;
+    } else if (iposz == 1) {
+        DPRINT0("   simple +z projection");
+        for (ivrt = 0; ivrt < nvrt; ivrt++) {
+            uv[ivrt].u = xyz[ivrt].x;
+            uv[ivrt].v = xyz[ivrt].y;
+        }
+        status = PRM_OK_SIMPLE;
+    } else if (inegz == 1) {
+        DPRINT0("   simple -z projection");
+        for (ivrt = 0; ivrt < nvrt; ivrt++) {
+            uv[ivrt].u = xyz[ivrt].y;
+            uv[ivrt].v = xyz[ivrt].x;
+        }
+        status = PRM_OK_SIMPLE;
+    } else {
+        DPRINT0("   simple projection failed");
+    }
+
+    /*
+     * make sure that all Triangles have outward pointing normals
+     */
+    if (status == PRM_OK_SIMPLE) {
+        nneg = 0;
+        npos = 0;
+        for (itri = 0; itri < ntri; itri++) {
+            iv0 = tri[itri].indices[0] - 1;
+            iv1 = tri[itri].indices[1] - 1;
+            iv2 = tri[itri].indices[2] - 1;
+
+            area = (uv[iv1].u - uv[iv0].u) * (uv[iv2].v - uv[iv0].v)
+                 - (uv[iv1].v - uv[iv0].v) * (uv[iv2].u - uv[iv0].u);
+            if (area < 0) {
+                nneg++;
+            } else if (area > 0) {
+                npos++;
+            }
+        }
+        DPRINT3("ntri=%d   nneg=%d   npos=%d", ntri, nneg, npos);
+
+        if (nneg != 0) {
+            status = PRM_NOGLOBALUV;
+            goto cleanup;
+        }
+    }
+
+cleanup:
+    DPRINT2("%s --> status=%d}", routine, status);
+    return status;
+}
+
+
+
+/*
+ ********************************************************************************
+ *                                                                              *
+ * unroll -- unroll (if possible)                                               *
+ *                                                                              *
+ ********************************************************************************
+ */
+static int
+unroll(int      ntri,                        /* (in)   number of Triangles */
+       prmTri   tri[],                       /* (in)   array  of Triangles */
+       int      nvrt,                        /* (in)   number of Vertices */
+       prmXYZ   xyz[],                       /* (in)   array  of Coordinates */
+       prmUV    uv[])                        /* (out)  array  of Parameters */
+{
+    int         status = PRM_NOGLOBALUV;     /* (out)  return status */
+                                             /*        PRM_NOGLOBALUV */
+                                             /*        PRM_OK_UNROLLING  */
+
+    int         *itmap = NULL;               /* Triangle mapping status */
+                                             /*          (0=not mapped, 1=scheduled, 2=mapped) */
+    int         *ivmap = NULL;               /* Vertex   mapping status */
+                                             /*          (0=not mapped, 1=mapped) */
+    int         *list  = NULL;               /* FIFO list of Triangles to process */
+
+    double      area;
+    int         done[5][5][5];
+    double      error, error_min;
+    double      ubar, vbar, unew, vnew;
+    int         itheta;
+    int         i, j, k;
+    int         ibeg;
+    int         itri, jtri;
+    int         ivrt, iv0, iv1, iv2;
+    int         jlist;
+    int         nlist;
+    int         nneg;
+    int         side;
+    double      theta, theta_min, costht, sintht;
+    double      xmin, ymin, zmin;
+    double      xmax, ymax, zmax;
+
+    ROUTINE(unroll);
+    DPRINT3("%s(ntri=%d, nvrt=%d) {",
+            routine, ntri, nvrt);
+
+    /* ----------------------------------------------------------------------- */
+
+    /*
+     * get the arrays that will keep track of the mapping status of
+     *    the Vertices and Triangles
+     */
+    MALLOC(ivmap, int, nvrt);
+    MALLOC(itmap, int, ntri);
+    MALLOC(list,  int, ntri);
+
+    /*
+     * start unrolling at one Triangle in each "region" of the Quilt's
+     *    bounding box
+     */
+    for (k = 0; k < 5; k++) {
+        for (j = 0; j < 5; j++) {
+            for (i = 0; i < 5; i++) {
+                done[i][j][k] = 0;
+            }
+        }
+    }
+
+    xmin = +HUGEQ;
+    xmax = -HUGEQ;
+    ymin = +HUGEQ;
+    ymax = -HUGEQ;
+    zmin = +HUGEQ;
+    zmax = -HUGEQ;
+
+    for (ivrt = 0; ivrt < nvrt; ivrt++) {
+        xmin = MIN(xmin, xyz[ivrt].x);
+        xmax = MAX(xmax, xyz[ivrt].x);
+        ymin = MIN(ymin, xyz[ivrt].y);
+        ymax = MAX(ymax, xyz[ivrt].y);
+        zmin = MIN(zmin, xyz[ivrt].z);
+        zmax = MAX(zmax, xyz[ivrt].z);
+    }
+
+    for (ibeg = 0; ibeg < ntri; ibeg++) {
+        iv0 = tri[ibeg].indices[0] - 1;
+
+        i = MINMAX(0, (int)(4.99 * (xyz[iv0].x - xmin) / (xmax - xmin)), 4);
+        j = MINMAX(0, (int)(4.99 * (xyz[iv0].y - ymin) / (ymax - ymin)), 4);
+        k = MINMAX(0, (int)(4.99 * (xyz[iv0].z - zmin) / (zmax - zmin)), 4);
+
+        if (done[i][j][k] == 0) {
+            done[i][j][k] = 1;
+
+            /*
+             * mark all Vertices and Triangles as not mapped
+             */
+            for (ivrt = 0; ivrt < nvrt; ivrt++) {
+                ivmap[ivrt] = 0;
+            }
+            for (itri = 0; itri < ntri; itri++) {
                 itmap[itri] = 0;
             }
 
-            /*
-             * set up the coordinates for the first Triangle
-             */
-            itri = ibeg;
-            iv0 = tri[itri].indices[0] - 1;
-            iv1 = tri[itri].indices[1] - 1;
-            iv2 = tri[itri].indices[2] - 1;
+            /*
+             * set up the coordinates for the first Triangle
+             */
+            itri = ibeg;
+            iv0 = tri[itri].indices[0] - 1;
+            iv1 = tri[itri].indices[1] - 1;
+            iv2 = tri[itri].indices[2] - 1;
+
+            uv[   iv0].u = 0.0;
+            uv[   iv0].v = 0.0;
+            ivmap[iv0]   = 1;
+
+            uv[   iv1].u = sqrt(  SQR(xyz[iv0].x - xyz[iv1].x)
+                                + SQR(xyz[iv0].y - xyz[iv1].y)
+                                + SQR(xyz[iv0].z - xyz[iv1].z));
+            uv[   iv1].v = 0.0;
+            ivmap[iv1]   = 1;
+
+            layDownTriangle(xyz, uv, iv0, iv1, iv2);
+            ivmap[iv2]   = 1;
+            itmap[itri]   = 2;
+
+            /*
+             * initialize the first-in-first-out list of Triangles to process
+             */
+            nlist = 0;                  /* number of entries in list */
+            jlist = 0;                  /* next list item to process */
+
+            for (side = 0; side < 3; side++) {
+                jtri = tri[itri].neigh[side] - 1;
+
+                if (jtri >= 0 && itmap[jtri] == 0) {
+                    itmap[jtri]   = 1;
+                    list[nlist++] = jtri;
+                }
+            }
+
+            /*
+             * process each list item (first-in-first-out)
+             */
+            while (jlist < nlist) {
+                itri = list[jlist++];
+                iv0 = tri[itri].indices[0] - 1;
+                iv1 = tri[itri].indices[1] - 1;
+                iv2 = tri[itri].indices[2] - 1;
+
+                if        ((ivmap[iv0] == 1) && (ivmap[iv1] == 1) && (ivmap[iv2] == 1)) {
+                    itmap[itri] = 2;
+                } else if ((ivmap[iv0] == 1) && (ivmap[iv1] == 1)) {
+                    layDownTriangle(xyz, uv, iv0, iv1, iv2);
+                    ivmap[iv2] = 1;
+                    itmap[itri] = 2;
+                } else if ((ivmap[iv1] == 1) && (ivmap[iv2] == 1)) {
+                    layDownTriangle(xyz, uv, iv1, iv2, iv0);
+                    ivmap[iv0] = 1;
+                    itmap[itri] = 2;
+                } else if ((ivmap[iv2] == 1) && (ivmap[iv0] == 1)) {
+                    layDownTriangle(xyz, uv, iv2, iv0, iv1);
+                    ivmap[iv1] = 1;
+                    itmap[itri] = 2;
+                }
+
+                /*
+                 * add the neighbors to the list to process
+                 */
+                for (side = 0; side < 3; side++) {
+                    jtri = tri[itri].neigh[side] - 1;
+
+                    if (jtri >= 0 && itmap[jtri] == 0) {
+                        itmap[jtri]   = 1;
+                        list[nlist++] = jtri;
+                    }
+                }
+            }
+
+            /*
+             * rotate and translate u and v so that their centroid is at
+             *    the origin and so that a "best-fit line" is in the u direction
+             */
+            ubar = 0.0;
+            vbar = 0.0;
+
+            for (ivrt = 0; ivrt < nvrt; ivrt++) {
+                ubar += uv[ivrt].u;
+                vbar += uv[ivrt].v;
+            }
+
+            ubar /= nvrt;
+            vbar /= nvrt;
+
+            for (ivrt = 0; ivrt < nvrt; ivrt++) {
+                uv[ivrt].u -= ubar;
+                uv[ivrt].v -= vbar;
+            }
+
+            error_min = +HUGEQ;
+            theta_min = 0.0;
+
+            for (itheta = -19; itheta <= 20; itheta++) {
+                theta = PI * itheta / 40.0;
+                error = 0.0;
+
+                costht = cos(theta);
+                sintht = sin(theta);
+
+                for (ivrt = 0; ivrt < nvrt; ivrt++) {
+                    error += SQR(uv[ivrt].u * sintht + uv[ivrt].v * costht);
+                }
+
+                if (error < error_min) {
+                    error_min = error;
+                    theta_min = theta;
+                }
+            }
+
+            costht = cos(theta_min);
+            sintht = sin(theta_min);
+
+            for (ivrt = 0; ivrt < nvrt; ivrt++) {
+                unew = uv[ivrt].u * costht - uv[ivrt].v * sintht;
+                vnew = uv[ivrt].u * sintht + uv[ivrt].v * costht;
+
+                uv[ivrt].u = unew;
+                uv[ivrt].v = vnew;
+            }
+
+            /*
+             * count the number of Triangles with a positive area
+             */
+            nneg = 0;
+            for (itri = 0; itri < ntri; itri++) {
+                iv0 = tri[itri].indices[0] - 1;
+                iv1 = tri[itri].indices[1] - 1;
+                iv2 = tri[itri].indices[2] - 1;
+
+                area = (uv[iv1].u - uv[iv0].u) * (uv[iv2].v - uv[iv0].v)
+                     - (uv[iv1].v - uv[iv0].v) * (uv[iv2].u - uv[iv0].u);
+                if (area < EPS12) nneg++;
+            }
+            DPRINT2("unrolling from Triangle %d has nneg = %d", ibeg, nneg);
+
+            /*
+             * if all the areas are positive, set UVtype
+             *    and copy the temporary uv values back into myQuilt->uv
+             */
+            if (nneg == 0) {
+                status = PRM_OK_UNROLLING;
+                goto cleanup;
+            }
+        }
+    }
+
+    /*
+     * if we got here, there is no good unrolling, so simply return
+     *    without updating UVtype
+     */
+
+    DPRINT0("no valid unrolling was found");
+    status = PRM_NOGLOBALUV;
+
+ cleanup:
+    FREE(ivmap);
+    FREE(itmap);
+    FREE(list );
+
+    DPRINT2("%s --> status=%d}", routine, status);
+    return status;
+}
+
+
+
+/*
+ ********************************************************************************
+ *                                                                              *
+ * fillHoles -- fill holes in a Triangulation                                   *
+ *                                                                              *
+ ********************************************************************************
+ */
+static int
+fillHoles(int      ntri,                     /* (in)   number of Triangles */
+          prmTri   tri[],                    /* (in)   array  of Triangles */
+          int      nvrt,                     /* (in)   number of Vertices */
+          prmUV    uv[],                     /* (in)   array  of parameters */
+          int      *newNtri,                 /* (out)  new number of Tri */
+          prmTri   *newTri[])                /* (out)  new array  of Tri */
+{
+    int      status = EGADS_SUCCESS;         /* (out)  return status */
+                                             /*        EGADS_SUCCESS */
+
+    typedef struct {
+        int     ibeg;                        /* first Vertex in Loop */
+        int     ilvl;                        /* level (starts at 0) */
+        int     ipar;                        /* parent Loop (or -1 for outer Loop */
+        int     nvrt;                        /* number of Vertices in Loop */
+    } lup_t;
+
+    int         nlup;                        /* number of Loops */
+    lup_t       *lup     = NULL;             /* array  of Loops */
+
+    int         *prev    = NULL;
+    int         *lupid   = NULL;
+    int         *ihole   = NULL;
+    int         *tempTri = NULL;
+    int         *cont    = NULL;
+    double      *uvcont  = NULL;
+
+    double      uu, vv;
+    int         found, ilup, ivrt, jlup, i, j, k, nn, ncont, ipass, nfig8;
+    int         itri, oldNtri, iv0, iv1, iv2;
+    fillArea    fast;
+
+
+    ROUTINE(fillHoles);
+    DPRINT3("%s(ntri=%d, nvrt=%d) {",
+            routine, ntri, nvrt);
+
+    /* ----------------------------------------------------------------------- */
+
+    /*
+     * allocate storage that will be used to keep track of the Loop
+     *    number and the previous Vertex in the Loop
+     */
+    MALLOC(prev,    int,    nvrt    );
+    MALLOC(lupid,   int,    nvrt    );
+    MALLOC(ihole,   int,    nvrt    );
+    MALLOC(lup,     lup_t,  MAXLOOPS);
+    MALLOC(tempTri, int,    3*nvrt  );
+    MALLOC(cont,    int,    MAXLOOPS);
+    MALLOC(uvcont,  double, 2*nvrt  );
+
+    /*
+     * for each Vertex that is along a boundary, keep track of
+     *    the prev Vertex on the boundary
+     */
+    for (ivrt = 0; ivrt < nvrt; ivrt++) {
+        prev[ ivrt] = -1;
+        lupid[ivrt] = -1;
+    }
+
+    nn = 0;
+    for (itri = 0; itri < ntri; itri++) {
+        iv0 = tri[itri].indices[0] - 1;
+        iv1 = tri[itri].indices[1] - 1;
+        iv2 = tri[itri].indices[2] - 1;
+
+        if (tri[itri].neigh[0] <= 0) {
+            nn++;
+            if (prev[iv2] == -1) {
+                prev[iv2] = iv1;
+            }
+        }
+        if (tri[itri].neigh[1] <= 0) {
+            nn++;
+            if (prev[iv0] == -1) {
+                prev[iv0] = iv2;
+            }
+        }
+        if (tri[itri].neigh[2] <= 0) {
+            nn++;
+            if (prev[iv1] == -1) {
+                prev[iv1] = iv0;
+            }
+        }
+    }
+
+    /*
+     * if there are no boundary Triangles, then make a copy
+     *    of the inputs and return
+     */
+    if (nn == 0) {
+        DPRINT0("no boundary Triangles");
+        MALLOC(*newTri, prmTri, ntri);
+        memcpy(*newTri, tri,    ntri*sizeof(prmTri));
+        *newNtri = ntri;
+        goto cleanup;
+    }
+
+    /*
+     * associate each boundary Vertex with a Loop
+     */
+    nlup = 0;
+    while (1) {
+
+        /*
+         * find a Vertex that has a prev but not a Loop
+         */
+        found = 0;
+        for (ivrt = 0; ivrt < nvrt; ivrt++) {
+            if ((prev[ivrt] >= 0) && (lupid[ivrt] < 0)) {
+                lupid[ivrt] = nlup;
+
+                lup[nlup].ibeg =  ivrt;
+                lup[nlup].ilvl =  0;
+                lup[nlup].ipar = -1;
+                lup[nlup].nvrt =  1;
+                nlup++;
+
+                found++;
+                break;
+            }
+        }
+
+        /*
+         * if no unassigned boundary Vertex is found, then exit
+         */
+        if (found == 0) {
+            break;
+        }
+
+        /*
+         * assign all the Vertices in the Loop
+         */
+        ivrt = prev[ivrt];
+        while (ivrt != lup[nlup-1].ibeg) {
+            lupid[ivrt] = nlup - 1;
+
+            lup[nlup-1].nvrt++;
+
+            ivrt = prev[ivrt];
+        }
+    }
+
+    /*
+     * if there is only one Loop, then just make a copy
+     *    of the inputs and return
+     */
+    if (nlup <= 1) {
+        DPRINT0("only 1 (outer) Loop");
+        MALLOC(*newTri, prmTri, ntri);
+        memcpy(*newTri, tri,    ntri*sizeof(prmTri));
+        *newNtri =ntri;
+        goto cleanup;
+    }
+
+    /*
+     * determine the level number (starting at 0 for outer Loop) for each Loop
+     */
+    for (ilup = 0; ilup < nlup; ilup++) {
+        ivrt = lup[ilup].ibeg;
+        uu   = uv[ivrt].u;
+        vv   = uv[ivrt].v;
+
+        for (jlup = 0; jlup < nlup; jlup++) {
+            if (jlup == ilup) continue;
+
+            if (insideLoop(uu, vv, lup[jlup].ibeg, uv, prev) > 0) {
+                lup[ilup].ilvl ++;
+            }
+        }
+    }
+
+    /*
+     * find the parent of each Loop
+     */
+    for (ilup = 0; ilup < nlup; ilup++) {
+        ivrt = lup[ilup].ibeg;
+        uu   = uv[ivrt].u;
+        vv   = uv[ivrt].v;
+
+        for (jlup = 0; jlup < nlup; jlup++) {
+            if (jlup == ilup) continue;
+
+            if (lup[ilup].ilvl == lup[jlup].ilvl+1) {
+                if (insideLoop(uu, vv, lup[jlup].ibeg, uv, prev) > 0) {
+                    lup[ilup].ipar = jlup;
+                    break;
+                }
+            }
+        }
+
+        DPRINT5("ilup=%2d, .ibeg=%4d, .nvrt=%4d, .ilvl=%2d, .ipar=%2d", ilup,
+                lup[ilup].ibeg,
+                lup[ilup].nvrt,
+                lup[ilup].ilvl,
+                lup[ilup].ipar);
+        ivrt = lup[ilup].ibeg;
+        for (i = 0; i < lup[ilup].nvrt; i++) {
+            DPRINT3("   %5d %10.5f %10.5f", ivrt, uv[ivrt].u, uv[ivrt].v);
+            ivrt = prev[ivrt];
+        }
+    }
+
+    /*
+     * get new tri array that is big enough for the new Triangles
+     */
+    *newNtri = ntri + 2 * nvrt;
+    MALLOC(*newTri, prmTri, *newNtri);
+    memcpy(*newTri, tri,        ntri*sizeof(prmTri));
+
+    /*
+     * fill the Loops that have "odd" level numbers
+     */
+    oldNtri  = ntri;
+    *newNtri = ntri;
+
+    for (ilup = 0; ilup < nlup; ilup++) {
+        if (lup[ilup].ilvl%2  == 0) continue;
+
+        DPRINT1("filling Loop %d", ilup);
+        ncont     = 1;
+        cont[0]   = lup[ilup].nvrt;
+        uvcont[0] = 0;
+        uvcont[1] = 0;
+        k         = 1;
+
+        ihole[k] = lup[ilup].ibeg;
+        for (i = 1; i <= cont[0]; i++) {
+            uvcont[2*k  ] = uv[  ihole[k]].u;
+            uvcont[2*k+1] = uv[  ihole[k]].v;
+            ihole[   k+1] = prev[ihole[k]];
+            k++;
+        }
+
+        /*
+         * splice in each of the children Loops
+         */
+        for (jlup = 0; jlup < nlup; jlup++) {
+            if (lup[jlup].ipar == ilup) {
+
+                DPRINT1("   contains Loop %d", jlup);
+                ncont++;
+                cont[ncont-1] = lup[jlup].nvrt;
+
+                ihole[k] = lup[jlup].ibeg;
+                for (i = 0; i < cont[ncont-1]; i++) {
+                    uvcont[2*k  ] = uv[  ihole[k]].u;
+                    uvcont[2*k+1] = uv[  ihole[k]].v;
+                    ihole[   k+1] = prev[ihole[k]];
+                    k++;
+                }
+            }
+        }
+
+        /*
+         * fill the Loop (with possible holes)
+         */
+        fast.pts   = NULL;
+        fast.segs  = NULL;
+        fast.front = NULL;
+        fast.grid  = NULL;
+        fast.link  = NULL;
+        for (ipass = 0; ipass <= 1; ipass++) {
+            status = EG_fillArea(-ncont, cont, uvcont, tempTri, &nfig8, ipass,
+                                 &fast);
+            DPRINT1("      EG_fillArea: status=%d", status);
+            if (status > 0) break;
+        }
+        if (fast.segs  != NULL) EG_free(fast.segs);
+        if (fast.pts   != NULL) EG_free(fast.pts);
+        if (fast.front != NULL) EG_free(fast.front);
+        if (fast.grid  != NULL) EG_free(fast.grid);
+        if (fast.link  != NULL) EG_free(fast.link);
+
+        /*
+         * add these Triangle to the end of the list
+         */
+        for (itri = 0; itri < status; itri++) {
+            (*newTri)[*newNtri].indices[0] = ihole[tempTri[3*itri  ]] + 1;
+            (*newTri)[*newNtri].indices[1] = ihole[tempTri[3*itri+1]] + 1;
+            (*newTri)[*newNtri].indices[2] = ihole[tempTri[3*itri+2]] + 1;
+            (*newTri)[*newNtri].neigh[  0] = 0;
+            (*newTri)[*newNtri].neigh[  1] = 0;
+            (*newTri)[*newNtri].neigh[  2] = 0;
+            (*newNtri)++;
+        }
+    }
+
+    /*
+     * set up the Triangle neighbor information for the new Triangles
+     *    (note the backwards loop since it is most likely that the neighnor
+     *    will be near the end of the list)
+     */
+    for (i = oldNtri; i < *newNtri; i++) {
+        iv0 = (*newTri)[i].indices[0];
+        iv1 = (*newTri)[i].indices[1];
+        iv2 = (*newTri)[i].indices[2];
+
+        for (j = *newNtri-1; j >= 0; j--) {
+            if        ((*newTri)[j].indices[2] == iv1 &&
+                       (*newTri)[j].indices[1] == iv2   ) {
+                (*newTri)[i].neigh[0] = j + 1;
+                (*newTri)[j].neigh[0] = i + 1;
+                break;
+            } else if ((*newTri)[j].indices[0] == iv1 &&
+                       (*newTri)[j].indices[2] == iv2   ) {
+                (*newTri)[i].neigh[0] = j + 1;
+                (*newTri)[j].neigh[1] = i + 1;
+                break;
+            } else if ((*newTri)[j].indices[1] == iv1 &&
+                       (*newTri)[j].indices[0] == iv2   ) {
+                (*newTri)[i].neigh[0] = j + 1;
+                (*newTri)[j].neigh[2] = i + 1;
+                break;
+            }
+        }
+
+        for (j = *newNtri-1; j >= 0; j--) {
+            if        ((*newTri)[j].indices[2] == iv2 &&
+                       (*newTri)[j].indices[1] == iv0   ) {
+                (*newTri)[i].neigh[1] = j + 1;
+                (*newTri)[j].neigh[0] = i + 1;
+                break;
+            } else if ((*newTri)[j].indices[0] == iv2 &&
+                       (*newTri)[j].indices[2] == iv0   ) {
+                (*newTri)[i].neigh[1] = j + 1;
+                (*newTri)[j].neigh[1] = i + 1;
+                break;
+            } else if ((*newTri)[j].indices[1] == iv2 &&
+                       (*newTri)[j].indices[0] == iv0   ) {
+                (*newTri)[i].neigh[1] = j + 1;
+                (*newTri)[j].neigh[2] = i + 1;
+                break;
+            }
+        }
+
+        for (j = *newNtri-1; j >= 0; j--) {
+            if        ((*newTri)[j].indices[2] == iv0 &&
+                       (*newTri)[j].indices[1] == iv1   ) {
+                (*newTri)[i].neigh[2] = j + 1;
+                (*newTri)[j].neigh[0] = i + 1;
+                break;
+            } else if ((*newTri)[j].indices[0] == iv0 &&
+                       (*newTri)[j].indices[2] == iv1   ) {
+                (*newTri)[i].neigh[2] = j + 1;
+                (*newTri)[j].neigh[1] = i + 1;
+                break;
+            } else if ((*newTri)[j].indices[1] == iv0 &&
+                       (*newTri)[j].indices[0] == iv1   ) {
+                (*newTri)[i].neigh[2] = j + 1;
+                (*newTri)[j].neigh[2] = i + 1;
+                break;
+            }
+        }
+        DPRINT4("neighbors for Triangle %4d (%4d,%4d,%4d)",
+                i, (*newTri)[i].neigh[0], (*newTri)[i].neigh[1], (*newTri)[i].neigh[2]);
+    }
+
+ cleanup:
+    FREE(uvcont );
+    FREE(cont   );
+    FREE(tempTri);
+    FREE(lup    );
+    FREE(ihole  );
+    FREE(lupid  );
+    FREE(prev   );
+
+    DPRINT2("%s --> status=%d}", routine, status);
+    return status;
+}
+
+
+
+/*
+ ********************************************************************************
+ *                                                                              *
+ * insideLoop -- check if point is inside the Loop                              *
+ *                                                                              *
+ ********************************************************************************
+ */
+static int
+insideLoop(double   uu,                      /* (in)   U-coord of point to check */
+           double   vv,                      /* (in)   V-coord of point to check */
+           int      ibeg,                    /* (in)   index of first Vertex in loop */
+           prmUV    uv[],                    /* (in)   UV-coords of Vertices */
+           int      next[])                  /* (in)   next Vertex in Loop (or -1) */
+{
+    int         inout = 0;                   /* (out)  returned value: */
+                                             /*        1 if inside Loop */
+                                             /*        0 otherwise */
+
+    int         ivrt, im1, ncross;
+    double      utmp;
+
+//    ROUTINE(insideLoop);
+//    DPRINT4("%s(uu=%f, vv=%f, ibeg=%d) {",
+//            routine, uu, vv, ibeg);
+
+    /* ----------------------------------------------------------------------- */
+
+    /*
+     * the following algorithm is from O"Rourke"s 'Computational Geometry in C'
+     *
+     * count the number of segments in the Loop that cross a horizontal
+     *    (constant V) ray from (uu,vv) to the left
+     */
+    ncross = 0;
+    im1    = ibeg;
+    ivrt   = next[im1];
+
+    while (1) {
+        if ((uv[ivrt].v > vv && uv[im1 ].v <= vv) ||
+            (uv[im1 ].v > vv && uv[ivrt].v <= vv)   ) {
+            utmp = ( uv[ivrt].u * (uv[im1 ].v - vv)
+                   - uv[im1 ].u * (uv[ivrt].v - vv))
+                 / (              (uv[im1 ].v - vv)
+                   -              (uv[ivrt].v - vv));
+            if (utmp > uu) {
+                ncross++;
+            }
+        }
+
+        if (ivrt == ibeg) break;
 
-            uv[   iv0].u = 0.0;
-            uv[   iv0].v = 0.0;
-            ivmap[iv0]   = 1;
+        im1  = ivrt;
+        ivrt = next[im1];
+    }
 
-            uv[   iv1].u = sqrt(  SQR(xyz[iv0].x - xyz[iv1].x)
-                                + SQR(xyz[iv0].y - xyz[iv1].y)
-                                + SQR(xyz[iv0].z - xyz[iv1].z));
-            uv[   iv1].v = 0.0;
-            ivmap[iv1]   = 1;
+    /*
+     * if there are an odd number of crosses, then we are inside
+     */
+    inout = ncross % 2;
 
-            layDownTriangle(xyz, uv, iv0, iv1, iv2);
-            ivmap[iv2]   = 1;
-            itmap[itri]   = 2;
+// cleanup:
+//    DPRINT2("%s --> inout=%d}", routine, inout);
+    return inout;
+}
 
-            /*
-             * initialize the first-in-first-out list of Triangles to process
-             */
-            nlist = 0;                  /* number of entries in list */
-            jlist = 0;                  /* next list item to process */
 
-            for (side = 0; side < 3; side++) {
-                jtri = tri[itri].neigh[side] - 1;
+
+/*
+ ********************************************************************************
+ *                                                                              *
+ * interp1D -- 1-D interpolation into a table                                   *
+ *                                                                              *
+ ********************************************************************************
+ */
+static double
+interp1D(double   xx,                        /* (in)   independent var for interp */
+         int      ntab,                      /* (in)   size of table */
+         double   xtab[],                    /* (in)   table of independent variables */
+         double   ytab[])                    /* (in)   table of   dependent variables */
+{
+    double      yy;                          /* (out)  interpolated value */
 
-                if (jtri >= 0 && itmap[jtri] == 0) {
-                    itmap[jtri]   = 1;
-                    list[nlist++] = jtri;
-                }
-            }
+    int         ileft, irite, imid;
+    double      frac;
 
-            /*
-             * process each list item (first-in-first-out)
-             */
-            while (jlist < nlist) {
-                itri = list[jlist++];
-                iv0 = tri[itri].indices[0] - 1;
-                iv1 = tri[itri].indices[1] - 1;
-                iv2 = tri[itri].indices[2] - 1;
+//    ROUTINE(interp1D);
+//    DPRINT3("%s(xx=%f, ntab=%d) {",
+//            routine, xx, ntab);
 
-                if        ((ivmap[iv0] == 1) && (ivmap[iv1] == 1) && (ivmap[iv2] == 1)) {
-                    itmap[itri] = 2;
-                } else if ((ivmap[iv0] == 1) && (ivmap[iv1] == 1)) {
-                    layDownTriangle(xyz, uv, iv0, iv1, iv2);
-                    ivmap[iv2] = 1;
-                    itmap[itri] = 2;
-                } else if ((ivmap[iv1] == 1) && (ivmap[iv2] == 1)) {
-                    layDownTriangle(xyz, uv, iv1, iv2, iv0);
-                    ivmap[iv0] = 1;
-                    itmap[itri] = 2;
-                } else if ((ivmap[iv2] == 1) && (ivmap[iv0] == 1)) {
-                    layDownTriangle(xyz, uv, iv2, iv0, iv1);
-                    ivmap[iv1] = 1;
-                    itmap[itri] = 2;
-                }
+    /* ----------------------------------------------------------------------- */
 
-                /*
-                 * add the neighbors to the list to process
-                 */
-                for (side = 0; side < 3; side++) {
-                    jtri = tri[itri].neigh[side] - 1;
+    /*
+     * binary search for interval
+     */
+    ileft = 0;
+    irite = ntab - 1;
 
-                    if (jtri >= 0 && itmap[jtri] == 0) {
-                        itmap[jtri]   = 1;
-                        list[nlist++] = jtri;
-                    }
-                }
-            }
+    while (irite > ileft+1) {
+        imid = (ileft + irite) / 2;
+        if (xx < xtab[imid]) {
+            irite = imid;
+        } else {
+            ileft = imid;
+        }
+    }
 
-            /*
-             * rotate and translate u and v so that their centroid is at
-             *    the origin and so that a "best-fit line" is in the u direction
-             */
-            ubar = 0.0;
-            vbar = 0.0;
+    /*
+     * linear interpolation
+     */
+    frac = (xx - xtab[ileft]) / (xtab[irite] - xtab[ileft]);
+    yy   = (1 - frac) * ytab[ileft] + frac * ytab[irite];
 
-            for (ivrt = 0; ivrt < nvrt; ivrt++) {
-                ubar += uv[ivrt].u;
-                vbar += uv[ivrt].v;
-            }
+// cleanup:
+//    DPRINT2("%s --> yy=%f}", routine, yy);
+    return yy;
+}
+
+
+
+#ifdef GRAFIC
+/*
+ ********************************************************************************
+ *                                                                              *
+ * plotTris -- plot the UV coordinates (using GRAFIC)                           *
+ *                                                                              *
+ ********************************************************************************
+ */
+extern void
+plotTris(int      ntri,                      /* (in)   number of Triangles */
+         prmTri   tri[],                     /* (in)   array  of Triangles */
+         int      nvrt,                      /* (in)   number of Vertices */
+         prmUV    uv[],                      /* (in)   array  of Parameters */
+         char     pltitl[])                  /* (in)   plot title */
+{
+    int         io_kbd = 5;
+    int         io_scr = 6;
+    int         indgr   = 1 + 2 + 4 + 16 + 64;
+
+    ROUTINE(plotTris);
+    DPRINT3("%s(ntri=%d, nvrt=%d) {",
+            routine, ntri, nvrt);
+
+    /* ----------------------------------------------------------------------- */
+
+    grinit_(&io_kbd, &io_scr, "plotTris",
+                       strlen("plotTris"));
+    grctrl_(plotTrisImage, &indgr, pltitl,
+            (void*)(&ntri), (void*)(tri), (void*)(&nvrt),
+            (void*)(uv),    NULL, NULL,
+            NULL, NULL, NULL, NULL, strlen(pltitl));
+
+// cleanup:
+    DPRINT1("%s}", routine);
+}
+#endif
+
+
+
+#ifdef GRAFIC
+/*
+ ********************************************************************************
+ *                                                                              *
+ * plotTrisImage -- used by plotTris                                            *
+ *                                                                              *
+ ********************************************************************************
+ */
+static void
+plotTrisImage(int   *ifunct,                 /* (in)   GRAFIC function indicator */
+              void  *ntriP,                  /* (in)   number of Triangles */
+              void  *triP,                   /* (in)   array  of Triangles */
+              void  *nvrtP,                  /* (in)   number of Vertices */
+              void  *uvP,                    /* (in)   array  of Parametric Coords */
+              void  *a4,                     /* (in)   dummy GRAFIC argument */
+              void  *a5,                     /* (in)   dummy GRAFIC argument */
+              void  *a6,                     /* (in)   dummy GRAFIC argument */
+              void  *a7,                     /* (in)   dummy GRAFIC argument */
+              void  *a8,                     /* (in)   dummy GRAFIC argument */
+              void  *a9,                     /* (in)   dummy GRAFIC argument */
+              float *scale,                  /* (out)  array of scales */
+              char  *text,                   /* (out)  help text */
+              int   textlen)                 /* (in)   length of text */
+{
+    int    *ntri   = (int    *) ntriP;
+    int    *nvrt   = (int    *) nvrtP;
+    prmTri *tri    = (prmTri *) triP;
+    prmUV  *uv     = (prmUV  *) uvP;
+
+    int    itri, ivrt, iv0, iv1, iv2, nneg;
+    double umin, umax, vmin, vmax;
+    float  u[3], v[3], area;
+
+    int    ithree  = 3;
+    int    iblack  = GR_BLACK;
+    int    ired    = GR_RED;
+    int    igreen  = GR_GREEN;
 
-            ubar /= nvrt;
-            vbar /= nvrt;
+//    ROUTINE(plotTrisImage);
 
-            for (ivrt = 0; ivrt < nvrt; ivrt++) {
-                uv[ivrt].u -= ubar;
-                uv[ivrt].v -= vbar;
-            }
+    /* ----------------------------------------------------------------------- */
 
-            error_min = +HUGEQ;
-            theta_min = 0.0;
+    /* ---------- return scales ----------*/
+    if (*ifunct == 0) {
+        umin = uv[0].u;
+        umax = uv[0].u;
+        vmin = uv[0].v;
+        vmax = uv[0].v;
 
-            for (itheta = -19; itheta <= 20; itheta++) {
-                theta = PI * itheta / 40.0;
-                error = 0.0;
+        for (ivrt = 1; ivrt < *nvrt; ivrt++) {
+            umin = MIN(umin, uv[ivrt].u);
+            umax = MAX(umax, uv[ivrt].u);
+            vmin = MIN(vmin, uv[ivrt].v);
+            vmax = MAX(vmax, uv[ivrt].v);
+        }
 
-                costht = cos(theta);
-                sintht = sin(theta);
+        scale[0] = umin;
+        scale[1] = umax;
+        scale[2] = vmin;
+        scale[3] = vmax;
 
-                for (ivrt = 0; ivrt < nvrt; ivrt++) {
-                    error += SQR(uv[ivrt].u * sintht + uv[ivrt].v * costht);
-                }
+        strncpy(text, "X", textlen-1);
 
-                if (error < error_min) {
-                    error_min = error;
-                    theta_min = theta;
-                }
-            }
+    /* ---------- plot image ---------- */
+    } else if (*ifunct == 1) {
 
-            costht = cos(theta_min);
-            sintht = sin(theta_min);
+        /*
+         * outlines in green and black
+         */
+        for (itri = 0; itri < *ntri; itri++) {
+            iv0 = tri[itri].indices[0] - 1;
+            iv1 = tri[itri].indices[1] - 1;
+            iv2 = tri[itri].indices[2] - 1;
 
-            for (ivrt = 0; ivrt < nvrt; ivrt++) {
-                unew = uv[ivrt].u * costht - uv[ivrt].v * sintht;
-                vnew = uv[ivrt].u * sintht + uv[ivrt].v * costht;
+            u[0] = uv[iv0].u;
+            u[1] = uv[iv1].u;
+            u[2] = uv[iv2].u;
+            v[0] = uv[iv0].v;
+            v[1] = uv[iv1].v;
+            v[2] = uv[iv2].v;
 
-                uv[ivrt].u = unew;
-                uv[ivrt].v = vnew;
-            }
+            grmov2_(&u[0], &v[0]);
 
-            /*
-             * count the number of Triangles with a positive area
-             */
-            nneg = 0;
-            for (itri = 0; itri < ntri; itri++) {
-                iv0 = tri[itri].indices[0] - 1;
-                iv1 = tri[itri].indices[1] - 1;
-                iv2 = tri[itri].indices[2] - 1;
+            if (tri[itri].neigh[2] > 0) {
+                grcolr_(&igreen);
+            } else {
+                grcolr_(&iblack);
+            }
+            grdrw2_(&u[1], &v[1]);
 
-                area = (uv[iv1].u - uv[iv0].u) * (uv[iv2].v - uv[iv0].v)
-                     - (uv[iv1].v - uv[iv0].v) * (uv[iv2].u - uv[iv0].u);
-                if (area < EPS12) nneg++;
+            if (tri[itri].neigh[0] > 0) {
+                grcolr_(&igreen);
+            } else {
+                grcolr_(&iblack);
             }
-            DPRINT2("unrolling from Triangle %d has nneg = %d", ibeg, nneg);
+            grdrw2_(&u[2], &v[2]);
 
-            /*
-             * if all the areas are positive, set UVtype
-             *    and copy the temporary uv values back into myQuilt->uv
-             */
-            if (nneg == 0) {
-                status = PRM_OK_UNROLLING;
-                goto cleanup;
+            if (tri[itri].neigh[1] > 0) {
+                grcolr_(&igreen);
+            } else {
+                grcolr_(&iblack);
             }
+            grdrw2_(&u[0], &v[0]);
         }
-    }
 
-    /*
-     * if we got here, there is no good unrolling, so simply return
-     *    without updating UVtype
-     */
+        /*
+         * cells with negative areas in red
+         */
+        nneg = 0;
+        for (itri = 0; itri < *ntri; itri++) {
+            iv0 = tri[itri].indices[0] - 1;
+            iv1 = tri[itri].indices[1] - 1;
+            iv2 = tri[itri].indices[2] - 1;
 
-    DPRINT0("no valid unrolling was found");
-    status = PRM_NOGLOBALUV;
+            u[0] = uv[iv0].u;
+            u[1] = uv[iv1].u;
+            u[2] = uv[iv2].u;
+            v[0] = uv[iv0].v;
+            v[1] = uv[iv1].v;
+            v[2] = uv[iv2].v;
 
- cleanup:
-    FREE(ivmap);
-    FREE(itmap);
-    FREE(list );
+            area = (u[1] - u[0]) * (v[2] - v[0])
+                 - (v[1] - v[0]) * (u[2] - u[0]);
 
-    DPRINT2("%s --> status=%d}", routine, status);
-    return status;
+            if (area <= 0) {
+                grfil2_(u, v, &ithree, &ired);
+                nneg++;
+
+                DPRINT2("itri=%d   area=%f", itri, area);
+                DPRINT3("%5d %15.8f %15.8f", iv0, u[0], v[0]);
+                DPRINT3("%5d %15.8f %15.8f", iv1, u[1], v[1]);
+                DPRINT3("%5d %15.8f %15.8f", iv2, u[2], v[2]);
+            }
+        }
+
+        if (nneg > 0) {
+            printf("%d triangles with area <= 0\n", nneg);
+        }
+
+        grcolr_(&iblack);
+    }
 }
+#endif
 
 
 
 /*
  ********************************************************************************
  *                                                                              *
- * fillHoles -- fill holes in a Triangulation                                   *
+ * printSMF -- print a sparse matrix                                            *
  *                                                                              *
  ********************************************************************************
  */
-static int
-fillHoles(int      ntri,                     /* (in)   number of Triangles */
-          prmTri   tri[],                    /* (in)   array  of Triangles */
-          int      nvrt,                     /* (in)   number of Vertices */
-          prmUV    uv[],                     /* (in)   array  of parameters */
-          int      *newNtri,                 /* (out)  new number of Tri */
-          prmTri   *newTri[])                /* (out)  new array  of Tri */
+extern int
+printSMF(FILE     *fp,                       /* (in)   file pointer */
+         double   asmf[],                    /* (in)   sparse-matrix data */
+         int      ismf[],                    /* (in)   sparse-matrix indices */
+         double   x[],                       /* (in)   initial  guess */
+         double   rhs[])                     /* (in)   right-hand side */
 {
-    int      status = EGADS_SUCCESS;         /* (out)  return status */
-                                             /*        EGADS_SUCCESS */
-
-    typedef struct {
-        int     ibeg;                        /* first Vertex in Loop */
-        int     ilvl;                        /* level (starts at 0) */
-        int     ipar;                        /* parent Loop (or -1 for outer Loop */
-        int     nvrt;                        /* number of Vertices in Loop */
-    } lup_t;
-
-    int         nlup;                        /* number of Loops */
-    lup_t       *lup     = NULL;             /* array  of Loops */
-
-    int         *prev    = NULL;
-    int         *lupid   = NULL;
-    int         *ihole   = NULL;
-    int         *tempTri = NULL;
-    int         *cont    = NULL;
-    double      *uvcont  = NULL;
-
-    double      uu, vv;
-    int         found, ilup, ivrt, jlup, i, j, k, nn, ncont, ipass, nfig8;
-    int         itri, oldNtri, iv0, iv1, iv2;
-    fillArea    fast;
-
-
-    ROUTINE(fillHoles);
-    DPRINT3("%s(ntri=%d, nvrt=%d) {",
-            routine, ntri, nvrt);
-
-    /* ----------------------------------------------------------------------- */
-
-    /*
-     * allocate storage that will be used to keep track of the Loop
-     *    number and the previous Vertex in the Loop
-     */
-    MALLOC(prev,    int,    nvrt    );
-    MALLOC(lupid,   int,    nvrt    );
-    MALLOC(ihole,   int,    nvrt    );
-    MALLOC(lup,     lup_t,  MAXLOOPS);
-    MALLOC(tempTri, int,    3*nvrt  );
-    MALLOC(cont,    int,    MAXLOOPS);
-    MALLOC(uvcont,  double, 2*nvrt  );
-
-    /*
-     * for each Vertex that is along a boundary, keep track of
-     *    the prev Vertex on the boundary
-     */
-    for (ivrt = 0; ivrt < nvrt; ivrt++) {
-        prev[ ivrt] = -1;
-        lupid[ivrt] = -1;
-    }
+    int         status = EGADS_SUCCESS;      /* (out)  return status */
+                                             /*        >0  number of iterations taken */
+                                             /*        PRM_NOTCONVERGED */
+                                             /*        PRM_ZEROPIVOT */
 
-    nn = 0;
-    for (itri = 0; itri < ntri; itri++) {
-        iv0 = tri[itri].indices[0] - 1;
-        iv1 = tri[itri].indices[1] - 1;
-        iv2 = tri[itri].indices[2] - 1;
+    int         i, k, n;
 
-        if (tri[itri].neigh[0] <= 0) {
-            nn++;
-            if (prev[iv2] == -1) {
-                prev[iv2] = iv1;
-            }
-        }
-        if (tri[itri].neigh[1] <= 0) {
-            nn++;
-            if (prev[iv0] == -1) {
-                prev[iv0] = iv2;
-            }
-        }
-        if (tri[itri].neigh[2] <= 0) {
-            nn++;
-            if (prev[iv1] == -1) {
-                prev[iv1] = iv0;
-            }
-        }
-    }
+//    ROUTINE(printSMF);
+//    DPRINT2("%s(ismf[0]=%d) {",
+//            routine, ismf[0]);
 
-    /*
-     * if there are no boundary Triangles, then make a copy
-     *    of the inputs and return
-     */
-    if (nn == 0) {
-        DPRINT0("no boundary Triangles");
-        MALLOC(*newTri, prmTri, ntri);
-        memcpy(*newTri, tri,    ntri*sizeof(prmTri));
-        *newNtri = ntri;
-        goto cleanup;
-    }
+    /* ----------------------------------------------------------------------- */
 
     /*
-     * associate each boundary Vertex with a Loop
+     * extract the matrix size from ismf
      */
-    nlup = 0;
-    while (1) {
+    n = ismf[0] - 1;
 
-        /*
-         * find a Vertex that has a prev but not a Loop
-         */
-        found = 0;
-        for (ivrt = 0; ivrt < nvrt; ivrt++) {
-            if ((prev[ivrt] >= 0) && (lupid[ivrt] < 0)) {
-                lupid[ivrt] = nlup;
+    /*
+     * print the matrix
+     */
+    for (i = 0; i < n; i++) {
+        fprintf(fp, "%5d    %5d %10.5f %10.5f %10.5f\n",
+                i, ismf[i], asmf[i], x[i], rhs[i]);
+        for (k = ismf[i]; k < ismf[i+1]; k++) {
+//$$$            if (asmf[k] != 0) {
+                fprintf(fp, "   %5d %5d %10.5f\n", k, ismf[k], asmf[k]);
+//$$$            }
+        }
+    }
 
-                lup[nlup].ibeg =  ivrt;
-                lup[nlup].ilvl =  0;
-                lup[nlup].ipar = -1;
-                lup[nlup].nvrt =  1;
-                nlup++;
+// cleanup:
+//    DPRINT2("%s --> status=%d}", routine, status);
+    return status;
+}
 
-                found++;
-                break;
-            }
-        }
 
-        /*
-         * if no unassigned boundary Vertex is found, then exit
-         */
-        if (found == 0) {
-            break;
-        }
+
+/*
+ ********************************************************************************
+ *                                                                              *
+ * sparseBCG -- solve sparse matrix with biconjugate gradient                   *
+ *                                                                              *
+ ********************************************************************************
+ */
+extern int
+sparseBCG(double   asmf[],                   /* (in)   sparse-matrix data */
+          int      ismf[],                   /* (in)   sparse-matrix indices */
+          double   x[],                      /* (in)   initial  guess */
+                                             /* (out)  solution to A * x = rhs */
+          double   rhs[])                    /* (in)   right-hand side */
+{
+    int         status = EGADS_SUCCESS;      /* (out)  return status */
+                                             /*        >0  number of iterations taken */
+                                             /*        PRM_NOTCONVERGED */
+                                             /*        PRM_ZEROPIVOT */
 
-        /*
-         * assign all the Vertices in the Loop
-         */
-        ivrt = prev[ivrt];
-        while (ivrt != lup[nlup-1].ibeg) {
-            lupid[ivrt] = nlup - 1;
+    double      *p  = NULL;
+    double      *pp = NULL;
+    double      *r  = NULL;
+    double      *rr = NULL;
+    double      *z  = NULL;
+    double      *zz = NULL;
 
-            lup[nlup-1].nvrt++;
+    double      err, rmin, rmax;
+    double      ak,        akden;
+    double      bk, bknum, bkden;
+    int         i, j, k, n, ipass, iter;
 
-            ivrt = prev[ivrt];
-        }
-    }
+    double      tol     = 1e-8;              /* convergence tolerance */
+    int         maxiter = 10000;             /* maximum number iterations */
+    int         maxpass = 10;                /* maximum number of passes */
+
+    ROUTINE(sparseBCG);
+    DPRINT2("%s(ismf[0]=%d) {",
+            routine, ismf[0]);
+
+    /* ----------------------------------------------------------------------- */
 
     /*
-     * if there is only one Loop, then just make a copy
-     *    of the inputs and return
+     * extract the matrix size from ismf
      */
-    if (nlup <= 1) {
-        DPRINT0("only 1 (outer) Loop");
-        MALLOC(*newTri, prmTri, ntri);
-        memcpy(*newTri, tri,    ntri*sizeof(prmTri));
-        *newNtri =ntri;
-        goto cleanup;
-    }
+    n = ismf[0] - 1;
 
     /*
-     * determine the level number (starting at 0 for outer Loop) for each Loop
+     * if all rhs are zero, just return the trivial result
      */
-    for (ilup = 0; ilup < nlup; ilup++) {
-        ivrt = lup[ilup].ibeg;
-        uu   = uv[ivrt].u;
-        vv   = uv[ivrt].v;
-
-        for (jlup = 0; jlup < nlup; jlup++) {
-            if (jlup == ilup) continue;
-
-            if (insideLoop(uu, vv, lup[jlup].ibeg, uv, prev) > 0) {
-                lup[ilup].ilvl ++;
-            }
+    rmin = +HUGEQ;
+    rmax = -HUGEQ;
+    for (i = 0; i < n; i++) {
+        rmin = MIN(rmin, rhs[i]);
+        rmax = MAX(rmax, rhs[i]);
+    }
+    if (fabs(rmin) < tol && fabs(rmax) < tol) {
+        for (i = 0; i < n; i++) {
+            x[i] = 0;
         }
+        goto cleanup;
     }
 
     /*
-     * find the parent of each Loop
+     * make sure that no diagonal elements are zero
      */
-    for (ilup = 0; ilup < nlup; ilup++) {
-        ivrt = lup[ilup].ibeg;
-        uu   = uv[ivrt].u;
-        vv   = uv[ivrt].v;
-
-        for (jlup = 0; jlup < nlup; jlup++) {
-            if (jlup == ilup) continue;
-
-            if (lup[ilup].ilvl == lup[jlup].ilvl+1) {
-                if (insideLoop(uu, vv, lup[jlup].ibeg, uv, prev) > 0) {
-                    lup[ilup].ipar = jlup;
-                    break;
-                }
-            }
-        }
-
-        DPRINT5("ilup=%2d, .ibeg=%4d, .nvrt=%4d, .ilvl=%2d, .ipar=%2d", ilup,
-                lup[ilup].ibeg,
-                lup[ilup].nvrt,
-                lup[ilup].ilvl,
-                lup[ilup].ipar);
-        ivrt = lup[ilup].ibeg;
-        for (i = 0; i < lup[ilup].nvrt; i++) {
-            DPRINT3("   %5d %10.5f %10.5f", ivrt, uv[ivrt].u, uv[ivrt].v);
-            ivrt = prev[ivrt];
+    for (i = 0; i < n; i++) {
+        if (fabs(asmf[i]) < EPS20) {
+            status = PRM_ZEROPIVOT;
+            goto cleanup;
         }
     }
 
     /*
-     * get new tri array that is big enough for the new Triangles
+     * allocate the needed matrixes
      */
-    *newNtri = ntri + 2 * nvrt;
-    MALLOC(*newTri, prmTri, *newNtri);
-    memcpy(*newTri, tri,        ntri*sizeof(prmTri));
+    MALLOC(p,  double, n);
+    MALLOC(pp, double, n);
+    MALLOC(r,  double, n);
+    MALLOC(rr, double, n);
+    MALLOC(z,  double, n);
+    MALLOC(zz, double, n);
 
     /*
-     * fill the Loops that have "odd" level numbers
+     * solve the matrix using biconjugate gradient technique.
+     *    code below is adapted from "Numerical Recipes"
+     *
+     * multiple passes might be needed if we ever get a zero denominator
      */
-    oldNtri  = ntri;
-    *newNtri = ntri;
-
-    for (ilup = 0; ilup < nlup; ilup++) {
-        if (lup[ilup].ilvl%2  == 0) continue;
-
-        DPRINT1("filling Loop %d", ilup);
-        ncont     = 1;
-        cont[0]   = lup[ilup].nvrt;
-        uvcont[0] = 0;
-        uvcont[1] = 0;
-        k         = 1;
-
-        ihole[k] = lup[ilup].ibeg;
-        for (i = 1; i <= cont[0]; i++) {
-            uvcont[2*k  ] = uv[  ihole[k]].u;
-            uvcont[2*k+1] = uv[  ihole[k]].v;
-            ihole[   k+1] = prev[ihole[k]];
-            k++;
-        }
+    ipass = 0;
+ new_pass:
+    ipass++;
 
-        /*
-         * splice in each of the children Loops
-         */
-        for (jlup = 0; jlup < nlup; jlup++) {
-            if (lup[jlup].ipar == ilup) {
+    if (ipass > maxpass) {
+        status = PRM_NOTCONVERGED;
+        goto cleanup;
+    }
 
-                DPRINT1("   contains Loop %d", jlup);
-                ncont++;
-                cont[ncont-1] = lup[jlup].nvrt;
+    /*
+     * calculate the initial residual
+     */
+    for (i = 0; i < n; i++) {                /* A * x -> r */
+        r[i] = asmf[i] * x[i];
 
-                ihole[k] = lup[jlup].ibeg;
-                for (i = 0; i < cont[ncont-1]; i++) {
-                    uvcont[2*k  ] = uv[  ihole[k]].u;
-                    uvcont[2*k+1] = uv[  ihole[k]].v;
-                    ihole[   k+1] = prev[ihole[k]];
-                    k++;
-                }
-            }
+        for (k = ismf[i]; k < ismf[i+1]; k++) {
+            j     = ismf[k];
+            r[i] += asmf[k] * x[j];
         }
+    }
 
-        /*
-         * fill the Loop (with possible holes)
-         */
-        fast.pts   = NULL;
-        fast.segs  = NULL;
-        fast.front = NULL;
-        for (ipass = 0; ipass <= 1; ipass++) {
-            status = EG_fillArea(-ncont, cont, uvcont, tempTri, &nfig8, ipass,
-                                 &fast);
-            DPRINT1("      EG_fillArea: status=%d", status);
-            if (status > 0) break;
-        }
-        if (fast.segs  != NULL) EG_free(fast.segs);
-        if (fast.pts   != NULL) EG_free(fast.pts);
-        if (fast.front != NULL) EG_free(fast.front);
+    for (j = 0; j < n; j++) {
+        r[ j] = rhs[j] - r[j];
+        rr[j] = r[j];
+    }
 
-        /*
-         * add these Triangle to the end of the list
-         */
-        for (itri = 0; itri < status; itri++) {
-            (*newTri)[*newNtri].indices[0] = ihole[tempTri[3*itri  ]] + 1;
-            (*newTri)[*newNtri].indices[1] = ihole[tempTri[3*itri+1]] + 1;
-            (*newTri)[*newNtri].indices[2] = ihole[tempTri[3*itri+2]] + 1;
-            (*newTri)[*newNtri].neigh[  0] = 0;
-            (*newTri)[*newNtri].neigh[  1] = 0;
-            (*newTri)[*newNtri].neigh[  2] = 0;
-            (*newNtri)++;
-        }
+    for (j = 0; j < n; j++) {
+        z[j] = r[j] / asmf[j];
     }
 
     /*
-     * set up the Triangle neighbor information for the new Triangles
-     *    (note the backwards loop since it is most likely that the neighnor
-     *    will be near the end of the list)
+     * jump out if we already have a solution
      */
-    for (i = oldNtri; i < *newNtri; i++) {
-        iv0 = (*newTri)[i].indices[0];
-        iv1 = (*newTri)[i].indices[1];
-        iv2 = (*newTri)[i].indices[2];
+    err = 0;
+    for (j = 0; j < n; j++) {
+        err += SQR(r[j]);
+    }
+    err = sqrt(err);
+    if (err < tol) {
+        goto cleanup;
+    }
 
-        for (j = *newNtri-1; j >= 0; j--) {
-            if        ((*newTri)[j].indices[2] == iv1 &&
-                       (*newTri)[j].indices[1] == iv2   ) {
-                (*newTri)[i].neigh[0] = j + 1;
-                (*newTri)[j].neigh[0] = i + 1;
-                break;
-            } else if ((*newTri)[j].indices[0] == iv1 &&
-                       (*newTri)[j].indices[2] == iv2   ) {
-                (*newTri)[i].neigh[0] = j + 1;
-                (*newTri)[j].neigh[1] = i + 1;
-                break;
-            } else if ((*newTri)[j].indices[1] == iv1 &&
-                       (*newTri)[j].indices[0] == iv2   ) {
-                (*newTri)[i].neigh[0] = j + 1;
-                (*newTri)[j].neigh[2] = i + 1;
-                break;
-            }
+    /*
+     * main iteration loop
+     */
+    bkden = 0;
+
+    for (iter = 0; iter < maxiter; iter++) {
+        DPRINT2("iter=%5d  err=%15.8e", iter, err);
+
+        for (j = 0; j < n; j++) {
+            zz[j] = rr[j] / asmf[j];
         }
 
-        for (j = *newNtri-1; j >= 0; j--) {
-            if        ((*newTri)[j].indices[2] == iv2 &&
-                       (*newTri)[j].indices[1] == iv0   ) {
-                (*newTri)[i].neigh[1] = j + 1;
-                (*newTri)[j].neigh[0] = i + 1;
-                break;
-            } else if ((*newTri)[j].indices[0] == iv2 &&
-                       (*newTri)[j].indices[2] == iv0   ) {
-                (*newTri)[i].neigh[1] = j + 1;
-                (*newTri)[j].neigh[1] = i + 1;
-                break;
-            } else if ((*newTri)[j].indices[1] == iv2 &&
-                       (*newTri)[j].indices[0] == iv0   ) {
-                (*newTri)[i].neigh[1] = j + 1;
-                (*newTri)[j].neigh[2] = i + 1;
-                break;
-            }
+        /*
+         * calculate coefficient bk and direction vectors p and pp
+         */
+        bknum = 0;
+        for (j = 0; j < n; j++) {
+            bknum += z[j] * rr[j];
         }
 
-        for (j = *newNtri-1; j >= 0; j--) {
-            if        ((*newTri)[j].indices[2] == iv0 &&
-                       (*newTri)[j].indices[1] == iv1   ) {
-                (*newTri)[i].neigh[2] = j + 1;
-                (*newTri)[j].neigh[0] = i + 1;
-                break;
-            } else if ((*newTri)[j].indices[0] == iv0 &&
-                       (*newTri)[j].indices[2] == iv1   ) {
-                (*newTri)[i].neigh[2] = j + 1;
-                (*newTri)[j].neigh[1] = i + 1;
-                break;
-            } else if ((*newTri)[j].indices[1] == iv0 &&
-                       (*newTri)[j].indices[0] == iv1   ) {
-                (*newTri)[i].neigh[2] = j + 1;
-                (*newTri)[j].neigh[2] = i + 1;
-                break;
+        if (iter == 0) {
+            for (j = 0; j < n; j++) {
+                p[ j] = z[ j];
+                pp[j] = zz[j];
+            }
+        } else {
+            bk = bknum / bkden;
+            for (j = 0; j < n; j++) {
+                p[ j] = bk * p[ j] +z[ j];
+                pp[j] = bk * pp[j] +zz[j];
             }
         }
-        DPRINT4("neighbors for Triangle %4d (%4d,%4d,%4d)",
-                i, (*newTri)[i].neigh[0], (*newTri)[i].neigh[1], (*newTri)[i].neigh[2]);
-    }
-
- cleanup:
-    FREE(uvcont );
-    FREE(cont   );
-    FREE(tempTri);
-    FREE(lup    );
-    FREE(ihole  );
-    FREE(lupid  );
-    FREE(prev   );
 
-    DPRINT2("%s --> status=%d}", routine, status);
-    return status;
-}
+        /*
+         * calculate coefficient ak, new iterate x, and new residuals r and rr
+         */
+        bkden = bknum;
 
+        if (fabs(bkden) < EPS20) {
+            DPRINT2("restarting because bknum = %f (ipass=%d)", bknum, ipass);
+            goto new_pass;
+        }
 
-
-/*
- ********************************************************************************
- *                                                                              *
- * insideLoop -- check if point is inside the Loop                              *
- *                                                                              *
- ********************************************************************************
- */
-static int
-insideLoop(double   uu,                      /* (in)   U-coord of point to check */
-           double   vv,                      /* (in)   V-coord of point to check */
-           int      ibeg,                    /* (in)   index of first Vertex in loop */
-           prmUV    uv[],                    /* (in)   UV-coords of Vertices */
-           int      next[])                  /* (in)   next Vertex in Loop (or -1) */
-{
-    int         inout = 0;                   /* (out)  returned value: */
-                                             /*        1 if inside Loop */
-                                             /*        0 otherwise */
+        for (i = 0; i < n; i++) {       /* A * p -> z */
+            z[i] = asmf[i] * p[i];
 
-    int         ivrt, im1, ncross;
-    double      utmp;
+            for (k = ismf[i]; k < ismf[i+1]; k++) {
+                j     = ismf[k];
+                z[i] += asmf[k] * p[j];
+            }
+        }
 
-//    ROUTINE(insideLoop);
-//    DPRINT4("%s(uu=%f, vv=%f, ibeg=%d) {",
-//            routine, uu, vv, ibeg);
+        akden = 0;
+        for (j = 0; j < n; j++) {
+            akden += z[j] * pp[j];
+        }
 
-    /* ----------------------------------------------------------------------- */
+        if (fabs(akden) < EPS20) {
+            DPRINT2("restarting because akden = %f (ipass=%d)", akden, ipass);
+            goto new_pass;
+        }
 
-    /*
-     * the following algorithm is from O"Rourke"s 'Computational Geometry in C'
-     *
-     * count the number of segments in the Loop that cross a horizontal
-     *    (constant V) ray from (uu,vv) to the left
-     */
-    ncross = 0;
-    im1    = ibeg;
-    ivrt   = next[im1];
+        for (i = 0; i < n; i++) {        /* AT * pp -> zz */
+            zz[i] = asmf[i] * pp[i];
+        }
 
-    while (1) {
-        if ((uv[ivrt].v > vv && uv[im1 ].v <= vv) ||
-            (uv[im1 ].v > vv && uv[ivrt].v <= vv)   ) {
-            utmp = ( uv[ivrt].u * (uv[im1 ].v - vv)
-                   - uv[im1 ].u * (uv[ivrt].v - vv))
-                 / (              (uv[im1 ].v - vv)
-                   -              (uv[ivrt].v - vv));
-            if (utmp > uu) {
-                ncross++;
+        for (i = 0; i < n; i++) {
+            for (k = ismf[i]; k < ismf[i+1]; k++) {
+                j      = ismf[k];
+                zz[j] += asmf[k] * pp[i];
             }
         }
 
-        if (ivrt == ibeg) break;
-
-        im1  = ivrt;
-        ivrt = next[im1];
-    }
-
-    /*
-     * if there are an odd number of crosses, then we are inside
-     */
-    inout = ncross % 2;
-
-// cleanup:
-//    DPRINT2("%s --> inout=%d}", routine, inout);
-    return inout;
-}
+        ak = bknum / akden;
+        for (j = 0; j < n; j++) {
+            x[ j] += ak * p[ j];
+            r[ j] -= ak * z[ j];
+            rr[j] -= ak * zz[j];
+        }
 
+        for (j = 0; j < n; j++) {
+            z[j] = r[j] / asmf[j];
+        }
 
-
-/*
- ********************************************************************************
- *                                                                              *
- * interp1D -- 1-D interpolation into a table                                   *
- *                                                                              *
- ********************************************************************************
- */
-static double
-interp1D(double   xx,                        /* (in)   independent var for interp */
-         int      ntab,                      /* (in)   size of table */
-         double   xtab[],                    /* (in)   table of independent variables */
-         double   ytab[])                    /* (in)   table of   dependent variables */
-{
-    double      yy;                          /* (out)  interpolated value */
+        /*
+         * solve a! * z = r and check stopping criterion
+         */
+        err = 0;
+        for (j = 0; j < n; j++) {
+            err += SQR(r[j]);
+        }
+        err = sqrt(err);
 
-    int         ileft, irite, imid;
-    double      frac;
+        if (err < tol) {
+            goto cleanup;
+        }
+    }
 
-//    ROUTINE(interp1D);
-//    DPRINT3("%s(xx=%f, ntab=%d) {",
-//            routine, xx, ntab);
+    DPRINT1("exceeded maxiter=%d", maxiter);
+    status = PRM_NOTCONVERGED;
 
-    /* ----------------------------------------------------------------------- */
+ cleanup:
+#ifdef DEBUG
+    if (status == PRM_ZEROPIVOT || status == PRM_NOTCONVERGED) {
+        double check;
+      
+        DPRINT1("Sparse matrix that caused status=%d", status);
 
-    /*
-     * binary search for interval
-     */
-    ileft = 0;
-    irite = ntab - 1;
+        for (i = 0; i < ismf[0]-1; i++) {
+            check = -rhs[i] + asmf[i] * x[i];
+            for (j = ismf[i]; j < ismf[i+1]; j++) {
+                check += asmf[j] * x[ismf[j]];
+            }
 
-    while (irite > ileft+1) {
-        imid = (ileft + irite) / 2;
-        if (xx < xtab[imid]) {
-            irite = imid;
-        } else {
-            ileft = imid;
+            DPRINT5("%5d      %12.6f %12.6f %12.6f %12.4e",
+                    i, asmf[i], x[i], rhs[i], check);
+
+            for (j = ismf[i]; j < ismf[i+1]; j++) {
+                DPRINT2("     %5d %12.6f", ismf[j], asmf[j]);
+            }
         }
     }
+#endif
 
-    /*
-     * linear interpolation
-     */
-    frac = (xx - xtab[ileft]) / (xtab[irite] - xtab[ileft]);
-    yy   = (1 - frac) * ytab[ileft] + frac * ytab[irite];
+    FREE(zz);
+    FREE(z );
+    FREE(rr);
+    FREE(r );
+    FREE(pp);
+    FREE(p );
 
-// cleanup:
-//    DPRINT2("%s --> yy=%f}", routine, yy);
-    return yy;
+    DPRINT2("%s --> status=%d}", routine, status);
+    return status;
 }
 
 
 
-#ifdef GRAFIC
 /*
  ********************************************************************************
  *                                                                              *
- * plotTris -- plot the UV coordinates (using GRAFIC)                           *
+ * multRows -- y = A * x over a range of rows                                   *
  *                                                                              *
  ********************************************************************************
  */
-extern void
-plotTris(int      ntri,                      /* (in)   number of Triangles */
-         prmTri   tri[],                     /* (in)   array  of Triangles */
-         int      nvrt,                      /* (in)   number of Vertices */
-         prmUV    uv[],                      /* (in)   array  of Parameters */
-         char     pltitl[])                  /* (in)   plot title */
+static void
+multRows(void     *data,                     /* (in)   prmMult structure */
+         int      ilo,                       /* (in)   first row */
+         int      ihi)                       /* (in)   last  row (+1) */
 {
-    int         io_kbd = 5;
-    int         io_scr = 6;
-    int         indgr   = 1 + 2 + 4 + 16 + 64;
+    prmMult     *mult = (prmMult *) data;
+    double      *asmf = mult->asmf;
+    int         *ismf = mult->ismf;
 
-    ROUTINE(plotTris);
-    DPRINT3("%s(ntri=%d, nvrt=%d) {",
-            routine, ntri, nvrt);
+    int         i, j, k;
 
     /* ----------------------------------------------------------------------- */
 
-    grinit_(&io_kbd, &io_scr, "plotTris",
-                       strlen("plotTris"));
-    grctrl_(plotTrisImage, &indgr, pltitl,
-            (void*)(&ntri), (void*)(tri), (void*)(&nvrt),
-            (void*)(uv),    NULL, NULL,
-            NULL, NULL, NULL, NULL, strlen(pltitl));
+    for (i = ilo; i < ihi; i++) {
+        mult->y[i] = asmf[i] * mult->x[i];
 
-// cleanup:
-    DPRINT1("%s}", routine);
+        for (k = ismf[i]; k < ismf[i+1]; k++) {
+            j           = ismf[k];
+            mult->y[i] += asmf[k] * mult->x[j];
+        }
+    }
 }
-#endif
 
 
-
-#ifdef GRAFIC
+
 /*
  ********************************************************************************
  *                                                                              *
- * plotTrisImage -- used by plotTris                                            *
+ * multSMF -- y = A * x (threaded for large matrices)                           *
  *                                                                              *
  ********************************************************************************
  */
 static void
-plotTrisImage(int   *ifunct,                 /* (in)   GRAFIC function indicator */
-              void  *ntriP,                  /* (in)   number of Triangles */
-              void  *triP,                   /* (in)   array  of Triangles */
-              void  *nvrtP,                  /* (in)   number of Vertices */
-              void  *uvP,                    /* (in)   array  of Parametric Coords */
-              void  *a4,                     /* (in)   dummy GRAFIC argument */
-              void  *a5,                     /* (in)   dummy GRAFIC argument */
-              void  *a6,                     /* (in)   dummy GRAFIC argument */
-              void  *a7,                     /* (in)   dummy GRAFIC argument */
-              void  *a8,                     /* (in)   dummy GRAFIC argument */
-              void  *a9,                     /* (in)   dummy GRAFIC argument */
-              float *scale,                  /* (out)  array of scales */
-              char  *text,                   /* (out)  help text */
-              int   textlen)                 /* (in)   length of text */
+multSMF(EMPteam  *team,                      /* (in)   team of threads to use */
+        double   asmf[],                     /* (in)   sparse-matrix data */
+        int      ismf[],                     /* (in)   sparse-matrix indices */
+        double   x[],                        /* (in)   vector */
+        double   y[])                        /* (out)  A * x */
 {
-    int    *ntri   = (int    *) ntriP;
-    int    *nvrt   = (int    *) nvrtP;
-    prmTri *tri    = (prmTri *) triP;
-    prmUV  *uv     = (prmUV  *) uvP;
-
-    int    itri, ivrt, iv0, iv1, iv2, nneg;
-    double umin, umax, vmin, vmax;
-    float  u[3], v[3], area;
-
-    int    ithree  = 3;
-    int    iblack  = GR_BLACK;
-    int    ired    = GR_RED;
-    int    igreen  = GR_GREEN;
-
-//    ROUTINE(plotTrisImage);
+    int         n, chunk;
+    prmMult     mult;
 
     /* ----------------------------------------------------------------------- */
 
-    /* ---------- return scales ----------*/
-    if (*ifunct == 0) {
-        umin = uv[0].u;
-        umax = uv[0].u;
-        vmin = uv[0].v;
-        vmax = uv[0].v;
+    mult.asmf = asmf;
+    mult.ismf = ismf;
+    mult.x    = x;
+    mult.y    = y;
 
-        for (ivrt = 1; ivrt < *nvrt; ivrt++) {
-            umin = MIN(umin, uv[ivrt].u);
-            umax = MAX(umax, uv[ivrt].u);
-            vmin = MIN(vmin, uv[ivrt].v);
-            vmax = MAX(vmax, uv[ivrt].v);
-        }
+    n     = ismf[0] - 1;
+    chunk = (n + 4*team->nthread - 1) / (4*team->nthread);
 
-        scale[0] = umin;
-        scale[1] = umax;
-        scale[2] = vmin;
-        scale[3] = vmax;
+    teamRun(team, n, MAX(chunk, 1), multRows, &mult);
+}
 
-        strncpy(text, "X", textlen-1);
 
-    /* ---------- plot image ---------- */
-    } else if (*ifunct == 1) {
 
-        /*
-         * outlines in green and black
-         */
-        for (itri = 0; itri < *ntri; itri++) {
-            iv0 = tri[itri].indices[0] - 1;
-            iv1 = tri[itri].indices[1] - 1;
-            iv2 = tri[itri].indices[2] - 1;
+/*
+ ********************************************************************************
+ *                                                                              *
+ * factorILU -- incomplete LU factorization (no fill) of an SMF matrix          *
+ *                                                                              *
+ ********************************************************************************
+ */
+static int
+factorILU(double   asmf[],                   /* (in)   sparse-matrix data */
+          int      ismf[],                   /* (in)   sparse-matrix indices */
+          double   alu[],                    /* (out)  factored data (in SMF form) */
+          int      ilu[])                    /* (out)  indices (rows sorted) */
+{
+    int         status = EGADS_SUCCESS;      /* (out)  return status */
+                                             /*        PRM_ZEROPIVOT */
 
-            u[0] = uv[iv0].u;
-            u[1] = uv[iv1].u;
-            u[2] = uv[iv2].u;
-            v[0] = uv[iv0].v;
-            v[1] = uv[iv1].v;
-            v[2] = uv[iv2].v;
+    int         i, j, k, m, n, jtemp;
+    int         *iw = NULL;
+    double      lij, atemp;
 
-            grmov2_(&u[0], &v[0]);
+    ROUTINE(factorILU);
+    DPRINT2("%s(ismf[0]=%d) {",
+            routine, ismf[0]);
 
-            if (tri[itri].neigh[2] > 0) {
-                grcolr_(&igreen);
-            } else {
-                grcolr_(&iblack);
-            }
-            grdrw2_(&u[1], &v[1]);
+    /* ----------------------------------------------------------------------- */
 
-            if (tri[itri].neigh[0] > 0) {
-                grcolr_(&igreen);
-            } else {
-                grcolr_(&iblack);
-            }
-            grdrw2_(&u[2], &v[2]);
+    n = ismf[0] - 1;
 
-            if (tri[itri].neigh[1] > 0) {
-                grcolr_(&igreen);
-            } else {
-                grcolr_(&iblack);
+    /*
+     * copy the matrix, sorting the off-diagonals of each row by column
+     */
+    for (k = 0; k < ismf[n]; k++) {
+        alu[k] = asmf[k];
+        ilu[k] = ismf[k];
+    }
+    for (i = 0; i < n; i++) {
+        for (k = ilu[i]+1; k < ilu[i+1]; k++) {
+            for (m = k; m > ilu[i] && ilu[m-1] > ilu[m]; m--) {
+                jtemp    = ilu[m-1];
+                ilu[m-1] = ilu[m];
+                ilu[m  ] = jtemp;
+                atemp    = alu[m-1];
+                alu[m-1] = alu[m];
+                alu[m  ] = atemp;
             }
-            grdrw2_(&u[0], &v[0]);
         }
+    }
 
-        /*
-         * cells with negative areas in red
-         */
-        nneg = 0;
-        for (itri = 0; itri < *ntri; itri++) {
-            iv0 = tri[itri].indices[0] - 1;
-            iv1 = tri[itri].indices[1] - 1;
-            iv2 = tri[itri].indices[2] - 1;
+    MALLOC(iw, int, n);
+    for (j = 0; j < n; j++) {
+        iw[j] = -1;
+    }
 
-            u[0] = uv[iv0].u;
-            u[1] = uv[iv1].u;
-            u[2] = uv[iv2].u;
-            v[0] = uv[iv0].v;
-            v[1] = uv[iv1].v;
-            v[2] = uv[iv2].v;
+    /*
+     * row-by-row elimination restricted to the sparsity pattern
+     */
+    for (i = 0; i < n; i++) {
+        iw[i] = i;
+        for (k = ilu[i]; k < ilu[i+1]; k++) {
+            iw[ilu[k]] = k;
+        }
 
-            area = (u[1] - u[0]) * (v[2] - v[0])
-                 - (v[1] - v[0]) * (u[2] - u[0]);
+        for (k = ilu[i]; k < ilu[i+1]; k++) {
+            j = ilu[k];
+            if (j >= i) break;
 
-            if (area <= 0) {
-                grfil2_(u, v, &ithree, &ired);
-                nneg++;
+            lij    = alu[k] / alu[j];
+            alu[k] = lij;
 
-                DPRINT2("itri=%d   area=%f", itri, area);
-                DPRINT3("%5d %15.8f %15.8f", iv0, u[0], v[0]);
-                DPRINT3("%5d %15.8f %15.8f", iv1, u[1], v[1]);
-                DPRINT3("%5d %15.8f %15.8f", iv2, u[2], v[2]);
+            for (m = ilu[j]; m < ilu[j+1]; m++) {
+                if (ilu[m] <= j || iw[ilu[m]] < 0) continue;
+                alu[iw[ilu[m]]] -= lij * alu[m];
             }
         }
 
-        if (nneg > 0) {
-            printf("%d triangles with area <= 0\n", nneg);
+        for (k = ilu[i]; k < ilu[i+1]; k++) {
+            iw[ilu[k]] = -1;
         }
+        iw[i] = -1;
 
-        grcolr_(&iblack);
+        if (fabs(alu[i]) < EPS20) {
+            DPRINT1("zero pivot in row %d", i);
+            status = PRM_ZEROPIVOT;
+            goto cleanup;
+        }
     }
+
+ cleanup:
+    FREE(iw);
+
+    DPRINT2("%s --> status=%d}", routine, status);
+    return status;
 }
-#endif
 
 
 
 /*
  ********************************************************************************
  *                                                                              *
- * printSMF -- print a sparse matrix                                            *
+ * solveILU -- apply the ILU(0) preconditioner: z = (LU)^-1 * r                 *
  *                                                                              *
  ********************************************************************************
  */
-extern int
-printSMF(FILE     *fp,                       /* (in)   file pointer */
-         double   asmf[],                    /* (in)   sparse-matrix data */
-         int      ismf[],                    /* (in)   sparse-matrix indices */
-         double   x[],                       /* (in)   initial  guess */
-         double   rhs[])                     /* (in)   right-hand side */
+static void
+solveILU(int      n,                         /* (in)   size of the matrix */
+         double   alu[],                     /* (in)   factored data */
+         int      ilu[],                     /* (in)   factored indices */
+         double   r[],                       /* (in)   vector */
+         double   z[])                       /* (out)  preconditioned vector */
 {
-    int         status = EGADS_SUCCESS;      /* (out)  return status */
-                                             /*        >0  number of iterations taken */
-                                             /*        PRM_NOTCONVERGED */
-                                             /*        PRM_ZEROPIVOT */
-
-    int         i, k, n;
-
-//    ROUTINE(printSMF);
-//    DPRINT2("%s(ismf[0]=%d) {",
-//            routine, ismf[0]);
+    int         i, k;
 
     /* ----------------------------------------------------------------------- */
 
-    /*
-     * extract the matrix size from ismf
-     */
-    n = ismf[0] - 1;
-
-    /*
-     * print the matrix
-     */
-    for (i = 0; i < n; i++) {
-        fprintf(fp, "%5d    %5d %10.5f %10.5f %10.5f\n",
-                i, ismf[i], asmf[i], x[i], rhs[i]);
-        for (k = ismf[i]; k < ismf[i+1]; k++) {
-//$$$            if (asmf[k] != 0) {
-                fprintf(fp, "   %5d %5d %10.5f\n", k, ismf[k], asmf[k]);
-//$$$            }
+    for (i = 0; i < n; i++) {                /* L * y = r  (unit diagonal) */
+        z[i] = r[i];
+        for (k = ilu[i]; k < ilu[i+1]; k++) {
+            if (ilu[k] >= i) break;
+            z[i] -= alu[k] * z[ilu[k]];
         }
     }
 
-// cleanup:
-//    DPRINT2("%s --> status=%d}", routine, status);
-    return status;
+    for (i = n-1; i >= 0; i--) {             /* U * z = y */
+        for (k = ilu[i+1]-1; k >= ilu[i]; k--) {
+            if (ilu[k] <= i) break;
+            z[i] -= alu[k] * z[ilu[k]];
+        }
+        z[i] /= alu[i];
+    }
 }
 
 
@@ -3688,44 +4976,51 @@ printSMF(FILE     *fp,                       /* (in)   file pointer */
 /*
  ********************************************************************************
  *                                                                              *
- * sparseBCG -- solve sparse matrix with biconjugate gradient                   *
+ * sparseILU -- solve sparse matrix with ILU(0) preconditioned BiCGSTAB         *
  *                                                                              *
  ********************************************************************************
  */
 extern int
-sparseBCG(double   asmf[],                   /* (in)   sparse-matrix data */
+sparseILU(double   asmf[],                   /* (in)   sparse-matrix data */
           int      ismf[],                   /* (in)   sparse-matrix indices */
           double   x[],                      /* (in)   initial  guess */
                                              /* (out)  solution to A * x = rhs */
           double   rhs[])                    /* (in)   right-hand side */
 {
     int         status = EGADS_SUCCESS;      /* (out)  return status */
-                                             /*        >0  number of iterations taken */
                                              /*        PRM_NOTCONVERGED */
                                              /*        PRM_ZEROPIVOT */
 
-    double      *p  = NULL;
-    double      *pp = NULL;
-    double      *r  = NULL;
-    double      *rr = NULL;
-    double      *z  = NULL;
-    double      *zz = NULL;
-
-    double      err, rmin, rmax;
-    double      ak,        akden;
-    double      bk, bknum, bkden;
-    int         i, j, k, n, ipass, iter;
+    double      *alu = NULL;
+    int         *ilu = NULL;
+    double      *r   = NULL;
+    double      *rh  = NULL;
+    double      *p   = NULL;
+    double      *ph  = NULL;
+    double      *v   = NULL;
+    double      *s   = NULL;
+    double      *sh  = NULL;
+    double      *t   = NULL;
+
+    double      err, rmin, rmax, rho, rhold, alpha, omega, beta, den;
+    int         j, n, np, ipass, iter;
+    EMPteam     team;
 
     double      tol     = 1e-8;              /* convergence tolerance */
     int         maxiter = 10000;             /* maximum number iterations */
     int         maxpass = 10;                /* maximum number of passes */
 
-    ROUTINE(sparseBCG);
+    ROUTINE(sparseILU);
     DPRINT2("%s(ismf[0]=%d) {",
             routine, ismf[0]);
 
     /* ----------------------------------------------------------------------- */
 
+    team.mutex   = NULL;
+    team.gate[0] = NULL;
+    team.gate[1] = NULL;
+    team.threads = NULL;
+
     /*
      * extract the matrix size from ismf
      */
@@ -3736,13 +5031,13 @@ sparseBCG(double   asmf[],                   /* (in)   sparse-matrix data */
      */
     rmin = +HUGEQ;
     rmax = -HUGEQ;
-    for (i = 0; i < n; i++) {
-        rmin = MIN(rmin, rhs[i]);
-        rmax = MAX(rmax, rhs[i]);
+    for (j = 0; j < n; j++) {
+        rmin = MIN(rmin, rhs[j]);
+        rmax = MAX(rmax, rhs[j]);
     }
     if (fabs(rmin) < tol && fabs(rmax) < tol) {
-        for (i = 0; i < n; i++) {
-            x[i] = 0;
+        for (j = 0; j < n; j++) {
+            x[j] = 0;
         }
         goto cleanup;
     }
@@ -3750,30 +5045,46 @@ sparseBCG(double   asmf[],                   /* (in)   sparse-matrix data */
     /*
      * make sure that no diagonal elements are zero
      */
-    for (i = 0; i < n; i++) {
-        if (fabs(asmf[i]) < EPS20) {
+    for (j = 0; j < n; j++) {
+        if (fabs(asmf[j]) < EPS20) {
             status = PRM_ZEROPIVOT;
             goto cleanup;
         }
     }
 
     /*
-     * allocate the needed matrixes
+     * only thread the products when there is enough work per thread (the
+     *    team is created once and used for every product in the solve)
      */
-    MALLOC(p,  double, n);
-    MALLOC(pp, double, n);
+    np = EMP_Init(NULL);
+    np = MIN(np, (ismf[n] - 1) / SMFPERTHREAD);
+    teamCreate(np, &team);
+
+    /*
+     * factor the preconditioner
+     */
+    MALLOC(alu, double, ismf[n]);
+    MALLOC(ilu, int,    ismf[n]);
+
+    status = factorILU(asmf, ismf, alu, ilu);
+    CHECK_STATUS;
+
     MALLOC(r,  double, n);
-    MALLOC(rr, double, n);
-    MALLOC(z,  double, n);
-    MALLOC(zz, double, n);
+    MALLOC(rh, double, n);
+    MALLOC(p,  double, n);
+    MALLOC(ph, double, n);
+    MALLOC(v,  double, n);
+    MALLOC(s,  double, n);
+    MALLOC(sh, double, n);
+    MALLOC(t,  double, n);
 
     /*
-     * solve the matrix using biconjugate gradient technique.
-     *    code below is adapted from "Numerical Recipes"
+     * right-preconditioned BiCGSTAB (no transpose products needed)
      *
      * multiple passes might be needed if we ever get a zero denominator
      */
     ipass = 0;
+    iter  = 0;
  new_pass:
     ipass++;
 
@@ -3785,173 +5096,305 @@ sparseBCG(double   asmf[],                   /* (in)   sparse-matrix data */
     /*
      * calculate the initial residual
      */
-    for (i = 0; i < n; i++) {                /* A * x -> r */
-        r[i] = asmf[i] * x[i];
-
-        for (k = ismf[i]; k < ismf[i+1]; k++) {
-            j     = ismf[k];
-            r[i] += asmf[k] * x[j];
-        }
-    }
+    multSMF(&team, asmf, ismf, x, r);
 
+    err = 0;
     for (j = 0; j < n; j++) {
         r[ j] = rhs[j] - r[j];
-        rr[j] = r[j];
-    }
-
-    for (j = 0; j < n; j++) {
-        z[j] = r[j] / asmf[j];
+        rh[j] = r[j];
+        p[ j] = 0;
+        v[ j] = 0;
+        err  += SQR(r[j]);
     }
+    err = sqrt(err);
 
     /*
      * jump out if we already have a solution
      */
-    err = 0;
-    for (j = 0; j < n; j++) {
-        err += SQR(r[j]);
-    }
-    err = sqrt(err);
     if (err < tol) {
         goto cleanup;
     }
 
+    rhold = 1;
+    alpha = 1;
+    omega = 1;
+
     /*
      * main iteration loop
      */
-    bkden = 0;
-
-    for (iter = 0; iter < maxiter; iter++) {
+    for (; iter < maxiter; iter++) {
         DPRINT2("iter=%5d  err=%15.8e", iter, err);
 
+        rho = 0;
         for (j = 0; j < n; j++) {
-            zz[j] = rr[j] / asmf[j];
-        }
-
-        /*
-         * calculate coefficient bk and direction vectors p and pp
-         */
-        bknum = 0;
-        for (j = 0; j < n; j++) {
-            bknum += z[j] * rr[j];
-        }
-
-        if (iter == 0) {
-            for (j = 0; j < n; j++) {
-                p[ j] = z[ j];
-                pp[j] = zz[j];
-            }
-        } else {
-            bk = bknum / bkden;
-            for (j = 0; j < n; j++) {
-                p[ j] = bk * p[ j] +z[ j];
-                pp[j] = bk * pp[j] +zz[j];
-            }
+            rho += rh[j] * r[j];
         }
 
-        /*
-         * calculate coefficient ak, new iterate x, and new residuals r and rr
-         */
-        bkden = bknum;
-
-        if (fabs(bkden) < EPS20) {
-            DPRINT2("restarting because bknum = %f (ipass=%d)", bknum, ipass);
+        if (fabs(rho) < EPS20) {
+            DPRINT2("restarting because rho = %f (ipass=%d)", rho, ipass);
             goto new_pass;
         }
 
-        for (i = 0; i < n; i++) {       /* A * p -> z */
-            z[i] = asmf[i] * p[i];
-
-            for (k = ismf[i]; k < ismf[i+1]; k++) {
-                j     = ismf[k];
-                z[i] += asmf[k] * p[j];
-            }
+        beta = (rho / rhold) * (alpha / omega);
+        for (j = 0; j < n; j++) {
+            p[j] = r[j] + beta * (p[j] - omega * v[j]);
         }
 
-        akden = 0;
+        solveILU(n, alu, ilu, p, ph);
+        multSMF(&team, asmf, ismf, ph, v);
+
+        den = 0;
         for (j = 0; j < n; j++) {
-            akden += z[j] * pp[j];
+            den += rh[j] * v[j];
         }
 
-        if (fabs(akden) < EPS20) {
-            DPRINT2("restarting because akden = %f (ipass=%d)", akden, ipass);
+        if (fabs(den) < EPS20) {
+            DPRINT2("restarting because den = %f (ipass=%d)", den, ipass);
             goto new_pass;
         }
 
-        for (i = 0; i < n; i++) {        /* AT * pp -> zz */
-            zz[i] = asmf[i] * pp[i];
+        alpha = rho / den;
+        err   = 0;
+        for (j = 0; j < n; j++) {
+            s[j] = r[j] - alpha * v[j];
+            err += SQR(s[j]);
         }
+        err = sqrt(err);
 
-        for (i = 0; i < n; i++) {
-            for (k = ismf[i]; k < ismf[i+1]; k++) {
-                j      = ismf[k];
-                zz[j] += asmf[k] * pp[i];
+        if (err < tol) {
+            for (j = 0; j < n; j++) {
+                x[j] += alpha * ph[j];
             }
+            goto cleanup;
         }
 
-        ak = bknum / akden;
+        solveILU(n, alu, ilu, s, sh);
+        multSMF(&team, asmf, ismf, sh, t);
+
+        omega = 0;
+        den   = 0;
         for (j = 0; j < n; j++) {
-            x[ j] += ak * p[ j];
-            r[ j] -= ak * z[ j];
-            rr[j] -= ak * zz[j];
+            omega += t[j] * s[j];
+            den   += t[j] * t[j];
         }
 
-        for (j = 0; j < n; j++) {
-            z[j] = r[j] / asmf[j];
+        if (fabs(den) < EPS20) {
+            DPRINT2("restarting because den = %f (ipass=%d)", den, ipass);
+            for (j = 0; j < n; j++) {
+                x[j] += alpha * ph[j];
+            }
+            goto new_pass;
         }
+        omega /= den;
 
-        /*
-         * solve a! * z = r and check stopping criterion
-         */
         err = 0;
         for (j = 0; j < n; j++) {
-            err += SQR(r[j]);
+            x[j] += alpha * ph[j] + omega * sh[j];
+            r[j]  = s[j] - omega * t[j];
+            err  += SQR(r[j]);
         }
-        err = sqrt(err);
+        err   = sqrt(err);
+        rhold = rho;
 
         if (err < tol) {
             goto cleanup;
         }
+
+        if (fabs(omega) < EPS20) {
+            DPRINT2("restarting because omega = %f (ipass=%d)", omega, ipass);
+            goto new_pass;
+        }
     }
 
     DPRINT1("exceeded maxiter=%d", maxiter);
     status = PRM_NOTCONVERGED;
 
  cleanup:
-#ifdef DEBUG
-    if (status == PRM_ZEROPIVOT || status == PRM_NOTCONVERGED) {
-        double check;
-      
-        DPRINT1("Sparse matrix that caused status=%d", status);
+    if (status == EGADS_SUCCESS) {
+        PPRINT2("sparseILU: %d iterations, %d passes", iter, ipass);
+    }
 
-        for (i = 0; i < ismf[0]-1; i++) {
-            check = -rhs[i] + asmf[i] * x[i];
-            for (j = ismf[i]; j < ismf[i+1]; j++) {
-                check += asmf[j] * x[ismf[j]];
-            }
+    FREE(t  );
+    FREE(sh );
+    FREE(s  );
+    FREE(v  );
+    FREE(ph );
+    FREE(p  );
+    FREE(rh );
+    FREE(r  );
+    FREE(ilu);
+    FREE(alu);
 
-            DPRINT5("%5d      %12.6f %12.6f %12.6f %12.4e",
-                    i, asmf[i], x[i], rhs[i], check);
+    teamDestroy(&team);
 
-            for (j = ismf[i]; j < ismf[i+1]; j++) {
-                DPRINT2("     %5d %12.6f", ismf[j], asmf[j]);
-            }
+    DPRINT2("%s --> status=%d}", routine, status);
+    return status;
+}
+
+
+
+/*
+ ********************************************************************************
+ *                                                                              *
+ * wallSeconds -- elapsed (wall-clock) time in seconds                          *
+ *                                                                              *
+ ********************************************************************************
+ */
+static double
+wallSeconds()
+{
+    struct timespec ts;
+
+    timespec_get(&ts, TIME_UTC);
+
+    return (double) ts.tv_sec + 1.0e-9 * (double) ts.tv_nsec;
+}
+
+
+
+/*
+ ********************************************************************************
+ *                                                                              *
+ * sparseSolve -- solve sparse matrix with the method set by prm_SetSolver      *
+ *                                                                              *
+ *     a failed ILU solve falls back to sparseBCG from the initial guess        *
+ *                                                                              *
+ ********************************************************************************
+ */
+extern int
+sparseSolve(double   asmf[],                 /* (in)   sparse-matrix data */
+            int      ismf[],                 /* (in)   sparse-matrix indices */
+            double   x[],                    /* (in)   initial  guess */
+                                             /* (out)  solution to A * x = rhs */
+            double   rhs[])                  /* (in)   right-hand side */
+{
+    int         status = EGADS_SUCCESS;      /* (out)  return status */
+                                             /*        PRM_NOTCONVERGED */
+                                             /*        PRM_ZEROPIVOT */
+
+    int         j, n, sbcg;
+    double      *x0 = NULL, tbcg, tilu;
+
+    ROUTINE(sparseSolve);
+    DPRINT2("%s(ismf[0]=%d) {",
+            routine, ismf[0]);
+
+    /* ----------------------------------------------------------------------- */
+
+    if (globalSolver == PRM_SOLVE_BCG) {
+        status = sparseBCG(asmf, ismf, x, rhs);
+        goto cleanup;
+    }
+
+    /*
+     * keep the initial guess for the fallback (and the benchmark)
+     */
+    n = ismf[0] - 1;
+    MALLOC(x0, double, n);
+    for (j = 0; j < n; j++) {
+        x0[j] = x[j];
+    }
+
+    if (globalSolver == PRM_SOLVE_BENCH) {
+        tbcg = wallSeconds();
+        sbcg = sparseBCG(asmf, ismf, x, rhs);
+        tbcg = wallSeconds() - tbcg;
+        for (j = 0; j < n; j++) {
+            x[j] = x0[j];
         }
+        tilu   = wallSeconds();
+        status = sparseILU(asmf, ismf, x, rhs);
+        tilu   = wallSeconds() - tilu;
+        printf(" sparseSolve: n = %d  BCG = %d (%.3f s)  ILU = %d (%.3f s)\n",
+               n, sbcg, tbcg, status, tilu);
+    } else {
+        status = sparseILU(asmf, ismf, x, rhs);
     }
-#endif
 
-    FREE(zz);
-    FREE(z );
-    FREE(rr);
-    FREE(r );
-    FREE(pp);
-    FREE(p );
+    if (status == PRM_ZEROPIVOT || status == PRM_NOTCONVERGED) {
+        DPRINT1("sparseILU failed (%d), using sparseBCG", status);
+        for (j = 0; j < n; j++) {
+            x[j] = x0[j];
+        }
+        status = sparseBCG(asmf, ismf, x, rhs);
+    }
+
+ cleanup:
+    FREE(x0);
 
     DPRINT2("%s --> status=%d}", routine, status);
     return status;
 }
 
 
-
+
+/*
+ ********************************************************************************
+ *                                                                              *
+ * prm_SetSolver -- select the sparse solver used by the Cfit and Grid fits     *
+ *                                                                              *
+ ********************************************************************************
+ */
+extern int
+prm_SetSolver(int      method)               /* (in)   PRM_SOLVE_BCG, _ILU or _BENCH */
+{
+    int         status = EGADS_SUCCESS;      /* (out)  return status */
+                                             /*        PRM_BADPARAM */
+
+    ROUTINE(prm_SetSolver);
+    DPRINT2("%s(method=%d) {",
+            routine, method);
+
+    /* ----------------------------------------------------------------------- */
+
+    if (method != PRM_SOLVE_BCG && method != PRM_SOLVE_ILU &&
+        method != PRM_SOLVE_BENCH) {
+        status = PRM_BADPARAM;
+    } else {
+        globalSolver = method;
+    }
+
+// cleanup:
+    DPRINT2("%s --> status=%d}",
+            routine, status);
+    return status;
+}
+
+
+
+/*
+ ********************************************************************************
+ *                                                                              *
+ * prm_SetRelax -- select the relaxation used by the Floater parameterization   *
+ *                                                                              *
+ ********************************************************************************
+ */
+extern int
+prm_SetRelax(int      method)                /* (in)   PRM_RELAX_SOR or _COLOR */
+{
+    int         status = EGADS_SUCCESS;      /* (out)  return status */
+                                             /*        PRM_BADPARAM */
+
+    ROUTINE(prm_SetRelax);
+    DPRINT2("%s(method=%d) {",
+            routine, method);
+
+    /* ----------------------------------------------------------------------- */
+
+    if (method != PRM_RELAX_SOR && method != PRM_RELAX_COLOR) {
+        status = PRM_BADPARAM;
+    } else {
+        globalRelax = method;
+    }
+
+// cleanup:
+    DPRINT2("%s --> status=%d}",
+            routine, status);
+    return status;
+}
+
+
+
 /*
  ********************************************************************************
  *                                                                              *
@@ -4045,6 +5488,8 @@ prm_CreateUV(int      UVtype,                /* (in)   type of transformation (s
     int         faces[5], nfaces, nneg, nper, n, swap;
 
     int         *points = NULL;
+    prmAdj      adj;
+    EMPteam     team;
 
     int         maxpass = 10000;
 
@@ -4086,7 +5531,15 @@ prm_CreateUV(int      UVtype,                /* (in)   type of transformation (s
 
     /* ----------------------------------------------------------------------- */
 
-    *ppnts = NULL;
+    *ppnts   = NULL;
+    adj.nvrt = 0;
+    adj.itri = NULL;
+    adj.jtri = NULL;
+
+    team.mutex   = NULL;
+    team.gate[0] = NULL;
+    team.gate[1] = NULL;
+    team.threads = NULL;
 
     /*
      * count the number of Faces (up to 5) associated with the Triangles
@@ -4174,11 +5627,20 @@ prm_CreateUV(int      UVtype,                /* (in)   type of transformation (s
             /*
              * smooth if we have non-positive areas (indicating a bad tessellation)
              */
+            if (amin <= EPS12) {
+                status = buildVrtTri(ntri, tri, nvrt, &adj);
+                CHECK_STATUS;
+                status = PRM_OK_ONEFACE;
+
+                teamCreate(EMP_Init(NULL), &team);
+            }
             for (ipass = 0; ipass <= maxpass; ipass++) {
                 if (amin > EPS12) break;
 
-                smoothUVcoords(ntri, tri, nvrt, uv, &amin);
+                smoothUVcoords(ntri, tri, nvrt, &adj, &team, uv, &amin);
             }
+            teamDestroy(&team);
+            freeVrtTri(&adj);
 
             /*
              * if we still have small or negative areas, reset UVtype so
@@ -4450,6 +5912,9 @@ retry:
 //$$$
 
  cleanup:
+    teamDestroy(&team);
+    freeVrtTri(&adj);
+
     if        (status == PRM_OK_ONEFACE) {
         PPRINT0("   UV via single Face");
     } else if (status == PRM_OK_SIMPLE) {
@@ -5063,14 +6528,14 @@ prm_SmoothUV(int      type,                  /* (in)   smoothing type =1 for bou
         }
 
         /*
-         * solve the matrix equations using biconjugate-gradient technique
+         * solve the matrix equations (preconditioned biconjugate-gradient)
          */
         DPRINT0("U smoothing");
-        status = sparseBCG(asmf, ismf, unew, urhs);
+        status = sparseSolve(asmf, ismf, unew, urhs);
         CHECK_STATUS;
 
         DPRINT0("V smoothing");
-        status = sparseBCG(asmf, ismf, vnew, vrhs);
+        status = sparseSolve(asmf, ismf, vnew, vrhs);
         CHECK_STATUS;
 
         DPRINT0("Old, new, and change in  Vertex locations");
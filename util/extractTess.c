@@ -15,6 +15,7 @@
 #include <string.h>
 
 #include "egads.h"
+#include "emp.h"
 
 
 #define CROSS(a,b,c)       a[0] = (b[1]*c[2]) - (b[2]*c[1]);\
@@ -26,6 +27,8 @@
     ego body;
     int num;
     int *objs;
+    int nidx;                   /* number of Edges in the matched Body */
+    int *index;                 /* matched Body Edge -> our Edge (or 0) */
   } objMatch;
 
   typedef struct {
@@ -33,28 +36,61 @@
     double xyz[3];
   } nodeMatch;
 
+  typedef struct {
+    int    nnode;               /* number of Nodes bounding the Edge */
+    double trange[2];           /* the Edge's parameter range */
+    double xyz[6];              /* the bounding Node positions */
+  } edgeInfo;
+
+  typedef struct {
+    int          itess;         /* the input tessellation index */
+    int          iface;         /* the Face index in the input tessellation */
+    int          face;          /* our Face index */
+    int          same;          /* 1 - the Faces are equivalent */
+    int          tfi;           /* the input Face is TFI */
+    int          len;           /* the Face tessellation from the input */
+    int          ntri;
+    const double *xyzs;
+    const double *prms;
+    const int    *ptype;
+    const int    *pindex;
+    const int    *tris;
+    const int    *tric;
+    int          *trix;         /* the triangles in our orientation */
+    double       *nprms;        /* recomputed parameters -- NULL if same */
+    int          stat;          /* the status of the extraction */
+  } faceMatch;
+
+  typedef struct {
+    void         *mutex;        /* the mutex or NULL for single thread */
+    long         master;        /* master thread ID */
+    int          index;         /* next Face to extract */
+    int          end;           /* number of Faces to extract */
+    ego          *faces;        /* our Faces */
+    objMatch     *ematch;       /* the Edge matches for each input tess */
+    edgeInfo     *edges;        /* the Edge parameters and Node positions */
+    egTessel     *btess;        /* our tessellation */
+    faceMatch    *fmatch;       /* the Faces to extract */
+  } EMPextract;
+
 
 
 static int
-EG_lookupEdge(int index, objMatch ematch)
+EG_lookupEdge(int index, const objMatch *ematch)
 {
-  int i;
+  if ((index < 1) || (index > ematch->nidx)) return 0;
   
-  for (i = 0; i < ematch.num; i++)
-    if (ematch.objs[2*i+1] == index) return ematch.objs[2*i];
-  
-  return 0;
+  return ematch->index[index-1];
 }
 
 
 static int
-EG_findEdge(ego body, const double *xyz, int is, const int *tris,
-            const int *tric, const int *ptype, const int *pindex,
-            objMatch ematch, egTessel *btess, double *t)
+EG_findEdge(const double *xyz, int is, const int *tris, const int *tric,
+            const int *ptype, const int *pindex, const objMatch *ematch,
+            const edgeInfo *edges, egTessel *btess, double *t)
 {
-  int    i, m, n, ie, stat, oclass, mtype, nnds, *senses;
-  double trange[2], coord[3], dmin, dmax;
-  ego    edge, ref, *nds, *objs;
+  int    i, m, ie;
+  double dmin, dmax;
   
   for (i = 0; i < 3; i++) {
     if (i == is) continue;
@@ -62,45 +98,20 @@ EG_findEdge(ego body, const double *xyz, int is, const int *tris,
   }
   if (i == 3) return EGADS_NOTFOUND;
   
-  ie   = EG_lookupEdge(-tric[i], ematch);
+  ie = EG_lookupEdge(-tric[i], ematch);
   if (ie == 0) return ie;
-  stat = EG_objectBodyTopo(body, EDGE, ie, &edge);
-  if (stat != EGADS_SUCCESS) {
-        printf(" Error: EG_objectBodyTopo = %d for Edge %d\n", stat, ie);
-    return stat;
-  }
-  
-  stat = EG_getTopology(edge, &ref, &oclass, &mtype, trange, &nnds, &nds,
-                        &senses);
-  if (stat != EGADS_SUCCESS) {
-    printf(" Error: EG_getTopology = %d for Edge %d\n", stat, ie);
-    return stat;
-  }
   
-  if (nnds == 2) {
+  if (edges[ie-1].nnode == 2) {
     
     /* find the closest Node */
-    stat = EG_getTopology(nds[0], &ref, &oclass, &mtype, coord, &n, &objs,
-                          &senses);
-    if (stat != EGADS_SUCCESS) {
-      printf(" Error: EG_getTopology = %d for start Node\n", stat);
-      return stat;
-    }
-    dmin = sqrt((coord[0]-xyz[0])*(coord[0]-xyz[0]) +
-                (coord[1]-xyz[1])*(coord[1]-xyz[1]) +
-                (coord[2]-xyz[2])*(coord[2]-xyz[2]));
-    
-    stat = EG_getTopology(nds[1], &ref, &oclass, &mtype, coord, &n, &objs,
-                          &senses);
-    if (stat != EGADS_SUCCESS) {
-      printf(" Error: EG_getTopology = %d for finis Node\n", stat);
-      return stat;
-    }
-    dmax = sqrt((coord[0]-xyz[0])*(coord[0]-xyz[0]) +
-                (coord[1]-xyz[1])*(coord[1]-xyz[1]) +
-                (coord[2]-xyz[2])*(coord[2]-xyz[2]));
-    *t = trange[0];
-    if (dmax < dmin) *t = trange[1];
+    dmin = sqrt((edges[ie-1].xyz[0]-xyz[0])*(edges[ie-1].xyz[0]-xyz[0]) +
+                (edges[ie-1].xyz[1]-xyz[1])*(edges[ie-1].xyz[1]-xyz[1]) +
+                (edges[ie-1].xyz[2]-xyz[2])*(edges[ie-1].xyz[2]-xyz[2]));
+    dmax = sqrt((edges[ie-1].xyz[3]-xyz[0])*(edges[ie-1].xyz[3]-xyz[0]) +
+                (edges[ie-1].xyz[4]-xyz[1])*(edges[ie-1].xyz[4]-xyz[1]) +
+                (edges[ie-1].xyz[5]-xyz[2])*(edges[ie-1].xyz[5]-xyz[2]));
+    *t = edges[ie-1].trange[0];
+    if (dmax < dmin) *t = edges[ie-1].trange[1];
     
   } else {
     
@@ -113,9 +124,9 @@ EG_findEdge(ego body, const double *xyz, int is, const int *tris,
     if (btess->tess1d[ie-1].npts <= 3)
       printf(" Info: Ambiguous Edge tessellation - %d\n", ie);
     if (ptype[m-1] == 2) {
-      *t = trange[0];
+      *t = edges[ie-1].trange[0];
     } else {
-      *t = trange[1];
+      *t = edges[ie-1].trange[1];
     }
     
   }
@@ -124,6 +135,267 @@ EG_findEdge(ego body, const double *xyz, int is, const int *tris,
 }
 
 
+/* orients the input Face tessellation to our Face and recomputes the
+ * parameters if the Faces are not the same -- only touches the geometry */
+static int
+EG_extractFace(EMPextract *ethread, faceMatch *fm)
+{
+  int          i, k, l, is, ie, npts, stat, ntri, *cnt;
+  double       t, xyz[3], coord[3], uv[2], result[18], an[3], ds[3];
+  double       x0[3], x1[3], *u, *v, *uvs, *nprms;
+  const int    *tris, *ptype, *pindex;
+  const double *xyzs;
+  ego          face, top;
+  egTessel     *btess;
+
+  i      = fm->itess;
+  face   = ethread->faces[fm->face-1];
+  btess  = ethread->btess;
+  ntri   = fm->ntri;
+  tris   = fm->tris;
+  ptype  = fm->ptype;
+  pindex = fm->pindex;
+  xyzs   = fm->xyzs;
+
+  uvs = (double *) EG_alloc(2*ntri*sizeof(double));
+  if (uvs == NULL) return EGADS_MALLOC;
+
+  /* is the orientation correct? */
+  for (npts = k = 0; k < ntri; k++) {
+    coord[0] = (xyzs[3*(tris[3*k  ]-1)  ] + xyzs[3*(tris[3*k+1]-1)  ] +
+                xyzs[3*(tris[3*k+2]-1)  ])/3.0;
+    coord[1] = (xyzs[3*(tris[3*k  ]-1)+1] + xyzs[3*(tris[3*k+1]-1)+1] +
+                xyzs[3*(tris[3*k+2]-1)+1])/3.0;
+    coord[2] = (xyzs[3*(tris[3*k  ]-1)+2] + xyzs[3*(tris[3*k+1]-1)+2] +
+                xyzs[3*(tris[3*k+2]-1)+2])/3.0;
+    stat = EG_invEvaluate(face, coord, uv, xyz);
+    if (stat != EGADS_SUCCESS) goto fail;
+    uvs[2*k  ] = uv[0];
+    uvs[2*k+1] = uv[1];
+    stat = EG_evaluate(face, uv, result);
+    if (stat != EGADS_SUCCESS) goto fail;
+    u = &result[3];
+    v = &result[6];
+    CROSS(an, u, v);
+    t = sqrt(DOT(an, an))*face->mtype;
+    if (t != 0.0) {
+      an[0] /= t;
+      an[1] /= t;
+      an[2] /= t;
+    }
+    x0[0] = xyzs[3*(tris[3*k  ]-1)  ] - xyzs[3*(tris[3*k+2]-1)  ];
+    x1[0] = xyzs[3*(tris[3*k+1]-1)  ] - xyzs[3*(tris[3*k+2]-1)  ];
+    x0[1] = xyzs[3*(tris[3*k  ]-1)+1] - xyzs[3*(tris[3*k+2]-1)+1];
+    x1[1] = xyzs[3*(tris[3*k+1]-1)+1] - xyzs[3*(tris[3*k+2]-1)+1];
+    x0[2] = xyzs[3*(tris[3*k  ]-1)+2] - xyzs[3*(tris[3*k+2]-1)+2];
+    x1[2] = xyzs[3*(tris[3*k+1]-1)+2] - xyzs[3*(tris[3*k+2]-1)+2];
+    CROSS(ds, x0, x1);
+    t = sqrt(DOT(ds, ds));
+    if (t != 0.0) {
+      ds[0] /= t;
+      ds[1] /= t;
+      ds[2] /= t;
+    }
+    if (DOT(ds, an) > 0.0) npts++;
+  }
+  fm->trix = (int *) tris;
+  if (npts < ntri/2) {
+#ifdef REPORT
+    printf("   reorienting tessellation\n");
+#endif
+    fm->trix = (int *) EG_alloc(3*ntri*sizeof(int));
+    stat     = EGADS_MALLOC;
+    if (fm->trix == NULL) goto fail;
+    if (fm->tfi == 1) {
+      for (k = 0; k < ntri/2; k++) {
+        fm->trix[6*k  ] = tris[6*k  ];
+        fm->trix[6*k+1] = tris[6*k+5];
+        fm->trix[6*k+2] = tris[6*k+2];
+        fm->trix[6*k+3] = tris[6*k+3];
+        fm->trix[6*k+4] = tris[6*k+4];
+        fm->trix[6*k+5] = tris[6*k+1];
+      }
+    } else {
+      for (k = 0; k < ntri; k++) {
+        fm->trix[3*k  ] = tris[3*k  ];
+        fm->trix[3*k+1] = tris[3*k+2];
+        fm->trix[3*k+2] = tris[3*k+1];
+      }
+    }
+  }
+  if (fm->same == 1) {
+    EG_free(uvs);
+    return EGADS_SUCCESS;
+  }
+
+  /* not the same -- recompute the parameters */
+  nprms = (double *) EG_alloc(2*fm->len*sizeof(double)+fm->len*sizeof(int));
+  stat  = EGADS_MALLOC;
+  if (nprms == NULL) goto fail;
+  fm->nprms = nprms;
+  cnt = (int *) &nprms[2*fm->len];
+  for (k = 0; k < fm->len; k++) cnt[k] = 0;
+  for (l = 0; l < ntri; l++)
+    for (is = 0; is < 3; is++) {
+      k = tris[3*l+is]-1;
+      if (cnt[k] != 0) continue;
+      if (ptype[k] >= 0) {
+        t = 0.0;
+        if (ptype[k] == 0) {
+          /* Node -- find Edge */
+          ie = EG_findEdge(&xyzs[3*k], is, &tris[3*l], &fm->tric[3*l], ptype,
+                           pindex, &ethread->ematch[i], ethread->edges, btess,
+                           &t);
+          if (ie == EGADS_NOTFOUND) continue;
+          if (ie <= EGADS_SUCCESS) {
+            printf(" Error: %d Cannot find match for tess %d / Node %d\n",
+                   ie, i+1, pindex[k]);
+            stat = ie;
+            if (stat == EGADS_SUCCESS) stat = EGADS_NOTFOUND;
+            goto fail;
+          }
+        } else {
+          /* Edge */
+          ie = EG_lookupEdge(pindex[k], &ethread->ematch[i]);
+          if (ie == 0) {
+            printf(" Error: Cannot find match for tess %d / Edge %d\n",
+                   i+1, pindex[k]);
+            stat = EGADS_NOTFOUND;
+            goto fail;
+          }
+          t = btess->tess1d[ie-1].t[ptype[k]-1];
+        }
+        top  = btess->tess1d[ie-1].obj;
+        stat = EG_getEdgeUV(face, top, 0, t, &nprms[2*k]);
+        if (stat == EGADS_TOPOERR) {
+          stat = EG_getEdgeUV(face, top,  1, t, &nprms[2*k]);
+          if (stat != EGADS_SUCCESS) goto fail;
+          stat = EG_getEdgeUV(face, top, -1, t, uv);
+          if (stat != EGADS_SUCCESS) goto fail;
+          x0[0] = sqrt((nprms[2*k  ]-uvs[2*l  ])*(nprms[2*k  ]-uvs[2*l  ]) +
+                       (nprms[2*k+1]-uvs[2*l+1])*(nprms[2*k+1]-uvs[2*l+1]));
+          x0[1] = sqrt((uv[0]-uvs[2*l  ])*(uv[0]-uvs[2*l  ]) +
+                       (uv[1]-uvs[2*l+1])*(uv[1]-uvs[2*l+1]));
+          if (x0[1] < x0[0]) {
+            nprms[2*k  ] = uv[0];
+            nprms[2*k+1] = uv[1];
+          }
+        } else if (stat != EGADS_SUCCESS) {
+          goto fail;
+        }
+        cnt[k] = 1;
+      } else {
+        /* interior -- do inverse evaluation */
+        coord[0] = xyzs[3*k  ];
+        coord[1] = xyzs[3*k+1];
+        coord[2] = xyzs[3*k+2];
+        stat     = EG_invEvaluate(face, coord, &nprms[2*k], xyz);
+        if (stat != EGADS_SUCCESS) goto fail;
+        cnt[k] = 1;
+      }
+    }
+  for (k = 0; k < fm->len; k++)
+    if (cnt[k] == 0) {
+      printf(" Error: Face %d - Vertex %d/%d not hit!\n", fm->face, k+1,
+             fm->len);
+      stat = EGADS_NOTFOUND;
+      goto fail;
+    }
+
+  EG_free(uvs);
+  return EGADS_SUCCESS;
+
+fail:
+  EG_free(uvs);
+  return stat;
+}
+
+
+static void
+EG_extractThread(void *struc)
+{
+  int        index;
+  long       ID;
+  EMPextract *ethread;
+
+  ethread = (EMPextract *) struc;
+
+  /* get our identifier */
+  ID = EMP_ThreadID();
+
+  /* look for work */
+  for (;;) {
+
+    /* only one thread at a time here -- controlled by a mutex! */
+    if (ethread->mutex != NULL) EMP_LockSet(ethread->mutex);
+    index = ethread->index;
+    ethread->index++;
+    if (ethread->mutex != NULL) EMP_LockRelease(ethread->mutex);
+    if (index >= ethread->end) break;
+
+    /* do the work */
+    ethread->fmatch[index].stat = EG_extractFace(ethread,
+                                                 &ethread->fmatch[index]);
+  }
+
+  /* exhausted all work -- exit */
+  if (ID != ethread->master) EMP_ThreadExit();
+}
+
+
+/* the matched Faces only touch their own geometry once the Edges are in
+   place -- extract them concurrently, the status of each is left in the
+   faceMatch */
+static void
+EG_extractFaces(EMPextract *ethread)
+{
+  int  i, np;
+  void **threads = NULL;
+
+  np = EMP_Init(NULL);
+  if (ethread->end < np) np = ethread->end;
+  if (np > 1) {
+    /* create the mutex to handle list synchronization */
+    ethread->mutex = EMP_LockCreate();
+    if (ethread->mutex == NULL) {
+      printf(" EMP Error: mutex creation = NULL!\n");
+      np = 1;
+    } else {
+      /* get storage for our extra threads */
+      threads = (void **) malloc((np-1)*sizeof(void *));
+      if (threads == NULL) {
+        EMP_LockDestroy(ethread->mutex);
+        ethread->mutex = NULL;
+        np = 1;
+      }
+    }
+  }
+
+  /* create the threads and get going! */
+  if (threads != NULL)
+    for (i = 0; i < np-1; i++) {
+      threads[i] = EMP_ThreadCreate(EG_extractThread, ethread);
+      if (threads[i] == NULL)
+        printf(" EMP Error Creating Thread #%d!\n", i+1);
+    }
+  /* now run the thread block from the original thread */
+  EG_extractThread(ethread);
+
+  /* wait for all others to return */
+  if (threads != NULL)
+    for (i = 0; i < np-1; i++)
+      if (threads[i] != NULL) EMP_ThreadWait(threads[i]);
+
+  /* cleanup */
+  if (threads != NULL)
+    for (i = 0; i < np-1; i++)
+      if (threads[i] != NULL) EMP_ThreadDestroy(threads[i]);
+  if (ethread->mutex != NULL) EMP_LockDestroy(ethread->mutex);
+  ethread->mutex = NULL;
+  if (threads != NULL) free(threads);
+}
+
+
 /* generates a Body tessellation copying matching Edge/Face tessellation from
  *           input tessellations
  *
@@ -137,17 +409,19 @@ EG_findEdge(ego body, const double *xyz, int is, const int *tris,
 int
 EG_extractTess(int niTess, ego *iTess, ego body, double *params, ego *tess)
 {
-  int          i, j, k, l, m, n, nobj, stat, npts, oclass, mtype, tesstate, len;
-  int          *mark, *senses, *trix, *cnt, ntri, ie, is, aType, aLen, *qints;
-  double       t, trange[2], xyz[3], coord[3], uv[2], result[18], an[3], ds[3];
-  double       x0[3], x1[3], *u, *v, *nprms, *uvs;
+  int          i, j, k, m, n, nobj, stat, npts, oclass, mtype, tesstate, len;
+  int          *mark, *senses, ntri, nface, aType, aLen, *qints;
+  double       trange[2], xyz[3], coord[3], *nprms;
   const int    *ptype, *pindex, *tris, *tric, *aInts;
   const double *xyzs, *prms, *aReals;
   const char   *aStr;
-  ego          top, prev, next, *objs, *nds;
+  ego          top, prev, next, *objs, *nds, *chld;
   egTessel     *btess, *otess;
   objMatch     *matches, *fmatch;
   nodeMatch    *nodes;
+  edgeInfo     *edges;
+  faceMatch    *faces;
+  EMPextract   ethread;
   
   /* check inputs */
   if (niTess <= 0) return EGADS_INDEXERR;
@@ -167,14 +441,18 @@ EG_extractTess(int niTess, ego *iTess, ego body, double *params, ego *tess)
     return EGADS_MALLOC;
   }
   for (i = 0; i < 2*niTess; i++) {
-    matches[i].num  = 0;
-    matches[i].objs = NULL;
+    matches[i].num   = 0;
+    matches[i].objs  = NULL;
+    matches[i].nidx  = 0;
+    matches[i].index = NULL;
   }
   fmatch = &matches[niTess];
   nprms  = NULL;
   mark   = NULL;
   nodes  = NULL;
-  uvs    = NULL;
+  edges  = NULL;
+  faces  = NULL;
+  nface  = 0;
   objs   = NULL;
   
   /* get the Nodes we may expect */
@@ -190,7 +468,7 @@ EG_extractTess(int niTess, ego *iTess, ego body, double *params, ego *tess)
     nodes[i].xyz[0] = nodes[i].xyz[1] = nodes[i].xyz[2] = 0.0;
   }
   
-  /* get the Edge matches */
+  /* get the Edge matches & index them by the input Edge */
   for (n = i = 0; i < niTess; i++) {
     stat = EG_statusTessBody(iTess[i], &matches[i].body, &tesstate, &npts);
     if (stat != EGADS_SUCCESS) goto cleanup;
@@ -198,6 +476,22 @@ EG_extractTess(int niTess, ego *iTess, ego body, double *params, ego *tess)
                              &matches[i].objs);
     if (stat != EGADS_SUCCESS) goto cleanup;
     n += matches[i].num;
+    stat = EG_getBodyTopos(matches[i].body, NULL, EDGE, &matches[i].nidx,
+                           NULL);
+    if (stat != EGADS_SUCCESS) goto cleanup;
+    if (matches[i].nidx == 0) continue;
+    matches[i].index = (int *) EG_alloc(matches[i].nidx*sizeof(int));
+    if (matches[i].index == NULL) {
+      stat = EGADS_MALLOC;
+      goto cleanup;
+    }
+    for (j = 0; j < matches[i].nidx; j++) matches[i].index[j] = 0;
+    /* keep the first match (as a linear search would) */
+    for (j = matches[i].num-1; j >= 0; j--) {
+      k = matches[i].objs[2*j+1];
+      if ((k < 1) || (k > matches[i].nidx)) continue;
+      matches[i].index[k-1] = matches[i].objs[2*j];
+    }
   }
 #ifdef REPORT
   printf(" *** Edge Matches = %d ***\n", n);
@@ -209,9 +503,10 @@ EG_extractTess(int niTess, ego *iTess, ego body, double *params, ego *tess)
   
   stat = EG_getBodyTopos(body, NULL, EDGE, &nobj, &objs);
   if ((stat != EGADS_SUCCESS) || (objs == NULL)) goto cleanup;
-  mark = (int *) EG_alloc(nobj*sizeof(int));
-  stat = EGADS_MALLOC;
-  if (mark == NULL) goto cleanup;
+  mark  = (int *) EG_alloc(nobj*sizeof(int));
+  edges = (edgeInfo *) EG_alloc(nobj*sizeof(edgeInfo));
+  stat  = EGADS_MALLOC;
+  if ((mark == NULL) || (edges == NULL)) goto cleanup;
   for (j = 0; j < nobj; j++) mark[j] = 0;
   for (i = 0; i < niTess; i++)
     for (j = 0; j < matches[i].num; j++) {
@@ -282,6 +577,29 @@ EG_extractTess(int niTess, ego *iTess, ego body, double *params, ego *tess)
       }
     }
 
+  /* cache the Edge ranges & Node positions for the Face Node lookups */
+  for (m = 0; m < nobj; m++) {
+    edges[m].nnode = 0;
+    if (mark[m] == 0) continue;
+    stat = EG_getTopology(objs[m], &top, &oclass, &mtype, edges[m].trange,
+                          &npts, &nds, &senses);
+    if (stat != EGADS_SUCCESS) {
+      printf(" Error: EG_getTopology = %d for Edge %d\n", stat, m+1);
+      goto cleanup;
+    }
+    edges[m].nnode = npts;
+    if (npts != 2) continue;
+    for (k = 0; k < 2; k++) {
+      stat = EG_getTopology(nds[k], &top, &oclass, &mtype, &edges[m].xyz[3*k],
+                            &n, &chld, &senses);
+      if (stat != EGADS_SUCCESS) {
+        printf(" Error: EG_getTopology = %d for Node %d of Edge %d\n",
+               stat, k+1, m+1);
+        goto cleanup;
+      }
+    }
+  }
+
   EG_free(mark);
   mark  = NULL;
   EG_free(objs);
@@ -304,12 +622,13 @@ EG_extractTess(int niTess, ego *iTess, ego body, double *params, ego *tess)
 
   if (n != 0) {
 
-    /* fill in the matched Faces */
+    /* collect the matched Faces */
     stat = EG_getBodyTopos(body, NULL, FACE, &nobj, &objs);
     if ((stat != EGADS_SUCCESS) || (objs == NULL)) goto cleanup;
-    mark = (int *) EG_alloc(2*nobj*sizeof(int));
-    stat = EGADS_MALLOC;
-    if (mark == NULL) goto cleanup;
+    mark  = (int *) EG_alloc(2*nobj*sizeof(int));
+    faces = (faceMatch *) EG_alloc(nobj*sizeof(faceMatch));
+    stat  = EGADS_MALLOC;
+    if ((mark == NULL) || (faces == NULL)) goto cleanup;
     qints = &mark[nobj];
     for (j = 0; j < nobj; j++) mark[j] = qints[j] = 0;
     for (i = 0; i < niTess; i++) {
@@ -323,212 +642,84 @@ EG_extractTess(int niTess, ego *iTess, ego body, double *params, ego *tess)
         if (stat != EGADS_SUCCESS) goto cleanup;
         if (ntri == 0) continue;
         mark[m-1] = 1;
-        uvs       = (double *) EG_alloc(2*ntri*sizeof(double));
-        stat      = EGADS_MALLOC;
-        if (uvs == NULL) goto cleanup;
-        /* is the orientation correct? */
-        for (npts = k = 0; k < ntri; k++) {
-          coord[0] = (xyzs[3*(tris[3*k  ]-1)  ] + xyzs[3*(tris[3*k+1]-1)  ] +
-                      xyzs[3*(tris[3*k+2]-1)  ])/3.0;
-          coord[1] = (xyzs[3*(tris[3*k  ]-1)+1] + xyzs[3*(tris[3*k+1]-1)+1] +
-                      xyzs[3*(tris[3*k+2]-1)+1])/3.0;
-          coord[2] = (xyzs[3*(tris[3*k  ]-1)+2] + xyzs[3*(tris[3*k+1]-1)+2] +
-                      xyzs[3*(tris[3*k+2]-1)+2])/3.0;
-          stat = EG_invEvaluate(objs[m-1], coord, uv, xyz);
-          if (stat != EGADS_SUCCESS) goto cleanup;
-          uvs[2*k  ] = uv[0];
-          uvs[2*k+1] = uv[1];
-          stat = EG_evaluate(objs[m-1], uv, result);
-          if (stat != EGADS_SUCCESS) goto cleanup;
-          u = &result[3];
-          v = &result[6];
-          CROSS(an, u, v);
-          t = sqrt(DOT(an, an))*objs[m-1]->mtype;
-          if (t != 0.0) {
-            an[0] /= t;
-            an[1] /= t;
-            an[2] /= t;
-          }
-          x0[0] = xyzs[3*(tris[3*k  ]-1)  ] - xyzs[3*(tris[3*k+2]-1)  ];
-          x1[0] = xyzs[3*(tris[3*k+1]-1)  ] - xyzs[3*(tris[3*k+2]-1)  ];
-          x0[1] = xyzs[3*(tris[3*k  ]-1)+1] - xyzs[3*(tris[3*k+2]-1)+1];
-          x1[1] = xyzs[3*(tris[3*k+1]-1)+1] - xyzs[3*(tris[3*k+2]-1)+1];
-          x0[2] = xyzs[3*(tris[3*k  ]-1)+2] - xyzs[3*(tris[3*k+2]-1)+2];
-          x1[2] = xyzs[3*(tris[3*k+1]-1)+2] - xyzs[3*(tris[3*k+2]-1)+2];
-          CROSS(ds, x0, x1);
-          t = sqrt(DOT(ds, ds));
-          if (t != 0.0) {
-            ds[0] /= t;
-            ds[1] /= t;
-            ds[2] /= t;
-          }
-          if (DOT(ds, an) > 0.0) npts++;
-        }
-        trix = (int *) tris;
-        if (npts < ntri/2) {
-#ifdef REPORT
-          printf("   reorienting tessellation\n");
-#endif
-          trix = (int *) EG_alloc(3*ntri*sizeof(int));
-          stat = EGADS_MALLOC;
-          if (trix == NULL) goto cleanup;
-          if (otess->tess2d[fmatch[i].objs[2*j+1]-1].tfi == 1) {
-            for (k = 0; k < ntri/2; k++) {
-              trix[6*k  ] = tris[6*k  ];
-              trix[6*k+1] = tris[6*k+5];
-              trix[6*k+2] = tris[6*k+2];
-              trix[6*k+3] = tris[6*k+3];
-              trix[6*k+4] = tris[6*k+4];
-              trix[6*k+5] = tris[6*k+1];
-            }
-          } else {
-            for (k = 0; k < ntri; k++) {
-              trix[3*k  ] = tris[3*k  ];
-              trix[3*k+1] = tris[3*k+2];
-              trix[3*k+2] = tris[3*k+1];
-            }
-          }
-        }
         
         /* are we the same? */
         stat = EG_objectBodyTopo(fmatch[i].body, FACE, fmatch[i].objs[2*j+1],
                                  &top);
-        if (stat != EGADS_SUCCESS) {
-          if (npts < ntri/2) EG_free(trix);
-          goto cleanup;
-        }
-        if (EG_isEquivalent(objs[m-1], top) == EGADS_SUCCESS) {
-          /* yes! */
-#ifdef REPORT
-          printf(" *** Tess Face %d = Body Face %d ***\n",
-                 fmatch[i].objs[2*j+1], m);
-#endif
-          stat = EG_setTessFace(*tess, m, len, xyzs, prms, ntri, trix);
-          if (stat != EGADS_SUCCESS) {
-            if (npts < ntri/2) EG_free(trix);
-            goto cleanup;
-          }
-        } else {
-          /* no -- recompute the parameters */
+        if (stat != EGADS_SUCCESS) goto cleanup;
+        faces[nface].itess  = i;
+        faces[nface].iface  = fmatch[i].objs[2*j+1];
+        faces[nface].face   = m;
+        faces[nface].same   = 0;
+        if (EG_isEquivalent(objs[m-1], top) == EGADS_SUCCESS)
+          faces[nface].same = 1;
+        faces[nface].tfi    = otess->tess2d[fmatch[i].objs[2*j+1]-1].tfi;
+        faces[nface].len    = len;
+        faces[nface].ntri   = ntri;
+        faces[nface].xyzs   = xyzs;
+        faces[nface].prms   = prms;
+        faces[nface].ptype  = ptype;
+        faces[nface].pindex = pindex;
+        faces[nface].tris   = tris;
+        faces[nface].tric   = tric;
+        faces[nface].trix   = NULL;
+        faces[nface].nprms  = NULL;
+        faces[nface].stat   = EGADS_SUCCESS;
+        nface++;
+      }
+    }
+
+    /* orient & reparameterize the Faces */
+    ethread.mutex  = NULL;
+    ethread.master = EMP_ThreadID();
+    ethread.index  = 0;
+    ethread.end    = nface;
+    ethread.faces  = objs;
+    ethread.ematch = matches;
+    ethread.edges  = edges;
+    ethread.btess  = btess;
+    ethread.fmatch = faces;
+    EG_extractFaces(&ethread);
+
+    /* fill in the matched Faces -- in match order */
+    for (j = 0; j < nface; j++) {
+      i    = faces[j].itess;
+      m    = faces[j].face;
+      stat = faces[j].stat;
+      if (stat != EGADS_SUCCESS) goto cleanup;
 #ifdef REPORT
-          printf(" *** Tess Face %d ~ Body Face %d ***\n",
-                 fmatch[i].objs[2*j+1], m);
+      if (faces[j].same == 1) {
+        printf(" *** Tess Face %d = Body Face %d ***\n", faces[j].iface, m);
+      } else {
+        printf(" *** Tess Face %d ~ Body Face %d ***\n", faces[j].iface, m);
+      }
 #endif
-          nprms = (double *) EG_alloc(2*len*sizeof(double)+len*sizeof(int));
-          if (nprms == NULL) {
-            stat = EGADS_MALLOC;
-            if (npts < ntri/2) EG_free(trix);
-            goto cleanup;
-          }
-          cnt = (int *) &nprms[2*len];
-          for (k = 0; k < len; k++) cnt[k] = 0;
-          for (l = 0; l < ntri; l++)
-            for (is = 0; is < 3; is++) {
-              k = tris[3*l+is]-1;
-              if (cnt[k] != 0) continue;
-              if (ptype[k] >= 0) {
-                t = 0.0;
-                if (ptype[k] == 0) {
-                  /* Node -- find Edge */
-                  ie = EG_findEdge(body, &xyzs[3*k], is, &tris[3*l], &tric[3*l],
-                                   ptype, pindex, matches[i], btess, &t);
-                  if (ie == EGADS_NOTFOUND) continue;
-                  if (ie <= EGADS_SUCCESS) {
-                    printf(" Error: %d Cannot find match for tess %d / Node %d\n",
-                           ie, i+1, pindex[k]);
-                    if (npts < ntri/2) EG_free(trix);
-                    goto cleanup;
-                  }
-                } else {
-                  /* Edge */
-                  ie = EG_lookupEdge(pindex[k], matches[i]);
-                  if (ie == 0) {
-                    printf(" Error: Cannot find match for tess %d / Edge %d\n",
-                           i+1, pindex[k]);
-                    if (npts < ntri/2) EG_free(trix);
-                    goto cleanup;
-                  }
-                  t = btess->tess1d[ie-1].t[ptype[k]-1];
-                }
-                top  = btess->tess1d[ie-1].obj;
-                stat = EG_getEdgeUV(objs[m-1], top, 0, t, &nprms[2*k]);
-                if (stat == EGADS_TOPOERR) {
-                  stat = EG_getEdgeUV(objs[m-1], top,  1, t, &nprms[2*k]);
-                  if (stat != EGADS_SUCCESS) {
-                    if (npts < ntri/2) EG_free(trix);
-                    goto cleanup;
-                  }
-                  stat = EG_getEdgeUV(objs[m-1], top, -1, t, uv);
-                  if (stat != EGADS_SUCCESS) {
-                    if (npts < ntri/2) EG_free(trix);
-                    goto cleanup;
-                  }
-                  x0[0] = sqrt((nprms[2*k  ]-uvs[2*l  ])*
-                               (nprms[2*k  ]-uvs[2*l  ]) +
-                               (nprms[2*k+1]-uvs[2*l+1])*
-                               (nprms[2*k+1]-uvs[2*l+1]));
-                  x0[1] = sqrt((uv[0]-uvs[2*l  ])*(uv[0]-uvs[2*l  ]) +
-                               (uv[1]-uvs[2*l+1])*(uv[1]-uvs[2*l+1]));
-                  if (x0[1] < x0[0]) {
-                    nprms[2*k  ] = uv[0];
-                    nprms[2*k+1] = uv[1];
-                  }
-                } else if (stat != EGADS_SUCCESS) {
-                  if (npts < ntri/2) EG_free(trix);
-                  goto cleanup;
-                }
-                cnt[k] = 1;
-              } else {
-                /* interior -- do inverse evaluation */
-                coord[0] = xyzs[3*k  ];
-                coord[1] = xyzs[3*k+1];
-                coord[2] = xyzs[3*k+2];
-                stat     = EG_invEvaluate(objs[m-1], coord, &nprms[2*k], xyz);
-                if (stat != EGADS_SUCCESS) {
-                  if (npts < ntri/2) EG_free(trix);
-                  goto cleanup;
-                }
-                cnt[k] = 1;
-              }
-            }
-          for (k = 0; k < len; k++)
-            if (cnt[k] == 0) {
-              printf(" Error: Face %d - Vertex %d/%d not hit!\n", m, k+1, len);
-              if (npts < ntri/2) EG_free(trix);
-              goto cleanup;
-            }
-
-          stat = EG_setTessFace(*tess, m, len, xyzs, nprms, ntri, trix);
-          if (stat != EGADS_SUCCESS) {
-            if (npts < ntri/2) EG_free(trix);
-            goto cleanup;
-          }
-        }
-        /* TFI flag */
-        if (otess->tess2d[fmatch[i].objs[2*j+1]-1].tfi == 1) {
-          btess->tess2d[m-1].tfi = 1;
-          qints[m-1] = btess->tess2d[m-1].ntris/2;
-        }
+      prms = faces[j].prms;
+      if (faces[j].nprms != NULL) prms = faces[j].nprms;
+      stat = EG_setTessFace(*tess, m, faces[j].len, faces[j].xyzs, prms,
+                            faces[j].ntri, faces[j].trix);
+      if (stat != EGADS_SUCCESS) goto cleanup;
+
+      /* TFI flag */
+      if (faces[j].tfi == 1) {
+        btess->tess2d[m-1].tfi = 1;
+        qints[m-1] = btess->tess2d[m-1].ntris/2;
+      }
         
-        /* do we transfer mixed info? */
-        stat = EG_attributeRet(iTess[i], ".tessType", &aType, &aLen, &aInts,
+      /* do we transfer mixed info? */
+      stat = EG_attributeRet(iTess[i], ".tessType", &aType, &aLen, &aInts,
+                             &aReals, &aStr);
+      if (stat == EGADS_SUCCESS) {
+        if (aType == ATTRSTRING)
+          if (strcmp(aStr, "Quad") == 0)
+            qints[m-1] = btess->tess2d[m-1].ntris/2;
+      } else {
+        stat = EG_attributeRet(iTess[i], ".mixed", &aType, &aLen, &aInts,
                                &aReals, &aStr);
         if (stat == EGADS_SUCCESS) {
-          if (aType == ATTRSTRING)
-            if (strcmp(aStr, "Quad") == 0)
-              qints[m-1] = btess->tess2d[m-1].ntris/2;
-        } else {
-          stat = EG_attributeRet(iTess[i], ".mixed", &aType, &aLen, &aInts,
-                                 &aReals, &aStr);
-          if (stat == EGADS_SUCCESS) {
-            if ((aType == ATTRINT) && (aLen == nobj))
-              qints[m-1] = aInts[fmatch[i].objs[2*j+1]-1];
-          }
+          if ((aType == ATTRINT) && (aLen == nobj))
+            qints[m-1] = aInts[faces[j].iface-1];
         }
-        
-        if (npts < ntri/2) EG_free(trix);
-        EG_free(uvs);
-        uvs = NULL;
       }
     }
     
@@ -585,13 +776,23 @@ EG_extractTess(int niTess, ego *iTess, ego body, double *params, ego *tess)
   }
   
 cleanup:
-  if (uvs   != NULL) EG_free(uvs);
+  if (faces != NULL) {
+    for (j = 0; j < nface; j++) {
+      if ((faces[j].trix != NULL) && (faces[j].trix != faces[j].tris))
+        EG_free(faces[j].trix);
+      if (faces[j].nprms != NULL) EG_free(faces[j].nprms);
+    }
+    EG_free(faces);
+  }
   if (nprms != NULL) EG_free(nprms);
+  if (edges != NULL) EG_free(edges);
   if (mark  != NULL) EG_free(mark);
   if (objs  != NULL) EG_free(objs);
   if (nodes != NULL) EG_free(nodes);
-  for (i = 0; i < 2*niTess; i++)
-    if (matches[i].objs != NULL) EG_free(matches[i].objs);
+  for (i = 0; i < 2*niTess; i++) {
+    if (matches[i].objs  != NULL) EG_free(matches[i].objs);
+    if (matches[i].index != NULL) EG_free(matches[i].index);
+  }
   EG_free(matches);
   if (stat != EGADS_SUCCESS) {
     EG_deleteObject(*tess);
@@ -546,6 +546,8 @@ EG_limitThread(void *struc)
   fast.pts     = NULL;
   fast.segs    = NULL;
   fast.front   = NULL;
+  fast.grid    = NULL;
+  fast.link    = NULL;
  
   /* look for work */
   for (;;) {
@@ -583,6 +585,8 @@ EG_limitThread(void *struc)
   if (fast.segs  != NULL) EG_free(fast.segs);
   if (fast.pts   != NULL) EG_free(fast.pts);
   if (fast.front != NULL) EG_free(fast.front);
+  if (fast.grid  != NULL) EG_free(fast.grid);
+  if (fast.link  != NULL) EG_free(fast.link);
   
   if (ID != tthread->master) EMP_ThreadExit();
 }
@@ -636,6 +640,7 @@ EG_limitTessBody(egObject *object, int *elimits, int *flimits, egObject **tess)
   btess->tess1d    = NULL;
   btess->tess2d    = NULL;
   btess->globals   = NULL;
+  btess->edits     = NULL;
   btess->nGlobal   = 0;
   btess->nEdge     = 0;
   btess->nFace     = 0;
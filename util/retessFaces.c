@@ -23,19 +23,81 @@
   extern int EG_outLevel(const egObject *object);
 
 
+/* insert n ts after vertex i in the local copy of the Edge discretization */
+static int
+EG_retessInsert(egObject *edge, int i, int n, double *newts, int *npts,
+                int *mpts, double **ts, double **xyzs, int **orig)
+{
+  int    j, k, len, stat, *itmp;
+  double result[9], *dtmp;
+  
+  if (*npts+n > *mpts) {
+    len  = *npts + n + 256;
+    dtmp = (double *) EG_reall(*ts, len*sizeof(double));
+    if (dtmp == NULL) return EGADS_MALLOC;
+    *ts  = dtmp;
+    dtmp = (double *) EG_reall(*xyzs, 3*len*sizeof(double));
+    if (dtmp == NULL) return EGADS_MALLOC;
+    *xyzs = dtmp;
+    itmp = (int *) EG_reall(*orig, len*sizeof(int));
+    if (itmp == NULL) return EGADS_MALLOC;
+    *orig = itmp;
+    *mpts = len;
+  }
+  
+  for (j = *npts-1; j > i; j--) {
+    (*ts)[j+n]       = (*ts)[j];
+    (*xyzs)[3*j+3*n  ] = (*xyzs)[3*j  ];
+    (*xyzs)[3*j+3*n+1] = (*xyzs)[3*j+1];
+    (*xyzs)[3*j+3*n+2] = (*xyzs)[3*j+2];
+    (*orig)[j+n]     = (*orig)[j];
+  }
+  for (k = 0; k < n; k++) {
+    stat = EG_evaluate(edge, &newts[k], result);
+    if (stat != EGADS_SUCCESS) return stat;
+    j = i+k+1;
+    (*ts)[j]       = newts[k];
+    (*xyzs)[3*j  ] = result[0];
+    (*xyzs)[3*j+1] = result[1];
+    (*xyzs)[3*j+2] = result[2];
+    (*orig)[j]     = 0;
+  }
+  *npts += n;
+  
+  return EGADS_SUCCESS;
+}
+
+
+/* refines a local copy of the Edge and queues the inserts per segment */
 static int
 EG_retessEdge(egObject *tess, int eIndex, egObject *edge, double *params)
 {
-  int    i, j, k, stat, npts;
-  double d, dist2, dotnrm, tang[3], result[9], *newts;
-  const double *xyz, *t;
+  int    i, j, k, stat, npts, mpts, *orig = NULL;
+  double d, dist2, dotnrm, tang[3], result[9], *newts, *t = NULL, *xyz = NULL;
+  const double *xyzs, *ts;
+  
+  stat = EG_getTessEdge(tess, eIndex, &npts, &xyzs, &ts);
+  if (stat != EGADS_SUCCESS) return stat;
+  if (npts < 2) return EGADS_EMPTY;
+  mpts = npts;
+  t    = (double *) EG_alloc(  mpts*sizeof(double));
+  xyz  = (double *) EG_alloc(3*mpts*sizeof(double));
+  orig = (int *)    EG_alloc(  mpts*sizeof(int));
+  if ((t == NULL) || (xyz == NULL) || (orig == NULL)) {
+    stat = EGADS_MALLOC;
+    goto cleanup;
+  }
+  for (i = 0; i < npts; i++) {
+    t[i]       = ts[i];
+    xyz[3*i  ] = xyzs[3*i  ];
+    xyz[3*i+1] = xyzs[3*i+1];
+    xyz[3*i+2] = xyzs[3*i+2];
+    orig[i]    = i+1;
+  }
  
   /* insert based on length */
   if (params[0] > 0.0)
     for (;;) {
-      stat = EG_getTessEdge(tess, eIndex, &npts, &xyz, &t);
-      if (stat != EGADS_SUCCESS) return stat;
-      if (npts < 2) return EGADS_EMPTY;
       i     = 0;
       dist2 = (xyz[0]-xyz[3])*(xyz[0]-xyz[3]) +
               (xyz[1]-xyz[4])*(xyz[1]-xyz[4]) +
@@ -54,26 +116,26 @@ EG_retessEdge(egObject *tess, int eIndex, egObject *edge, double *params)
       /* number of insertion points */
       j     = sqrt(dist2)/params[0];
       newts = (double *) EG_alloc(j*sizeof(double));
-      if (newts == NULL) return EGADS_MALLOC;
+      if (newts == NULL) {
+        stat = EGADS_MALLOC;
+        goto cleanup;
+      }
       for (k = 0; k < j; k++)
         newts[k] = t[i] + (k+1.0)*(t[i+1]-t[i])/(j+1.0);
-      stat = EG_insertEdgeVerts(tess, eIndex, i+1, j, newts);
+      stat = EG_retessInsert(edge, i, j, newts, &npts, &mpts, &t, &xyz, &orig);
       EG_free(newts);
-      if (stat != EGADS_SUCCESS) return stat;
+      if (stat != EGADS_SUCCESS) goto cleanup;
     }
   
   /* sag */
   if (params[1] > 0.0)
     for (;;) {
-      stat = EG_getTessEdge(tess, eIndex, &npts, &xyz, &t);
-      if (stat != EGADS_SUCCESS) return stat;
-      if (npts < 2) return EGADS_EMPTY;
       i = -1;
       dist2 = 0;
       for (j = 0; j < npts-1; j++) {
         d    = 0.5*(t[j]+t[j+1]);
         stat = EG_evaluate(edge, &d, result);
-        if (stat != EGADS_SUCCESS) return stat;
+        if (stat != EGADS_SUCCESS) goto cleanup;
         result[3] = 0.5*(xyz[3*j  ] + xyz[3*j+3]);
         result[4] = 0.5*(xyz[3*j+1] + xyz[3*j+4]);
         result[5] = 0.5*(xyz[3*j+2] + xyz[3*j+5]);
@@ -94,8 +156,8 @@ EG_retessEdge(egObject *tess, int eIndex, egObject *edge, double *params)
 
       /* insert one vertex in the segment with the largest chordal deviation */
       d    = 0.5*(t[i]+t[i+1]);
-      stat = EG_insertEdgeVerts(tess, eIndex, i+1, 1, &d);
-      if (stat != EGADS_SUCCESS) return stat;
+      stat = EG_retessInsert(edge, i, 1, &d, &npts, &mpts, &t, &xyz, &orig);
+      if (stat != EGADS_SUCCESS) goto cleanup;
     }
   
   /* angle */
@@ -104,11 +166,8 @@ EG_retessEdge(egObject *tess, int eIndex, egObject *edge, double *params)
     if (d < 0.5) d = 0.5;
     dotnrm = cos(PI*d/180.0);
     for (;;) {
-      stat = EG_getTessEdge(tess, eIndex, &npts, &xyz, &t);
-      if (stat != EGADS_SUCCESS) return stat;
-      if (npts < 2) return EGADS_EMPTY;
       stat = EG_evaluate(edge, &t[0], result);
-      if (stat != EGADS_SUCCESS) return stat;
+      if (stat != EGADS_SUCCESS) goto cleanup;
       d = sqrt(result[3]*result[3] + result[4]*result[4] +
                result[5]*result[5]);
       if (d == 0.0) d = 1.0;
@@ -119,7 +178,7 @@ EG_retessEdge(egObject *tess, int eIndex, egObject *edge, double *params)
       i       = 0;
       for (j = 0; j < npts-1; j++) {
         stat = EG_evaluate(edge, &t[j+1], result);
-        if (stat != EGADS_SUCCESS) return stat;
+        if (stat != EGADS_SUCCESS) goto cleanup;
         d = sqrt(result[3]*result[3] + result[4]*result[4] +
                  result[5]*result[5]);
         if (d == 0.0) d = 1.0;
@@ -139,12 +198,26 @@ EG_retessEdge(egObject *tess, int eIndex, egObject *edge, double *params)
 
       /* insert one vertex in the segment with the largest tangent deviation */
       d    = 0.5*(t[i]+t[i+1]);
-      stat = EG_insertEdgeVerts(tess, eIndex, i+1, 1, &d);
-      if (stat != EGADS_SUCCESS) return stat;      
+      stat = EG_retessInsert(edge, i, 1, &d, &npts, &mpts, &t, &xyz, &orig);
+      if (stat != EGADS_SUCCESS) goto cleanup;
     }
   }
 
-  return EGADS_SUCCESS;
+  /* queue the new vertices -- one insert for each original segment */
+  stat = EGADS_SUCCESS;
+  for (i = 0; i < npts-1; i = j) {
+    for (j = i+1; j < npts; j++)
+      if (orig[j] != 0) break;
+    if (j == i+1) continue;
+    stat = EG_insertEdgeVerts(tess, eIndex, orig[i], j-i-1, &t[i+1]);
+    if (stat != EGADS_SUCCESS) break;
+  }
+
+cleanup:
+  if (orig != NULL) EG_free(orig);
+  if (xyz  != NULL) EG_free(xyz);
+  if (t    != NULL) EG_free(t);
+  return stat;
 }
 
 
@@ -282,7 +355,17 @@ EG_retessFaces(egObject *tess, int nf, int *iface, double *params)
   }
   for (i = 0; i < nf; i++) facedg[i] = faces[iface[i]-1];
 
-  /* deal with the edges touched */
+  /* deal with the edges touched -- all inserts are applied at once */
+  stat = EG_beginEdgeEdits(tess);
+  if (stat != EGADS_SUCCESS) {
+    if (outLevel > 0)
+      printf(" EGADS Error: EG_beginEdgeEdits = %d (EG_retessFaces)!\n", stat);
+    EG_free(facedg);
+    EG_free(iedge);
+    EG_free(edges);
+    EG_free(faces);
+    return stat;
+  }
   for (k = 0; k < nedge; k++)
     if (iedge[k] == 1) {
       /* adjust this edge here and now */
@@ -291,6 +374,7 @@ EG_retessFaces(egObject *tess, int nf, int *iface, double *params)
         if (outLevel > 0)
           printf(" EGADS Error: EG_retessEdge %d=%d (EG_retessFaces)!\n",
                  k+1, stat);
+        EG_abortEdgeEdits(tess);
         EG_free(facedg);
         EG_free(iedge);
         EG_free(edges);
@@ -308,6 +392,17 @@ EG_retessFaces(egObject *tess, int nf, int *iface, double *params)
         EG_free(edgf);
       }
     }
+  stat = EG_commitEdgeEdits(tess);
+  if (stat != EGADS_SUCCESS) {
+    if (outLevel > 0)
+      printf(" EGADS Error: EG_commitEdgeEdits = %d (EG_retessFaces)!\n",
+             stat);
+    EG_free(facedg);
+    EG_free(iedge);
+    EG_free(edges);
+    EG_free(faces);
+    return stat;
+  }
   
   /* remove NULL faces and add the multiple hit edges */
   for (k = i = 0; i < nf; i++)